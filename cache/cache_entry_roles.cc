@@ -39,6 +39,7 @@ std::array<std::string, kNumCacheEntryRoles> kCacheEntryRoleToCamelString{{
     "FileMetadata",
     "BlobValue",
     "BlobCache",
+    "FragmentedRangeTombstoneList",
     "Misc",
 }};
 
@@ -56,6 +57,7 @@ std::array<std::string, kNumCacheEntryRoles> kCacheEntryRoleToHyphenString{{
     "file-metadata",
     "blob-value",
     "blob-cache",
+    "fragmented-range-tombstone-list",
     "misc",
 }};
 
@@ -29,14 +29,21 @@
 #include <cstdlib>
 
 #include "cache/secondary_cache_adapter.h"
+#include "memory/memory_allocator.h"
 #include "monitoring/perf_context_imp.h"
 #include "monitoring/statistics.h"
 #include "port/lang.h"
+#include "util/compression.h"
 #include "util/distributed_mutex.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace lru_cache {
 
+// Block format version used when compressing cold entries in place; 2 means
+// the decompressed size is included in the header (same default as
+// CompressedSecondaryCacheOptions::compress_format_version).
+constexpr uint32_t kColdEntryCompressFormatVersion = 2;
+
 LRUHandleTable::LRUHandleTable(int max_upper_hash_bits,
                                MemoryAllocator* allocator)
     : length_bits_(/* historical starting size*/ 4),
@@ -134,7 +141,9 @@ LRUCacheShard::LRUCacheShard(size_t capacity, bool strict_capacity_limit,
                              CacheMetadataChargePolicy metadata_charge_policy,
                              int max_upper_hash_bits,
                              MemoryAllocator* allocator,
-                             const Cache::EvictionCallback* eviction_callback)
+                             const Cache::EvictionCallback* eviction_callback,
+                             const CacheAdmissionPolicy* admission_policy,
+                             CompressionType compress_cold_entries)
     : CacheShardBase(metadata_charge_policy),
       capacity_(0),
       high_pri_pool_usage_(0),
@@ -144,11 +153,13 @@ LRUCacheShard::LRUCacheShard(size_t capacity, bool strict_capacity_limit,
       high_pri_pool_capacity_(0),
       low_pri_pool_ratio_(low_pri_pool_ratio),
       low_pri_pool_capacity_(0),
+      compress_cold_entries_(compress_cold_entries),
       table_(max_upper_hash_bits, allocator),
       usage_(0),
       lru_usage_(0),
-      mutex_(use_adaptive_mutex),
-      eviction_callback_(*eviction_callback) {
+      eviction_callback_(*eviction_callback),
+      admission_policy_(*admission_policy) {
+  (void)use_adaptive_mutex;
   // Make empty circular linked list.
   lru_.next = &lru_;
   lru_.prev = &lru_;
@@ -160,7 +171,7 @@ LRUCacheShard::LRUCacheShard(size_t capacity, bool strict_capacity_limit,
 void LRUCacheShard::EraseUnRefEntries() {
   autovector<LRUHandle*> last_reference_list;
   {
-    DMutexLock l(mutex_);
+    WriteLock l(&mutex_);
     while (lru_.next != &lru_) {
       LRUHandle* old = lru_.next;
       // LRU list contains only elements which can be evicted.
@@ -188,7 +199,7 @@ void LRUCacheShard::ApplyToSomeEntriesWithOwnerId(
   // The state is essentially going to be the starting hash, which works
   // nicely even if we resize between calls because we use upper-most
   // hash bits for table indexes.
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   int length_bits = table_.GetLengthBits();
   size_t length = size_t{1} << length_bits;
 
@@ -210,22 +221,32 @@ void LRUCacheShard::ApplyToSomeEntriesWithOwnerId(
   table_.ApplyToEntriesRange(
       [callback,
        metadata_charge_policy = metadata_charge_policy_](LRUHandle* h) {
+        // A cold-compressed entry's value is a compressed byte buffer, not
+        // the live object its helper describes, so report it with the
+        // secondary-incompatible helper (no size/saveto callbacks); that
+        // keeps serializing consumers such as the cache dumper from
+        // reinterpreting the buffer as the live object, and they already
+        // skip entries without those callbacks.
+        const Cache::CacheItemHelper* helper =
+            (h->IsValueCompressed() && h->helper != nullptr)
+                ? h->helper->without_secondary_compat
+                : h->helper;
         callback(h->key(), h->value, h->GetCharge(metadata_charge_policy),
-                 h->helper, h->item_owner_id);
+                 helper, h->item_owner_id);
       },
       index_begin, index_end);
 }
 
 void LRUCacheShard::TEST_GetLRUList(LRUHandle** lru, LRUHandle** lru_low_pri,
                                     LRUHandle** lru_bottom_pri) {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   *lru = &lru_;
   *lru_low_pri = lru_low_pri_;
   *lru_bottom_pri = lru_bottom_pri_;
 }
 
 size_t LRUCacheShard::TEST_GetLRUSize() {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   LRUHandle* lru_handle = lru_.next;
   size_t lru_size = 0;
   while (lru_handle != &lru_) {
@@ -236,12 +257,12 @@ size_t LRUCacheShard::TEST_GetLRUSize() {
 }
 
 double LRUCacheShard::GetHighPriPoolRatio() {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   return high_pri_pool_ratio_;
 }
 
 double LRUCacheShard::GetLowPriPoolRatio() {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   return low_pri_pool_ratio_;
 }
 
@@ -340,6 +361,15 @@ void LRUCacheShard::EvictFromLRU(size_t charge,
     LRUHandle* old = lru_.next;
     // LRU list contains only elements which can be evicted.
     assert(old->InCache() && !old->HasRefs());
+    // Before evicting a cold entry, try compressing it in place: it stays
+    // findable at a fraction of the footprint and is only evicted once it
+    // comes around cold again. Entries handed to an eviction callback
+    // (secondary cache) are excluded since the callback expects the object.
+    if (compress_cold_entries_ != kNoCompression && !eviction_callback_ &&
+        !old->IsValueCompressed() && old->value != nullptr &&
+        old->helper->size_cb != nullptr && CompressColdValue(old)) {
+      continue;
+    }
     LRU_Remove(old);
     table_.Remove(old->key(), old->hash);
     old->SetInCache(false);
@@ -349,6 +379,86 @@ void LRUCacheShard::EvictFromLRU(size_t charge,
   }
 }
 
+bool LRUCacheShard::CompressColdValue(LRUHandle* e) {
+  assert(e->InCache() && !e->HasRefs() && !e->IsValueCompressed());
+  const Cache::CacheItemHelper* helper = e->helper;
+  assert(helper->size_cb != nullptr && helper->saveto_cb != nullptr &&
+         helper->create_cb != nullptr);
+  MemoryAllocator* allocator = table_.GetAllocator();
+  const size_t size = (*helper->size_cb)(e->value);
+  CacheAllocationPtr serialized = AllocateBlock(size, allocator);
+  if (!(*helper->saveto_cb)(e->value, 0, size, serialized.get()).ok()) {
+    return false;
+  }
+  CompressionOptions compression_opts;
+  CompressionContext compression_context(compress_cold_entries_);
+  CompressionInfo compression_info(
+      compression_opts, compression_context, CompressionDict::GetEmptyDict(),
+      compress_cold_entries_, 0 /* sample_for_compression */);
+  std::string compressed;
+  if (!CompressData(Slice(serialized.get(), size), compression_info,
+                    kColdEntryCompressFormatVersion, &compressed) ||
+      compressed.size() >= size) {
+    // Not compressible enough to be worth keeping; let it be evicted.
+    return false;
+  }
+  CacheAllocationPtr buf = AllocateBlock(compressed.size(), allocator);
+  memcpy(buf.get(), compressed.data(), compressed.size());
+
+  // Swap the object for the compressed serialization and re-charge the
+  // entry for its smaller footprint.
+  LRU_Remove(e);
+  assert(usage_ >= e->total_charge);
+  usage_ -= e->total_charge;
+  if (helper->del_cb) {
+    helper->del_cb(e->value, allocator);
+  }
+  e->value = buf.release();
+  e->SetValueCompressed(true);
+  e->CalcTotalCharge(compressed.size(), metadata_charge_policy_);
+  usage_ += e->total_charge;
+  // Re-insert at the head of its pool: the compressed entry survives until
+  // it cycles back to the cold end, at which point it is evicted for real.
+  LRU_Insert(e);
+  return true;
+}
+
+bool LRUCacheShard::UncompressValue(LRUHandle* e,
+                                    Cache::CreateContext* create_context) {
+  assert(e->IsValueCompressed() && !e->HasRefs());
+  const Cache::CacheItemHelper* helper = e->helper;
+  assert(helper->create_cb != nullptr);
+  MemoryAllocator* allocator = table_.GetAllocator();
+  const size_t compressed_size = e->GetCharge(metadata_charge_policy_);
+  UncompressionContext uncompression_context(compress_cold_entries_);
+  UncompressionInfo uncompression_info(uncompression_context,
+                                       UncompressionDict::GetEmptyDict(),
+                                       compress_cold_entries_);
+  size_t uncompressed_size = 0;
+  CacheAllocationPtr uncompressed = UncompressData(
+      uncompression_info, static_cast<char*>(e->value), compressed_size,
+      &uncompressed_size, kColdEntryCompressFormatVersion, allocator);
+  if (!uncompressed) {
+    return false;
+  }
+  Cache::ObjectPtr obj = nullptr;
+  size_t charge = 0;
+  Status s = helper->create_cb(Slice(uncompressed.get(), uncompressed_size),
+                               create_context, allocator, &obj, &charge);
+  if (!s.ok()) {
+    return false;
+  }
+  CacheAllocationPtr defer_free(static_cast<char*>(e->value),
+                                CustomDeleter(allocator));
+  e->value = obj;
+  e->SetValueCompressed(false);
+  assert(usage_ >= e->total_charge);
+  usage_ -= e->total_charge;
+  e->CalcTotalCharge(charge, metadata_charge_policy_);
+  usage_ += e->total_charge;
+  return true;
+}
+
 void LRUCacheShard::NotifyEvicted(
     const autovector<LRUHandle*>& evicted_handles) {
   MemoryAllocator* alloc = table_.GetAllocator();
@@ -368,7 +478,7 @@ void LRUCacheShard::NotifyEvicted(
 void LRUCacheShard::SetCapacity(size_t capacity) {
   autovector<LRUHandle*> last_reference_list;
   {
-    DMutexLock l(mutex_);
+    WriteLock l(&mutex_);
     capacity_ = capacity;
     high_pri_pool_capacity_ = capacity_ * high_pri_pool_ratio_;
     low_pri_pool_capacity_ = capacity_ * low_pri_pool_ratio_;
@@ -379,7 +489,7 @@ void LRUCacheShard::SetCapacity(size_t capacity) {
 }
 
 void LRUCacheShard::SetStrictCapacityLimit(bool strict_capacity_limit) {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   strict_capacity_limit_ = strict_capacity_limit;
 }
 
@@ -388,7 +498,7 @@ Status LRUCacheShard::InsertItem(LRUHandle* e, LRUHandle** handle) {
   autovector<LRUHandle*> last_reference_list;
 
   {
-    DMutexLock l(mutex_);
+    WriteLock l(&mutex_);
 
     // Free the space following strict LRU policy until enough space
     // is freed or the lru list is empty.
@@ -442,11 +552,34 @@ Status LRUCacheShard::InsertItem(LRUHandle* e, LRUHandle** handle) {
 }
 
 LRUHandle* LRUCacheShard::Lookup(const Slice& key, uint32_t hash,
-                                 const Cache::CacheItemHelper* /*helper*/,
-                                 Cache::CreateContext* /*create_context*/,
+                                 const Cache::CacheItemHelper* helper,
+                                 Cache::CreateContext* create_context,
                                  Cache::Priority /*priority*/,
                                  Statistics* /*stats*/) {
-  DMutexLock l(mutex_);
+  {
+    // Fast path under the shared lock. An entry that already carries
+    // external refs is not on the LRU list, so a hit on it needs no list
+    // maintenance - just another atomic ref. The shared lock keeps the
+    // table stable, and since refs only drop under the exclusive lock the
+    // entry cannot be freed from under us. This is where concurrent reads
+    // of the same hot blocks land, so they no longer serialize on the
+    // shard. Misses also resolve here without the exclusive lock.
+    ReadLock l(&mutex_);
+    LRUHandle* e = table_.Lookup(key, hash);
+    if (e == nullptr) {
+      return nullptr;
+    }
+    assert(e->InCache());
+    if (e->HasRefs()) {
+      e->Ref();
+      e->SetHit();
+      return e;
+    }
+  }
+  // The entry sits on the LRU list and has to be unlinked, which needs the
+  // exclusive lock. Redo the lookup since the table may have changed in
+  // between.
+  WriteLock l(&mutex_);
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->InCache());
@@ -455,6 +588,21 @@ LRUHandle* LRUCacheShard::Lookup(const Slice& key, uint32_t hash,
       // references.
       LRU_Remove(e);
     }
+    if (e->IsValueCompressed()) {
+      // The entry was compressed in place while cold (see EvictFromLRU);
+      // restore the object before handing it out. If that is not possible
+      // (caller provided no create support, or corruption), drop the entry
+      // and report a miss.
+      if (helper == nullptr || helper->create_cb == nullptr ||
+          !UncompressValue(e, create_context)) {
+        table_.Remove(e->key(), e->hash);
+        e->SetInCache(false);
+        assert(usage_ >= e->total_charge);
+        usage_ -= e->total_charge;
+        e->Free(table_.GetAllocator());
+        return nullptr;
+      }
+    }
     e->Ref();
     e->SetHit();
   }
@@ -462,22 +610,23 @@ LRUHandle* LRUCacheShard::Lookup(const Slice& key, uint32_t hash,
 }
 
 bool LRUCacheShard::Ref(LRUHandle* e) {
-  DMutexLock l(mutex_);
-  // To create another reference - entry must be already externally referenced.
+  // To create another reference - entry must be already externally
+  // referenced, and the caller holds one of those references, so the entry
+  // cannot go away; no lock is needed for the atomic ref.
   assert(e->HasRefs());
   e->Ref();
   return true;
 }
 
 void LRUCacheShard::SetHighPriorityPoolRatio(double high_pri_pool_ratio) {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   high_pri_pool_ratio_ = high_pri_pool_ratio;
   high_pri_pool_capacity_ = capacity_ * high_pri_pool_ratio_;
   MaintainPoolSize();
 }
 
 void LRUCacheShard::SetLowPriorityPoolRatio(double low_pri_pool_ratio) {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   low_pri_pool_ratio_ = low_pri_pool_ratio;
   low_pri_pool_capacity_ = capacity_ * low_pri_pool_ratio_;
   MaintainPoolSize();
@@ -491,7 +640,7 @@ bool LRUCacheShard::Release(LRUHandle* e, bool /*useful*/,
   bool must_free;
   bool was_in_cache;
   {
-    DMutexLock l(mutex_);
+    WriteLock l(&mutex_);
     must_free = e->Unref();
     was_in_cache = e->InCache();
     if (must_free && was_in_cache) {
@@ -578,6 +727,34 @@ Status LRUCacheShard::InsertWithOwnerId(const Slice& key, uint32_t hash,
   LRUHandle* e = CreateHandle(key, hash, value, helper, charge, item_owner_id);
   e->SetPriority(priority);
   e->SetInCache(true);
+  if (admission_policy_) {
+    CacheEntryAdmission verdict = admission_policy_(
+        key, helper->role, charge, priority == Cache::Priority::BOTTOM);
+    if (verdict == CacheEntryAdmission::kAdmitAtBottom) {
+      e->SetPriority(Cache::Priority::BOTTOM);
+    } else if (verdict == CacheEntryAdmission::kReject) {
+      if (handle == nullptr) {
+        // Free the entry as if it was inserted and immediately evicted.
+        e->SetInCache(false);
+        e->Free(table_.GetAllocator());
+        return Status::OK();
+      }
+      // The caller needs the entry, so hand it out as a standalone handle
+      // that is never linked into the table and goes away on release.
+      e->SetInCache(false);
+      e->SetIsStandalone(true);
+      e->Ref();
+      autovector<LRUHandle*> last_reference_list;
+      {
+        WriteLock l(&mutex_);
+        EvictFromLRU(e->total_charge, &last_reference_list);
+        usage_ += e->total_charge;
+      }
+      NotifyEvicted(last_reference_list);
+      *handle = e;
+      return Status::OK();
+    }
+  }
   return InsertItem(e, handle);
 }
 
@@ -594,7 +771,7 @@ LRUHandle* LRUCacheShard::CreateStandalone(const Slice& key, uint32_t hash,
   autovector<LRUHandle*> last_reference_list;
 
   {
-    DMutexLock l(mutex_);
+    WriteLock l(&mutex_);
 
     EvictFromLRU(e->total_charge, &last_reference_list);
 
@@ -618,7 +795,7 @@ void LRUCacheShard::Erase(const Slice& key, uint32_t hash) {
   LRUHandle* e;
   bool last_reference = false;
   {
-    DMutexLock l(mutex_);
+    WriteLock l(&mutex_);
     e = table_.Remove(key, hash);
     if (e != nullptr) {
       assert(e->InCache());
@@ -641,23 +818,23 @@ void LRUCacheShard::Erase(const Slice& key, uint32_t hash) {
 }
 
 size_t LRUCacheShard::GetUsage() const {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   return usage_;
 }
 
 size_t LRUCacheShard::GetPinnedUsage() const {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   assert(usage_ >= lru_usage_);
   return usage_ - lru_usage_;
 }
 
 size_t LRUCacheShard::GetOccupancyCount() const {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   return table_.GetOccupancyCount();
 }
 
 size_t LRUCacheShard::GetTableAddressCount() const {
-  DMutexLock l(mutex_);
+  WriteLock l(&mutex_);
   return size_t{1} << table_.GetLengthBits();
 }
 
@@ -665,7 +842,7 @@ void LRUCacheShard::AppendPrintableOptions(std::string& str) const {
   const int kBufferSize = 200;
   char buffer[kBufferSize];
   {
-    DMutexLock l(mutex_);
+    WriteLock l(&mutex_);
     snprintf(buffer, kBufferSize, "    high_pri_pool_ratio: %.3lf\n",
              high_pri_pool_ratio_);
     snprintf(buffer + strlen(buffer), kBufferSize - strlen(buffer),
@@ -679,18 +856,22 @@ LRUCache::LRUCache(size_t capacity, int num_shard_bits,
                    double low_pri_pool_ratio,
                    std::shared_ptr<MemoryAllocator> allocator,
                    bool use_adaptive_mutex,
-                   CacheMetadataChargePolicy metadata_charge_policy)
+                   CacheMetadataChargePolicy metadata_charge_policy,
+                   CacheAdmissionPolicy admission_policy,
+                   CompressionType compress_cold_entries)
     : ShardedCache(capacity, num_shard_bits, strict_capacity_limit,
-                   std::move(allocator)) {
+                   std::move(allocator)),
+      admission_policy_(std::move(admission_policy)) {
   size_t per_shard = GetPerShardCapacity();
   MemoryAllocator* alloc = memory_allocator();
   const EvictionCallback* eviction_callback = &eviction_callback_;
+  const CacheAdmissionPolicy* policy = &admission_policy_;
   InitShards([=](LRUCacheShard* cs) {
     new (cs) LRUCacheShard(per_shard, strict_capacity_limit,
                            high_pri_pool_ratio, low_pri_pool_ratio,
                            use_adaptive_mutex, metadata_charge_policy,
                            /* max_upper_hash_bits */ 32 - num_shard_bits, alloc,
-                           eviction_callback);
+                           eviction_callback, policy, compress_cold_entries);
   });
 }
 
@@ -726,7 +907,8 @@ std::shared_ptr<Cache> NewLRUCache(
     std::shared_ptr<MemoryAllocator> memory_allocator, bool use_adaptive_mutex,
     CacheMetadataChargePolicy metadata_charge_policy,
     const std::shared_ptr<SecondaryCache>& secondary_cache,
-    double low_pri_pool_ratio) {
+    double low_pri_pool_ratio, CacheAdmissionPolicy admission_policy = {},
+    CompressionType compress_cold_entries = kNoCompression) {
   if (num_shard_bits >= 20) {
     return nullptr;  // The cache cannot be sharded into too many fine pieces.
   }
@@ -748,7 +930,8 @@ std::shared_ptr<Cache> NewLRUCache(
   std::shared_ptr<Cache> cache = std::make_shared<LRUCache>(
       capacity, num_shard_bits, strict_capacity_limit, high_pri_pool_ratio,
       low_pri_pool_ratio, std::move(memory_allocator), use_adaptive_mutex,
-      metadata_charge_policy);
+      metadata_charge_policy, std::move(admission_policy),
+      compress_cold_entries);
   if (secondary_cache) {
     cache = std::make_shared<CacheWithSecondaryAdapter>(cache, secondary_cache);
   }
@@ -761,7 +944,9 @@ std::shared_ptr<Cache> NewLRUCache(const LRUCacheOptions& cache_opts) {
                      cache_opts.high_pri_pool_ratio,
                      cache_opts.memory_allocator, cache_opts.use_adaptive_mutex,
                      cache_opts.metadata_charge_policy,
-                     cache_opts.secondary_cache, cache_opts.low_pri_pool_ratio);
+                     cache_opts.secondary_cache, cache_opts.low_pri_pool_ratio,
+                     cache_opts.admission_policy,
+                     cache_opts.compress_cold_entries);
 }
 
 std::shared_ptr<Cache> NewLRUCache(
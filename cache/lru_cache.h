@@ -22,16 +22,18 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "cache/sharded_cache.h"
+#include "memory/memory_allocator.h"
 #include "port/lang.h"
 #include "port/likely.h"
 #include "port/malloc.h"
 #include "port/port.h"
 #include "util/autovector.h"
-#include "util/distributed_mutex.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace lru_cache {
@@ -71,14 +73,18 @@ struct LRUHandle {
   size_t key_length;
   // The hash of key(). Used for fast sharding and comparisons.
   uint32_t hash;
-  // The number of external refs to this entry. The cache itself is not counted.
-  uint32_t refs;
+  // The number of external refs to this entry. The cache itself is not
+  // counted. Atomic so that Lookup can take a ref on an already referenced
+  // entry under the shared lock; it only ever drops under the exclusive lock.
+  std::atomic<uint32_t> refs;
   Cache::ItemOwnerId item_owner_id = Cache::kUnknownItemOwnerId;
 
-  // Mutable flags - access controlled by mutex
+  // Mutable flags - modified under the exclusive lock, except that the
+  // shared-lock lookup fast path may set M_HAS_HIT, hence the atomic
+  // bit operations.
   // The m_ and M_ prefixes (and im_ and IM_ later) are to hopefully avoid
   // checking an M_ flag on im_flags or an IM_ flag on m_flags.
-  uint8_t m_flags;
+  std::atomic<uint8_t> m_flags;
   enum MFlags : uint8_t {
     // Whether this entry is referenced by the hash table.
     M_IN_CACHE = (1 << 0),
@@ -88,6 +94,11 @@ struct LRUHandle {
     M_IN_HIGH_PRI_POOL = (1 << 2),
     // Whether this entry is in low-pri pool.
     M_IN_LOW_PRI_POOL = (1 << 3),
+    // Whether value points to a compressed serialization of the object
+    // instead of the object itself (cold-entry demotion tier). Only set
+    // while refs == 0; restored to the object before a lookup hands the
+    // entry out.
+    M_VALUE_COMPRESSED = (1 << 4),
   };
 
   // "Immutable" flags - only set in single-threaded context and then
@@ -111,34 +122,40 @@ struct LRUHandle {
   uint32_t GetHash() const { return hash; }
 
   // Increase the reference count by 1.
-  void Ref() { refs++; }
+  void Ref() { refs.fetch_add(1, std::memory_order_relaxed); }
 
   // Just reduce the reference count by 1. Return true if it was last reference.
   bool Unref() {
-    assert(refs > 0);
-    refs--;
-    return refs == 0;
+    uint32_t old_refs = refs.fetch_sub(1, std::memory_order_acq_rel);
+    assert(old_refs > 0);
+    return old_refs == 1;
   }
 
   // Return true if there are external refs, false otherwise.
-  bool HasRefs() const { return refs > 0; }
+  bool HasRefs() const { return refs.load(std::memory_order_acquire) > 0; }
 
-  bool InCache() const { return m_flags & M_IN_CACHE; }
+  bool InCache() const { return MFlags() & M_IN_CACHE; }
   bool IsHighPri() const { return im_flags & IM_IS_HIGH_PRI; }
-  bool InHighPriPool() const { return m_flags & M_IN_HIGH_PRI_POOL; }
+  bool InHighPriPool() const { return MFlags() & M_IN_HIGH_PRI_POOL; }
   bool IsLowPri() const { return im_flags & IM_IS_LOW_PRI; }
-  bool InLowPriPool() const { return m_flags & M_IN_LOW_PRI_POOL; }
-  bool HasHit() const { return m_flags & M_HAS_HIT; }
+  bool InLowPriPool() const { return MFlags() & M_IN_LOW_PRI_POOL; }
+  bool HasHit() const { return MFlags() & M_HAS_HIT; }
+  bool IsValueCompressed() const { return MFlags() & M_VALUE_COMPRESSED; }
   bool IsStandalone() const { return im_flags & IM_IS_STANDALONE; }
 
-  void SetInCache(bool in_cache) {
-    if (in_cache) {
-      m_flags |= M_IN_CACHE;
+  uint8_t MFlags() const { return m_flags.load(std::memory_order_relaxed); }
+
+  void SetMFlag(uint8_t flag, bool on) {
+    if (on) {
+      m_flags.fetch_or(flag, std::memory_order_relaxed);
     } else {
-      m_flags &= ~M_IN_CACHE;
+      m_flags.fetch_and(static_cast<uint8_t>(~flag),
+                        std::memory_order_relaxed);
     }
   }
 
+  void SetInCache(bool in_cache) { SetMFlag(M_IN_CACHE, in_cache); }
+
   void SetPriority(Cache::Priority priority) {
     if (priority == Cache::Priority::HIGH) {
       im_flags |= IM_IS_HIGH_PRI;
@@ -153,22 +170,18 @@ struct LRUHandle {
   }
 
   void SetInHighPriPool(bool in_high_pri_pool) {
-    if (in_high_pri_pool) {
-      m_flags |= M_IN_HIGH_PRI_POOL;
-    } else {
-      m_flags &= ~M_IN_HIGH_PRI_POOL;
-    }
+    SetMFlag(M_IN_HIGH_PRI_POOL, in_high_pri_pool);
   }
 
   void SetInLowPriPool(bool in_low_pri_pool) {
-    if (in_low_pri_pool) {
-      m_flags |= M_IN_LOW_PRI_POOL;
-    } else {
-      m_flags &= ~M_IN_LOW_PRI_POOL;
-    }
+    SetMFlag(M_IN_LOW_PRI_POOL, in_low_pri_pool);
   }
 
-  void SetHit() { m_flags |= M_HAS_HIT; }
+  void SetHit() { SetMFlag(M_HAS_HIT, true); }
+
+  void SetValueCompressed(bool compressed) {
+    SetMFlag(M_VALUE_COMPRESSED, compressed);
+  }
 
   void SetIsStandalone(bool is_standalone) {
     if (is_standalone) {
@@ -181,7 +194,12 @@ struct LRUHandle {
   void Free(MemoryAllocator* allocator) {
     assert(refs == 0);
     assert(helper);
-    if (helper->del_cb) {
+    if (IsValueCompressed()) {
+      // value is a compressed serialization owned by the cache, not the
+      // object that del_cb expects.
+      CacheAllocationPtr defer_free(static_cast<char*>(value),
+                                    CustomDeleter(allocator));
+    } else if (helper->del_cb) {
       helper->del_cb(value, allocator);
     }
 
@@ -286,7 +304,9 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
                 bool use_adaptive_mutex,
                 CacheMetadataChargePolicy metadata_charge_policy,
                 int max_upper_hash_bits, MemoryAllocator* allocator,
-                const Cache::EvictionCallback* eviction_callback);
+                const Cache::EvictionCallback* eviction_callback,
+                const CacheAdmissionPolicy* admission_policy,
+                CompressionType compress_cold_entries = kNoCompression);
 
  public:  // Type definitions expected as parameter to ShardedCache
   using HandleImpl = LRUHandle;
@@ -391,6 +411,17 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   // holding the mutex_.
   void EvictFromLRU(size_t charge, autovector<LRUHandle*>* deleted);
 
+  // Replace the object of the unreferenced entry `e` with a compressed
+  // serialization, re-charging the entry for the smaller footprint. Returns
+  // false (leaving the entry untouched) if the object could not be
+  // serialized or did not shrink. Requires the exclusive lock.
+  bool CompressColdValue(LRUHandle* e);
+
+  // Rebuild the object of a compressed entry via its helper's create_cb.
+  // Returns false if the object could not be restored. Requires the
+  // exclusive lock and that `e` is not on the LRU list.
+  bool UncompressValue(LRUHandle* e, Cache::CreateContext* create_context);
+
   void NotifyEvicted(const autovector<LRUHandle*>& evicted_handles);
 
   LRUHandle* CreateHandle(const Slice& key, uint32_t hash,
@@ -435,6 +466,11 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   // Pointer to head of bottom-pri pool in LRU list.
   LRUHandle* lru_bottom_pri_;
 
+  // If not kNoCompression, entries at the cold end of the LRU list are
+  // compressed in place before being evicted (see
+  // LRUCacheOptions::compress_cold_entries).
+  CompressionType compress_cold_entries_;
+
   // ------------^^^^^^^^^^^^^-----------
   // Not frequently modified data members
   // ------------------------------------
@@ -454,13 +490,20 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   // Memory size for entries residing only in the LRU list.
   size_t lru_usage_;
 
-  // mutex_ protects the following state.
+  // mutex_ protects the following state. All mutating operations take it
+  // exclusively; Lookup hits on entries that already carry external refs
+  // only take it shared, so concurrent readers of hot blocks do not
+  // serialize on the shard (see Lookup).
   // We don't count mutex_ as the cache's internal state so semantically we
   // don't mind mutex_ invoking the non-const actions.
-  mutable DMutex mutex_;
+  mutable port::RWMutex mutex_;
 
   // A reference to Cache::eviction_callback_
   const Cache::EvictionCallback& eviction_callback_;
+
+  // A reference to LRUCache::admission_policy_; consulted on every insert
+  // when set. May be empty.
+  const CacheAdmissionPolicy& admission_policy_;
 };
 
 class LRUCache
@@ -474,7 +517,9 @@ class LRUCache
            std::shared_ptr<MemoryAllocator> memory_allocator = nullptr,
            bool use_adaptive_mutex = kDefaultToAdaptiveMutex,
            CacheMetadataChargePolicy metadata_charge_policy =
-               kDontChargeCacheMetadata);
+               kDontChargeCacheMetadata,
+           CacheAdmissionPolicy admission_policy = {},
+           CompressionType compress_cold_entries = kNoCompression);
   const char* Name() const override { return "LRUCache"; }
   ObjectPtr Value(Handle* handle) override;
   size_t GetCharge(Handle* handle) const override;
@@ -484,6 +529,10 @@ class LRUCache
   size_t TEST_GetLRUSize();
   // Retrieves high pri pool ratio.
   double GetHighPriPoolRatio();
+
+ private:
+  // Consulted by the shards on every insert when set. Must outlive them.
+  const CacheAdmissionPolicy admission_policy_;
 };
 
 }  // namespace lru_cache
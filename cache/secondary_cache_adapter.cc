@@ -6,6 +6,7 @@
 #include "cache/secondary_cache_adapter.h"
 
 #include "monitoring/perf_context_imp.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -16,6 +17,9 @@ struct Dummy {
 };
 const Dummy kDummy{};
 Cache::ObjectPtr const kDummyObj = const_cast<Dummy*>(&kDummy);
+
+// Bound on queued dummy-insert recency hints; hints past it are dropped.
+constexpr size_t kMaxDeferredDummyInserts = 256;
 }  // namespace
 
 CacheWithSecondaryAdapter::CacheWithSecondaryAdapter(
@@ -26,14 +30,107 @@ CacheWithSecondaryAdapter::CacheWithSecondaryAdapter(
   target_->SetEvictionCallback([this](const Slice& key, Handle* handle) {
     return EvictionHandler(key, handle);
   });
+  drain_thread_ =
+      port::Thread([this]() { DrainDeferredDummyInserts(); });
 }
 
 CacheWithSecondaryAdapter::~CacheWithSecondaryAdapter() {
+  {
+    MutexLock l(&deferred_mutex_);
+    shutting_down_ = true;
+    deferred_cv_.SignalAll();
+  }
+  drain_thread_.join();
   // `*this` will be destroyed before `*target_`, so we have to prevent
   // use after free
   target_->SetEvictionCallback({});
 }
 
+void CacheWithSecondaryAdapter::DeferDummyInsert(const Slice& key,
+                                                 Priority priority) {
+  MutexLock l(&deferred_mutex_);
+  if (deferred_dummy_inserts_.size() >= kMaxDeferredDummyInserts) {
+    // The hint only delays promotion by one more secondary hit, so it is
+    // cheaper to drop it than to stall the lookup behind the drainer.
+    return;
+  }
+  deferred_dummy_inserts_.push_back({key.ToString(), priority});
+  deferred_hints_.fetch_add(1, std::memory_order_release);
+  deferred_cv_.Signal();
+}
+
+bool CacheWithSecondaryAdapter::ClaimPendingDummyHint(const Slice& key) {
+  MutexLock l(&deferred_mutex_);
+  for (auto it = deferred_dummy_inserts_.begin();
+       it != deferred_dummy_inserts_.end(); ++it) {
+    if (Slice(it->key) == key) {
+      deferred_dummy_inserts_.erase(it);
+      deferred_hints_.fetch_sub(1, std::memory_order_release);
+      return true;
+    }
+  }
+  if (in_flight_dummy_valid_ && Slice(in_flight_dummy_key_) == key) {
+    // The dummy is about to land in the primary cache. Treat it as found;
+    // at worst the landing dummy shortly displaces the promoted entry, the
+    // same (noted) hazard the synchronous dummy insert has.
+    return true;
+  }
+  return false;
+}
+
+bool CacheWithSecondaryAdapter::CheckDeferredDummyHint(
+    const Slice& key, const CacheItemHelper* helper,
+    CreateContext* create_context, Priority priority, Statistics* stats,
+    Handle** result) {
+  assert(*result == nullptr);
+  if (deferred_hints_.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  if (ClaimPendingDummyHint(key)) {
+    return true;
+  }
+  // A hint for this key, if there was one, has been drained into the primary
+  // cache since the miss above; look once more so a lookup never observes
+  // less than the synchronous insert would have shown.
+  Handle* retry = target_->Lookup(key, helper, create_context, priority, stats);
+  bool found_dummy_entry = ProcessDummyResult(&retry, /*erase=*/true);
+  if (retry) {
+    // A real entry appeared concurrently; just use it.
+    *result = retry;
+  }
+  return found_dummy_entry;
+}
+
+void CacheWithSecondaryAdapter::DrainDeferredDummyInserts() {
+  deferred_mutex_.Lock();
+  while (true) {
+    while (deferred_dummy_inserts_.empty() && !shutting_down_) {
+      deferred_cv_.Wait();
+    }
+    if (deferred_dummy_inserts_.empty()) {
+      assert(shutting_down_);
+      deferred_mutex_.Unlock();
+      return;
+    }
+    DeferredDummyInsert hint = std::move(deferred_dummy_inserts_.front());
+    deferred_dummy_inserts_.pop_front();
+    // Track the key while inserting so a concurrent lookup that just missed
+    // both the queue and the primary cache still counts the hint as found.
+    in_flight_dummy_key_ = hint.key;
+    in_flight_dummy_valid_ = true;
+    deferred_mutex_.Unlock();
+    // The insert takes the primary shard mutex here instead of in the
+    // caller's lookup.
+    Status s = Insert(hint.key, kDummyObj, &kNoopCacheItemHelper,
+                      /*charge=*/0, /*handle=*/nullptr, hint.priority);
+    // Nothing to do or clean up on dummy insertion failure
+    s.PermitUncheckedError();
+    deferred_mutex_.Lock();
+    in_flight_dummy_valid_ = false;
+    deferred_hints_.fetch_sub(1, std::memory_order_release);
+  }
+}
+
 bool CacheWithSecondaryAdapter::EvictionHandler(const Slice& key,
                                                 Handle* handle) {
   auto helper = GetCacheItemHelper(handle);
@@ -109,13 +206,13 @@ Cache::Handle* CacheWithSecondaryAdapter::Promote(
     assert(result);
     PERF_COUNTER_ADD(block_cache_standalone_handle_count, 1);
 
-    // Insert dummy to record recent use
+    // Queue a dummy insert to record recent use. Doing it in the background
+    // keeps the caller's lookup down to the standalone handle creation, so
+    // MultiGet bursts that hit the secondary tier do not serialize on the
+    // primary shard mutexes.
     // TODO: try to avoid case where inserting this dummy could overwrite a
     // regular entry
-    Status s = Insert(key, kDummyObj, &kNoopCacheItemHelper, /*charge=*/0,
-                      /*handle=*/nullptr, priority);
-    s.PermitUncheckedError();
-    // Nothing to do or clean up on dummy insertion failure
+    DeferDummyInsert(key, priority);
   } else {
     // Insert regular entry into primary cache.
     // Don't allow it to spill into secondary cache again if it was kept there.
@@ -149,6 +246,13 @@ Cache::Handle* CacheWithSecondaryAdapter::Lookup(const Slice& key,
   bool secondary_compatible = helper && helper->IsSecondaryCacheCompatible();
   bool found_dummy_entry =
       ProcessDummyResult(&result, /*erase=*/secondary_compatible);
+  if (!result && secondary_compatible && !found_dummy_entry) {
+    found_dummy_entry = CheckDeferredDummyHint(key, helper, create_context,
+                                               priority, stats, &result);
+    if (result) {
+      return result;
+    }
+  }
   if (!result && secondary_compatible) {
     // Try our secondary cache
     bool kept_in_sec_cache = false;
@@ -197,6 +301,13 @@ void CacheWithSecondaryAdapter::StartAsyncLookup(
     async_handle.found_dummy_entry |= ProcessDummyResult(
         &async_handle.result_handle, /*erase=*/secondary_compatible);
 
+    if (async_handle.Result() == nullptr && secondary_compatible &&
+        !async_handle.found_dummy_entry) {
+      async_handle.found_dummy_entry = CheckDeferredDummyHint(
+          async_handle.key, async_handle.helper, async_handle.create_context,
+          async_handle.priority, async_handle.stats,
+          &async_handle.result_handle);
+    }
     if (async_handle.Result() == nullptr && secondary_compatible) {
       // Not found and not pending on another secondary cache
       StartAsyncLookupOnMySecondary(async_handle);
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <string>
+
+#include "port/port.h"
 #include "rocksdb/secondary_cache.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -46,7 +51,47 @@ class CacheWithSecondaryAdapter : public CacheWrapper {
 
   void CleanupCacheObject(ObjectPtr obj, const CacheItemHelper* helper);
 
+  // Queues the dummy entry recording recent use of `key` for the background
+  // drainer instead of inserting it in the caller's lookup. Lossy: the hint
+  // is dropped if the queue is full.
+  void DeferDummyInsert(const Slice& key, Priority priority);
+
+  // Removes a queued dummy-insert hint for `key` and reports whether one was
+  // pending (queued or being inserted right now). A pending hint counts as a
+  // found dummy entry, just as if it had been inserted synchronously.
+  bool ClaimPendingDummyHint(const Slice& key);
+
+  // Checks for a deferred dummy hint for `key` after a primary cache miss,
+  // including redoing the primary lookup for hints that were drained between
+  // the miss and the check. Sets *result if that retry surfaced a real
+  // entry. Returns whether a dummy entry should be considered found.
+  bool CheckDeferredDummyHint(const Slice& key, const CacheItemHelper* helper,
+                              CreateContext* create_context, Priority priority,
+                              Statistics* stats, Handle** result);
+
+  void DrainDeferredDummyInserts();
+
   std::shared_ptr<SecondaryCache> secondary_cache_;
+
+  struct DeferredDummyInsert {
+    std::string key;
+    Priority priority;
+  };
+
+  // Recency hints waiting to be inserted as dummy entries, drained by
+  // drain_thread_ so secondary cache hits do not pay for a primary shard
+  // insert inside the caller's lookup.
+  port::Mutex deferred_mutex_;
+  port::CondVar deferred_cv_{&deferred_mutex_};
+  std::deque<DeferredDummyInsert> deferred_dummy_inserts_;
+  // Key whose dummy insert the drainer is performing at this moment.
+  std::string in_flight_dummy_key_;
+  bool in_flight_dummy_valid_ = false;
+  // Queued plus in-flight hints; lets lookups skip deferred_mutex_ entirely
+  // when no deferred work exists.
+  std::atomic<size_t> deferred_hints_{0};
+  bool shutting_down_ = false;
+  port::Thread drain_thread_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
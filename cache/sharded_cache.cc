@@ -25,6 +25,7 @@ ShardedCacheBase::ShardedCacheBase(size_t capacity, int num_shard_bits,
     : Cache(std::move(allocator)),
       last_id_(1),
       shard_mask_((uint32_t{1} << num_shard_bits) - 1),
+      shard_lookups_(new ShardLookupCount[shard_mask_ + 1]),
       strict_capacity_limit_(strict_capacity_limit),
       capacity_(capacity) {}
 
@@ -75,6 +76,23 @@ std::string ShardedCacheBase::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "    memory_allocator : %s\n",
            memory_allocator() ? memory_allocator()->Name() : "None");
   ret.append(buffer);
+  {
+    // Report lookup skew across shards so persistent hot shards are
+    // visible in LOG. A ratio near 1.0 means even utilization.
+    uint32_t num_shards = GetNumShards();
+    uint64_t total = 0;
+    uint64_t max_count = 0;
+    for (uint32_t i = 0; i < num_shards; i++) {
+      uint64_t c = shard_lookups_[i].count.load(std::memory_order_relaxed);
+      total += c;
+      max_count = std::max(max_count, c);
+    }
+    if (total > 0) {
+      double skew = max_count * static_cast<double>(num_shards) / total;
+      snprintf(buffer, kBufferSize, "    shard_lookup_skew : %.2lf\n", skew);
+      ret.append(buffer);
+    }
+  }
   AppendPrintableOptions(ret);
   return ret;
 }
@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "port/lang.h"
@@ -125,9 +126,28 @@ class ShardedCacheBase : public Cache {
   size_t GetPerShardCapacity() const;
   size_t ComputePerShardCapacity(size_t capacity) const;
 
+  // Maps a 32-bit sharding piece of the key hash to a shard index. Applies a
+  // finalizing mix before taking the low bits so that structured key
+  // populations (e.g. the blocks of one huge SST file, whose cache keys
+  // share most of their bytes) cannot alias into a few hot shards through
+  // whatever bias survives in the piece.
+  uint32_t ShardIndex(uint32_t hash_piece) const {
+    uint32_t mixed = hash_piece * 0x9E3779B9U;
+    mixed ^= mixed >> 16;
+    return mixed & shard_mask_;
+  }
+
+  // Relaxed per-shard lookup counters, one cache line each so concurrent
+  // bumps of neighboring shards do not false-share. Reported by
+  // GetPrintableOptions so hot shards show up in LOG.
+  struct ALIGN_AS(CACHE_LINE_SIZE) ShardLookupCount {
+    std::atomic<uint64_t> count{0};
+  };
+
  protected:                        // data
   std::atomic<uint64_t> last_id_;  // For NewId
   const uint32_t shard_mask_;
+  const std::unique_ptr<ShardLookupCount[]> shard_lookups_;
 
   // Dynamic configuration parameters, guarded by config_mutex_
   bool strict_capacity_limit_;
@@ -164,11 +184,11 @@ class ShardedCache : public ShardedCacheBase {
   }
 
   CacheShard& GetShard(HashCref hash) {
-    return shards_[CacheShard::HashPieceForSharding(hash) & shard_mask_];
+    return shards_[ShardIndex(CacheShard::HashPieceForSharding(hash))];
   }
 
   const CacheShard& GetShard(HashCref hash) const {
-    return shards_[CacheShard::HashPieceForSharding(hash) & shard_mask_];
+    return shards_[ShardIndex(CacheShard::HashPieceForSharding(hash))];
   }
 
   void SetCapacity(size_t capacity) override {
@@ -218,8 +238,11 @@ class ShardedCache : public ShardedCacheBase {
                  Priority priority = Priority::LOW,
                  Statistics* stats = nullptr) override {
     HashVal hash = CacheShard::ComputeHash(key);
-    HandleImpl* result = GetShard(hash).Lookup(key, hash, helper,
-                                               create_context, priority, stats);
+    uint32_t shard_idx = ShardIndex(CacheShard::HashPieceForSharding(hash));
+    shard_lookups_[shard_idx].count.fetch_add(1, std::memory_order_relaxed);
+    HandleImpl* result = shards_[shard_idx].Lookup(key, hash, helper,
+                                                   create_context, priority,
+                                                   stats);
     return reinterpret_cast<Handle*>(result);
   }
 
@@ -44,12 +44,73 @@ void ArenaWrappedDBIter::Init(
                        sequence, true, max_sequential_skip_in_iteration,
                        read_callback, db_impl, cfd, expose_blob_index);
   sv_number_ = version_number;
+  read_seq_ = sequence;
   read_options_ = read_options;
   allow_refresh_ = allow_refresh;
   memtable_range_tombstone_iter_ = nullptr;
   if (!env->GetFileSystem()->use_async_io()) {
     read_options_.async_io = false;
   }
+  // Auto refresh rebuilds the iterator tree at read_seq_, so it is only safe
+  // when that sequence is pinned by a snapshot. User-defined timestamps are
+  // excluded because the re-seek key would need the timestamp re-appended.
+  // Note this is independent of allow_refresh: manual Refresh() is disallowed
+  // with a snapshot because it moves to the latest sequence, while auto
+  // refresh keeps the sequence fixed.
+  auto_refresh_ = read_options.auto_refresh_iterator &&
+                  read_options.snapshot != nullptr &&
+                  read_options.timestamp == nullptr;
+  auto_refresh_op_count_ = 0;
+}
+
+void ArenaWrappedDBIter::ReInit(SequenceNumber sequence, uint64_t sv_number) {
+  assert(db_impl_ != nullptr && cfd_ != nullptr);
+  Env* env = db_iter_->env();
+  db_iter_->~DBIter();
+  arena_.~Arena();
+  new (&arena_) Arena();
+
+  SuperVersion* sv = cfd_->GetReferencedSuperVersion(db_impl_);
+  Init(env, read_options_, *(cfd_->ioptions()), sv->mutable_cf_options,
+       sv->current, sequence,
+       sv->mutable_cf_options.max_sequential_skip_in_iterations, sv_number,
+       read_callback_, db_impl_, cfd_, expose_blob_index_, allow_refresh_);
+
+  InternalIterator* internal_iter = db_impl_->NewInternalIterator(
+      read_options_, cfd_, sv, &arena_, sequence,
+      /* allow_unprepared_value */ true, /* db_iter */ this);
+  SetIterUnderDBIter(internal_iter);
+}
+
+void ArenaWrappedDBIter::MaybeAutoRefresh(bool forward) {
+  assert(auto_refresh_);
+  if (++auto_refresh_op_count_ < kAutoRefreshCheckInterval) {
+    return;
+  }
+  auto_refresh_op_count_ = 0;
+  if (db_impl_ == nullptr || cfd_ == nullptr) {
+    return;
+  }
+  uint64_t cur_sv_number = cfd_->GetSuperVersionNumber();
+  if (cur_sv_number == sv_number_) {
+    return;
+  }
+  if (!db_iter_->Valid() || !db_iter_->status().ok()) {
+    // Refreshing at an iteration boundary would not release anything the
+    // caller still observes, but there is no position to restore.
+    return;
+  }
+  // Save the current user key, rebuild the iterator tree on the newest
+  // super-version at the original sequence, and land back on the same key.
+  // The snapshot guarantees the key's visible version still exists, so the
+  // refresh is invisible to the caller.
+  std::string saved_key = db_iter_->key().ToString();
+  ReInit(read_seq_, cur_sv_number);
+  if (forward) {
+    db_iter_->Seek(saved_key);
+  } else {
+    db_iter_->SeekForPrev(saved_key);
+  }
 }
 
 Status ArenaWrappedDBIter::Refresh() {
@@ -64,26 +125,11 @@ Status ArenaWrappedDBIter::Refresh() {
   TEST_SYNC_POINT("ArenaWrappedDBIter::Refresh:1");
   TEST_SYNC_POINT("ArenaWrappedDBIter::Refresh:2");
   auto reinit_internal_iter = [&]() {
-    Env* env = db_iter_->env();
-    db_iter_->~DBIter();
-    arena_.~Arena();
-    new (&arena_) Arena();
-
-    SuperVersion* sv = cfd_->GetReferencedSuperVersion(db_impl_);
     SequenceNumber latest_seq = db_impl_->GetLatestSequenceNumber();
     if (read_callback_) {
       read_callback_->Refresh(latest_seq);
     }
-    Init(env, read_options_, *(cfd_->ioptions()), sv->mutable_cf_options,
-         sv->current, latest_seq,
-         sv->mutable_cf_options.max_sequential_skip_in_iterations,
-         cur_sv_number, read_callback_, db_impl_, cfd_, expose_blob_index_,
-         allow_refresh_);
-
-    InternalIterator* internal_iter = db_impl_->NewInternalIterator(
-        read_options_, cfd_, sv, &arena_, latest_seq,
-        /* allow_unprepared_value */ true, /* db_iter */ this);
-    SetIterUnderDBIter(internal_iter);
+    ReInit(latest_seq, cur_sv_number);
   };
   while (true) {
     if (sv_number_ != cur_sv_number) {
@@ -153,7 +199,10 @@ ArenaWrappedDBIter* NewArenaWrappedDbIterator(
   iter->Init(env, read_options, ioptions, mutable_cf_options, version, sequence,
              max_sequential_skip_in_iterations, version_number, read_callback,
              db_impl, cfd, expose_blob_index, allow_refresh);
-  if (db_impl != nullptr && cfd != nullptr && allow_refresh) {
+  // Auto refresh needs the refresh info even when manual Refresh() is
+  // disallowed (it is, whenever a snapshot is set).
+  if (db_impl != nullptr && cfd != nullptr &&
+      (allow_refresh || read_options.auto_refresh_iterator)) {
     iter->StoreRefreshInfo(db_impl, cfd, read_callback, expose_blob_index);
   }
 
@@ -35,11 +35,11 @@ class Version;
 // the same as the inner DBIter.
 class ArenaWrappedDBIter : public Iterator {
  public:
+  // db_iter_ is null only when Init() was never called or when a
+  // RecyclableDBIter released the shared DBIter it does not own.
   ~ArenaWrappedDBIter() override {
     if (db_iter_ != nullptr) {
       db_iter_->~DBIter();
-    } else {
-      assert(false);
     }
   }
 
@@ -47,6 +47,9 @@ class ArenaWrappedDBIter : public Iterator {
   // as well as child iterators in it.
   virtual Arena* GetArena() { return &arena_; }
 
+  // The DBIter allocated inside this iterator's arena.
+  DBIter* GetDBIter() const { return db_iter_; }
+
   const ReadOptions& GetReadOptions() { return read_options_; }
 
   // Set the internal iterator wrapped inside the DB Iterator. Usually it is
@@ -65,11 +68,28 @@ class ArenaWrappedDBIter : public Iterator {
   // 'target' does not contain timestamp, even if user timestamp feature is
   // enabled.
   void Seek(const Slice& target) override { db_iter_->Seek(target); }
+  void SeekAsync(const Slice& target,
+                 std::function<void(Iterator*)> callback) override {
+    // rebind the callback so it observes this wrapper, not the inner DBIter
+    db_iter_->SeekAsync(
+        target, [this, cb = std::move(callback)](Iterator*) { cb(this); });
+  }
+  void SeekAwait() override { db_iter_->SeekAwait(); }
   void SeekForPrev(const Slice& target) override {
     db_iter_->SeekForPrev(target);
   }
-  void Next() override { db_iter_->Next(); }
-  void Prev() override { db_iter_->Prev(); }
+  void Next() override {
+    db_iter_->Next();
+    if (auto_refresh_) {
+      MaybeAutoRefresh(true /* forward */);
+    }
+  }
+  void Prev() override {
+    db_iter_->Prev();
+    if (auto_refresh_) {
+      MaybeAutoRefresh(false /* forward */);
+    }
+  }
   Slice key() const override { return db_iter_->key(); }
   Slice value() const override { return db_iter_->value(); }
   const WideColumns& columns() const override { return db_iter_->columns(); }
@@ -99,8 +119,25 @@ class ArenaWrappedDBIter : public Iterator {
     expose_blob_index_ = expose_blob_index;
   }
 
- private:
+ protected:
   DBIter* db_iter_ = nullptr;
+
+ private:
+  // Tear down the current DBIter and internal iterator tree and rebuild them
+  // on the column family's newest super-version, reading at `sequence`.
+  // Requires db_impl_ and cfd_ to be set.
+  void ReInit(SequenceNumber sequence, uint64_t sv_number);
+
+  // Called between user keys when ReadOptions::auto_refresh_iterator is in
+  // effect. If the pinned super-version became stale, rebuilds the iterator
+  // tree at the original read sequence and re-seeks to the current key, so
+  // the refresh is invisible to the caller.
+  void MaybeAutoRefresh(bool forward);
+
+  // Only probe the super-version number every this many Next()/Prev() calls,
+  // to keep the per-key cost of auto refresh negligible.
+  static constexpr uint32_t kAutoRefreshCheckInterval = 1024;
+
   Arena arena_;
   uint64_t sv_number_;
   ColumnFamilyData* cfd_ = nullptr;
@@ -109,11 +146,55 @@ class ArenaWrappedDBIter : public Iterator {
   ReadCallback* read_callback_;
   bool expose_blob_index_ = false;
   bool allow_refresh_ = true;
+  // Sequence number this iterator reads at; used to rebuild the iterator
+  // tree with unchanged visibility on auto refresh.
+  SequenceNumber read_seq_ = kMaxSequenceNumber;
+  bool auto_refresh_ = false;
+  uint32_t auto_refresh_op_count_ = 0;
   // If this is nullptr, it means the mutable memtable does not contain range
   // tombstone when added under this DBIter.
   TruncatedRangeDelIterator** memtable_range_tombstone_iter_ = nullptr;
 };
 
+// Handed out by DBImpl::NewIterator() when DBOptions::recycle_iterators is
+// set and the iterator is eligible for the per-column-family iterator pool.
+// It shares the inner ArenaWrappedDBIter's DBIter, so every accessor
+// inherited from ArenaWrappedDBIter operates on the inner iterator tree with
+// no extra indirection. On destruction the inner iterator is offered back to
+// the pool (DBImpl::RecycleIterator()) instead of being destroyed, so that a
+// later NewIterator() call with compatible ReadOptions can rebind it to the
+// current super-version with Refresh() instead of rebuilding the whole
+// iterator tree.
+class RecyclableDBIter : public ArenaWrappedDBIter {
+ public:
+  RecyclableDBIter(DBImpl* db_impl, uint32_t cf_id, ArenaWrappedDBIter* inner)
+      : db_impl_(db_impl), cf_id_(cf_id), inner_(inner) {
+    db_iter_ = inner_->GetDBIter();
+  }
+
+  ~RecyclableDBIter() override {
+    // The shared DBIter is owned by inner_, which is handed back to the pool.
+    db_iter_ = nullptr;
+    db_impl_->RecycleIterator(cf_id_, inner_);
+  }
+
+  Status GetProperty(std::string prop_name, std::string* prop) override {
+    return inner_->GetProperty(std::move(prop_name), prop);
+  }
+
+  Status Refresh() override {
+    Status s = inner_->Refresh();
+    // Refresh() may have reconstructed the DBIter inside inner_'s arena.
+    db_iter_ = inner_->GetDBIter();
+    return s;
+  }
+
+ private:
+  DBImpl* db_impl_;
+  uint32_t cf_id_;
+  ArenaWrappedDBIter* inner_;
+};
+
 // Generate the arena wrapped iterator class.
 // `db_impl` and `cfd` are used for reneweal. If left null, renewal will not
 // be supported.
@@ -20,6 +20,7 @@
 #include "file/read_write_util.h"
 #include "file/writable_file_writer.h"
 #include "logging/logging.h"
+#include "monitoring/histogram.h"
 #include "options/cf_options.h"
 #include "options/options_helper.h"
 #include "rocksdb/slice.h"
@@ -41,13 +42,14 @@ BlobFileBuilder::BlobFileBuilder(
     BlobFileCompletionCallback* blob_callback,
     BlobFileCreationReason creation_reason,
     std::vector<std::string>* blob_file_paths,
-    std::vector<BlobFileAddition>* blob_file_additions)
+    std::vector<BlobFileAddition>* blob_file_additions,
+    HistogramImpl* value_size_histogram)
     : BlobFileBuilder([versions]() { return versions->NewFileNumber(); }, fs,
                       immutable_options, mutable_cf_options, file_options,
                       db_id, db_session_id, job_id, column_family_id,
                       column_family_name, io_priority, write_hint, io_tracer,
                       blob_callback, creation_reason, blob_file_paths,
-                      blob_file_additions) {}
+                      blob_file_additions, value_size_histogram) {}
 
 BlobFileBuilder::BlobFileBuilder(
     std::function<uint64_t()> file_number_generator, FileSystem* fs,
@@ -60,7 +62,8 @@ BlobFileBuilder::BlobFileBuilder(
     BlobFileCompletionCallback* blob_callback,
     BlobFileCreationReason creation_reason,
     std::vector<std::string>* blob_file_paths,
-    std::vector<BlobFileAddition>* blob_file_additions)
+    std::vector<BlobFileAddition>* blob_file_additions,
+    HistogramImpl* value_size_histogram)
     : file_number_generator_(std::move(file_number_generator)),
       fs_(fs),
       immutable_options_(immutable_options),
@@ -81,6 +84,7 @@ BlobFileBuilder::BlobFileBuilder(
       creation_reason_(creation_reason),
       blob_file_paths_(blob_file_paths),
       blob_file_additions_(blob_file_additions),
+      value_size_histogram_(value_size_histogram),
       blob_count_(0),
       blob_bytes_(0) {
   assert(file_number_generator_);
@@ -91,6 +95,25 @@ BlobFileBuilder::BlobFileBuilder(
   assert(blob_file_paths_->empty());
   assert(blob_file_additions_);
   assert(blob_file_additions_->empty());
+
+  const double inline_ratio = mutable_cf_options->blob_adaptive_inline_ratio;
+  if (inline_ratio > 0.0 && value_size_histogram_ &&
+      !value_size_histogram_->Empty()) {
+    // Derive the separation threshold from the value sizes observed so far,
+    // so that approximately inline_ratio of the values stays inline.
+    // min_blob_size acts as a lower bound on the derived threshold.
+    const uint64_t adaptive_threshold = static_cast<uint64_t>(
+        value_size_histogram_->Percentile(inline_ratio * 100.0));
+    if (adaptive_threshold > min_blob_size_) {
+      min_blob_size_ = adaptive_threshold;
+    }
+    ROCKS_LOG_INFO(immutable_options_->logger,
+                   "[%s] [JOB %d] Adaptive blob separation threshold: %" PRIu64
+                   " (min_blob_size: %" PRIu64
+                   ", blob_adaptive_inline_ratio: %f)",
+                   column_family_name_.c_str(), job_id_, min_blob_size_,
+                   mutable_cf_options->min_blob_size, inline_ratio);
+  }
 }
 
 BlobFileBuilder::~BlobFileBuilder() = default;
@@ -100,6 +123,10 @@ Status BlobFileBuilder::Add(const Slice& key, const Slice& value,
   assert(blob_index);
   assert(blob_index->empty());
 
+  if (value_size_histogram_) {
+    value_size_histogram_->Add(value.size());
+  }
+
   if (value.size() < min_blob_size_) {
     return Status::OK();
   }
@@ -30,6 +30,7 @@ class Slice;
 class BlobLogWriter;
 class IOTracer;
 class BlobFileCompletionCallback;
+class HistogramImpl;
 
 class BlobFileBuilder {
  public:
@@ -46,7 +47,8 @@ class BlobFileBuilder {
                   BlobFileCompletionCallback* blob_callback,
                   BlobFileCreationReason creation_reason,
                   std::vector<std::string>* blob_file_paths,
-                  std::vector<BlobFileAddition>* blob_file_additions);
+                  std::vector<BlobFileAddition>* blob_file_additions,
+                  HistogramImpl* value_size_histogram = nullptr);
 
   BlobFileBuilder(std::function<uint64_t()> file_number_generator,
                   FileSystem* fs, const ImmutableOptions* immutable_options,
@@ -61,7 +63,8 @@ class BlobFileBuilder {
                   BlobFileCompletionCallback* blob_callback,
                   BlobFileCreationReason creation_reason,
                   std::vector<std::string>* blob_file_paths,
-                  std::vector<BlobFileAddition>* blob_file_additions);
+                  std::vector<BlobFileAddition>* blob_file_additions,
+                  HistogramImpl* value_size_histogram = nullptr);
 
   BlobFileBuilder(const BlobFileBuilder&) = delete;
   BlobFileBuilder& operator=(const BlobFileBuilder&) = delete;
@@ -69,6 +72,11 @@ class BlobFileBuilder {
   ~BlobFileBuilder();
 
   Status Add(const Slice& key, const Slice& value, std::string* blob_index);
+
+  // The separation threshold in effect for this builder. Matches
+  // min_blob_size unless blob_adaptive_inline_ratio is in effect.
+  uint64_t effective_min_blob_size() const { return min_blob_size_; }
+
   Status Finish();
   void Abandon(const Status& s);
 
@@ -104,6 +112,7 @@ class BlobFileBuilder {
   BlobFileCreationReason creation_reason_;
   std::vector<std::string>* blob_file_paths_;
   std::vector<BlobFileAddition>* blob_file_additions_;
+  HistogramImpl* value_size_histogram_;
   std::unique_ptr<BlobLogWriter> writer_;
   uint64_t blob_count_;
   uint64_t blob_bytes_;
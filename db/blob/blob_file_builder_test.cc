@@ -16,6 +16,7 @@
 #include "db/blob/blob_log_format.h"
 #include "db/blob/blob_log_sequential_reader.h"
 #include "env/mock_env.h"
+#include "monitoring/histogram.h"
 #include "file/filename.h"
 #include "file/random_access_file_reader.h"
 #include "options/cf_options.h"
@@ -341,6 +342,76 @@ TEST_F(BlobFileBuilderTest, InlinedValues) {
   ASSERT_TRUE(blob_file_additions.empty());
 }
 
+TEST_F(BlobFileBuilderTest, AdaptiveThreshold) {
+  // With blob_adaptive_inline_ratio set, the separation threshold is derived
+  // from the value-size histogram: small values from the bimodal distribution
+  // stay inline while large ones get separated, even though min_blob_size
+  // alone would separate everything.
+  constexpr size_t small_value_size = 100;
+  constexpr size_t large_value_size = 50000;
+
+  Options options;
+  options.cf_paths.emplace_back(
+      test::PerThreadDBPath(mock_env_.get(),
+                            "BlobFileBuilderTest_AdaptiveThreshold"),
+      0);
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+  options.blob_adaptive_inline_ratio = 0.9;
+  options.env = mock_env_.get();
+
+  ImmutableOptions immutable_options(options);
+  MutableCFOptions mutable_cf_options(options);
+
+  constexpr int job_id = 1;
+  constexpr uint32_t column_family_id = 123;
+  constexpr char column_family_name[] = "foobar";
+  constexpr Env::IOPriority io_priority = Env::IO_HIGH;
+  constexpr Env::WriteLifeTimeHint write_hint = Env::WLTH_MEDIUM;
+
+  // Bimodal history: 90% small values, 10% large ones.
+  HistogramImpl value_size_histogram;
+  for (size_t i = 0; i < 90; ++i) {
+    value_size_histogram.Add(small_value_size);
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    value_size_histogram.Add(large_value_size);
+  }
+
+  std::vector<std::string> blob_file_paths;
+  std::vector<BlobFileAddition> blob_file_additions;
+
+  BlobFileBuilder builder(
+      TestFileNumberGenerator(), fs_, &immutable_options, &mutable_cf_options,
+      &file_options_, "" /*db_id*/, "" /*db_session_id*/, job_id,
+      column_family_id, column_family_name, io_priority, write_hint,
+      nullptr /*IOTracer*/, nullptr /*BlobFileCompletionCallback*/,
+      BlobFileCreationReason::kFlush, &blob_file_paths, &blob_file_additions,
+      &value_size_histogram);
+
+  ASSERT_GT(builder.effective_min_blob_size(), small_value_size);
+  ASSERT_LE(builder.effective_min_blob_size(), large_value_size);
+
+  const std::string small_value(small_value_size, 'a');
+  const std::string large_value(large_value_size, 'b');
+
+  std::string blob_index;
+  ASSERT_OK(builder.Add("1", small_value, &blob_index));
+  ASSERT_TRUE(blob_index.empty());
+
+  blob_index.clear();
+  ASSERT_OK(builder.Add("2", large_value, &blob_index));
+  ASSERT_FALSE(blob_index.empty());
+
+  ASSERT_OK(builder.Finish());
+
+  ASSERT_EQ(blob_file_additions.size(), 1);
+  ASSERT_EQ(blob_file_additions[0].GetTotalBlobCount(), 1);
+
+  // The builder feeds the sizes it sees back into the histogram.
+  ASSERT_EQ(value_size_histogram.num(), 102);
+}
+
 TEST_F(BlobFileBuilderTest, Compression) {
   // Build a blob file with a compressed blob
   if (!Snappy_Supported()) {
@@ -431,6 +431,82 @@ TEST_F(BlobFileReaderTest, CreateReaderAndGetBlob) {
   }
 }
 
+TEST_F(BlobFileReaderTest, MultiGetBlobSparse) {
+  // Request blobs that are more than the coalescing gap apart, so that the
+  // batch cannot be served by a single merged file read.
+
+  Options options;
+  options.env = mock_env_.get();
+  options.cf_paths.emplace_back(
+      test::PerThreadDBPath(mock_env_.get(),
+                            "BlobFileReaderTest_MultiGetBlobSparse"),
+      0);
+  options.enable_blob_files = true;
+
+  ImmutableOptions immutable_options(options);
+
+  constexpr uint32_t column_family_id = 1;
+  constexpr bool has_ttl = false;
+  constexpr ExpirationRange expiration_range;
+  constexpr uint64_t blob_file_number = 1;
+  const std::vector<std::string> key_strs = {"key1", "key2", "key3"};
+  // The middle blob is larger than the coalescing gap, so reading the first
+  // and the last one requires two separate file reads.
+  const std::vector<std::string> blob_strs = {
+      "blob1", std::string(16 << 10, 'x'), "blob3"};
+
+  const std::vector<Slice> keys = {key_strs[0], key_strs[1], key_strs[2]};
+  const std::vector<Slice> blobs = {blob_strs[0], blob_strs[1], blob_strs[2]};
+
+  std::vector<uint64_t> blob_offsets(keys.size());
+  std::vector<uint64_t> blob_sizes(keys.size());
+
+  WriteBlobFile(immutable_options, column_family_id, has_ttl, expiration_range,
+                expiration_range, blob_file_number, keys, blobs, kNoCompression,
+                blob_offsets, blob_sizes);
+
+  constexpr HistogramImpl* blob_file_read_hist = nullptr;
+
+  std::unique_ptr<BlobFileReader> reader;
+
+  ASSERT_OK(BlobFileReader::Create(
+      immutable_options, FileOptions(), column_family_id, blob_file_read_hist,
+      blob_file_number, nullptr /*IOTracer*/, &reader));
+
+  ReadOptions read_options;
+  read_options.verify_checksums = true;
+
+  constexpr MemoryAllocator* allocator = nullptr;
+
+  std::array<Status, 2> statuses_buf;
+  std::array<BlobReadRequest, 2> requests_buf;
+  requests_buf[0] = BlobReadRequest(keys[0], blob_offsets[0], blob_sizes[0],
+                                    kNoCompression, nullptr, &statuses_buf[0]);
+  requests_buf[1] = BlobReadRequest(keys[2], blob_offsets[2], blob_sizes[2],
+                                    kNoCompression, nullptr, &statuses_buf[1]);
+
+  autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>
+      blob_reqs;
+  blob_reqs.emplace_back(&requests_buf[0], std::unique_ptr<BlobContents>());
+  blob_reqs.emplace_back(&requests_buf[1], std::unique_ptr<BlobContents>());
+
+  uint64_t bytes_read = 0;
+  reader->MultiGetBlob(read_options, allocator, blob_reqs, &bytes_read);
+
+  ASSERT_OK(statuses_buf[0]);
+  ASSERT_NE(blob_reqs[0].second, nullptr);
+  ASSERT_EQ(blob_reqs[0].second->data(), blobs[0]);
+  ASSERT_OK(statuses_buf[1]);
+  ASSERT_NE(blob_reqs[1].second, nullptr);
+  ASSERT_EQ(blob_reqs[1].second->data(), blobs[2]);
+
+  const uint64_t expected_bytes =
+      blob_sizes[0] + blob_sizes[2] +
+      BlobLogRecord::CalculateAdjustmentForRecordHeader(keys[0].size()) +
+      BlobLogRecord::CalculateAdjustmentForRecordHeader(keys[2].size());
+  ASSERT_EQ(bytes_read, expected_bytes);
+}
+
 TEST_F(BlobFileReaderTest, Malformed) {
   // Write a blob file consisting of nothing but a header, and make sure we
   // detect the error when we open it for reading
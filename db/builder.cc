@@ -39,6 +39,7 @@
 #include "file/file_util.h"
 #include "file/filename.h"
 #include "file/read_write_util.h"
+#include "file/sst_file_manager_impl.h"
 #include "file/writable_file_writer.h"
 #include "monitoring/iostats_context_imp.h"
 #include "monitoring/thread_status_util.h"
@@ -87,7 +88,8 @@ Status BuildTable(
     const std::string* full_history_ts_low,
     BlobFileCompletionCallback* blob_callback, Version* version,
     uint64_t* num_input_entries, uint64_t* memtable_payload_bytes,
-    uint64_t* memtable_garbage_bytes) {
+    uint64_t* memtable_garbage_bytes,
+    HistogramImpl* blob_value_size_histogram) {
   assert((tboptions.column_family_id ==
           TablePropertiesCollectorFactory::Context::kUnknownColumnFamily) ==
          tboptions.column_family_name.empty());
@@ -183,12 +185,20 @@ Status BuildTable(
           std::move(file), fname, file_options, ioptions.clock, io_tracer,
           ioptions.stats, ioptions.listeners,
           ioptions.file_checksum_gen_factory.get(),
-          tmp_set.Contains(FileType::kTableFile), false));
+          tmp_set.Contains(FileType::kTableFile), false,
+          static_cast<SstFileManagerImpl*>(ioptions.sst_file_manager.get())));
 
       builder = NewTableBuilder(tboptions, file_writer.get());
     }
 
     auto ucmp = tboptions.internal_comparator.user_comparator();
+    // Note that flushing through CompactionIterator also collapses merge
+    // chains: MergeUntil() partial-merges consecutive operands of a key
+    // within each snapshot stripe (for operators implementing
+    // PartialMergeMulti()), so long chains of associative operands are
+    // pre-aggregated before they ever reach L0 rather than waiting for the
+    // first compaction. Full merge down to a value is not possible here since
+    // older entries for the key may exist below L0.
     MergeHelper merge(
         env, ucmp, ioptions.merge_operator.get(), compaction_filter.get(),
         ioptions.logger, true /* internal key corruption is not ok */,
@@ -204,7 +214,8 @@ Status BuildTable(
                   tboptions.db_id, tboptions.db_session_id, job_id,
                   tboptions.column_family_id, tboptions.column_family_name,
                   io_priority, write_hint, io_tracer, blob_callback,
-                  blob_creation_reason, &blob_file_paths, blob_file_additions)
+                  blob_creation_reason, &blob_file_paths, blob_file_additions,
+                  blob_value_size_histogram)
             : nullptr);
 
     const std::atomic<bool> kManualCompactionCanceledFalse{false};
@@ -1150,6 +1150,30 @@ int main(int argc, char** argv) {
     CheckMultiGetValues(3, vals, vals_sizes, errs, expected);
   }
 
+  StartPhase("multiget_pinned");
+  {
+    const char* keys[3] = {"box", "foo", "notfound"};
+    const size_t keys_sizes[3] = {3, 3, 8};
+    char* errs[3];
+    const char* expected[3] = {"c", "hello", NULL};
+
+    rocksdb_pinnableslice_t* pvals[3];
+    rocksdb_multi_get_pinned(db, roptions, 3, keys, keys_sizes, pvals, errs,
+                             false);
+    int i;
+    for (i = 0; i < 3; ++i) {
+      CheckNoError(errs[i]);
+      if (expected[i] == NULL) {
+        CheckCondition(pvals[i] == NULL);
+      } else {
+        size_t val_len;
+        const char* val = rocksdb_pinnableslice_value(pvals[i], &val_len);
+        CheckEqual(expected[i], val, val_len);
+        rocksdb_pinnableslice_destroy(pvals[i]);
+      }
+    }
+  }
+
   StartPhase("pin_get");
   {
     CheckPinGet(db, roptions, "box", "c");
@@ -576,6 +576,10 @@ ColumnFamilyData::ColumnFamilyData(
       db_paths_registered_(false),
       mempurge_used_(false),
       next_epoch_number_(1) {
+  // CoreLocalArray does not value-initialize its elements
+  for (size_t i = 0; i < standby_sv_.Size(); ++i) {
+    standby_sv_.AccessAtCore(i)->store(nullptr, std::memory_order_relaxed);
+  }
   if (id_ != kDummyColumnFamilyDataId) {
     // TODO(cc): RegisterDbPaths can be expensive, considering moving it
     // outside of this constructor which might be called with db mutex held.
@@ -753,6 +757,9 @@ bool ColumnFamilyData::UnrefAndTryDelete() {
     SuperVersion* sv = super_version_;
     super_version_ = nullptr;
 
+    // Release SuperVersion references parked per core.
+    DrainStandbySuperVersions();
+
     // Release SuperVersion references kept in ThreadLocalPtr.
     local_sv_.reset();
 
@@ -776,6 +783,9 @@ void ColumnFamilyData::SetDropped() {
 
   // remove from column_family_set
   column_family_set_->RemoveColumnFamily(this);
+  // The catalog must drop its ref here, not in RemoveColumnFamily() -- the
+  // latter also runs from ~ColumnFamilyData, where re-refing would be fatal.
+  column_family_set_->RefreshCatalog();
 }
 
 ColumnFamilyOptions ColumnFamilyData::GetLatestCFOptions() const {
@@ -930,7 +940,7 @@ void ColumnFamilyData::DynamicSetupDelay(
     write_rate = WriteController::kMinWriteRate;
   }
 
-  UpdateCFRate(this, write_rate);
+  UpdateCFRate(this, write_rate, mutable_cf_options.write_delay_weight);
 }
 
 std::pair<WriteStallCondition, WriteStallCause>
@@ -1083,6 +1093,27 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
       }
     }
 
+    // Remember what triggered the computed condition so that stall
+    // notifications and the stall timeline can attribute the transition if
+    // this turns out to be one (see InstallSuperVersion()).
+    write_stall_cause_ = (write_stall_condition == WriteStallCondition::kNormal)
+                             ? WriteStallCause::kNone
+                             : write_stall_cause;
+    switch (write_stall_cause_) {
+      case WriteStallCause::kMemtableLimit:
+        write_stall_trigger_value_ = imm()->NumNotFlushed();
+        break;
+      case WriteStallCause::kL0FileCountLimit:
+        write_stall_trigger_value_ = vstorage->l0_delay_trigger_count();
+        break;
+      case WriteStallCause::kPendingCompactionBytes:
+        write_stall_trigger_value_ = compaction_needed_bytes;
+        break;
+      default:
+        write_stall_trigger_value_ = 0;
+        break;
+    }
+
     if (write_stall_condition == WriteStallCondition::kStopped &&
         write_stall_cause == WriteStallCause::kMemtableLimit) {
       write_controller_token_ = write_controller->GetStopToken();
@@ -1411,18 +1442,39 @@ SuperVersion* ColumnFamilyData::GetThreadLocalSuperVersion(DBImpl* db) {
       sv->version_number != super_version_number_.load()) {
     RecordTick(ioptions_.stats, NUMBER_SUPERVERSION_ACQUIRES);
     SuperVersion* sv_to_delete = nullptr;
+    SuperVersion* stale_sv = nullptr;
+
+    if (sv == SuperVersion::kSVObsolete) {
+      // Common case on a memtable switch: the install scraped the cached
+      // entry. Try the reference parked for this core by the last install
+      // and skip the DB mutex entirely.
+      std::atomic<SuperVersion*>* slot = standby_sv_.Access();
+      SuperVersion* standby = slot->exchange(nullptr, std::memory_order_acquire);
+      if (standby != nullptr) {
+        if (standby->version_number == super_version_number_.load()) {
+          return standby;
+        }
+        // Lost a race with yet another install; dispose of the stale
+        // parked reference below.
+        if (standby->Unref()) {
+          stale_sv = standby;
+        }
+      }
+    } else if (sv->Unref()) {
+      stale_sv = sv;
+    }
 
-    if (sv != SuperVersion::kSVObsolete && sv->Unref()) {
+    if (stale_sv != nullptr) {
       RecordTick(ioptions_.stats, NUMBER_SUPERVERSION_CLEANUPS);
       db->mutex()->Lock();
       // NOTE: underlying resources held by superversion (sst files) might
       // not be released until the next background job.
-      sv->Cleanup();
+      stale_sv->Cleanup();
       if (db->immutable_db_options().avoid_unnecessary_blocking_io) {
-        db->AddSuperVersionsToFreeQueue(sv);
+        db->AddSuperVersionsToFreeQueue(stale_sv);
         db->SchedulePurge();
       } else {
-        sv_to_delete = sv;
+        sv_to_delete = stale_sv;
       }
     } else {
       db->mutex()->Lock();
@@ -1497,13 +1549,43 @@ void ColumnFamilyData::InstallSuperVersion(
         new_superversion->write_stall_condition) {
       sv_context->PushWriteStallNotification(
           old_superversion->write_stall_condition,
-          new_superversion->write_stall_condition, GetName(), ioptions());
+          new_superversion->write_stall_condition, GetName(),
+          write_stall_cause_, write_stall_trigger_value_, ioptions());
+      column_family_set_->write_stall_timeline()->Record(
+          GetName(), old_superversion->write_stall_condition,
+          new_superversion->write_stall_condition, write_stall_cause_,
+          write_stall_trigger_value_, ioptions_.clock);
     }
     if (old_superversion->Unref()) {
       old_superversion->Cleanup();
       sv_context->superversions_to_free.push_back(old_superversion);
     }
   }
+  ParkStandbySuperVersions(sv_context);
+}
+
+void ColumnFamilyData::ParkStandbySuperVersions(
+    SuperVersionContext* sv_context) {
+  for (size_t i = 0; i < standby_sv_.Size(); ++i) {
+    SuperVersion* old = standby_sv_.AccessAtCore(i)->exchange(
+        super_version_->Ref(), std::memory_order_acq_rel);
+    if (old != nullptr && old->Unref()) {
+      old->Cleanup();
+      sv_context->superversions_to_free.push_back(old);
+    }
+  }
+}
+
+void ColumnFamilyData::DrainStandbySuperVersions() {
+  for (size_t i = 0; i < standby_sv_.Size(); ++i) {
+    SuperVersion* parked =
+        standby_sv_.AccessAtCore(i)->exchange(nullptr,
+                                              std::memory_order_acq_rel);
+    if (parked != nullptr && parked->Unref()) {
+      parked->Cleanup();
+      delete parked;
+    }
+  }
 }
 
 void ColumnFamilyData::ResetThreadLocalSuperVersions() {
@@ -1724,12 +1806,18 @@ ColumnFamilySet::ColumnFamilySet(
   wbm_client_id_ = write_buffer_manager_->RegisterWCAndLogger(
       write_controller_, db_options_->info_log);
   wc_client_id_ = write_controller_->RegisterLogger(db_options_->info_log);
+  catalog_ = std::make_shared<const ColumnFamilyCatalog>();
 }
 
 ColumnFamilySet::~ColumnFamilySet() {
   write_buffer_manager_->DeregisterWCAndLogger(
       write_controller_, db_options_->info_log, wbm_client_id_);
   write_controller_->DeregisterLogger(db_options_->info_log, wc_client_id_);
+  // Drop the catalog's refs before draining column_family_data_, so the
+  // last_ref asserts below hold.
+  std::atomic_store(&catalog_,
+                    std::shared_ptr<const ColumnFamilyCatalog>(nullptr));
+  DrainCatalogUnrefs();
   while (column_family_data_.size() > 0) {
     // cfd destructor will delete itself from column_family_data_
     auto cfd = column_family_data_.begin()->second;
@@ -1803,12 +1891,59 @@ ColumnFamilyData* ColumnFamilySet::CreateColumnFamily(
   if (id == 0) {
     default_cfd_cache_ = new_cfd;
   }
+  RefreshCatalog();
   return new_cfd;
 }
 
-void ColumnFamilyData::UpdateCFRate(void* client_id, uint64_t write_rate) {
+void ColumnFamilySet::RefreshCatalog() {
+  DrainCatalogUnrefs();
+  auto new_catalog = new ColumnFamilyCatalog();
+  for (const auto& pair : column_family_data_) {
+    ColumnFamilyData* cfd = pair.second;
+    if (cfd->IsDropped()) {
+      continue;
+    }
+    cfd->Ref();
+    new_catalog->column_families.push_back(cfd);
+    new_catalog->by_name.emplace(cfd->GetName(), cfd);
+  }
+  std::sort(new_catalog->column_families.begin(),
+            new_catalog->column_families.end(),
+            [](const ColumnFamilyData* a, const ColumnFamilyData* b) {
+              return a->GetID() < b->GetID();
+            });
+  // The last reference to a snapshot may be released on a thread that
+  // doesn't hold the DB mutex, where UnrefAndTryDelete() is not allowed, so
+  // the deleter only queues the unrefs for a later DrainCatalogUnrefs().
+  std::shared_ptr<const ColumnFamilyCatalog> sp(
+      new_catalog, [this](const ColumnFamilyCatalog* catalog) {
+        {
+          std::lock_guard<std::mutex> lock(catalog_unref_mutex_);
+          catalog_unrefs_.insert(catalog_unrefs_.end(),
+                                 catalog->column_families.begin(),
+                                 catalog->column_families.end());
+        }
+        delete catalog;
+      });
+  std::atomic_store(&catalog_, std::move(sp));
+  DrainCatalogUnrefs();
+}
+
+void ColumnFamilySet::DrainCatalogUnrefs() {
+  std::vector<ColumnFamilyData*> to_unref;
+  {
+    std::lock_guard<std::mutex> lock(catalog_unref_mutex_);
+    to_unref.swap(catalog_unrefs_);
+  }
+  for (ColumnFamilyData* cfd : to_unref) {
+    cfd->UnrefAndTryDelete();
+  }
+}
+
+void ColumnFamilyData::UpdateCFRate(void* client_id, uint64_t write_rate,
+                                    double weight) {
   if (write_controller_ && write_controller_->is_dynamic_delay()) {
-    write_controller_->HandleNewDelayReq(client_id, write_rate);
+    write_controller_->HandleNewDelayReq(client_id, write_rate, weight);
   }
 }
 
@@ -24,6 +24,8 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -33,6 +35,8 @@
 #include "db/table_cache.h"
 #include "db/table_properties_collector.h"
 #include "db/write_batch_internal.h"
+#include "db/write_stall_timeline.h"
+#include "monitoring/histogram.h"
 #include "options/cf_options.h"
 #include "rocksdb/compaction_job_stats.h"
 #include "rocksdb/db.h"
@@ -40,6 +44,7 @@
 #include "rocksdb/options.h"
 #include "rocksdb/write_controller.h"
 #include "trace_replay/block_cache_tracer.h"
+#include "util/core_local.h"
 #include "util/hash_containers.h"
 #include "util/thread_local.h"
 
@@ -356,6 +361,14 @@ class ColumnFamilyData {
 
   InternalStats* internal_stats() { return internal_stats_.get(); }
 
+  // Online histogram of the sizes of values written to this column family,
+  // fed by blob-enabled flushes and compactions and consumed by
+  // BlobFileBuilder to derive the adaptive key-value separation threshold
+  // (see AdvancedColumnFamilyOptions::blob_adaptive_inline_ratio).
+  HistogramImpl* blob_value_size_histogram() {
+    return &blob_value_size_histogram_;
+  }
+
   MemTableList* imm() { return &imm_; }
   MemTable* mem() { return mem_; }
 
@@ -470,6 +483,15 @@ class ColumnFamilyData {
 
   void ResetThreadLocalSuperVersions();
 
+  // Park one reference of the freshly installed super version per core so
+  // that readers scraped by the install can re-acquire without the DB mutex.
+  // Only called from InstallSuperVersion().
+  void ParkStandbySuperVersions(SuperVersionContext* sv_context);
+
+  // Release all per-core parked super version references. Called during
+  // column family teardown, with the DB mutex held.
+  void DrainStandbySuperVersions();
+
   // Protected by DB mutex
   void set_queued_for_flush(bool value) {
     queued_for_flush_ = value;
@@ -508,7 +530,8 @@ class ColumnFamilyData {
   VersionStorageInfo* TEST_GetCurrentStorageInfo();
 
  private:
-  void UpdateCFRate(void* client_id, uint64_t write_rate);
+  void UpdateCFRate(void* client_id, uint64_t write_rate,
+                    double weight = 1.0);
   void ResetCFRate(void* client_id);
 
   void DynamicSetupDelay(uint64_t max_write_rate,
@@ -575,6 +598,31 @@ class ColumnFamilyData {
   // Keep track of whether the mempurge feature was ever used.
   void SetMempurgeUsed() { mempurge_used_ = true; }
   bool GetMempurgeUsed() { return mempurge_used_; }
+
+  // Smoothed garbage (overwrite) ratio of this CF's memtables as observed
+  // by past mempurge deciders, packed as (observations << 32 | percent).
+  // Used by FlushJob::MemPurgeDecider() to skip its sampling pass once the
+  // ratio is stable.
+  void UpdateMempurgeGarbagePercent(uint32_t percent) {
+    const uint64_t packed =
+        mempurge_garbage_history_.load(std::memory_order_relaxed);
+    const uint64_t observations = (packed >> 32) + 1;
+    const uint32_t old_percent = static_cast<uint32_t>(packed);
+    // equal weight on the newest observation so the ratio tracks workload
+    // changes quickly
+    const uint32_t new_percent =
+        (observations == 1) ? percent : (old_percent + percent) / 2;
+    mempurge_garbage_history_.store((observations << 32) | new_percent,
+                                    std::memory_order_relaxed);
+  }
+  uint32_t GetMempurgeGarbageObservations() const {
+    return static_cast<uint32_t>(
+        mempurge_garbage_history_.load(std::memory_order_relaxed) >> 32);
+  }
+  uint32_t GetMempurgeGarbagePercent() const {
+    return static_cast<uint32_t>(
+        mempurge_garbage_history_.load(std::memory_order_relaxed));
+  }
   uint64_t GetNumQueuedForFlush() const { return num_queued_for_flush_; }
 
   // TODO - Make it a CF option
@@ -641,6 +689,8 @@ class ColumnFamilyData {
 
   std::unique_ptr<InternalStats> internal_stats_;
 
+  HistogramImpl blob_value_size_histogram_;
+
   WriteBufferManager* write_buffer_manager_;
   std::shared_ptr<WriteController> write_controller_;
 
@@ -657,6 +707,12 @@ class ColumnFamilyData {
   // This needs to be destructed before mutex_
   std::unique_ptr<ThreadLocalPtr> local_sv_;
 
+  // Per-core parked references to super_version_, refreshed on every
+  // install. A reader whose thread-local cache was just scraped claims one
+  // with an atomic exchange instead of taking the DB mutex, which flattens
+  // the read latency spike on memtable switches.
+  CoreLocalArray<std::atomic<SuperVersion*>> standby_sv_;
+
   // pointers for a circular linked list. we use it to support iterations over
   // all column families that are alive (note: dropped column families can also
   // be alive as long as client holds a reference)
@@ -685,6 +741,13 @@ class ColumnFamilyData {
 
   uint64_t prev_compaction_needed_bytes_;
 
+  // What triggered the stall condition computed by the last
+  // RecalculateWriteStallConditions() call and the value of the triggering
+  // metric at that point, so that stall notifications and the stall timeline
+  // can attribute the transition. Both are written under the DB mutex.
+  WriteStallCause write_stall_cause_ = WriteStallCause::kNone;
+  uint64_t write_stall_trigger_value_ = 0;
+
   // if the database was opened with 2pc enabled
   bool allow_2pc_;
 
@@ -703,6 +766,9 @@ class ColumnFamilyData {
   std::shared_ptr<CacheReservationManager> file_metadata_cache_res_mgr_;
   bool mempurge_used_;
 
+  // See UpdateMempurgeGarbagePercent().
+  std::atomic<uint64_t> mempurge_garbage_history_{0};
+
   // Used in the WBM's flush initiation heuristics.
   // See DBImpl::InitiateMemoryManagerFlushRequest() for more details
   uint64_t num_queued_for_flush_ = 0U;
@@ -725,6 +791,7 @@ class ColumnFamilyData {
 // * Iteration -- hold DB mutex. If you want to release the DB mutex in the
 // body of the iteration, wrap in a RefedColumnFamilySet.
 // * GetDefault() -- thread safe
+// * GetCatalog() -- thread safe
 // * GetColumnFamily() -- either inside of DB mutex or from a write thread
 // * GetNextColumnFamilyID(), GetMaxColumnFamily(), UpdateMaxColumnFamily(),
 // NumberOfColumnFamilies -- inside of DB mutex
@@ -775,6 +842,23 @@ class ColumnFamilySet {
                                        Version* dummy_version,
                                        const ColumnFamilyOptions& options);
 
+  // An immutable snapshot of the live (non-dropped) column families, rebuilt
+  // whenever a column family is created or dropped. Each listed cfd holds a
+  // ref for the lifetime of the snapshot, so entries stay valid without the
+  // DB mutex; a cfd may still be concurrently dropped, so callers that care
+  // must check cfd->IsDropped().
+  struct ColumnFamilyCatalog {
+    // Sorted by column family ID.
+    std::vector<ColumnFamilyData*> column_families;
+    UnorderedMap<std::string, ColumnFamilyData*> by_name;
+  };
+
+  // Thread safe; does not require the DB mutex. The returned snapshot must
+  // not outlive the DB.
+  std::shared_ptr<const ColumnFamilyCatalog> GetCatalog() const {
+    return std::atomic_load(&catalog_);
+  }
+
   iterator begin() { return iterator(dummy_cfd_->next_); }
   iterator end() { return iterator(dummy_cfd_); }
 
@@ -792,12 +876,25 @@ class ColumnFamilySet {
     return write_controller_.get();
   }
 
+  WriteStallTimeline* write_stall_timeline() { return &write_stall_timeline_; }
+
  private:
   friend class ColumnFamilyData;
   // helper function that gets called from cfd destructor
   // REQUIRES: DB mutex held
   void RemoveColumnFamily(ColumnFamilyData* cfd);
 
+  // Rebuild catalog_ from column_family_data_, skipping dropped cfds.
+  // REQUIRES: DB mutex held and in single-threaded write thread
+  void RefreshCatalog();
+
+  // Release the refs of retired catalog snapshots. The last reference to a
+  // snapshot may be dropped on a thread that doesn't hold the DB mutex, so
+  // the deleter only queues the unrefs; this runs them in a context where
+  // UnrefAndTryDelete() is allowed.
+  // REQUIRES: DB mutex held
+  void DrainCatalogUnrefs();
+
   // column_families_ and column_family_data_ need to be protected:
   // * when mutating both conditions have to be satisfied:
   // 1. DB mutex locked
@@ -829,6 +926,18 @@ class ColumnFamilySet {
   std::string db_session_id_;
   uint64_t wbm_client_id_ = 0;
   uint64_t wc_client_id_ = 0;
+
+  // Current catalog snapshot; read with std::atomic_load (GetCatalog()),
+  // replaced with std::atomic_store under the DB mutex + write thread.
+  std::shared_ptr<const ColumnFamilyCatalog> catalog_;
+  // Cfds whose catalog refs are pending release, queued by the snapshot
+  // deleter and drained under the DB mutex.
+  std::mutex catalog_unref_mutex_;
+  std::vector<ColumnFamilyData*> catalog_unrefs_;
+
+  // Ring of recent write stall transitions of this DB's column families,
+  // surfaced through DB::GetWriteStallTimeline().
+  WriteStallTimeline write_stall_timeline_;
 };
 
 // A wrapper for ColumnFamilySet that supports releasing DB mutex during each
@@ -818,6 +818,37 @@ TEST_P(ColumnFamilyTest, AddDrop) {
               std::vector<std::string>({"default", "four", "three"}));
 }
 
+TEST_P(ColumnFamilyTest, CatalogSnapshot) {
+  Open();
+  CreateColumnFamilies({"one", "two"});
+
+  ColumnFamilySet* cf_set = dbfull()->GetVersionSet()->GetColumnFamilySet();
+  auto catalog = cf_set->GetCatalog();
+  ASSERT_EQ(3U, catalog->column_families.size());
+  ASSERT_EQ(1U, catalog->by_name.count("default"));
+  ASSERT_EQ(1U, catalog->by_name.count("one"));
+  ASSERT_EQ(1U, catalog->by_name.count("two"));
+  ASSERT_EQ("one", catalog->by_name.at("one")->GetName());
+  // Sorted by column family ID
+  for (size_t i = 0; i + 1 < catalog->column_families.size(); ++i) {
+    ASSERT_LT(catalog->column_families[i]->GetID(),
+              catalog->column_families[i + 1]->GetID());
+  }
+
+  // Dropping a column family refreshes the catalog; the old snapshot keeps
+  // its (now dropped) entries alive.
+  DropColumnFamilies({1});
+  auto new_catalog = cf_set->GetCatalog();
+  ASSERT_EQ(2U, new_catalog->column_families.size());
+  ASSERT_EQ(0U, new_catalog->by_name.count("one"));
+  ASSERT_EQ(3U, catalog->column_families.size());
+  ASSERT_TRUE(catalog->by_name.at("one")->IsDropped());
+
+  catalog.reset();
+  new_catalog.reset();
+  Close();
+}
+
 TEST_P(ColumnFamilyTest, BulkAddDrop) {
   constexpr int kNumCF = 1000;
   ColumnFamilyOptions cf_options;
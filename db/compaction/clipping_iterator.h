@@ -17,11 +17,21 @@ namespace ROCKSDB_NAMESPACE {
 // iterator has already performed the bounds checking, it relies on that result;
 // otherwise, it performs the necessary key comparisons itself. Both bounds
 // are optional.
+//
+// The second constructor stores copies of the bound slices and treats the
+// upper bound as inclusive, i.e. the range is [start, end]. This form is used
+// for clipped-view files after a metadata-only SST split, whose largest key
+// is an inclusive bound.
 class ClippingIterator : public InternalIterator {
  public:
   ClippingIterator(InternalIterator* iter, const Slice* start, const Slice* end,
                    const CompareInterface* cmp)
-      : iter_(iter), start_(start), end_(end), cmp_(cmp), valid_(false) {
+      : iter_(iter),
+        start_(start),
+        end_(end),
+        cmp_(cmp),
+        end_inclusive_(false),
+        valid_(false) {
     assert(iter_);
     assert(cmp_);
     assert(!start_ || !end_ || cmp_->Compare(*start_, *end_) <= 0);
@@ -29,6 +39,23 @@ class ClippingIterator : public InternalIterator {
     UpdateAndEnforceBounds();
   }
 
+  ClippingIterator(InternalIterator* iter, const Slice& start, const Slice& end,
+                   const CompareInterface* cmp)
+      : iter_(iter),
+        start_storage_(start),
+        end_storage_(end),
+        start_(&start_storage_),
+        end_(&end_storage_),
+        cmp_(cmp),
+        end_inclusive_(true),
+        valid_(false) {
+    assert(iter_);
+    assert(cmp_);
+    assert(cmp_->Compare(*start_, *end_) <= 0);
+
+    UpdateAndEnforceBounds();
+  }
+
   bool Valid() const override { return valid_; }
 
   void SeekToFirst() override {
@@ -45,8 +72,10 @@ class ClippingIterator : public InternalIterator {
     if (end_) {
       iter_->SeekForPrev(*end_);
 
-      // Upper bound is exclusive, so we need a key which is strictly smaller
-      if (iter_->Valid() && cmp_->Compare(iter_->key(), *end_) == 0) {
+      // When the upper bound is exclusive, we need a key which is strictly
+      // smaller
+      if (!end_inclusive_ && iter_->Valid() &&
+          cmp_->Compare(iter_->key(), *end_) == 0) {
         iter_->Prev();
       }
     } else {
@@ -63,7 +92,7 @@ class ClippingIterator : public InternalIterator {
       return;
     }
 
-    if (end_ && cmp_->Compare(target, *end_) >= 0) {
+    if (end_ && AfterEnd(target)) {
       valid_ = false;
       return;
     }
@@ -78,11 +107,13 @@ class ClippingIterator : public InternalIterator {
       return;
     }
 
-    if (end_ && cmp_->Compare(target, *end_) >= 0) {
+    if (end_ && AfterEnd(target)) {
       iter_->SeekForPrev(*end_);
 
-      // Upper bound is exclusive, so we need a key which is strictly smaller
-      if (iter_->Valid() && cmp_->Compare(iter_->key(), *end_) == 0) {
+      // When the upper bound is exclusive, we need a key which is strictly
+      // smaller
+      if (!end_inclusive_ && iter_->Valid() &&
+          cmp_->Compare(iter_->key(), *end_) == 0) {
         iter_->Prev();
       }
 
@@ -194,6 +225,13 @@ class ClippingIterator : public InternalIterator {
   }
 
  private:
+  // Returns true if `key` is past the upper bound.
+  bool AfterEnd(const Slice& key) const {
+    assert(end_);
+    const int c = cmp_->Compare(key, *end_);
+    return end_inclusive_ ? c > 0 : c >= 0;
+  }
+
   void UpdateValid() {
     assert(!iter_->Valid() || iter_->status().ok());
 
@@ -212,7 +250,7 @@ class ClippingIterator : public InternalIterator {
 
     assert(bound_check_result == IterBoundCheck::kUnknown);
 
-    if (cmp_->Compare(key(), *end_) >= 0) {
+    if (AfterEnd(key())) {
       valid_ = false;
     }
   }
@@ -249,7 +287,7 @@ class ClippingIterator : public InternalIterator {
 
   void AssertBounds() {
     assert(!valid_ || !start_ || cmp_->Compare(key(), *start_) >= 0);
-    assert(!valid_ || !end_ || cmp_->Compare(key(), *end_) < 0);
+    assert(!valid_ || !end_ || !AfterEnd(key()));
   }
 
   void UpdateAndEnforceBounds() {
@@ -272,9 +310,13 @@ class ClippingIterator : public InternalIterator {
   }
 
   InternalIterator* iter_;
+  // Back the bound pointers when the owning-bounds constructor is used.
+  Slice start_storage_;
+  Slice end_storage_;
   const Slice* start_;
   const Slice* end_;
   const CompareInterface* cmp_;
+  const bool end_inclusive_;
   bool valid_;
 };
 
@@ -331,6 +331,24 @@ Compaction::Compaction(
   PopulatePenultimateLevelOutputRange();
 }
 
+void Compaction::ElideInputFileFromIteration(size_t compaction_input_level,
+                                             FileMetaData* f) {
+  assert(compaction_input_level < input_levels_.size());
+  LevelFilesBrief* brief = &input_levels_[compaction_input_level];
+  std::vector<FileMetaData*> remaining;
+  remaining.reserve(brief->num_files);
+  for (size_t i = 0; i < brief->num_files; i++) {
+    if (brief->files[i].file_metadata != f) {
+      remaining.push_back(brief->files[i].file_metadata);
+    }
+  }
+  assert(remaining.size() + 1 == brief->num_files);
+  // The brief previously generated for this level stays allocated in arena_
+  // until the compaction is destroyed; elision is rare enough that this
+  // waste does not matter.
+  DoGenerateLevelFilesBrief(brief, remaining, &arena_);
+}
+
 void Compaction::PopulatePenultimateLevelOutputRange() {
   if (!SupportsPerKeyPlacement()) {
     return;
@@ -169,6 +169,15 @@ class Compaction {
     return &input_levels_[compaction_input_level];
   }
 
+  // Removes `f` from the input-iteration structures (input_levels_) of input
+  // level `compaction_input_level` while keeping it registered as a
+  // compaction input, so it is still deleted when the compaction result is
+  // installed. Used by CompactionJob to elide reading input files whose
+  // entire contents are known to be dropped, e.g. files fully covered by a
+  // newer range tombstone in a snapshot-free bottommost compaction.
+  void ElideInputFileFromIteration(size_t compaction_input_level,
+                                   FileMetaData* f);
+
   // Maximum size of files to build during this compaction.
   uint64_t max_output_file_size() const { return max_output_file_size_; }
 
@@ -268,7 +268,10 @@ bool CompactionIterator::InvokeFilterIfNeeded(bool* need_skip,
   compaction_filter_value_.clear();
   compaction_filter_skip_until_.Clear();
 
-  std::vector<std::pair<std::string, std::string>> new_columns;
+  // Reuse the buffers grown by previous filter invocations.
+  new_columns_scratch_.clear();
+  std::vector<std::pair<std::string, std::string>>& new_columns =
+      new_columns_scratch_;
 
   {
     StopWatchNano timer(clock_, report_detailed_time_);
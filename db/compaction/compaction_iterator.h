@@ -474,6 +474,9 @@ class CompactionIterator {
   std::string blob_index_;
   PinnableSlice blob_value_;
   std::string compaction_filter_value_;
+  // Scratch for wide columns emitted by the compaction filter, kept as a
+  // member so its buffers are reused across filter invocations.
+  std::vector<std::pair<std::string, std::string>> new_columns_scratch_;
   InternalKey compaction_filter_skip_until_;
   // "level_ptrs" holds indices that remember which file of an associated
   // level we were last checking during the last call to compaction->
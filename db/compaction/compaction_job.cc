@@ -28,6 +28,7 @@
 #include <memory>
 #include <optional>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -276,6 +277,8 @@ void CompactionJob::Prepare() {
   bottommost_level_ = c->bottommost_level();
   last_level_with_data_ = cfd->IsLastLevelWithData(c->output_level());
 
+  ElideRangeDeletedInputFiles();
+
   if (c->ShouldFormSubcompactions()) {
     StopWatch sw(db_options_.clock, stats_, SUBCOMPACTION_SETUP_TIME);
     GenSubcompactionBoundaries();
@@ -361,6 +364,114 @@ void CompactionJob::Prepare() {
   }
 }
 
+void CompactionJob::ElideRangeDeletedInputFiles() {
+  Compaction* c = compact_->compaction;
+  ColumnFamilyData* cfd = c->column_family_data();
+  const Comparator* ucmp = cfd->user_comparator();
+  // Whole-file elision is only attempted when dropping every key of a
+  // covered file is trivially correct: the compaction output is bottommost
+  // (no older versions below to expose), there are no snapshots or snapshot
+  // checker that could keep individual covered keys alive, and no
+  // user-defined timestamps that make coverage key-dependent.
+  if (!bottommost_level_ || !existing_snapshots_.empty() ||
+      snapshot_checker_ != nullptr || ucmp->timestamp_size() > 0 ||
+      db_options_.allow_ingest_behind || c->SupportsPerKeyPlacement() ||
+      c->num_input_levels() < 2 || c->output_level() == 0) {
+    return;
+  }
+
+  // Collect the fragmented range tombstones of the non-output input levels.
+  // Only the tombstone metadata block of each file is read; data blocks are
+  // untouched.
+  struct TombstoneSource {
+    std::unique_ptr<FragmentedRangeTombstoneIterator> iter;
+  };
+  std::vector<TombstoneSource> sources;
+  for (size_t which = 0; which < c->num_input_levels(); which++) {
+    if (c->level(which) == c->output_level()) {
+      continue;
+    }
+    for (size_t i = 0; i < c->num_input_files(which); i++) {
+      FileMetaData* fmd = c->input(which, i);
+      std::unique_ptr<FragmentedRangeTombstoneIterator> iter;
+      Status s = cfd->table_cache()->GetRangeTombstoneIterator(
+          ReadOptions(), cfd->internal_comparator(), *fmd, &iter);
+      if (!s.ok()) {
+        // Elision is an optimization; on any failure fall back to reading
+        // the inputs normally.
+        return;
+      }
+      if (iter != nullptr) {
+        sources.emplace_back(TombstoneSource{std::move(iter)});
+      }
+    }
+  }
+  if (sources.empty()) {
+    return;
+  }
+
+  for (size_t which = 0; which < c->num_input_levels(); which++) {
+    if (c->level(which) != c->output_level()) {
+      continue;
+    }
+    for (size_t i = 0; i < c->num_input_files(which); i++) {
+      FileMetaData* fmd = c->input(which, i);
+      // The file's entry stats must be known and it must not contain range
+      // tombstones of its own: those could cover keys in other input files
+      // and have to go through the range-del aggregator. Files referencing
+      // blob files keep their normal path so blob garbage is tracked.
+      if (fmd->num_entries == 0 || fmd->num_range_deletions > 0 ||
+          fmd->oldest_blob_file_number != kInvalidBlobFileNumber) {
+        continue;
+      }
+      const Slice file_smallest = fmd->smallest.user_key();
+      const Slice file_largest = fmd->largest.user_key();
+      bool covered = false;
+      for (auto& source : sources) {
+        // A single source file's fragments are non-overlapping and sorted,
+        // so coverage can be checked with one forward scan. Every fragment
+        // used must be newer than all entries in the candidate file.
+        Slice covered_up_to = file_smallest;
+        bool have_coverage = false;
+        for (source.iter->SeekToFirst(); source.iter->Valid();
+             source.iter->Next()) {
+          if (source.iter->seq() <= fmd->fd.largest_seqno) {
+            continue;
+          }
+          if (ucmp->Compare(source.iter->start_key(), covered_up_to) > 0) {
+            if (have_coverage) {
+              break;  // gap in coverage
+            }
+            continue;
+          }
+          if (ucmp->Compare(source.iter->end_key(), covered_up_to) > 0) {
+            covered_up_to = source.iter->end_key();
+            have_coverage = true;
+            // end_key() is exclusive, so the file's largest key must sort
+            // strictly before it.
+            if (ucmp->Compare(file_largest, covered_up_to) < 0) {
+              covered = true;
+              break;
+            }
+          }
+        }
+        if (covered) {
+          break;
+        }
+      }
+      if (covered) {
+        c->ElideInputFileFromIteration(which, fmd);
+        ROCKS_LOG_INFO(db_options_.info_log,
+                       "[%s] [JOB %d] Eliding input file %" PRIu64
+                       " (%" PRIu64
+                       " entries): entirely covered by a range tombstone",
+                       cfd->GetName().c_str(), job_id_, fmd->fd.GetNumber(),
+                       fmd->num_entries);
+      }
+    }
+  }
+}
+
 uint64_t CompactionJob::GetSubcompactionsLimit() {
   return extra_num_subcompaction_threads_reserved_ +
          std::max(
@@ -560,6 +671,13 @@ void CompactionJob::GenSubcompactionBoundaries() {
                   }),
       all_anchors.end());
 
+  // The minimum size of a subcompaction's range; also used below as the floor
+  // for the target range size when picking the boundaries.
+  const uint64_t min_range_size = MaxFileSizeForLevel(
+      *(c->mutable_cf_options()), out_lvl,
+      c->immutable_options()->compaction_style, base_level,
+      c->immutable_options()->level_compaction_dynamic_level_bytes);
+
   // Get the number of planned subcompactions, may update reserve threads
   // and update extra_num_subcompaction_threads_reserved_ for round-robin
   uint64_t num_planned_subcompactions;
@@ -591,6 +709,24 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   } else {
     num_planned_subcompactions = GetSubcompactionsLimit();
+    // If the input holds substantially more data than max_subcompactions
+    // ranges of the minimum size, the job is limited by its slowest shard.
+    // Try to employ extra subcompactions backed by reserved threads, the same
+    // way round-robin compaction does. The boundary picking below still
+    // enforces the minimum range size, so the planned number is only reached
+    // when the data is really there; unused reservations are shrunk at the
+    // end of this function.
+    if (min_range_size > 0 && bg_compaction_scheduled_ != nullptr &&
+        bg_bottom_compaction_scheduled_ != nullptr) {
+      uint64_t size_based_subcompactions = total_size / min_range_size;
+      if (size_based_subcompactions > num_planned_subcompactions) {
+        AcquireSubcompactionResources(
+            (int)(size_based_subcompactions - num_planned_subcompactions));
+        // Subcompactions limit changes after acquiring additional resources.
+        num_planned_subcompactions =
+            std::min(size_based_subcompactions, GetSubcompactionsLimit());
+      }
+    }
   }
 
   TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:0",
@@ -598,12 +734,8 @@ void CompactionJob::GenSubcompactionBoundaries() {
   if (num_planned_subcompactions == 1) return;
 
   // Group the ranges into subcompactions
-  uint64_t target_range_size = std::max(
-      total_size / num_planned_subcompactions,
-      MaxFileSizeForLevel(
-          *(c->mutable_cf_options()), out_lvl,
-          c->immutable_options()->compaction_style, base_level,
-          c->immutable_options()->level_compaction_dynamic_level_bytes));
+  uint64_t target_range_size =
+      std::max(total_size / num_planned_subcompactions, min_range_size);
 
   if (target_range_size >= total_size) {
     return;
@@ -1103,6 +1235,14 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   read_options.verify_checksums = true;
   read_options.fill_cache = false;
   read_options.rate_limiter_priority = GetRateLimiterPriority();
+  // Overlap input IO with merging: with async_io set, the double-buffered
+  // FilePrefetchBuffer issues the next compaction_readahead_size read through
+  // ReadAsync while the current buffer is being consumed, so the iterator
+  // rarely stalls on a cold block. Only do this when reads are not rate
+  // limited, since the async read path bypasses the rate limiter.
+  read_options.async_io =
+      db_options_.fs->use_async_io() &&
+      read_options.rate_limiter_priority == Env::IO_TOTAL;
   // Compaction iterators shouldn't be confined to a single prefix.
   // Compactions use Seek() for
   // (a) concurrent compactions,
@@ -1248,7 +1388,8 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
                 job_id_, cfd->GetID(), cfd->GetName(), Env::IOPriority::IO_LOW,
                 write_hint_, io_tracer_, blob_callback_,
                 BlobFileCreationReason::kCompaction, &blob_file_paths,
-                sub_compact->Current().GetBlobFileAdditionsPtr())
+                sub_compact->Current().GetBlobFileAdditionsPtr(),
+                cfd->blob_value_size_histogram())
           : nullptr);
 
   TEST_SYNC_POINT("CompactionJob::Run():Inprogress");
@@ -1314,6 +1455,15 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
       RecordDroppedKeys(c_iter_stats, &sub_compact->compaction_job_stats);
       c_iter->ResetRecordCounts();
       RecordCompactionIOStats();
+      // Cooperative preemption checkpoint: when flushes are queued behind
+      // busy high-priority threads, step to the back of the run queue so a
+      // flush thread wins the next core instead of this long compaction.
+      // This cannot free up this pool slot, only the CPU; see the comment in
+      // MaybeScheduleFlushOrCompaction() for how flushes get pool threads.
+      if (thread_pri_ != Env::Priority::HIGH &&
+          env_->GetThreadPoolQueueLen(Env::Priority::HIGH) > 0) {
+        std::this_thread::yield();
+      }
     }
 
     // Add current compaction_iterator key to target compaction output, if the
@@ -1764,6 +1914,19 @@ void CompactionJob::RecordCompactionIOStats() {
   IOSTATS_RESET(bytes_written);
 }
 
+namespace {
+// Process-wide budget of extra block compression worker threads, shared by
+// all concurrent compactions. Sized once from the LOW pool of the first
+// caller's Env: compaction threads themselves also compress, so the extra
+// workers at most double the compression parallelism.
+ConcurrentTaskLimiterImpl& CompressionThreadsLimiter(Env* env) {
+  static ConcurrentTaskLimiterImpl limiter(
+      "compaction_compression_threads",
+      std::max(1, env->GetBackgroundThreads(Env::Priority::LOW)));
+  return limiter;
+}
+}  // namespace
+
 Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
                                                CompactionOutputs& outputs) {
   assert(sub_compact != nullptr);
@@ -1887,19 +2050,50 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
   outputs.AssignFileWriter(new WritableFileWriter(
       std::move(writable_file), fname, fo_copy, db_options_.clock, io_tracer_,
       db_options_.stats, listeners, db_options_.file_checksum_gen_factory.get(),
-      tmp_set.Contains(FileType::kTableFile), false));
+      tmp_set.Contains(FileType::kTableFile), false,
+      static_cast<SstFileManagerImpl*>(db_options_.sst_file_manager.get())));
+
+  // Block compression is most of a compaction's CPU cost with a heavy
+  // compressor. When parallel compression is configured, draw the extra
+  // worker threads from a process-wide budget shared by all concurrent
+  // compactions, so several jobs cannot multiply parallel_threads into more
+  // threads than the machine has. The tokens are held by `outputs` for as
+  // long as the builder is alive.
+  CompressionOptions output_compression_opts =
+      sub_compact->compaction->output_compression_opts();
+  if (output_compression_opts.parallel_threads > 1) {
+    ConcurrentTaskLimiterImpl& limiter =
+        CompressionThreadsLimiter(db_options_.env);
+    std::vector<std::unique_ptr<TaskLimiterToken>> tokens;
+    for (uint32_t i = 1; i < output_compression_opts.parallel_threads; i++) {
+      std::unique_ptr<TaskLimiterToken> token =
+          limiter.GetToken(false /* force */);
+      if (token == nullptr) {
+        break;
+      }
+      tokens.push_back(std::move(token));
+    }
+    output_compression_opts.parallel_threads =
+        static_cast<uint32_t>(1 + tokens.size());
+    outputs.AssignCompressionThreadTokens(std::move(tokens));
+  }
 
   TableBuilderOptions tboptions(
       *cfd->ioptions(), *(sub_compact->compaction->mutable_cf_options()),
       cfd->internal_comparator(), cfd->int_tbl_prop_collector_factories(),
       sub_compact->compaction->output_compression(),
-      sub_compact->compaction->output_compression_opts(), cfd->GetID(),
+      output_compression_opts, cfd->GetID(),
       cfd->GetName(), sub_compact->compaction->output_level(),
       bottommost_level_, last_level_with_data_,
       TableFileCreationReason::kCompaction, 0 /* oldest_key_time */,
       current_time, db_id_, db_session_id_,
       sub_compact->compaction->max_output_file_size(), file_number);
 
+  if (output_compression_opts.shared_dict_per_compaction &&
+      output_compression_opts.max_dict_bytes > 0) {
+    tboptions.compression_dict_share = compression_dict_share_;
+  }
+
   outputs.NewBuilder(tboptions);
 
   LogFlush(db_options_.info_log);
@@ -242,6 +242,13 @@ class CompactionJob {
   // consecutive groups such that each group has a similar size.
   void GenSubcompactionBoundaries();
 
+  // Elides, from iteration, input files in the output level whose key range
+  // is entirely covered by a newer range tombstone from another input file,
+  // when every key in them is provably droppable (bottommost compaction, no
+  // snapshots, no user-defined timestamps). Such files are deleted by the
+  // compaction without their blocks ever being read or decompressed.
+  void ElideRangeDeletedInputFiles();
+
   // Get the number of planned subcompactions based on max_subcompactions and
   // extra reserved resources
   uint64_t GetSubcompactionsLimit();
@@ -326,6 +333,13 @@ class CompactionJob {
 
   std::shared_ptr<Cache> table_cache_;
 
+  // Compression dictionary shared by the output files of this compaction
+  // when CompressionOptions::shared_dict_per_compaction is set. Created
+  // unconditionally since OpenCompactionOutputFile may run concurrently
+  // from several subcompactions.
+  std::shared_ptr<SharedCompressionDict> compression_dict_share_ =
+      std::make_shared<SharedCompressionDict>();
+
   EventLogger* event_logger_;
 
   bool paranoid_file_checks_;
@@ -413,6 +427,10 @@ struct CompactionServiceInput {
 // CompactionServiceOutputFile is the metadata for the output SST file
 struct CompactionServiceOutputFile {
   std::string file_name;
+  // Size of the output file as written by the remote worker. 0 means the
+  // worker did not report it (older result format); the primary then relies
+  // solely on the file system.
+  uint64_t file_size = 0;
   SequenceNumber smallest_seqno;
   SequenceNumber largest_seqno;
   std::string smallest_internal_key;
@@ -426,12 +444,14 @@ struct CompactionServiceOutputFile {
 
   CompactionServiceOutputFile() = default;
   CompactionServiceOutputFile(
-      const std::string& name, SequenceNumber smallest, SequenceNumber largest,
-      std::string _smallest_internal_key, std::string _largest_internal_key,
-      uint64_t _oldest_ancester_time, uint64_t _file_creation_time,
-      uint64_t _epoch_number, uint64_t _paranoid_hash,
-      bool _marked_for_compaction, UniqueId64x2 _unique_id)
+      const std::string& name, uint64_t _file_size, SequenceNumber smallest,
+      SequenceNumber largest, std::string _smallest_internal_key,
+      std::string _largest_internal_key, uint64_t _oldest_ancester_time,
+      uint64_t _file_creation_time, uint64_t _epoch_number,
+      uint64_t _paranoid_hash, bool _marked_for_compaction,
+      UniqueId64x2 _unique_id)
       : file_name(name),
+        file_size(_file_size),
         smallest_seqno(smallest),
         largest_seqno(largest),
         smallest_internal_key(std::move(_smallest_internal_key)),
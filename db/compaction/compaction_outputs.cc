@@ -24,10 +24,11 @@ Status CompactionOutputs::Finish(const Status& intput_status,
   assert(meta != nullptr);
   Status s = intput_status;
   if (s.ok()) {
-    std::string seqno_time_mapping_str;
-    seqno_time_mapping.Encode(seqno_time_mapping_str, meta->fd.smallest_seqno,
-                              meta->fd.largest_seqno, meta->file_creation_time);
-    builder_->SetSeqnoTimeTableProperties(seqno_time_mapping_str,
+    seqno_time_mapping_scratch_.clear();
+    seqno_time_mapping.Encode(seqno_time_mapping_scratch_,
+                              meta->fd.smallest_seqno, meta->fd.largest_seqno,
+                              meta->file_creation_time);
+    builder_->SetSeqnoTimeTableProperties(seqno_time_mapping_scratch_,
                                           meta->oldest_ancester_time);
     s = builder_->Finish();
 
@@ -62,6 +63,12 @@ IOStatus CompactionOutputs::WriterSyncClose(const Status& input_status,
     io_s = file_writer_->Sync(use_fsync);
   }
   if (input_status.ok() && io_s.ok()) {
+    // The output was just synced, so its pages are clean and compaction won't
+    // read them back; tell the OS they are not needed so large compactions do
+    // not evict user-read pages from the page cache. This is only a hint -
+    // failures (e.g. file systems without page cache) are ignored, and table
+    // verification/open simply reads the dropped pages back in.
+    file_writer_->InvalidateCache(0, 0).PermitUncheckedError();
     io_s = file_writer_->Close();
   }
 
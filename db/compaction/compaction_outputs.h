@@ -15,6 +15,7 @@
 #include "db/compaction/compaction_iterator.h"
 #include "db/internal_stats.h"
 #include "db/output_validator.h"
+#include "util/concurrent_task_limiter_impl.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -164,9 +165,18 @@ class CompactionOutputs {
 
   void ResetBuilder() {
     builder_.reset();
+    compression_thread_tokens_.clear();
     current_output_file_size_ = 0;
   }
 
+  // Takes ownership of the tokens backing the builder's extra block
+  // compression threads. They are returned to the shared budget when the
+  // builder is reset.
+  void AssignCompressionThreadTokens(
+      std::vector<std::unique_ptr<TaskLimiterToken>>&& tokens) {
+    compression_thread_tokens_ = std::move(tokens);
+  }
+
   // Add range deletions from the range_del_agg_ to the current output file.
   // Input parameters, `range_tombstone_lower_bound_` and current output's
   // metadata determine the bounds on range deletions to add. Updates output
@@ -225,6 +235,7 @@ class CompactionOutputs {
       builder_->Abandon();
       builder_.reset();
     }
+    compression_thread_tokens_.clear();
   }
 
   // Updates states related to file cutting for TTL.
@@ -298,6 +309,9 @@ class CompactionOutputs {
   // current output builder and writer
   std::unique_ptr<TableBuilder> builder_;
   std::unique_ptr<WritableFileWriter> file_writer_;
+  // Tokens from the process-wide compression thread budget, held while the
+  // current builder compresses blocks in parallel
+  std::vector<std::unique_ptr<TaskLimiterToken>> compression_thread_tokens_;
   uint64_t current_output_file_size_ = 0;
 
   // all the compaction outputs so far
@@ -315,6 +329,10 @@ class CompactionOutputs {
   const bool is_penultimate_level_;
   std::unique_ptr<CompactionRangeDelAggregator> range_del_agg_ = nullptr;
 
+  // Scratch for the encoded seqno-to-time mapping, kept as a member so its
+  // buffer is reused across the output files of this subcompaction.
+  std::string seqno_time_mapping_scratch_;
+
   // partitioner information
   std::string last_key_for_partitioner_;
   std::unique_ptr<SstPartitioner> partitioner_;
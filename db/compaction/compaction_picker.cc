@@ -18,6 +18,7 @@
 
 #include "db/column_family.h"
 #include "file/filename.h"
+#include "file/sst_file_manager_impl.h"
 #include "logging/log_buffer.h"
 #include "logging/logging.h"
 #include "monitoring/statistics.h"
@@ -70,6 +71,17 @@ bool FindIntraL0Compaction(const std::vector<FileMetaData*>& level_files,
   return false;
 }
 
+uint32_t AdjustOutputPathIdForDeviceLoad(const ImmutableOptions& ioptions,
+                                         uint32_t min_path_id) {
+  auto* sfm =
+      static_cast<SstFileManagerImpl*>(ioptions.sst_file_manager.get());
+  if (sfm == nullptr ||
+      static_cast<size_t>(min_path_id) + 1 >= ioptions.cf_paths.size()) {
+    return min_path_id;
+  }
+  return sfm->PickLeastLoadedPathId(ioptions.cf_paths, min_path_id);
+}
+
 // Determine compression type, based on user options, level of the output
 // file and whether compression is disabled.
 // If enable_compression is false, then compression is always disabled no
@@ -319,6 +319,15 @@ bool FindIntraL0Compaction(const std::vector<FileMetaData*>& level_files,
                            uint64_t max_compaction_bytes,
                            CompactionInputFiles* comp_inputs);
 
+// Adjust a size-based output path choice for device load. When later
+// cf_paths sit on a different, less busy device, the SstFileManager may move
+// the compaction output there; paths after min_path_id always have room for
+// the output under the size heuristic that produced it. Returns min_path_id
+// unchanged when no SstFileManager is configured or all paths share one
+// device.
+uint32_t AdjustOutputPathIdForDeviceLoad(const ImmutableOptions& ioptions,
+                                         uint32_t min_path_id);
+
 CompressionType GetCompressionType(const VersionStorageInfo* vstorage,
                                    const MutableCFOptions& mutable_cf_options,
                                    int level, int base_level,
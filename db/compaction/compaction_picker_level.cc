@@ -15,6 +15,7 @@
 
 #include "db/version_edit.h"
 #include "logging/log_buffer.h"
+#include "rocksdb/write_buffer_manager.h"
 #include "test_util/sync_point.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -138,8 +139,10 @@ class LevelCompactionBuilder {
   const MutableCFOptions& mutable_cf_options_;
   const ImmutableOptions& ioptions_;
   const MutableDBOptions& mutable_db_options_;
-  // Pick a path ID to place a newly generated file, with its level
-  static uint32_t GetPathId(const ImmutableCFOptions& ioptions,
+  // Pick a path ID to place a newly generated file, with its level; the
+  // size-based choice may be moved to a less-loaded device, see
+  // AdjustOutputPathIdForDeviceLoad()
+  static uint32_t GetPathId(const ImmutableOptions& ioptions,
                             const MutableCFOptions& mutable_cf_options,
                             int level);
 
@@ -536,7 +539,7 @@ Compaction* LevelCompactionBuilder::GetCompaction() {
  * up to and including this path
  */
 uint32_t LevelCompactionBuilder::GetPathId(
-    const ImmutableCFOptions& ioptions,
+    const ImmutableOptions& ioptions,
     const MutableCFOptions& mutable_cf_options, int level) {
   uint32_t p = 0;
   assert(!ioptions.cf_paths.empty());
@@ -556,7 +559,7 @@ uint32_t LevelCompactionBuilder::GetPathId(
     if (level_size <= current_path_size) {
       if (cur_level == level) {
         // Does desired level fit in this path?
-        return p;
+        return AdjustOutputPathIdForDeviceLoad(ioptions, p);
       } else {
         current_path_size -= level_size;
         if (cur_level > 0) {
@@ -581,7 +584,7 @@ uint32_t LevelCompactionBuilder::GetPathId(
     p++;
     current_path_size = ioptions.cf_paths[p].target_size;
   }
-  return p;
+  return AdjustOutputPathIdForDeviceLoad(ioptions, p);
 }
 
 bool LevelCompactionBuilder::TryPickL0TrivialMove() {
@@ -814,9 +817,20 @@ bool LevelCompactionBuilder::PickIntraL0Compaction() {
   start_level_inputs_.clear();
   const std::vector<FileMetaData*>& level_files =
       vstorage_->LevelFiles(0 /* level */);
-  if (level_files.size() <
-          static_cast<size_t>(
-              mutable_cf_options_.level0_file_num_compaction_trigger + 2) ||
+  size_t min_files_to_consider = static_cast<size_t>(
+      mutable_cf_options_.level0_file_num_compaction_trigger + 2);
+  // During a sustained write burst the memtables fill faster than
+  // L0->base_level compactions can drain L0, and read-amp builds up well
+  // before the regular `trigger + 2` cushion is reached. Use the write buffer
+  // manager's memory usage as a burst signal and start merging small L0
+  // spans as soon as the regular trigger is hit.
+  const WriteBufferManager* wbm = ioptions_.write_buffer_manager.get();
+  if (wbm != nullptr && wbm->enabled() &&
+      wbm->memory_usage() >= wbm->buffer_size() / 2) {
+    min_files_to_consider = static_cast<size_t>(
+        mutable_cf_options_.level0_file_num_compaction_trigger);
+  }
+  if (level_files.size() < min_files_to_consider ||
       level_files[0]->being_compacted) {
     // If L0 isn't accumulating much files beyond the regular trigger, don't
     // resort to L0->L0 compaction yet.
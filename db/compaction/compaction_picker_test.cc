@@ -2870,6 +2870,41 @@ TEST_F(CompactionPickerTest, IntraL0MaxCompactionBytesHit) {
   ASSERT_EQ(0, compaction->output_level());
 }
 
+TEST_F(CompactionPickerTest, UniversalLookaheadPicksCheaperWindow) {
+  const uint64_t kFileSize = 100000;
+
+  ioptions_.compaction_style = kCompactionStyleUniversal;
+  mutable_cf_options_.compaction_options_universal.lookahead_scheduling = true;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+
+  // The greedy size-ratio picker would commit to the window starting at file
+  // 3 ({22x, 1x, 1x}, ~12x rewritten per run removed); with lookahead
+  // scheduling the window {1x, 1x} further down removes a run for a fraction
+  // of the bytes and wins.
+  Add(0, 1U, "100", "199", 20 * kFileSize, 0, 601, 650);
+  Add(0, 2U, "100", "199", 21 * kFileSize, 0, 501, 550);
+  Add(0, 3U, "100", "199", 22 * kFileSize, 0, 401, 450);
+  Add(0, 4U, "100", "199", 1 * kFileSize, 0, 301, 350);
+  Add(0, 5U, "100", "199", 1 * kFileSize, 0, 201, 250);
+  Add(0, 6U, "100", "199", 400 * kFileSize, 0, 101, 150);
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+          &log_buffer_));
+
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kUniversalSizeRatio,
+            compaction->compaction_reason());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_FALSE(file_map_[3].first->being_compacted);
+  ASSERT_TRUE(file_map_[4].first->being_compacted);
+  ASSERT_TRUE(file_map_[5].first->being_compacted);
+}
+
 TEST_F(CompactionPickerTest, UniversalMarkedCompactionFullOverlap) {
   const uint64_t kFileSize = 100000;
 
@@ -137,8 +137,9 @@ class UniversalCompactionBuilder {
       const VersionStorageInfo& vstorage);
 
   // Pick a path ID to place a newly generated file, with its estimated file
-  // size.
-  static uint32_t GetPathId(const ImmutableCFOptions& ioptions,
+  // size; the size-based choice may be moved to a less-loaded device, see
+  // AdjustOutputPathIdForDeviceLoad().
+  static uint32_t GetPathId(const ImmutableOptions& ioptions,
                             const MutableCFOptions& mutable_cf_options,
                             uint64_t file_size);
 };
@@ -520,7 +521,7 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
 }
 
 uint32_t UniversalCompactionBuilder::GetPathId(
-    const ImmutableCFOptions& ioptions,
+    const ImmutableOptions& ioptions,
     const MutableCFOptions& mutable_cf_options, uint64_t file_size) {
   // Two conditions need to be satisfied:
   // (1) the target path needs to be able to hold the file's size
@@ -546,11 +547,11 @@ uint32_t UniversalCompactionBuilder::GetPathId(
     uint64_t target_size = ioptions.cf_paths[p].target_size;
     if (target_size > file_size &&
         accumulated_size + (target_size - file_size) > future_size) {
-      return p;
+      return AdjustOutputPathIdForDeviceLoad(ioptions, p);
     }
     accumulated_size += target_size;
   }
-  return p;
+  return AdjustOutputPathIdForDeviceLoad(ioptions, p);
 }
 
 //
@@ -569,6 +570,15 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
   size_t start_index = 0;
   unsigned int candidate_count = 0;
 
+  // With lookahead scheduling, instead of committing to the first window of
+  // runs that satisfies the size ratio, every eligible window is costed by
+  // the projected bytes rewritten per sorted run removed and the cheapest
+  // one wins.
+  const bool lookahead = mutable_cf_options_.compaction_options_universal
+                             .lookahead_scheduling;
+  unsigned int best_candidate_count = 0;
+  double best_cost = std::numeric_limits<double>::max();
+
   unsigned int max_files_to_compact =
       std::min(max_merge_width, max_number_of_files_to_compact);
   min_merge_width = std::max(min_merge_width, 2U);
@@ -651,9 +661,26 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
 
     // Found a series of consecutive files that need compaction.
     if (candidate_count >= (unsigned int)min_merge_width) {
-      start_index = loop;
-      done = true;
-      break;
+      if (!lookahead) {
+        start_index = loop;
+        done = true;
+        break;
+      }
+      uint64_t window_bytes = 0;
+      for (size_t i = loop; i < loop + candidate_count; i++) {
+        window_bytes += sorted_runs_[i].compensated_file_size;
+      }
+      const double cost =
+          static_cast<double>(window_bytes) / (candidate_count - 1);
+      if (!done || cost < best_cost) {
+        best_cost = cost;
+        best_candidate_count = candidate_count;
+        start_index = loop;
+        done = true;
+      }
+      // Keep scanning; a window further down the run list may remove as many
+      // runs for fewer bytes.
+      continue;
     } else {
       for (size_t i = loop;
            i < loop + candidate_count && i < sorted_runs_.size(); i++) {
@@ -665,6 +692,9 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
       }
     }
   }
+  if (lookahead && done) {
+    candidate_count = best_candidate_count;
+  }
   if (!done || candidate_count <= 1) {
     return nullptr;
   }
@@ -197,6 +197,15 @@ CompactionJob::ProcessKeyValueCompactionWithCompactionService(
       sub_compact->status = s;
       return CompactionServiceJobStatus::kFailure;
     }
+    if (file.file_size > 0 && file.file_size != file_size) {
+      // The worker reported how large the file should be; a mismatch means
+      // the file was truncated or corrupted on the way back to us.
+      sub_compact->status = Status::Corruption(
+          "Compaction service output file " + file.file_name +
+          " size mismatch: expected " + std::to_string(file.file_size) +
+          ", actual " + std::to_string(file_size));
+      return CompactionServiceJobStatus::kFailure;
+    }
     meta.fd = FileDescriptor(file_num, compaction->output_path_id(), file_size,
                              file.smallest_seqno, file.largest_seqno);
     meta.smallest.DecodeFrom(file.smallest_internal_key);
@@ -344,10 +353,10 @@ Status CompactionServiceCompactionJob::Run() {
   for (const auto& output_file : sub_compact->GetOutputs()) {
     auto& meta = output_file.meta;
     compaction_result_->output_files.emplace_back(
-        MakeTableFileName(meta.fd.GetNumber()), meta.fd.smallest_seqno,
-        meta.fd.largest_seqno, meta.smallest.Encode().ToString(),
-        meta.largest.Encode().ToString(), meta.oldest_ancester_time,
-        meta.file_creation_time, meta.epoch_number,
+        MakeTableFileName(meta.fd.GetNumber()), meta.fd.GetFileSize(),
+        meta.fd.smallest_seqno, meta.fd.largest_seqno,
+        meta.smallest.Encode().ToString(), meta.largest.Encode().ToString(),
+        meta.oldest_ancester_time, meta.file_creation_time, meta.epoch_number,
         output_file.validator.GetHash(), meta.marked_for_compaction,
         meta.unique_id);
   }
@@ -480,6 +489,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct CompactionServiceOutputFile, file_name),
           OptionType::kEncodedString, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"file_size",
+         {offsetof(struct CompactionServiceOutputFile, file_size),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"smallest_seqno",
          {offsetof(struct CompactionServiceOutputFile, smallest_seqno),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
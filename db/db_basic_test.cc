@@ -462,6 +462,91 @@ TEST_F(DBBasicTest, GetSnapshot) {
   } while (ChangeOptions());
 }
 
+TEST_F(DBBasicTest, GetWithSnapshotSeqno) {
+  Options options = CurrentOptions();
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "v1"));
+  const SequenceNumber seq1 = db_->GetLatestSequenceNumber();
+  ASSERT_OK(Put("foo", "v2"));
+
+  ReadOptions ropts;
+  ropts.snapshot_seqno = seq1;
+  std::string value;
+  ASSERT_OK(db_->Get(ropts, "foo", &value));
+  ASSERT_EQ("v1", value);
+
+  // Also reads consistently across a flush, like a registered snapshot
+  // would, as long as nothing collapses the history.
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->Get(ropts, "foo", &value));
+  ASSERT_EQ("v1", value);
+  ropts.snapshot_seqno = db_->GetLatestSequenceNumber();
+  ASSERT_OK(db_->Get(ropts, "foo", &value));
+  ASSERT_EQ("v2", value);
+
+  // A seqno the DB has not reached yet is rejected.
+  ropts.snapshot_seqno = db_->GetLatestSequenceNumber() + 1;
+  ASSERT_TRUE(db_->Get(ropts, "foo", &value).IsInvalidArgument());
+
+  // Combining with a registered snapshot is rejected, and so is reading
+  // below the oldest registered snapshot.
+  const Snapshot* s1 = db_->GetSnapshot();
+  ASSERT_OK(Put("foo", "v3"));
+  ropts.snapshot_seqno = s1->GetSequenceNumber();
+  ropts.snapshot = s1;
+  ASSERT_TRUE(db_->Get(ropts, "foo", &value).IsInvalidArgument());
+  ropts.snapshot = nullptr;
+  ASSERT_OK(db_->Get(ropts, "foo", &value));
+  ASSERT_EQ("v2", value);
+  ropts.snapshot_seqno = s1->GetSequenceNumber() - 1;
+  ASSERT_TRUE(db_->Get(ropts, "foo", &value).IsInvalidArgument());
+  db_->ReleaseSnapshot(s1);
+}
+
+TEST_F(DBBasicTest, GetWithStaleImmutableView) {
+  Options options = CurrentOptions();
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("foo", "v2"));
+  ASSERT_OK(Put("bar", "v1"));
+
+  // The stale view excludes the mutable memtable: it sees the state as of
+  // the last memtable switch.
+  ReadOptions ropts;
+  ropts.allow_stale_immutable_view = true;
+  std::string value;
+  ASSERT_OK(db_->Get(ropts, "foo", &value));
+  ASSERT_EQ("v1", value);
+  ASSERT_TRUE(db_->Get(ropts, "bar", &value).IsNotFound());
+  ASSERT_EQ("v2", Get("foo"));
+  ASSERT_EQ("v1", Get("bar"));
+
+  // MultiGet takes the same view.
+  std::vector<std::string> values;
+  std::vector<Status> statuses = db_->MultiGet(
+      ropts, {db_->DefaultColumnFamily(), db_->DefaultColumnFamily()},
+      {"foo", "bar"}, &values);
+  ASSERT_OK(statuses[0]);
+  ASSERT_EQ("v1", values[0]);
+  ASSERT_TRUE(statuses[1].IsNotFound());
+
+  // Data still in an immutable memtable is visible before it hits an SST.
+  ASSERT_OK(dbfull()->TEST_SwitchMemtable());
+  ASSERT_OK(db_->Get(ropts, "bar", &value));
+  ASSERT_EQ("v1", value);
+  ASSERT_OK(db_->Get(ropts, "foo", &value));
+  ASSERT_EQ("v2", value);
+
+  // A flush naturally refreshes the view as well.
+  ASSERT_OK(Put("foo", "v3"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->Get(ropts, "foo", &value));
+  ASSERT_EQ("v3", value);
+}
+
 TEST_F(DBBasicTest, CheckLock) {
   do {
     DB* localdb = nullptr;
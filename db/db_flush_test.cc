@@ -145,6 +145,36 @@ TEST_F(DBFlushTest, SyncSkip) {
   Destroy(options);
 }
 
+TEST_F(DBFlushTest, SyncSkipWalFreeCF) {
+  // Flushing a wal_free column family must not sync closed WALs, even with
+  // multiple column families in the DB.
+  Options options = CurrentOptions();
+  options.wal_free = true;
+
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"DBFlushTest::SyncSkipWalFreeCF:1", "DBImpl::SyncClosedLogs:Skip"},
+       {"DBImpl::SyncClosedLogs:Skip", "DBFlushTest::SyncSkipWalFreeCF:2"}});
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  CreateAndReopenWithCF({"derived"}, options);
+  WriteOptions wo;
+  wo.disableWAL = true;
+  ASSERT_OK(db_->Put(wo, handles_[1], "key", "value"));
+
+  FlushOptions flush_options;
+  flush_options.wait = false;
+  ASSERT_OK(dbfull()->Flush(flush_options, handles_[1]));
+
+  TEST_SYNC_POINT("DBFlushTest::SyncSkipWalFreeCF:1");
+  TEST_SYNC_POINT("DBFlushTest::SyncSkipWalFreeCF:2");
+
+  // Now the background job will do the flush; wait for it.
+  ASSERT_OK(dbfull()->TEST_WaitForFlushMemTable(handles_[1]));
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  Destroy(options);
+}
+
 TEST_F(DBFlushTest, FlushInLowPriThreadPool) {
   // Verify setting an empty high-pri (flush) thread pool causes flushes to be
   // scheduled in the low-pri (compaction) thread pool.
@@ -1073,6 +1103,58 @@ TEST_F(DBFlushTest, MemPurgeBasic) {
   Close();
 }
 
+// Verify that the MemPurge decider can sample a HashSpdbRep memtable
+// (UniqueRandomSample support) and that overwrite-heavy workloads are
+// mempurged instead of flushed to storage.
+TEST_F(DBFlushTest, MemPurgeHashSpdbRep) {
+  Options options = CurrentOptions();
+  options.statistics = CreateDBStatistics();
+  options.statistics->set_stats_level(StatsLevel::kAll);
+  options.create_if_missing = true;
+  options.compression = kNoCompression;
+  options.inplace_update_support = false;
+  options.allow_concurrent_memtable_write = true;
+  options.write_buffer_size = 1 << 20;
+  options.memtable_factory.reset(NewHashSpdbRepFactory(1000));
+  options.experimental_mempurge_threshold = 1.0;
+  ASSERT_OK(TryReopen(options));
+
+  std::atomic<uint32_t> mempurge_count{0};
+  std::atomic<uint32_t> sst_count{0};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::FlushJob:MemPurgeSuccessful",
+      [&](void* /*arg*/) { mempurge_count++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::FlushJob:SSTFileCreated", [&](void* /*arg*/) { sst_count++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  // Heavy overwrite workload: the same small key set is rewritten with
+  // fresh values until multiple memtable switches have happened.
+  Random rnd(433);
+  const size_t NUM_REPEAT = 100;
+  const size_t NUM_KEYS = 5;
+  const size_t RAND_VALUES_LENGTH = 10240;
+  std::vector<std::string> values(NUM_KEYS);
+  for (size_t i = 0; i < NUM_REPEAT; i++) {
+    for (size_t k = 0; k < NUM_KEYS; k++) {
+      values[k] = rnd.RandomString(RAND_VALUES_LENGTH);
+      ASSERT_OK(Put("IamKey" + std::to_string(k), values[k]));
+    }
+    for (size_t k = 0; k < NUM_KEYS; k++) {
+      ASSERT_EQ(Get("IamKey" + std::to_string(k)), values[k]);
+    }
+  }
+
+  // At least one mempurge must have happened, and no SST file should
+  // have been created by flush for this overwrite-only workload.
+  EXPECT_GE(mempurge_count.load(), 1u);
+  EXPECT_EQ(sst_count.load(), 0u);
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  Close();
+}
+
 // RocksDB lite does not support dynamic options
 TEST_F(DBFlushTest, MemPurgeBasicToggle) {
   Options options = CurrentOptions();
@@ -71,6 +71,7 @@
 #include "file/file_util.h"
 #include "file/filename.h"
 #include "file/random_access_file_reader.h"
+#include "file/read_write_util.h"
 #include "file/sst_file_manager_impl.h"
 #include "logging/auto_roll_logger.h"
 #include "logging/log_buffer.h"
@@ -79,6 +80,7 @@
 #include "monitoring/instrumented_mutex.h"
 #include "monitoring/iostats_context_imp.h"
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/perf_context_sampler.h"
 #include "monitoring/persistent_stats_history.h"
 #include "monitoring/thread_status_updater.h"
 #include "monitoring/thread_status_util.h"
@@ -222,6 +224,7 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       bg_flush_scheduled_(0),
       num_running_flushes_(0),
       bg_purge_scheduled_(0),
+      bg_prealloc_wal_scheduled_(0),
       disable_delete_obsolete_files_(0),
       pending_purge_obsolete_files_(0),
       delete_obsolete_files_last_run_(immutable_db_options_.clock->NowMicros()),
@@ -310,7 +313,20 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   }
 
   if (immutable_db_options_.use_spdb_writes) {
-    spdb_write_.reset(new SpdbWriteImpl(this));
+    if (seq_per_batch_ || immutable_db_options_.two_write_queues ||
+        immutable_db_options_.unordered_write) {
+      // The Speedb write flow cannot do seq_per_batch sequence accounting,
+      // run the ordered pre-release callbacks of the prepared-transaction
+      // layer, or defer sequence publication. Fall back to the default write
+      // flow, whose write groups already merge the 2PC markers of concurrent
+      // transactions into a single WAL write.
+      ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                     "use_spdb_writes is not supported with seq_per_batch, "
+                     "two_write_queues or unordered_write; using the default "
+                     "write flow instead");
+    } else {
+      spdb_write_.reset(new SpdbWriteImpl(this));
+    }
   }
 }
 
@@ -564,6 +580,9 @@ Status DBImpl::MaybeReleaseTimestampedSnapshotsAndCheck() {
 }
 
 Status DBImpl::CloseHelper() {
+  // Release recycled iterators first: they hold super-version references.
+  PurgeAllRecycledIterators();
+
   if (is_registered_for_flush_initiation_rqsts_) {
     assert(write_buffer_manager_);
     assert(write_buffer_manager_->IsInitiatingFlushes());
@@ -613,11 +632,22 @@ Status DBImpl::CloseHelper() {
   // Wait for background work to finish
   while (bg_bottom_compaction_scheduled_ || bg_compaction_scheduled_ ||
          bg_flush_scheduled_ || bg_purge_scheduled_ ||
-         pending_purge_obsolete_files_ ||
+         bg_prealloc_wal_scheduled_ || pending_purge_obsolete_files_ ||
          error_handler_.IsRecoveryInProgress()) {
     TEST_SYNC_POINT("DBImpl::~DBImpl:WaitJob");
     bg_cv_.Wait();
   }
+  {
+    // Remove any WAL files still sitting in the preallocation pool; nothing
+    // else cleans them up since their names are invisible to ParseFileName()
+    InstrumentedMutexLock l(&prealloc_wal_mutex_);
+    for (const PreallocatedWAL& ready : prealloc_wal_pool_) {
+      fs_->DeleteFile(ready.fname, IOOptions(), nullptr)
+          .PermitUncheckedError();
+    }
+    prealloc_wal_pool_.clear();
+    prealloc_wal_slot_filled_.clear();
+  }
   TEST_SYNC_POINT_CALLBACK("DBImpl::CloseHelper:PendingPurgeFinished",
                            &files_grabbed_for_purge_);
   EraseThreadStatusDbInfo();
@@ -1074,6 +1104,15 @@ Status DBImpl::GetStatsHistory(
   return (*stats_iterator)->status();
 }
 
+Status DBImpl::GetWriteStallTimeline(
+    std::vector<WriteStallTimelineEvent>* events) {
+  if (events == nullptr) {
+    return Status::InvalidArgument("events not preallocated.");
+  }
+  versions_->GetColumnFamilySet()->write_stall_timeline()->Get(events);
+  return Status::OK();
+}
+
 void DBImpl::DumpStats() {
   TEST_SYNC_POINT("DBImpl::DumpStats:1");
   std::string stats;
@@ -1084,31 +1123,31 @@ void DBImpl::DumpStats() {
   // Also probe block cache(s) for problems, dump to info log
   UnorderedSet<Cache*> probed_caches;
   TEST_SYNC_POINT("DBImpl::DumpStats:StartRunning");
-  {
-    InstrumentedMutexLock l(&mutex_);
-    for (auto cfd : versions_->GetRefedColumnFamilySet()) {
-      if (!cfd->initialized()) {
-        continue;
-      }
+  // Gather cache entry stats without the DB mutex, iterating the lock-free
+  // column family catalog. Pass over all column families for this first so
+  // that other stats are dumped near-atomically.
+  auto catalog = versions_->GetColumnFamilySet()->GetCatalog();
+  for (auto cfd : catalog->column_families) {
+    if (cfd->IsDropped() || !cfd->initialized()) {
+      continue;
+    }
 
-      // Release DB mutex for gathering cache entry stats. Pass over all
-      // column families for this first so that other stats are dumped
-      // near-atomically.
-      InstrumentedMutexUnlock u(&mutex_);
-      cfd->internal_stats()->CollectCacheEntryStats(/*foreground=*/false);
-
-      // Probe block cache for problems (if not already via another CF)
-      if (immutable_db_options_.info_log) {
-        auto* table_factory = cfd->ioptions()->table_factory.get();
-        assert(table_factory != nullptr);
-        Cache* cache =
-            table_factory->GetOptions<Cache>(TableFactory::kBlockCacheOpts());
-        if (cache && probed_caches.insert(cache).second) {
-          cache->ReportProblems(immutable_db_options_.info_log);
-        }
+    cfd->internal_stats()->CollectCacheEntryStats(/*foreground=*/false);
+
+    // Probe block cache for problems (if not already via another CF)
+    if (immutable_db_options_.info_log) {
+      auto* table_factory = cfd->ioptions()->table_factory.get();
+      assert(table_factory != nullptr);
+      Cache* cache =
+          table_factory->GetOptions<Cache>(TableFactory::kBlockCacheOpts());
+      if (cache && probed_caches.insert(cache).second) {
+        cache->ReportProblems(immutable_db_options_.info_log);
       }
     }
+  }
 
+  {
+    InstrumentedMutexLock l(&mutex_);
     const std::string* property = &DB::Properties::kDBStats;
     const DBPropertyInfo* property_info = GetPropertyInfo(*property);
     assert(property_info != nullptr);
@@ -1142,6 +1181,223 @@ void DBImpl::DumpStats() {
   }
 
   PrintStatistics();
+
+  MaybeReportTuningAdvice();
+}
+
+Status DBImpl::GetTuningReport(std::string* report) {
+  bool has_suggestions = false;
+  return GetTuningReportImpl(report, &has_suggestions);
+}
+
+Status DBImpl::GetTuningReportImpl(std::string* report,
+                                   bool* has_suggestions) {
+  assert(report != nullptr);
+  assert(has_suggestions != nullptr);
+  report->clear();
+  *has_suggestions = false;
+
+  struct CFSnapshot {
+    std::string name;
+    uint32_t id = 0;
+    // Same layout as TuningAdvisorSample::cf_stall_counts.
+    std::array<uint64_t, 3> stalls = {};
+    int l0_files = 0;
+    int level0_slowdown_writes_trigger = 0;
+    int max_write_buffer_number = 0;
+    uint64_t write_buffer_size = 0;
+    uint64_t soft_pending_compaction_bytes_limit = 0;
+    uint64_t pending_compaction_bytes = 0;
+  };
+  std::vector<CFSnapshot> cfs;
+  {
+    InstrumentedMutexLock l(&mutex_);
+    for (auto cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped() || !cfd->initialized()) {
+        continue;
+      }
+      const InternalStats* internal_stats = cfd->internal_stats();
+      const MutableCFOptions& cf_opts = *cfd->GetLatestMutableCFOptions();
+      const auto* vstorage = cfd->current()->storage_info();
+      CFSnapshot snap;
+      snap.name = cfd->GetName();
+      snap.id = cfd->GetID();
+      snap.stalls[0] =
+          internal_stats->GetCFStatsCount(InternalStats::MEMTABLE_LIMIT_DELAYS) +
+          internal_stats->GetCFStatsCount(InternalStats::MEMTABLE_LIMIT_STOPS);
+      snap.stalls[1] =
+          internal_stats->GetCFStatsCount(
+              InternalStats::L0_FILE_COUNT_LIMIT_DELAYS) +
+          internal_stats->GetCFStatsCount(
+              InternalStats::L0_FILE_COUNT_LIMIT_STOPS) +
+          internal_stats->GetCFStatsCount(
+              InternalStats::
+                  L0_FILE_COUNT_LIMIT_DELAYS_WITH_ONGOING_COMPACTION) +
+          internal_stats->GetCFStatsCount(
+              InternalStats::L0_FILE_COUNT_LIMIT_STOPS_WITH_ONGOING_COMPACTION);
+      snap.stalls[2] =
+          internal_stats->GetCFStatsCount(
+              InternalStats::PENDING_COMPACTION_BYTES_LIMIT_DELAYS) +
+          internal_stats->GetCFStatsCount(
+              InternalStats::PENDING_COMPACTION_BYTES_LIMIT_STOPS);
+      snap.l0_files = vstorage->NumLevelFiles(0);
+      snap.pending_compaction_bytes =
+          vstorage->estimated_compaction_needed_bytes();
+      snap.level0_slowdown_writes_trigger =
+          cf_opts.level0_slowdown_writes_trigger;
+      snap.max_write_buffer_number = cf_opts.max_write_buffer_number;
+      snap.write_buffer_size = cf_opts.write_buffer_size;
+      snap.soft_pending_compaction_bytes_limit =
+          cf_opts.soft_pending_compaction_bytes_limit;
+      cfs.push_back(std::move(snap));
+    }
+  }
+
+  // Ticker values for the cache and filter rules; index layout matches
+  // TuningAdvisorSample::tickers.
+  std::array<uint64_t, 6> tickers = {};
+  if (stats_ != nullptr) {
+    tickers[0] = stats_->getTickerCount(BLOCK_CACHE_MISS);
+    tickers[1] = stats_->getTickerCount(BLOCK_CACHE_HIT);
+    tickers[2] = stats_->getTickerCount(BLOOM_FILTER_USEFUL);
+    tickers[3] = stats_->getTickerCount(BLOOM_FILTER_FULL_POSITIVE);
+    tickers[4] = stats_->getTickerCount(BLOOM_FILTER_FULL_TRUE_POSITIVE);
+    tickers[5] = stats_->getTickerCount(STALL_MICROS);
+  }
+
+  // Compute deltas against the previous sample and start a new window.
+  std::map<uint32_t, std::array<uint64_t, 3>> cf_deltas;
+  std::array<uint64_t, 6> ticker_deltas = {};
+  {
+    std::lock_guard<std::mutex> lock(tuning_advisor_mutex_);
+    for (const CFSnapshot& snap : cfs) {
+      std::array<uint64_t, 3> delta = snap.stalls;
+      if (tuning_advisor_last_.valid) {
+        auto it = tuning_advisor_last_.cf_stall_counts.find(snap.id);
+        if (it != tuning_advisor_last_.cf_stall_counts.end()) {
+          for (size_t i = 0; i < delta.size(); ++i) {
+            delta[i] -= std::min(delta[i], it->second[i]);
+          }
+        }
+      }
+      cf_deltas[snap.id] = delta;
+    }
+    for (size_t i = 0; i < tickers.size(); ++i) {
+      ticker_deltas[i] = tickers[i];
+      if (tuning_advisor_last_.valid) {
+        ticker_deltas[i] -=
+            std::min(tickers[i], tuning_advisor_last_.tickers[i]);
+      }
+    }
+    tuning_advisor_last_.cf_stall_counts.clear();
+    for (const CFSnapshot& snap : cfs) {
+      tuning_advisor_last_.cf_stall_counts[snap.id] = snap.stalls;
+    }
+    tuning_advisor_last_.tickers = tickers;
+    tuning_advisor_last_.valid = true;
+  }
+
+  std::string suggestions;
+  char buf[512];
+  for (const CFSnapshot& snap : cfs) {
+    const auto& delta = cf_deltas[snap.id];
+    if (delta[0] > 0) {
+      snprintf(buf, sizeof(buf),
+               "[%s] %" PRIu64
+               " write stalls hit the memtable count limit; consider "
+               "SetOptions({{\"max_write_buffer_number\", \"%d\"}}) (current "
+               "%d) or a larger write_buffer_size (current %" PRIu64 ")\n",
+               snap.name.c_str(), delta[0], snap.max_write_buffer_number + 1,
+               snap.max_write_buffer_number, snap.write_buffer_size);
+      suggestions.append(buf);
+    }
+    if (delta[1] > 0) {
+      snprintf(buf, sizeof(buf),
+               "[%s] %" PRIu64
+               " write stalls hit the L0 file count limit (%d L0 files now); "
+               "the trigger is too low for the ingest rate: consider "
+               "SetOptions({{\"level0_slowdown_writes_trigger\", \"%d\"}}) "
+               "(current %d) or more compaction parallelism via "
+               "SetDBOptions({{\"max_background_jobs\", ...}})\n",
+               snap.name.c_str(), delta[1], snap.l0_files,
+               snap.level0_slowdown_writes_trigger + 4,
+               snap.level0_slowdown_writes_trigger);
+      suggestions.append(buf);
+    }
+    if (delta[2] > 0) {
+      snprintf(buf, sizeof(buf),
+               "[%s] %" PRIu64
+               " write stalls hit the pending compaction bytes limit "
+               "(%" PRIu64
+               " bytes pending now); consider "
+               "SetOptions({{\"soft_pending_compaction_bytes_limit\", ...}}) "
+               "(current %" PRIu64 ") or more compaction bandwidth\n",
+               snap.name.c_str(), delta[2], snap.pending_compaction_bytes,
+               snap.soft_pending_compaction_bytes_limit);
+      suggestions.append(buf);
+    }
+  }
+  if (stats_ != nullptr) {
+    const uint64_t cache_accesses = ticker_deltas[0] + ticker_deltas[1];
+    if (cache_accesses >= 1000 && ticker_deltas[0] * 2 > cache_accesses) {
+      snprintf(buf, sizeof(buf),
+               "[db] block cache miss ratio %" PRIu64 "%% over %" PRIu64
+               " accesses; consider a larger block cache\n",
+               ticker_deltas[0] * 100 / cache_accesses, cache_accesses);
+      suggestions.append(buf);
+    }
+    const uint64_t filter_negatives = ticker_deltas[2];
+    const uint64_t filter_positives = ticker_deltas[3];
+    const uint64_t filter_checks = filter_negatives + filter_positives;
+    const uint64_t false_positives =
+        filter_positives - std::min(filter_positives, ticker_deltas[4]);
+    if (filter_checks >= 1000 && false_positives * 5 > filter_checks) {
+      snprintf(buf, sizeof(buf),
+               "[db] %" PRIu64 " of %" PRIu64
+               " filter checks were false positives; consider more filter "
+               "bits_per_key in the table factory's filter policy, or "
+               "pin_l0_filter_and_index_blocks_in_cache if filter partitions "
+               "are being evicted\n",
+               false_positives, filter_checks);
+      suggestions.append(buf);
+    }
+    if (ticker_deltas[5] > 0) {
+      snprintf(buf, sizeof(buf),
+               "[db] writes spent %" PRIu64
+               " micros stalled in this window\n",
+               ticker_deltas[5]);
+      suggestions.append(buf);
+    }
+  }
+
+  *report = "--- Tuning report ---\n";
+  if (stats_ == nullptr) {
+    report->append(
+        "(DBOptions::statistics not set; cache and filter rules skipped)\n");
+  }
+  if (suggestions.empty()) {
+    report->append("no tuning suggestions in this window\n");
+  } else {
+    *has_suggestions = true;
+    report->append(suggestions);
+  }
+  return Status::OK();
+}
+
+void DBImpl::MaybeReportTuningAdvice() {
+  if (shutdown_initiated_) {
+    return;
+  }
+  std::string tuning_report;
+  bool has_suggestions = false;
+  if (!GetTuningReportImpl(&tuning_report, &has_suggestions).ok() ||
+      !has_suggestions) {
+    return;
+  }
+  ROCKS_LOG_WARN(immutable_db_options_.info_log, "%s", tuning_report.c_str());
+  for (auto& listener : immutable_db_options_.listeners) {
+    listener->OnTuningReport(this, tuning_report);
+  }
 }
 
 // Periodically flush info log out of application buffer at a low frequency.
@@ -1468,6 +1724,8 @@ Status DBImpl::SetDBOptions(
           file_options_for_compaction_, immutable_db_options_);
       file_options_for_compaction_.compaction_readahead_size =
           mutable_db_options_.compaction_readahead_size;
+      file_options_for_compaction_.cold_tier_compaction_readahead_size =
+          mutable_db_options_.cold_tier_compaction_readahead_size;
       WriteThread::Writer w;
       write_thread_.EnterUnbatched(&w, &mutex_);
       if (total_log_size_ > GetMaxTotalWalSize() || wal_changed) {
@@ -1908,6 +2166,120 @@ void DBImpl::BackgroundCallPurge() {
 
 namespace {
 
+// Pool files carry names that ParseFileName() does not recognize, so
+// obsolete-file purging and recovery leave them alone.
+std::string PreallocatedWALName(const std::string& wal_dir, size_t slot) {
+  return wal_dir + "/prealloc." + std::to_string(slot) + ".wal";
+}
+
+}  // namespace
+
+void DBImpl::MaybeScheduleWALPrealloc() {
+  mutex_.AssertHeld();
+  if (immutable_db_options_.recycle_log_file_num == 0 ||
+      !opened_successfully_ || shutdown_initiated_ ||
+      bg_prealloc_wal_scheduled_ > 0) {
+    return;
+  }
+  {
+    InstrumentedMutexLock l(&prealloc_wal_mutex_);
+    if (prealloc_wal_pool_.size() >=
+        immutable_db_options_.recycle_log_file_num) {
+      return;
+    }
+  }
+  bg_prealloc_wal_scheduled_++;
+  env_->Schedule(&DBImpl::BGWorkPreallocWAL, this, Env::Priority::HIGH,
+                 nullptr);
+}
+
+void DBImpl::BGWorkPreallocWAL(void* db) {
+  IOSTATS_SET_THREAD_POOL_ID(Env::Priority::HIGH);
+  TEST_SYNC_POINT("DBImpl::BGWorkPreallocWAL:start");
+  static_cast<DBImpl*>(db)->BackgroundCallPreallocWAL();
+  TEST_SYNC_POINT("DBImpl::BGWorkPreallocWAL:end");
+}
+
+void DBImpl::BackgroundCallPreallocWAL() {
+  const size_t target = immutable_db_options_.recycle_log_file_num;
+  const DBOptions db_options =
+      BuildDBOptions(immutable_db_options_, mutable_db_options_);
+  const FileOptions opt_file_options =
+      fs_->OptimizeForLogWrite(file_options_, db_options);
+  const std::string wal_dir = immutable_db_options_.GetWalDir();
+  while (!shutting_down_.load(std::memory_order_acquire)) {
+    size_t slot;
+    std::string fname;
+    {
+      InstrumentedMutexLock l(&prealloc_wal_mutex_);
+      if (prealloc_wal_slot_filled_.size() < target) {
+        prealloc_wal_slot_filled_.resize(target, false);
+      }
+      if (prealloc_wal_pool_.size() >= target) {
+        break;
+      }
+      slot = target;
+      for (size_t i = 0; i < target; i++) {
+        if (!prealloc_wal_slot_filled_[i]) {
+          slot = i;
+          break;
+        }
+      }
+      if (slot == target) {
+        // All slots filled; files are in flight between Take and adoption
+        break;
+      }
+      prealloc_wal_slot_filled_[slot] = true;
+      fname = PreallocatedWALName(wal_dir, slot);
+    }
+    // NewWritableFile truncates a stale pool file left over by a crashed
+    // instance, so the same slot names are safe to reuse across instances.
+    std::unique_ptr<FSWritableFile> file;
+    IOStatus io_s = NewWritableFile(fs_.get(), fname, &file, opt_file_options);
+    if (io_s.ok()) {
+      uint64_t preallocate_size =
+          wal_prealloc_block_size_.load(std::memory_order_relaxed);
+      if (preallocate_size > 0) {
+        // Reserve the first extent so the adopting WAL writer does not block
+        // on allocation; best effort, not all file systems support it
+        file->Allocate(0, preallocate_size, IOOptions(), nullptr)
+            .PermitUncheckedError();
+      }
+      io_s = file->Close(IOOptions(), nullptr);
+    }
+    InstrumentedMutexLock l(&prealloc_wal_mutex_);
+    if (io_s.ok()) {
+      prealloc_wal_pool_.push_back({slot, fname});
+    } else {
+      prealloc_wal_slot_filled_[slot] = false;
+      ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                     "Failed to preallocate WAL %s -- %s", fname.c_str(),
+                     io_s.ToString().c_str());
+      break;
+    }
+  }
+  InstrumentedMutexLock l(&mutex_);
+  assert(bg_prealloc_wal_scheduled_ > 0);
+  bg_prealloc_wal_scheduled_--;
+  bg_cv_.SignalAll();
+  // IMPORTANT: no code after SignalAll; see BackgroundCallPurge()
+}
+
+bool DBImpl::TakePreallocatedWAL(std::string* fname) {
+  InstrumentedMutexLock l(&prealloc_wal_mutex_);
+  if (prealloc_wal_pool_.empty()) {
+    return false;
+  }
+  const PreallocatedWAL& ready = prealloc_wal_pool_.front();
+  *fname = ready.fname;
+  assert(ready.slot < prealloc_wal_slot_filled_.size());
+  prealloc_wal_slot_filled_[ready.slot] = false;
+  prealloc_wal_pool_.pop_front();
+  return true;
+}
+
+namespace {
+
 // A `SuperVersionHandle` holds a non-null `SuperVersion*` pointing at a
 // `SuperVersion` referenced once for this object. It also contains the state
 // needed to clean up the `SuperVersion` reference from outside of `DBImpl`
@@ -2139,6 +2511,10 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     get_impl_options.timestamp->clear();
   }
 
+  // Must precede the perf timer guards below so that a sampled operation has
+  // its timers enabled from the start.
+  ScopedPerfContextSample perf_context_sample;
+
   GetWithTimestampReadCallback read_cb(0);  // Will call Refresh
 
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, immutable_db_options_.clock);
@@ -2167,6 +2543,33 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     }
   }
 
+  if (read_options.snapshot_seqno != 0) {
+    // Snapshot-free point-in-time read: the caller supplies the sequence
+    // number bound directly and guarantees it is above the compaction
+    // horizon, so no snapshot is registered (and no DB mutex is taken).
+    // Only the cheap bounds are validated here; see
+    // ReadOptions::snapshot_seqno.
+    if (read_options.snapshot != nullptr) {
+      return Status::InvalidArgument(
+          "snapshot and snapshot_seqno cannot both be set");
+    }
+    if (get_impl_options.callback != nullptr) {
+      return Status::NotSupported(
+          "snapshot_seqno is not supported with a read callback");
+    }
+    if (read_options.snapshot_seqno > GetLastPublishedSequence()) {
+      return Status::InvalidArgument(
+          "snapshot_seqno is beyond the last published sequence number");
+    }
+    const SequenceNumber oldest_snapshot =
+        snapshots_.UnlockedOldestSnapshotSeqno();
+    if (oldest_snapshot != 0 &&
+        read_options.snapshot_seqno < oldest_snapshot) {
+      return Status::InvalidArgument(
+          "snapshot_seqno is below the oldest registered snapshot");
+    }
+  }
+
   // Acquire SuperVersion
   SuperVersion* sv = GetAndRefSuperVersion(cfd);
 
@@ -2188,7 +2591,18 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     // data for the snapshot, so the reader would see neither data that was be
     // visible to the snapshot before compaction nor the newer data inserted
     // afterwards.
-    snapshot = GetLastPublishedSequence();
+    if (read_options.snapshot_seqno != 0) {
+      snapshot = read_options.snapshot_seqno;
+    } else if (read_options.allow_stale_immutable_view &&
+               get_impl_options.callback == nullptr) {
+      // The immutable memtables and SST files of the referenced super
+      // version form a fixed set, so reading them with maximum visibility
+      // yields a consistent view as of the last memtable switch without
+      // consulting the published sequence number.
+      snapshot = kMaxSequenceNumber;
+    } else {
+      snapshot = GetLastPublishedSequence();
+    }
     if (get_impl_options.callback) {
       // The unprep_seqs are not published for write unprepared, so it could be
       // that max_visible_seq is larger. Seek to the std::max of the two.
@@ -2242,7 +2656,8 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   if (!skip_memtable) {
     // Get value associated with key
     if (get_impl_options.get_value) {
-      if (sv->mem->Get(
+      if (!read_options.allow_stale_immutable_view &&
+          sv->mem->Get(
               lkey,
               get_impl_options.value ? get_impl_options.value->GetSelf()
                                      : nullptr,
@@ -2277,17 +2692,21 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     } else {
       // Get Merge Operands associated with key, Merge Operands should not be
       // merged and raw values should be returned to the user.
-      if (sv->mem->Get(lkey, /*value=*/nullptr, /*columns=*/nullptr,
+      const bool stop_when_should_merge =
+          get_impl_options.get_merge_operands_options->stop_when_should_merge;
+      if (!read_options.allow_stale_immutable_view &&
+          sv->mem->Get(lkey, /*value=*/nullptr, /*columns=*/nullptr,
                        /*timestamp=*/nullptr, &s, &merge_context,
                        &max_covering_tombstone_seq, read_options,
-                       false /* immutable_memtable */, nullptr, nullptr,
-                       false)) {
+                       false /* immutable_memtable */, nullptr, nullptr, false,
+                       stop_when_should_merge)) {
         done = true;
         RecordTick(stats_, MEMTABLE_HIT);
       } else if ((s.ok() || s.IsMergeInProgress()) &&
                  sv->imm->GetMergeOperands(lkey, &s, &merge_context,
                                            &max_covering_tombstone_seq,
-                                           read_options)) {
+                                           read_options,
+                                           stop_when_should_merge)) {
         done = true;
         RecordTick(stats_, MEMTABLE_HIT);
       }
@@ -2310,7 +2729,10 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
         nullptr, nullptr,
         get_impl_options.get_value ? get_impl_options.callback : nullptr,
         get_impl_options.get_value ? get_impl_options.is_blob_index : nullptr,
-        get_impl_options.get_value);
+        get_impl_options.get_value,
+        get_impl_options.get_merge_operands_options != nullptr &&
+            get_impl_options.get_merge_operands_options
+                ->stop_when_should_merge);
     RecordTick(stats_, MEMTABLE_MISS);
   }
 
@@ -2534,7 +2956,8 @@ std::vector<Status> DBImpl::MultiGet(
          has_unpersisted_data_.load(std::memory_order_relaxed));
     bool done = false;
     if (!skip_memtable) {
-      if (super_version->mem->Get(
+      if (!read_options.allow_stale_immutable_view &&
+          super_version->mem->Get(
               lkey, value, /*columns=*/nullptr, timestamp, &s, &merge_context,
               &max_covering_tombstone_seq, read_options,
               false /* immutable_memtable */, read_callback)) {
@@ -2862,22 +3285,60 @@ void DBImpl::MultiGetCommon(const ReadOptions& read_options,
     read_callback = &timestamp_read_callback;
   }
 
-  Status s;
-  auto cf_iter = multiget_cf_data.begin();
-  for (; cf_iter != multiget_cf_data.end(); ++cf_iter) {
-    s = MultiGetImpl(read_options, cf_iter->start, cf_iter->num_keys,
-                     &sorted_keys, cf_iter->super_version, consistent_seqnum,
-                     read_callback);
-    if (!s.ok()) {
-      break;
+  const size_t num_cfs = multiget_cf_data.size();
+  if (num_cfs > 1 && read_options.async_io) {
+    // Overlap the lookups of the independent column families on helper
+    // threads so a logical record spread across several CFs pays roughly
+    // one storage round trip instead of one per CF. The per-CF key ranges
+    // are disjoint and each lookup uses its own super version, so the only
+    // shared state is the thread-safe statistics object. Builds with
+    // coroutine support get this overlap within one thread instead; here
+    // the helper threads' perf contexts are not folded back into the
+    // caller's.
+    std::atomic<size_t> next_cf{0};
+    auto lookup_fn = [&]() {
+      while (true) {
+        size_t idx = next_cf.fetch_add(1, std::memory_order_relaxed);
+        if (idx >= num_cfs) {
+          break;
+        }
+        const auto& mgd = multiget_cf_data[idx];
+        Status cf_s =
+            MultiGetImpl(read_options, mgd.start, mgd.num_keys, &sorted_keys,
+                         mgd.super_version, consistent_seqnum, read_callback);
+        // MultiGetImpl sets the per-key statuses of its whole range on
+        // failure, so nothing more to propagate here
+        assert(cf_s.ok() || cf_s.IsTimedOut() || cf_s.IsAborted());
+        cf_s.PermitUncheckedError();
+      }
+    };
+    std::vector<port::Thread> helpers;
+    helpers.reserve(num_cfs - 1);
+    for (size_t i = 0; i + 1 < num_cfs; ++i) {
+      helpers.emplace_back(lookup_fn);
     }
-  }
-  if (!s.ok()) {
-    assert(s.IsTimedOut() || s.IsAborted());
-    for (++cf_iter; cf_iter != multiget_cf_data.end(); ++cf_iter) {
-      for (size_t i = cf_iter->start; i < cf_iter->start + cf_iter->num_keys;
-           ++i) {
-        *sorted_keys[i]->s = s;
+    lookup_fn();
+    for (auto& t : helpers) {
+      t.join();
+    }
+  } else {
+    Status s;
+    auto cf_iter = multiget_cf_data.begin();
+    for (; cf_iter != multiget_cf_data.end(); ++cf_iter) {
+      s = MultiGetImpl(read_options, cf_iter->start, cf_iter->num_keys,
+                       &sorted_keys, cf_iter->super_version, consistent_seqnum,
+                       read_callback);
+      if (!s.ok()) {
+        break;
+      }
+    }
+    if (!s.ok()) {
+      assert(s.IsTimedOut() || s.IsAborted());
+      for (++cf_iter; cf_iter != multiget_cf_data.end(); ++cf_iter) {
+        for (size_t i = cf_iter->start; i < cf_iter->start + cf_iter->num_keys;
+             ++i) {
+          *sorted_keys[i]->s = s;
+        }
       }
     }
   }
@@ -3074,8 +3535,11 @@ Status DBImpl::MultiGetImpl(
 
   assert(sorted_keys);
   // Clear the timestamps for returning results so that we can distinguish
-  // between tombstone or key that has never been written
-  for (auto* kctx : *sorted_keys) {
+  // between tombstone or key that has never been written. Only touch this
+  // call's range of keys: in the multi-CF case other ranges belong to other
+  // column families, possibly processed concurrently.
+  for (size_t i = start_key; i < start_key + num_keys; ++i) {
+    KeyContext* kctx = (*sorted_keys)[i];
     assert(kctx);
     if (kctx->timestamp) {
       kctx->timestamp->clear();
@@ -3118,8 +3582,10 @@ Status DBImpl::MultiGetImpl(
         (read_options.read_tier == kPersistedTier &&
          has_unpersisted_data_.load(std::memory_order_relaxed));
     if (!skip_memtable) {
-      super_version->mem->MultiGet(read_options, &range, callback,
-                                   false /* immutable_memtable */);
+      if (!read_options.allow_stale_immutable_view) {
+        super_version->mem->MultiGet(read_options, &range, callback,
+                                     false /* immutable_memtable */);
+      }
       if (!range.empty()) {
         super_version->imm->MultiGet(read_options, &range, callback);
       }
@@ -3446,6 +3912,9 @@ Status DBImpl::DropColumnFamilyImpl(ColumnFamilyHandle* column_family) {
     // later inside db_mutex.
     EraseThreadStatusCfInfo(cfd);
     assert(cfd->IsDropped());
+    // A recycled iterator would keep the dropped column family's
+    // super-version alive until DB close; release it now.
+    PurgeRecycledIterators(cfd->GetID());
     ROCKS_LOG_INFO(immutable_db_options_.info_log,
                    "Dropped column family with id %u\n", cfd->GetID());
   } else {
@@ -3527,15 +3996,150 @@ Iterator* DBImpl::NewIterator(const ReadOptions& read_options,
     // Note: no need to consider the special case of
     // last_seq_same_as_publish_seq_==false since NewIterator is overridden in
     // WritePreparedTxnDB
-    result = NewIteratorImpl(read_options, cfd,
-                             (read_options.snapshot != nullptr)
-                                 ? read_options.snapshot->GetSequenceNumber()
-                                 : kMaxSequenceNumber,
-                             read_callback);
+    if (immutable_db_options_.recycle_iterators &&
+        IsIteratorPoolEligible(read_options)) {
+      // Eligibility implies read_options.snapshot == nullptr.
+      ArenaWrappedDBIter* inner = GetRecycledIterator(read_options, cfd);
+      if (inner == nullptr) {
+        inner = NewIteratorImpl(read_options, cfd, kMaxSequenceNumber,
+                                read_callback);
+      }
+      result = new RecyclableDBIter(this, cfd->GetID(), inner);
+    } else {
+      result = NewIteratorImpl(read_options, cfd,
+                               (read_options.snapshot != nullptr)
+                                   ? read_options.snapshot->GetSequenceNumber()
+                                   : kMaxSequenceNumber,
+                               read_callback);
+    }
   }
   return result;
 }
 
+bool DBImpl::IsIteratorPoolEligible(const ReadOptions& read_options) {
+  // A snapshot disables ArenaWrappedDBIter::Refresh(), timestamps pin the
+  // iterator to a point in time, and table_filter cannot be compared for
+  // reuse. Tailing and managed iterators never reach the pool anyway.
+  return read_options.snapshot == nullptr && !read_options.tailing &&
+         !read_options.managed && read_options.timestamp == nullptr &&
+         read_options.iter_start_ts == nullptr && !read_options.table_filter;
+}
+
+bool DBImpl::PooledIterReadOptionsCompatible(
+    const ReadOptions& pooled, const ReadOptions& requested) const {
+  // Every ReadOptions field that gets baked into the iterator tree must
+  // match. The bound slices are compared by pointer: DBIter and the table
+  // iterators store the pointers, so a caller that reuses the same
+  // ReadOptions object (and updates the pointed-to slices between queries)
+  // still gets a pool hit. Fields excluded by IsIteratorPoolEligible() need
+  // no comparison. If a field is added to ReadOptions, add it here as well.
+  //
+  // async_io is normalized the same way ArenaWrappedDBIter::Init() stores
+  // it, so that file systems without async IO support do not cause permanent
+  // pool misses.
+  const bool requested_async_io =
+      requested.async_io && env_->GetFileSystem()->use_async_io();
+  return pooled.iterate_lower_bound == requested.iterate_lower_bound &&
+         pooled.iterate_upper_bound == requested.iterate_upper_bound &&
+         pooled.readahead_size == requested.readahead_size &&
+         pooled.max_skippable_internal_keys ==
+             requested.max_skippable_internal_keys &&
+         pooled.read_tier == requested.read_tier &&
+         pooled.verify_checksums == requested.verify_checksums &&
+         pooled.fill_cache == requested.fill_cache &&
+         pooled.total_order_seek == requested.total_order_seek &&
+         pooled.auto_prefix_mode == requested.auto_prefix_mode &&
+         pooled.prefix_same_as_start == requested.prefix_same_as_start &&
+         pooled.pin_data == requested.pin_data &&
+         pooled.background_purge_on_iterator_cleanup ==
+             requested.background_purge_on_iterator_cleanup &&
+         pooled.ignore_range_deletions == requested.ignore_range_deletions &&
+         pooled.deadline == requested.deadline &&
+         pooled.io_timeout == requested.io_timeout &&
+         pooled.value_size_soft_limit == requested.value_size_soft_limit &&
+         pooled.adaptive_readahead == requested.adaptive_readahead &&
+         pooled.rate_limiter_priority == requested.rate_limiter_priority &&
+         pooled.async_io == requested_async_io &&
+         pooled.optimize_multiget_for_io == requested.optimize_multiget_for_io &&
+         pooled.skip_expired_data == requested.skip_expired_data &&
+         pooled.part_of_flush == requested.part_of_flush;
+}
+
+ArenaWrappedDBIter* DBImpl::GetRecycledIterator(const ReadOptions& read_options,
+                                                ColumnFamilyData* cfd) {
+  ArenaWrappedDBIter* iter = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(iter_pool_mutex_);
+    auto it = iter_pool_.find(cfd->GetID());
+    if (it != iter_pool_.end()) {
+      // Pick the entry whose baked-in ReadOptions (most notably the bound
+      // slices) match the request, so that interleaved scans with different
+      // bounds each resume their own iterator.
+      auto& entries = it->second;
+      for (size_t i = 0; i < entries.size(); i++) {
+        if (PooledIterReadOptionsCompatible(entries[i]->GetReadOptions(),
+                                            read_options)) {
+          iter = entries[i];
+          entries[i] = entries.back();
+          entries.pop_back();
+          break;
+        }
+      }
+    }
+  }
+  if (iter == nullptr) {
+    return nullptr;
+  }
+  if (!iter->Refresh().ok()) {
+    delete iter;
+    return nullptr;
+  }
+  return iter;
+}
+
+void DBImpl::RecycleIterator(uint32_t cf_id, ArenaWrappedDBIter* iter) {
+  assert(iter != nullptr);
+  // Do not hand out an iterator carrying an error status; Refresh() does not
+  // clear it.
+  if (iter->status().ok()) {
+    std::lock_guard<std::mutex> lock(iter_pool_mutex_);
+    auto& entries = iter_pool_[cf_id];
+    if (entries.size() < kIterPoolEntriesPerCF) {
+      entries.push_back(iter);
+      return;
+    }
+  }
+  delete iter;
+}
+
+void DBImpl::PurgeRecycledIterators(uint32_t cf_id) {
+  autovector<ArenaWrappedDBIter*> entries;
+  {
+    std::lock_guard<std::mutex> lock(iter_pool_mutex_);
+    auto it = iter_pool_.find(cf_id);
+    if (it != iter_pool_.end()) {
+      entries = std::move(it->second);
+      iter_pool_.erase(it);
+    }
+  }
+  for (ArenaWrappedDBIter* iter : entries) {
+    delete iter;
+  }
+}
+
+void DBImpl::PurgeAllRecycledIterators() {
+  std::unordered_map<uint32_t, autovector<ArenaWrappedDBIter*>> pool;
+  {
+    std::lock_guard<std::mutex> lock(iter_pool_mutex_);
+    pool.swap(iter_pool_);
+  }
+  for (auto& entry : pool) {
+    for (ArenaWrappedDBIter* iter : entry.second) {
+      delete iter;
+    }
+  }
+}
+
 ArenaWrappedDBIter* DBImpl::NewIteratorImpl(const ReadOptions& read_options,
                                             ColumnFamilyData* cfd,
                                             SequenceNumber snapshot,
@@ -3683,6 +4287,113 @@ Status DBImpl::NewIterators(
   return Status::OK();
 }
 
+Status DBImpl::NewMergedCrossCFIterator(
+    const ReadOptions& read_options,
+    const std::vector<ColumnFamilyHandle*>& column_families,
+    Iterator** iterator) {
+  assert(iterator != nullptr);
+  *iterator = nullptr;
+  if (column_families.empty()) {
+    return Status::InvalidArgument("No column family provided");
+  }
+  if (read_options.managed) {
+    return Status::NotSupported("Managed iterator is not supported anymore.");
+  }
+  if (read_options.tailing) {
+    return Status::NotSupported(
+        "Tailing iterators are not supported across column families.");
+  }
+  if (read_options.read_tier == kPersistedTier) {
+    return Status::NotSupported(
+        "ReadTier::kPersistedData is not yet supported in iterators.");
+  }
+  if (read_options.timestamp) {
+    return Status::NotSupported(
+        "User-defined timestamps are not supported by "
+        "NewMergedCrossCFIterator.");
+  }
+
+  // The DBIter on top of the merged tree is built with the first column
+  // family's comparator and merge operator, so every listed column family
+  // must agree on both.
+  auto* cfd0 =
+      static_cast_with_check<ColumnFamilyHandleImpl>(column_families[0])
+          ->cfd();
+  const Comparator* ucmp = cfd0->user_comparator();
+  const MergeOperator* merge_op = cfd0->ioptions()->merge_operator.get();
+  for (auto* cfh : column_families) {
+    assert(cfh);
+    const Status s = FailIfCfHasTs(cfh);
+    if (!s.ok()) {
+      return s;
+    }
+    auto* cfd = static_cast_with_check<ColumnFamilyHandleImpl>(cfh)->cfd();
+    if (strcmp(cfd->user_comparator()->Name(), ucmp->Name()) != 0) {
+      return Status::InvalidArgument(
+          "All column families must share one comparator");
+    }
+    const MergeOperator* cf_merge_op = cfd->ioptions()->merge_operator.get();
+    if ((merge_op == nullptr) != (cf_merge_op == nullptr) ||
+        (merge_op != nullptr &&
+         strcmp(merge_op->Name(), cf_merge_op->Name()) != 0)) {
+      return Status::InvalidArgument(
+          "All column families must share one merge operator");
+    }
+  }
+
+  // Reference every super version before picking the sequence number, for
+  // the same reason as in NewIteratorImpl: a flush in between could compact
+  // away data visible to the chosen sequence.
+  autovector<ColumnFamilyData*> cfds;
+  autovector<SuperVersion*> super_versions;
+  for (auto* cfh : column_families) {
+    auto* cfd = static_cast_with_check<ColumnFamilyHandleImpl>(cfh)->cfd();
+    cfds.push_back(cfd);
+    super_versions.push_back(cfd->GetReferencedSuperVersion(this));
+  }
+  for (size_t i = 0; i < cfds.size(); ++i) {
+    if (super_versions[i]->mutable_cf_options.enable_blob_files) {
+      for (auto* sv : super_versions) {
+        CleanupSuperVersion(sv);
+      }
+      return Status::NotSupported(
+          "BlobDB is not supported by NewMergedCrossCFIterator.");
+    }
+  }
+
+  const SequenceNumber snapshot =
+      read_options.snapshot != nullptr
+          ? read_options.snapshot->GetSequenceNumber()
+          : versions_->LastSequence();
+
+  // Refresh is disabled (no db_impl/cfd passed) because it would rebuild
+  // only the first column family's state.
+  SuperVersion* sv0 = super_versions[0];
+  ArenaWrappedDBIter* db_iter = NewArenaWrappedDbIterator(
+      env_, read_options, *cfd0->ioptions(), sv0->mutable_cf_options,
+      sv0->current, snapshot,
+      sv0->mutable_cf_options.max_sequential_skip_in_iterations,
+      sv0->version_number, /*read_callback=*/nullptr);
+
+  // All child trees live in the shared arena; each child registers cleanup
+  // of its own super version reference and is destroyed in place when the
+  // merging iterator above it is.
+  Arena* arena = db_iter->GetArena();
+  std::vector<InternalIterator*> children;
+  children.reserve(cfds.size());
+  for (size_t i = 0; i < cfds.size(); ++i) {
+    children.push_back(NewInternalIterator(
+        db_iter->GetReadOptions(), cfds[i], super_versions[i], arena, snapshot,
+        /* allow_unprepared_value */ true));
+  }
+  InternalIterator* merged_iter =
+      NewMergingIterator(&cfd0->internal_comparator(), children.data(),
+                         static_cast<int>(children.size()), arena);
+  db_iter->SetIterUnderDBIter(merged_iter);
+  *iterator = db_iter;
+  return Status::OK();
+}
+
 const Snapshot* DBImpl::GetSnapshot() { return GetSnapshotImpl(false); }
 
 const Snapshot* DBImpl::GetSnapshotForWriteConflictBoundary() {
@@ -4073,6 +4784,86 @@ bool DBImpl::GetMapProperty(ColumnFamilyHandle* column_family,
   return false;
 }
 
+Status DBImpl::GetPropertiesSnapshot(
+    ColumnFamilyHandle* column_family, const std::vector<Slice>& properties,
+    std::map<std::string, std::string>* values) {
+  assert(values != nullptr);
+  values->clear();
+  auto cfd =
+      static_cast_with_check<ColumnFamilyHandleImpl>(column_family)->cfd();
+
+  Status result;
+  auto mark_failed = [&result](const Slice& property) {
+    if (result.ok()) {
+      result = Status::NotFound("Unknown or unsupported property: " +
+                                property.ToString());
+    }
+  };
+
+  // Resolve all property infos up front so the DB mutex is acquired at most
+  // once for the whole batch, and only for the properties that need it.
+  struct Request {
+    const Slice* name;
+    const DBPropertyInfo* info;
+  };
+  std::vector<Request> in_mutex;
+  std::vector<Request> out_of_mutex;
+  for (const Slice& property : properties) {
+    const DBPropertyInfo* info = GetPropertyInfo(property);
+    if (info == nullptr) {
+      mark_failed(property);
+    } else if (info->need_out_of_mutex) {
+      out_of_mutex.push_back({&property, info});
+    } else {
+      in_mutex.push_back({&property, info});
+    }
+  }
+
+  // Mirrors the per-property dispatch in GetProperty(); locking is handled
+  // by the loops below, so `locked` tells the int-property path whether the
+  // DB mutex is already held.
+  auto evaluate = [&](const Request& req, bool locked, std::string* value) {
+    const DBPropertyInfo& info = *req.info;
+    if (info.handle_int != nullptr) {
+      uint64_t int_value = 0;
+      bool ok = locked ? cfd->internal_stats()->GetIntProperty(info, &int_value,
+                                                              this)
+                       : GetIntPropertyInternal(cfd, info, false /* is_locked */,
+                                                &int_value);
+      if (ok) {
+        *value = std::to_string(int_value);
+      }
+      return ok;
+    } else if (info.handle_string != nullptr) {
+      return cfd->internal_stats()->GetStringProperty(info, *req.name, value);
+    } else if (info.handle_string_dbimpl != nullptr) {
+      return (this->*(info.handle_string_dbimpl))(value);
+    }
+    return false;
+  };
+
+  if (!in_mutex.empty()) {
+    InstrumentedMutexLock l(&mutex_);
+    for (const Request& req : in_mutex) {
+      std::string value;
+      if (evaluate(req, true /* locked */, &value)) {
+        values->emplace(req.name->ToString(), std::move(value));
+      } else {
+        mark_failed(*req.name);
+      }
+    }
+  }
+  for (const Request& req : out_of_mutex) {
+    std::string value;
+    if (evaluate(req, false /* locked */, &value)) {
+      values->emplace(req.name->ToString(), std::move(value));
+    } else {
+      mark_failed(*req.name);
+    }
+  }
+  return result;
+}
+
 bool DBImpl::GetIntProperty(ColumnFamilyHandle* column_family,
                             const Slice& property, uint64_t* value) {
   const DBPropertyInfo* property_info = GetPropertyInfo(property);
@@ -4272,6 +5063,30 @@ void DBImpl::GetApproximateMemTableStats(ColumnFamilyHandle* column_family,
   ReturnAndCleanupSuperVersion(cfd, sv);
 }
 
+Status DBImpl::EstimateKeysInRange(ColumnFamilyHandle* column_family,
+                                   const Range& range, uint64_t* count) {
+  uint64_t bytes = 0;
+  auto cfd =
+      static_cast_with_check<ColumnFamilyHandleImpl>(column_family)->cfd();
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  sv->current->storage_info()->EstimateRangeStats(range.start, range.limit,
+                                                  count, &bytes);
+  ReturnAndCleanupSuperVersion(cfd, sv);
+  return Status::OK();
+}
+
+Status DBImpl::EstimateBytesInRange(ColumnFamilyHandle* column_family,
+                                    const Range& range, uint64_t* bytes) {
+  uint64_t count = 0;
+  auto cfd =
+      static_cast_with_check<ColumnFamilyHandleImpl>(column_family)->cfd();
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  sv->current->storage_info()->EstimateRangeStats(range.start, range.limit,
+                                                  &count, bytes);
+  ReturnAndCleanupSuperVersion(cfd, sv);
+  return Status::OK();
+}
+
 Status DBImpl::GetApproximateSizes(const SizeApproximationOptions& options,
                                    ColumnFamilyHandle* column_family,
                                    const Range* range, int n, uint64_t* sizes) {
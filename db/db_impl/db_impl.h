@@ -22,6 +22,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <functional>
@@ -359,6 +360,12 @@ class DBImpl : public DB {
       const std::vector<ColumnFamilyHandle*>& column_families,
       std::vector<Iterator*>* iterators) override;
 
+  using DB::NewMergedCrossCFIterator;
+  virtual Status NewMergedCrossCFIterator(
+      const ReadOptions& options,
+      const std::vector<ColumnFamilyHandle*>& column_families,
+      Iterator** iterator) override;
+
   virtual const Snapshot* GetSnapshot() override;
   // Will unref a snapshot copy
   // Returns true if the snapshot has not been deleted from SnapshotList
@@ -386,6 +393,11 @@ class DBImpl : public DB {
   virtual bool GetMapProperty(
       ColumnFamilyHandle* column_family, const Slice& property,
       std::map<std::string, std::string>* value) override;
+  using DB::GetPropertiesSnapshot;
+  virtual Status GetPropertiesSnapshot(
+      ColumnFamilyHandle* column_family, const std::vector<Slice>& properties,
+      std::map<std::string, std::string>* values) override;
+  virtual Status GetTuningReport(std::string* report) override;
   using DB::GetIntProperty;
   virtual bool GetIntProperty(ColumnFamilyHandle* column_family,
                               const Slice& property, uint64_t* value) override;
@@ -402,6 +414,14 @@ class DBImpl : public DB {
                                            const Range& range,
                                            uint64_t* const count,
                                            uint64_t* const size) override;
+  using DB::EstimateKeysInRange;
+  virtual Status EstimateKeysInRange(ColumnFamilyHandle* column_family,
+                                     const Range& range,
+                                     uint64_t* count) override;
+  using DB::EstimateBytesInRange;
+  virtual Status EstimateBytesInRange(ColumnFamilyHandle* column_family,
+                                      const Range& range,
+                                      uint64_t* bytes) override;
   using DB::CompactRange;
   virtual Status CompactRange(const CompactRangeOptions& options,
                               ColumnFamilyHandle* column_family,
@@ -500,6 +520,9 @@ class DBImpl : public DB {
       uint64_t start_time, uint64_t end_time,
       std::unique_ptr<StatsHistoryIterator>* stats_iterator) override;
 
+  Status GetWriteStallTimeline(
+      std::vector<WriteStallTimelineEvent>* events) override;
+
   using DB::ResetStats;
   virtual Status ResetStats() override;
   // All the returned filenames start with "/"
@@ -545,6 +568,9 @@ class DBImpl : public DB {
   Status PromoteL0(ColumnFamilyHandle* column_family,
                    int target_level) override;
 
+  Status SplitSstFile(ColumnFamilyHandle* column_family, uint64_t file_number,
+                      const Slice& split_user_key) override;
+
   using DB::IngestExternalFile;
   virtual Status IngestExternalFile(
       ColumnFamilyHandle* column_family,
@@ -668,6 +694,12 @@ class DBImpl : public DB {
                                       bool expose_blob_index = false,
                                       bool allow_refresh = true);
 
+  // Offer `iter` back to the column family's iterator pool slot, or delete
+  // it if the slot is taken or the iterator is not reusable. Called by
+  // RecyclableDBIter on destruction; takes ownership of `iter`.
+  // REQUIRES: DBOptions::recycle_iterators is set.
+  void RecycleIterator(uint32_t cf_id, ArenaWrappedDBIter* iter);
+
   virtual SequenceNumber GetLastPublishedSequence() const {
     if (last_seq_same_as_publish_seq_) {
       return versions_->LastSequence();
@@ -850,6 +882,13 @@ class DBImpl : public DB {
   // Schedule a background job to actually delete obsolete files.
   void SchedulePurge();
 
+  // Schedule a background job that keeps the pool of preallocated WAL files
+  // topped up to recycle_log_file_num entries, so that switching memtables
+  // does not block on file creation or extent allocation when the recycle
+  // list is empty. No-op if the pool is already full or a job is scheduled.
+  // REQUIRES: mutex_ held
+  void MaybeScheduleWALPrealloc();
+
   const SnapshotList& snapshots() const { return snapshots_; }
 
   // load list of snapshots to `snap_vector` that is no newer than `max_seq`
@@ -1224,6 +1263,14 @@ class DBImpl : public DB {
   // dump rocksdb.stats to LOG
   void DumpStats();
 
+  // Runs the tuning advisor from the periodic statistics task; logs reports
+  // with suggestions and forwards them to EventListener::OnTuningReport.
+  void MaybeReportTuningAdvice();
+
+  // Shared implementation of GetTuningReport(). *has_suggestions is set to
+  // true when at least one rule fired.
+  Status GetTuningReportImpl(std::string* report, bool* has_suggestions);
+
   // flush LOG out of application buffer
   void FlushInfoLog();
 
@@ -1300,8 +1347,17 @@ class DBImpl : public DB {
   }
   Status SpdbWrite(const WriteOptions& write_options, WriteBatch* my_batch,
                    bool disable_memtable);
+  // Applies a large multi column family batch to the memtables with one
+  // inserter per column family, fanned out to the high-pri thread pool.
+  Status SpdbInsertIntoMemtablesParallel(
+      WriteBatch* batch, const WriteOptions& write_options,
+      const std::vector<uint32_t>& column_families);
+  // When `precompressed_entry` is non-null it holds the batch contents
+  // already compressed off the WAL turn (see log::Writer::CompressRecord())
+  // and is appended without re-compressing.
   IOStatus SpdbWriteToWAL(WriteBatch* merged_batch, size_t write_with_wal,
                           const WriteBatch* to_be_cached_state, bool do_flush,
+                          const std::string* precompressed_entry,
                           uint64_t* offset, uint64_t* size);
   IOStatus SpdbSyncWAL(uint64_t offset, uint64_t size);
 
@@ -1333,6 +1389,21 @@ class DBImpl : public DB {
   InstrumentedMutex trace_mutex_;
   BlockCacheTracer block_cache_tracer_;
 
+  // Counter snapshot taken by the previous tuning-advisor sample, used by
+  // GetTuningReport() to compute per-window deltas. Guarded by
+  // tuning_advisor_mutex_.
+  struct TuningAdvisorSample {
+    // Aggregated write-stall event counts per column family ID:
+    // [0]=memtable limit, [1]=L0 file count limit, [2]=pending compaction
+    // bytes limit.
+    std::map<uint32_t, std::array<uint64_t, 3>> cf_stall_counts;
+    // Ticker values; see GetTuningReport() for the sampled set.
+    std::array<uint64_t, 6> tickers = {};
+    bool valid = false;
+  };
+  TuningAdvisorSample tuning_advisor_last_;
+  std::mutex tuning_advisor_mutex_;
+
   // constant false canceled flag, used when the compaction is not manual
   const std::atomic<bool> kManualCompactionCanceledFalse_{false};
 
@@ -2135,12 +2206,18 @@ class DBImpl : public DB {
   static void BGWorkBottomCompaction(void* arg);
   static void BGWorkFlush(void* arg);
   static void BGWorkPurge(void* arg);
+  static void BGWorkPreallocWAL(void* arg);
   static void UnscheduleCompactionCallback(void* arg);
   static void UnscheduleFlushCallback(void* arg);
   void BackgroundCallCompaction(PrepickedCompaction* prepicked_compaction,
                                 Env::Priority thread_pri);
   void BackgroundCallFlush(Env::Priority thread_pri);
   void BackgroundCallPurge();
+  void BackgroundCallPreallocWAL();
+  // Pop a preallocated WAL file off the pool; returns false when the pool is
+  // empty. The file is pre-created and pre-sized; CreateWAL renames it into
+  // place the same way it adopts a recycled log.
+  bool TakePreallocatedWAL(std::string* fname);
   Status BackgroundCompaction(bool* madeProgress, JobContext* job_context,
                               LogBuffer* log_buffer,
                               PrepickedCompaction* prepicked_compaction,
@@ -2215,6 +2292,25 @@ class DBImpl : public DB {
 
   Status MaybeReleaseTimestampedSnapshotsAndCheck();
 
+  // Iterator pool used when DBOptions::recycle_iterators is set. Each column
+  // family keeps a small table of recently released eligible iterators,
+  // matched to new requests by their baked-in ReadOptions (bounds included).
+  // An iterator created with `read_options` may go through the pool only if
+  // this returns true (snapshots, timestamps and table_filter cannot be
+  // rebound with ArenaWrappedDBIter::Refresh() or compared for reuse).
+  static bool IsIteratorPoolEligible(const ReadOptions& read_options);
+  // Whether a pooled iterator built with `pooled` ReadOptions can serve a
+  // NewIterator() call made with `requested`.
+  bool PooledIterReadOptionsCompatible(const ReadOptions& pooled,
+                                       const ReadOptions& requested) const;
+  // Returns a recycled iterator for `cfd` refreshed to the current
+  // super-version, or nullptr if the pool cannot serve `read_options`.
+  ArenaWrappedDBIter* GetRecycledIterator(const ReadOptions& read_options,
+                                          ColumnFamilyData* cfd);
+  // Delete the pooled iterators of one column family / of all of them.
+  void PurgeRecycledIterators(uint32_t cf_id);
+  void PurgeAllRecycledIterators();
+
   Status CloseHelper();
 
   void WaitForBackgroundWork();
@@ -2639,6 +2735,29 @@ class DBImpl : public DB {
   // number of background obsolete file purge jobs, submitted to the HIGH pool
   int bg_purge_scheduled_;
 
+  // number of background WAL preallocation jobs, submitted to the HIGH pool.
+  // Guarded by mutex_
+  int bg_prealloc_wal_scheduled_;
+
+  // A pre-created, pre-sized WAL file waiting to be renamed into place. The
+  // slot index keeps the pool's on-disk footprint to a fixed set of names
+  // (overwritten across DB instances), so a crash leaves at most
+  // recycle_log_file_num stray files behind.
+  struct PreallocatedWAL {
+    size_t slot;
+    std::string fname;
+  };
+
+  // Guards prealloc_wal_pool_ and prealloc_wal_slot_filled_. Never acquired
+  // while holding log_write_mutex_; may be acquired while holding mutex_
+  InstrumentedMutex prealloc_wal_mutex_;
+  std::deque<PreallocatedWAL> prealloc_wal_pool_;
+  std::vector<bool> prealloc_wal_slot_filled_;
+
+  // Extent size to fallocate in pool files; refreshed by CreateWAL from the
+  // preallocation block size the last WAL switch used
+  std::atomic<uint64_t> wal_prealloc_block_size_{0};
+
   std::deque<ManualCompactionState*> manual_compaction_dequeue_;
 
   // shall we disable deletion of obsolete files
@@ -2668,6 +2787,18 @@ class DBImpl : public DB {
   // Number of threads intending to write to memtable
   std::atomic<size_t> pending_memtable_writes_ = {};
 
+  // Iterator pool (cf id -> recycled iterators), used only when
+  // DBOptions::recycle_iterators is set. Protected by iter_pool_mutex_.
+  // Each column family keeps up to kIterPoolEntriesPerCF released iterators,
+  // so that interleaved scans with different bounds (e.g. several paginated
+  // range scans in flight) each find their own match instead of evicting one
+  // another. A pooled iterator keeps its super-version referenced until it
+  // is reused or purged; purging happens when its column family is dropped
+  // and on CloseHelper().
+  static constexpr size_t kIterPoolEntriesPerCF = 4;
+  std::mutex iter_pool_mutex_;
+  std::unordered_map<uint32_t, autovector<ArenaWrappedDBIter*>> iter_pool_;
+
   // A flag indicating whether the current rocksdb database has any
   // data that is not yet persisted into either WAL or SST file.
   // Used when disableWAL is true.
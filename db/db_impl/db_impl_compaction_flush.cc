@@ -186,10 +186,13 @@ Status DBImpl::FlushMemTableToOutputFile(
   // all the log files except the most recent one are synced. Otherwise if
   // the host crashes after flushing and before WAL is persistent, the
   // flushed SST may contain data from write batches whose updates to
-  // other (unflushed) column families are missing.
+  // other (unflushed) column families are missing. WAL-free column families
+  // are exempt: their memtable contents come from writes that skipped the
+  // WAL, so there is no cross-CF WAL dependency to preserve.
   const bool needs_to_sync_closed_wals =
       logfile_number_ > 0 &&
-      versions_->GetColumnFamilySet()->NumberOfColumnFamilies() > 1;
+      versions_->GetColumnFamilySet()->NumberOfColumnFamilies() > 1 &&
+      !cfd->ioptions()->wal_free;
 
   // If needs_to_sync_closed_wals is true, we need to record the current
   // maximum memtable ID of this column family so that a later PickMemtables()
@@ -504,7 +507,18 @@ Status DBImpl::AtomicFlushMemTablesToOutputFiles(
                        job_context->job_id, flush_reason);
   }
 
-  if (logfile_number_ > 0) {
+  // WAL-free column families have no data in the WALs, so if all the column
+  // families in this atomic flush are WAL-free there is no cross-CF WAL
+  // dependency to preserve and the sync can be skipped.
+  bool sync_closed_wals = false;
+  for (int i = 0; i != num_cfs; ++i) {
+    if (!cfds[i]->ioptions()->wal_free) {
+      sync_closed_wals = true;
+      break;
+    }
+  }
+
+  if (logfile_number_ > 0 && sync_closed_wals) {
     // TODO (yanqin) investigate whether we should sync the closed logs for
     // single column family case.
     VersionEdit synced_wals;
@@ -2008,6 +2022,40 @@ Status DBImpl::RunManualCompaction(
   // others will wait on a condition variable until it completes.
 
   AddManualCompaction(&manual);
+
+  // Estimate the total input of this manual compaction stage for the
+  // compact-range-progress property: the size of the files currently
+  // overlapping the requested range in the levels this stage touches.
+  // Compacted bytes are added back as the scheduled compactions complete.
+  {
+    int first_level = 0;
+    int last_level = cfd->NumberLevels() - 1;
+    if (input_level >= 0 && output_level >= 0) {
+      first_level = std::min(input_level, output_level);
+      last_level = std::max(input_level, output_level);
+    }
+    uint64_t total_bytes = 0;
+    const Comparator* ucmp = cfd->user_comparator();
+    const VersionStorageInfo* vstorage = cfd->current()->storage_info();
+    for (int level = first_level;
+         level <= last_level && level < vstorage->num_non_empty_levels();
+         level++) {
+      for (const FileMetaData* f : vstorage->LevelFiles(level)) {
+        if (manual.begin != nullptr &&
+            ucmp->Compare(f->largest.user_key(), manual.begin->user_key()) <
+                0) {
+          continue;
+        }
+        if (manual.end != nullptr &&
+            ucmp->Compare(f->smallest.user_key(), manual.end->user_key()) >
+                0) {
+          continue;
+        }
+        total_bytes += f->fd.GetFileSize();
+      }
+    }
+    cfd->internal_stats()->StartCompactRangeProgress(total_bytes);
+  }
   TEST_SYNC_POINT_CALLBACK("DBImpl::RunManualCompaction:NotScheduled", &mutex_);
   if (exclusive) {
     // Limitation: there's no way to wake up the below loop when user sets
@@ -2132,6 +2180,7 @@ Status DBImpl::RunManualCompaction(
   log_buffer.FlushBufferToLog();
   assert(!manual.in_progress);
   assert(HasPendingManualCompaction());
+  cfd->internal_stats()->FinishCompactRangeProgress();
   RemoveManualCompaction(&manual);
   // if the manual job is unscheduled, try schedule other jobs in case there's
   // any unscheduled compaction job which was blocked by exclusive manual
@@ -3719,6 +3768,11 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
       }
     }
   }
+  if (is_manual && c != nullptr && status.ok()) {
+    // Feed the compact-range-progress property
+    c->column_family_data()->internal_stats()->AddCompactRangeProgress(
+        c->CalculateTotalInputSize());
+  }
   // this will unref its input_version and column_family_data
   c.reset();
 
@@ -4116,11 +4170,18 @@ bool DBImpl::InitiateMemoryManagerFlushRequestNonAtomicFlush(
     size_t min_size_to_flush, const FlushOptions& flush_options) {
   assert(immutable_db_options_.atomic_flush == false);
 
-  // Pick the "oldest" CF that meets one of the following:
+  // Pick the CF that frees the most memory per unit of L0 read-amplification
+  // its flush generates, among the CFs that meet one of the following:
   // 1. Has at least one IMMUTABLE memtable (=> already has a memtable that
   //     should be flushed); Or
   // 2. Has a MUTABLE memtable > min size to flush
   //
+  // A flush adds one file to the CF's L0, so the benefit of flushing a CF is
+  // its unflushed bytes, and the cost grows with the number of L0 files the
+  // CF already has (deeper L0 => more compaction debt per added file).
+  // Scoring by unflushed-bytes / (1 + L0-files) avoids repeatedly flushing a
+  // small hot CF into tiny files while a colder CF holds far more memory.
+  //
   // However, care must be taken to avoid starving a CF which has data to flush
   // (=> and associated WAL) but, to which there is not much writing. So, in
   // case we find such a CF that is lagging enough in the number of flushes it
@@ -4131,13 +4192,13 @@ bool DBImpl::InitiateMemoryManagerFlushRequestNonAtomicFlush(
   ColumnFamilyData* orig_cfd_to_flush = nullptr;
   // The cf to actually flush (possibly == orig_cfd_to_flush)
   ColumnFamilyData* cfd_to_flush = nullptr;
-  SequenceNumber seq_num_for_cf_picked = kMaxSequenceNumber;
+  double score_for_cf_picked = 0.0;
 
   {
     InstrumentedMutexLock lock(&mutex_);
 
-    // First pick the oldest CF with data to flush that meets
-    // the min_size_to_flush condition
+    // First pick the CF with the best freed-memory / added-read-amp score
+    // among those meeting the min_size_to_flush condition
     for (auto* cfd : *versions_->GetColumnFamilySet()) {
       if (cfd->IsDropped()) {
         continue;
@@ -4145,10 +4206,18 @@ bool DBImpl::InitiateMemoryManagerFlushRequestNonAtomicFlush(
       if ((cfd->imm()->NumNotFlushed() != 0) ||
           ((cfd->mem()->IsEmpty() == false) &&
            (cfd->mem()->ApproximateMemoryUsage() >= min_size_to_flush))) {
-        uint64_t seq = cfd->mem()->GetCreationSeq();
-        if (cfd_to_flush == nullptr || seq < seq_num_for_cf_picked) {
+        size_t unflushed_bytes =
+            cfd->imm()->ApproximateUnflushedMemTablesMemoryUsage();
+        if (cfd->mem()->IsEmpty() == false) {
+          unflushed_bytes += cfd->mem()->ApproximateMemoryUsage();
+        }
+        const int num_l0_files =
+            cfd->current()->storage_info()->NumLevelFiles(0);
+        const double score =
+            static_cast<double>(unflushed_bytes) / (1 + num_l0_files);
+        if (cfd_to_flush == nullptr || score > score_for_cf_picked) {
           cfd_to_flush = cfd;
-          seq_num_for_cf_picked = seq;
+          score_for_cf_picked = score;
         }
       }
     }
@@ -4189,12 +4258,12 @@ bool DBImpl::InitiateMemoryManagerFlushRequestNonAtomicFlush(
   ROCKS_LOG_INFO(immutable_db_options_.info_log,
                  "[%s] write buffer manager initiated flush "
                  "started current "
-                 "usage %lu out of %lu, min-size:%lu, seq:%" PRIu64
+                 "usage %lu out of %lu, min-size:%lu, score:%.1f"
                  ", num-flushes:%" PRIu64 ", orig-cf:%s num-flushes:%" PRIu64,
                  cfd_to_flush->GetName().c_str(),
                  cfd_to_flush->write_buffer_mgr()->memory_usage(),
                  cfd_to_flush->write_buffer_mgr()->buffer_size(),
-                 min_size_to_flush, seq_num_for_cf_picked,
+                 min_size_to_flush, score_for_cf_picked,
                  cfd_to_flush->GetNumQueuedForFlush(),
                  orig_cfd_to_flush->GetName().c_str(),
                  orig_cfd_to_flush->GetNumQueuedForFlush());
@@ -8,14 +8,17 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #include <cinttypes>
+#include <memory>
 #include <vector>
 
 #include "db/column_family.h"
 #include "db/db_impl/db_impl.h"
 #include "db/job_context.h"
 #include "db/version_set.h"
+#include "file/filename.h"
 #include "logging/logging.h"
 #include "rocksdb/status.h"
+#include "table/internal_iterator.h"
 #include "util/cast_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -154,4 +157,209 @@ Status DBImpl::PromoteL0(ColumnFamilyHandle* column_family, int target_level) {
   return status;
 }
 
+Status DBImpl::SplitSstFile(ColumnFamilyHandle* column_family,
+                            uint64_t file_number, const Slice& split_user_key) {
+  assert(column_family);
+  auto* cfh = static_cast_with_check<ColumnFamilyHandleImpl>(column_family);
+  auto* cfd = cfh->cfd();
+  const InternalKeyComparator* icmp = &cfd->internal_comparator();
+  const Comparator* ucmp = icmp->user_comparator();
+
+  Status status;
+  JobContext job_context(next_job_id_.fetch_add(1), true);
+
+  Version* version = nullptr;
+  FileMetaData* f = nullptr;
+  int file_level = -1;
+  uint64_t left_number = 0;
+  uint64_t right_number = 0;
+  {
+    InstrumentedMutexLock l(&mutex_);
+    version = cfd->current();
+    const auto* vstorage = version->storage_info();
+    // L0 is excluded: its files are ordered by epoch number, and the two
+    // halves of a split would share one.
+    for (int level = 1;
+         level < vstorage->num_non_empty_levels() && f == nullptr; ++level) {
+      for (FileMetaData* file : vstorage->LevelFiles(level)) {
+        if (file->fd.GetNumber() == file_number) {
+          f = file;
+          file_level = level;
+          break;
+        }
+      }
+    }
+    if (f == nullptr) {
+      job_context.Clean();
+      return Status::InvalidArgument(
+          "File not found in levels 1 and up of the current version");
+    }
+    if (f->being_compacted) {
+      job_context.Clean();
+      return Status::Busy("File is being compacted");
+    }
+    if (ucmp->Compare(split_user_key, f->smallest.user_key()) <= 0 ||
+        ucmp->Compare(split_user_key, f->largest.user_key()) > 0) {
+      job_context.Clean();
+      return Status::InvalidArgument(
+          "Split key must be strictly inside the file's key range");
+    }
+    // Keep `f` (owned by this version) alive while the mutex is released
+    // below for the boundary read and the link creation.
+    version->Ref();
+    left_number = versions_->NewFileNumber();
+    right_number = versions_->NewFileNumber();
+  }
+
+  // Find the entries adjacent to the split point: the last point entry below
+  // split_user_key becomes part of the left half, the first one at or above
+  // it starts the right half. This reads two blocks of the file but rewrites
+  // nothing.
+  InternalKey left_largest;
+  InternalKey right_smallest;
+  {
+    ReadOptions ro;
+    ro.total_order_seek = true;
+    ro.fill_cache = false;
+    std::unique_ptr<InternalIterator> iter(cfd->table_cache()->NewIterator(
+        ro, file_options_, *icmp, *f, /*range_del_agg=*/nullptr,
+        /*prefix_extractor=*/nullptr, /*table_reader_ptr=*/nullptr,
+        /*file_read_hist=*/nullptr, TableReaderCaller::kUncategorized,
+        /*arena=*/nullptr, /*skip_filters=*/true, file_level,
+        /*max_file_size_for_l0_meta_pin=*/0,
+        /*smallest_compaction_key=*/nullptr,
+        /*largest_compaction_key=*/nullptr,
+        /*allow_unprepared_value=*/false, /*range_del_iter=*/nullptr));
+    InternalKey split_target;
+    split_target.SetMinPossibleForUserKey(split_user_key);
+    iter->Seek(split_target.Encode());
+    if (iter->Valid()) {
+      right_smallest.DecodeFrom(iter->key());
+    } else {
+      status = !iter->status().ok()
+                   ? iter->status()
+                   : Status::NotSupported(
+                         "No point entry at or above the split key");
+    }
+    if (status.ok()) {
+      iter->SeekForPrev(split_target.Encode());
+      if (iter->Valid()) {
+        left_largest.DecodeFrom(iter->key());
+      } else {
+        status = !iter->status().ok()
+                     ? iter->status()
+                     : Status::NotSupported(
+                           "No point entry below the split key");
+      }
+    }
+  }
+
+  // The left half ends at a range-deletion boundary sentinel just before the
+  // right half's first user key, the same way compaction outputs are cut
+  // inside a range tombstone: the halves stay adjacent (range tombstones
+  // spanning the split point keep covering the keys between the two boundary
+  // entries) without overlapping.
+  InternalKey left_largest_sentinel(right_smallest.user_key(),
+                                    kMaxSequenceNumber, kTypeRangeDeletion);
+
+  // Give each half its own file number and hard-link both names to the
+  // original file, so the halves can be compacted and deleted independently;
+  // the filesystem frees the inode when the last link goes.
+  const auto& cf_paths = cfd->ioptions()->cf_paths;
+  const std::string orig_path =
+      TableFileName(cf_paths, file_number, f->fd.GetPathId());
+  const std::string left_path =
+      TableFileName(cf_paths, left_number, f->fd.GetPathId());
+  const std::string right_path =
+      TableFileName(cf_paths, right_number, f->fd.GetPathId());
+  bool links_created = false;
+  if (status.ok()) {
+    status = fs_->LinkFile(orig_path, left_path, IOOptions(), nullptr);
+    if (status.ok()) {
+      status = fs_->LinkFile(orig_path, right_path, IOOptions(), nullptr);
+      if (status.ok()) {
+        links_created = true;
+      } else {
+        fs_->DeleteFile(left_path, IOOptions(), nullptr)
+            .PermitUncheckedError();
+      }
+    }
+  }
+
+  {
+    InstrumentedMutexLock l(&mutex_);
+    if (status.ok()) {
+      // Re-validate under the mutex: the file must still be live in the
+      // current version and not picked for compaction meanwhile.
+      bool still_live = false;
+      const auto* vstorage = cfd->current()->storage_info();
+      if (file_level < vstorage->num_non_empty_levels()) {
+        for (FileMetaData* file : vstorage->LevelFiles(file_level)) {
+          if (file->fd.GetNumber() == file_number) {
+            still_live = !file->being_compacted;
+            break;
+          }
+        }
+      }
+      if (!still_live) {
+        status = Status::TryAgain("File changed while preparing the split");
+      }
+    }
+    if (status.ok()) {
+      VersionEdit edit;
+      edit.SetColumnFamily(cfd->GetID());
+      edit.DeleteFile(file_level, file_number);
+      // Seqno bounds and aggregate stats are inherited from the original
+      // file; the unique id is cleared because the physical contents are no
+      // longer exclusive to either number.
+      FileMetaData left(left_number, f->fd.GetPathId(), f->fd.GetFileSize(),
+                        f->smallest, left_largest_sentinel,
+                        f->fd.smallest_seqno, f->fd.largest_seqno,
+                        f->marked_for_compaction, f->temperature,
+                        f->oldest_blob_file_number, f->oldest_ancester_time,
+                        f->file_creation_time, f->epoch_number,
+                        f->file_checksum, f->file_checksum_func_name,
+                        kNullUniqueId64x2,
+                        f->compensated_range_deletion_size);
+      left.clipped = true;
+      FileMetaData right(right_number, f->fd.GetPathId(), f->fd.GetFileSize(),
+                         right_smallest, f->largest, f->fd.smallest_seqno,
+                         f->fd.largest_seqno, f->marked_for_compaction,
+                         f->temperature, f->oldest_blob_file_number,
+                         f->oldest_ancester_time, f->file_creation_time,
+                         f->epoch_number, f->file_checksum,
+                         f->file_checksum_func_name, kNullUniqueId64x2,
+                         f->compensated_range_deletion_size);
+      right.clipped = true;
+      edit.AddFile(file_level, left);
+      edit.AddFile(file_level, right);
+      status = versions_->LogAndApply(cfd, *cfd->GetLatestMutableCFOptions(),
+                                      &edit, &mutex_, directories_.GetDbDir());
+      if (status.ok()) {
+        InstallSuperVersionAndScheduleWork(
+            cfd, &job_context.superversion_contexts[0],
+            *cfd->GetLatestMutableCFOptions());
+      }
+    }
+    version->Unref();
+  }
+
+  if (!status.ok() && links_created) {
+    fs_->DeleteFile(left_path, IOOptions(), nullptr).PermitUncheckedError();
+    fs_->DeleteFile(right_path, IOOptions(), nullptr).PermitUncheckedError();
+  }
+
+  if (status.ok()) {
+    ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                   "[%s] Split file %" PRIu64 " at level %d into %" PRIu64
+                   " and %" PRIu64 " (metadata only)\n",
+                   cfd->GetName().c_str(), file_number, file_level,
+                   left_number, right_number);
+  }
+  LogFlush(immutable_db_options_.info_log);
+  job_context.Clean();
+
+  return status;
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -20,7 +20,11 @@
 // Copyright (c) 2011 The LevelDB Authors. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
+#include <atomic>
 #include <cinttypes>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
 #include "db/builder.h"
 #include "db/db_impl/db_impl.h"
@@ -1101,52 +1105,160 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     } else {
       reporter.status = &status;
     }
+    // The reader thread below reports read corruption into its own status so
+    // that a corrupted record does not stop this thread before the records
+    // read ahead of it have been applied, which preserves the serial replay
+    // semantics.
+    Status read_status;
+    LogReporter read_reporter = reporter;
+    if (reporter.status != nullptr) {
+      read_reporter.status = &read_status;
+    }
+
     // We intentially make log::Reader do checksumming even if
     // paranoid_checks==false so that corruptions cause entire commits
     // to be skipped instead of propagating bad information (like overly
     // large sequence numbers).
     log::Reader reader(immutable_db_options_.info_log, std::move(file_reader),
-                       &reporter, true /*checksum*/, wal_number);
-
-    // Determine if we should tolerate incomplete records at the tail end of the
-    // Read all the records and add to a memtable
-    std::string scratch;
-    Slice record;
+                       &read_reporter, true /*checksum*/, wal_number);
 
     TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
                              /*arg=*/nullptr);
-    uint64_t record_checksum;
-    while (!stop_replay_by_wal_filter &&
-           reader.ReadRecord(&record, &scratch,
-                             immutable_db_options_.wal_recovery_mode,
-                             &record_checksum) &&
-           status.ok()) {
-      if (record.size() < WriteBatchInternal::kHeader) {
-        reporter.Corruption(record.size(),
-                            Status::Corruption("log record too small"));
-        continue;
-      }
 
-      // We create a new batch and initialize with a valid prot_info_ to store
-      // the data checksums
+    // Replay is pipelined across two threads: reading the WAL, verifying
+    // record checksums and computing the per-key protection info are
+    // CPU-bound and independent of the memtable inserts, so a reader thread
+    // runs them ahead while this thread applies the batches in log order.
+    // Everything order-sensitive - the WAL filter, point-in-time recovery
+    // decisions, memtable inserts and mid-recovery flushes - stays on this
+    // thread.
+    struct PreparedBatch {
       WriteBatch batch;
+      size_t record_size = 0;
+      // When set, every column family the record touches (per its
+      // kColumnFamilyIdsType tag) is already flushed past this WAL; the
+      // batch contents were never parsed and only the sequence numbers
+      // below need to be accounted for.
+      bool skip_insertion = false;
+      SequenceNumber skipped_sequence = 0;
+      uint32_t skipped_count = 0;
+    };
+    const size_t kMaxPreparedBatches = 16;
+    std::deque<PreparedBatch> prepared_batches;
+    std::mutex pipeline_mu;
+    std::condition_variable pipeline_not_empty;
+    std::condition_variable pipeline_not_full;
+    bool produced_all = false;
+    std::atomic<bool> stop_reading{false};
+    // A failure to prepare a batch aborts the recovery regardless of
+    // wal_recovery_mode, unlike read corruption; keep it separate.
+    Status prepare_status;
+
+    // Returns true if every column family id in the record's tag (see
+    // DBOptions::wal_tag_column_family_ids) is either dropped or already
+    // flushed past this WAL, so the record cannot contain live data. Column
+    // family log numbers are stable while the WALs are replayed, so this is
+    // safe to evaluate on the reader thread. A malformed tag replays
+    // normally.
+    auto wal_record_fully_flushed = [&](const std::string& cf_ids_payload) {
+      Slice input(cf_ids_payload);
+      uint32_t cf_id = 0;
+      while (GetVarint32(&input, &cf_id)) {
+        ColumnFamilyData* tagged_cfd =
+            versions_->GetColumnFamilySet()->GetColumnFamily(cf_id);
+        if (tagged_cfd != nullptr && tagged_cfd->GetLogNumber() <= wal_number) {
+          return false;
+        }
+      }
+      return input.empty();
+    };
 
-      status = WriteBatchInternal::SetContents(&batch, record);
-      if (!status.ok()) {
-        return status;
+    port::Thread log_read_thread([&]() {
+      std::string scratch;
+      Slice record;
+      uint64_t record_checksum;
+      while (!stop_reading.load(std::memory_order_relaxed) &&
+             reader.ReadRecord(&record, &scratch,
+                               immutable_db_options_.wal_recovery_mode,
+                               &record_checksum) &&
+             read_status.ok()) {
+        if (record.size() < WriteBatchInternal::kHeader) {
+          read_reporter.Corruption(record.size(),
+                                   Status::Corruption("log record too small"));
+          continue;
+        }
+
+        // We create a new batch and initialize with a valid prot_info_ to
+        // store the data checksums
+        PreparedBatch prepared;
+        prepared.record_size = record.size();
+        Status s;
+        if (!seq_per_batch_ && !reader.GetRecordColumnFamilyIds().empty() &&
+            wal_record_fully_flushed(reader.GetRecordColumnFamilyIds())) {
+          // Nothing in this record survives; only its sequence numbers need
+          // accounting, which the batch header provides without parsing the
+          // contents. seq_per_batch sequence accounting is owned by the
+          // inserter, so the shortcut is limited to the common case.
+          prepared.skip_insertion = true;
+          prepared.skipped_sequence = DecodeFixed64(record.data());
+          prepared.skipped_count = DecodeFixed32(record.data() + 8);
+        } else {
+          s = WriteBatchInternal::SetContents(&prepared.batch, record);
+          if (s.ok()) {
+            TEST_SYNC_POINT_CALLBACK(
+                "DBImpl::RecoverLogFiles:BeforeUpdateProtectionInfo:batch",
+                &prepared.batch);
+            TEST_SYNC_POINT_CALLBACK(
+                "DBImpl::RecoverLogFiles:BeforeUpdateProtectionInfo:checksum",
+                &record_checksum);
+            s = WriteBatchInternal::UpdateProtectionInfo(
+                &prepared.batch, 8 /* bytes_per_key */, &record_checksum);
+          }
+        }
+
+        std::unique_lock<std::mutex> lock(pipeline_mu);
+        if (!s.ok()) {
+          prepare_status = s;
+          break;
+        }
+        pipeline_not_full.wait(lock, [&]() {
+          return prepared_batches.size() < kMaxPreparedBatches ||
+                 stop_reading.load(std::memory_order_relaxed);
+        });
+        if (stop_reading.load(std::memory_order_relaxed)) {
+          break;
+        }
+        prepared_batches.push_back(std::move(prepared));
+        pipeline_not_empty.notify_one();
       }
-      TEST_SYNC_POINT_CALLBACK(
-          "DBImpl::RecoverLogFiles:BeforeUpdateProtectionInfo:batch", &batch);
-      TEST_SYNC_POINT_CALLBACK(
-          "DBImpl::RecoverLogFiles:BeforeUpdateProtectionInfo:checksum",
-          &record_checksum);
-      status = WriteBatchInternal::UpdateProtectionInfo(
-          &batch, 8 /* bytes_per_key */, &record_checksum);
-      if (!status.ok()) {
-        return status;
+      std::lock_guard<std::mutex> lock(pipeline_mu);
+      produced_all = true;
+      pipeline_not_empty.notify_one();
+    });
+
+    // A fatal error below must return from this function, but only after the
+    // reader thread has been joined; stash it here.
+    Status fatal_status;
+
+    while (!stop_replay_by_wal_filter && status.ok()) {
+      PreparedBatch prepared;
+      {
+        std::unique_lock<std::mutex> lock(pipeline_mu);
+        pipeline_not_empty.wait(lock, [&]() {
+          return !prepared_batches.empty() || produced_all;
+        });
+        if (prepared_batches.empty()) {
+          break;
+        }
+        prepared = std::move(prepared_batches.front());
+        prepared_batches.pop_front();
+        pipeline_not_full.notify_one();
       }
+      WriteBatch& batch = prepared.batch;
 
-      SequenceNumber sequence = WriteBatchInternal::Sequence(&batch);
+      SequenceNumber sequence = prepared.skip_insertion
+                                    ? prepared.skipped_sequence
+                                    : WriteBatchInternal::Sequence(&batch);
 
       if (immutable_db_options_.wal_recovery_mode ==
           WALRecoveryMode::kPointInTimeRecovery) {
@@ -1163,6 +1275,14 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
         }
       }
 
+      if (prepared.skip_insertion) {
+        // All column families this record touches are flushed past the WAL;
+        // consume its sequence numbers and move on. This also bypasses the
+        // WAL filter, which only gets to see records that may be replayed.
+        *next_sequence = sequence + prepared.skipped_count;
+        continue;
+      }
+
       // For the default case of wal_filter == nullptr, always performs no-op
       // and returns true.
       if (!InvokeWalFilterIfNeededOnWalRecord(wal_number, fname, reporter,
@@ -1186,7 +1306,7 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
       if (!status.ok()) {
         // We are treating this as a failure while reading since we read valid
         // blocks that do not form coherent data
-        reporter.Corruption(record.size(), status);
+        reporter.Corruption(prepared.record_size, status);
         continue;
       }
 
@@ -1207,16 +1327,44 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
           if (!status.ok()) {
             // Reflect errors immediately so that conditions like full
             // file-systems cause the DB::Open() to fail.
-            return status;
+            fatal_status = status;
+            break;
           }
           flushed = true;
 
           cfd->CreateNewMemtable(*cfd->GetLatestMutableCFOptions(),
                                  *next_sequence);
         }
+        if (!fatal_status.ok()) {
+          break;
+        }
       }
     }
 
+    // Wind down the reader thread before inspecting any of the statuses it
+    // writes to. If this thread bailed out early (WAL filter, point-in-time
+    // corruption stop, fatal error) the reader may still be blocked on a full
+    // queue; wake it up.
+    stop_reading.store(true, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lock(pipeline_mu);
+      pipeline_not_full.notify_one();
+    }
+    log_read_thread.join();
+
+    if (!fatal_status.ok()) {
+      return fatal_status;
+    }
+    if (!prepare_status.ok()) {
+      return prepare_status;
+    }
+    if (status.ok()) {
+      // Surface read corruption exactly as the serial replay did: the records
+      // read before the corruption have all been applied by now, and the
+      // wal_recovery_mode handling below decides what to do with the error.
+      status = read_status;
+    }
+
     if (!status.ok()) {
       if (status.IsNotSupported()) {
         // We should not treat NotSupported as corruption. It is rather a clear
@@ -1753,6 +1901,10 @@ IOStatus DBImpl::CreateWAL(uint64_t log_file_num, uint64_t recycle_log_number,
   std::string wal_dir = immutable_db_options_.GetWalDir();
   std::string log_fname = LogFileName(wal_dir, log_file_num);
 
+  // Let the preallocation pool know what extent size future WALs want
+  wal_prealloc_block_size_.store(preallocate_block_size,
+                                 std::memory_order_relaxed);
+
   if (recycle_log_number) {
     ROCKS_LOG_INFO(immutable_db_options_.info_log,
                    "reusing log %" PRIu64 " from recycle list\n",
@@ -1763,7 +1915,26 @@ IOStatus DBImpl::CreateWAL(uint64_t log_file_num, uint64_t recycle_log_number,
     io_s = fs_->ReuseWritableFile(log_fname, old_log_fname, opt_file_options,
                                   &lfile, /*dbg=*/nullptr);
   } else {
-    io_s = NewWritableFile(fs_.get(), log_fname, &lfile, opt_file_options);
+    // With recycling enabled but no recyclable log available yet, adopt a
+    // pre-created, pre-sized file from the preallocation pool; renaming it
+    // into place is the same operation as reusing a recycled log, and its
+    // zero-filled content reads as end-of-log during recovery.
+    std::string pooled_wal;
+    if (TakePreallocatedWAL(&pooled_wal)) {
+      TEST_SYNC_POINT("DBImpl::CreateWAL:AdoptPreallocatedWAL");
+      io_s = fs_->ReuseWritableFile(log_fname, pooled_wal, opt_file_options,
+                                    &lfile, /*dbg=*/nullptr);
+      if (!io_s.ok()) {
+        // Pool file may have been lost underneath us; fall back to a plain
+        // creation rather than failing the memtable switch
+        ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                       "Failed to adopt preallocated WAL %s -- %s",
+                       pooled_wal.c_str(), io_s.ToString().c_str());
+        io_s = NewWritableFile(fs_.get(), log_fname, &lfile, opt_file_options);
+      }
+    } else {
+      io_s = NewWritableFile(fs_.get(), log_fname, &lfile, opt_file_options);
+    }
   }
 
   if (io_s.ok()) {
@@ -1991,6 +2162,7 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
     impl->DeleteObsoleteFiles();
     TEST_SYNC_POINT("DBImpl::Open:AfterDeleteFiles");
     impl->MaybeScheduleFlushOrCompaction();
+    impl->MaybeScheduleWALPrealloc();
   } else {
     persist_options_status.PermitUncheckedError();
   }
@@ -610,6 +610,15 @@ Status DBImplSecondary::CheckConsistency() {
                                      : Status::Corruption(corruption_messages);
 }
 
+// Catch-up is incremental, not a replay from scratch: manifest_reader_ is a
+// FragmentBufferedReader that keeps its position in the MANIFEST between
+// calls, so each cycle decodes only the VersionEdits the primary appended
+// since the last cycle (ReactiveVersionSet::ReadAndApply only switches files
+// when the primary rolls the MANIFEST). Table files newly referenced by
+// those edits are opened through VersionBuilder::LoadTableHandlers(), which
+// fans the opens out over up to max_file_opening_threads threads. WAL
+// tailing below is likewise incremental via the cached log readers in
+// log_readers_.
 Status DBImplSecondary::TryCatchUpWithPrimary() {
   assert(versions_.get() != nullptr);
   assert(manifest_reader_.get() != nullptr);
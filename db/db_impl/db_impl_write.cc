@@ -244,8 +244,17 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         "pipelined_writes is not compatible with concurrent prepares");
   }
   if (immutable_db_options_.allow_concurrent_memtable_write && spdb_write_) {
-    // TBD AYELET this is temporary. the handle of transaction in write flow
-    // needs careful assignment
+    // The Speedb write flow cannot report the assigned sequence or log
+    // number, nor run the write-path callbacks of the transaction layer.
+    // Such writes cannot fall back to the default write path either, since
+    // the two flows allocate sequence numbers independently.
+    if (callback != nullptr || pre_release_callback != nullptr ||
+        post_memtable_callback != nullptr || seq_used != nullptr ||
+        log_used != nullptr || log_ref != 0 || disable_memtable ||
+        batch_cnt != 0) {
+      return Status::NotSupported(
+          "Transactional writes are not supported with use_spdb_writes");
+    }
     return SpdbWrite(write_options, my_batch, disable_memtable);
   }
   assert(!seq_per_batch_ || batch_cnt != 0);
@@ -1339,6 +1348,19 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
     return status_to_io_status(std::move(s));
   }
   *log_size = log_entry.size();
+  // Collect the column families the batch touches so the record can be
+  // tagged for fast skipping at recovery. Batches carrying 2PC markers must
+  // always be replayed, so they are never tagged.
+  std::vector<uint32_t> wal_cf_ids;
+  if (immutable_db_options_.wal_tag_column_family_ids &&
+      !merged_batch.HasBeginPrepare() && !merged_batch.HasEndPrepare() &&
+      !merged_batch.HasCommit() && !merged_batch.HasRollback()) {
+    s = WriteBatchInternal::CollectColumnFamilies(&merged_batch, &wal_cf_ids);
+    if (!s.ok()) {
+      // Tagging is best effort; replay the record normally.
+      wal_cf_ids.clear();
+    }
+  }
   // When two_write_queues_ WriteToWAL has to be protected from concurretn calls
   // from the two queues anyway and log_write_mutex_ is already held. Otherwise
   // if manual_wal_flush_ is enabled we need to protect log_writer->AddRecord
@@ -1350,7 +1372,14 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   if (UNLIKELY(needs_locking)) {
     log_write_mutex_.Lock();
   }
-  IOStatus io_s = log_writer->AddRecord(log_entry, rate_limiter_priority);
+  IOStatus io_s;
+  if (!wal_cf_ids.empty()) {
+    io_s = log_writer->AddColumnFamilyIdsRecord(wal_cf_ids,
+                                                rate_limiter_priority);
+  }
+  if (io_s.ok()) {
+    io_s = log_writer->AddRecord(log_entry, rate_limiter_priority);
+  }
 
   if (UNLIKELY(needs_locking)) {
     log_write_mutex_.Unlock();
@@ -2319,6 +2348,11 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context) {
   cfd->SetMemtable(new_mem);
   InstallSuperVersionAndScheduleWork(cfd, &context->superversion_context,
                                      mutable_cf_options);
+  if (creating_new_log) {
+    // Top the preallocated-WAL pool back up so the next switch does not
+    // create its file synchronously either
+    MaybeScheduleWALPrealloc();
+  }
 
   // Notify client that memtable is sealed, now that we have successfully
   // installed a new memtable
@@ -27,6 +27,7 @@
 // limitations under the License.
 #include "db/db_impl/db_spdb_impl_write.h"
 
+#include "db/column_family.h"
 #include "db/db_impl/db_impl.h"
 #include "db/write_batch_internal.h"
 #include "logging/logging.h"
@@ -37,32 +38,107 @@
 #include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
-#define MAX_ELEMENTS_IN_BATCH_GROUP 16
-// add_buffer_mutex_ is held
+
+namespace {
+
+// A batch smaller than this applies faster on one core than the fan-out
+// costs, so the parallel memtable apply only kicks in above it.
+constexpr uint32_t kSpdbParallelApplyMinKeys = 4 * 1024;
+
+// Per column family work item of a parallel memtable apply. Every shard
+// walks the whole batch with its own inserter and applies only the entries
+// of its column family, so all shards assign identical sequence numbers.
+struct SpdbApplyShard {
+  DBImpl* db = nullptr;
+  WriteBatch* batch = nullptr;
+  const WriteOptions* write_options = nullptr;
+  ColumnFamilySet* cf_set = nullptr;
+  FlushScheduler* flush_scheduler = nullptr;
+  TrimHistoryScheduler* trim_history_scheduler = nullptr;
+  uint32_t cf_id = 0;
+  bool seq_per_batch = false;
+  bool batch_per_txn = true;
+  Status* result = nullptr;
+  size_t* pending = nullptr;
+  port::Mutex* mutex = nullptr;
+  port::CondVar* cv = nullptr;
+};
+
+void ApplyShardToMemtables(void* arg) {
+  auto* shard = static_cast<SpdbApplyShard*>(arg);
+  // Each shard needs its own ColumnFamilyMemTables since Seek() keeps state.
+  ColumnFamilyMemTablesImpl cf_mems(shard->cf_set);
+  Status s = WriteBatchInternal::InsertInto(
+      shard->batch, &cf_mems, shard->flush_scheduler,
+      shard->trim_history_scheduler,
+      shard->write_options->ignore_missing_column_families,
+      0 /*recovery_log_number*/, shard->db,
+      true /*concurrent_memtable_writes*/, nullptr /*next_seq*/,
+      nullptr /*has_valid_writes*/, shard->seq_per_batch, shard->batch_per_txn,
+      shard->cf_id);
+  MutexLock lck(shard->mutex);
+  if (!s.ok() && shard->result->ok()) {
+    *shard->result = s;
+  }
+  if (--*shard->pending == 0) {
+    shard->cv->SignalAll();
+  }
+}
+
+}  // namespace
+
+// Batch group sizing. A group asks to be switched out once it collects
+// switch_threshold_ batches; the threshold for newly opened groups is
+// auto-tuned between the bounds below, based on how fast groups fill
+// relative to how long their WAL write (and sync) takes. See
+// SpdbWriteImpl::TuneBatchGroupSize().
+constexpr uint32_t kInitElementsInBatchGroup = 16;
+constexpr uint32_t kMinElementsInBatchGroup = 4;
+constexpr uint32_t kMaxElementsInBatchGroup = 128;
+
+// may be called concurrently; adds only touch the caller's core-group shard
 bool WritesBatchList::Add(WriteBatch* batch, const WriteOptions& write_options,
                           bool* leader_batch) {
-  elements_num_++;
-  if (elements_num_ == MAX_ELEMENTS_IN_BATCH_GROUP) {
+  const uint32_t elements = elements_num_.fetch_add(1) + 1;
+  if (elements == switch_threshold_) {
     switch_wb_.store(true);
   }
   const size_t seq_inc = batch->Count();
-  max_seq_ = WriteBatchInternal::Sequence(batch) + seq_inc - 1;
+  const uint64_t batch_max_seq =
+      WriteBatchInternal::Sequence(batch) + seq_inc - 1;
+  uint64_t curr_max = max_seq_.load(std::memory_order_relaxed);
+  while (batch_max_seq > curr_max &&
+         !max_seq_.compare_exchange_weak(curr_max, batch_max_seq)) {
+  }
 
   if (!write_options.disableWAL) {
-    wal_writes_.push_back(batch);
-  }
-  if (write_options.sync && wal_writes_.size() != 0) {
-    need_sync_ = true;
+    const int core_id = port::PhysicalCoreID();
+    AddShard& shard =
+        add_shards_[(core_id < 0 ? 0 : core_id) % kAddShards];
+    MutexLock l(&shard.mutex_);
+    shard.wal_writes_.push_back(batch);
+    if (write_options.sync) {
+      need_sync_ = true;
+    }
   }
-  if (elements_num_ == 1) {
-    // first wal batch . should take the buffer_write_rw_lock_ as write
+  if (elements == 1) {
+    // first batch in the group leads the WAL write and the publish
     *leader_batch = true;
-    buffer_write_rw_lock_.WriteLock();
   }
   write_ref_rwlock_.ReadLock();
   return switch_wb_.load();
 }
 
+void WritesBatchList::MergeAddShards() {
+  for (auto& shard : add_shards_) {
+    // the group was already switched out, so no adder can race with us
+    wal_writes_.splice(wal_writes_.end(), shard.wal_writes_);
+  }
+  wal_writes_.sort([](const WriteBatch* a, const WriteBatch* b) {
+    return WriteBatchInternal::Sequence(a) < WriteBatchInternal::Sequence(b);
+  });
+}
+
 void WritesBatchList::WriteBatchComplete(bool leader_batch) {
   // Batch was added to the memtable, we can release the memtable_ref.
   write_ref_rwlock_.ReadUnlock();
@@ -72,12 +148,16 @@ void WritesBatchList::WriteBatchComplete(bool leader_batch) {
       // the version
       WriteLock wl(&write_ref_rwlock_);
     }
-    complete_batch_.store(true);
+    {
+      std::lock_guard<std::mutex> lck(complete_mutex_);
+      complete_batch_.store(true);
+    }
     // wal write has been completed wal waiters will be released
-    buffer_write_rw_lock_.WriteUnlock();
+    complete_cv_.notify_all();
   } else {
     // wait wal write completed
-    ReadLock rl(&buffer_write_rw_lock_);
+    std::unique_lock<std::mutex> lck(complete_mutex_);
+    complete_cv_.wait(lck, [this] { return complete_batch_.load(); });
   }
 }
 
@@ -121,14 +201,16 @@ void SpdbWriteImpl::SpdbFlushWriteThread() {
 SpdbWriteImpl::SpdbWriteImpl(DBImpl* db)
     : db_(db),
       flush_thread_terminate_(false),
-      flush_thread_(&SpdbWriteImpl::SpdbFlushWriteThread, this) {
+      flush_thread_(&SpdbWriteImpl::SpdbFlushWriteThread, this),
+      batch_group_switch_threshold_(kInitElementsInBatchGroup) {
 #if defined(_GNU_SOURCE) && defined(__GLIBC_PREREQ)
 #if __GLIBC_PREREQ(2, 12)
   auto thread_handle = flush_thread_.native_handle();
   pthread_setname_np(thread_handle, "speedb:wflush");
 #endif
 #endif
-  wb_lists_.push_back(std::make_shared<WritesBatchList>());
+  wb_lists_.push_back(
+      std::make_shared<WritesBatchList>(kInitElementsInBatchGroup));
 }
 
 SpdbWriteImpl::~SpdbWriteImpl() {
@@ -191,7 +273,9 @@ Status DBImpl::RegisterFlushOrTrim() {
 
 std::shared_ptr<WritesBatchList> SpdbWriteImpl::Add(
     WriteBatch* batch, const WriteOptions& write_options, bool* leader_batch) {
-  MutexLock l(&add_buffer_mutex_);
+  // shared lock: adds proceed in parallel, only a group switch or a merge
+  // write excludes them
+  ReadLock rl(&add_buffer_rwlock_);
   std::shared_ptr<WritesBatchList> current_wb = nullptr;
   {
     MutexLock wb_list_lock(&wb_list_mutex_);
@@ -201,17 +285,18 @@ std::shared_ptr<WritesBatchList> SpdbWriteImpl::Add(
       db_->FetchAddLastAllocatedSequence(batch->Count()) + 1;
   WriteBatchInternal::SetSequence(batch, sequence);
   current_wb->Add(batch, write_options, leader_batch);
-  /*if (need_switch_wb) {
-    //create new wb
-    wb_lists_.push_back(std::make_shared<WritesBatchList>());
-  }*/
+  if (*leader_batch) {
+    // the group was just opened; start the fill clock for the auto-tuner
+    current_wb->fill_start_micros_ =
+        db_->immutable_db_options().clock->NowMicros();
+  }
   return current_wb;
 }
 
 std::shared_ptr<WritesBatchList> SpdbWriteImpl::AddMerge(
     WriteBatch* batch, const WriteOptions& write_options, bool* leader_batch) {
   // thie will be released AFTER ths batch will be written to memtable!
-  add_buffer_mutex_.Lock();
+  add_buffer_rwlock_.WriteLock();
   std::shared_ptr<WritesBatchList> current_wb = nullptr;
   const uint64_t sequence =
       db_->FetchAddLastAllocatedSequence(batch->Count()) + 1;
@@ -229,11 +314,15 @@ std::shared_ptr<WritesBatchList> SpdbWriteImpl::AddMerge(
     current_wb = wb_lists_.back();
   }
   current_wb->Add(batch, write_options, leader_batch);
+  if (*leader_batch) {
+    current_wb->fill_start_micros_ =
+        db_->immutable_db_options().clock->NowMicros();
+  }
 
   return current_wb;
 }
 // release the add merge lock
-void SpdbWriteImpl::CompleteMerge() { add_buffer_mutex_.Unlock(); }
+void SpdbWriteImpl::CompleteMerge() { add_buffer_rwlock_.WriteUnlock(); }
 
 void SpdbWriteImpl::Lock(bool is_read) {
   if (is_read) {
@@ -251,13 +340,51 @@ void SpdbWriteImpl::Unlock(bool is_read) {
   }
 }
 
-void SpdbWriteImpl::SwitchBatchGroupIfNeeded() {
-  MutexLock l(&add_buffer_mutex_);
+uint64_t SpdbWriteImpl::SwitchBatchGroupIfNeeded() {
+  WriteLock wl(&add_buffer_rwlock_);
   MutexLock wb_list_lock(&wb_list_mutex_);
   // create new wb if needed
   // if (!wb_list->IsSwitchWBOccur()) {
-  wb_lists_.push_back(std::make_shared<WritesBatchList>());
+  wb_lists_.push_back(std::make_shared<WritesBatchList>(
+      batch_group_switch_threshold_.load(std::memory_order_relaxed)));
   //}
+  return next_wal_ticket_++;
+}
+
+void SpdbWriteImpl::WaitForWalWriteTurn(uint64_t ticket) {
+  std::unique_lock<std::mutex> lck(wal_order_mutex_);
+  wal_order_cv_.wait(lck, [&] { return wal_write_turn_ == ticket; });
+}
+
+void SpdbWriteImpl::CompleteWalWriteTurn(uint64_t /*ticket*/) {
+  {
+    std::lock_guard<std::mutex> lck(wal_order_mutex_);
+    ++wal_write_turn_;
+  }
+  wal_order_cv_.notify_all();
+}
+
+// Multiplicative adjust of the switch threshold, in the spirit of the rate
+// limiter's auto_tuned mode: if the group filled faster than its WAL write
+// (and sync) completed, writers are queuing behind the WAL and a larger
+// group amortizes the write better; if filling took much longer than the
+// WAL write, the load is light and a smaller group keeps the cap from ever
+// delaying a switch. In between the threshold is left alone. The leader
+// calls this outside any lock; concurrent leaders may race on the store,
+// which at worst loses one adjustment step.
+void SpdbWriteImpl::TuneBatchGroupSize(uint64_t fill_micros,
+                                       uint64_t wal_micros) {
+  const uint32_t threshold =
+      batch_group_switch_threshold_.load(std::memory_order_relaxed);
+  uint32_t tuned = threshold;
+  if (fill_micros < wal_micros) {
+    tuned = std::min(threshold * 2, kMaxElementsInBatchGroup);
+  } else if (fill_micros > 4 * wal_micros) {
+    tuned = std::max(threshold / 2, kMinElementsInBatchGroup);
+  }
+  if (tuned != threshold) {
+    batch_group_switch_threshold_.store(tuned, std::memory_order_relaxed);
+  }
 }
 
 void SpdbWriteImpl::PublishedSeq() {
@@ -283,57 +410,65 @@ void SpdbWriteImpl::PublishedSeq() {
 }
 
 void SpdbWriteImpl::SwitchAndWriteBatchGroup(WritesBatchList* batch_group) {
-  // take the wal write rw lock from protecting another batch group wal write
   IOStatus io_s;
   uint64_t offset = 0;
   uint64_t size = 0;
-  // uint64_t start_offset = 0;
-  // uint64_t total_size = 0;
 
-  wal_write_mutex_.Lock();
-  SwitchBatchGroupIfNeeded();
+  SystemClock* clock = db_->immutable_db_options().clock;
+
+  // The switch and the WAL ticket are allocated atomically, so the ticket
+  // order matches the batch group (and sequence) order.
+  const uint64_t ticket = SwitchBatchGroupIfNeeded();
+  // how long the group stayed open collecting batches
+  const uint64_t fill_micros =
+      clock->NowMicros() - batch_group->fill_start_micros_;
+  batch_group->MergeAddShards();
   /*ROCKS_LOG_INFO(db_->immutable_db_options().info_log,
                  "SwitchBatchGroup last batch group with %d batches and with "
                  "publish seq %" PRIu64,
                  batch_group->elements_num_, batch_group->GetMaxSeq());*/
 
+  // Merge the group's WAL writes before taking the WAL turn, so this
+  // leader prepares its merged record while the previous group's write is
+  // still in flight; only the ordered submission below is serialized.
+  struct WalSegment {
+    WriteBatch* batch;
+    size_t wal_writes;
+    const WriteBatch* to_be_cached_state;
+    // Batch contents compressed ahead of the WAL turn; used only when
+    // precompressed is set.
+    std::string compressed;
+    bool precompressed = false;
+  };
+  std::list<WriteBatch> merged_batches;
+  std::vector<WalSegment> segments;
   if (!batch_group->wal_writes_.empty()) {
-    auto const& immutable_db_options = db_->immutable_db_options();
-    StopWatch write_sw(immutable_db_options.clock, immutable_db_options.stats,
-                       DB_WAL_WRITE_TIME);
-
-    const WriteBatch* to_be_cached_state = nullptr;
     if (batch_group->wal_writes_.size() == 1 &&
         batch_group->wal_writes_.front()
             ->GetWalTerminationPoint()
             .is_cleared()) {
       WriteBatch* wal_batch = batch_group->wal_writes_.front();
-
+      const WriteBatch* to_be_cached_state = nullptr;
       if (WriteBatchInternal::IsLatestPersistentState(wal_batch)) {
         to_be_cached_state = wal_batch;
       }
-      io_s = db_->SpdbWriteToWAL(wal_batch, 1, to_be_cached_state,
-                                 batch_group->need_sync_, &offset, &size);
+      segments.push_back({wal_batch, 1, to_be_cached_state});
     } else {
       uint64_t progress_batch_seq = 0;
+      const WriteBatch* to_be_cached_state = nullptr;
       size_t wal_writes = 0;
-      WriteBatch* merged_batch = &tmp_batch_;
+      merged_batches.emplace_back();
+      WriteBatch* merged_batch = &merged_batches.back();
       for (const WriteBatch* batch : batch_group->wal_writes_) {
         if (wal_writes != 0 &&
             (progress_batch_seq != WriteBatchInternal::Sequence(batch))) {
           // this can happened if we have a batch group that consists no wal
           // writes... need to divide the wal writes when the seq is broken
-          io_s =
-              db_->SpdbWriteToWAL(merged_batch, wal_writes, to_be_cached_state,
-                                  batch_group->need_sync_, &offset, &size);
-          // reset counter and state
-          tmp_batch_.Clear();
+          segments.push_back({merged_batch, wal_writes, to_be_cached_state});
+          merged_batches.emplace_back();
+          merged_batch = &merged_batches.back();
           wal_writes = 0;
           to_be_cached_state = nullptr;
-          if (!io_s.ok()) {
-            // TBD what todo with error
-            break;
-          }
         }
         if (wal_writes == 0) {
           // first batch seq to use when we will replay the wal after recovery
@@ -355,13 +490,50 @@ void SpdbWriteImpl::SwitchAndWriteBatchGroup(WritesBatchList* batch_group) {
         ++wal_writes;
       }
       if (wal_writes) {
-        io_s = db_->SpdbWriteToWAL(merged_batch, wal_writes, to_be_cached_state,
-                                   batch_group->need_sync_, &offset, &size);
-        tmp_batch_.Clear();
+        segments.push_back({merged_batch, wal_writes, to_be_cached_state});
       }
     }
   }
-  wal_write_mutex_.Unlock();
+
+  // Compress the merged records before taking the WAL turn as well, so the
+  // compressor runs concurrently with the previous group's write instead of
+  // on the serialized submission path. On any compression error fall back to
+  // the inline-compressing AddRecord() path.
+  const CompressionType wal_compression =
+      db_->immutable_db_options().wal_compression;
+  if (wal_compression != kNoCompression) {
+    for (WalSegment& segment : segments) {
+      const Slice log_entry = WriteBatchInternal::Contents(segment.batch);
+      IOStatus compress_io_s = log::Writer::CompressRecord(
+          wal_compression, log_entry, &segment.compressed);
+      if (compress_io_s.ok()) {
+        segment.precompressed = true;
+      } else {
+        compress_io_s.PermitUncheckedError();
+        segment.compressed.clear();
+      }
+    }
+  }
+
+  WaitForWalWriteTurn(ticket);
+  const uint64_t wal_start_micros = clock->NowMicros();
+  if (!segments.empty()) {
+    auto const& immutable_db_options = db_->immutable_db_options();
+    StopWatch write_sw(immutable_db_options.clock, immutable_db_options.stats,
+                       DB_WAL_WRITE_TIME);
+    for (const WalSegment& segment : segments) {
+      io_s = db_->SpdbWriteToWAL(
+          segment.batch, segment.wal_writes, segment.to_be_cached_state,
+          batch_group->need_sync_,
+          segment.precompressed ? &segment.compressed : nullptr, &offset,
+          &size);
+      if (!io_s.ok()) {
+        // TBD what todo with error
+        break;
+      }
+    }
+  }
+  CompleteWalWriteTurn(ticket);
   if (!io_s.ok()) {
     // TBD what todo with error
     ROCKS_LOG_ERROR(db_->immutable_db_options().info_log,
@@ -371,6 +543,9 @@ void SpdbWriteImpl::SwitchAndWriteBatchGroup(WritesBatchList* batch_group) {
   if (batch_group->need_sync_) {
     db_->SpdbSyncWAL(offset, size);
   }
+  if (!segments.empty()) {
+    TuneBatchGroupSize(fill_micros, clock->NowMicros() - wal_start_micros);
+  }
 
   batch_group->WriteBatchComplete(true);
   /*ROCKS_LOG_INFO(db_->immutable_db_options().info_log,
@@ -410,11 +585,22 @@ Status DBImpl::SpdbWrite(const WriteOptions& write_options, WriteBatch* batch,
 
   if (!disable_memtable) {
     bool concurrent_memtable_writes = !batch->HasMerge();
-    status = WriteBatchInternal::InsertInto(
-        batch, column_family_memtables_.get(), &flush_scheduler_,
-        &trim_history_scheduler_, write_options.ignore_missing_column_families,
-        0 /*recovery_log_number*/, this, concurrent_memtable_writes, nullptr,
-        nullptr, seq_per_batch_, batch_per_txn_);
+    std::vector<uint32_t> batch_cfs;
+    if (concurrent_memtable_writes &&
+        immutable_db_options_.allow_concurrent_memtable_write &&
+        WriteBatchInternal::Count(batch) >= kSpdbParallelApplyMinKeys &&
+        WriteBatchInternal::CollectColumnFamilies(batch, &batch_cfs).ok() &&
+        batch_cfs.size() > 1) {
+      status =
+          SpdbInsertIntoMemtablesParallel(batch, write_options, batch_cfs);
+    } else {
+      status = WriteBatchInternal::InsertInto(
+          batch, column_family_memtables_.get(), &flush_scheduler_,
+          &trim_history_scheduler_,
+          write_options.ignore_missing_column_families,
+          0 /*recovery_log_number*/, this, concurrent_memtable_writes, nullptr,
+          nullptr, seq_per_batch_, batch_per_txn_);
+    }
   }
 
   if (batch->HasMerge()) {
@@ -428,6 +614,44 @@ Status DBImpl::SpdbWrite(const WriteOptions& write_options, WriteBatch* batch,
   return status;
 }
 
+Status DBImpl::SpdbInsertIntoMemtablesParallel(
+    WriteBatch* batch, const WriteOptions& write_options,
+    const std::vector<uint32_t>& column_families) {
+  assert(column_families.size() > 1);
+  port::Mutex mutex;
+  port::CondVar cv(&mutex);
+  size_t pending = column_families.size();
+  Status result;
+  std::vector<SpdbApplyShard> shards(column_families.size());
+  for (size_t i = 0; i < column_families.size(); i++) {
+    SpdbApplyShard& shard = shards[i];
+    shard.db = this;
+    shard.batch = batch;
+    shard.write_options = &write_options;
+    shard.cf_set = versions_->GetColumnFamilySet();
+    shard.flush_scheduler = &flush_scheduler_;
+    shard.trim_history_scheduler = &trim_history_scheduler_;
+    shard.cf_id = column_families[i];
+    shard.seq_per_batch = seq_per_batch_;
+    shard.batch_per_txn = batch_per_txn_;
+    shard.result = &result;
+    shard.pending = &pending;
+    shard.mutex = &mutex;
+    shard.cv = &cv;
+  }
+  for (size_t i = 1; i < shards.size(); i++) {
+    env_->Schedule(&ApplyShardToMemtables, &shards[i], Env::HIGH);
+  }
+  // Apply the first shard on this thread so we make progress even when the
+  // high-pri pool is saturated.
+  ApplyShardToMemtables(&shards[0]);
+  MutexLock lck(&mutex);
+  while (pending > 0) {
+    cv.Wait();
+  }
+  return result;
+}
+
 void DBImpl::SuspendSpdbWrites() {
   if (spdb_write_) {
     spdb_write_->Lock(false);
@@ -466,8 +690,9 @@ IOStatus DBImpl::SpdbSyncWAL(uint64_t offset, uint64_t size) {
 }
 IOStatus DBImpl::SpdbWriteToWAL(WriteBatch* merged_batch, size_t write_with_wal,
                                 const WriteBatch* to_be_cached_state,
-                                bool do_flush, uint64_t* offset,
-                                uint64_t* size) {
+                                bool do_flush,
+                                const std::string* precompressed_entry,
+                                uint64_t* offset, uint64_t* size) {
   assert(merged_batch != nullptr || write_with_wal == 0);
   IOStatus io_s;
 
@@ -476,8 +701,14 @@ IOStatus DBImpl::SpdbWriteToWAL(WriteBatch* merged_batch, size_t write_with_wal,
   {
     InstrumentedMutexLock l(&log_write_mutex_);
     log::Writer* log_writer = logs_.back().writer;
-    io_s = log_writer->AddRecordWithStartOffsetAndSize(log_entry, Env::IO_TOTAL,
-                                                       do_flush, offset, size);
+    if (precompressed_entry != nullptr && log_writer->compression_enabled()) {
+      *offset = log_writer->file()->GetFileSize();
+      io_s = log_writer->AddPrecompressedRecord(Slice(*precompressed_entry));
+      *size = log_writer->file()->GetFileSize() - *offset + 1;
+    } else {
+      io_s = log_writer->AddRecordWithStartOffsetAndSize(
+          log_entry, Env::IO_TOTAL, do_flush, offset, size);
+    }
   }
 
   total_log_size_ += log_entry_size;
@@ -45,15 +45,39 @@ class DBImpl;
 struct WriteOptions;
 
 struct WritesBatchList {
+  // The switch threshold is snapshotted from the auto-tuned value at
+  // creation so it stays constant over the list's lifetime.
+  explicit WritesBatchList(uint32_t switch_threshold)
+      : switch_threshold_(switch_threshold) {}
+
+  // Writers append to per-core-group shards so concurrent adds do not
+  // bounce one list head (and its cache lines) across sockets; the leader
+  // merges the shards back into wal_writes_ at publish time.
+  static constexpr size_t kAddShards = 4;
+  struct ALIGN_AS(CACHE_LINE_SIZE) AddShard {
+    port::Mutex mutex_;
+    std::list<WriteBatch*> wal_writes_;
+  };
+
+  std::array<AddShard, kAddShards> add_shards_;
   std::list<WriteBatch*> wal_writes_;
-  uint16_t elements_num_ = 0;
-  uint64_t max_seq_ = 0;
-  port::RWMutexWr buffer_write_rw_lock_;
+  // Once this many batches were added the group asks to be switched out.
+  const uint32_t switch_threshold_;
+  // Stamped by the leader when the group is opened; read back by the same
+  // leader when it switches the group out, to measure the fill time.
+  uint64_t fill_start_micros_ = 0;
+  std::atomic<uint32_t> elements_num_ = 0;
+  std::atomic<uint64_t> max_seq_ = 0;
   port::RWMutexWr write_ref_rwlock_;
   std::atomic<bool> need_sync_ = false;
   std::atomic<bool> switch_wb_ = false;
   std::atomic<bool> complete_batch_ = false;
+  std::mutex complete_mutex_;
+  std::condition_variable complete_cv_;
   void Clear() {
+    for (auto& shard : add_shards_) {
+      shard.wal_writes_.clear();
+    }
     wal_writes_.clear();
     elements_num_ = 0;
     max_seq_ = 0;
@@ -65,7 +89,10 @@ struct WritesBatchList {
  public:
   bool Add(WriteBatch* batch, const WriteOptions& write_options,
            bool* leader_batch);
-  uint64_t GetMaxSeq() const { return max_seq_; }
+  // collect the shard lists into wal_writes_ in sequence order; only the
+  // leader calls this, after the group was switched out
+  void MergeAddShards();
+  uint64_t GetMaxSeq() const { return max_seq_.load(); }
   void WaitForPendingWrites();
   bool IsSwitchWBOccur() const { return switch_wb_.load(); }
   bool IsComplete() const { return complete_batch_.load(); }
@@ -95,9 +122,21 @@ class SpdbWriteImpl {
 
  public:
   void SwitchAndWriteBatchGroup(WritesBatchList* wb_list);
-  void SwitchBatchGroupIfNeeded();
+  // switches to a fresh batch list and returns the WAL ordering ticket of
+  // the closed one; tickets are issued in batch-group (sequence) order
+  uint64_t SwitchBatchGroupIfNeeded();
   void PublishedSeq();
 
+  // WAL submissions are admitted in ticket order so the merged record
+  // stream stays sequence-ordered while leaders merge in parallel
+  void WaitForWalWriteTurn(uint64_t ticket);
+  void CompleteWalWriteTurn(uint64_t ticket);
+
+  // Adjusts the switch threshold used for newly opened batch groups from
+  // the fill time and WAL write (incl. sync) time the leader just observed;
+  // see the implementation for the policy and the bounds.
+  void TuneBatchGroupSize(uint64_t fill_micros, uint64_t wal_micros);
+
   std::atomic<uint64_t> last_wal_write_seq_{0};
 
   std::list<std::shared_ptr<WritesBatchList>> wb_lists_;
@@ -105,14 +144,20 @@ class SpdbWriteImpl {
   std::atomic<bool> flush_thread_terminate_;
   std::mutex flush_thread_mutex_;
   std::condition_variable flush_thread_cv_;
-  port::Mutex add_buffer_mutex_;
+  port::RWMutexWr add_buffer_rwlock_;
   port::RWMutexWr flush_rwlock_;
   port::Thread flush_thread_;
   port::RWMutexWr wal_buffers_rwlock_;
-  port::Mutex wal_write_mutex_;
   port::Mutex wb_list_mutex_;
 
-  WriteBatch tmp_batch_;
+  std::mutex wal_order_mutex_;
+  std::condition_variable wal_order_cv_;
+  uint64_t next_wal_ticket_ = 0;
+  uint64_t wal_write_turn_ = 0;
+
+  // Cap on batches per group, applied to newly opened groups; auto-tuned
+  // by TuneBatchGroupSize().
+  std::atomic<uint32_t> batch_group_switch_threshold_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
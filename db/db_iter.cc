@@ -310,7 +310,8 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
 
     assert(prefix == nullptr || prefix_extractor_ != nullptr);
     if (prefix != nullptr &&
-        prefix_extractor_->Transform(user_key_without_ts).compare(*prefix) !=
+        prefix_extractor_->TransformInline(user_key_without_ts)
+                .compare(*prefix) !=
             0) {
       assert(prefix_same_as_start_);
       break;
@@ -1479,6 +1480,80 @@ void DBIter::Seek(const Slice& target) {
 
     RecordTick(statistics_, NUMBER_DB_SEEK);
   }
+
+  FinishSeek(target);
+}
+
+void DBIter::SeekAsync(const Slice& target,
+                       std::function<void(Iterator*)> callback) {
+  PERF_CPU_TIMER_GUARD(iter_seek_cpu_nanos, clock_);
+  // Only the issue phase is under DB_SEEK; the deferred completion is timed
+  // by SeekAwait().
+  StopWatch sw(clock_, statistics_, DB_SEEK);
+
+  if (db_impl_ != nullptr && cfd_ != nullptr) {
+    Slice lower_bound, upper_bound;
+    if (iterate_lower_bound_ != nullptr) {
+      lower_bound = *iterate_lower_bound_;
+    } else {
+      lower_bound = Slice("");
+    }
+    if (iterate_upper_bound_ != nullptr) {
+      upper_bound = *iterate_upper_bound_;
+    } else {
+      upper_bound = Slice("");
+    }
+    db_impl_->TraceIteratorSeek(cfd_->GetID(), target, lower_bound, upper_bound)
+        .PermitUncheckedError();
+  }
+
+  status_ = Status::OK();
+  ReleaseTempPinnedData();
+  ResetBlobValue();
+  ResetValueAndColumns();
+  ResetInternalKeysSkippedCounter();
+
+  bool completed = true;
+  {
+    PERF_TIMER_GUARD(seek_internal_seek_time);
+
+    SetSavedKeyToSeekTarget(target);
+    completed = iter_.SeekIssue(saved_key_.GetInternalKey());
+
+    RecordTick(statistics_, NUMBER_DB_SEEK);
+  }
+  if (!completed) {
+    // the inner iterator submitted its first table reads asynchronously;
+    // the caller may issue seeks on other iterators before SeekAwait()
+    async_seek_pending_ = true;
+    async_seek_target_.assign(target.data(), target.size());
+    async_seek_callback_ = std::move(callback);
+    return;
+  }
+
+  FinishSeek(target);
+  callback(this);
+}
+
+void DBIter::SeekAwait() {
+  if (!async_seek_pending_) {
+    return;
+  }
+  PERF_CPU_TIMER_GUARD(iter_seek_cpu_nanos, clock_);
+  StopWatch sw(clock_, statistics_, DB_SEEK);
+  async_seek_pending_ = false;
+  {
+    PERF_TIMER_GUARD(seek_internal_seek_time);
+    iter_.SeekComplete();
+  }
+
+  FinishSeek(async_seek_target_);
+  std::function<void(Iterator*)> callback = std::move(async_seek_callback_);
+  async_seek_callback_ = nullptr;
+  callback(this);
+}
+
+void DBIter::FinishSeek(const Slice& target) {
   if (!iter_.Valid()) {
     valid_ = false;
     return;
@@ -1492,7 +1567,7 @@ void DBIter::Seek(const Slice& target) {
     // The case where the iterator needs to be invalidated if it has exhausted
     // keys within the same prefix of the seek key.
     assert(prefix_extractor_ != nullptr);
-    Slice target_prefix = prefix_extractor_->Transform(target);
+    Slice target_prefix = prefix_extractor_->TransformInline(target);
     FindNextUserEntry(false /* not skipping saved_key */,
                       &target_prefix /* prefix */);
     if (valid_) {
@@ -1566,7 +1641,7 @@ void DBIter::SeekForPrev(const Slice& target) {
     // The case where the iterator needs to be invalidated if it has exhausted
     // keys within the same prefix of the seek key.
     assert(prefix_extractor_ != nullptr);
-    Slice target_prefix = prefix_extractor_->Transform(target);
+    Slice target_prefix = prefix_extractor_->TransformInline(target);
     PrevInternal(&target_prefix);
     if (valid_) {
       // Remember the prefix of the seek key for the future Prev() call to
@@ -1631,7 +1706,7 @@ void DBIter::SeekToFirst() {
   }
   if (valid_ && prefix_same_as_start_) {
     assert(prefix_extractor_ != nullptr);
-    prefix_.SetUserKey(prefix_extractor_->Transform(
+    prefix_.SetUserKey(prefix_extractor_->TransformInline(
         StripTimestampFromUserKey(saved_key_.GetUserKey(), timestamp_size_)));
   }
 }
@@ -1684,7 +1759,7 @@ void DBIter::SeekToLast() {
   }
   if (valid_ && prefix_same_as_start_) {
     assert(prefix_extractor_ != nullptr);
-    prefix_.SetUserKey(prefix_extractor_->Transform(
+    prefix_.SetUserKey(prefix_extractor_->TransformInline(
         StripTimestampFromUserKey(saved_key_.GetUserKey(), timestamp_size_)));
   }
 }
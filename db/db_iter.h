@@ -200,6 +200,12 @@ class DBIter final : public Iterator {
   // 'target' does not contain timestamp, even if user timestamp feature is
   // enabled.
   void Seek(const Slice& target) final override;
+  // Two-phase Seek; see Iterator::SeekAsync(). The issue phase pushes the
+  // inner iterator's first table reads through SeekIssue(); when they were
+  // deferred, SeekAwait() finishes positioning and invokes the callback.
+  void SeekAsync(const Slice& target,
+                 std::function<void(Iterator*)> callback) final override;
+  void SeekAwait() final override;
   void SeekForPrev(const Slice& target) final override;
   void SeekToFirst() final override;
   void SeekToLast() final override;
@@ -223,6 +229,10 @@ class DBIter final : public Iterator {
   // It might get adjusted if the seek key is smaller than iterator lower bound.
   // target does not have timestamp.
   void SetSavedKeyToSeekTarget(const Slice& target);
+  // Position on the first visible user entry at or after the target once the
+  // inner iterator completed its seek; shared tail of Seek(), SeekAsync()
+  // and SeekAwait(). target is the user target of the seek.
+  void FinishSeek(const Slice& target);
   // Set saved_key_ to the seek key to target, with proper sequence number set.
   // It might get adjusted if the seek key is larger than iterator upper bound.
   // target does not have timestamp.
@@ -394,6 +404,11 @@ class DBIter final : public Iterator {
   const Slice* const timestamp_lb_;
   const size_t timestamp_size_;
   std::string saved_timestamp_;
+  // Pending state of a SeekAsync() whose inner seek was deferred; consumed
+  // by SeekAwait().
+  bool async_seek_pending_ = false;
+  std::string async_seek_target_;
+  std::function<void(Iterator*)> async_seek_callback_;
 };
 
 // Return a new iterator that converts internal keys (yielded by
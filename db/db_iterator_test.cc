@@ -189,6 +189,52 @@ TEST_P(DBIteratorTest, IterSeekBeforePrev) {
   delete iter;
 }
 
+TEST_P(DBIteratorTest, SeekAsyncBatch) {
+  ASSERT_OK(Put("a", "1"));
+  ASSERT_OK(Put("c", "2"));
+  EXPECT_OK(dbfull()->Flush(FlushOptions()));
+  ASSERT_OK(Put("e", "3"));
+  ASSERT_OK(Put("g", "4"));
+  EXPECT_OK(dbfull()->Flush(FlushOptions()));
+  ASSERT_OK(Put("i", "5"));
+
+  // async_io falls back to synchronous reads when the file system does not
+  // support it, so every callback is expected to fire by the time the
+  // SeekAwait() loop finished, with the same positioning as plain Seek().
+  ReadOptions read_options;
+  read_options.async_io = true;
+  constexpr size_t kNumIters = 4;
+  const std::vector<std::string> targets = {"a", "b", "f", "j"};
+  const std::vector<std::string> expected_keys = {"a", "c", "g", ""};
+  std::vector<Iterator*> iters;
+  for (size_t i = 0; i < kNumIters; ++i) {
+    iters.push_back(NewIterator(read_options));
+  }
+  size_t callbacks = 0;
+  for (size_t i = 0; i < kNumIters; ++i) {
+    iters[i]->SeekAsync(targets[i],
+                        [&callbacks](Iterator* iter) {
+                          ASSERT_OK(iter->status());
+                          ++callbacks;
+                        });
+  }
+  for (size_t i = 0; i < kNumIters; ++i) {
+    iters[i]->SeekAwait();
+    // a second SeekAwait() with no pending seek is a no-op
+    iters[i]->SeekAwait();
+  }
+  ASSERT_EQ(kNumIters, callbacks);
+  for (size_t i = 0; i < kNumIters; ++i) {
+    if (expected_keys[i].empty()) {
+      ASSERT_FALSE(iters[i]->Valid());
+    } else {
+      ASSERT_TRUE(iters[i]->Valid());
+      ASSERT_EQ(expected_keys[i], iters[i]->key().ToString());
+    }
+    delete iters[i];
+  }
+}
+
 TEST_P(DBIteratorTest, IterReseekNewUpperBound) {
   Random rnd(301);
   Options options = CurrentOptions();
@@ -2395,6 +2441,129 @@ TEST_P(DBIteratorTest, RefreshWithSnapshot) {
   delete iter;
 }
 
+TEST_P(DBIteratorTest, AutoRefreshIterator) {
+  // Enough keys to get past the iterator's internal refresh-check interval
+  // after the super-version changes mid-scan.
+  constexpr int kNumKeys = 3000;
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), "v"));
+  }
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ReadOptions options;
+  options.snapshot = snapshot;
+  options.auto_refresh_iterator = true;
+  std::unique_ptr<Iterator> iter(NewIterator(options));
+  ASSERT_OK(iter->status());
+
+  iter->SeekToFirst();
+  ASSERT_TRUE(iter->Valid());
+  std::string sv_before;
+  ASSERT_OK(
+      iter->GetProperty("rocksdb.iterator.super-version-number", &sv_before));
+
+  // Change the super-version under the iterator, and write a key past the
+  // snapshot that the scan must not observe.
+  ASSERT_OK(Put(Key(kNumKeys), "not-visible"));
+  ASSERT_OK(Flush());
+
+  int count = 0;
+  for (; iter->Valid(); iter->Next()) {
+    ASSERT_EQ("v", iter->value());
+    count++;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(kNumKeys, count);
+
+  std::string sv_after;
+  ASSERT_OK(
+      iter->GetProperty("rocksdb.iterator.super-version-number", &sv_after));
+  // The iterator transparently rebound to a newer super-version mid-scan.
+  ASSERT_NE(sv_before, sv_after);
+
+  iter.reset();
+  db_->ReleaseSnapshot(snapshot);
+}
+
+TEST_P(DBIteratorTest, MergedCrossCFIterator) {
+  Options options = CurrentOptions();
+  CreateAndReopenWithCF({"shard_a", "shard_b"}, options);
+
+  // Disjoint keys spread over the three column families, with one shard
+  // flushed so that both memtable and SST sources get merged.
+  ASSERT_OK(Put(0, "k0", "v0"));
+  ASSERT_OK(Put(1, "k1", "v1"));
+  ASSERT_OK(Put(2, "k2", "v2"));
+  ASSERT_OK(Put(1, "k4", "v4"));
+  ASSERT_OK(Flush(1));
+  ASSERT_OK(Put(2, "k3", "v3"));
+
+  std::vector<ColumnFamilyHandle*> cfs = {handles_[0], handles_[1],
+                                          handles_[2]};
+  ReadOptions read_options;
+  Iterator* iter = nullptr;
+  ASSERT_OK(db_->NewMergedCrossCFIterator(read_options, cfs, &iter));
+  std::unique_ptr<Iterator> iter_guard(iter);
+
+  std::vector<std::string> keys;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    keys.push_back(iter->key().ToString());
+    ASSERT_EQ("v" + keys.back().substr(1), iter->value().ToString());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(std::vector<std::string>({"k0", "k1", "k2", "k3", "k4"}), keys);
+
+  // Reverse scan over the same merged view.
+  keys.clear();
+  for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+    keys.push_back(iter->key().ToString());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(std::vector<std::string>({"k4", "k3", "k2", "k1", "k0"}), keys);
+
+  // Seek lands on the smallest key >= target regardless of column family.
+  iter->Seek("k2");
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ("k2", iter->key().ToString());
+  iter_guard.reset();
+
+  // A snapshot pins the merged view across all column families.
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(Put(1, "k5", "v5"));
+  // Shadow CF shard_b's "k2" from CF shard_a.
+  ASSERT_OK(Put(1, "k2", "overwritten"));
+  read_options.snapshot = snapshot;
+  ASSERT_OK(db_->NewMergedCrossCFIterator(read_options, cfs, &iter));
+  iter_guard.reset(iter);
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_NE("k5", iter->key().ToString());
+    ASSERT_NE("overwritten", iter->value().ToString());
+    count++;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(5, count);
+  iter_guard.reset();
+  db_->ReleaseSnapshot(snapshot);
+
+  // Without the snapshot, the newest entry for a duplicated user key wins,
+  // no matter which column family it was written to.
+  read_options.snapshot = nullptr;
+  ASSERT_OK(db_->NewMergedCrossCFIterator(read_options, cfs, &iter));
+  iter_guard.reset(iter);
+  iter->Seek("k2");
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ("overwritten", iter->value().ToString());
+  iter_guard.reset();
+
+  // Error cases.
+  ASSERT_TRUE(db_->NewMergedCrossCFIterator(read_options, {}, &iter)
+                  .IsInvalidArgument());
+  ReadOptions tailing_options;
+  tailing_options.tailing = true;
+  ASSERT_TRUE(db_->NewMergedCrossCFIterator(tailing_options, cfs, &iter)
+                  .IsNotSupported());
+}
+
 TEST_P(DBIteratorTest, CreationFailure) {
   SyncPoint::GetInstance()->SetCallBack(
       "DBImpl::NewInternalIterator:StatusCallback", [](void* arg) {
@@ -3046,6 +3215,56 @@ TEST_P(DBIteratorTest, Blob) {
   ASSERT_EQ(IterStatus(iter), "b->vb3");
 }
 
+TEST_P(DBIteratorTest, RecycledIteratorsWithBounds) {
+  Options options = CurrentOptions();
+  options.recycle_iterators = true;
+  DestroyAndReopen(options);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_OK(Put(Key(i), "v" + std::to_string(i)));
+  }
+  // Two paginated scans with different upper bounds, interleaved, each
+  // reusing its own ReadOptions object across pages. With the pool holding
+  // several entries per column family, each scan resumes its own iterator.
+  std::string ub_a_storage = Key(30);
+  Slice ub_a(ub_a_storage);
+  ReadOptions ro_a;
+  ro_a.iterate_upper_bound = &ub_a;
+  std::string ub_b_storage = Key(60);
+  Slice ub_b(ub_b_storage);
+  ReadOptions ro_b;
+  ro_b.iterate_upper_bound = &ub_b;
+  for (int page = 0; page < 3; page++) {
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ro_a));
+      int count = 0;
+      for (iter->Seek(Key(10 * page)); iter->Valid(); iter->Next()) {
+        ASSERT_LT(iter->key().ToString(), ub_a_storage);
+        count++;
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(30 - 10 * page, count);
+    }
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ro_b));
+      int count = 0;
+      for (iter->Seek(Key(20 * page)); iter->Valid(); iter->Next()) {
+        ASSERT_LT(iter->key().ToString(), ub_b_storage);
+        count++;
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(60 - 20 * page, count);
+    }
+  }
+  // Writes between pages are visible to reused iterators.
+  ASSERT_OK(Put(Key(15), "updated"));
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ro_a));
+    iter->Seek(Key(15));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ("updated", iter->value().ToString());
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(DBIteratorTestInstance, DBIteratorTest,
                         testing::Values(true, false));
 
@@ -437,6 +437,68 @@ TEST_F(DBMergeOperandTest, GetMergeOperandsLargeResultOptimization) {
   }
 }
 
+TEST_F(DBMergeOperandTest, GetMergeOperandsStopWhenShouldMerge) {
+  Options options;
+  options.create_if_missing = true;
+  // The operator only needs the latest two operands.
+  options.merge_operator = std::make_shared<LimitedStringAppendMergeOp>(2, ',');
+  options.env = env_;
+  DestroyAndReopen(options);
+
+  const int kNumOperands = 10;
+  std::vector<PinnableSlice> values(kNumOperands);
+  GetMergeOperandsOptions merge_operands_info;
+  merge_operands_info.expected_max_number_of_operands = kNumOperands;
+  merge_operands_info.stop_when_should_merge = true;
+  int number_of_operands = 0;
+
+  // All operands in the memtable; the lookup stops there.
+  ASSERT_OK(Merge("k1", "a"));
+  ASSERT_OK(Merge("k1", "b"));
+  ASSERT_OK(Merge("k1", "c"));
+  ASSERT_OK(Merge("k1", "d"));
+  ASSERT_OK(db_->GetMergeOperands(ReadOptions(), db_->DefaultColumnFamily(),
+                                  "k1", values.data(), &merge_operands_info,
+                                  &number_of_operands));
+  ASSERT_EQ(number_of_operands, 2);
+  ASSERT_EQ(values[0], "c");
+  ASSERT_EQ(values[1], "d");
+
+  // Operands spread between an SST file and the memtable; the memtable alone
+  // satisfies ShouldMerge(), so the SST file is never read.
+  ASSERT_OK(Merge("k2", "a"));
+  ASSERT_OK(Merge("k2", "b"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Merge("k2", "c"));
+  ASSERT_OK(Merge("k2", "d"));
+  ASSERT_OK(db_->GetMergeOperands(ReadOptions(), db_->DefaultColumnFamily(),
+                                  "k2", values.data(), &merge_operands_info,
+                                  &number_of_operands));
+  ASSERT_EQ(number_of_operands, 2);
+  ASSERT_EQ(values[0], "c");
+  ASSERT_EQ(values[1], "d");
+
+  // All operands in an SST file; the scan stops within the file.
+  ASSERT_OK(Merge("k3", "a"));
+  ASSERT_OK(Merge("k3", "b"));
+  ASSERT_OK(Merge("k3", "c"));
+  ASSERT_OK(Merge("k3", "d"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->GetMergeOperands(ReadOptions(), db_->DefaultColumnFamily(),
+                                  "k3", values.data(), &merge_operands_info,
+                                  &number_of_operands));
+  ASSERT_EQ(number_of_operands, 2);
+  ASSERT_EQ(values[0], "c");
+  ASSERT_EQ(values[1], "d");
+
+  // Without the flag, all operands are returned as before.
+  merge_operands_info.stop_when_should_merge = false;
+  ASSERT_OK(db_->GetMergeOperands(ReadOptions(), db_->DefaultColumnFamily(),
+                                  "k3", values.data(), &merge_operands_info,
+                                  &number_of_operands));
+  ASSERT_EQ(number_of_operands, 4);
+}
+
 TEST_F(DBMergeOperandTest, GetMergeOperandsBaseDeletionInImmMem) {
   // In this test, "k1" has a MERGE in a mutable memtable on top of a base
   // DELETE in an immutable memtable.
@@ -76,6 +76,46 @@ TEST_F(DBRangeDelTest, EndComesBeforeStartInvalidArgument) {
   ASSERT_EQ("val", Get("b"));
 }
 
+TEST_F(DBRangeDelTest, FragmentedTombstoneListSharedThroughBlockCache) {
+  std::shared_ptr<Cache> cache = NewLRUCache(8 << 20);
+  Options options = CurrentOptions();
+  BlockBasedTableOptions bbto;
+  bbto.block_cache = cache;
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("a", "v"));
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "b",
+                             "c"));
+  ASSERT_OK(Flush());
+
+  auto count_fragment_entries = [&]() {
+    size_t count = 0;
+    cache->ApplyToAllEntries(
+        [&](const Slice& /*key*/, Cache::ObjectPtr /*obj*/, size_t /*charge*/,
+            const Cache::CacheItemHelper* helper) {
+          if (helper != nullptr &&
+              helper->role == CacheEntryRole::kFragmentedRangeTombstoneList) {
+            ++count;
+          }
+        },
+        {});
+    return count;
+  };
+
+  // Opening the flushed table fragments its tombstones once and publishes
+  // the result in the block cache.
+  ASSERT_EQ(1, count_fragment_entries());
+
+  // A fresh DB open builds new table readers for the same file; the cache
+  // key is derived from the file's stable identity, so the fragmented
+  // structure is reused rather than rebuilt and re-inserted.
+  Reopen(options);
+  ASSERT_EQ("v", Get("a"));
+  ASSERT_EQ("NOT_FOUND", Get("b"));
+  ASSERT_EQ(1, count_fragment_entries());
+}
+
 TEST_F(DBRangeDelTest, FlushOutputHasOnlyRangeTombstones) {
   do {
     DestroyAndReopen(CurrentOptions());
@@ -1867,6 +1867,40 @@ TEST_F(DBSSTTest, DBWithSFMForBlobFilesAtomicFlush) {
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
 }
 
+TEST_F(DBSSTTest, SstFileManagerDeviceWriteAccounting) {
+  SstFileManagerImpl sfm(env_->GetSystemClock(), env_->GetFileSystem(),
+                         nullptr, /* rate_bytes_per_sec= */ 0,
+                         /* max_trash_db_ratio= */ 0.25,
+                         /* bytes_max_delete_chunk= */ 0);
+
+  // Paths that do not exist resolve to distinct synthetic device ids, which
+  // lets this test model a two-drive db_paths layout.
+  std::string path_a = dbname_ + "/nonexistent_drive_a";
+  std::string path_b = dbname_ + "/nonexistent_drive_b";
+  std::vector<DbPath> paths{{path_a, 1ull << 30}, {path_b, 1ull << 30}};
+
+  // No traffic yet: the size-based choice sticks.
+  ASSERT_EQ(sfm.PickLeastLoadedPathId(paths, 0), 0u);
+  ASSERT_EQ(sfm.GetDeviceWriteBandwidth(path_a), 0u);
+
+  // Light traffic on the preferred device is not worth deviating for.
+  sfm.OnIOBytesWritten(path_a + "/000001.sst", 1 << 20);
+  ASSERT_EQ(sfm.PickLeastLoadedPathId(paths, 0), 0u);
+  ASSERT_GT(sfm.GetDeviceWriteBandwidth(path_a), 0u);
+
+  // Heavy traffic on the preferred device moves the output to the idle one.
+  sfm.OnIOBytesWritten(path_a + "/000002.sst", 64 << 20);
+  ASSERT_EQ(sfm.PickLeastLoadedPathId(paths, 0), 1u);
+
+  // Once both devices are equally busy the size-based choice sticks again.
+  sfm.OnIOBytesWritten(path_b + "/000003.sst", 65 << 20);
+  ASSERT_EQ(sfm.PickLeastLoadedPathId(paths, 0), 0u);
+
+  // A single-path layout never deviates.
+  std::vector<DbPath> one_path{{path_a, 1ull << 30}};
+  ASSERT_EQ(sfm.PickLeastLoadedPathId(one_path, 0), 0u);
+}
+
 
 }  // namespace ROCKSDB_NAMESPACE
 
@@ -1953,6 +1953,61 @@ TEST_F(DBTest, ApproximateSizes) {
                          kSkipPlainTable | kSkipHashIndex));
 }
 
+TEST_F(DBTest, EstimateRangeStats) {
+  Options options = CurrentOptions();
+  options.compression = kNoCompression;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+  ASSERT_OK(db_->EstimateKeysInRange(Range("", "xyz"), &count));
+  ASSERT_EQ(count, 0U);
+
+  // 10 disjoint files of 100 keys each, all in L0 but non-overlapping.
+  constexpr int kNumFiles = 10;
+  constexpr int kKeysPerFile = 100;
+  Random rnd(301);
+  for (int f = 0; f < kNumFiles; f++) {
+    for (int i = 0; i < kKeysPerFile; i++) {
+      ASSERT_OK(Put(Key(f * kKeysPerFile + i), rnd.RandomString(100)));
+    }
+    ASSERT_OK(Flush());
+  }
+
+  // Whole key space; every file lies inside the range so the estimate is
+  // exact.
+  ASSERT_OK(
+      db_->EstimateKeysInRange(Range("", Key(kNumFiles * kKeysPerFile)),
+                               &count));
+  ASSERT_EQ(count, static_cast<uint64_t>(kNumFiles * kKeysPerFile));
+  ASSERT_OK(
+      db_->EstimateBytesInRange(Range("", Key(kNumFiles * kKeysPerFile)),
+                                &bytes));
+  ASSERT_GT(bytes, 0U);
+
+  // A range covering 4 full files plus half of the files on each side; the
+  // boundary files are counted at half weight, so the estimate stays within
+  // one file's worth of the true count.
+  ASSERT_OK(db_->EstimateKeysInRange(
+      Range(Key(150), Key(750)), &count));
+  ASSERT_GE(count, 5 * kKeysPerFile);
+  ASSERT_LE(count, 7 * kKeysPerFile);
+
+  // Empty range beyond the last key.
+  ASSERT_OK(db_->EstimateKeysInRange(
+      Range(Key(kNumFiles * kKeysPerFile), Key(kNumFiles * kKeysPerFile + 1)),
+      &count));
+  ASSERT_EQ(count, 0U);
+
+  // The summary is refreshed when a new version is installed.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_OK(
+      db_->EstimateKeysInRange(Range("", Key(kNumFiles * kKeysPerFile)),
+                               &count));
+  ASSERT_EQ(count, static_cast<uint64_t>(kNumFiles * kKeysPerFile));
+}
+
 TEST_F(DBTest, ApproximateSizes_MixOfSmallAndLarge) {
   do {
     Options options = CurrentOptions();
@@ -6344,6 +6399,86 @@ TEST_F(DBTest, PromoteL0Failure) {
   ASSERT_TRUE(status.IsInvalidArgument());
 }
 
+TEST_F(DBTest, SplitSstFile) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  const int kNumKeys = 100;
+  Random rnd(301);
+  std::map<int, std::string> values;
+  for (int i = 0; i < kNumKeys; i++) {
+    values[i] = rnd.RandomString(1024);
+    ASSERT_OK(Put(Key(i), values[i]));
+  }
+  ASSERT_OK(Flush());
+  // Move the file out of L0; splits are only supported on sorted levels.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 1);
+  const uint64_t file_number = files[0].file_number;
+  const int level = files[0].level;
+  ASSERT_GT(level, 0);
+
+  // A split key outside the file range fails.
+  ASSERT_TRUE(experimental::SplitSstFile(db_, db_->DefaultColumnFamily(),
+                                         file_number, Key(0))
+                  .IsInvalidArgument());
+  // An unknown file number fails.
+  ASSERT_TRUE(experimental::SplitSstFile(db_, db_->DefaultColumnFamily(),
+                                         file_number + 12345, Key(50))
+                  .IsInvalidArgument());
+
+  ASSERT_OK(experimental::SplitSstFile(db_, db_->DefaultColumnFamily(),
+                                       file_number, Key(50)));
+
+  // Two metadata entries now share the physical file.
+  files.clear();
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 2);
+  for (const auto& f : files) {
+    ASSERT_EQ(f.level, level);
+    ASSERT_NE(f.file_number, file_number);
+  }
+
+  // Point lookups and both scan directions must see each key exactly once.
+  auto verify_all = [&]() {
+    for (const auto& kv : values) {
+      ASSERT_EQ(Get(Key(kv.first)), kv.second);
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->key().ToString(), Key(count));
+      ASSERT_EQ(iter->value().ToString(), values[count]);
+      count++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, kNumKeys);
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      count--;
+      ASSERT_EQ(iter->key().ToString(), Key(count));
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, 0);
+    // Seek straight into the right half.
+    iter->Seek(Key(50));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key().ToString(), Key(50));
+  };
+  verify_all();
+
+  // The clipped flag must survive a MANIFEST round trip.
+  Reopen(options);
+  verify_all();
+
+  // The halves can be compacted back into regular files.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  verify_all();
+}
+
 // Github issue #596
 TEST_F(DBTest, CompactRangeWithEmptyBottomLevel) {
   const int kNumLevels = 2;
@@ -315,6 +315,35 @@ TEST_F(DBWALTest, Recover) {
   } while (ChangeWalOptions());
 }
 
+TEST_F(DBWALTest, RecoverWithColumnFamilyIdTags) {
+  Options options = CurrentOptions();
+  options.wal_tag_column_family_ids = true;
+  options.avoid_flush_during_recovery = true;
+  CreateAndReopenWithCF({"busy", "idle"}, options);
+
+  ASSERT_OK(Put(1, "busy1", "v1"));
+  ASSERT_OK(Put(2, "idle1", "v1"));
+  // After the flush, "idle"'s records in the shared WAL are skippable at
+  // recovery while "busy"'s must still be replayed.
+  ASSERT_OK(Flush(2));
+  ASSERT_OK(Put(1, "busy2", "v2"));
+  ASSERT_OK(Put(2, "idle2", "v2"));
+
+  ReopenWithColumnFamilies({"default", "busy", "idle"}, options);
+  ASSERT_EQ("v1", Get(1, "busy1"));
+  ASSERT_EQ("v2", Get(1, "busy2"));
+  ASSERT_EQ("v1", Get(2, "idle1"));
+  ASSERT_EQ("v2", Get(2, "idle2"));
+
+  // A WAL tagged by a previous run must also recover with the option off.
+  ASSERT_OK(Put(1, "busy3", "v3"));
+  options.wal_tag_column_family_ids = false;
+  ReopenWithColumnFamilies({"default", "busy", "idle"}, options);
+  ASSERT_EQ("v1", Get(1, "busy1"));
+  ASSERT_EQ("v3", Get(1, "busy3"));
+  ASSERT_EQ("v2", Get(2, "idle2"));
+}
+
 TEST_F(DBWALTest, RecoverWithTableHandle) {
   do {
     Options options = CurrentOptions();
@@ -975,6 +1004,55 @@ TEST_F(DBWALTest, DISABLED_FullPurgePreservesLogPendingReuse) {
   }
 }
 
+TEST_F(DBWALTest, PreallocatedWALPool) {
+  // With recycling enabled, a background job keeps a pool of pre-created
+  // WAL files ready so memtable switches can adopt one instead of creating
+  // a file from scratch. Verify the pool is filled after open, that a WAL
+  // roll adopts from it, and that the pool files are removed at close.
+  Options options = CurrentOptions();
+  options.recycle_log_file_num = 2;
+
+  std::atomic<int> adopted{0};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::CreateWAL:AdoptPreallocatedWAL",
+      [&](void* /*arg*/) { adopted.fetch_add(1); });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->LoadDependency(
+      {{"DBImpl::BGWorkPreallocWAL:end",
+        "DBWALTest::PreallocatedWALPool:WaitForPool"}});
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  DestroyAndReopen(options);
+  TEST_SYNC_POINT("DBWALTest::PreallocatedWALPool:WaitForPool");
+
+  auto count_pool_files = [&]() {
+    std::vector<std::string> files;
+    EXPECT_OK(env_->GetChildren(dbname_, &files));
+    int n = 0;
+    for (const auto& f : files) {
+      if (f.compare(0, strlen("prealloc."), "prealloc.") == 0) {
+        ++n;
+      }
+    }
+    return n;
+  };
+  ASSERT_GT(count_pool_files(), 0);
+
+  // Rolling the WAL with an empty recycle list should adopt a pool file.
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("foo", "v2"));
+  ASSERT_GT(adopted.load(), 0);
+
+  // Make sure the adopted file replays like any other WAL.
+  Reopen(options);
+  ASSERT_EQ("v2", Get("foo"));
+
+  Close();
+  ASSERT_EQ(0, count_pool_files());
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBWALTest, GetSortedWalFiles) {
   do {
     CreateAndReopenWithCF({"pikachu"}, CurrentOptions());
@@ -29,6 +29,14 @@ Status PromoteL0(DB* db, ColumnFamilyHandle* column_family, int target_level) {
   return db->PromoteL0(column_family, target_level);
 }
 
+Status SplitSstFile(DB* db, ColumnFamilyHandle* column_family,
+                    uint64_t file_number, const Slice& split_user_key) {
+  if (db == nullptr) {
+    return Status::InvalidArgument("Didn't recognize DB object");
+  }
+  return db->SplitSstFile(column_family, file_number, split_user_key);
+}
+
 
 Status SuggestCompactRange(DB* db, const Slice* begin, const Slice* end) {
   return SuggestCompactRange(db, db->DefaultColumnFamily(), begin, end);
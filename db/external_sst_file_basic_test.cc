@@ -251,6 +251,53 @@ TEST_F(ExternalSSTFileBasicTest, Basic) {
   DestroyAndRecreateExternalSSTFilesDir();
 }
 
+TEST_F(ExternalSSTFileBasicTest, AddBatch) {
+  Options options = CurrentOptions();
+
+  SstFileWriter sst_file_writer(EnvOptions(), options);
+
+  // file1.sst (0 => 99), written in two batches
+  std::string file1 = sst_files_dir_ + "file1.sst";
+  ASSERT_OK(sst_file_writer.Open(file1));
+  std::vector<std::string> keys;
+  std::vector<std::string> vals;
+  for (int k = 0; k < 100; k++) {
+    keys.push_back(Key(k));
+    vals.push_back(Key(k) + "_val");
+  }
+  std::vector<std::pair<Slice, Slice>> batch;
+  for (int k = 0; k < 50; k++) {
+    batch.emplace_back(keys[k], vals[k]);
+  }
+  ASSERT_OK(sst_file_writer.AddBatch(batch));
+
+  // Misordered or overlapping batches must fail without adding anything
+  ASSERT_NOK(sst_file_writer.AddBatch(batch));
+  ASSERT_NOK(sst_file_writer.AddBatch(
+      {{keys[60], vals[60]}, {keys[55], vals[55]}}));
+
+  batch.clear();
+  for (int k = 50; k < 100; k++) {
+    batch.emplace_back(keys[k], vals[k]);
+  }
+  ASSERT_OK(sst_file_writer.AddBatch(batch));
+
+  ExternalSstFileInfo file1_info;
+  Status s = sst_file_writer.Finish(&file1_info);
+  ASSERT_OK(s) << s.ToString();
+  ASSERT_EQ(file1_info.num_entries, 100);
+  ASSERT_EQ(file1_info.smallest_key, Key(0));
+  ASSERT_EQ(file1_info.largest_key, Key(99));
+
+  DestroyAndReopen(options);
+  ASSERT_OK(db_->IngestExternalFile({file1}, IngestExternalFileOptions()));
+  for (int k = 0; k < 100; k++) {
+    ASSERT_EQ(Get(Key(k)), Key(k) + "_val");
+  }
+
+  DestroyAndRecreateExternalSSTFilesDir();
+}
+
 class ChecksumVerifyHelper {
  private:
   Options options_;
@@ -49,14 +49,46 @@ Status ExternalSstFileIngestionJob::Prepare(
     SuperVersion* sv) {
   Status status;
 
-  // Read the information of files we are ingesting
-  for (const std::string& file_path : external_files_paths) {
-    IngestedFileInfo file_to_ingest;
-    status =
-        GetIngestedFileInfo(file_path, next_file_number++, &file_to_ingest, sv);
-    if (!status.ok()) {
-      return status;
+  // Read the information of files we are ingesting. The per-file work reads
+  // out the table properties, probes the key bounds and (with
+  // verify_checksums_before_ingest) re-reads the whole file to verify block
+  // checksums; it is independent across files, so fan it out across threads
+  // the same way table-cache loading does on recovery. Note that all of this
+  // happens before writes are stopped; only seqno assignment and the version
+  // edit are done in the write-stop window.
+  const size_t num_external_files = external_files_paths.size();
+  files_to_ingest_.resize(num_external_files);
+  std::vector<Status> statuses(num_external_files);
+  {
+    std::atomic<size_t> next_file_idx(0);
+    auto load_file_info_func = [&]() {
+      while (true) {
+        size_t file_idx = next_file_idx.fetch_add(1);
+        if (file_idx >= num_external_files) {
+          break;
+        }
+        statuses[file_idx] = GetIngestedFileInfo(
+            external_files_paths[file_idx], next_file_number + file_idx,
+            &files_to_ingest_[file_idx], sv);
+      }
+    };
+    const size_t max_threads =
+        static_cast<size_t>(std::max(db_options_.max_file_opening_threads, 1));
+    const size_t num_threads = std::min(max_threads, num_external_files);
+    std::vector<port::Thread> threads;
+    for (size_t i = 1; i < num_threads; i++) {
+      threads.emplace_back(load_file_info_func);
     }
+    load_file_info_func();
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+  for (size_t i = 0; i < num_external_files; i++) {
+    if (!statuses[i].ok()) {
+      return statuses[i];
+    }
+    const IngestedFileInfo& file_to_ingest = files_to_ingest_[i];
 
     if (file_to_ingest.cf_id !=
             TablePropertiesCollectorFactory::Context::kUnknownColumnFamily &&
@@ -74,8 +106,6 @@ Status ExternalSstFileIngestionJob::Prepare(
         !file_to_ingest.largest_internal_key.Valid()) {
       return Status::Corruption("Generated table have corrupted keys");
     }
-
-    files_to_ingest_.emplace_back(std::move(file_to_ingest));
   }
 
   const Comparator* ucmp = cfd_->internal_comparator().user_comparator();
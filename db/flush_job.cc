@@ -59,6 +59,7 @@
 #include "test_util/sync_point.h"
 #include "util/coding.h"
 #include "util/mutexlock.h"
+#include "util/random.h"
 #include "util/stop_watch.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -658,6 +659,25 @@ bool FlushJob::MemPurgeDecider(double threshold) {
   if (threshold > (1.0 * mems_.size())) {
     return true;
   }
+  // Adaptive per-CF trigger: once a few deciders have observed this CF,
+  // skip the sampling pass below when the smoothed overwrite ratio is
+  // decisively on one side of the threshold. The sampled decision
+  // approximates (1 - garbage_ratio) < threshold, so a margin is kept
+  // around the threshold, and one decision in eight still samples so the
+  // smoothed ratio keeps tracking workload changes.
+  constexpr uint32_t kMinGarbageObservations = 3;
+  constexpr double kGarbageRatioMargin = 0.1;
+  if (cfd_->GetMempurgeGarbageObservations() >= kMinGarbageObservations &&
+      (Random::GetTLSInstance()->Next() % 8) != 0) {
+    const double useful_ratio =
+        1.0 - (cfd_->GetMempurgeGarbagePercent() / 100.0);
+    if (useful_ratio < threshold - kGarbageRatioMargin) {
+      return true;
+    }
+    if (useful_ratio > threshold + kGarbageRatioMargin) {
+      return false;
+    }
+  }
   // Payload and useful_payload (in bytes).
   // The useful payload ratio of a given MemTable
   // is estimated to be useful_payload/payload.
@@ -814,6 +834,11 @@ bool FlushJob::MemPurgeDecider(double threshold) {
                      sentries.size());
     }
   }
+  if (payload > 0) {
+    // Feed the adaptive per-CF trigger above.
+    cfd_->UpdateMempurgeGarbagePercent(static_cast<uint32_t>(
+        100.0 * (payload - useful_payload) / payload));
+  }
   // We convert the total number of useful payload bytes
   // into the proportion of memtable necessary to store all these bytes.
   // We compare this proportion with the threshold value.
@@ -954,7 +979,8 @@ Status FlushJob::WriteLevel0Table() {
           BlobFileCreationReason::kFlush, seqno_to_time_mapping_, event_logger_,
           job_context_->job_id, io_priority, &table_properties_, write_hint,
           full_history_ts_low, blob_callback_, base_, &num_input_entries,
-          &memtable_payload_bytes, &memtable_garbage_bytes);
+          &memtable_payload_bytes, &memtable_garbage_bytes,
+          cfd_->blob_value_size_histogram());
       // TODO: Cleanup io_status in BuildTable and table builders
       assert(!s.ok() || io_s.ok());
       io_s.PermitUncheckedError();
@@ -155,6 +155,11 @@ class ForwardLevelIterator : public InternalIterator {
         return;
       }
       file_iter_->SeekToFirst();
+      if (file_iter_->status().IsTryAgain()) {
+        // No caller retries an asynchronous seek from inside Next();
+        // complete the requested block read right away.
+        file_iter_->SeekToFirst();
+      }
     }
   }
   Slice key() const override {
@@ -272,6 +272,8 @@ static const std::string fast_block_cache_entry_stats =
 static const std::string block_cache_cf_stats = "block-cache-cf-stats";
 static const std::string fast_block_cache_cf_stats =
     "fast-block-cache-cf-stats";
+static const std::string row_cache_admission_stats =
+    "row-cache-admission-stats";
 static const std::string num_immutable_mem_table = "num-immutable-mem-table";
 static const std::string num_immutable_mem_table_flushed =
     "num-immutable-mem-table-flushed";
@@ -317,6 +319,7 @@ static const std::string aggregated_table_properties =
 static const std::string aggregated_table_properties_at_level =
     aggregated_table_properties + "-at-level";
 static const std::string num_running_compactions = "num-running-compactions";
+static const std::string compact_range_progress = "compact-range-progress";
 static const std::string num_running_flushes = "num-running-flushes";
 static const std::string actual_delayed_write_rate =
     "actual-delayed-write-rate";
@@ -361,6 +364,8 @@ const std::string DB::Properties::kBlockCacheCfStats =
     rocksdb_prefix + block_cache_cf_stats;
 const std::string DB::Properties::kFastBlockCacheCfStats =
     rocksdb_prefix + fast_block_cache_cf_stats;
+const std::string DB::Properties::kRowCacheAdmissionStats =
+    rocksdb_prefix + row_cache_admission_stats;
 const std::string DB::Properties::kNumImmutableMemTable =
     rocksdb_prefix + num_immutable_mem_table;
 const std::string DB::Properties::kNumImmutableMemTableFlushed =
@@ -371,6 +376,8 @@ const std::string DB::Properties::kCompactionPending =
     rocksdb_prefix + compaction_pending;
 const std::string DB::Properties::kNumRunningCompactions =
     rocksdb_prefix + num_running_compactions;
+const std::string DB::Properties::kCompactRangeProgress =
+    rocksdb_prefix + compact_range_progress;
 const std::string DB::Properties::kNumRunningFlushes =
     rocksdb_prefix + num_running_flushes;
 const std::string DB::Properties::kBackgroundErrors =
@@ -503,6 +510,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kFastBlockCacheCfStats,
          {true, &InternalStats::HandleFastBlockCacheCfStats, nullptr,
           &InternalStats::HandleFastBlockCacheCfStatsMap, nullptr}},
+        {DB::Properties::kRowCacheAdmissionStats,
+         {false, &InternalStats::HandleRowCacheAdmissionStats, nullptr,
+          nullptr, nullptr}},
         {DB::Properties::kSSTables,
          {false, &InternalStats::HandleSsTables, nullptr, nullptr, nullptr}},
         {DB::Properties::kAggregatedTableProperties,
@@ -601,6 +611,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kNumRunningCompactions,
          {false, nullptr, &InternalStats::HandleNumRunningCompactions, nullptr,
           nullptr}},
+        {DB::Properties::kCompactRangeProgress,
+         {false, &InternalStats::HandleCompactRangeProgress, nullptr, nullptr,
+          nullptr}},
         {DB::Properties::kActualDelayedWriteRate,
          {false, nullptr, &InternalStats::HandleActualDelayedWriteRate, nullptr,
           nullptr}},
@@ -931,6 +944,12 @@ bool InternalStats::HandleFastBlockCacheCfStatsMap(
   return HandleBlockCacheCfStatsMapInternal(values, true /* fast */);
 }
 
+bool InternalStats::HandleRowCacheAdmissionStats(std::string* value,
+                                                 Slice /*suffix*/) {
+  // Unsupported (returns false) when the row cache is not enabled.
+  return cfd_->table_cache()->GetRowCacheAdmissionStats(value);
+}
+
 bool InternalStats::HandleLiveSstFilesSizeAtTemperature(std::string* value,
                                                         Slice suffix) {
   uint64_t temperature;
@@ -1238,6 +1257,33 @@ bool InternalStats::HandleCFWriteStallStatsMap(
   return true;
 }
 
+bool InternalStats::HandleCompactRangeProgress(std::string* value,
+                                               Slice /*suffix*/) {
+  const bool in_progress =
+      compact_range_in_progress_.load(std::memory_order_relaxed);
+  const uint64_t total =
+      compact_range_bytes_total_.load(std::memory_order_relaxed);
+  const uint64_t compacted =
+      compact_range_bytes_compacted_.load(std::memory_order_relaxed);
+  if (!in_progress) {
+    *value = "no manual compaction in progress";
+    return true;
+  }
+  // The total is an estimate taken when the manual compaction started;
+  // compacted bytes may end up exceeding it, e.g. when writes land in the
+  // range while the compaction runs.
+  const double pct =
+      total > 0 ? (100.0 * static_cast<double>(std::min(compacted, total)) /
+                   static_cast<double>(total))
+                : 100.0;
+  char buf[100];
+  snprintf(buf, sizeof(buf),
+           "%" PRIu64 " of %" PRIu64 " estimated input bytes (%.1f%%)",
+           compacted, total, pct);
+  *value = buf;
+  return true;
+}
+
 bool InternalStats::HandleDBMapStats(
     std::map<std::string, std::string>* db_stats, Slice /*suffix*/) {
   DumpDBMapStats(db_stats);
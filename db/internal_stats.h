@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -574,6 +575,10 @@ class InternalStats {
     ++cf_stats_count_[type];
   }
 
+  uint64_t GetCFStatsCount(InternalCFStatsType type) const {
+    return cf_stats_count_[type];
+  }
+
   void AddDBStats(InternalDBStatsType type, uint64_t value,
                   bool concurrent = false) {
     auto& v = db_stats_[type];
@@ -599,6 +604,25 @@ class InternalStats {
 
   uint64_t BumpAndGetBackgroundErrorCount() { return ++bg_error_count_; }
 
+  // Progress tracking for a manual (CompactRange) compaction on this column
+  // family, reported through the "rocksdb.compact-range-progress" property.
+  // `total_bytes` is the estimated total input; compacted bytes are added as
+  // each scheduled compaction of the manual compaction completes.
+  void StartCompactRangeProgress(uint64_t total_bytes) {
+    compact_range_bytes_compacted_.store(0, std::memory_order_relaxed);
+    compact_range_bytes_total_.store(total_bytes, std::memory_order_relaxed);
+    compact_range_in_progress_.store(true, std::memory_order_relaxed);
+  }
+
+  void AddCompactRangeProgress(uint64_t compacted_bytes) {
+    compact_range_bytes_compacted_.fetch_add(compacted_bytes,
+                                             std::memory_order_relaxed);
+  }
+
+  void FinishCompactRangeProgress() {
+    compact_range_in_progress_.store(false, std::memory_order_relaxed);
+  }
+
   bool GetStringProperty(const DBPropertyInfo& property_info,
                          const Slice& property, std::string* value);
 
@@ -792,6 +816,7 @@ class InternalStats {
   bool HandleCFFileHistogram(std::string* value, Slice suffix);
   bool HandleCFStatsPeriodic(std::string* value, Slice suffix);
   bool HandleCFWriteStallStats(std::string* value, Slice suffix);
+  bool HandleCompactRangeProgress(std::string* value, Slice suffix);
   bool HandleCFWriteStallStatsMap(std::map<std::string, std::string>* values,
                                   Slice suffix);
   bool HandleDBMapStats(std::map<std::string, std::string>* compaction_stats,
@@ -867,6 +892,7 @@ class InternalStats {
   bool HandleBlockCacheEntryStats(std::string* value, Slice suffix);
   bool HandleBlockCacheEntryStatsMap(std::map<std::string, std::string>* values,
                                      Slice suffix);
+  bool HandleRowCacheAdmissionStats(std::string* value, Slice suffix);
   bool HandleFastBlockCacheEntryStats(std::string* value, Slice suffix);
   bool HandleFastBlockCacheEntryStatsMap(
       std::map<std::string, std::string>* values, Slice suffix);
@@ -898,6 +924,13 @@ class InternalStats {
   // or compaction will cause the counter to increase too.
   uint64_t bg_error_count_;
 
+  // Progress of the manual (CompactRange) compaction currently running on
+  // this column family, if any. Updated by DBImpl under the db mutex but
+  // read by the property handler without it, hence atomics.
+  std::atomic<bool> compact_range_in_progress_{false};
+  std::atomic<uint64_t> compact_range_bytes_total_{0};
+  std::atomic<uint64_t> compact_range_bytes_compacted_{0};
+
   const int number_levels_;
   SystemClock* clock_;
   ColumnFamilyData* cfd_;
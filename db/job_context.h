@@ -63,18 +63,23 @@ struct SuperVersionContext {
   void PushWriteStallNotification(WriteStallCondition old_cond,
                                   WriteStallCondition new_cond,
                                   const std::string& name,
+                                  WriteStallCause cause, uint64_t trigger_value,
                                   const ImmutableOptions* ioptions) {
 #if !defined(ROCKSDB_DISABLE_STALL_NOTIFICATION)
     WriteStallNotification notif;
     notif.write_stall_info.cf_name = name;
     notif.write_stall_info.condition.prev = old_cond;
     notif.write_stall_info.condition.cur = new_cond;
+    notif.write_stall_info.cause = cause;
+    notif.write_stall_info.trigger_value = trigger_value;
     notif.immutable_options = ioptions;
     write_stall_notifications.push_back(notif);
 #else
     (void)old_cond;
     (void)new_cond;
     (void)name;
+    (void)cause;
+    (void)trigger_value;
     (void)ioptions;
 #endif  // !defined(ROCKSDB_DISABLE_STALL_NOTIFICATION)
   }
@@ -35,8 +35,15 @@ enum RecordType {
 
   // Compression Type
   kSetCompressionType = 9,
+
+  // Metadata record carrying the column family ids (as varint32s) touched by
+  // the next logical record, so recovery can skip fully-flushed batches
+  // without parsing their contents. Optional; written only when
+  // DBOptions::wal_tag_column_family_ids is set.
+  kColumnFamilyIdsType = 10,
+  kRecyclableColumnFamilyIdsType = 11,
 };
-static const int kMaxRecordType = kSetCompressionType;
+static const int kMaxRecordType = kRecyclableColumnFamilyIdsType;
 
 static const unsigned int kBlockSize = 32768;
 
@@ -71,6 +71,7 @@ bool Reader::ReadRecord(Slice* record, std::string* scratch,
                         uint64_t* record_checksum) {
   scratch->clear();
   record->clear();
+  record_cf_ids_.clear();
   if (record_checksum != nullptr) {
     if (hash_state_ == nullptr) {
       hash_state_ = XXH3_createState();
@@ -108,6 +109,8 @@ bool Reader::ReadRecord(Slice* record, std::string* scratch,
           // No need to stream since the record is a single fragment
           *record_checksum = XXH3_64bits(fragment.data(), fragment.size());
         }
+        record_cf_ids_ = std::move(pending_cf_ids_);
+        pending_cf_ids_.clear();
         prospective_record_offset = physical_record_offset;
         scratch->clear();
         *record = fragment;
@@ -128,6 +131,8 @@ bool Reader::ReadRecord(Slice* record, std::string* scratch,
         if (record_checksum != nullptr) {
           XXH3_64bits_update(hash_state_, fragment.data(), fragment.size());
         }
+        record_cf_ids_ = std::move(pending_cf_ids_);
+        pending_cf_ids_.clear();
         prospective_record_offset = physical_record_offset;
         scratch->assign(fragment.data(), fragment.size());
         in_fragmented_record = true;
@@ -280,6 +285,20 @@ bool Reader::ReadRecord(Slice* record, std::string* scratch,
         break;
       }
 
+      case kColumnFamilyIdsType:
+      case kRecyclableColumnFamilyIdsType: {
+        if (in_fragmented_record) {
+          ReportCorruption(scratch->size(),
+                           "column family ids record in fragmented record");
+          in_fragmented_record = false;
+          scratch->clear();
+        }
+        // Applies to the next logical record; promoted when its first
+        // fragment is read.
+        pending_cf_ids_.assign(fragment.data(), fragment.size());
+        break;
+      }
+
       default: {
         char buf[40];
         snprintf(buf, sizeof(buf), "unknown record type %u", record_type);
@@ -444,7 +463,8 @@ unsigned int Reader::ReadPhysicalRecord(Slice* result, size_t* drop_size,
     const unsigned int type = header[6];
     const uint32_t length = a | (b << 8);
     int header_size = kHeaderSize;
-    if (type >= kRecyclableFullType && type <= kRecyclableLastType) {
+    if ((type >= kRecyclableFullType && type <= kRecyclableLastType) ||
+        type == kRecyclableColumnFamilyIdsType) {
       if (end_of_buffer_offset_ - buffer_.size() == 0) {
         recycled_ = true;
       }
@@ -500,7 +520,9 @@ unsigned int Reader::ReadPhysicalRecord(Slice* result, size_t* drop_size,
 
     buffer_.remove_prefix(header_size + length);
 
-    if (!uncompress_ || type == kSetCompressionType) {
+    if (!uncompress_ || type == kSetCompressionType ||
+        type == kColumnFamilyIdsType ||
+        type == kRecyclableColumnFamilyIdsType) {
       *result = Slice(header + header_size, length);
       return type;
     } else {
@@ -591,6 +613,8 @@ bool FragmentBufferedReader::ReadRecord(Slice* record, std::string* scratch,
           ReportCorruption(fragments_.size(), "partial record without end(1)");
         }
         fragments_.clear();
+        record_cf_ids_ = std::move(pending_cf_ids_);
+        pending_cf_ids_.clear();
         *record = fragment;
         prospective_record_offset = physical_record_offset;
         last_record_offset_ = prospective_record_offset;
@@ -603,6 +627,8 @@ bool FragmentBufferedReader::ReadRecord(Slice* record, std::string* scratch,
         if (in_fragmented_record_ || !fragments_.empty()) {
           ReportCorruption(fragments_.size(), "partial record without end(2)");
         }
+        record_cf_ids_ = std::move(pending_cf_ids_);
+        pending_cf_ids_.clear();
         prospective_record_offset = physical_record_offset;
         fragments_.assign(fragment.data(), fragment.size());
         in_fragmented_record_ = true;
@@ -683,6 +709,20 @@ bool FragmentBufferedReader::ReadRecord(Slice* record, std::string* scratch,
         break;
       }
 
+      case kColumnFamilyIdsType:
+      case kRecyclableColumnFamilyIdsType: {
+        if (in_fragmented_record_) {
+          ReportCorruption(fragments_.size(),
+                           "column family ids record in fragmented record");
+          in_fragmented_record_ = false;
+          fragments_.clear();
+        }
+        // Applies to the next logical record; promoted when its first
+        // fragment is read.
+        pending_cf_ids_.assign(fragment.data(), fragment.size());
+        break;
+      }
+
       default: {
         char buf[40];
         snprintf(buf, sizeof(buf), "unknown record type %u",
@@ -770,7 +810,8 @@ bool FragmentBufferedReader::TryReadFragment(
   const unsigned int type = header[6];
   const uint32_t length = a | (b << 8);
   int header_size = kHeaderSize;
-  if (type >= kRecyclableFullType && type <= kRecyclableLastType) {
+  if ((type >= kRecyclableFullType && type <= kRecyclableLastType) ||
+      type == kRecyclableColumnFamilyIdsType) {
     if (end_of_buffer_offset_ - buffer_.size() == 0) {
       recycled_ = true;
     }
@@ -822,7 +863,9 @@ bool FragmentBufferedReader::TryReadFragment(
 
   buffer_.remove_prefix(header_size + length);
 
-  if (!uncompress_ || type == kSetCompressionType) {
+  if (!uncompress_ || type == kSetCompressionType ||
+        type == kColumnFamilyIdsType ||
+        type == kRecyclableColumnFamilyIdsType) {
     *fragment = Slice(header + header_size, length);
     *fragment_type_or_err = type;
     return true;
@@ -111,6 +111,14 @@ class Reader {
     return !first_record_read_ && compression_type_record_read_;
   }
 
+  // Raw varint32-encoded column family ids from the kColumnFamilyIdsType
+  // metadata record preceding the last record returned by ReadRecord(), or
+  // empty if that record was not tagged (see
+  // DBOptions::wal_tag_column_family_ids).
+  const std::string& GetRecordColumnFamilyIds() const {
+    return record_cf_ids_;
+  }
+
  protected:
   std::shared_ptr<Logger> info_log_;
   const std::unique_ptr<SequentialFileReader> file_;
@@ -153,6 +161,11 @@ class Reader {
   XXH3_state_t* hash_state_;
   // Used for stream hashing uncompressed buffer in ReadPhysicalRecord()
   XXH3_state_t* uncompress_hash_state_;
+  // Column family ids stashed from a kColumnFamilyIdsType record, promoted
+  // to record_cf_ids_ when the first fragment of the record they announce is
+  // read; see GetRecordColumnFamilyIds().
+  std::string pending_cf_ids_;
+  std::string record_cf_ids_;
 
   // Extend record types with the following special values
   enum {
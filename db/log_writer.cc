@@ -172,6 +172,105 @@ IOStatus Writer::AddRecord(const Slice& slice,
   return s;
 }
 
+IOStatus Writer::CompressRecord(CompressionType compression_type,
+                                const Slice& record,
+                                std::string* compressed_out) {
+  assert(compression_type != kNoCompression);
+  compressed_out->clear();
+  // Mirror the context parameters set up in AddCompressionTypeRecord() so
+  // that the output decompresses exactly like an inline-compressed record.
+  const size_t max_output_buffer_len = kBlockSize - kHeaderSize;
+  CompressionOptions opts;
+  constexpr uint32_t compression_format_version = 2;
+  std::unique_ptr<StreamingCompress> compress(StreamingCompress::Create(
+      compression_type, opts, compression_format_version,
+      max_output_buffer_len));
+  if (compress == nullptr) {
+    return IOStatus::NotSupported("WAL compression type is not supported");
+  }
+  std::unique_ptr<char[]> buffer(new char[max_output_buffer_len]);
+  compress->Reset();
+  int compress_remaining;
+  do {
+    size_t output_pos = 0;
+    compress_remaining = compress->Compress(record.data(), record.size(),
+                                            buffer.get(), &output_pos);
+    if (compress_remaining < 0) {
+      IOStatus s = IOStatus::IOError("Unexpected WAL compression error");
+      s.SetDataLoss(true);
+      return s;
+    }
+    compressed_out->append(buffer.get(), output_pos);
+  } while (compress_remaining > 0);
+  return IOStatus::OK();
+}
+
+IOStatus Writer::AddPrecompressedRecord(const Slice& slice,
+                                        Env::IOPriority rate_limiter_priority) {
+  // The payload was produced by CompressRecord(); fragment it on block
+  // boundaries exactly like AddRecord() fragments its compressed chunks,
+  // but without running the compressor on the writing thread.
+  assert(compress_ != nullptr);
+  const char* ptr = slice.data();
+  size_t left = slice.size();
+
+  const int header_size =
+      recycle_log_files_ ? kRecyclableHeaderSize : kHeaderSize;
+
+  IOStatus s;
+  bool begin = true;
+  do {
+    const int64_t leftover = kBlockSize - block_offset_;
+    assert(leftover >= 0);
+    if (leftover < header_size) {
+      // Switch to a new block
+      if (leftover > 0) {
+        // Fill the trailer (literal below relies on kHeaderSize and
+        // kRecyclableHeaderSize being <= 11)
+        assert(header_size <= 11);
+        s = dest_->Append(Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+                                static_cast<size_t>(leftover)),
+                          0 /* crc32c_checksum */, rate_limiter_priority);
+        if (!s.ok()) {
+          break;
+        }
+      }
+      block_offset_ = 0;
+    }
+
+    // Invariant: we never leave < header_size bytes in a block.
+    assert(static_cast<int64_t>(kBlockSize - block_offset_) >= header_size);
+
+    const size_t avail = kBlockSize - block_offset_ - header_size;
+    const size_t fragment_length = (left < avail) ? left : avail;
+
+    RecordType type;
+    const bool end = (left == fragment_length);
+    if (begin && end) {
+      type = recycle_log_files_ ? kRecyclableFullType : kFullType;
+    } else if (begin) {
+      type = recycle_log_files_ ? kRecyclableFirstType : kFirstType;
+    } else if (end) {
+      type = recycle_log_files_ ? kRecyclableLastType : kLastType;
+    } else {
+      type = recycle_log_files_ ? kRecyclableMiddleType : kMiddleType;
+    }
+
+    s = EmitPhysicalRecord(type, ptr, fragment_length, rate_limiter_priority);
+    ptr += fragment_length;
+    left -= fragment_length;
+    begin = false;
+  } while (s.ok() && left > 0);
+
+  if (s.ok()) {
+    if (!manual_flush_) {
+      s = dest_->Flush(rate_limiter_priority);
+    }
+  }
+
+  return s;
+}
+
 IOStatus Writer::AddRecordWithStartOffsetAndSize(
     const Slice& slice, Env::IOPriority rate_limiter_priority, bool do_flush,
     uint64_t* offset, uint64_t* size) {
@@ -229,6 +328,58 @@ IOStatus Writer::AddCompressionTypeRecord() {
   return s;
 }
 
+IOStatus Writer::AddColumnFamilyIdsRecord(
+    const std::vector<uint32_t>& cf_ids,
+    Env::IOPriority rate_limiter_priority) {
+  if (cf_ids.empty()) {
+    return IOStatus::OK();
+  }
+
+  std::string encode;
+  for (uint32_t cf_id : cf_ids) {
+    PutVarint32(&encode, cf_id);
+  }
+
+  const int header_size =
+      recycle_log_files_ ? kRecyclableHeaderSize : kHeaderSize;
+  if (encode.size() > kBlockSize - header_size) {
+    // Too many column families to describe in one physical record; recovery
+    // will simply parse the following record as usual.
+    return IOStatus::OK();
+  }
+
+  int64_t leftover = kBlockSize - block_offset_;
+  assert(leftover >= 0);
+  if (leftover < header_size) {
+    // Not even a header fits; fill the trailer and switch to a new block,
+    // the same way AddRecord() does (literal relies on kHeaderSize and
+    // kRecyclableHeaderSize being <= 11).
+    if (leftover > 0) {
+      assert(header_size <= 11);
+      IOStatus s =
+          dest_->Append(Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+                              static_cast<size_t>(leftover)),
+                        0 /* crc32c_checksum */, rate_limiter_priority);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    block_offset_ = 0;
+    leftover = kBlockSize;
+  }
+  if (static_cast<size_t>(leftover) < header_size + encode.size()) {
+    // The metadata record is never fragmented. Rather than padding out a
+    // potentially large chunk of the block, drop the optional tag; recovery
+    // will parse the following record as usual.
+    return IOStatus::OK();
+  }
+
+  return EmitPhysicalRecord(
+      recycle_log_files_ ? kRecyclableColumnFamilyIdsType
+                         : kColumnFamilyIdsType,
+      encode.data(), encode.size(), rate_limiter_priority);
+}
+
 bool Writer::BufferIsEmpty() { return dest_->BufferIsEmpty(); }
 
 IOStatus Writer::EmitPhysicalRecord(RecordType t, const char* ptr, size_t n,
@@ -244,7 +395,8 @@ IOStatus Writer::EmitPhysicalRecord(RecordType t, const char* ptr, size_t n,
   buf[6] = static_cast<char>(t);
 
   uint32_t crc = type_crc_[t];
-  if (t < kRecyclableFullType || t == kSetCompressionType) {
+  if (t < kRecyclableFullType || t == kSetCompressionType ||
+      t == kColumnFamilyIdsType) {
     // Legacy record format
     assert(block_offset_ + kHeaderSize + n <= kBlockSize);
     header_size = kHeaderSize;
@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "db/log_format.h"
 #include "rocksdb/compression_type.h"
@@ -105,9 +106,35 @@ class Writer {
       bool do_flush = true, uint64_t* offset = nullptr,
       uint64_t* size = nullptr);
 
+  // Compress a whole record payload with the same streaming context
+  // parameters AddRecord() uses, without touching the file or block state.
+  // Callers may run this off the serialized WAL submission path and later
+  // append the result, in WAL order, with AddPrecompressedRecord().
+  static IOStatus CompressRecord(CompressionType compression_type,
+                                 const Slice& record,
+                                 std::string* compressed_out);
+
+  // Append a record whose payload was already compressed by CompressRecord().
+  // Requires compression_enabled(); emits the same physical record fragments
+  // AddRecord() would have produced for the uncompressed payload.
+  IOStatus AddPrecompressedRecord(
+      const Slice& slice, Env::IOPriority rate_limiter_priority = Env::IO_TOTAL);
+
+  // Emit a kColumnFamilyIdsType metadata record announcing the column
+  // families the next AddRecord() payload touches, so recovery can skip the
+  // record without parsing it when they are all flushed. Must be called
+  // immediately before the record it describes, under the same
+  // serialization. A no-op when cf_ids is empty or too large for one block.
+  IOStatus AddColumnFamilyIdsRecord(
+      const std::vector<uint32_t>& cf_ids,
+      Env::IOPriority rate_limiter_priority = Env::IO_TOTAL);
+
   IOStatus SyncRange(bool use_fsync, uint64_t offset, uint64_t size);
   IOStatus AddCompressionTypeRecord();
 
+  // True once AddCompressionTypeRecord() has enabled payload compression.
+  bool compression_enabled() const { return compress_ != nullptr; }
+
   WritableFileWriter* file() { return dest_.get(); }
   const WritableFileWriter* file() const { return dest_.get(); }
 
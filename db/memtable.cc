@@ -39,6 +39,7 @@
 #include "logging/logging.h"
 #include "memory/arena.h"
 #include "memory/memory_usage.h"
+#include "monitoring/cycle_profiler.h"
 #include "monitoring/perf_context_imp.h"
 #include "monitoring/statistics.h"
 #include "port/lang.h"
@@ -351,6 +352,10 @@ int MemTable::KeyComparator::operator()(
   return comparator.CompareKeySeq(a, key);
 }
 
+bool MemTable::KeyComparator::IsForwardBytewise() const {
+  return comparator.user_comparator() == BytewiseComparator();
+}
+
 void MemTableRep::InsertConcurrently(KeyHandle /*handle*/) {
   throw std::runtime_error("concurrent insert not supported");
 }
@@ -593,7 +598,10 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIteratorInternal(
   std::shared_ptr<FragmentedRangeTombstoneListCache> cache =
       std::atomic_load_explicit(cached_range_tombstone_.Access(),
                                 std::memory_order_relaxed);
-  // construct fragmented tombstone list if necessary
+  // Construct the fragmented tombstone list if necessary. This happens at
+  // most once per DeleteRange() since MemTable::Add() swaps a new cache into
+  // every core slot for each range tombstone written; until the next
+  // DeleteRange(), all readers share the list built here.
   if (!cache->initialized.load(std::memory_order_acquire)) {
     cache->reader_mutex.lock();
     if (!cache->tombstones) {
@@ -914,6 +922,9 @@ struct Saver {
   Statistics* statistics;
   bool inplace_update_support;
   bool do_merge;
+  // Only relevant when do_merge is false (GetMergeOperands): stop collecting
+  // operands once the merge operator's ShouldMerge() is satisfied.
+  bool stop_when_should_merge;
   SystemClock* clock;
 
   ReadCallback* callback_;
@@ -1250,9 +1261,10 @@ static bool SaveValue(void* arg, const char* entry) {
             v, s->inplace_update_support == false /* operand_pinned */);
         PERF_COUNTER_ADD(internal_merge_point_lookup_count, 1);
 
-        if (s->do_merge && merge_operator->ShouldMerge(
-                               merge_context->GetOperandsDirectionBackward())) {
-          if (s->value || s->columns) {
+        if ((s->do_merge || s->stop_when_should_merge) &&
+            merge_operator->ShouldMerge(
+                merge_context->GetOperandsDirectionBackward())) {
+          if (s->do_merge && (s->value || s->columns)) {
             std::string result;
             // `op_failure_scope` (an output parameter) is not provided (set to
             // nullptr) since a failure must be propagated regardless of its
@@ -1304,12 +1316,14 @@ bool MemTable::Get(const LookupKey& key, std::string* value,
                    SequenceNumber* max_covering_tombstone_seq,
                    SequenceNumber* seq, const ReadOptions& read_opts,
                    bool immutable_memtable, ReadCallback* callback,
-                   bool* is_blob_index, bool do_merge) {
+                   bool* is_blob_index, bool do_merge,
+                   bool stop_when_should_merge) {
   // The sequence number is updated synchronously in version_set.h
   if (IsEmpty()) {
     // Avoiding recording stats for speed.
     return false;
   }
+  CYCLE_PROFILE_GUARD(kCycleStageMemtableGet);
   PERF_TIMER_GUARD(get_from_memtable_time);
 
   std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
@@ -1360,9 +1374,10 @@ bool MemTable::Get(const LookupKey& key, std::string* value,
     if (bloom_checked) {
       PERF_COUNTER_ADD(bloom_memtable_hit_count, 1);
     }
-    GetFromTable(key, *max_covering_tombstone_seq, do_merge, callback,
-                 is_blob_index, value, columns, timestamp, s, merge_context,
-                 seq, &found_final_value, &merge_in_progress);
+    GetFromTable(key, *max_covering_tombstone_seq, do_merge,
+                 stop_when_should_merge, callback, is_blob_index, value,
+                 columns, timestamp, s, merge_context, seq, &found_final_value,
+                 &merge_in_progress);
   }
 
   // No change to value, since we have not yet found a Put/Delete
@@ -1376,9 +1391,9 @@ bool MemTable::Get(const LookupKey& key, std::string* value,
 
 void MemTable::GetFromTable(const LookupKey& key,
                             SequenceNumber max_covering_tombstone_seq,
-                            bool do_merge, ReadCallback* callback,
-                            bool* is_blob_index, std::string* value,
-                            PinnableWideColumns* columns,
+                            bool do_merge, bool stop_when_should_merge,
+                            ReadCallback* callback, bool* is_blob_index,
+                            std::string* value, PinnableWideColumns* columns,
                             std::string* timestamp, Status* s,
                             MergeContext* merge_context, SequenceNumber* seq,
                             bool* found_final_value, bool* merge_in_progress) {
@@ -1402,6 +1417,7 @@ void MemTable::GetFromTable(const LookupKey& key,
   saver.callback_ = callback;
   saver.is_blob_index = is_blob_index;
   saver.do_merge = do_merge;
+  saver.stop_when_should_merge = stop_when_should_merge;
   saver.allow_data_in_errors = moptions_.allow_data_in_errors;
   saver.protection_bytes_per_key = moptions_.protection_bytes_per_key;
   table_->Get(key, &saver, SaveValue);
@@ -1472,7 +1488,8 @@ void MemTable::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
     }
     SequenceNumber dummy_seq;
     GetFromTable(*(iter->lkey), iter->max_covering_tombstone_seq, true,
-                 callback, &iter->is_blob_index,
+                 false /* stop_when_should_merge */, callback,
+                 &iter->is_blob_index,
                  iter->value ? iter->value->GetSelf() : nullptr, iter->columns,
                  iter->timestamp, iter->s, &(iter->merge_context), &dummy_seq,
                  &found_final_value, &merge_in_progress);
@@ -107,6 +107,7 @@ class MemTable {
                            const char* prefix_len_key2) const override;
     virtual int operator()(const char* prefix_len_key,
                            const DecodedType& key) const override;
+    bool IsForwardBytewise() const override;
   };
 
   // MemTables are reference counted.  The initial reference count
@@ -278,7 +279,7 @@ class MemTable {
            SequenceNumber* max_covering_tombstone_seq, SequenceNumber* seq,
            const ReadOptions& read_opts, bool immutable_memtable,
            ReadCallback* callback = nullptr, bool* is_blob_index = nullptr,
-           bool do_merge = true);
+           bool do_merge = true, bool stop_when_should_merge = false);
 
   bool Get(const LookupKey& key, std::string* value,
            PinnableWideColumns* columns, std::string* timestamp, Status* s,
@@ -286,11 +287,11 @@ class MemTable {
            SequenceNumber* max_covering_tombstone_seq,
            const ReadOptions& read_opts, bool immutable_memtable,
            ReadCallback* callback = nullptr, bool* is_blob_index = nullptr,
-           bool do_merge = true) {
+           bool do_merge = true, bool stop_when_should_merge = false) {
     SequenceNumber seq;
     return Get(key, value, columns, timestamp, s, merge_context,
                max_covering_tombstone_seq, &seq, read_opts, immutable_memtable,
-               callback, is_blob_index, do_merge);
+               callback, is_blob_index, do_merge, stop_when_should_merge);
   }
 
   // @param immutable_memtable Whether this memtable is immutable. Used
@@ -493,6 +494,16 @@ class MemTable {
     return &moptions_;
   }
 
+  // The prefix (and/or whole key) bloom filter over this memtable's entries,
+  // or nullptr if not configured.
+  const DynamicBloom* GetBloomFilter() const { return bloom_filter_.get(); }
+
+  // Returns true if no range tombstone was ever written to this memtable.
+  // The result is stable once the memtable is immutable.
+  bool IsRangeDelTableEmpty() const {
+    return is_range_del_table_empty_.load(std::memory_order_relaxed);
+  }
+
   uint64_t ApproximateOldestKeyTime() const {
     return oldest_key_time_.load(std::memory_order_relaxed);
   }
@@ -655,10 +666,10 @@ class MemTable {
 
   void GetFromTable(const LookupKey& key,
                     SequenceNumber max_covering_tombstone_seq, bool do_merge,
-                    ReadCallback* callback, bool* is_blob_index,
-                    std::string* value, PinnableWideColumns* columns,
-                    std::string* timestamp, Status* s,
-                    MergeContext* merge_context, SequenceNumber* seq,
+                    bool stop_when_should_merge, ReadCallback* callback,
+                    bool* is_blob_index, std::string* value,
+                    PinnableWideColumns* columns, std::string* timestamp,
+                    Status* s, MergeContext* merge_context, SequenceNumber* seq,
                     bool* found_final_value, bool* merge_in_progress);
 
   // Always returns non-null and assumes certain pre-checks (e.g.,
@@ -678,6 +689,14 @@ class MemTable {
 
   // makes sure there is a single range tombstone writer to invalidate cache
   std::mutex range_del_mutex_;
+  // Per-core cache of the fragmented range tombstone list for the mutable
+  // memtable. Each DeleteRange() installs a fresh (empty) cache in every core
+  // slot, and the first reader after that re-fragments the range-del table
+  // once and publishes the result in the cache (see
+  // NewRangeTombstoneIteratorInternal()). All subsequent point lookups and
+  // scans share that snapshot via the per-core shared_ptr until the next
+  // DeleteRange(), so fragmentation cost is paid once per tombstone write,
+  // not per read.
   CoreLocalArray<std::shared_ptr<FragmentedRangeTombstoneListCache>>
       cached_range_tombstone_;
 
@@ -31,6 +31,7 @@
 #include "db/version_set.h"
 #include "logging/log_buffer.h"
 #include "logging/logging.h"
+#include "monitoring/perf_context_imp.h"
 #include "monitoring/thread_status_util.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
@@ -75,6 +76,8 @@ MemTableListVersion::MemTableListVersion(
   for (auto& m : memlist_history_) {
     m->Ref();
   }
+
+  RebuildAggregateFilter();
 }
 
 MemTableListVersion::MemTableListVersion(
@@ -125,6 +128,22 @@ bool MemTableListVersion::Get(const LookupKey& key, std::string* value,
                               SequenceNumber* max_covering_tombstone_seq,
                               SequenceNumber* seq, const ReadOptions& read_opts,
                               ReadCallback* callback, bool* is_blob_index) {
+  if (aggregate_filter_ != nullptr) {
+    assert(!memlist_.empty());
+    const size_t ts_sz = memlist_.front()
+                             ->GetInternalKeyComparator()
+                             .user_comparator()
+                             ->timestamp_size();
+    if (!aggregate_filter_->MayContain(
+            StripTimestampFromUserKey(key.user_key(), ts_sz))) {
+      // The key is in none of the memtables in memlist_: they all do
+      // whole-key filtering and none has range tombstones (see
+      // RebuildAggregateFilter()), so the whole list can be skipped.
+      PERF_COUNTER_ADD(bloom_memtable_miss_count, 1);
+      *seq = kMaxSequenceNumber;
+      return false;
+    }
+  }
   return GetFromList(&memlist_, key, value, columns, timestamp, s,
                      merge_context, max_covering_tombstone_seq, seq, read_opts,
                      callback, is_blob_index);
@@ -144,12 +163,14 @@ void MemTableListVersion::MultiGet(const ReadOptions& read_options,
 
 bool MemTableListVersion::GetMergeOperands(
     const LookupKey& key, Status* s, MergeContext* merge_context,
-    SequenceNumber* max_covering_tombstone_seq, const ReadOptions& read_opts) {
+    SequenceNumber* max_covering_tombstone_seq, const ReadOptions& read_opts,
+    bool stop_when_should_merge) {
   for (MemTable* memtable : memlist_) {
     bool done = memtable->Get(
         key, /*value=*/nullptr, /*columns=*/nullptr, /*timestamp=*/nullptr, s,
         merge_context, max_covering_tombstone_seq, read_opts,
-        true /* immutable_memtable */, nullptr, nullptr, false);
+        true /* immutable_memtable */, nullptr, nullptr, false,
+        stop_when_should_merge);
     if (done) {
       return true;
     }
@@ -313,6 +334,7 @@ SequenceNumber MemTableListVersion::GetFirstSequenceNumber() const {
 void MemTableListVersion::Add(MemTable* m, autovector<MemTable*>* to_delete) {
   assert(refs_ == 1);  // only when refs_ == 1 is MemTableListVersion mutable
   AddMemTable(m);
+  RebuildAggregateFilter();
   // m->MemoryAllocatedBytes() is added in MemoryAllocatedBytesExcludingLast
   TrimHistory(to_delete, 0);
 }
@@ -322,6 +344,7 @@ void MemTableListVersion::Remove(MemTable* m,
                                  autovector<MemTable*>* to_delete) {
   assert(refs_ == 1);  // only when refs_ == 1 is MemTableListVersion mutable
   memlist_.remove(m);
+  RebuildAggregateFilter();
 
   m->MarkFlushed();
   if (max_write_buffer_size_to_maintain_ > 0 ||
@@ -335,6 +358,44 @@ void MemTableListVersion::Remove(MemTable* m,
   }
 }
 
+// Maintain aggregate_filter_ as the union of the whole-key bloom filters of
+// all memtables in memlist_. A negative lookup in the union then proves the
+// key is in none of them, letting Get() skip the whole list with a single
+// probe. The union may only be consulted when every memtable could be
+// skipped on its own bloom negative, so it is built only if each of them has
+// a whole-key bloom of identical geometry and has no range tombstones
+// (MemTable::Get() accounts for covering tombstones even when its bloom is
+// negative). The memtables are immutable, so this only needs to run when
+// memlist_ changes, while this version is still private to its writer.
+void MemTableListVersion::RebuildAggregateFilter() {
+  aggregate_filter_.reset();
+  aggregate_filter_arena_.reset();
+  if (memlist_.empty()) {
+    return;
+  }
+  for (MemTable* m : memlist_) {
+    if (m->GetBloomFilter() == nullptr ||
+        !m->GetImmutableMemTableOptions()->memtable_whole_key_filtering ||
+        !m->IsRangeDelTableEmpty()) {
+      return;
+    }
+  }
+  aggregate_filter_arena_.reset(new Arena());
+  aggregate_filter_.reset(new DynamicBloom(
+      aggregate_filter_arena_.get(),
+      memlist_.front()->GetImmutableMemTableOptions()->memtable_prefix_bloom_bits,
+      6 /* hard coded 6 probes */));
+  for (MemTable* m : memlist_) {
+    if (!aggregate_filter_->UnionWith(*m->GetBloomFilter())) {
+      // Geometry mismatch, e.g. memtable_prefix_bloom_bits was changed
+      // between memtables; fall back to probing each memtable.
+      aggregate_filter_.reset();
+      aggregate_filter_arena_.reset();
+      return;
+    }
+  }
+}
+
 // return the total memory usage assuming the oldest flushed memtable is dropped
 size_t MemTableListVersion::MemoryAllocatedBytesExcludingLast() const {
   size_t total_memtable_size = 0;
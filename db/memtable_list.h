@@ -15,6 +15,7 @@
 #include "db/logs_with_prep_tracker.h"
 #include "db/memtable.h"
 #include "db/range_del_aggregator.h"
+#include "memory/arena.h"
 #include "file/filename.h"
 #include "logging/log_buffer.h"
 #include "monitoring/instrumented_mutex.h"
@@ -84,7 +85,8 @@ class MemTableListVersion {
   bool GetMergeOperands(const LookupKey& key, Status* s,
                         MergeContext* merge_context,
                         SequenceNumber* max_covering_tombstone_seq,
-                        const ReadOptions& read_opts);
+                        const ReadOptions& read_opts,
+                        bool stop_when_should_merge = false);
 
   // Similar to Get(), but searches the Memtable history of memtables that
   // have already been flushed.  Should only be used from in-memory only
@@ -173,6 +175,11 @@ class MemTableListVersion {
 
   void UnrefMemTable(autovector<MemTable*>* to_delete, MemTable* m);
 
+  // Recompute aggregate_filter_ from the memtables in memlist_. Must be
+  // called whenever memlist_ changes (the version is mutable then, so there
+  // are no concurrent readers).
+  void RebuildAggregateFilter();
+
   // Calculate the total amount of memory used by memlist_ and memlist_history_
   // excluding the last MemTable in memlist_history_. The reason for excluding
   // the last MemTable is to see if dropping the last MemTable will keep total
@@ -188,6 +195,13 @@ class MemTableListVersion {
   // Immutable MemTables that have not yet been flushed.
   std::list<MemTable*> memlist_;
 
+  // Union of the whole-key bloom filters of all memtables in memlist_; lets
+  // Get() skip probing the whole list on a negative instead of taking a
+  // bloom miss per memtable. nullptr whenever the union cannot answer
+  // safely (see RebuildAggregateFilter()).
+  std::unique_ptr<Arena> aggregate_filter_arena_;
+  std::unique_ptr<DynamicBloom> aggregate_filter_;
+
   // MemTables that have already been flushed
   // (used during Transaction validation)
   std::list<MemTable*> memlist_history_;
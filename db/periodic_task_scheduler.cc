@@ -51,6 +51,9 @@ static const std::map<PeriodicTaskType, std::string> kPeriodicTaskTypeNames = {
     {PeriodicTaskType::kRefreshOptions, "refresh_options"},
 };
 
+PeriodicTaskScheduler::PeriodicTaskScheduler()
+    : clock_(SystemClock::Default().get()) {}
+
 Status PeriodicTaskScheduler::Register(PeriodicTaskType task_type,
                                        const PeriodicTaskFunc& fn) {
   return Register(task_type, fn, kDefaultPeriodSeconds.at(task_type));
@@ -60,7 +63,6 @@ Status PeriodicTaskScheduler::Register(PeriodicTaskType task_type,
                                        const PeriodicTaskFunc& fn,
                                        uint64_t repeat_period_seconds) {
   MutexLock l(&timer_mutex);
-  static std::atomic<uint64_t> initial_delay(0);
 
   if (repeat_period_seconds == kInvalidPeriodSec) {
     return Status::InvalidArgument("Invalid task repeat period");
@@ -81,10 +83,22 @@ Status PeriodicTaskScheduler::Register(PeriodicTaskType task_type,
   std::string unique_id =
       kPeriodicTaskTypeNames.at(task_type) + std::to_string(id_++);
 
-  bool succeeded = timer_->Add(
-      fn, unique_id,
-      (initial_delay.fetch_add(1) % repeat_period_seconds) * kMicrosInSecond,
-      repeat_period_seconds * kMicrosInSecond);
+  // Phase-align the first run to the wall clock, with a small per-type
+  // offset. Tasks of the same type and period then come due in the same
+  // timer wakeup on every scheduler sharing the global timer, so a host
+  // running many DB instances pays one wakeup per period per task type
+  // instead of one per instance, while different types stay spread out
+  // within the period.
+  const uint64_t now_sec = clock_->NowMicros() / kMicrosInSecond;
+  const uint64_t phase_sec =
+      static_cast<uint64_t>(task_type) % repeat_period_seconds;
+  const uint64_t initial_delay_sec =
+      (repeat_period_seconds + phase_sec - now_sec % repeat_period_seconds) %
+      repeat_period_seconds;
+
+  bool succeeded =
+      timer_->Add(fn, unique_id, initial_delay_sec * kMicrosInSecond,
+                  repeat_period_seconds * kMicrosInSecond);
   if (!succeeded) {
     return Status::Aborted("Failed to register periodic task");
   }
@@ -120,6 +134,7 @@ void PeriodicTaskScheduler::TEST_OverrideTimer(SystemClock* clock) {
   test_timer.TEST_OverrideTimer(clock);
   MutexLock l(&timer_mutex);
   timer_ = &test_timer;
+  clock_ = clock;
 }
 #endif  // NDEBUG
 
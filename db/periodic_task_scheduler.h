@@ -50,7 +50,7 @@ enum class PeriodicTaskType : uint8_t {
 // flushing cannot be disabled.
 class PeriodicTaskScheduler {
  public:
-  explicit PeriodicTaskScheduler() = default;
+  PeriodicTaskScheduler();
 
   PeriodicTaskScheduler(const PeriodicTaskScheduler&) = delete;
   PeriodicTaskScheduler(PeriodicTaskScheduler&&) = delete;
@@ -113,6 +113,10 @@ class PeriodicTaskScheduler {
   // so having a global `timer_mutex` for add/cancel task.
   Timer* timer_ = Default();
 
+  // The clock driving timer_, used to phase-align task start times across
+  // scheduler instances sharing the global timer.
+  SystemClock* clock_;
+
   // Global task id, protected by the global `timer_mutex`
   inline static uint64_t id_;
 
@@ -266,6 +266,17 @@ bool FragmentedRangeTombstoneList::ContainsRange(SequenceNumber lower,
   return seq_it != seq_set_.end() && *seq_it <= upper;
 }
 
+size_t FragmentedRangeTombstoneList::ApproximateMemoryUsage() const {
+  size_t usage = sizeof(*this);
+  usage += tombstones_.capacity() * sizeof(RangeTombstoneStack);
+  usage += tombstone_seqs_.capacity() * sizeof(SequenceNumber);
+  usage += tombstone_timestamps_.capacity() * sizeof(Slice);
+  for (const auto& pinned : pinned_slices_) {
+    usage += pinned.size();
+  }
+  return usage;
+}
+
 FragmentedRangeTombstoneIterator::FragmentedRangeTombstoneIterator(
     FragmentedRangeTombstoneList* tombstones, const InternalKeyComparator& icmp,
     SequenceNumber _upper_bound, const Slice* ts_upper_bound,
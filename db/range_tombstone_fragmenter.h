@@ -96,6 +96,10 @@ struct FragmentedRangeTombstoneList {
     return total_tombstone_payload_bytes_;
   }
 
+  // Approximate memory held by this object, used as the charge when the
+  // fragmented structure is stored in the block cache.
+  size_t ApproximateMemoryUsage() const;
+
  private:
   // Given an ordered range tombstone iterator unfragmented_tombstones,
   // "fragment" the tombstones into non-overlapping pieces. Each
@@ -912,7 +912,7 @@ TEST_F(SeqnoTimeTest, Sort) {
 
   auto seqs = test.TEST_GetInternalMapping();
 
-  std::deque<SeqnoToTimeMapping::SeqnoTimePair> expected;
+  std::vector<SeqnoToTimeMapping::SeqnoTimePair> expected;
   expected.emplace_back(1, 10);
   expected.emplace_back(10, 11);
   expected.emplace_back(100, 100);
@@ -968,7 +968,7 @@ TEST_F(SeqnoTimeTest, EncodeDecodePerferNewTime) {
   ASSERT_EQ(decoded.Size(), 3);
 
   auto seqs = decoded.TEST_GetInternalMapping();
-  std::deque<SeqnoToTimeMapping::SeqnoTimePair> expected;
+  std::vector<SeqnoToTimeMapping::SeqnoTimePair> expected;
   expected.emplace_back(1, 10);
   expected.emplace_back(6, 25);
   expected.emplace_back(8, 30);
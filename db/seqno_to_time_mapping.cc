@@ -130,7 +130,7 @@ void SeqnoToTimeMapping::Encode(std::string& dest, const SequenceNumber start,
   // evenly distributed for time. Anyway the following algorithm is simple and
   // may over-select new data, which is good. We do want more accurate time
   // information for recent data.
-  std::deque<SeqnoTimePair> output_copy;
+  std::vector<SeqnoTimePair> output_copy;
   if (std::distance(start_it, end_it) > static_cast<int64_t>(output_size)) {
     int64_t num_entries_to_fill = static_cast<int64_t>(output_size);
     auto last_it = end_it;
@@ -234,7 +234,7 @@ bool SeqnoToTimeMapping::Append(SequenceNumber seqno, uint64_t time) {
   seqno_time_mapping_.emplace_back(seqno, time);
 
   if (seqno_time_mapping_.size() > max_capacity_) {
-    seqno_time_mapping_.pop_front();
+    seqno_time_mapping_.erase(seqno_time_mapping_.begin());
   }
   return true;
 }
@@ -263,30 +263,31 @@ Status SeqnoToTimeMapping::Sort() {
     return Status::OK();
   }
 
-  std::deque<SeqnoTimePair> copy = std::move(seqno_time_mapping_);
+  std::vector<SeqnoTimePair> copy = std::move(seqno_time_mapping_);
 
   std::sort(copy.begin(), copy.end());
 
   seqno_time_mapping_.clear();
 
-  // remove seqno = 0, which may have special meaning, like zeroed out data
-  while (copy.front().seqno == 0) {
-    copy.pop_front();
+  // skip seqno = 0, which may have special meaning, like zeroed out data
+  auto front = copy.begin();
+  while (front->seqno == 0) {
+    ++front;
   }
 
-  SeqnoTimePair prev = copy.front();
-  for (const auto& it : copy) {
+  SeqnoTimePair prev = *front;
+  for (auto it = front; it != copy.end(); ++it) {
     // If sequence number is the same, pick the one with larger time, which is
     // more accurate than the older time.
-    if (it.seqno == prev.seqno) {
-      assert(it.time >= prev.time);
-      prev.time = it.time;
+    if (it->seqno == prev.seqno) {
+      assert(it->time >= prev.time);
+      prev.time = it->time;
     } else {
-      assert(it.seqno > prev.seqno);
+      assert(it->seqno > prev.seqno);
       // If a larger sequence number has an older time which is not useful, skip
-      if (it.time > prev.time) {
+      if (it->time > prev.time) {
         seqno_time_mapping_.push_back(prev);
-        prev = it;
+        prev = *it;
       }
     }
   }
@@ -8,10 +8,10 @@
 
 #include <algorithm>
 #include <cinttypes>
-#include <deque>
 #include <functional>
 #include <iterator>
 #include <string>
+#include <vector>
 
 #include "rocksdb/status.h"
 #include "rocksdb/types.h"
@@ -32,6 +32,12 @@ constexpr uint64_t kUnknownSeqnoTime = 0;
 //
 // Note: the data struct is not thread safe, both read and write need to be
 //  synchronized by caller.
+//
+// Performance note: lookups are never made per key. Tiered compactions build
+// one sorted mapping per compaction (see CompactionJob::Prepare()) and query
+// it a constant number of times to precompute the seqno cutoffs
+// (preserve_time_min_seqno_ / preclude_last_level_min_seqno_) that
+// CompactionIterator then compares each key's seqno against.
 class SeqnoToTimeMapping {
  public:
   // Maximum number of entries can be encoded into SST. The data is delta encode
@@ -155,7 +161,7 @@ class SeqnoToTimeMapping {
   std::string ToHumanString() const;
 
 #ifndef NDEBUG
-  const std::deque<SeqnoTimePair>& TEST_GetInternalMapping() const {
+  const std::vector<SeqnoTimePair>& TEST_GetInternalMapping() const {
     return seqno_time_mapping_;
   }
 #endif
@@ -167,7 +173,11 @@ class SeqnoToTimeMapping {
   uint64_t max_time_duration_;
   uint64_t max_capacity_;
 
-  std::deque<SeqnoTimePair> seqno_time_mapping_;
+  // Flat storage: the list is capped at kMaxSeqnoToTimeEntries entries and is
+  // mostly appended to and binary-searched, so a contiguous vector beats a
+  // deque on locality; the occasional erase from the front is cheap at this
+  // size.
+  std::vector<SeqnoTimePair> seqno_time_mapping_;
 
   bool is_sorted_ = true;
 
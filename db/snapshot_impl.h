@@ -22,6 +22,8 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #pragma once
+#include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -195,6 +197,8 @@ class SnapshotList {
     s->prev_->next_ = s;
     s->next_->prev_ = s;
     count_++;
+    epoch_++;
+    RecomputeOldestSeqnoCache();
 #ifdef SPEEDB_SNAP_OPTIMIZATION
     l.unlock();
     return NewSnapRef(s);
@@ -210,9 +214,11 @@ class SnapshotList {
 #else
     assert(s->list_ == this);
     count_--;
+    epoch_++;
     s->prev_->next_ = s->next_;
     s->next_->prev_ = s->prev_;
     delete s;
+    RecomputeOldestSeqnoCache();
 #endif
   }
 
@@ -243,25 +249,44 @@ class SnapshotList {
     if (empty()) {
       return;
     }
-    const SnapshotImpl* s = &list_;
-    while (s->next_ != &list_) {
-      if (s->next_->number_ > max_seq) {
-        break;
-      }
-      // Avoid duplicates
-      if (ret.empty() || ret.back() != s->next_->number_) {
-        ret.push_back(s->next_->number_);
-      }
-
-      if (oldest_write_conflict_snapshot != nullptr &&
-          *oldest_write_conflict_snapshot == kMaxSequenceNumber &&
-          s->next_->is_write_conflict_boundary_) {
-        // If this is the first write-conflict boundary snapshot in the list,
-        // it is the oldest
-        *oldest_write_conflict_snapshot = s->next_->number_;
+    if (cached_epoch_ != epoch_) {
+      // The list changed since the cache was built; rebuild it with one full
+      // scan. Until the next New()/Delete(), further calls (e.g. one per
+      // compaction) are served from the sorted array without walking the
+      // list again.
+      cached_seqs_.clear();
+      cached_oldest_write_conflict_ = kMaxSequenceNumber;
+      const SnapshotImpl* s = &list_;
+      while (s->next_ != &list_) {
+        // Avoid duplicates
+        if (cached_seqs_.empty() || cached_seqs_.back() != s->next_->number_) {
+          cached_seqs_.push_back(s->next_->number_);
+        }
+
+        if (cached_oldest_write_conflict_ == kMaxSequenceNumber &&
+            s->next_->is_write_conflict_boundary_) {
+          // The first write-conflict boundary snapshot in the list is the
+          // oldest
+          cached_oldest_write_conflict_ = s->next_->number_;
+        }
+
+        s = s->next_;
       }
+      cached_epoch_ = epoch_;
+    }
 
-      s = s->next_;
+    // The list is kept in ascending sequence order, so the cached array is
+    // sorted and the max_seq cutoff is a prefix of it.
+    if (max_seq == kMaxSequenceNumber) {
+      ret = cached_seqs_;
+    } else {
+      ret.assign(cached_seqs_.begin(),
+                 std::upper_bound(cached_seqs_.begin(), cached_seqs_.end(),
+                                  max_seq));
+    }
+    if (oldest_write_conflict_snapshot != nullptr &&
+        cached_oldest_write_conflict_ <= max_seq) {
+      *oldest_write_conflict_snapshot = cached_oldest_write_conflict_;
     }
     return;
   }
@@ -282,6 +307,13 @@ class SnapshotList {
     }
   }
 
+  // Sequence number of the oldest live snapshot, or 0 when there are none.
+  // Unlike oldest(), safe to read without holding the db mutex (or lock_
+  // under SPEEDB_SNAP_OPTIMIZATION); maintained on every New()/Delete().
+  SequenceNumber UnlockedOldestSnapshotSeqno() const {
+    return oldest_seqno_.load(std::memory_order_relaxed);
+  }
+
   int64_t GetOldestSnapshotSequence() const {
     if (empty()) {
       return 0;
@@ -297,10 +329,32 @@ class SnapshotList {
 
   std::atomic_uint64_t logical_count_ = {0};
   uint64_t count_;
+  // Bumped on every list change; invalidates the GetAll() cache below.
+  // Protected the same way as the list itself.
+  uint64_t epoch_ = 0;
 
  private:
   // Dummy head of doubly-linked list of snapshots
   SnapshotImpl list_;
+
+  // Cache of the result of a full GetAll() scan, so that repeated calls
+  // (one per flush/compaction) don't each walk the whole list. The cache is
+  // rebuilt when it doesn't match the epoch it was built at. Protected by
+  // lock_ when SPEEDB_SNAP_OPTIMIZATION is on, by the db mutex otherwise,
+  // same as the list itself.
+  mutable uint64_t cached_epoch_ = 0;
+  mutable std::vector<SequenceNumber> cached_seqs_;
+  mutable SequenceNumber cached_oldest_write_conflict_ = kMaxSequenceNumber;
+
+  // See UnlockedOldestSnapshotSeqno().
+  std::atomic<SequenceNumber> oldest_seqno_{0};
+
+  void RecomputeOldestSeqnoCache() {
+    oldest_seqno_.store(empty() ? 0 : oldest()->number_,
+                        std::memory_order_relaxed);
+  }
+
+  friend class SnapshotImpl;
 };
 
 // All operations on TimestampedSnapshotList must be protected by db mutex.
@@ -359,8 +413,10 @@ inline void SnapshotImpl::Deleter::operator()(SnapshotImpl* snap) const {
   if (snap->cached_snapshot == nullptr) {
     std::scoped_lock<std::mutex> l(snap->list_->lock_);
     snap->list_->count_--;
+    snap->list_->epoch_++;
     snap->prev_->next_ = snap->next_;
     snap->next_->prev_ = snap->prev_;
+    snap->list_->RecomputeOldestSeqnoCache();
     snap->list_->deleteitem_ = true;
   }
   delete snap;
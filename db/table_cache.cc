@@ -23,6 +23,7 @@
 
 #include "db/table_cache.h"
 
+#include "db/compaction/clipping_iterator.h"
 #include "db/dbformat.h"
 #include "db/range_tombstone_fragmenter.h"
 #include "db/snapshot_impl.h"
@@ -97,10 +98,60 @@ TableCache::TableCache(const ImmutableOptions& ioptions,
     // If the same cache is shared by multiple instances, we need to
     // disambiguate its entries.
     PutVarint64(&row_cache_id_, ioptions_.row_cache->NewId());
+    row_cache_admission_sketch_.reset(new CountMinSketch());
   }
 }
 
-TableCache::~TableCache() {}
+TableCache::~TableCache() {
+  // Drop the references held by the core-local handle cache. The backing
+  // Cache outlives the TableCache, so the entries themselves are cleaned up
+  // by it as usual once unreferenced.
+  for (size_t core = 0; core < local_handle_cache_.Size(); ++core) {
+    for (TableHandleSlot& slot : local_handle_cache_.AccessAtCore(core)->slots) {
+      if (slot.handle != nullptr) {
+        cache_.Release(slot.handle);
+      }
+    }
+  }
+}
+
+TableCache::TypedHandle* TableCache::LookupCoreLocalHandle(uint64_t number) {
+  TableHandleSlot& slot =
+      local_handle_cache_.Access()->slots[number % kHandleSlotsPerCore];
+  if (slot.busy.exchange(true, std::memory_order_acquire)) {
+    // Another thread on this core owns the slot right now; treat as a miss
+    // rather than waiting.
+    return nullptr;
+  }
+  TypedHandle* handle = nullptr;
+  if (slot.file_number == number) {
+    handle = slot.handle;
+    // Take the caller's reference while the slot's own reference still pins
+    // the entry.
+    cache_.get()->Ref(handle);
+  }
+  slot.busy.store(false, std::memory_order_release);
+  return handle;
+}
+
+void TableCache::PublishCoreLocalHandle(uint64_t number, TypedHandle* handle) {
+  TableHandleSlot& slot =
+      local_handle_cache_.Access()->slots[number % kHandleSlotsPerCore];
+  if (slot.busy.exchange(true, std::memory_order_acquire)) {
+    return;
+  }
+  TypedHandle* old_handle = nullptr;
+  if (slot.file_number != number) {
+    old_handle = slot.handle;
+    cache_.get()->Ref(handle);
+    slot.file_number = number;
+    slot.handle = handle;
+  }
+  slot.busy.store(false, std::memory_order_release);
+  if (old_handle != nullptr) {
+    cache_.Release(old_handle);
+  }
+}
 
 Status TableCache::GetTableReader(
     const ReadOptions& ro, const FileOptions& file_options,
@@ -186,6 +237,10 @@ Status TableCache::FindTable(
     size_t max_file_size_for_l0_meta_pin, Temperature file_temperature) {
   PERF_TIMER_GUARD_WITH_CLOCK(find_table_nanos, ioptions_.clock);
   uint64_t number = file_meta.fd.GetNumber();
+  *handle = LookupCoreLocalHandle(number);
+  if (*handle != nullptr) {
+    return Status::OK();
+  }
   Slice key = GetSliceForFileNumber(&number);
   *handle = cache_.Lookup(key);
   TEST_SYNC_POINT_CALLBACK("TableCache::FindTable:0",
@@ -199,6 +254,7 @@ Status TableCache::FindTable(
     // We check the cache again under loading mutex
     *handle = cache_.Lookup(key);
     if (*handle != nullptr) {
+      PublishCoreLocalHandle(number, *handle);
       return Status::OK();
     }
 
@@ -219,10 +275,12 @@ Status TableCache::FindTable(
       if (s.ok()) {
         // Release ownership of table reader.
         (void)table_reader.release();
+        PublishCoreLocalHandle(number, *handle);
       }
     }
     return s;
   }
+  PublishCoreLocalHandle(number, *handle);
   return Status::OK();
 }
 
@@ -265,15 +323,50 @@ InternalIterator* TableCache::NewIterator(
         !options.table_filter(*table_reader->GetTableProperties())) {
       result = NewEmptyInternalIterator<Slice>(arena);
     } else {
+      size_t compaction_readahead_size = file_options.compaction_readahead_size;
+      if (file_options.cold_tier_compaction_readahead_size > 0 &&
+          (file_meta.temperature == Temperature::kWarm ||
+           file_meta.temperature == Temperature::kCold)) {
+        compaction_readahead_size =
+            file_options.cold_tier_compaction_readahead_size;
+      }
       result = table_reader->NewIterator(
           options, prefix_extractor.get(), arena, skip_filters, caller,
-          file_options.compaction_readahead_size, allow_unprepared_value);
+          compaction_readahead_size, allow_unprepared_value);
     }
     if (handle != nullptr) {
       cache_.RegisterReleaseAsCleanup(handle, *result);
       handle = nullptr;  // prevent from releasing below
     }
 
+    if (file_meta.clipped) {
+      // The physical SST is shared with another FileMetaData entry after a
+      // metadata-only split; serve only [smallest, largest]. The bound
+      // slices point into the FileMetaData, which outlives the iterator
+      // because the version holding it stays referenced.
+      InternalIterator* inner = result;
+      if (arena != nullptr) {
+        auto* mem = arena->AllocateAligned(sizeof(ClippingIterator));
+        result = new (mem)
+            ClippingIterator(inner, file_meta.smallest.Encode(),
+                             file_meta.largest.Encode(), &icomparator);
+        result->RegisterCleanup(
+            [](void* arg1, void* /*arg2*/) {
+              static_cast<InternalIterator*>(arg1)->~InternalIterator();
+            },
+            inner, nullptr);
+      } else {
+        result =
+            new ClippingIterator(inner, file_meta.smallest.Encode(),
+                                 file_meta.largest.Encode(), &icomparator);
+        result->RegisterCleanup(
+            [](void* arg1, void* /*arg2*/) {
+              delete static_cast<InternalIterator*>(arg1);
+            },
+            inner, nullptr);
+      }
+    }
+
     if (for_compaction) {
       table_reader->SetupForCompaction();
     }
@@ -435,12 +528,17 @@ Status TableCache::Get(
   bool done = false;
   IterKey row_cache_key;
   std::string row_cache_entry_buffer;
+  uint32_t row_cache_key_freq = 0;
 
   // Check row cache if enabled. Since row cache does not currently store
   // sequence numbers, we cannot use it if we need to fetch the sequence.
   if (ioptions_.row_cache && !get_context->NeedToReadSequence()) {
     auto user_key = ExtractUserKey(k);
     CreateRowCacheKeyPrefix(options, fd, k, get_context, row_cache_key);
+    // Count every row-cache-eligible access, including hits, so a hot key
+    // that gets evicted is readmitted on its next access.
+    row_cache_key_freq =
+        row_cache_admission_sketch_->AddAndEstimate(user_key);
     done = GetFromRowCache(user_key, row_cache_key, row_cache_key.Size(),
                            get_context);
     if (!done) {
@@ -495,12 +593,19 @@ Status TableCache::Get(
 
   // Put the replay log in row cache only if something was found.
   if (!done && s.ok() && row_cache_entry && !row_cache_entry->empty()) {
-    RowCacheInterface row_cache{ioptions_.row_cache.get()};
-    size_t charge = row_cache_entry->capacity() + sizeof(std::string);
-    auto row_ptr = new std::string(std::move(*row_cache_entry));
-    // If row cache is full, it's OK to continue.
-    row_cache.Insert(row_cache_key.GetUserKey(), row_ptr, charge)
-        .PermitUncheckedError();
+    if (row_cache_key_freq >= kRowCacheAdmissionThreshold) {
+      row_cache_admit_count_.fetch_add(1, std::memory_order_relaxed);
+      RowCacheInterface row_cache{ioptions_.row_cache.get()};
+      size_t charge = row_cache_entry->capacity() + sizeof(std::string);
+      auto row_ptr = new std::string(std::move(*row_cache_entry));
+      // If row cache is full, it's OK to continue.
+      row_cache.Insert(row_cache_key.GetUserKey(), row_ptr, charge)
+          .PermitUncheckedError();
+    } else {
+      // First recent access of this key; let it prove itself before it may
+      // displace hotter entries.
+      row_cache_reject_count_.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   if (handle != nullptr) {
@@ -509,6 +614,24 @@ Status TableCache::Get(
   return s;
 }
 
+bool TableCache::GetRowCacheAdmissionStats(std::string* value) const {
+  if (!row_cache_admission_sketch_) {
+    return false;
+  }
+  char buf[256];
+  snprintf(buf, sizeof(buf),
+           "sketch width %" PRIu32 " depth %" PRIu32 ", %" PRIu64
+           " sampled accesses, %" PRIu64 " decays, %" PRIu64 " admitted, %" PRIu64
+           " rejected\n",
+           row_cache_admission_sketch_->Width(), CountMinSketch::kDepth,
+           row_cache_admission_sketch_->AddCount(),
+           row_cache_admission_sketch_->DecayCount(),
+           row_cache_admit_count_.load(std::memory_order_relaxed),
+           row_cache_reject_count_.load(std::memory_order_relaxed));
+  value->append(buf);
+  return true;
+}
+
 void TableCache::UpdateRangeTombstoneSeqnums(
     const ReadOptions& options, TableReader* t,
     MultiGetContext::Range& table_range) {
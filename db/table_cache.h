@@ -38,6 +38,8 @@
 #include "rocksdb/env.h"
 #include "rocksdb/options.h"
 #include "rocksdb/table.h"
+#include "util/core_local.h"
+#include "util/count_min_sketch.h"
 #include "table/table_reader.h"
 #include "trace_replay/block_cache_tracer.h"
 #include "util/coro_utils.h"
@@ -250,6 +252,11 @@ class TableCache {
     cache_owner_id_ = cache_owner_id;
   }
 
+  // Appends a human-readable summary of the row cache admission sketch to
+  // `*value` (feeds the rocksdb.row-cache-admission-stats DB property).
+  // Returns false if the row cache is not enabled.
+  bool GetRowCacheAdmissionStats(std::string* value) const;
+
  private:
   // Build a table reader
   Status GetTableReader(
@@ -282,10 +289,45 @@ class TableCache {
   bool GetFromRowCache(const Slice& user_key, IterKey& row_cache_key,
                        size_t prefix_size, GetContext* get_context);
 
+  // Minimum estimated access frequency within the sketch's sampling window
+  // for a key to be admitted into the row cache. With a threshold of 2, a
+  // key's first recent access only records it; a repeat access admits it.
+  static constexpr uint32_t kRowCacheAdmissionThreshold = 2;
+
+  // A small per-core, direct-mapped cache of recently resolved table cache
+  // handles, layered above cache_ so that steady-state FindTable() calls do
+  // not touch the shared cache's shard mutex. Each occupied slot owns one
+  // reference on its handle, entries are validated by file number (file
+  // numbers are never reused), and slots are claimed with a non-blocking
+  // try-lock - contenders simply fall back to the shared cache.
+  struct TableHandleSlot {
+    std::atomic<bool> busy{false};
+    uint64_t file_number = 0;  // 0 means the slot is empty
+    TypedHandle* handle = nullptr;
+  };
+  static constexpr size_t kHandleSlotsPerCore = 8;
+  struct ALIGN_AS(CACHE_LINE_SIZE) TableHandleSlots {
+    TableHandleSlot slots[kHandleSlotsPerCore];
+  };
+
+  // Returns the handle for `number` with an extra reference taken for the
+  // caller, or nullptr on miss.
+  TypedHandle* LookupCoreLocalHandle(uint64_t number);
+
+  // Stores `handle` (with its own extra reference) in this core's slot,
+  // releasing the slot's previous occupant. No-op if the slot is contended.
+  void PublishCoreLocalHandle(uint64_t number, TypedHandle* handle);
+
   const ImmutableOptions& ioptions_;
   const FileOptions& file_options_;
   CacheInterface cache_;
   std::string row_cache_id_;
+  // Admission control for the row cache: a count-min sketch tracks recent
+  // key access frequency and only keys seen more than once within the
+  // sampling window are inserted, so long-tail keys do not churn the cache.
+  std::unique_ptr<CountMinSketch> row_cache_admission_sketch_;
+  std::atomic<uint64_t> row_cache_admit_count_{0};
+  std::atomic<uint64_t> row_cache_reject_count_{0};
   bool immortal_tables_;
   BlockCacheTracer* const block_cache_tracer_;
   Striped<port::Mutex, Slice> loader_mutex_;
@@ -293,6 +335,7 @@ class TableCache {
   std::string db_session_id_;
   Cache::ItemOwnerId cache_owner_id_ = Cache::kUnknownItemOwnerId;
   IsLastLevelWithDataFunc is_last_level_with_data_func_;
+  CoreLocalArray<TableHandleSlots> local_handle_cache_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -29,6 +29,7 @@ DEFINE_SYNC_AND_ASYNC(Status, TableCache::MultiGet)
     t = cache_.Value(handle);
   }
   autovector<std::string, MultiGetContext::MAX_BATCH_SIZE> row_cache_entries;
+  autovector<uint32_t, MultiGetContext::MAX_BATCH_SIZE> row_cache_key_freqs;
   IterKey row_cache_key;
   size_t row_cache_key_prefix_size = 0;
   KeyContext& first_key = *table_range.begin();
@@ -49,11 +50,16 @@ DEFINE_SYNC_AND_ASYNC(Status, TableCache::MultiGet)
 
       GetContext* get_context = miter->get_context;
 
+      // Count every row-cache-eligible access, including hits, so a hot key
+      // that gets evicted is readmitted on its next access.
+      const uint32_t freq =
+          row_cache_admission_sketch_->AddAndEstimate(user_key);
       if (GetFromRowCache(user_key, row_cache_key, row_cache_key_prefix_size,
                           get_context)) {
         table_range.SkipKey(miter);
       } else {
         row_cache_entries.emplace_back();
+        row_cache_key_freqs.emplace_back(freq);
         get_context->SetReplayLog(&(row_cache_entries.back()));
       }
     }
@@ -100,7 +106,9 @@ DEFINE_SYNC_AND_ASYNC(Status, TableCache::MultiGet)
 
     for (auto miter = table_range.begin(); miter != table_range.end();
          ++miter) {
-      std::string& row_cache_entry = row_cache_entries[row_idx++];
+      std::string& row_cache_entry = row_cache_entries[row_idx];
+      const uint32_t row_cache_key_freq = row_cache_key_freqs[row_idx];
+      ++row_idx;
       const Slice& user_key = miter->ukey_with_ts;
       ;
       GetContext* get_context = miter->get_context;
@@ -111,11 +119,16 @@ DEFINE_SYNC_AND_ASYNC(Status, TableCache::MultiGet)
                                user_key.size());
       // Put the replay log in row cache only if something was found.
       if (s.ok() && !row_cache_entry.empty()) {
-        size_t charge = row_cache_entry.capacity() + sizeof(std::string);
-        auto row_ptr = new std::string(std::move(row_cache_entry));
-        // If row cache is full, it's OK.
-        row_cache.Insert(row_cache_key.GetUserKey(), row_ptr, charge)
-            .PermitUncheckedError();
+        if (row_cache_key_freq >= kRowCacheAdmissionThreshold) {
+          row_cache_admit_count_.fetch_add(1, std::memory_order_relaxed);
+          size_t charge = row_cache_entry.capacity() + sizeof(std::string);
+          auto row_ptr = new std::string(std::move(row_cache_entry));
+          // If row cache is full, it's OK.
+          row_cache.Insert(row_cache_key.GetUserKey(), row_ptr, charge)
+              .PermitUncheckedError();
+        } else {
+          row_cache_reject_count_.fetch_add(1, std::memory_order_relaxed);
+        }
       }
     }
   }
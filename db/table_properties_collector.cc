@@ -29,15 +29,8 @@ uint64_t GetUint64Property(const UserCollectedProperties& props,
 
 }  // anonymous namespace
 
-Status UserKeyTablePropertiesCollector::InternalAdd(const Slice& key,
-                                                    const Slice& value,
-                                                    uint64_t file_size) {
-  ParsedInternalKey ikey;
-  Status s = ParseInternalKey(key, &ikey, false /* log_err_key */);  // TODO
-  if (!s.ok()) {
-    return s;
-  }
-
+Status UserKeyTablePropertiesCollector::InternalAdd(
+    const ParsedInternalKey& ikey, const Slice& value, uint64_t file_size) {
   return collector_->AddUserKey(ikey.user_key, value, GetEntryType(ikey.type),
                                 ikey.sequence, file_size);
 }
@@ -24,9 +24,16 @@ class IntTblPropCollector {
 
   virtual const char* Name() const = 0;
 
-  // @params key    the user key that is inserted into the table.
+  // Whether this collector is interested in per-key InternalAdd()
+  // notifications. Collectors returning false are skipped in the hot add loop
+  // of table building and never get InternalAdd() called, and the internal
+  // key is not parsed on their behalf.
+  virtual bool NeedsInternalAdd() const { return true; }
+
+  // @params ikey   the parsed internal key that is inserted into the table.
+  //                Parsed once by the caller and shared by all collectors.
   // @params value  the value that is inserted into the table.
-  virtual Status InternalAdd(const Slice& key, const Slice& value,
+  virtual Status InternalAdd(const ParsedInternalKey& ikey, const Slice& value,
                              uint64_t file_size) = 0;
 
   virtual void BlockAdd(uint64_t block_uncomp_bytes,
@@ -66,7 +73,7 @@ class UserKeyTablePropertiesCollector : public IntTblPropCollector {
 
   virtual ~UserKeyTablePropertiesCollector() {}
 
-  virtual Status InternalAdd(const Slice& key, const Slice& value,
+  virtual Status InternalAdd(const ParsedInternalKey& ikey, const Slice& value,
                              uint64_t file_size) override;
 
   virtual void BlockAdd(uint64_t block_uncomp_bytes,
@@ -122,9 +129,9 @@ class TimestampTablePropertiesCollector : public IntTblPropCollector {
         timestamp_min_(kDisableUserTimestamp),
         timestamp_max_(kDisableUserTimestamp) {}
 
-  Status InternalAdd(const Slice& key, const Slice& /* value */,
+  Status InternalAdd(const ParsedInternalKey& ikey, const Slice& /* value */,
                      uint64_t /* file_size */) override {
-    auto user_key = ExtractUserKey(key);
+    const Slice& user_key = ikey.user_key;
     assert(cmp_ && cmp_->timestamp_size() > 0);
     if (user_key.size() < cmp_->timestamp_size()) {
       return Status::Corruption(
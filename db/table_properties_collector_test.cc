@@ -167,10 +167,10 @@ class RegularKeysStartWithAInternal : public IntTblPropCollector {
     return Status::OK();
   }
 
-  Status InternalAdd(const Slice& user_key, const Slice& /*value*/,
+  Status InternalAdd(const ParsedInternalKey& ikey, const Slice& /*value*/,
                      uint64_t /*file_size*/) override {
     // simply asssume all user keys are not empty.
-    if (user_key.data()[0] == 'A') {
+    if (ikey.user_key.data()[0] == 'A') {
       ++count_;
     }
     return Status::OK();
@@ -1339,7 +1339,11 @@ class VersionBuilder::Rep {
     });
 
     std::vector<port::Thread> threads;
-    for (int i = 1; i < max_threads; i++) {
+    // No point spawning more threads than there are files left to open; with
+    // few files to load this skips the thread creation entirely.
+    const int num_threads = static_cast<int>(std::min(
+        static_cast<size_t>(std::max(max_threads, 1)), files_meta.size()));
+    for (int i = 1; i < num_threads; i++) {
       threads.emplace_back(load_handlers_func);
     }
     load_handlers_func();
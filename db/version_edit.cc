@@ -93,7 +93,8 @@ void VersionEdit::Clear() {
   full_history_ts_low_.clear();
 }
 
-bool VersionEdit::EncodeTo(std::string* dst) const {
+bool VersionEdit::EncodeTo(std::string* dst,
+                           bool delta_encode_file_numbers) const {
   if (has_db_id_) {
     PutVarint32(dst, kDbId);
     PutLengthPrefixedSlice(dst, db_id_);
@@ -133,14 +134,27 @@ bool VersionEdit::EncodeTo(std::string* dst) const {
   }
 
   bool min_log_num_written = false;
+  uint64_t prev_file_number = 0;
   for (size_t i = 0; i < new_files_.size(); i++) {
     const FileMetaData& f = new_files_[i].second;
     if (!f.smallest.Valid() || !f.largest.Valid() ||
         f.epoch_number == kUnknownEpochNumber) {
       return false;
     }
-    PutVarint32(dst, kNewFile4);
-    PutVarint32Varint64(dst, new_files_[i].first /* level */, f.fd.GetNumber());
+    if (delta_encode_file_numbers) {
+      // Large edits (e.g. the full-state snapshot written on a MANIFEST
+      // roll) carry mostly-consecutive file numbers, so the signed deltas
+      // are usually one byte each.
+      PutVarint32(dst, kNewFileDelta);
+      PutVarint32(dst, new_files_[i].first /* level */);
+      PutVarsignedint64(dst, static_cast<int64_t>(f.fd.GetNumber()) -
+                                 static_cast<int64_t>(prev_file_number));
+      prev_file_number = f.fd.GetNumber();
+    } else {
+      PutVarint32(dst, kNewFile4);
+      PutVarint32Varint64(dst, new_files_[i].first /* level */,
+                          f.fd.GetNumber());
+    }
     PutVarint64(dst, f.fd.GetFileSize());
     PutLengthPrefixedSlice(dst, f.smallest.Encode());
     PutLengthPrefixedSlice(dst, f.largest.Encode());
@@ -231,6 +245,11 @@ bool VersionEdit::EncodeTo(std::string* dst) const {
       std::string unique_id_str = EncodeUniqueIdBytes(&unique_id);
       PutLengthPrefixedSlice(dst, Slice(unique_id_str));
     }
+    if (f.clipped) {
+      PutVarint32(dst, NewFileCustomTag::kClipped);
+      char p = static_cast<char>(1);
+      PutLengthPrefixedSlice(dst, Slice(&p, 1));
+    }
     if (f.compensated_range_deletion_size) {
       PutVarint32(dst, kCompensatedRangeDeletionSize);
       std::string compensated_range_deletion_size;
@@ -318,7 +337,8 @@ bool VersionEdit::GetLevel(Slice* input, int* level, const char** /*msg*/) {
   }
 }
 
-const char* VersionEdit::DecodeNewFile4From(Slice* input) {
+const char* VersionEdit::DecodeNewFile4From(Slice* input,
+                                            uint64_t* file_number_base) {
   const char* msg = nullptr;
   int level = 0;
   FileMetaData f;
@@ -327,9 +347,23 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
   uint64_t file_size = 0;
   SequenceNumber smallest_seqno = 0;
   SequenceNumber largest_seqno = kMaxSequenceNumber;
-  if (GetLevel(input, &level, &msg) && GetVarint64(input, &number) &&
-      GetVarint64(input, &file_size) && GetInternalKey(input, &f.smallest) &&
-      GetInternalKey(input, &f.largest) &&
+  bool number_ok;
+  if (!GetLevel(input, &level, &msg)) {
+    return "new-file4 entry";
+  }
+  if (file_number_base != nullptr) {
+    int64_t delta = 0;
+    number_ok = GetVarsignedint64(input, &delta);
+    if (number_ok) {
+      number = static_cast<uint64_t>(
+          static_cast<int64_t>(*file_number_base) + delta);
+      *file_number_base = number;
+    }
+  } else {
+    number_ok = GetVarint64(input, &number);
+  }
+  if (number_ok && GetVarint64(input, &file_size) &&
+      GetInternalKey(input, &f.smallest) && GetInternalKey(input, &f.largest) &&
       GetVarint64(input, &smallest_seqno) &&
       GetVarint64(input, &largest_seqno)) {
     // See comments in VersionEdit::EncodeTo() for format of customized fields
@@ -416,6 +450,12 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
             return "Invalid compensated range deletion size";
           }
           break;
+        case kClipped:
+          if (field.size() != 1) {
+            return "clipped field wrong size";
+          }
+          f.clipped = (field[0] == 1);
+          break;
         default:
           if ((custom_tag & kCustomTagNonSafeIgnoreMask) != 0) {
             // Should not proceed if cannot understand it
@@ -449,6 +489,8 @@ Status VersionEdit::DecodeFrom(const Slice& src) {
   FileMetaData f;
   Slice str;
   InternalKey key;
+  // Running base for kNewFileDelta entries within this record
+  uint64_t delta_file_number_base = 0;
   while (msg == nullptr && GetVarint32(&input, &tag)) {
 #ifndef NDEBUG
     if (ignore_ignorable_tags && tag > kTagSafeIgnoreMask) {
@@ -611,6 +653,11 @@ Status VersionEdit::DecodeFrom(const Slice& src) {
         break;
       }
 
+      case kNewFileDelta: {
+        msg = DecodeNewFile4From(&input, &delta_file_number_base);
+        break;
+      }
+
       case kBlobFileAddition:
       case kBlobFileAddition_DEPRECATED: {
         BlobFileAddition blob_file_addition;
@@ -48,6 +48,11 @@ enum Tag : uint32_t {
   kNewFile2 = 100,
   kNewFile3 = 102,
   kNewFile4 = 103,      // 4th (the latest) format version of adding files
+  // Same layout as kNewFile4 except the file number is encoded as a signed
+  // varint delta from the previous new-file entry of the same record. Only
+  // written when DBOptions::manifest_delta_encoding is set; a MANIFEST
+  // containing this tag cannot be opened by releases that predate it.
+  kNewFileDelta = 104,
   kColumnFamily = 200,  // specify column family for version edit
   kColumnFamilyAdd = 201,
   kColumnFamilyDrop = 202,
@@ -97,6 +102,11 @@ enum NewFileCustomTag : uint32_t {
 
   // Forward incompatible (aka unignorable) fields
   kPathId,
+  // Marks a file installed by a metadata-only split (see DB::SplitSstFile):
+  // the physical SST is shared with another FileMetaData and only keys in
+  // [smallest, largest] belong to this file. Cannot be ignored: a release
+  // that does not understand the flag would serve the unclipped contents.
+  kClipped,
 };
 
 class VersionSet;
@@ -238,6 +248,13 @@ struct FileMetaData {
   // SST unique id
   UniqueId64x2 unique_id{};
 
+  // True for a file installed by a metadata-only split (DB::SplitSstFile):
+  // the physical SST is shared with another FileMetaData entry, and readers
+  // must serve only the keys in [smallest, largest]. TableCache::NewIterator
+  // clips iterators of such files accordingly; point lookups are already
+  // restricted to the file's key range by the file-picking logic.
+  bool clipped = false;
+
   FileMetaData() = default;
 
   FileMetaData(uint64_t file, uint32_t file_path_id, uint64_t file_size,
@@ -354,6 +371,12 @@ struct FdWithKeyRange {
 struct LevelFilesBrief {
   size_t num_files;
   FdWithKeyRange* files;
+  // Aggregate user-key span over all files in the level, or empty slices if
+  // not computed. Only filled in for level 0 (where files may overlap and a
+  // point lookup otherwise range-checks every file); see
+  // VersionStorageInfo::GenerateLevelFilesBrief().
+  Slice smallest_user_key;
+  Slice largest_user_key;
   LevelFilesBrief() {
     num_files = 0;
     files = nullptr;
@@ -622,8 +645,10 @@ class VersionEdit {
     full_history_ts_low_ = std::move(full_history_ts_low);
   }
 
-  // return true on success.
-  bool EncodeTo(std::string* dst) const;
+  // return true on success. When `delta_encode_file_numbers` is set, new
+  // files are written as kNewFileDelta entries with delta-encoded file
+  // numbers; see the Tag comment for the compatibility implications.
+  bool EncodeTo(std::string* dst, bool delta_encode_file_numbers = false) const;
   Status DecodeFrom(const Slice& src);
 
   std::string DebugString(bool hex_key = false) const;
@@ -642,7 +667,11 @@ class VersionEdit {
 
   bool GetLevel(Slice* input, int* level, const char** msg);
 
-  const char* DecodeNewFile4From(Slice* input);
+  // When `file_number_base` is non-null the entry is a kNewFileDelta one:
+  // the file number is read as a signed varint delta against *file_number_base
+  // and *file_number_base is updated to the decoded number.
+  const char* DecodeNewFile4From(Slice* input,
+                                 uint64_t* file_number_base = nullptr);
 
   int max_level_ = 0;
   std::string db_id_;
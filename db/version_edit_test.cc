@@ -115,6 +115,51 @@ TEST_F(VersionEditTest, EncodeDecodeNewFile4) {
   ASSERT_EQ(1001, new_files[3].second.oldest_blob_file_number);
 }
 
+TEST_F(VersionEditTest, EncodeDecodeNewFileDelta) {
+  static const uint64_t kBig = 1ull << 50;
+
+  VersionEdit edit;
+  // Mostly-consecutive file numbers, plus one going backwards to exercise
+  // negative deltas.
+  for (uint64_t number : {kBig + 300, kBig + 301, kBig + 302, kBig + 150}) {
+    edit.AddFile(3, number, 0, 100,
+                 InternalKey("foo", kBig + 500, kTypeValue),
+                 InternalKey("zoo", kBig + 600, kTypeDeletion), kBig + 500,
+                 kBig + 600, false, Temperature::kUnknown,
+                 kInvalidBlobFileNumber, kUnknownOldestAncesterTime,
+                 kUnknownFileCreationTime, number /* epoch_number */,
+                 kUnknownFileChecksum, kUnknownFileChecksumFuncName,
+                 kNullUniqueId64x2, 0);
+  }
+  edit.SetComparatorName("foo");
+  edit.SetLogNumber(kBig + 100);
+  edit.SetNextFile(kBig + 200);
+  edit.SetLastSequence(kBig + 1000);
+
+  std::string encoded, encoded_delta;
+  ASSERT_TRUE(edit.EncodeTo(&encoded));
+  ASSERT_TRUE(edit.EncodeTo(&encoded_delta, true /* delta */));
+  // Delta-encoded file numbers must not inflate the record; only the first
+  // entry pays the full varint.
+  ASSERT_LT(encoded_delta.size(), encoded.size());
+
+  VersionEdit parsed;
+  Status s = parsed.DecodeFrom(encoded_delta);
+  ASSERT_TRUE(s.ok()) << s.ToString();
+  auto& new_files = parsed.GetNewFiles();
+  ASSERT_EQ(4u, new_files.size());
+  ASSERT_EQ(kBig + 300, new_files[0].second.fd.GetNumber());
+  ASSERT_EQ(kBig + 301, new_files[1].second.fd.GetNumber());
+  ASSERT_EQ(kBig + 302, new_files[2].second.fd.GetNumber());
+  ASSERT_EQ(kBig + 150, new_files[3].second.fd.GetNumber());
+
+  // Re-encoding the parsed edit without deltas must match the original
+  // absolute encoding.
+  std::string encoded2;
+  ASSERT_TRUE(parsed.EncodeTo(&encoded2));
+  ASSERT_EQ(encoded, encoded2);
+}
+
 TEST_F(VersionEditTest, ForwardCompatibleNewFile4) {
   static const uint64_t kBig = 1ull << 50;
   VersionEdit edit;
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cinttypes>
 #include <cstdio>
 #include <list>
@@ -172,7 +173,7 @@ class FilePicker {
         internal_comparator_(internal_comparator) {
     // Setup member variables to search first level.
     search_ended_ = !PrepareNextLevel();
-    if (!search_ended_) {
+    if (!search_ended_ && curr_level_ == 0) {
       // Prefetch Level 0 table data to avoid cache miss if possible.
       for (unsigned int i = 0; i < (*level_files_brief_)[0].num_files; ++i) {
         auto* r = (*level_files_brief_)[0].files[i].fd.table_reader;
@@ -309,7 +310,24 @@ class FilePicker {
       // are always compacted into a single entry).
       int32_t start_index;
       if (curr_level_ == 0) {
-        // On Level-0, we read through all files to check for overlap.
+        // On Level-0, we read through all files to check for overlap. But
+        // first consult the aggregate user-key span of the level, computed at
+        // version install time (see
+        // VersionStorageInfo::GenerateLevelFilesBrief()): when the lookup key
+        // falls outside it, the whole level is skipped with two comparisons
+        // instead of two per file. Mirror the key range filtering condition
+        // in GetNextFile() so highly tuned small setups are unaffected.
+        if ((num_levels_ > 1 || curr_file_level_->num_files > 3) &&
+            !curr_file_level_->smallest_user_key.empty() &&
+            (user_comparator_->CompareWithoutTimestamp(
+                 user_key_, curr_file_level_->smallest_user_key) < 0 ||
+             user_comparator_->CompareWithoutTimestamp(
+                 user_key_, curr_file_level_->largest_user_key) > 0)) {
+          // No level-0 file can contain the key. Level 0 never narrows the
+          // search bounds for level 1, so it is safe to move on directly.
+          curr_level_++;
+          continue;
+        }
         start_index = 0;
       } else {
         // On Level-n (n>=1), files are sorted. Binary search to find the
@@ -1345,6 +1363,13 @@ void LevelIterator::SeekToFirst() {
   InitFileIterator(0);
   if (file_iter_.iter() != nullptr) {
     file_iter_.SeekToFirst();
+    // Status::TryAgain indicates asynchronous request for retrieval of data
+    // blocks has been submitted. So it should return at this point and
+    // SeekToFirst should be called again to retrieve the requested block and
+    // execute the remaining code.
+    if (file_iter_.status() == Status::TryAgain()) {
+      return;
+    }
     if (range_tombstone_iter_) {
       // We do this in SeekToFirst() and SeekToLast() since
       // we could have an empty file with only range tombstones.
@@ -1457,6 +1482,12 @@ bool LevelIterator::SkipEmptyFileForward() {
     // range tombstone iterator.
     if (file_iter_.iter() != nullptr) {
       file_iter_.SeekToFirst();
+      if (file_iter_.status().IsTryAgain()) {
+        // This file advance may happen inside Next(), where no caller will
+        // call SeekToFirst() again to pick up the asynchronously requested
+        // block. Complete the read right away instead.
+        file_iter_.SeekToFirst();
+      }
       if (range_tombstone_iter_) {
         if (*range_tombstone_iter_) {
           (*range_tombstone_iter_)->SeekToFirst();
@@ -2274,7 +2305,7 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
                   SequenceNumber* max_covering_tombstone_seq,
                   PinnedIteratorsManager* pinned_iters_mgr, bool* value_found,
                   bool* key_exists, SequenceNumber* seq, ReadCallback* callback,
-                  bool* is_blob, bool do_merge) {
+                  bool* is_blob, bool do_merge, bool stop_when_should_merge) {
   Slice ikey = k.internal_key();
   Slice user_key = k.user_key();
 
@@ -2306,7 +2337,7 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
       do_merge ? timestamp : nullptr, value_found, merge_context, do_merge,
       max_covering_tombstone_seq, clock_, seq,
       merge_operator_ ? pinned_iters_mgr : nullptr, callback, is_blob_to_use,
-      tracing_get_id, &blob_fetcher);
+      tracing_get_id, &blob_fetcher, stop_when_should_merge);
 
   // Pin blocks that we read to hold merge operands
   if (merge_operator_) {
@@ -2325,6 +2356,17 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
       // stop here.
       break;
     }
+    if (read_options.deadline.count() &&
+        clock_->NowMicros() >
+            static_cast<uint64_t>(read_options.deadline.count())) {
+      // Give up probing further files once the caller's deadline has passed,
+      // rather than waiting for the next table read to notice it.
+      *status = Status::TimedOut();
+      if (db_statistics_ != nullptr) {
+        get_context.ReportCounters();
+      }
+      return;
+    }
     if (get_context.sample()) {
       sample_file_read_inc(f->file_metadata);
     }
@@ -2548,22 +2590,90 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
       // is faster.
       if (!read_options.async_io || !using_coroutines() || !use_async_io_ ||
           fp.GetHitFileLevel() == 0 || !fp.RemainingOverlapInLevel()) {
-        if (f) {
-          bool skip_filters =
-              IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
-                              fp.IsHitFileLastInLevel());
-          // Call MultiGetFromSST for looking up a single file
-          s = MultiGetFromSST(read_options, fp.CurrentFileRange(),
-                              fp.GetHitFileLevel(), skip_filters,
-                              /*skip_range_deletions=*/false, f, blob_ctxs,
-                              /*table_handle=*/nullptr, num_filter_read,
-                              num_index_read, num_sst_read);
-          if (fp.GetHitFileLevel() == 0) {
-            dump_stats_for_l0_file = true;
+        if (f != nullptr && fp.GetHitFileLevel() > 0 &&
+            fp.RemainingOverlapInLevel()) {
+          // The batch spans multiple files in this level. Probe every
+          // candidate file's filter first - the filter blocks are usually
+          // cache resident - so keys are eliminated before any data block
+          // read is issued, and the surviving lookups then go to each file
+          // as one batch. This mirrors the structure of the coroutine path
+          // below, minus the parallel scheduling.
+          struct FilteredFileRange {
+            MultiGetRange file_range;
+            FdWithKeyRange* f;
+            TableCache::TypedHandle* table_handle;
+            bool skip_filters;
+            bool skip_range_deletions;
+          };
+          autovector<FilteredFileRange, 4> filtered_ranges;
+          while (f != nullptr) {
+            MultiGetRange file_range = fp.CurrentFileRange();
+            TableCache::TypedHandle* table_handle = nullptr;
+            bool skip_filters =
+                IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
+                                fp.IsHitFileLastInLevel());
+            bool skip_range_deletions = false;
+            if (!skip_filters) {
+              Status status = table_cache_->MultiGetFilter(
+                  read_options, *internal_comparator(), *f->file_metadata,
+                  mutable_cf_options_.prefix_extractor,
+                  cfd_->internal_stats()->GetFileReadHist(
+                      fp.GetHitFileLevel()),
+                  fp.GetHitFileLevel(), &file_range, &table_handle);
+              skip_range_deletions = true;
+              if (status.ok()) {
+                skip_filters = true;
+              } else if (!status.IsNotSupported()) {
+                s = status;
+              }
+            }
+
+            if (!s.ok()) {
+              break;
+            }
+
+            if (!file_range.empty()) {
+              filtered_ranges.push_back({file_range, f, table_handle,
+                                         skip_filters, skip_range_deletions});
+            }
+            if (fp.KeyMaySpanNextFile()) {
+              break;
+            }
+            f = fp.GetNextFileInLevel();
+          }
+          if (s.ok()) {
+            for (FilteredFileRange& ffr : filtered_ranges) {
+              s = MultiGetFromSST(read_options, ffr.file_range,
+                                  fp.GetHitFileLevel(), ffr.skip_filters,
+                                  ffr.skip_range_deletions, ffr.f, blob_ctxs,
+                                  ffr.table_handle, num_filter_read,
+                                  num_index_read, num_sst_read);
+              if (!s.ok()) {
+                break;
+              }
+            }
+            if (s.ok() && fp.KeyMaySpanNextFile()) {
+              f = fp.GetNextFileInLevel();
+            }
+          }
+        } else {
+          if (f) {
+            bool skip_filters =
+                IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
+                                fp.IsHitFileLastInLevel());
+            // Call MultiGetFromSST for looking up a single file
+            s = MultiGetFromSST(read_options, fp.CurrentFileRange(),
+                                fp.GetHitFileLevel(), skip_filters,
+                                /*skip_range_deletions=*/false, f, blob_ctxs,
+                                /*table_handle=*/nullptr, num_filter_read,
+                                num_index_read, num_sst_read);
+            if (fp.GetHitFileLevel() == 0) {
+              dump_stats_for_l0_file = true;
+            }
+          }
+          if (s.ok()) {
+            f = fp.GetNextFileInLevel();
           }
-        }
-        if (s.ok()) {
-          f = fp.GetNextFileInLevel();
         }
 #if USE_COROUTINES
       } else {
@@ -2978,6 +3088,29 @@ void VersionStorageInfo::GenerateLevelFilesBrief() {
     DoGenerateLevelFilesBrief(&level_files_brief_[level], files_[level],
                               &arena_);
   }
+  // Precompute the aggregate user-key span of level 0, so that point lookups
+  // can skip the whole level with two comparisons when the key falls outside
+  // it, instead of range-checking every (possibly overlapping) file. See
+  // FilePicker::PrepareNextLevel().
+  if (!level_files_brief_.empty() && level_files_brief_[0].num_files > 0) {
+    auto& brief = level_files_brief_[0];
+    Slice smallest = ExtractUserKey(brief.files[0].smallest_key);
+    Slice largest = ExtractUserKey(brief.files[0].largest_key);
+    for (size_t i = 1; i < brief.num_files; i++) {
+      Slice file_smallest = ExtractUserKey(brief.files[i].smallest_key);
+      Slice file_largest = ExtractUserKey(brief.files[i].largest_key);
+      if (user_comparator_->CompareWithoutTimestamp(file_smallest, smallest) <
+          0) {
+        smallest = file_smallest;
+      }
+      if (user_comparator_->CompareWithoutTimestamp(file_largest, largest) >
+          0) {
+        largest = file_largest;
+      }
+    }
+    brief.smallest_user_key = smallest;
+    brief.largest_user_key = largest;
+  }
 }
 
 void VersionStorageInfo::PrepareForVersionAppend(
@@ -2994,6 +3127,134 @@ void VersionStorageInfo::PrepareForVersionAppend(
     GenerateBottommostFiles();
   }
   GenerateFileLocationIndex();
+  GenerateRangeStatsSummary();
+}
+
+void VersionStorageInfo::GenerateRangeStatsSummary() {
+  cumulative_range_entries_.clear();
+  cumulative_range_bytes_.clear();
+  cumulative_range_entries_.resize(num_levels_);
+  cumulative_range_bytes_.resize(num_levels_);
+  // Average entry size across the sampled files of the column family; used
+  // to approximate the entry count of files whose table properties were not
+  // loaded yet.
+  uint64_t avg_entry_size = 0;
+  const uint64_t accumulated_entries =
+      accumulated_num_non_deletions_ + accumulated_num_deletions_;
+  if (accumulated_entries > 0) {
+    avg_entry_size =
+        (accumulated_raw_key_size_ + accumulated_raw_value_size_) /
+        accumulated_entries;
+  }
+  for (int level = 0; level < num_levels_; level++) {
+    const auto& files = files_[level];
+    auto& entries = cumulative_range_entries_[level];
+    auto& bytes = cumulative_range_bytes_[level];
+    entries.resize(files.size() + 1);
+    bytes.resize(files.size() + 1);
+    entries[0] = 0;
+    bytes[0] = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+      const FileMetaData* f = files[i];
+      uint64_t file_entries = f->num_entries;
+      if (file_entries == 0 && avg_entry_size > 0) {
+        file_entries = f->fd.GetFileSize() / avg_entry_size;
+      }
+      entries[i + 1] = entries[i] + file_entries;
+      bytes[i + 1] = bytes[i] + f->fd.GetFileSize();
+    }
+  }
+}
+
+void VersionStorageInfo::EstimateRangeStats(const Slice& start,
+                                            const Slice& limit,
+                                            uint64_t* num_keys,
+                                            uint64_t* num_bytes) const {
+  *num_keys = 0;
+  *num_bytes = 0;
+  const Comparator* ucmp = user_comparator_;
+  for (int level = 0; level < num_non_empty_levels_; level++) {
+    const auto& brief = level_files_brief_[level];
+    if (brief.num_files == 0) {
+      continue;
+    }
+    assert(cumulative_range_entries_[level].size() == brief.num_files + 1);
+    const auto& entries = cumulative_range_entries_[level];
+    const auto& bytes = cumulative_range_bytes_[level];
+    // Add the contribution of one file: its full totals when it lies
+    // entirely inside [start, limit), half of them when it straddles a
+    // boundary.
+    auto add_file = [&](size_t i) {
+      const Slice fs = ExtractUserKey(brief.files[i].smallest_key);
+      const Slice fl = ExtractUserKey(brief.files[i].largest_key);
+      if (ucmp->CompareWithoutTimestamp(fl, start) < 0 ||
+          ucmp->CompareWithoutTimestamp(fs, limit) >= 0) {
+        return;
+      }
+      const uint64_t file_entries = entries[i + 1] - entries[i];
+      const uint64_t file_bytes = bytes[i + 1] - bytes[i];
+      if (ucmp->CompareWithoutTimestamp(fs, start) >= 0 &&
+          ucmp->CompareWithoutTimestamp(fl, limit) < 0) {
+        *num_keys += file_entries;
+        *num_bytes += file_bytes;
+      } else {
+        *num_keys += file_entries / 2;
+        *num_bytes += file_bytes / 2;
+      }
+    };
+    if (level == 0) {
+      // L0 files may overlap each other, examine each of them
+      for (size_t i = 0; i < brief.num_files; i++) {
+        add_file(i);
+      }
+      continue;
+    }
+    // Files are disjoint and sorted: binary search for the first file whose
+    // largest key reaches start and for the first file whose smallest key
+    // reaches limit, then take the interior files from the prefix sums.
+    size_t lo = 0;
+    {
+      size_t l = 0;
+      size_t r = brief.num_files;
+      while (l < r) {
+        const size_t m = l + (r - l) / 2;
+        if (ucmp->CompareWithoutTimestamp(
+                ExtractUserKey(brief.files[m].largest_key), start) < 0) {
+          l = m + 1;
+        } else {
+          r = m;
+        }
+      }
+      lo = l;
+    }
+    size_t hi = 0;
+    {
+      size_t l = 0;
+      size_t r = brief.num_files;
+      while (l < r) {
+        const size_t m = l + (r - l) / 2;
+        if (ucmp->CompareWithoutTimestamp(
+                ExtractUserKey(brief.files[m].smallest_key), limit) < 0) {
+          l = m + 1;
+        } else {
+          r = m;
+        }
+      }
+      hi = l;
+    }
+    if (lo >= hi) {
+      continue;
+    }
+    // Files (lo, hi - 1) lie entirely inside the range.
+    if (hi - lo > 2) {
+      *num_keys += entries[hi - 1] - entries[lo + 1];
+      *num_bytes += bytes[hi - 1] - bytes[lo + 1];
+    }
+    add_file(lo);
+    if (hi - 1 != lo) {
+      add_file(hi - 1);
+    }
+  }
 }
 
 void Version::PrepareAppend(const MutableCFOptions& mutable_cf_options,
@@ -3579,14 +3840,15 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
     return;
   }
 
-  // Compute the sum of total and garbage bytes over the oldest batch of blob
-  // files. The oldest batch is defined as the set of blob files which are
-  // kept alive by the same SSTs as the very oldest one. Here is a toy example.
-  // Let's assume we have three SSTs 1, 2, and 3, and four blob files 10, 11,
-  // 12, and 13. Also, let's say SSTs 1 and 2 both rely on blob file 10 and
-  // potentially some higher-numbered ones, while SST 3 relies on blob file 12
-  // and potentially some higher-numbered ones. Then, the SST to oldest blob
-  // file mapping is as follows:
+  // Walk the age-eligible prefix of the blob file list batch by batch. A
+  // batch is a blob file with a non-empty linked SST set plus any newer blob
+  // files which are kept alive by the same SSTs (i.e. files with an empty
+  // linked SST set). Here is a toy example. Let's assume we have three SSTs
+  // 1, 2, and 3, and four blob files 10, 11, 12, and 13. Also, let's say
+  // SSTs 1 and 2 both rely on blob file 10 and potentially some
+  // higher-numbered ones, while SST 3 relies on blob file 12 and potentially
+  // some higher-numbered ones. Then, the SST to oldest blob file mapping is
+  // as follows:
   //
   // SST file number               Oldest blob file number
   // 1                             10
@@ -3602,70 +3864,83 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
   // 12                            {3}
   // 13                            {}
   //
-  // Then, the oldest batch of blob files consists of blob files 10 and 11,
-  // and we can get rid of them by forcing the compaction of SSTs 1 and 2.
+  // Then, the first batch of blob files consists of blob files 10 and 11,
+  // and we can get rid of them by forcing the compaction of SSTs 1 and 2;
+  // the second batch consists of blob files 12 and 13 and additionally
+  // requires compacting SST 3.
   //
-  // Note that the overall ratio of garbage computed for the batch has to exceed
-  // blob_garbage_collection_force_threshold and the entire batch has to be
-  // eligible for GC according to blob_garbage_collection_age_cutoff in order
-  // for us to schedule any compactions.
-  const auto& oldest_meta = blob_files_.front();
-  assert(oldest_meta);
+  // Since freeing the files of a batch requires rewriting the linked SSTs of
+  // all batches up to and including it, we schedule the compaction of the
+  // linked SSTs of the longest prefix of complete batches whose overall
+  // ratio of garbage reaches blob_garbage_collection_force_threshold.
+  // (Every file of the prefix also has to be eligible for GC according to
+  // blob_garbage_collection_age_cutoff.) Considering batches beyond the
+  // oldest one means that a low-garbage oldest batch cannot indefinitely
+  // hold back the collection of heavily fragmented younger blob files.
+  assert(blob_files_.front());
+  assert(!blob_files_.front()->GetLinkedSsts().empty());
+  assert(cutoff_count <= blob_files_.size());
 
-  const auto& linked_ssts = oldest_meta->GetLinkedSsts();
-  assert(!linked_ssts.empty());
+  uint64_t sum_total_blob_bytes = 0;
+  uint64_t sum_garbage_blob_bytes = 0;
 
-  size_t count = 1;
-  uint64_t sum_total_blob_bytes = oldest_meta->GetTotalBlobBytes();
-  uint64_t sum_garbage_blob_bytes = oldest_meta->GetGarbageBlobBytes();
-
-  assert(cutoff_count <= blob_files_.size());
+  // Number of leading blob files whose linked SSTs are to be compacted
+  size_t marked_count = 0;
 
+  size_t count = 0;
   for (; count < cutoff_count; ++count) {
     const auto& meta = blob_files_[count];
     assert(meta);
 
-    if (!meta->GetLinkedSsts().empty()) {
-      // Found the beginning of the next batch of blob files
-      break;
+    if (count > 0 && !meta->GetLinkedSsts().empty()) {
+      // The previous batch is complete; check whether the prefix so far
+      // clears the threshold.
+      if (sum_garbage_blob_bytes >=
+          blob_garbage_collection_force_threshold * sum_total_blob_bytes) {
+        marked_count = count;
+      }
     }
 
     sum_total_blob_bytes += meta->GetTotalBlobBytes();
     sum_garbage_blob_bytes += meta->GetGarbageBlobBytes();
   }
 
-  if (count < blob_files_.size()) {
-    const auto& meta = blob_files_[count];
-    assert(meta);
-
-    if (meta->GetLinkedSsts().empty()) {
-      // Some files in the oldest batch are not eligible for GC
-      return;
+  // The last batch of the prefix is complete only if the file right after the
+  // prefix (if any) starts a new batch.
+  if (count == blob_files_.size() ||
+      !blob_files_[count]->GetLinkedSsts().empty()) {
+    if (sum_garbage_blob_bytes >=
+        blob_garbage_collection_force_threshold * sum_total_blob_bytes) {
+      marked_count = count;
     }
   }
 
-  if (sum_garbage_blob_bytes <
-      blob_garbage_collection_force_threshold * sum_total_blob_bytes) {
+  if (!marked_count) {
     return;
   }
 
-  for (uint64_t sst_file_number : linked_ssts) {
-    const FileLocation location = GetFileLocation(sst_file_number);
-    assert(location.IsValid());
+  for (size_t i = 0; i < marked_count; ++i) {
+    const auto& meta = blob_files_[i];
+    assert(meta);
 
-    const int level = location.GetLevel();
-    assert(level >= 0);
+    for (uint64_t sst_file_number : meta->GetLinkedSsts()) {
+      const FileLocation location = GetFileLocation(sst_file_number);
+      assert(location.IsValid());
 
-    const size_t pos = location.GetPosition();
+      const int level = location.GetLevel();
+      assert(level >= 0);
 
-    FileMetaData* const sst_meta = files_[level][pos];
-    assert(sst_meta);
+      const size_t pos = location.GetPosition();
 
-    if (sst_meta->being_compacted) {
-      continue;
-    }
+      FileMetaData* const sst_meta = files_[level][pos];
+      assert(sst_meta);
+
+      if (sst_meta->being_compacted) {
+        continue;
+      }
 
-    files_marked_for_forced_blob_gc_.emplace_back(level, sst_meta);
+      files_marked_for_forced_blob_gc_.emplace_back(level, sst_meta);
+    }
   }
 }
 
@@ -4973,6 +5248,10 @@ Status VersionSet::ProcessManifestWrites(
   } else {
     auto it = manifest_writers_.cbegin();
     size_t group_start = std::numeric_limits<size_t>::max();
+    // Index into `versions` by column family ID, so that forming a large
+    // group commit over many column families stays linear in the number of
+    // queued writers.
+    UnorderedMap<uint32_t, size_t> cf_to_version_idx;
     while (it != manifest_writers_.cend()) {
       if ((*it)->edit_list.front()->IsColumnFamilyManipulation()) {
         // no group commits for column family add or drop
@@ -5013,20 +5292,18 @@ Status VersionSet::ProcessManifestWrites(
         }
         continue;
       }
-      // We do a linear search on versions because versions is small.
-      // TODO(yanqin) maybe consider unordered_map
       Version* version = nullptr;
       VersionBuilder* builder = nullptr;
-      for (int i = 0; i != static_cast<int>(versions.size()); ++i) {
+      {
         uint32_t cf_id = last_writer->cfd->GetID();
-        if (versions[i]->cfd()->GetID() == cf_id) {
-          version = versions[i];
+        auto version_iter = cf_to_version_idx.find(cf_id);
+        if (version_iter != cf_to_version_idx.end()) {
+          version = versions[version_iter->second];
           assert(!builder_guards.empty() &&
                  builder_guards.size() == versions.size());
-          builder = builder_guards[i]->version_builder();
+          builder = builder_guards[version_iter->second]->version_builder();
           TEST_SYNC_POINT_CALLBACK(
               "VersionSet::ProcessManifestWrites:SameColumnFamily", &cf_id);
-          break;
         }
       }
       if (version == nullptr) {
@@ -5035,6 +5312,8 @@ Status VersionSet::ProcessManifestWrites(
           version = new Version(last_writer->cfd, this, file_options_,
                                 last_writer->mutable_cf_options, io_tracer_,
                                 current_version_number_++);
+          cf_to_version_idx.emplace(last_writer->cfd->GetID(),
+                                    versions.size());
           versions.push_back(version);
           mutable_cf_options_ptrs.push_back(&last_writer->mutable_cf_options);
           builder_guards.emplace_back(
@@ -5068,19 +5347,10 @@ Status VersionSet::ProcessManifestWrites(
         batch_edits.push_back(e);
       }
     }
-    for (int i = 0; i < static_cast<int>(versions.size()); ++i) {
-      assert(!builder_guards.empty() &&
-             builder_guards.size() == versions.size());
-      auto* builder = builder_guards[i]->version_builder();
-      Status s = builder->SaveTo(versions[i]->storage_info());
-      if (!s.ok()) {
-        // free up the allocated memory
-        for (auto v : versions) {
-          delete v;
-        }
-        return s;
-      }
-    }
+    // Saving the builders' state into the new versions is deferred to the
+    // unlocked section below: with a large file count the merge of base and
+    // added files is the most expensive part of LogAndApply, and nothing
+    // before the manifest write reads the new versions' storage.
   }
 
 #ifndef NDEBUG
@@ -5165,7 +5435,17 @@ Status VersionSet::ProcessManifestWrites(
     TEST_SYNC_POINT("VersionSet::LogAndApply:WriteManifestStart");
     TEST_SYNC_POINT_CALLBACK("VersionSet::LogAndApply:WriteManifest", nullptr);
     if (!first_writer.edit_list.front()->IsColumnFamilyManipulation()) {
-      for (int i = 0; i < static_cast<int>(versions.size()); ++i) {
+      // Materialize the builders' state into the new versions without
+      // holding the DB mutex. The builders are not mutated anymore at this
+      // point, their base versions are referenced, and the new versions do
+      // not become visible to anyone until AppendVersion() below.
+      for (int i = 0; s.ok() && i < static_cast<int>(versions.size()); ++i) {
+        assert(!builder_guards.empty() &&
+               builder_guards.size() == versions.size());
+        auto* builder = builder_guards[i]->version_builder();
+        s = builder->SaveTo(versions[i]->storage_info());
+      }
+      for (int i = 0; s.ok() && i < static_cast<int>(versions.size()); ++i) {
         assert(!builder_guards.empty() &&
                builder_guards.size() == versions.size());
         assert(!mutable_cf_options_ptrs.empty() &&
@@ -5231,7 +5511,7 @@ Status VersionSet::ProcessManifestWrites(
 #endif
       for (auto& e : batch_edits) {
         std::string record;
-        if (!e->EncodeTo(&record)) {
+        if (!e->EncodeTo(&record, db_options_->manifest_delta_encoding)) {
           s = Status::Corruption("Unable to encode VersionEdit:" +
                                  e->DebugString(true));
           break;
@@ -6327,7 +6607,7 @@ Status VersionSet::WriteCurrentStateToManifest(
       edit.SetLastSequence(descriptor_last_sequence_);
 
       std::string record;
-      if (!edit.EncodeTo(&record)) {
+      if (!edit.EncodeTo(&record, db_options_->manifest_delta_encoding)) {
         return Status::Corruption("Unable to Encode VersionEdit:" +
                                   edit.DebugString(true));
       }
@@ -6459,17 +6739,50 @@ uint64_t VersionSet::ApproximateSize(const SizeApproximationOptions& options,
                         static_cast<uint64_t>(total_full_size * margin)) {
     total_full_size += total_intersecting_size / 2;
   } else {
-    // Estimate for all the first files (might also be last files), at each
-    // level
-    for (const auto file_ptr : first_files) {
-      total_full_size += ApproximateSize(v, *file_ptr, start, end, caller);
-    }
+    // Estimate the first and last files at each level. Each estimate may have
+    // to open the file and consult its index block, so on large installations
+    // this dominates the cost of the call; spread the per-file work over up to
+    // max_file_opening_threads threads (the table cache is thread safe). The
+    // first files (which might also be last files) are estimated with
+    // ApproximateSize(); for the last files calling ApproximateOffsetOf()
+    // directly is just more efficient.
+    const size_t num_files = first_files.size() + last_files.size();
+    std::vector<uint64_t> file_sizes(num_files, 0);
+    std::atomic<size_t> next_file_idx(0);
+    auto estimate_files_func = [&]() {
+      while (true) {
+        const size_t i = next_file_idx.fetch_add(1);
+        if (i >= num_files) {
+          break;
+        }
+        if (i < first_files.size()) {
+          file_sizes[i] = ApproximateSize(v, *first_files[i], start, end,
+                                          caller);
+        } else {
+          file_sizes[i] = ApproximateOffsetOf(
+              v, *last_files[i - first_files.size()], end, caller);
+        }
+      }
+    };
 
-    // Estimate for all the last files, at each level
-    for (const auto file_ptr : last_files) {
-      // We could use ApproximateSize here, but calling ApproximateOffsetOf
-      // directly is just more efficient.
-      total_full_size += ApproximateOffsetOf(v, *file_ptr, end, caller);
+    const size_t num_threads = std::min(
+        num_files, static_cast<size_t>(
+                       std::max(1, db_options_->max_file_opening_threads)));
+    if (num_threads <= 1) {
+      estimate_files_func();
+    } else {
+      std::vector<port::Thread> threads;
+      threads.reserve(num_threads - 1);
+      for (size_t i = 0; i < num_threads - 1; ++i) {
+        threads.emplace_back(estimate_files_func);
+      }
+      estimate_files_func();
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+    for (const uint64_t file_size : file_sizes) {
+      total_full_size += file_size;
     }
   }
 
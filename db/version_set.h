@@ -199,6 +199,16 @@ class VersionStorageInfo {
   // REQUIRES: PrepareForVersionAppend has been called
   void SetFinalized();
 
+  // Estimate the number of entries and file bytes in SST files whose keys
+  // fall in the user-key range [start, limit), using the summary
+  // materialized by PrepareForVersionAppend(). Files straddling a range
+  // boundary contribute half of their totals, which bounds the error by the
+  // contents of the boundary files. Entries in memtables and duplicates
+  // across sorted runs are not accounted for.
+  // REQUIRES: PrepareForVersionAppend has been called
+  void EstimateRangeStats(const Slice& start, const Slice& limit,
+                          uint64_t* num_keys, uint64_t* num_bytes) const;
+
   // Update the accumulated stats from a file-meta.
   void UpdateAccumulatedStats(FileMetaData* file_meta);
 
@@ -632,6 +642,7 @@ class VersionStorageInfo {
   void GenerateLevel0NonOverlapping();
   void GenerateBottommostFiles();
   void GenerateFileLocationIndex();
+  void GenerateRangeStatsSummary();
 
   const InternalKeyComparator* internal_comparator_;
   const Comparator* user_comparator_;
@@ -643,6 +654,12 @@ class VersionStorageInfo {
 
   // A short brief metadata of files per level
   autovector<ROCKSDB_NAMESPACE::LevelFilesBrief> level_files_brief_;
+  // Per-level prefix sums over files_ of estimated entry counts and file
+  // sizes; entry i + 1 holds the totals of files_[level][0..i]. Materialized
+  // in PrepareForVersionAppend() so EstimateRangeStats() is answered with a
+  // few binary searches and no I/O.
+  std::vector<std::vector<uint64_t>> cumulative_range_entries_;
+  std::vector<std::vector<uint64_t>> cumulative_range_bytes_;
   FileIndexer file_indexer_;
   Arena arena_;  // Used to allocate space for file_levels_
 
@@ -883,7 +900,8 @@ class Version {
            PinnedIteratorsManager* pinned_iters_mgr,
            bool* value_found = nullptr, bool* key_exists = nullptr,
            SequenceNumber* seq = nullptr, ReadCallback* callback = nullptr,
-           bool* is_blob = nullptr, bool do_merge = true);
+           bool* is_blob = nullptr, bool do_merge = true,
+           bool stop_when_should_merge = false);
 
   void MultiGet(const ReadOptions&, MultiGetRange* range,
                 ReadCallback* callback = nullptr);
@@ -533,6 +533,26 @@ TEST_F(VersionStorageInfoTest, GetOverlappingInputs) {
             GetOverlappingFiles(1, {"i", 0, kTypeValue}, {"j", 0, kTypeValue}));
 }
 
+TEST_F(VersionStorageInfoTest, Level0UserKeySpan) {
+  // Overlapping L0 files; the aggregate span must cover all of them even
+  // though no single file does.
+  Add(0, 1U, "d", "j", 1);
+  Add(0, 2U, "b", "f", 1);
+  Add(0, 3U, "h", "p", 1);
+  // L1 bounds must not leak into the L0 span.
+  Add(1, 4U, "a", "z", 1);
+
+  UpdateVersionStorageInfo();
+
+  const auto& l0_brief = vstorage_.LevelFilesBrief(0);
+  ASSERT_EQ("b", l0_brief.smallest_user_key.ToString());
+  ASSERT_EQ("p", l0_brief.largest_user_key.ToString());
+
+  const auto& l1_brief = vstorage_.LevelFilesBrief(1);
+  ASSERT_TRUE(l1_brief.smallest_user_key.empty());
+  ASSERT_TRUE(l1_brief.largest_user_key.empty());
+}
+
 TEST_F(VersionStorageInfoTest, FileLocationAndMetaDataByNumber) {
   Add(0, 11U, "1", "2", 5000U);
   Add(0, 12U, "1", "2", 5000U);
@@ -887,6 +907,48 @@ TEST_F(VersionStorageInfoTest, ForcedBlobGCMultipleBatches) {
     ASSERT_EQ(ssts_to_be_compacted[0], expected_ssts_to_be_compacted[0]);
     ASSERT_EQ(ssts_to_be_compacted[1], expected_ssts_to_be_compacted[1]);
   }
+
+  // With the entire blob file list eligible based on age, the first batch
+  // clears the threshold on its own but the cumulative garbage ratio of both
+  // batches does not, so only the first batch's linked SSTs are marked.
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.2;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold);
+
+    auto ssts_to_be_compacted = vstorage_.FilesMarkedForForcedBlobGC();
+    ASSERT_EQ(ssts_to_be_compacted.size(), 2);
+  }
+
+  // With a lower threshold that the cumulative garbage ratio of both batches
+  // clears as well, the linked SSTs of both batches are marked.
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.1;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold);
+
+    auto ssts_to_be_compacted = vstorage_.FilesMarkedForForcedBlobGC();
+    ASSERT_EQ(ssts_to_be_compacted.size(), 3);
+
+    std::sort(ssts_to_be_compacted.begin(), ssts_to_be_compacted.end(),
+              [](const std::pair<int, FileMetaData*>& lhs,
+                 const std::pair<int, FileMetaData*>& rhs) {
+                assert(lhs.second);
+                assert(rhs.second);
+                return lhs.second->fd.GetNumber() < rhs.second->fd.GetNumber();
+              });
+
+    const autovector<std::pair<int, FileMetaData*>>
+        expected_ssts_to_be_compacted{{level, level_files[0]},
+                                      {level, level_files[1]},
+                                      {level, level_files[2]}};
+
+    ASSERT_EQ(ssts_to_be_compacted[0], expected_ssts_to_be_compacted[0]);
+    ASSERT_EQ(ssts_to_be_compacted[1], expected_ssts_to_be_compacted[1]);
+    ASSERT_EQ(ssts_to_be_compacted[2], expected_ssts_to_be_compacted[2]);
+  }
 }
 
 class VersionStorageInfoTimestampTest : public VersionStorageInfoTestBase {
@@ -815,6 +815,62 @@ Status WriteBatchInternal::Put(WriteBatch* b, uint32_t column_family_id,
   return save.commit();
 }
 
+void WriteBatch::Reserve(size_t total_bytes) { rep_.reserve(total_bytes); }
+
+Status WriteBatchInternal::PutUninitialized(WriteBatch* b,
+                                            uint32_t column_family_id,
+                                            size_t key_len, size_t value_len,
+                                            char** key_out, char** value_out) {
+  assert(key_out != nullptr);
+  assert(value_out != nullptr);
+  if (key_len > size_t{std::numeric_limits<uint32_t>::max()}) {
+    return Status::InvalidArgument("key is too large");
+  }
+  if (value_len > size_t{std::numeric_limits<uint32_t>::max()}) {
+    return Status::InvalidArgument("value is too large");
+  }
+  if (b->prot_info_ != nullptr) {
+    // Protection info is computed from the key and value contents, which do
+    // not exist yet when this record is appended.
+    return Status::NotSupported(
+        "PutUninitialized does not support per-key-value protection");
+  }
+
+  LocalSavePoint save(b);
+  WriteBatchInternal::SetCount(b, WriteBatchInternal::Count(b) + 1);
+  if (column_family_id == 0) {
+    b->rep_.push_back(static_cast<char>(kTypeValue));
+  } else {
+    b->rep_.push_back(static_cast<char>(kTypeColumnFamilyValue));
+    PutVarint32(&b->rep_, column_family_id);
+  }
+  PutVarint32(&b->rep_, static_cast<uint32_t>(key_len));
+  const size_t key_offset = b->rep_.size();
+  b->rep_.resize(key_offset + key_len);
+  PutVarint32(&b->rep_, static_cast<uint32_t>(value_len));
+  const size_t value_offset = b->rep_.size();
+  b->rep_.resize(value_offset + value_len);
+  // Set the output pointers only after the final resize; either resize may
+  // reallocate the buffer.
+  *key_out = &b->rep_[0] + key_offset;
+  *value_out = &b->rep_[0] + value_offset;
+  b->content_flags_.store(
+      b->content_flags_.load(std::memory_order_relaxed) | ContentFlags::HAS_PUT,
+      std::memory_order_relaxed);
+  return save.commit();
+}
+
+Status WriteBatch::PutUninitialized(ColumnFamilyHandle* column_family,
+                                    size_t key_len, size_t value_len,
+                                    char** key_out, char** value_out) {
+  uint32_t cf_id = 0;
+  if (column_family != nullptr) {
+    cf_id = column_family->GetID();
+  }
+  return WriteBatchInternal::PutUninitialized(this, cf_id, key_len, value_len,
+                                              key_out, value_out);
+}
+
 Status WriteBatch::Put(ColumnFamilyHandle* column_family, const Slice& key,
                        const Slice& value) {
   size_t ts_sz = 0;
@@ -1785,6 +1841,11 @@ class MemTableInserter : public WriteBatch::Handler {
 
   bool hint_per_batch_;
   bool hint_created_;
+  // When set, only updates of this column family are applied; entries of
+  // other column families are skipped while the sequence still advances.
+  // This lets several inserters walk the same batch concurrently, each
+  // owning a disjoint set of column families.
+  uint32_t cf_filter_;
   // Hints for this batch
   using HintMap = std::unordered_map<MemTable*, void*>;
   using HintMapType = std::aligned_storage<sizeof(HintMap)>::type;
@@ -1886,7 +1947,8 @@ class MemTableInserter : public WriteBatch::Handler {
         duplicate_detector_(),
         dup_dectector_on_(false),
         hint_per_batch_(hint_per_batch),
-        hint_created_(false) {
+        hint_created_(false),
+        cf_filter_(WriteBatchInternal::kAllColumnFamilies) {
     assert(cf_mems_);
   }
 
@@ -1910,6 +1972,8 @@ class MemTableInserter : public WriteBatch::Handler {
   MemTableInserter(const MemTableInserter&) = delete;
   MemTableInserter& operator=(const MemTableInserter&) = delete;
 
+  void set_cf_filter(uint32_t cf_id) { cf_filter_ = cf_id; }
+
   // The batch seq is regularly restarted; In normal mode it is set when
   // MemTableInserter is constructed in the write thread and in recovery mode it
   // is set when a batch, which is tagged with seq, is read from the WAL.
@@ -1946,6 +2010,14 @@ class MemTableInserter : public WriteBatch::Handler {
   }
 
   bool SeekToColumnFamily(uint32_t column_family_id, Status* s) {
+    if (cf_filter_ != WriteBatchInternal::kAllColumnFamilies &&
+        column_family_id != cf_filter_) {
+      // Another inserter of a parallel batch apply owns this column family.
+      // Skipping here still advances the seq in the caller so every inserter
+      // assigns the same sequence numbers to the same entries.
+      *s = Status::OK();
+      return false;
+    }
     // If we are in a concurrent mode, it is the caller's responsibility
     // to clone the original ColumnFamilyMemTables so that each thread
     // has its own instance.  Otherwise, it must be guaranteed that there
@@ -2940,12 +3012,14 @@ Status WriteBatchInternal::InsertInto(
     TrimHistoryScheduler* trim_history_scheduler,
     bool ignore_missing_column_families, uint64_t log_number, DB* db,
     bool concurrent_memtable_writes, SequenceNumber* next_seq,
-    bool* has_valid_writes, bool seq_per_batch, bool batch_per_txn) {
+    bool* has_valid_writes, bool seq_per_batch, bool batch_per_txn,
+    uint32_t cf_filter) {
   MemTableInserter inserter(Sequence(batch), memtables, flush_scheduler,
                             trim_history_scheduler,
                             ignore_missing_column_families, log_number, db,
                             concurrent_memtable_writes, batch->prot_info_.get(),
                             has_valid_writes, seq_per_batch, batch_per_txn);
+  inserter.set_cf_filter(cf_filter);
   Status s = batch->Iterate(&inserter);
   if (next_seq != nullptr) {
     *next_seq = inserter.sequence();
@@ -2958,6 +3032,76 @@ Status WriteBatchInternal::InsertInto(
 
 namespace {
 
+// Records the distinct column family ids a batch refers to.
+class ColumnFamilyCollector : public WriteBatch::Handler {
+ public:
+  explicit ColumnFamilyCollector(std::vector<uint32_t>* column_families)
+      : column_families_(column_families) {}
+
+  Status PutCF(uint32_t cf, const Slice&, const Slice&) override {
+    return AddColumnFamily(cf);
+  }
+
+  Status PutEntityCF(uint32_t cf, const Slice&, const Slice&) override {
+    return AddColumnFamily(cf);
+  }
+
+  Status DeleteCF(uint32_t cf, const Slice&) override {
+    return AddColumnFamily(cf);
+  }
+
+  Status SingleDeleteCF(uint32_t cf, const Slice&) override {
+    return AddColumnFamily(cf);
+  }
+
+  Status DeleteRangeCF(uint32_t cf, const Slice&, const Slice&) override {
+    return AddColumnFamily(cf);
+  }
+
+  Status MergeCF(uint32_t cf, const Slice&, const Slice&) override {
+    return AddColumnFamily(cf);
+  }
+
+  Status PutBlobIndexCF(uint32_t cf, const Slice&, const Slice&) override {
+    return AddColumnFamily(cf);
+  }
+
+  Status MarkBeginPrepare(bool) override { return Status::OK(); }
+
+  Status MarkEndPrepare(const Slice&) override { return Status::OK(); }
+
+  Status MarkNoop(bool) override { return Status::OK(); }
+
+  Status MarkRollback(const Slice&) override { return Status::OK(); }
+
+  Status MarkCommit(const Slice&) override { return Status::OK(); }
+
+  Status MarkCommitWithTimestamp(const Slice&, const Slice&) override {
+    return Status::OK();
+  }
+
+ private:
+  Status AddColumnFamily(uint32_t cf) {
+    if (std::find(column_families_->begin(), column_families_->end(), cf) ==
+        column_families_->end()) {
+      column_families_->push_back(cf);
+    }
+    return Status::OK();
+  }
+
+  std::vector<uint32_t>* column_families_;
+};
+
+}  // anonymous namespace
+
+Status WriteBatchInternal::CollectColumnFamilies(
+    const WriteBatch* batch, std::vector<uint32_t>* column_families) {
+  ColumnFamilyCollector collector(column_families);
+  return batch->Iterate(&collector);
+}
+
+namespace {
+
 // This class updates protection info for a WriteBatch.
 class ProtectionInfoUpdater : public WriteBatch::Handler {
  public:
@@ -87,6 +87,10 @@ class WriteBatchInternal {
   static Status Put(WriteBatch* batch, uint32_t column_family_id,
                     const SliceParts& key, const SliceParts& value);
 
+  static Status PutUninitialized(WriteBatch* batch, uint32_t column_family_id,
+                                 size_t key_len, size_t value_len,
+                                 char** key_out, char** value_out);
+
   static Status PutEntity(WriteBatch* batch, uint32_t column_family_id,
                           const Slice& key, const WideColumns& columns);
 
@@ -182,8 +186,14 @@ class WriteBatchInternal {
       DB* db = nullptr, bool concurrent_memtable_writes = false,
       bool seq_per_batch = false, bool batch_per_txn = true);
 
+  // Sentinel for cf_filter below: apply updates of every column family.
+  static constexpr uint32_t kAllColumnFamilies = 0xFFFFFFFFu;
+
   // Convenience form of InsertInto when you have only one batch
   // next_seq returns the seq after last sequence number used in MemTable insert
+  // With cf_filter set, only updates of that column family are applied while
+  // the sequence still advances over the skipped entries, so several threads
+  // can apply disjoint column families of one batch concurrently.
   static Status InsertInto(
       const WriteBatch* batch, ColumnFamilyMemTables* memtables,
       FlushScheduler* flush_scheduler,
@@ -191,7 +201,12 @@ class WriteBatchInternal {
       bool ignore_missing_column_families = false, uint64_t log_number = 0,
       DB* db = nullptr, bool concurrent_memtable_writes = false,
       SequenceNumber* next_seq = nullptr, bool* has_valid_writes = nullptr,
-      bool seq_per_batch = false, bool batch_per_txn = true);
+      bool seq_per_batch = false, bool batch_per_txn = true,
+      uint32_t cf_filter = kAllColumnFamilies);
+
+  // Collects the distinct column family ids referenced by the batch.
+  static Status CollectColumnFamilies(const WriteBatch* batch,
+                                      std::vector<uint32_t>* column_families);
 
   static Status InsertInto(WriteThread::Writer* writer, SequenceNumber sequence,
                            ColumnFamilyMemTables* memtables,
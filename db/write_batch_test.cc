@@ -180,6 +180,43 @@ TEST_F(WriteBatchTest, Multiple) {
   ASSERT_EQ(4u, batch.Count());
 }
 
+TEST_F(WriteBatchTest, PutUninitialized) {
+  WriteBatch batch;
+  batch.Reserve(1024);
+  ASSERT_GE(batch.Data().capacity(), 1024u);
+
+  char* key = nullptr;
+  char* value = nullptr;
+  ASSERT_OK(batch.PutUninitialized(3, 3, &key, &value));
+  memcpy(key, "foo", 3);
+  memcpy(value, "bar", 3);
+  // The record must interoperate with regular operations.
+  ASSERT_OK(batch.Delete(Slice("box")));
+  ASSERT_OK(batch.PutUninitialized(3, 2, &key, &value));
+  memcpy(key, "baz", 3);
+  memcpy(value, "bo", 2);
+  WriteBatchInternal::SetSequence(&batch, 100);
+  ASSERT_EQ(3u, batch.Count());
+  ASSERT_EQ(
+      "Put(baz, bo)@102"
+      "Delete(box)@101"
+      "Put(foo, bar)@100",
+      PrintContents(&batch));
+
+  // Zero-length key and value are legal, like with Put().
+  batch.Clear();
+  ASSERT_OK(batch.PutUninitialized(0, 0, &key, &value));
+  ASSERT_EQ("Put(, )@0", PrintContents(&batch));
+
+  // Not supported with per-key-value protection: the protection info
+  // covers contents that do not exist yet.
+  WriteBatch protected_batch(0 /* reserved_bytes */, 0 /* max_bytes */,
+                             8 /* protection_bytes_per_key */,
+                             0 /* default_cf_ts_sz */);
+  ASSERT_TRUE(protected_batch.PutUninitialized(3, 3, &key, &value)
+                  .IsNotSupported());
+}
+
 TEST_F(WriteBatchTest, Corruption) {
   WriteBatch batch;
   ASSERT_OK(batch.Put(Slice("foo"), Slice("bar")));
@@ -128,8 +128,25 @@ bool WriteController::IsInRateMap(void* client_id) {
 // its write_rate is higher than the delayed_write_rate_ so we need to find a
 // new min from all clients via GetMapMinRate()
 void WriteController::HandleNewDelayReq(void* client_id,
-                                        uint64_t client_write_rate) {
+                                        uint64_t client_write_rate,
+                                        double weight) {
   assert(is_dynamic_delay());
+  // Out-of-range weights fall back to full throttling strength since thats
+  // the safe option with respect to write stalls.
+  if (!(weight > 0.0) || weight > 1.0) {
+    weight = 1.0;
+  }
+  const uint64_t max_rate = max_delayed_write_rate();
+  if (client_write_rate > max_rate) {
+    client_write_rate = max_rate;
+  }
+  if (weight < 1.0) {
+    // A weighted client only claims `weight` of the slowdown it requests -
+    // the recorded rate is pulled proportionally back toward the global
+    // budget, leaving the rest of it to writers of other clients.
+    client_write_rate = max_rate - static_cast<uint64_t>(
+                                       weight * (max_rate - client_write_rate));
+  }
   std::unique_lock<std::mutex> lock(map_mu_);
   bool was_min = IsMinRate(client_id);
   bool inserted =
@@ -152,8 +169,9 @@ void WriteController::HandleNewDelayReq(void* client_id,
     for (auto& logger_and_clients : loggers_to_client_ids_map_) {
       ROCKS_LOG_WARN(logger_and_clients.first.get(),
                      "WC setting delay of %" PRIu64
-                     ", client_id: %p, client rate: %" PRIu64,
-                     min_rate, client_id, client_write_rate);
+                     ", client_id: %p, client rate: %" PRIu64
+                     ", client weight: %f",
+                     min_rate, client_id, client_write_rate, weight);
     }
   }
 }
@@ -282,6 +282,36 @@ TEST_P(WriteControllerTest, DebtAccumulation) {
   ASSERT_EQ(0U, controller.GetDelay(clock_.get(), 100u /*small bytes*/));
 }
 
+// Weighted delay requests (dynamic delay only): a client's weight caps how
+// much of its requested slowdown is recorded on its behalf.
+TEST_F(WriteControllerTest, WeightedDelayReq) {
+  WriteController controller(true /*dynamic_delay*/, 100 MBPS);
+
+  // Full-weight client behaves as before.
+  controller.HandleNewDelayReq(this, 10 MBPS);
+  EXPECT_EQ(controller.delayed_write_rate(), 10 MBPS);
+
+  // Re-request with weight 0.5: only half of the requested slowdown is
+  // claimed, so the recorded rate is 100 - 0.5 * (100 - 10) = 55 MBPS.
+  controller.HandleNewDelayReq(this, 10 MBPS, 0.5);
+  EXPECT_EQ(controller.delayed_write_rate(), 55 MBPS);
+
+  // A second, full-weight client with a lower request takes over the min.
+  controller.HandleNewDelayReq(this + 1, 40 MBPS);
+  EXPECT_EQ(controller.delayed_write_rate(), 40 MBPS);
+  controller.HandleRemoveDelayReq(this + 1);
+  EXPECT_EQ(controller.delayed_write_rate(), 55 MBPS);
+
+  // Out-of-range weights are treated as full weight.
+  controller.HandleNewDelayReq(this, 10 MBPS, 0.0);
+  EXPECT_EQ(controller.delayed_write_rate(), 10 MBPS);
+  controller.HandleNewDelayReq(this, 10 MBPS, 2.0);
+  EXPECT_EQ(controller.delayed_write_rate(), 10 MBPS);
+
+  controller.HandleRemoveDelayReq(this);
+  EXPECT_FALSE(controller.NeedsDelay());
+}
+
 // This may or may not be a "good" feature, but it's an old feature
 TEST_F(WriteControllerTest, CreditAccumulation) {
   WriteController controller(false, 10 MBPS);
@@ -0,0 +1,43 @@
+//  Copyright (c) Facebook, Inc. and its affiliates. All Rights Reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/write_stall_timeline.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+void WriteStallTimeline::Record(const std::string& cf_name,
+                                WriteStallCondition prev,
+                                WriteStallCondition cur, WriteStallCause cause,
+                                uint64_t trigger_value, SystemClock* clock) {
+  const uint64_t now_ns = clock->NowNanos();
+
+  std::lock_guard<std::mutex> lock(mu_);
+  WriteStallTimelineEvent event;
+  event.cf_name = cf_name;
+  event.prev_condition = prev;
+  event.cur_condition = cur;
+  event.cause = cause;
+  event.trigger_value = trigger_value;
+  event.time_ns = now_ns;
+  auto it = last_transition_ns_.find(cf_name);
+  if (it != last_transition_ns_.end()) {
+    event.prev_condition_duration_ns = now_ns - it->second;
+    it->second = now_ns;
+  } else {
+    last_transition_ns_.emplace(cf_name, now_ns);
+  }
+  events_.push_back(std::move(event));
+  if (events_.size() > kMaxEvents) {
+    events_.pop_front();
+  }
+}
+
+void WriteStallTimeline::Get(
+    std::vector<WriteStallTimelineEvent>* events) const {
+  std::lock_guard<std::mutex> lock(mu_);
+  events->assign(events_.begin(), events_.end());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,47 @@
+//  Copyright (c) Facebook, Inc. and its affiliates. All Rights Reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rocksdb/system_clock.h"
+#include "rocksdb/types.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A bounded in-memory ring of recent write stall state transitions, kept per
+// DB (owned by ColumnFamilySet) and surfaced through
+// DB::GetWriteStallTimeline(). Recording only happens when a column family
+// changes stall condition, which is rare, so a plain mutex is cheap enough
+// here and keeps readers trivially consistent.
+class WriteStallTimeline {
+ public:
+  // Number of transitions retained before the oldest ones are dropped.
+  static constexpr size_t kMaxEvents = 256;
+
+  // Append a transition of `cf_name` from `prev` to `cur`. `cause` and
+  // `trigger_value` describe what pushed the column family into `cur`, see
+  // WriteStallTimelineEvent. Thread safe.
+  void Record(const std::string& cf_name, WriteStallCondition prev,
+              WriteStallCondition cur, WriteStallCause cause,
+              uint64_t trigger_value, SystemClock* clock);
+
+  // Copy out the retained events, oldest first. Thread safe.
+  void Get(std::vector<WriteStallTimelineEvent>* events) const;
+
+ private:
+  mutable std::mutex mu_;
+  std::deque<WriteStallTimelineEvent> events_;
+  // Per column family, the timestamp of its last recorded transition, used to
+  // compute how long the previous condition was in effect.
+  std::unordered_map<std::string, uint64_t> last_transition_ns_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
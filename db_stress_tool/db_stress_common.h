@@ -113,6 +113,11 @@ DECLARE_int32(compaction_readahead_size);
 DECLARE_bool(enable_pipelined_write);
 DECLARE_bool(verify_before_write);
 DECLARE_bool(histogram);
+DECLARE_string(perf_report_file);
+DECLARE_string(perf_baseline_file);
+DECLARE_double(perf_regression_threshold);
+DECLARE_uint64(perf_warmup_ops_per_thread);
+DECLARE_uint64(perf_ops_per_sec_per_thread);
 DECLARE_bool(destroy_db_initially);
 DECLARE_bool(verbose);
 DECLARE_bool(progress_reports);
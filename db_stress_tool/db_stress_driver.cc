@@ -180,6 +180,13 @@ bool RunStressTest(SharedState* shared) {
   }
   threads[0]->stats.Report("Stress Test");
 
+  bool perf_ok = true;
+  if (!FLAGS_perf_report_file.empty()) {
+    perf_ok = threads[0]->stats.ReportPerf(FLAGS_perf_report_file,
+                                           FLAGS_perf_baseline_file,
+                                           FLAGS_perf_regression_threshold);
+  }
+
   for (unsigned int i = 0; i < n; i++) {
     delete threads[i];
     threads[i] = nullptr;
@@ -205,6 +212,10 @@ bool RunStressTest(SharedState* shared) {
     fprintf(stderr, "Verification failed :(\n");
     return false;
   }
+  if (!perf_ok) {
+    fprintf(stderr, "Perf regression check failed :(\n");
+    return false;
+  }
   return true;
 }
 }  // namespace ROCKSDB_NAMESPACE
@@ -140,6 +140,32 @@ DEFINE_bool(verify_before_write, false, "Verify before write");
 
 DEFINE_bool(histogram, false, "Print histogram of operation timings");
 
+DEFINE_string(perf_report_file, "",
+              "If non-empty, record per-op-type latencies (excluding warmup) "
+              "and write a machine-readable report to this file at the end of "
+              "the run");
+
+DEFINE_string(perf_baseline_file, "",
+              "If non-empty, compare the report written to -perf_report_file "
+              "against the report in this file and fail the run when avg or "
+              "p99 latency of any op type regressed beyond "
+              "-perf_regression_threshold");
+
+DEFINE_double(perf_regression_threshold, 0.1,
+              "Maximum allowed fractional latency increase over "
+              "-perf_baseline_file before the run is reported as a "
+              "regression, e.g. 0.1 allows 10% slower");
+
+DEFINE_uint64(perf_warmup_ops_per_thread, 0,
+              "Number of operations per thread excluded from the latencies "
+              "recorded for -perf_report_file, so cache warmup does not skew "
+              "the numbers");
+
+DEFINE_uint64(perf_ops_per_sec_per_thread, 0,
+              "If nonzero, pace each thread to this many operations per "
+              "second so latency reports are comparable across runs and "
+              "machines with different peak throughput");
+
 DEFINE_bool(destroy_db_initially, true,
             "Destroys the database dir before start if this is true");
 
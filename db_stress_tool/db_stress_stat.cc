@@ -7,11 +7,125 @@
 
 #include "db_stress_tool/db_stress_stat.h"
 
+#include <cstdio>
+#include <map>
+
 namespace ROCKSDB_NAMESPACE {
 
 std::shared_ptr<ROCKSDB_NAMESPACE::Statistics> dbstats;
 std::shared_ptr<ROCKSDB_NAMESPACE::Statistics> dbstats_secondaries;
 
+const char* PerfOpTypeName(int op) {
+  switch (op) {
+    case kPerfRead:
+      return "read";
+    case kPerfPrefixScan:
+      return "prefix_scan";
+    case kPerfWrite:
+      return "write";
+    case kPerfDelete:
+      return "delete";
+    case kPerfDeleteRange:
+      return "delete_range";
+    case kPerfIterate:
+      return "iterate";
+    case kPerfCustom:
+      return "custom";
+    default:
+      return "unknown";
+  }
+}
+
+namespace {
+
+// One parsed line of a perf report: the metrics compared against a baseline.
+struct PerfBaselineEntry {
+  double avg = 0;
+  double p99 = 0;
+};
+
+}  // namespace
+
+bool Stats::ReportPerf(const std::string& report_path,
+                       const std::string& baseline_path,
+                       double threshold) const {
+  FILE* report = fopen(report_path.c_str(), "w");
+  if (report == nullptr) {
+    fprintf(stderr, "Cannot open perf report file %s\n", report_path.c_str());
+    return false;
+  }
+  // One line per op type that actually ran, all latencies in microseconds:
+  //   <op> <count> <avg> <p50> <p99> <p999> <max>
+  fprintf(report, "# db_stress perf report v1: op count avg p50 p99 p999 max\n");
+  for (int op = 0; op < kNumPerfOpTypes; ++op) {
+    const HistogramImpl& hist = perf_hists_[op];
+    if (hist.num() == 0) {
+      continue;
+    }
+    fprintf(report, "%s %" PRIu64 " %.2f %.2f %.2f %.2f %" PRIu64 "\n",
+            PerfOpTypeName(op), hist.num(), hist.Average(), hist.Median(),
+            hist.Percentile(99.0), hist.Percentile(99.9), hist.max());
+  }
+  fclose(report);
+
+  if (baseline_path.empty()) {
+    return true;
+  }
+  FILE* baseline = fopen(baseline_path.c_str(), "r");
+  if (baseline == nullptr) {
+    fprintf(stderr, "Cannot open perf baseline file %s\n",
+            baseline_path.c_str());
+    return false;
+  }
+  std::map<std::string, PerfBaselineEntry> baseline_entries;
+  char op_name[64];
+  uint64_t count;
+  uint64_t max_val;
+  double avg, p50, p99, p999;
+  char line[256];
+  while (fgets(line, sizeof(line), baseline) != nullptr) {
+    if (line[0] == '#') {
+      continue;
+    }
+    if (sscanf(line, "%63s %" SCNu64 " %lf %lf %lf %lf %" SCNu64, op_name,
+               &count, &avg, &p50, &p99, &p999, &max_val) == 7) {
+      baseline_entries[op_name] = PerfBaselineEntry{avg, p99};
+    }
+  }
+  fclose(baseline);
+
+  bool ok = true;
+  for (int op = 0; op < kNumPerfOpTypes; ++op) {
+    const HistogramImpl& hist = perf_hists_[op];
+    if (hist.num() == 0) {
+      continue;
+    }
+    auto it = baseline_entries.find(PerfOpTypeName(op));
+    if (it == baseline_entries.end()) {
+      // New op type since the baseline was recorded; nothing to compare.
+      continue;
+    }
+    const double allowed = 1.0 + threshold;
+    if (hist.Average() > it->second.avg * allowed) {
+      fprintf(stderr,
+              "Perf regression: %s avg latency %.2f us exceeds baseline "
+              "%.2f us by more than %.0f%%\n",
+              PerfOpTypeName(op), hist.Average(), it->second.avg,
+              threshold * 100);
+      ok = false;
+    }
+    if (hist.Percentile(99.0) > it->second.p99 * allowed) {
+      fprintf(stderr,
+              "Perf regression: %s p99 latency %.2f us exceeds baseline "
+              "%.2f us by more than %.0f%%\n",
+              PerfOpTypeName(op), hist.Percentile(99.0), it->second.p99,
+              threshold * 100);
+      ok = false;
+    }
+  }
+  return ok;
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 #endif  // GFLAGS
@@ -7,6 +7,7 @@
 #include <cinttypes>
 #include <memory>
 #include <queue>
+#include <string>
 #include <unordered_set>
 
 #include "monitoring/histogram.h"
@@ -26,6 +27,22 @@ namespace ROCKSDB_NAMESPACE {
 extern std::shared_ptr<ROCKSDB_NAMESPACE::Statistics> dbstats;
 extern std::shared_ptr<ROCKSDB_NAMESPACE::Statistics> dbstats_secondaries;
 
+// Operation categories tracked by the perf-regression mode
+// (-perf_report_file). One histogram per category so latency changes in one
+// op type are not masked by the mix.
+enum PerfOpType : int {
+  kPerfRead = 0,
+  kPerfPrefixScan,
+  kPerfWrite,
+  kPerfDelete,
+  kPerfDeleteRange,
+  kPerfIterate,
+  kPerfCustom,
+  kNumPerfOpTypes,
+};
+
+const char* PerfOpTypeName(int op);
+
 class Stats {
  private:
   uint64_t start_;
@@ -50,6 +67,7 @@ class Stats {
   size_t bytes_;
   uint64_t last_op_finish_;
   HistogramImpl hist_;
+  HistogramImpl perf_hists_[kNumPerfOpTypes];
 
  public:
   Stats() {}
@@ -57,6 +75,9 @@ class Stats {
   void Start() {
     next_report_ = 100;
     hist_.Clear();
+    for (int op = 0; op < kNumPerfOpTypes; ++op) {
+      perf_hists_[op].Clear();
+    }
     done_ = 0;
     gets_ = 0;
     prefixes_ = 0;
@@ -81,6 +102,9 @@ class Stats {
 
   void Merge(const Stats& other) {
     hist_.Merge(other.hist_);
+    for (int op = 0; op < kNumPerfOpTypes; ++op) {
+      perf_hists_[op].Merge(other.perf_hists_[op]);
+    }
     done_ += other.done_;
     gets_ += other.gets_;
     prefixes_ += other.prefixes_;
@@ -173,6 +197,16 @@ class Stats {
 
   void AddNumCompactFilesFailed(long n) { num_compact_files_failed_ += n; }
 
+  void AddPerfOpLatency(PerfOpType op, uint64_t micros) {
+    perf_hists_[op].Add(micros);
+  }
+
+  // Write the per-op-type latency report to `report_path` and, when
+  // `baseline_path` is non-empty, compare against a report previously written
+  // by the same code. Returns false on a regression or I/O failure.
+  bool ReportPerf(const std::string& report_path,
+                  const std::string& baseline_path, double threshold) const;
+
   void Report(const char* name) {
     std::string extra;
     if (bytes_ < 1 || done_ < 1) {
@@ -809,6 +809,17 @@ void StressTest::OperateDb(ThreadState* thread) {
 
   const uint64_t ops_per_open = FLAGS_ops_per_thread / (FLAGS_reopen + 1);
 
+  // Perf-regression mode: optionally pace operations to a stable rate and
+  // time each dispatched op so latencies are comparable across runs.
+  const bool perf_recording = !FLAGS_perf_report_file.empty();
+  const uint64_t perf_op_interval_us =
+      FLAGS_perf_ops_per_sec_per_thread > 0
+          ? 1000000 / FLAGS_perf_ops_per_sec_per_thread
+          : 0;
+  uint64_t perf_next_op_due_us =
+      perf_op_interval_us > 0 ? clock_->NowMicros() : 0;
+  uint64_t perf_ops_done = 0;
+
 #ifndef NDEBUG
   if (FLAGS_read_fault_one_in) {
     fault_fs_guard->SetThreadLocalReadErrorContext(thread->shared->GetSeed(),
@@ -1058,12 +1069,16 @@ void StressTest::OperateDb(ThreadState* thread) {
       }
 
       int prob_op = thread->rand.Uniform(100);
+      PerfOpType perf_op = kPerfCustom;
+      const uint64_t perf_op_start_us =
+          perf_recording ? clock_->NowMicros() : 0;
       // Reset this in case we pick something other than a read op. We don't
       // want to use a stale value when deciding at the beginning of the loop
       // whether to vote to reopen
       if (prob_op >= 0 && prob_op < static_cast<int>(FLAGS_readpercent)) {
         assert(0 <= prob_op);
         // OPERATION read
+        perf_op = kPerfRead;
         if (FLAGS_use_get_entity) {
           TestGetEntity(thread, read_opts, rand_column_families, rand_keys);
         } else if (FLAGS_use_multiget) {
@@ -1084,6 +1099,7 @@ void StressTest::OperateDb(ThreadState* thread) {
       } else if (prob_op < prefix_bound) {
         assert(static_cast<int>(FLAGS_readpercent) <= prob_op);
         // OPERATION prefix scan
+        perf_op = kPerfPrefixScan;
         // keys are 8 bytes long, prefix size is FLAGS_prefix_size. There are
         // (8 - FLAGS_prefix_size) bytes besides the prefix. So there will
         // be 2 ^ ((8 - FLAGS_prefix_size) * 8) possible keys with the same
@@ -1092,19 +1108,23 @@ void StressTest::OperateDb(ThreadState* thread) {
       } else if (prob_op < write_bound) {
         assert(prefix_bound <= prob_op);
         // OPERATION write
+        perf_op = kPerfWrite;
         TestPut(thread, write_opts, read_opts, rand_column_families, rand_keys,
                 value);
       } else if (prob_op < del_bound) {
         assert(write_bound <= prob_op);
         // OPERATION delete
+        perf_op = kPerfDelete;
         TestDelete(thread, write_opts, rand_column_families, rand_keys);
       } else if (prob_op < delrange_bound) {
         assert(del_bound <= prob_op);
         // OPERATION delete range
+        perf_op = kPerfDeleteRange;
         TestDeleteRange(thread, write_opts, rand_column_families, rand_keys);
       } else if (prob_op < iterate_bound) {
         assert(delrange_bound <= prob_op);
         // OPERATION iterate
+        perf_op = kPerfIterate;
         if (!FLAGS_skip_verifydb &&
             thread->rand.OneInOpt(
                 FLAGS_verify_iterator_with_expected_state_one_in)) {
@@ -1124,6 +1144,25 @@ void StressTest::OperateDb(ThreadState* thread) {
         assert(iterate_bound <= prob_op);
         TestCustomOperations(thread, rand_column_families);
       }
+      if (perf_recording) {
+        if (perf_ops_done >= FLAGS_perf_warmup_ops_per_thread) {
+          thread->stats.AddPerfOpLatency(
+              perf_op, clock_->NowMicros() - perf_op_start_us);
+        }
+        ++perf_ops_done;
+      }
+      if (perf_op_interval_us > 0) {
+        perf_next_op_due_us += perf_op_interval_us;
+        uint64_t now_us = clock_->NowMicros();
+        if (now_us < perf_next_op_due_us) {
+          clock_->SleepForMicroseconds(
+              static_cast<int>(perf_next_op_due_us - now_us));
+        } else {
+          // Too far behind the schedule to catch up; restart it rather than
+          // issuing an unpaced burst of operations.
+          perf_next_op_due_us = now_us;
+        }
+      }
       thread->stats.FinishedSingleOp();
     }
   }
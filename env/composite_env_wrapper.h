@@ -365,6 +365,10 @@ class CompositeEnvWrapper : public CompositeEnv {
     target_.env->LowerThreadPoolIOPriority(pool);
   }
 
+  void RaiseThreadPoolIOPriority(Priority pool) override {
+    target_.env->RaiseThreadPoolIOPriority(pool);
+  }
+
   void LowerThreadPoolCPUPriority(Priority pool) override {
     target_.env->LowerThreadPoolCPUPriority(pool);
   }
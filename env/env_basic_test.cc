@@ -274,6 +274,32 @@ TEST_P(EnvBasicTestWithParam, ReadWrite) {
   ASSERT_TRUE(rand_file->Read(1000, 5, &result, scratch).ok());
 }
 
+TEST_P(EnvBasicTestWithParam, MultiRead) {
+  std::unique_ptr<WritableFile> writable_file;
+  ASSERT_OK(env_->NewWritableFile(test_dir_ + "/f", &writable_file, soptions_));
+  ASSERT_OK(writable_file->Append("hello world"));
+  ASSERT_OK(writable_file->Close());
+  writable_file.reset();
+
+  std::unique_ptr<FSRandomAccessFile> rand_file;
+  ASSERT_OK(env_->GetFileSystem()->NewRandomAccessFile(
+      test_dir_ + "/f", FileOptions(soptions_), &rand_file, nullptr));
+  char scratch1[10];
+  char scratch2[10];
+  FSReadRequest reqs[2];
+  reqs[0].offset = 6;
+  reqs[0].len = 5;
+  reqs[0].scratch = scratch1;
+  reqs[1].offset = 0;
+  reqs[1].len = 5;
+  reqs[1].scratch = scratch2;
+  ASSERT_OK(rand_file->MultiRead(reqs, 2, IOOptions(), nullptr));
+  ASSERT_OK(reqs[0].status);
+  ASSERT_OK(reqs[1].status);
+  ASSERT_EQ(0, reqs[0].result.compare("world"));
+  ASSERT_EQ(0, reqs[1].result.compare("hello"));
+}
+
 TEST_P(EnvBasicTestWithParam, Misc) {
   std::unique_ptr<WritableFile> writable_file;
   ASSERT_OK(env_->NewWritableFile(test_dir_ + "/b", &writable_file, soptions_));
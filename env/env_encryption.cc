@@ -143,6 +143,34 @@ IOStatus EncryptedRandomAccessFile::Read(uint64_t offset, size_t n,
   return io_s;
 }
 
+// Issue the reads to the underlying file in one batch, so that the file
+// system can coalesce or parallelize them, and decrypt the results
+// afterwards. This preserves any MultiRead optimization of the underlying
+// file system, which the default request-by-request fallback would lose.
+IOStatus EncryptedRandomAccessFile::MultiRead(FSReadRequest* reqs,
+                                              size_t num_reqs,
+                                              const IOOptions& options,
+                                              IODebugContext* dbg) {
+  assert(reqs != nullptr);
+  for (size_t i = 0; i < num_reqs; i++) {
+    reqs[i].offset += prefixLength_;
+  }
+  IOStatus io_s = file_->MultiRead(reqs, num_reqs, options, dbg);
+  for (size_t i = 0; i < num_reqs; i++) {
+    FSReadRequest& req = reqs[i];
+    if (io_s.ok() && req.status.ok() && req.result.size() > 0) {
+      PERF_TIMER_GUARD(decrypt_data_nanos);
+      IOStatus decrypt_status = status_to_io_status(stream_->Decrypt(
+          req.offset, (char*)req.result.data(), req.result.size()));
+      if (!decrypt_status.ok()) {
+        req.status = decrypt_status;
+      }
+    }
+    req.offset -= prefixLength_;
+  }
+  return io_s;
+}
+
 // Readahead the file starting from offset by n bytes for caching.
 IOStatus EncryptedRandomAccessFile::Prefetch(uint64_t offset, size_t n,
                                              const IOOptions& options,
@@ -197,30 +225,50 @@ IOStatus EncryptedRandomAccessFile::InvalidateCache(size_t offset,
 // A file abstraction for sequential writing.  The implementation
 // must provide buffering since callers may append small fragments
 // at a time to the file.
+EncryptedWritableFile::EncryptedWritableFile(
+    std::unique_ptr<FSWritableFile>&& f,
+    std::unique_ptr<BlockAccessCipherStream>&& s, size_t prefixLength)
+    : file_(std::move(f)), stream_(std::move(s)), prefixLength_(prefixLength) {}
+
+EncryptedWritableFile::~EncryptedWritableFile() {}
+
+// Copy `data` into the reusable encryption buffer, growing it if needed.
+// The buffer is a member so that a sequence of appends does not pay for an
+// allocation per call; Append() requires external synchronization, so there
+// is no concurrent use of the buffer.
+void EncryptedWritableFile::CloneDataToEncryptBuffer(const Slice& data) {
+  if (!encrypt_buf_) {
+    encrypt_buf_.reset(new AlignedBuffer());
+    encrypt_buf_->Alignment(GetRequiredBufferAlignment());
+  }
+  if (encrypt_buf_->Capacity() < data.size()) {
+    encrypt_buf_->AllocateNewBuffer(data.size());
+  }
+  // TODO (sagar0): Modify AlignedBuffer.Append to allow doing a memmove
+  // so that the next two lines can be replaced with buf.Append().
+  memmove(encrypt_buf_->BufferStart(), data.data(), data.size());
+  encrypt_buf_->Size(data.size());
+}
+
 IOStatus EncryptedWritableFile::Append(const Slice& data,
                                        const IOOptions& options,
                                        IODebugContext* dbg) {
-  AlignedBuffer buf;
   Slice dataToAppend(data);
   if (data.size() > 0) {
     auto offset = file_->GetFileSize(options, dbg);  // size including prefix
     // Encrypt in cloned buffer
-    buf.Alignment(GetRequiredBufferAlignment());
-    buf.AllocateNewBuffer(data.size());
-    // TODO (sagar0): Modify AlignedBuffer.Append to allow doing a memmove
-    // so that the next two lines can be replaced with buf.Append().
-    memmove(buf.BufferStart(), data.data(), data.size());
-    buf.Size(data.size());
+    CloneDataToEncryptBuffer(data);
     IOStatus io_s;
     {
       PERF_TIMER_GUARD(encrypt_data_nanos);
-      io_s = status_to_io_status(
-          stream_->Encrypt(offset, buf.BufferStart(), buf.CurrentSize()));
+      io_s = status_to_io_status(stream_->Encrypt(
+          offset, encrypt_buf_->BufferStart(), encrypt_buf_->CurrentSize()));
     }
     if (!io_s.ok()) {
       return io_s;
     }
-    dataToAppend = Slice(buf.BufferStart(), buf.CurrentSize());
+    dataToAppend = Slice(encrypt_buf_->BufferStart(),
+                         encrypt_buf_->CurrentSize());
   }
   return file_->Append(dataToAppend, options, dbg);
 }
@@ -229,25 +277,22 @@ IOStatus EncryptedWritableFile::PositionedAppend(const Slice& data,
                                                  uint64_t offset,
                                                  const IOOptions& options,
                                                  IODebugContext* dbg) {
-  AlignedBuffer buf;
   Slice dataToAppend(data);
   offset += prefixLength_;
   if (data.size() > 0) {
     // Encrypt in cloned buffer
-    buf.Alignment(GetRequiredBufferAlignment());
-    buf.AllocateNewBuffer(data.size());
-    memmove(buf.BufferStart(), data.data(), data.size());
-    buf.Size(data.size());
+    CloneDataToEncryptBuffer(data);
     IOStatus io_s;
     {
       PERF_TIMER_GUARD(encrypt_data_nanos);
-      io_s = status_to_io_status(
-          stream_->Encrypt(offset, buf.BufferStart(), buf.CurrentSize()));
+      io_s = status_to_io_status(stream_->Encrypt(
+          offset, encrypt_buf_->BufferStart(), encrypt_buf_->CurrentSize()));
     }
     if (!io_s.ok()) {
       return io_s;
     }
-    dataToAppend = Slice(buf.BufferStart(), buf.CurrentSize());
+    dataToAppend = Slice(encrypt_buf_->BufferStart(),
+                         encrypt_buf_->CurrentSize());
   }
   return file_->PositionedAppend(dataToAppend, offset, options, dbg);
 }
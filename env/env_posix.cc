@@ -390,6 +390,15 @@ class PosixEnv : public CompositeEnv {
 #endif
   }
 
+  void RaiseThreadPoolIOPriority(Priority pool) override {
+    assert(pool >= Priority::BOTTOM && pool <= Priority::HIGH);
+#ifdef OS_LINUX
+    thread_pools_[pool].RaiseIOPriority();
+#else
+    (void)pool;
+#endif
+  }
+
   void LowerThreadPoolCPUPriority(Priority pool) override {
     assert(pool >= Priority::BOTTOM && pool <= Priority::HIGH);
     thread_pools_[pool].LowerCPUPriority(CpuPriority::kLow);
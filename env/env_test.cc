@@ -489,6 +489,62 @@ TEST_P(EnvPosixTestWithParam, RunMany) {
   WaitThreadPoolsEmpty();
   ASSERT_EQ(4, last_id.load(std::memory_order_acquire));
 }
+
+// The tag-affine pick in ThreadPoolImpl::Impl::BGThread may bypass the
+// queue head in favor of a job matching the worker's last tag, but only a
+// bounded number of times; a differently-tagged head must not be starved
+// by a sustained backlog of same-tag jobs behind it.
+TEST_P(EnvPosixTestWithParam, TagAffinityHeadBypassBound) {
+  constexpr size_t kMaxHeadBypasses = 8;  // Matches ThreadPoolImpl::Impl.
+  env_->SetBackgroundThreads(1, Env::LOW);
+  int tag_a = 0;
+  int tag_b = 0;
+
+  struct JobState {
+    port::Mutex mu;
+    std::string order;  // One char per completed job, in execution order.
+  };
+  JobState state;
+
+  struct Recorder {
+    JobState* state;
+    char id;
+
+    static void Run(void* v) {
+      Recorder* r = static_cast<Recorder*>(v);
+      r->state->mu.Lock();
+      r->state->order.push_back(r->id);
+      r->state->mu.Unlock();
+    }
+  };
+
+  // Park the single worker on a tag_a job, so its last tag becomes tag_a
+  // and the jobs scheduled below all pile up in the queue.
+  test::SleepingBackgroundTask sleeping_task;
+  env_->Schedule(&test::SleepingBackgroundTask::DoSleepTask, &sleeping_task,
+                 Env::Priority::LOW, &tag_a);
+  sleeping_task.WaitUntilSleeping();
+
+  // A differently-tagged job at the head, with a tag_a backlog longer than
+  // the bypass bound behind it.
+  constexpr int kBacklog = 20;
+  Recorder head_job{&state, 'b'};
+  std::vector<Recorder> backlog(kBacklog, Recorder{&state, 'a'});
+  env_->Schedule(&Recorder::Run, &head_job, Env::Priority::LOW, &tag_b);
+  for (int i = 0; i < kBacklog; i++) {
+    env_->Schedule(&Recorder::Run, &backlog[i], Env::Priority::LOW, &tag_a);
+  }
+
+  sleeping_task.WakeUp();
+  WaitThreadPoolsEmpty();
+
+  ASSERT_EQ(static_cast<size_t>(kBacklog) + 1, state.order.size());
+  size_t head_pos = state.order.find('b');
+  // The worker prefers its warm tag at least once, but must take the head
+  // after at most kMaxHeadBypasses affinity picks.
+  ASSERT_GE(head_pos, 1u);
+  ASSERT_LE(head_pos, kMaxHeadBypasses);
+}
 #endif
 
 struct State {
@@ -360,6 +360,9 @@ class PosixWritableFile : public FSWritableFile {
                           IODebugContext* dbg) override {
     return Append(data, opts, dbg);
   }
+  virtual IOStatus AppendVec(const std::vector<Slice>& data,
+                             const IOOptions& opts,
+                             IODebugContext* dbg) override;
   virtual IOStatus PositionedAppend(const Slice& data, uint64_t offset,
                                     const IOOptions& opts,
                                     IODebugContext* dbg) override;
@@ -6,6 +6,7 @@
 
 #include "file/delete_scheduler.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <thread>
 #include <vector>
@@ -233,70 +234,138 @@ void DeleteScheduler::BackgroundEmptyTrash() {
     uint64_t total_deleted_bytes = 0;
     int64_t current_delete_rate = rate_bytes_per_sec_.load();
     while (!queue_.empty() && !closing_) {
-      if (current_delete_rate != rate_bytes_per_sec_.load()) {
-        // User changed the delete rate
-        current_delete_rate = rate_bytes_per_sec_.load();
-        start_time = clock_->NowMicros();
-        total_deleted_bytes = 0;
-        ROCKS_LOG_INFO(info_log_, "rate_bytes_per_sec is changed to %" PRIi64,
-                       current_delete_rate);
-      }
-
-      // Get new file to delete
-      const FileAndDir& fad = queue_.front();
-      std::string path_in_trash = fad.fname;
-
-      // We don't need to hold the lock while deleting the file
-      mu_.Unlock();
-      uint64_t deleted_bytes = 0;
-      bool is_complete = true;
-      // Delete file from trash and update total_penlty value
-      Status s =
-          DeleteTrashFile(path_in_trash, fad.dir, &deleted_bytes, &is_complete);
-      total_deleted_bytes += deleted_bytes;
-      mu_.Lock();
-      if (is_complete) {
+      // Take a batch of files off the queue and sort it by path so that
+      // consecutive unlinks hit the same directory and its dentries stay
+      // warm. Dropping a column family queues tens of thousands of files in
+      // arrival order, which otherwise bounces between directories on every
+      // delete.
+      std::vector<FileAndDir> batch;
+      while (!queue_.empty() && batch.size() < kMaxFilesPerBatch) {
+        batch.push_back(queue_.front());
         queue_.pop();
       }
+      std::sort(batch.begin(), batch.end(),
+                [](const FileAndDir& a, const FileAndDir& b) {
+                  return a.fname < b.fname;
+                });
+
+      for (size_t i = 0; i < batch.size() && !closing_;) {
+        if (current_delete_rate != rate_bytes_per_sec_.load()) {
+          // User changed the delete rate
+          current_delete_rate = rate_bytes_per_sec_.load();
+          start_time = clock_->NowMicros();
+          total_deleted_bytes = 0;
+          ROCKS_LOG_INFO(info_log_, "rate_bytes_per_sec is changed to %" PRIi64,
+                         current_delete_rate);
+        }
 
-      if (!s.ok()) {
-        bg_errors_[path_in_trash] = s;
-      }
+        const FileAndDir& fad = batch[i];
+        std::string path_in_trash = fad.fname;
+
+        // We don't need to hold the lock while deleting the file
+        mu_.Unlock();
+        // Decide whether to pace this delete before paying the penalty for
+        // it; the current file still counts as reclaimable trash here.
+        const bool low_free_space = IsFreeSpaceLow(path_in_trash);
+        uint64_t deleted_bytes = 0;
+        bool is_complete = true;
+        // Delete file from trash and update total_penlty value
+        Status s = DeleteTrashFile(path_in_trash, fad.dir, &deleted_bytes,
+                                   &is_complete);
+        total_deleted_bytes += deleted_bytes;
+        mu_.Lock();
+        if (is_complete) {
+          ++i;
+        }
 
-      // Apply penalty if necessary
-      uint64_t total_penalty;
-      if (current_delete_rate > 0) {
-        // rate limiting is enabled
-        total_penalty =
-            ((total_deleted_bytes * kMicrosInSecond) / current_delete_rate);
-        ROCKS_LOG_INFO(info_log_,
-                       "Rate limiting is enabled with penalty %" PRIu64
-                       " after deleting file %s",
-                       total_penalty, path_in_trash.c_str());
-        while (!closing_ && !cv_.TimedWait(start_time + total_penalty)) {
+        if (!s.ok()) {
+          bg_errors_[path_in_trash] = s;
         }
-      } else {
-        // rate limiting is disabled
-        total_penalty = 0;
-        ROCKS_LOG_INFO(info_log_,
-                       "Rate limiting is disabled after deleting file %s",
-                       path_in_trash.c_str());
-      }
-      TEST_SYNC_POINT_CALLBACK("DeleteScheduler::BackgroundEmptyTrash:Wait",
-                               &total_penalty);
 
-      if (is_complete) {
-        pending_files_--;
-      }
-      if (pending_files_ == 0) {
-        // Unblock WaitForEmptyTrash since there are no more files waiting
-        // to be deleted
-        cv_.SignalAll();
+        // Apply penalty if necessary
+        uint64_t total_penalty;
+        if (current_delete_rate > 0 && !low_free_space) {
+          // rate limiting is enabled
+          total_penalty =
+              ((total_deleted_bytes * kMicrosInSecond) / current_delete_rate);
+          ROCKS_LOG_INFO(info_log_,
+                         "Rate limiting is enabled with penalty %" PRIu64
+                         " after deleting file %s",
+                         total_penalty, path_in_trash.c_str());
+          while (!closing_ && !cv_.TimedWait(start_time + total_penalty)) {
+          }
+        } else if (low_free_space) {
+          // Free space is low relative to the reclaimable trash; deleting is
+          // the fastest way to get it back, so skip the penalty until the
+          // condition clears. Reset the accounting so we do not owe the
+          // accumulated penalty once it does.
+          total_penalty = 0;
+          start_time = clock_->NowMicros();
+          total_deleted_bytes = 0;
+        } else {
+          // rate limiting is disabled
+          total_penalty = 0;
+          ROCKS_LOG_INFO(info_log_,
+                         "Rate limiting is disabled after deleting file %s",
+                         path_in_trash.c_str());
+        }
+        TEST_SYNC_POINT_CALLBACK("DeleteScheduler::BackgroundEmptyTrash:Wait",
+                                 &total_penalty);
+
+        if (is_complete) {
+          pending_files_--;
+        }
+        if (pending_files_ == 0) {
+          // Unblock WaitForEmptyTrash since there are no more files waiting
+          // to be deleted
+          cv_.SignalAll();
+        }
       }
     }
   }
 }
 
+bool DeleteScheduler::IsFreeSpaceLow(const std::string& path_in_trash) {
+  uint64_t now = clock_->NowMicros();
+  if (now < next_free_space_check_micros_.load(std::memory_order_relaxed)) {
+    return low_free_space_.load(std::memory_order_relaxed);
+  }
+  next_free_space_check_micros_.store(now + kFreeSpaceCheckIntervalMicros,
+                                      std::memory_order_relaxed);
+
+  // statfs the directory holding the trash file
+  size_t idx = path_in_trash.rfind('/');
+  std::string dir = idx == std::string::npos ? "." : path_in_trash.substr(0, idx);
+  uint64_t free_space = 0;
+  IOStatus io_s = fs_->GetFreeSpace(dir, IOOptions(), &free_space, nullptr);
+  bool low = false;
+  if (io_s.ok()) {
+    // The situation is urgent only when the pending trash is a sizable
+    // fraction of what is left on the filesystem; otherwise rate limiting
+    // is more valuable than the space.
+    low = total_trash_size_.load() * kFreeSpaceUrgencyFactor > free_space;
+  } else {
+    // Not all file systems can report free space; treat that as not urgent.
+    io_s.PermitUncheckedError();
+  }
+  if (low != low_free_space_.load(std::memory_order_relaxed)) {
+    if (low) {
+      ROCKS_LOG_WARN(info_log_,
+                     "Free space (%" PRIu64
+                     " bytes) is low relative to trash size (%" PRIu64
+                     " bytes); deleting trash without rate limiting",
+                     free_space, total_trash_size_.load());
+    } else {
+      ROCKS_LOG_INFO(info_log_,
+                     "Free space recovered (%" PRIu64
+                     " bytes); resuming rate-limited trash deletion",
+                     free_space);
+    }
+    low_free_space_.store(low, std::memory_order_relaxed);
+  }
+  return low;
+}
+
 Status DeleteScheduler::DeleteTrashFile(const std::string& path_in_trash,
                                         const std::string& dir_to_sync,
                                         uint64_t* deleted_bytes,
@@ -30,6 +30,10 @@ class SystemClock;
 //
 // Rate limiting can be turned off by setting rate_bytes_per_sec = 0, In this
 // case DeleteScheduler will delete files immediately.
+//
+// The background thread processes trash in batches sorted by path and
+// suspends the rate limit while free space on the trash filesystem is low
+// relative to the pending trash size.
 class DeleteScheduler {
  public:
   DeleteScheduler(SystemClock* clock, FileSystem* fs,
@@ -93,6 +97,13 @@ class DeleteScheduler {
                          const std::string& dir_to_sync,
                          uint64_t* deleted_bytes, bool* is_complete);
 
+  // Return true if free space on the filesystem holding path_in_trash is low
+  // compared to the pending trash size, in which case the background thread
+  // deletes without applying the rate-limit penalty. The result is cached
+  // and refreshed at most once per kFreeSpaceCheckIntervalMicros so trash
+  // deletion does not statfs on every file. Called without mu_ held.
+  bool IsFreeSpaceLow(const std::string& path_in_trash);
+
   void BackgroundEmptyTrash();
 
   void MaybeCreateBackgroundThread();
@@ -140,6 +151,18 @@ class DeleteScheduler {
   // immediately
   std::atomic<double> max_trash_db_ratio_;
   static const uint64_t kMicrosInSecond = 1000 * 1000LL;
+  // Maximum number of trash files popped off the queue per wakeup of the
+  // background thread; each batch is sorted by path before deletion so
+  // unlinks within a directory are issued back to back.
+  static const size_t kMaxFilesPerBatch = 256;
+  // How often the free-space check in IsFreeSpaceLow() is allowed to statfs.
+  static const uint64_t kFreeSpaceCheckIntervalMicros = kMicrosInSecond;
+  // Trash deletion is accelerated when
+  // total_trash_size_ * kFreeSpaceUrgencyFactor > free space.
+  static const uint64_t kFreeSpaceUrgencyFactor = 4;
+  // Cached result and next refresh deadline of the free-space check.
+  std::atomic<uint64_t> next_free_space_check_micros_{0};
+  std::atomic<bool> low_free_space_{false};
   std::shared_ptr<Statistics> stats_;
 };
 
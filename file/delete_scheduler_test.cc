@@ -13,6 +13,7 @@
 #include "file/file_util.h"
 #include "file/sst_file_manager_impl.h"
 #include "rocksdb/env.h"
+#include "rocksdb/file_system.h"
 #include "rocksdb/options.h"
 #include "test_util/sync_point.h"
 #include "test_util/testharness.h"
@@ -686,6 +687,67 @@ TEST_F(DeleteSchedulerTest, ImmediateDeleteOn25PercDBSize) {
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
 }
 
+namespace {
+// Reports no free space so that the trash urgency mode is always on.
+class NoFreeSpaceFS : public FileSystemWrapper {
+ public:
+  explicit NoFreeSpaceFS(const std::shared_ptr<FileSystem>& t)
+      : FileSystemWrapper(t) {}
+  static const char* kClassName() { return "NoFreeSpaceFS"; }
+  const char* Name() const override { return kClassName(); }
+
+  IOStatus GetFreeSpace(const std::string& /*path*/,
+                        const IOOptions& /*options*/, uint64_t* free_space,
+                        IODebugContext* /*dbg*/) override {
+    *free_space = 0;
+    return IOStatus::OK();
+  }
+};
+}  // namespace
+
+// When free space is low relative to the pending trash size, the background
+// thread must delete without applying the rate-limit penalty.
+TEST_F(DeleteSchedulerTest, LowFreeSpaceSkipsRateLimit) {
+  std::vector<uint64_t> penalties;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DeleteScheduler::BackgroundEmptyTrash:Wait",
+      [&](void* arg) { penalties.push_back(*(static_cast<uint64_t*>(arg))); });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  int num_files = 10;
+  uint64_t file_size = 1024;
+  // Slow enough that rate-limited deletion of all files would take ~10s
+  rate_bytes_per_sec_ = 1024;
+
+  auto fs = std::make_shared<NoFreeSpaceFS>(env_->GetFileSystem());
+  sst_file_mgr_.reset(new SstFileManagerImpl(
+      env_->GetSystemClock(), fs, nullptr, rate_bytes_per_sec_,
+      /* max_trash_db_ratio= */ 1.1, 128 * 1024));
+  delete_scheduler_ = sst_file_mgr_->delete_scheduler();
+  sst_file_mgr_->SetStatisticsPtr(stats_);
+
+  std::vector<std::string> generated_files;
+  for (int i = 0; i < num_files; i++) {
+    std::string file_name = "file" + std::to_string(i) + ".data";
+    generated_files.push_back(NewDummyFile(file_name, file_size));
+  }
+  for (const std::string& file_name : generated_files) {
+    ASSERT_OK(
+        delete_scheduler_->DeleteFile(file_name, dummy_files_dirs_[0]));
+  }
+
+  delete_scheduler_->WaitForEmptyTrash();
+
+  ASSERT_EQ(delete_scheduler_->GetBackgroundErrors().size(), 0);
+  ASSERT_EQ(CountTrashFiles(), 0);
+  ASSERT_EQ(penalties.size(), static_cast<size_t>(num_files));
+  for (uint64_t penalty : penalties) {
+    ASSERT_EQ(penalty, 0);
+  }
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+}
+
 TEST_F(DeleteSchedulerTest, IsTrashCheck) {
   // Trash files
   ASSERT_TRUE(DeleteScheduler::IsTrashFile("x.trash"));
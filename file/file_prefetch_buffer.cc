@@ -164,10 +164,28 @@ Status FilePrefetchBuffer::Prefetch(const IOOptions& opts,
                   rounddown_offset, curr_);
   if (usage_ == FilePrefetchBufferUsage::kTableOpenPrefetchTail && s.ok()) {
     RecordInHistogram(stats_, TABLE_OPEN_PREFETCH_TAIL_READ_BYTES, read_len);
+  } else if (usage_ == FilePrefetchBufferUsage::kCompactionPrefetch && s.ok()) {
+    DropCacheBehind(reader, rounddown_offset);
   }
   return s;
 }
 
+void FilePrefetchBuffer::DropCacheBehind(RandomAccessFileReader* reader,
+                                         uint64_t offset) {
+  if (offset <= drop_cache_behind_offset_) {
+    return;
+  }
+  uint64_t len = offset - drop_cache_behind_offset_;
+  TEST_SYNC_POINT_CALLBACK("FilePrefetchBuffer::DropCacheBehind", &len);
+  // This is only a page cache hint, so failures (e.g. file systems that don't
+  // use the page cache) are ignored.
+  reader->file()
+      ->InvalidateCache(static_cast<size_t>(drop_cache_behind_offset_),
+                        static_cast<size_t>(len))
+      .PermitUncheckedError();
+  drop_cache_behind_offset_ = offset;
+}
+
 // Copy data from src to third buffer.
 void FilePrefetchBuffer::CopyDataToBuffer(uint32_t src, uint64_t& offset,
                                           size_t& length) {
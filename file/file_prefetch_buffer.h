@@ -56,6 +56,10 @@ struct BufferInfo {
 
 enum class FilePrefetchBufferUsage {
   kTableOpenPrefetchTail,
+  // Sequential compaction input reads. The buffer drops pages behind the
+  // prefetch window from the OS page cache as it moves forward, so large
+  // compactions do not evict user-read pages.
+  kCompactionPrefetch,
   kUnknown,
 };
 
@@ -422,6 +426,11 @@ class FilePrefetchBuffer {
                                       Status* status,
                                       Env::IOPriority rate_limiter_priority);
 
+  // Drop pages in [drop_cache_behind_offset_, offset) from the OS page cache.
+  // Only called for usage_ == kCompactionPrefetch, where reads move strictly
+  // forward and the pages behind the prefetch window won't be read again.
+  void DropCacheBehind(RandomAccessFileReader* reader, uint64_t offset);
+
   std::vector<BufferInfo> bufs_;
   // curr_ represents the index for bufs_ indicating which buffer is being
   // consumed currently.
@@ -463,5 +472,9 @@ class FilePrefetchBuffer {
   Statistics* stats_;
 
   FilePrefetchBufferUsage usage_;
+
+  // Offset up to which pages have already been dropped from the OS page
+  // cache. Only used when usage_ == kCompactionPrefetch.
+  uint64_t drop_cache_behind_offset_ = 0;
 };
 }  // namespace ROCKSDB_NAMESPACE
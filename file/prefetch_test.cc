@@ -1642,6 +1642,80 @@ TEST_P(PrefetchTest1, SeekParallelizationTest) {
   Close();
 }
 
+// This test verifies iteration with async_io on a file whose partitioned
+// index doesn't fit in one block. Index partitions are then retrieved
+// asynchronously through PartitionedIndexIterator (TryAgain + reseek), so
+// the scan must return the same keys as a synchronous scan.
+TEST_P(PrefetchTest1, AsyncIndexPartitionScan) {
+  const int kNumKeys = 2000;
+  std::shared_ptr<MockFS> fs =
+      std::make_shared<MockFS>(env_->GetFileSystem(), false);
+  std::unique_ptr<Env> env(new CompositeEnvWrapper(env_, fs));
+
+  Options options;
+  SetGenericOptions(env.get(), GetParam(), options);
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  SetBlockBasedTableOptions(table_options);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  Status s = TryReopen(options);
+  if (GetParam() && (s.IsNotSupported() || s.IsInvalidArgument())) {
+    // If direct IO is not supported, skip the test
+    return;
+  } else {
+    ASSERT_OK(s);
+  }
+
+  WriteBatch batch;
+  Random rnd(309);
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(batch.Put(BuildKey(i), rnd.RandomString(1000)));
+  }
+  ASSERT_OK(db_->Write(WriteOptions(), &batch));
+
+  std::string start_key = BuildKey(0);
+  std::string end_key = BuildKey(kNumKeys - 1);
+  Slice least(start_key.data(), start_key.size());
+  Slice greatest(end_key.data(), end_key.size());
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), &least, &greatest));
+
+  // Collect the keys with a plain synchronous scan for validation.
+  int num_keys_sync = 0;
+  {
+    auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ReadOptions()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      num_keys_sync++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(num_keys_sync, kNumKeys);
+  }
+
+  ReadOptions ro;
+  ro.adaptive_readahead = true;
+  ro.async_io = true;
+
+  {
+    ASSERT_OK(options.statistics->Reset());
+    get_perf_context()->Reset();
+    int num_keys_async = 0;
+    auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ro));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      num_keys_async++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(num_keys_async, num_keys_sync);
+
+    // Check stats to make sure async prefetch is done.
+    HistogramData async_read_bytes;
+    options.statistics->histogramData(ASYNC_READ_BYTES, &async_read_bytes);
+    ASSERT_GT(async_read_bytes.count, 0);
+    ASSERT_GT(get_perf_context()->number_async_seek, 0);
+  }
+  Close();
+}
+
 namespace {
 #ifdef GFLAGS
 const int kMaxArgCount = 100;
@@ -2285,6 +2359,54 @@ TEST_F(FilePrefetchBufferTest, NoSyncWithAsyncIO) {
   ASSERT_EQ(result, async_result);
 }
 
+TEST_F(FilePrefetchBufferTest, CompactionDropCacheBehind) {
+  std::string fname = "compaction-drop-cache-behind";
+  Random rand(0);
+  std::string content = rand.RandomString(65536);
+  Write(fname, content);
+
+  FileOptions opts;
+  std::unique_ptr<RandomAccessFileReader> r;
+  Read(fname, opts, &r);
+
+  int drop_calls = 0;
+  uint64_t dropped_bytes = 0;
+  uint64_t last_drop_len = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "FilePrefetchBuffer::DropCacheBehind", [&](void* arg) {
+        last_drop_len = *static_cast<uint64_t*>(arg);
+        dropped_bytes += last_drop_len;
+        drop_calls++;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  FilePrefetchBuffer fpb(
+      /*readahead_size=*/8192, /*max_readahead_size=*/8192, /*enable=*/true,
+      /*track_min_offset=*/false, /*implicit_auto_readahead=*/false,
+      /*num_file_reads=*/0, /*num_file_reads_for_auto_readahead=*/0, fs(),
+      /*clock=*/nullptr, /*stats=*/nullptr,
+      FilePrefetchBufferUsage::kCompactionPrefetch);
+
+  Slice result;
+  Status s;
+  // Read sequentially the way compaction does. As the prefetch window moves
+  // forward, the pages behind it are dropped from the OS page cache.
+  for (uint64_t offset = 0; offset < 65536; offset += 4096) {
+    ASSERT_TRUE(fpb.TryReadFromCache(IOOptions(), r.get(), offset, 4096,
+                                     &result, &s, Env::IOPriority::IO_LOW,
+                                     /*for_compaction=*/true));
+    ASSERT_OK(s);
+    ASSERT_EQ(result.ToString(), content.substr(offset, 4096));
+  }
+  ASSERT_GT(drop_calls, 0);
+  ASSERT_GT(dropped_bytes, 0);
+  // Everything behind the last prefetch window start has been dropped.
+  ASSERT_EQ(dropped_bytes, 65536 - 8192);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
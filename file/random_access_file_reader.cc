@@ -98,6 +98,15 @@ IOStatus RandomAccessFileReader::Read(
                  true /*delay_enabled*/);
     auto prev_perf_level = GetPerfLevel();
     IOSTATS_TIMER_GUARD(read_nanos);
+    // opts.timeout is the remaining budget computed by
+    // PrepareIOFromReadOptions. The FileSystem is expected to honor it for a
+    // single read, but when a read is split across multiple iterations below
+    // (e.g. rate limited reads), check the budget ourselves between
+    // iterations so a slow first chunk doesn't blow the caller's deadline.
+    const uint64_t deadline_micros =
+        opts.timeout.count() > 0
+            ? clock_->NowMicros() + static_cast<uint64_t>(opts.timeout.count())
+            : 0;
     if (use_direct_io()) {
       size_t alignment = file_->GetRequiredBufferAlignment();
       size_t aligned_offset =
@@ -109,6 +118,11 @@ IOStatus RandomAccessFileReader::Read(
       buf.Alignment(alignment);
       buf.AllocateNewBuffer(read_size);
       while (buf.CurrentSize() < read_size) {
+        if (deadline_micros > 0 && buf.CurrentSize() > 0 &&
+            clock_->NowMicros() > deadline_micros) {
+          io_s = IOStatus::TimedOut();
+          break;
+        }
         size_t allowed;
         if (rate_limiter_priority != Env::IO_TOTAL &&
             rate_limiter_ != nullptr) {
@@ -168,6 +182,11 @@ IOStatus RandomAccessFileReader::Read(
       size_t pos = 0;
       const char* res_scratch = nullptr;
       while (pos < n) {
+        if (deadline_micros > 0 && pos > 0 &&
+            clock_->NowMicros() > deadline_micros) {
+          io_s = IOStatus::TimedOut();
+          break;
+        }
         size_t allowed;
         if (rate_limiter_priority != Env::IO_TOTAL &&
             rate_limiter_ != nullptr) {
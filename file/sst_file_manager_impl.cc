@@ -8,6 +8,10 @@
 #include <cinttypes>
 #include <vector>
 
+#ifndef OS_WIN
+#include <sys/stat.h>
+#endif
+
 #include "db/db_impl/db_impl.h"
 #include "logging/logging.h"
 #include "port/port.h"
@@ -240,6 +244,106 @@ uint64_t SstFileManagerImpl::GetTotalTrashSize() {
   return delete_scheduler_.GetTotalTrashSize();
 }
 
+void SstFileManagerImpl::OnIOBytesWritten(const std::string& file_path,
+                                          uint64_t bytes) {
+  const uint64_t now_sec = clock_->NowMicros() / (1000 * 1000);
+  size_t idx = file_path.rfind('/');
+  std::string dir = idx == std::string::npos ? "." : file_path.substr(0, idx);
+  MutexLock l(&io_mu_);
+  DeviceWriteStats& stats = device_write_stats_[GetDeviceIdLocked(dir)];
+  AdvanceWindow(&stats, now_sec);
+  stats.buckets[now_sec % kWriteBandwidthWindowSecs] += bytes;
+}
+
+uint64_t SstFileManagerImpl::GetDeviceWriteBandwidth(const std::string& path) {
+  const uint64_t now_sec = clock_->NowMicros() / (1000 * 1000);
+  MutexLock l(&io_mu_);
+  return RecentWriteBytesLocked(GetDeviceIdLocked(path), now_sec) /
+         kWriteBandwidthWindowSecs;
+}
+
+uint32_t SstFileManagerImpl::PickLeastLoadedPathId(
+    const std::vector<DbPath>& paths, uint32_t min_path_id) {
+  if (static_cast<size_t>(min_path_id) + 1 >= paths.size()) {
+    return min_path_id;
+  }
+  const uint64_t now_sec = clock_->NowMicros() / (1000 * 1000);
+  MutexLock l(&io_mu_);
+  const uint64_t preferred_dev = GetDeviceIdLocked(paths[min_path_id].path);
+  const uint64_t preferred_bytes =
+      RecentWriteBytesLocked(preferred_dev, now_sec);
+  if (preferred_bytes < kMinBytesForLoadSkew) {
+    // Not enough traffic for the device choice to matter
+    return min_path_id;
+  }
+  uint32_t best = min_path_id;
+  uint64_t best_bytes = preferred_bytes;
+  for (uint32_t p = min_path_id + 1; p < paths.size(); p++) {
+    const uint64_t dev = GetDeviceIdLocked(paths[p].path);
+    if (dev == preferred_dev) {
+      continue;
+    }
+    const uint64_t dev_bytes = RecentWriteBytesLocked(dev, now_sec);
+    if (dev_bytes < best_bytes) {
+      best = p;
+      best_bytes = dev_bytes;
+    }
+  }
+  if (best != min_path_id &&
+      preferred_bytes >= kDeviceLoadSkewFactor * best_bytes) {
+    return best;
+  }
+  return min_path_id;
+}
+
+uint64_t SstFileManagerImpl::GetDeviceIdLocked(const std::string& dir) {
+  auto it = dir_device_cache_.find(dir);
+  if (it != dir_device_cache_.end()) {
+    return it->second;
+  }
+  uint64_t device_id;
+#ifndef OS_WIN
+  struct stat sb;
+  if (stat(dir.c_str(), &sb) == 0) {
+    device_id = static_cast<uint64_t>(sb.st_dev);
+  } else {
+    // Path may not exist yet; fall back to treating it as its own device
+    device_id = std::hash<std::string>{}(dir);
+  }
+#else
+  device_id = std::hash<std::string>{}(dir);
+#endif
+  dir_device_cache_.emplace(dir, device_id);
+  return device_id;
+}
+
+uint64_t SstFileManagerImpl::RecentWriteBytesLocked(uint64_t device_id,
+                                                    uint64_t now_sec) {
+  auto it = device_write_stats_.find(device_id);
+  if (it == device_write_stats_.end()) {
+    return 0;
+  }
+  AdvanceWindow(&it->second, now_sec);
+  uint64_t total = 0;
+  for (uint64_t bucket : it->second.buckets) {
+    total += bucket;
+  }
+  return total;
+}
+
+void SstFileManagerImpl::AdvanceWindow(DeviceWriteStats* stats,
+                                       uint64_t now_sec) {
+  if (now_sec <= stats->last_slot_sec) {
+    return;
+  }
+  const uint64_t skipped = std::min<uint64_t>(now_sec - stats->last_slot_sec,
+                                              kWriteBandwidthWindowSecs);
+  for (uint64_t i = 1; i <= skipped; i++) {
+    stats->buckets[(stats->last_slot_sec + i) % kWriteBandwidthWindowSecs] = 0;
+  }
+  stats->last_slot_sec = now_sec;
+}
+
 void SstFileManagerImpl::ReserveDiskBuffer(uint64_t size,
                                            const std::string& path) {
   MutexLock l(&mu_);
@@ -6,6 +6,7 @@
 #pragma once
 
 
+#include <array>
 #include <string>
 
 #include "db/compaction/compaction.h"
@@ -102,6 +103,25 @@ class SstFileManagerImpl : public SstFileManager {
   // Return the total size of trash files
   uint64_t GetTotalTrashSize() override;
 
+  // Called by WritableFileWriter whenever bytes reach storage for file_path.
+  // Maintains a sliding window of bytes written per device so compaction
+  // placement can prefer a less-loaded device. The device of a path is
+  // resolved once and cached.
+  void OnIOBytesWritten(const std::string& file_path, uint64_t bytes);
+
+  // Return the recent write bandwidth, in bytes per second averaged over the
+  // last kWriteBandwidthWindowSecs seconds, of the device holding path.
+  uint64_t GetDeviceWriteBandwidth(const std::string& path);
+
+  // Given the output path the size-based heuristic picked (min_path_id),
+  // return the path in paths[min_path_id..] whose device has seen the least
+  // write traffic recently. Deviates from min_path_id only when its device
+  // carries meaningful traffic (kMinBytesForLoadSkew over the window) and is
+  // at least kDeviceLoadSkewFactor times busier than the alternative; paths
+  // on the same device as paths[min_path_id] never cause a deviation.
+  uint32_t PickLeastLoadedPathId(const std::vector<DbPath>& paths,
+                                 uint32_t min_path_id);
+
   // Called by each DB instance using this sst file manager to reserve
   // disk buffer space for recovery from out of space errors
   void ReserveDiskBuffer(uint64_t buffer, const std::string& path);
@@ -147,6 +167,27 @@ class SstFileManagerImpl : public SstFileManager {
     return bg_err_.severity() == Status::Severity::kSoftError;
   }
 
+  // Seconds of per-device write history kept for bandwidth accounting
+  static constexpr size_t kWriteBandwidthWindowSecs = 10;
+  // PickLeastLoadedPathId deviates from the size-based path only when the
+  // preferred device is this many times busier than the alternative ...
+  static constexpr uint64_t kDeviceLoadSkewFactor = 2;
+  // ... and has written at least this many bytes over the window.
+  static constexpr uint64_t kMinBytesForLoadSkew = 32 << 20;
+
+  // Sliding one-second buckets of bytes written to one device
+  struct DeviceWriteStats {
+    std::array<uint64_t, kWriteBandwidthWindowSecs> buckets = {};
+    uint64_t last_slot_sec = 0;
+  };
+
+  // Resolve (and cache) the device holding dir. REQUIRES: io_mu_ locked
+  uint64_t GetDeviceIdLocked(const std::string& dir);
+  // Total bytes written to device_id over the window. REQUIRES: io_mu_ locked
+  uint64_t RecentWriteBytesLocked(uint64_t device_id, uint64_t now_sec);
+  // Zero out the buckets skipped since stats' last write
+  static void AdvanceWindow(DeviceWriteStats* stats, uint64_t now_sec);
+
   std::shared_ptr<SystemClock> clock_;
   std::shared_ptr<FileSystem> fs_;
   std::shared_ptr<Logger> logger_;
@@ -187,6 +228,12 @@ class SstFileManagerImpl : public SstFileManager {
   // Pointer to ErrorHandler instance that is currently processing recovery
   ErrorHandler* cur_instance_;
   std::shared_ptr<Statistics> stats_;
+  // Mutex protecting the per-device write accounting below
+  port::Mutex io_mu_;
+  // directory => device id
+  std::unordered_map<std::string, uint64_t> dir_device_cache_;
+  // device id => recent write history
+  std::unordered_map<uint64_t, DeviceWriteStats> device_write_stats_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
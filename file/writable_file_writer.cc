@@ -13,6 +13,7 @@
 #include <mutex>
 
 #include "db/version_edit.h"
+#include "file/sst_file_manager_impl.h"
 #include "monitoring/histogram.h"
 #include "monitoring/iostats_context_imp.h"
 #include "port/port.h"
@@ -620,6 +621,9 @@ IOStatus WritableFileWriter::WriteBuffered(
     }
 
     IOSTATS_ADD(bytes_written, allowed);
+    if (sst_file_manager_ != nullptr) {
+      sst_file_manager_->OnIOBytesWritten(file_name_, allowed);
+    }
     TEST_KILL_RANDOM("WritableFileWriter::WriteBuffered:0");
 
     left -= allowed;
@@ -714,6 +718,9 @@ IOStatus WritableFileWriter::WriteBufferedWithChecksum(
   }
 
   IOSTATS_ADD(bytes_written, left);
+  if (sst_file_manager_ != nullptr) {
+    sst_file_manager_->OnIOBytesWritten(file_name_, left);
+  }
   TEST_KILL_RANDOM("WritableFileWriter::WriteBuffered:0");
 
   // Buffer write is successful, reset the buffer current size to 0 and reset
@@ -835,6 +842,9 @@ IOStatus WritableFileWriter::WriteDirect(
     }
 
     IOSTATS_ADD(bytes_written, size);
+    if (sst_file_manager_ != nullptr) {
+      sst_file_manager_->OnIOBytesWritten(file_name_, size);
+    }
     left -= size;
     src += size;
     write_offset += size;
@@ -948,6 +958,9 @@ IOStatus WritableFileWriter::WriteDirectWithChecksum(
   }
 
   IOSTATS_ADD(bytes_written, left);
+  if (sst_file_manager_ != nullptr) {
+    sst_file_manager_->OnIOBytesWritten(file_name_, left);
+  }
   assert((next_write_offset_ % alignment) == 0);
   uint64_t cur_size = flushed_size_.load(std::memory_order_acquire);
   flushed_size_.store(cur_size + left, std::memory_order_release);
@@ -37,6 +37,7 @@
 #include "util/aligned_buffer.h"
 
 namespace ROCKSDB_NAMESPACE {
+class SstFileManagerImpl;
 class Statistics;
 class SystemClock;
 
@@ -179,6 +180,9 @@ class WritableFileWriter {
   bool perform_data_verification_;
   uint32_t buffered_data_crc32c_checksum_;
   bool buffered_data_with_checksum_;
+  // When set, fed the number of bytes reaching storage so it can track
+  // per-device write bandwidth; see SstFileManagerImpl::OnIOBytesWritten()
+  SstFileManagerImpl* sst_file_manager_;
   Temperature temperature_;
 
  public:
@@ -190,7 +194,8 @@ class WritableFileWriter {
       const std::vector<std::shared_ptr<EventListener>>& listeners = {},
       FileChecksumGenFactory* file_checksum_gen_factory = nullptr,
       bool perform_data_verification = false,
-      bool buffered_data_with_checksum = false)
+      bool buffered_data_with_checksum = false,
+      SstFileManagerImpl* sst_file_manager = nullptr)
       : file_name_(_file_name),
         writable_file_(std::move(file), io_tracer, _file_name),
         clock_(clock),
@@ -210,7 +215,8 @@ class WritableFileWriter {
         checksum_finalized_(false),
         perform_data_verification_(perform_data_verification),
         buffered_data_crc32c_checksum_(0),
-        buffered_data_with_checksum_(buffered_data_with_checksum) {
+        buffered_data_with_checksum_(buffered_data_with_checksum),
+        sst_file_manager_(sst_file_manager) {
     temperature_ = options.temperature;
     assert(!use_direct_io() || max_buffer_size_ > 0);
     TEST_SYNC_POINT_CALLBACK("WritableFileWriter::WritableFileWriter:0",
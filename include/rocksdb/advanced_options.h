@@ -191,6 +191,22 @@ struct CompressionOptions {
   // Default: true
   bool use_zstd_dict_trainer;
 
+  // Train one compression dictionary per compaction and share it across all
+  // of the compaction's output files, instead of training per output file.
+  // The first output file buffers data and trains as usual; the remaining
+  // files of the same (column family, output level) skip buffering and reuse
+  // the trained dictionary. Small output files get a dictionary trained from
+  // a larger sample than their own contents and dictionary training CPU
+  // drops proportionally to the output file count. Each output file still
+  // embeds the dictionary it uses, so files remain self-contained and
+  // readable by older releases.
+  //
+  // Only takes effect when `max_dict_bytes` is nonzero. Flushes and external
+  // file writers are unaffected.
+  //
+  // Default: false
+  bool shared_dict_per_compaction;
+
   CompressionOptions()
       : window_bits(-14),
         level(kDefaultCompressionLevel),
@@ -200,7 +216,8 @@ struct CompressionOptions {
         parallel_threads(1),
         enabled(false),
         max_dict_buffer_bytes(0),
-        use_zstd_dict_trainer(true) {}
+        use_zstd_dict_trainer(true),
+        shared_dict_per_compaction(false) {}
   CompressionOptions(int wbits, int _lev, int _strategy,
                      uint32_t _max_dict_bytes, uint32_t _zstd_max_train_bytes,
                      uint32_t _parallel_threads, bool _enabled,
@@ -214,7 +231,8 @@ struct CompressionOptions {
         parallel_threads(_parallel_threads),
         enabled(_enabled),
         max_dict_buffer_bytes(_max_dict_buffer_bytes),
-        use_zstd_dict_trainer(_use_zstd_dict_trainer) {}
+        use_zstd_dict_trainer(_use_zstd_dict_trainer),
+        shared_dict_per_compaction(false) {}
 };
 
 // Temperature of a file. Used to pass to FileSystem for a different
@@ -708,6 +726,24 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   uint64_t hard_pending_compaction_bytes_limit = 256 * 1073741824ull;
 
+  // Only applicable when use_dynamic_delay = true.
+  // How strongly this column family's stall pressure may throttle the shared
+  // delayed write rate. With the dynamic delay mechanism the effective rate is
+  // the minimum of the rates requested by all delayed column families, so one
+  // column family's compaction debt slows down writers to every other column
+  // family. A weight in (0, 1] caps the reduction this column family may
+  // impose: with weight w and requested rate r, the rate recorded on its
+  // behalf is max_rate - w * (max_rate - r). Weight 1 gives today's behavior
+  // (the request is taken as-is); e.g. weight 0.25 lets this column family's
+  // debt claim at most a quarter of the slowdown it asks for, leaving more of
+  // the budget to writers of other column families. Values outside (0, 1] are
+  // treated as 1.
+  //
+  // Default: 1.0
+  //
+  // Dynamically changeable through SetOptions() API
+  double write_delay_weight = 1.0;
+
   // The compaction style. Default: kCompactionStyleLevel
   CompactionStyle compaction_style = kCompactionStyleLevel;
 
@@ -823,6 +859,22 @@ struct AdvancedColumnFamilyOptions {
   // Default: true
   bool force_consistency_checks = true;
 
+  // Declares this column family as WAL-free: its contents are rebuildable
+  // derived data, all writes to it are expected to use
+  // WriteOptions::disableWAL, and its recovery contract is "restore to the
+  // last flush". Flushing a WAL-free column family skips syncing closed WALs,
+  // so its flushes no longer wait on unrelated WAL traffic from other column
+  // families (and vice versa for atomic flushes covering only WAL-free
+  // column families).
+  //
+  // If WAL-enabled writes are applied to a WAL-free column family anyway,
+  // the data is still recovered from the WAL, but atomicity of a write batch
+  // spanning this and other column families is no longer guaranteed across a
+  // crash that races with a flush.
+  //
+  // Default: false
+  bool wal_free = false;
+
   // Measure IO stats in compactions and flushes, if true.
   //
   // Default: false
@@ -974,6 +1026,20 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   uint64_t min_blob_size = 0;
 
+  // When positive, enables adaptive key-value separation: the effective
+  // min_blob_size of each new flush or compaction is derived from an online
+  // histogram of the column family's observed value sizes, so that
+  // approximately this fraction of newly written values stays inline in the
+  // SST files. min_blob_size acts as a lower bound on the derived threshold.
+  // The value must be in the range [0.0, 1.0]; zero disables adaptation and
+  // min_blob_size is used as-is. Note that enable_blob_files has to be set in
+  // order for this option to have any effect.
+  //
+  // Default: 0.0 (disabled)
+  //
+  // Dynamically changeable through the SetOptions() API
+  double blob_adaptive_inline_ratio = 0.0;
+
   // The size limit for blob files. When writing blob files, a new file is
   // opened once this limit is reached. Note that enable_blob_files has to be
   // set in order for this option to have any effect.
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+
 #include "rocksdb/options.h"
 #include "rocksdb/system_clock.h"
 #include "rocksdb/table_reader_caller.h"
@@ -146,4 +149,40 @@ std::unique_ptr<BlockCacheTraceWriter> NewBlockCacheTraceWriter(
     SystemClock* clock, const BlockCacheTraceWriterOptions& trace_options,
     std::unique_ptr<TraceWriter>&& trace_writer);
 
+// Aggregated statistics over the accesses observed by a
+// BlockCacheTraceStatsCollector.
+struct BlockCacheTraceStats {
+  uint64_t total_accesses = 0;
+  uint64_t total_hits = 0;
+  // Accesses and hits broken down by the higher level request that triggered
+  // the block cache lookup, and by block type.
+  std::map<TableReaderCaller, uint64_t> accesses_per_caller;
+  std::map<TableReaderCaller, uint64_t> hits_per_caller;
+  std::map<TraceType, uint64_t> accesses_per_block_type;
+  std::map<TraceType, uint64_t> hits_per_block_type;
+  // Number of distinct blocks observed and the sum of their sizes. This is a
+  // lower bound on the working set size; when accesses are downsampled 1-in-N
+  // by block key (BlockCacheTraceOptions::sampling_frequency), multiply by N
+  // for an estimate of the full working set.
+  uint64_t distinct_blocks = 0;
+  uint64_t distinct_block_bytes = 0;
+};
+
+// A BlockCacheTraceWriter that aggregates the accesses into in-memory
+// statistics instead of persisting them, so block cache behavior can be
+// analyzed in-process from live traffic rather than from offline trace files.
+// Intended for always-on downsampled tracing: pass an instance to
+// DB::StartBlockCacheTrace() together with a
+// BlockCacheTraceOptions::sampling_frequency, keep a reference to it, and
+// poll GetStats() periodically. All methods are thread-safe.
+class BlockCacheTraceStatsCollector : public BlockCacheTraceWriter {
+ public:
+  virtual BlockCacheTraceStats GetStats() const = 0;
+};
+
+// Allocate an instance of the built-in BlockCacheTraceStatsCollector
+// implementation.
+std::unique_ptr<BlockCacheTraceStatsCollector>
+NewBlockCacheTraceStatsCollector();
+
 }  // namespace ROCKSDB_NAMESPACE
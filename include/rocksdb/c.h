@@ -571,6 +571,15 @@ extern ROCKSDB_LIBRARY_API void rocksdb_batched_multi_get_cf(
     const char* const* keys_list, const size_t* keys_list_sizes,
     rocksdb_pinnableslice_t** values, char** errs, const bool sorted_input);
 
+// Same as rocksdb_batched_multi_get_cf, but on the default column family.
+// Found values are returned as PinnableSlices that may reference block cache
+// memory directly; each non-NULL values entry must be released with
+// rocksdb_pinnableslice_destroy.
+extern ROCKSDB_LIBRARY_API void rocksdb_multi_get_pinned(
+    rocksdb_t* db, const rocksdb_readoptions_t* options, size_t num_keys,
+    const char* const* keys_list, const size_t* keys_list_sizes,
+    rocksdb_pinnableslice_t** values, char** errs, const bool sorted_input);
+
 // The value is only allocated (using malloc) and returned if it is found and
 // value_found isn't NULL. In that case the user is responsible for freeing it.
 extern ROCKSDB_LIBRARY_API unsigned char rocksdb_key_may_exist(
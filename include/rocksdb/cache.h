@@ -26,6 +26,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -38,6 +39,7 @@ namespace ROCKSDB_NAMESPACE {
 class Cache;  // defined in advanced_cache.h
 struct ConfigOptions;
 class SecondaryCache;
+class Slice;
 
 // Classifications of block cache entries.
 //
@@ -75,6 +77,9 @@ enum class CacheEntryRole {
   // Blob cache's charge to account for its memory usage (when using a
   // separate block cache and blob cache)
   kBlobCache,
+  // Fragmented range tombstone structure built from an SST file's range
+  // deletion block, shared by all readers of the file
+  kFragmentedRangeTombstoneList,
   // Default bucket, for miscellaneous cache entries. Do not use for
   // entries that could potentially add up to large usage.
   kMisc,
@@ -175,6 +180,28 @@ struct ShardedCacheOptions {
         metadata_charge_policy(_metadata_charge_policy) {}
 };
 
+// The verdict of a CacheAdmissionPolicy for a single insert.
+enum class CacheEntryAdmission : char {
+  // Insert normally, with the priority the caller asked for.
+  kAdmit,
+  // Insert at bottom priority, making the entry first in line for eviction
+  // unless it gets a hit before then.
+  kAdmitAtBottom,
+  // Do not cache the entry. The insert behaves as if the entry was inserted
+  // and immediately evicted.
+  kReject,
+};
+
+// A policy consulted on every insert into an LRU cache, with the entry's key,
+// its role and its charge. bottom_priority is true for inserts the caller
+// already marked as cold, which includes data blocks read on behalf of
+// compactions; a policy can use that to keep one-pass compaction readahead
+// from wiping out the hot working set. The policy runs on the insert path of
+// every shard, so it must be thread safe and cheap.
+using CacheAdmissionPolicy = std::function<CacheEntryAdmission(
+    const Slice& key, CacheEntryRole role, size_t charge,
+    bool bottom_priority)>;
+
 struct LRUCacheOptions : public ShardedCacheOptions {
   // Ratio of cache reserved for high-priority and low-priority entries,
   // respectively. (See Cache::Priority below more information on the levels.)
@@ -209,6 +236,21 @@ struct LRUCacheOptions : public ShardedCacheOptions {
   // -DROCKSDB_DEFAULT_TO_ADAPTIVE_MUTEX, false otherwise.
   bool use_adaptive_mutex = kDefaultToAdaptiveMutex;
 
+  // Optional admission policy consulted on every insert. See
+  // CacheAdmissionPolicy above. Default: admit everything.
+  CacheAdmissionPolicy admission_policy;
+
+  // EXPERIMENTAL
+  // If set to a compression type other than kNoCompression, unreferenced
+  // entries that reach the cold end of the LRU list are compressed in place
+  // (when their cache item helper supports serialization) before the cache
+  // resorts to evicting them, and are transparently decompressed again on
+  // their next lookup. This stretches effective capacity for cold-but-not-
+  // dead entries without the handle overhead of a second cache tier.
+  // Ignored when a secondary cache is configured, since eviction then hands
+  // entries to the secondary cache instead.
+  CompressionType compress_cold_entries = kNoCompression;
+
   LRUCacheOptions() {}
   LRUCacheOptions(size_t _capacity, int _num_shard_bits,
                   bool _strict_capacity_limit, double _high_pri_pool_ratio,
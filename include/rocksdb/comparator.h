@@ -161,4 +161,11 @@ extern const Comparator* BytewiseComparator();
 // ordering.
 extern const Comparator* ReverseBytewiseComparator();
 
+// Returns a builtin comparator that enables user-defined timestamps (formatted
+// as uint64_t) while ordering the user key part without UDT with a
+// BytewiseComparator.
+// For the same user key with different timestamps, larger (newer) timestamp
+// comes first.
+extern const Comparator* BytewiseComparatorWithU64Ts();
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,54 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// EXPERIMENTAL: sampled CPU-cycle attribution for the major read-path
+// stages, so a Get regression can be narrowed down to memtable probes,
+// bloom filter checks, index seeks or block reads without rebuilding with
+// external profiling tools.
+//
+// The profiler is process-wide (it covers every DB in the process) and
+// disabled by default. When disabled, each instrumented site costs a single
+// relaxed atomic load; when enabled, only one in every `every_n` operations
+// per thread reads the timestamp counter, so it is cheap enough to leave on
+// in production. Cycle counts come from the CPU timestamp counter (TSC on
+// x86-64, the virtual counter on AArch64) and are comparable between stages
+// on the same machine, not across machines. Building with
+// -DROCKSDB_DISABLE_CYCLE_PROFILING removes the instrumentation entirely.
+
+// The instrumented read-path stages.
+enum CycleStage : uint32_t {
+  kCycleStageMemtableGet = 0,
+  kCycleStageFilterKeyMayMatch,
+  kCycleStageIndexSeek,
+  kCycleStageBlockRead,
+  kNumCycleStages,  // N.B. Must always be the last value!
+};
+
+// Sample one in every `every_n` operations per thread; 0 (the default)
+// disables the profiler.
+void SetCycleProfilerSamplePeriod(uint32_t every_n);
+uint32_t GetCycleProfilerSamplePeriod();
+
+// A human-readable per-stage summary: sample count, total cycles and
+// average cycles per sampled operation.
+std::string GetCycleProfilerReport();
+
+// Number of samples and total cycles recorded for one stage.
+void GetCycleProfilerStage(CycleStage stage, uint64_t* count,
+                           uint64_t* cycles);
+
+// Zero all counters.
+void ResetCycleProfiler();
+
+}  // namespace ROCKSDB_NAMESPACE
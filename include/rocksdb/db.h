@@ -146,6 +146,15 @@ struct IngestExternalFileArg {
 
 struct GetMergeOperandsOptions {
   int expected_max_number_of_operands = 0;
+
+  // If true, the lookup stops as soon as the column family's merge operator's
+  // ShouldMerge(), fed the operands found so far (newest first), returns
+  // true, and only those operands are returned; the rest of the key's history
+  // is not read. Useful for operators that only need a bounded number of
+  // recent operands, e.g. sharded counters where a suffix of the operand list
+  // is enough to reconstruct the value. Off by default, meaning all operands
+  // are returned.
+  bool stop_when_should_merge = false;
 };
 
 // A collections of table properties objects, where
@@ -914,6 +923,26 @@ class DB {
       const std::vector<ColumnFamilyHandle*>& column_families,
       std::vector<Iterator*>* iterators) = 0;
 
+  // EXPERIMENTAL
+  // Returns a single iterator presenting the merged contents of all listed
+  // column families, as of one consistent sequence number. Intended for
+  // tables sharded across column families with disjoint key ranges; if the
+  // same user key exists in several column families, only the entry with the
+  // highest sequence number is surfaced (deletions shadow older entries
+  // regardless of which column family they were written to).
+  //
+  // All listed column families must share the same user comparator and the
+  // same merge operator. Tailing iterators, user-defined timestamps and
+  // BlobDB are not supported. The returned iterator does not support
+  // Refresh(). The iterator is heap allocated and needs to be deleted before
+  // the db is deleted.
+  virtual Status NewMergedCrossCFIterator(
+      const ReadOptions& /*options*/,
+      const std::vector<ColumnFamilyHandle*>& /*column_families*/,
+      Iterator** /*iterator*/) {
+    return Status::NotSupported("NewMergedCrossCFIterator not supported");
+  }
+
   // Return a handle to the current DB state.  Iterators created with
   // this handle will all observe a stable snapshot of the current DB
   // state.  The caller must call ReleaseSnapshot(result) when the
@@ -1009,6 +1038,12 @@ class DB {
     //      stale values more frequently to reduce overhead and latency.
     static const std::string kFastBlockCacheCfStats;
 
+    //  "rocksdb.row-cache-admission-stats" - returns a string describing
+    //      the row cache admission sketch: sampled accesses, decays, and
+    //      how many entries were admitted to or kept out of the row cache.
+    //      Only supported when ColumnFamilyOptions::row_cache is set.
+    static const std::string kRowCacheAdmissionStats;
+
     //  "rocksdb.num-immutable-mem-table" - returns number of immutable
     //      memtables that have not yet been flushed.
     static const std::string kNumImmutableMemTable;
@@ -1033,6 +1068,12 @@ class DB {
     //      running compactions.
     static const std::string kNumRunningCompactions;
 
+    //  "rocksdb.compact-range-progress" - returns a string describing the
+    //      progress of the CompactRange() currently running on the column
+    //      family, as input bytes compacted so far out of the estimated
+    //      total input bytes, or "no manual compaction in progress".
+    static const std::string kCompactRangeProgress;
+
     //  "rocksdb.background-errors" - returns accumulated number of background
     //      errors.
     static const std::string kBackgroundErrors;
@@ -1234,6 +1275,51 @@ class DB {
     return GetMapProperty(DefaultColumnFamily(), property, value);
   }
 
+  // Reads several "string" properties in one call and fills *values with a
+  // property-name-to-value entry for each one that succeeded. Implementations
+  // that need a lock to read properties (see DBImpl) acquire it only once for
+  // the whole batch, which makes this the preferred way for monitoring
+  // agents to scrape many properties without repeatedly colliding with
+  // foreground work. Returns non-OK if any requested property was unknown or
+  // unsupported; the remaining properties are still filled in.
+  virtual Status GetPropertiesSnapshot(
+      ColumnFamilyHandle* column_family, const std::vector<Slice>& properties,
+      std::map<std::string, std::string>* values) {
+    assert(values != nullptr);
+    values->clear();
+    Status result;
+    for (const Slice& property : properties) {
+      std::string value;
+      if (GetProperty(column_family, property, &value)) {
+        values->emplace(property.ToString(), std::move(value));
+      } else if (result.ok()) {
+        result = Status::NotFound("Unknown or unsupported property: " +
+                                  property.ToString());
+      }
+    }
+    return result;
+  }
+  virtual Status GetPropertiesSnapshot(
+      const std::vector<Slice>& properties,
+      std::map<std::string, std::string>* values) {
+    return GetPropertiesSnapshot(DefaultColumnFamily(), properties, values);
+  }
+
+  // EXPERIMENTAL
+  // Fills *report with a human-readable tuning report: rule-based findings
+  // derived from write-stall counters, compaction state and (when
+  // DBOptions::statistics is set) block cache and filter tickers, each with
+  // a concrete SetOptions()/SetDBOptions() suggestion. Every call starts a
+  // new sampling window; counter deltas are relative to the previous call.
+  // The periodic statistics task (stats_dump_period_sec) samples as well and
+  // forwards reports with suggestions to EventListener::OnTuningReport, so
+  // when it is enabled a manual call observes at most one period's worth of
+  // activity. Returns NotSupported for DB implementations without an
+  // advisor.
+  virtual Status GetTuningReport(std::string* /*report*/) {
+    return Status::NotSupported("GetTuningReport not supported");
+  }
+
   // Similar to GetProperty(), but only works for a subset of properties whose
   // return value is an integer. Return the value by integer. Supported
   // properties:
@@ -1345,6 +1431,36 @@ class DB {
     GetApproximateMemTableStats(DefaultColumnFamily(), range, count, size);
   }
 
+  // EXPERIMENTAL
+  // Fast approximation of the number of keys in the user-key range
+  // [range.start, range.limit) of the given column family. Answered from a
+  // per-version summary of the SST metadata that is maintained when a
+  // version is installed, so a call costs a few binary searches and performs
+  // no I/O, unlike GetApproximateSizes(). Keys in memtables and duplicates
+  // across sorted runs are not accounted for, and files straddling the range
+  // boundaries contribute half of their entries, which bounds the error by
+  // the contents of the boundary files.
+  virtual Status EstimateKeysInRange(ColumnFamilyHandle* /*column_family*/,
+                                     const Range& /*range*/,
+                                     uint64_t* /*count*/) {
+    return Status::NotSupported("EstimateKeysInRange() is not implemented");
+  }
+  virtual Status EstimateKeysInRange(const Range& range, uint64_t* count) {
+    return EstimateKeysInRange(DefaultColumnFamily(), range, count);
+  }
+
+  // EXPERIMENTAL
+  // Same as EstimateKeysInRange(), but estimates the SST file bytes covered
+  // by the range instead of the key count.
+  virtual Status EstimateBytesInRange(ColumnFamilyHandle* /*column_family*/,
+                                      const Range& /*range*/,
+                                      uint64_t* /*bytes*/) {
+    return Status::NotSupported("EstimateBytesInRange() is not implemented");
+  }
+  virtual Status EstimateBytesInRange(const Range& range, uint64_t* bytes) {
+    return EstimateBytesInRange(DefaultColumnFamily(), range, bytes);
+  }
+
   // Compact the underlying storage for the key range [*begin,*end].
   // The actual compaction interval might be superset of [*begin, *end].
   // In particular, deleted and overwritten versions are discarded,
@@ -1851,6 +1967,13 @@ class DB {
     return Status::NotSupported("PromoteL0() is not implemented.");
   }
 
+  // EXPERIMENTAL: see experimental::SplitSstFile() for semantics and caveats.
+  virtual Status SplitSstFile(ColumnFamilyHandle* /*column_family*/,
+                              uint64_t /*file_number*/,
+                              const Slice& /*split_user_key*/) {
+    return Status::NotSupported("SplitSstFile() is not implemented.");
+  }
+
   // Trace DB operations. Use EndTrace() to stop tracing.
   virtual Status StartTrace(const TraceOptions& /*options*/,
                             std::unique_ptr<TraceWriter>&& /*trace_writer*/) {
@@ -1909,6 +2032,17 @@ class DB {
     return Status::NotSupported("GetStatsHistory() is not implemented.");
   }
 
+  // Retrieve the most recent write stall state transitions of all column
+  // families, oldest first. Each event carries the stall condition before and
+  // after the transition, the triggering cause and metric value, a wall clock
+  // timestamp in nanoseconds and how long the previous condition lasted. The
+  // DB keeps a bounded in-memory ring of these events, so old transitions are
+  // eventually dropped.
+  virtual Status GetWriteStallTimeline(
+      std::vector<WriteStallTimelineEvent>* /*events*/) {
+    return Status::NotSupported("GetWriteStallTimeline() is not implemented.");
+  }
+
   // Make the secondary instance catch up with the primary by tailing and
   // replaying the MANIFEST and WAL of the primary.
   // Column families created by the primary after the secondary instance starts
@@ -146,6 +146,9 @@ struct EnvOptions {
   // See DBOptions doc
   size_t compaction_readahead_size = 0;
 
+  // See DBOptions doc
+  size_t cold_tier_compaction_readahead_size = 0;
+
   // See DBOptions doc
   size_t random_access_max_buffer_size = 0;
 
@@ -572,6 +575,13 @@ class Env : public Customizable {
   // Lower IO priority for threads from the specified pool.
   virtual void LowerThreadPoolIOPriority(Priority /*pool*/ = LOW) {}
 
+  // Raise IO priority for threads from the specified pool to the highest
+  // best-effort level, so e.g. flush output written by the HIGH pool jumps
+  // ahead of compaction writes from a pool that was lowered to idle class.
+  // Currently only has effect on Linux, with an I/O scheduler that supports
+  // I/O priorities.
+  virtual void RaiseThreadPoolIOPriority(Priority /*pool*/ = HIGH) {}
+
   // Lower CPU priority for threads from the specified pool.
   virtual Status LowerThreadPoolCPUPriority(Priority /*pool*/,
                                             CpuPriority /*pri*/) {
@@ -1594,6 +1604,10 @@ class EnvWrapper : public Env {
     target_.env->LowerThreadPoolIOPriority(pool);
   }
 
+  void RaiseThreadPoolIOPriority(Priority pool) override {
+    target_.env->RaiseThreadPoolIOPriority(pool);
+  }
+
   void LowerThreadPoolCPUPriority(Priority pool) override {
     target_.env->LowerThreadPoolCPUPriority(pool);
   }
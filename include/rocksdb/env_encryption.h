@@ -15,6 +15,7 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class AlignedBuffer;
 class EncryptionProvider;
 
 struct ConfigOptions;
@@ -264,6 +265,12 @@ class EncryptedRandomAccessFile : public FSRandomAccessFile {
                 Slice* result, char* scratch,
                 IODebugContext* dbg) const override;
 
+  // Issues the reads to the underlying file in a single batch, so that the
+  // file system can coalesce or parallelize them, and decrypts every
+  // successful result in place afterwards.
+  IOStatus MultiRead(FSReadRequest* reqs, size_t num_reqs,
+                     const IOOptions& options, IODebugContext* dbg) override;
+
   // Readahead the file starting from offset by n bytes for caching.
   IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& options,
                     IODebugContext* dbg) override;
@@ -309,15 +316,20 @@ class EncryptedWritableFile : public FSWritableFile {
   std::unique_ptr<FSWritableFile> file_;
   std::unique_ptr<BlockAccessCipherStream> stream_;
   size_t prefixLength_;
+  // Buffer in which the data is encrypted before it is passed on to the
+  // underlying file. Lazily allocated and reused across calls; Append()
+  // requires external synchronization, so there is no concurrent use.
+  std::unique_ptr<AlignedBuffer> encrypt_buf_;
+
+  void CloneDataToEncryptBuffer(const Slice& data);
 
  public:
   // Default ctor. Prefix is assumed to be written already.
   EncryptedWritableFile(std::unique_ptr<FSWritableFile>&& f,
                         std::unique_ptr<BlockAccessCipherStream>&& s,
-                        size_t prefixLength)
-      : file_(std::move(f)),
-        stream_(std::move(s)),
-        prefixLength_(prefixLength) {}
+                        size_t prefixLength);
+
+  ~EncryptedWritableFile() override;
 
   using FSWritableFile::Append;
   IOStatus Append(const Slice& data, const IOOptions& options,
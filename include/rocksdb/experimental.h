@@ -25,6 +25,29 @@ Status SuggestCompactRange(DB* db, const Slice* begin, const Slice* end);
 Status PromoteL0(DB* db, ColumnFamilyHandle* column_family,
                  int target_level = 1);
 
+// Split the live SST file identified by `file_number` into two files at
+// `split_user_key` without rewriting any data. The two halves are installed
+// as separate FileMetaData entries that share the physical file through hard
+// links (the filesystem link count acts as the reference count, so each half
+// can later be compacted or deleted independently). The left half covers the
+// keys below `split_user_key` and the right half the keys at or above it;
+// readers clip each half to its own key range. This makes aligning existing
+// files to SST-partitioner boundaries (e.g. moving a tenant's prefix out of
+// a shared file) a metadata-only operation.
+//
+// Requirements: the file must be live in a level >= 1 of the column family's
+// current version, must not be undergoing compaction, and `split_user_key`
+// must fall strictly inside its key range with at least one point entry on
+// each side. The filesystem must support hard links.
+//
+// Caveats: until the halves are rewritten by compaction, aggregate
+// statistics (file sizes, table properties) count the shared file once per
+// half, and backup/import utilities see two files with identical physical
+// contents. Returns TryAgain if the file changed while the split was being
+// prepared; the caller may simply retry.
+Status SplitSstFile(DB* db, ColumnFamilyHandle* column_family,
+                    uint64_t file_number, const Slice& split_user_key);
+
 struct UpdateManifestForFilesStateOptions {
   // When true, read current file temperatures from FileSystem and update in
   // DB manifest when a temperature other than Unknown is reported and
@@ -989,6 +989,23 @@ class FSWritableFile {
     return Append(data, options, dbg);
   }
 
+  // Append several buffers to the end of the file as one logical write.
+  // Implementations that support vectored writes (e.g. pwritev) submit all
+  // buffers in a single system call, letting callers hand over data that
+  // lives in multiple places without first concatenating it. The default
+  // appends the buffers one by one.
+  virtual IOStatus AppendVec(const std::vector<Slice>& data,
+                             const IOOptions& options, IODebugContext* dbg) {
+    IOStatus s;
+    for (const Slice& slice : data) {
+      s = Append(slice, options, dbg);
+      if (!s.ok()) {
+        break;
+      }
+    }
+    return s;
+  }
+
   // PositionedAppend data to the specified offset. The new EOF after append
   // must be larger than the previous EOF. This is to be used when writes are
   // not backed by OS buffers and hence has to always start from the start of
@@ -1667,6 +1684,10 @@ class FSWritableFileWrapper : public FSWritableFile {
                   IODebugContext* dbg) override {
     return target_->Append(data, options, verification_info, dbg);
   }
+  IOStatus AppendVec(const std::vector<Slice>& data, const IOOptions& options,
+                     IODebugContext* dbg) override {
+    return target_->AppendVec(data, options, dbg);
+  }
   IOStatus PositionedAppend(const Slice& data, uint64_t offset,
                             const IOOptions& options,
                             IODebugContext* dbg) override {
@@ -154,18 +154,7 @@ inline IOStatus::IOStatus(Code _code, SubCode _subcode, const Slice& msg,
     : Status(_code, _subcode, false, false, kIOErrorScopeFileSystem) {
   assert(code_ != kOk);
   assert(subcode_ != kMaxSubCode);
-  const size_t len1 = msg.size();
-  const size_t len2 = msg2.size();
-  const size_t size = len1 + (len2 ? (2 + len2) : 0);
-  char* const result = new char[size + 1];  // +1 for null terminator
-  memcpy(result, msg.data(), len1);
-  if (len2) {
-    result[len1] = ':';
-    result[len1 + 1] = ' ';
-    memcpy(result + len1 + 2, msg2.data(), len2);
-  }
-  result[size] = '\0';  // null terminator for C style string
-  state_.reset(result);
+  SetState(msg, msg2);
 }
 
 inline IOStatus::IOStatus(const IOStatus& s) : Status(s.code_, s.subcode_) {
@@ -175,7 +164,7 @@ inline IOStatus::IOStatus(const IOStatus& s) : Status(s.code_, s.subcode_) {
   retryable_ = s.retryable_;
   data_loss_ = s.data_loss_;
   scope_ = s.scope_;
-  state_ = (s.state_ == nullptr) ? nullptr : CopyState(s.state_.get());
+  CopyStateFrom(s);
 }
 inline IOStatus& IOStatus::operator=(const IOStatus& s) {
   // The following condition catches both aliasing (when this == &s),
@@ -190,7 +179,7 @@ inline IOStatus& IOStatus::operator=(const IOStatus& s) {
     retryable_ = s.retryable_;
     data_loss_ = s.data_loss_;
     scope_ = s.scope_;
-    state_ = (s.state_ == nullptr) ? nullptr : CopyState(s.state_.get());
+    CopyStateFrom(s);
   }
   return *this;
 }
@@ -214,6 +203,11 @@ inline IOStatus& IOStatus::operator=(IOStatus&& s) noexcept {
     scope_ = s.scope_;
     s.scope_ = kIOErrorScopeFileSystem;
     state_ = std::move(s.state_);
+    state_is_inline_ = s.state_is_inline_;
+    if (state_is_inline_) {
+      std::memcpy(inline_state_, s.inline_state_, kInlineStateSize);
+      s.state_is_inline_ = false;
+    }
   }
   return *this;
 }
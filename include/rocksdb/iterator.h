@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "rocksdb/cleanable.h"
@@ -58,6 +59,30 @@ class Iterator : public Cleanable {
   // Target does not contain timestamp.
   virtual void Seek(const Slice& target) = 0;
 
+  // EXPERIMENTAL
+  // Two-phase Seek for callers that drive many iterators from one thread.
+  // SeekAsync() starts a Seek(target); when ReadOptions::async_io is set and
+  // the storage supports it, the implementation may submit its first table
+  // reads asynchronously and return before the iterator is positioned. The
+  // callback is invoked exactly once with this iterator, either from inside
+  // SeekAsync() (when the seek completed without deferring any read) or from
+  // inside SeekAwait(). Calling SeekAsync() on a batch of iterators and then
+  // SeekAwait() on each of them overlaps the I/O of the individual seeks.
+  // No other method may be called on this iterator between SeekAsync() and
+  // the invocation of the callback. The default implementation seeks
+  // synchronously and always invokes the callback before returning.
+  virtual void SeekAsync(const Slice& target,
+                         std::function<void(Iterator*)> callback) {
+    Seek(target);
+    callback(this);
+  }
+
+  // EXPERIMENTAL
+  // Completes a seek started by SeekAsync(), waiting for its reads if they
+  // are still in flight, and invokes the pending callback. A no-op when no
+  // seek is pending.
+  virtual void SeekAwait() {}
+
   // Position at the last key in the source that at or before target.
   // The iterator is Valid() after this call iff the source contains
   // an entry that comes at or before target.
@@ -217,6 +217,12 @@ struct WriteStallInfo {
     WriteStallCondition cur;
     WriteStallCondition prev;
   } condition;
+  // what triggered the current condition; kNone when the column family went
+  // back to kNormal
+  WriteStallCause cause = WriteStallCause::kNone;
+  // value of the triggering metric at transition time, see
+  // WriteStallTimelineEvent::trigger_value for its meaning per cause
+  uint64_t trigger_value = 0;
 };
 
 
@@ -758,6 +764,15 @@ class EventListener : public Customizable {
   // returns.  Otherwise, RocksDB may be blocked.
   virtual void OnStallConditionsChanged(const WriteStallInfo& /*info*/) {}
 
+  // A callback function for RocksDB which will be called by the periodic
+  // statistics task (see stats_dump_period_sec) whenever the built-in tuning
+  // advisor has produced a report with at least one suggestion. See
+  // DB::GetTuningReport() for the report contents.
+  //
+  // Note that this function should not run for an extended period of time
+  // before returning. Otherwise, RocksDB may be blocked.
+  virtual void OnTuningReport(DB* /*db*/, const std::string& /*report*/) {}
+
   // A callback function for RocksDB which will be called whenever a file read
   // operation finishes.
   virtual void OnFileReadFinish(const FileOperationInfo& /* info */) {}
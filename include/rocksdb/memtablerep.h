@@ -98,6 +98,13 @@ class MemTableRep {
     virtual int operator()(const char* prefix_len_key,
                            const Slice& key) const = 0;
 
+    // Returns true if this comparator orders the encoded keys exactly like
+    // the default internal key comparator over the builtin forward bytewise
+    // user comparator: increasing user key (bytewise), then decreasing
+    // sequence number. Memtable implementations may use this to compare
+    // keys inline instead of through the virtual interface.
+    virtual bool IsForwardBytewise() const { return false; }
+
     virtual ~KeyComparator() {}
   };
 
@@ -180,6 +187,23 @@ class MemTableRep {
     return true;
   }
 
+  // Insert num keys in one call, with the same per-key semantics as
+  // InsertKey(). Implementations may regroup the keys internally to
+  // amortize locking and search costs across the batch; external
+  // visibility order within the batch is unspecified, so this must only
+  // be used where the whole batch becomes visible atomically (e.g. while
+  // applying a WriteBatch under a sequence number barrier).
+  //
+  // Returns false if any key was a duplicate per InsertKey(); the
+  // remaining keys are still inserted.
+  virtual bool InsertBatch(KeyHandle* handles, size_t num) {
+    bool inserted_all = true;
+    for (size_t i = 0; i < num; ++i) {
+      inserted_all = InsertKey(handles[i]) && inserted_all;
+    }
+    return inserted_all;
+  }
+
   // Returns true iff an entry that compares equal to key is in the collection.
   virtual bool Contains(const char* key) const = 0;
 
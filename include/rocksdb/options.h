@@ -574,6 +574,17 @@ struct DBOptions {
   // Default: true
   bool verify_sst_unique_id_in_manifest = true;
 
+  // If true, then every time the OPTIONS file is persisted (on DB::Open,
+  // SetOptions, column family creation/drop, etc.), the freshly written file
+  // is parsed back in full and verified against the in-memory options as a
+  // sanity check of the serialization round trip. The re-parse rebuilds every
+  // column family's options from text, which can add seconds to DB::Open with
+  // hundreds of column families. Setting this to false skips only the
+  // post-write verification; the OPTIONS file is still written as usual.
+  //
+  // Default: true
+  bool verify_options_file_on_persist = true;
+
   // Use the specified object to interact with the environment,
   // e.g. to read/write files, schedule background work, etc. In the near
   // future, support for doing storage operations such as read/write files
@@ -644,6 +655,8 @@ struct DBOptions {
 
   // If max_open_files is -1, DB will open all files on DB::Open(). You can
   // use this option to increase the number of threads used to open the files.
+  // Also bounds the number of threads used to copy files when creating a
+  // checkpoint.
   // Default: 16
   int max_file_opening_threads = 16;
 
@@ -880,6 +893,16 @@ struct DBOptions {
   // Default: false
   bool use_direct_io_for_flush_and_compaction = false;
 
+  // Use O_DIRECT for WAL writes, bypassing the page cache. WAL bytes are
+  // staged in WritableFileWriter's aligned buffer and written out in
+  // sector-aligned chunks, with the partial tail sector rewritten by the next
+  // append, so WAL syncs no longer compete with page-cache writeback. This
+  // can smooth commit latency tails on hosts where dirty page flushing is
+  // bursty, at the cost of losing read caching of the WAL (only relevant for
+  // recovery and replication tailing).
+  // Default: false
+  bool use_direct_io_for_wal = false;
+
   // If false, fallocate() calls are bypassed, which disables file
   // preallocation. The file space preallocation is used to increase the file
   // write/append performance. By default, RocksDB preallocates space for WAL,
@@ -980,6 +1003,18 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   size_t compaction_readahead_size = 0;
 
+  // If non-zero, overrides compaction_readahead_size for input files whose
+  // temperature is kWarm or kCold. This lets compactions that read from a
+  // slow storage tier (e.g. object storage behind a FileSystem plugin) use
+  // much larger sequential reads than files on the hot tier, where oversized
+  // readahead only wastes memory. Files with other temperatures (including
+  // kUnknown) keep using compaction_readahead_size.
+  //
+  // Default: 0 (cold files use compaction_readahead_size)
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  size_t cold_tier_compaction_readahead_size = 0;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -1237,6 +1272,35 @@ struct DBOptions {
   // entry (#411)
   bool use_clean_delete_during_flush = false;
 
+  // If true, DB::NewIterator() keeps the most recently deleted iterator of
+  // each column family and, when a new iterator with compatible ReadOptions
+  // is requested, rebinds it to the current super-version (using the
+  // Iterator::Refresh() machinery) instead of rebuilding the whole iterator
+  // tree. This can significantly reduce the per-query overhead of workloads
+  // dominated by short range scans.
+  //
+  // A recycled iterator keeps referencing the super-version it was created
+  // with until it is reused or purged, so memtables and SST files may be
+  // released later than with this option off.
+  //
+  // Iterators created with a snapshot, a timestamp or a table_filter, as
+  // well as tailing iterators, are never recycled.
+  //
+  // Default: false
+  bool recycle_iterators = false;
+
+  // If true, new-file entries in the MANIFEST are written with delta-encoded
+  // file numbers (tag kNewFileDelta), which significantly shrinks the
+  // full-state snapshot written on every MANIFEST roll for DBs with many
+  // files. Smaller manifests roll less often and replay faster on recovery.
+  //
+  // WARNING: a MANIFEST written with this option set cannot be opened by
+  // releases that predate the kNewFileDelta tag. Turning the option off
+  // again takes effect at the next MANIFEST roll.
+  //
+  // Default: false
+  bool manifest_delta_encoding = false;
+
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
   // records, ignoring a particular record or skipping replay.
@@ -1306,6 +1370,18 @@ struct DBOptions {
   // versions regardless of the wal_compression settings.
   CompressionType wal_compression = kNoCompression;
 
+  // If true, every WAL record is preceded by a small metadata record listing
+  // the column family ids the write batch touches. Recovery uses it to skip
+  // records whose column families are all flushed past the WAL (or dropped)
+  // without parsing the batch contents, which speeds up restarts when a few
+  // write-heavy column families share the WAL with many mostly-idle ones.
+  // WALs written with this option can only be read by versions that
+  // understand the metadata record; turning the option off again produces
+  // fully backward-compatible WALs.
+  //
+  // Default: false
+  bool wal_tag_column_family_ids = false;
+
   // If true, RocksDB supports flushing multiple column families and committing
   // their results atomically to MANIFEST. Note that it is not
   // necessary to set atomic_flush to true if WAL is always enabled since WAL
@@ -1562,6 +1638,33 @@ struct ReadOptions {
   // Default: nullptr
   const Snapshot* snapshot;
 
+  // If nonzero, Get() reads as of this sequence number instead of taking an
+  // implicit snapshot of the current state. Unlike a Snapshot from
+  // GetSnapshot(), nothing is registered with the DB, so the read skips the
+  // DB mutex acquisitions of snapshot creation and release; in exchange,
+  // nothing prevents compaction from collapsing history at or below this
+  // point. The caller must guarantee the sequence number is recent enough --
+  // typically one recently obtained from GetLatestSequenceNumber(), e.g. for
+  // read-your-writes -- and the DB validates only cheap bounds: the value
+  // must not exceed the last published sequence number and must not be below
+  // the oldest registered snapshot. Must not be combined with `snapshot` or
+  // with transaction read callbacks. Currently only honored by Get() on a
+  // primary DB instance.
+  // Default: 0 (disabled)
+  SequenceNumber snapshot_seqno;
+
+  // If true, point lookups are served from a view that excludes the mutable
+  // memtable: only immutable memtables and SST files are consulted. Those
+  // structures only change at a memtable switch, so the result is a
+  // consistent view of the database as of the most recent switch (e.g.
+  // triggered by a flush); the freshest writes may be missing, but the read
+  // never touches the write-hot memtable. Intended for analytics and
+  // dashboard readers that tolerate bounded staleness. Currently honored by
+  // Get() and MultiGet(); iterators are not affected. May be combined with
+  // `snapshot`, in which case the older of the two views applies.
+  // Default: false
+  bool allow_stale_immutable_view;
+
   // `iterate_lower_bound` defines the smallest key at which the backward
   // iterator can return an entry. Once the bound is passed, Valid() will be
   // false. `iterate_lower_bound` is inclusive ie the bound value is a valid
@@ -1794,6 +1897,21 @@ struct ReadOptions {
   // Default: true
   bool optimize_multiget_for_io;
 
+  // Experimental
+  //
+  // If true, a long-lived iterator will transparently rebuild its internal
+  // iterator tree on the newest super-version at safe points between user
+  // keys, instead of pinning obsolete memtables and SST files until it is
+  // destroyed or manually Refresh()-ed. The rebuild preserves the iterator's
+  // position and is invisible to the caller.
+  //
+  // Only takes effect when `snapshot` is set (so the rebuild cannot change
+  // what the iterator observes) and `timestamp` is not set, and only for
+  // iterators that support Refresh().
+  //
+  // Default: false
+  bool auto_refresh_iterator = false;
+
   // If true, DB with TTL will not Get keys that reached their timeout
   // Default: false
   bool skip_expired_data = false;
@@ -9,6 +9,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "rocksdb/perf_level.h"
 
@@ -276,4 +277,29 @@ struct PerfContext {
 // This function never returns nullptr.
 PerfContext* get_perf_context();
 
+// Always-on sampled perf context collection, for production visibility into
+// per-operation perf counters without paying for full instrumentation.
+//
+// When enabled, roughly one out of every `sample_period` point lookups per
+// thread is sampled: for that operation only, timers are enabled (as if
+// perf_level were kEnableTimeExceptForMutex) and the resulting PerfContext
+// snapshot is recorded into a small per-core ring buffer, overwriting the
+// oldest retained sample. Other operations pay a single thread-local counter
+// update. Sampling does not disturb perf context state a caller is gathering
+// through get_perf_context(), except that the caller's counters do not
+// accumulate during a sampled operation.
+//
+// `sample_period` == 0 disables sampling (as does
+// DisablePerfContextSampling()). These functions affect the whole process,
+// like SetPerfLevel().
+void EnablePerfContextSampling(uint64_t sample_period);
+void DisablePerfContextSampling();
+
+// Drain the collected samples, oldest retained sample of each core first.
+// Each returned string is one snapshot in PerfContext::ToString() format,
+// prefixed with the sample's wall clock time:
+//   "timestamp_us = <microseconds since epoch>, <counters...>"
+std::vector<std::string> GetSampledPerfContexts(
+    bool exclude_zero_counters = true);
+
 }  // namespace ROCKSDB_NAMESPACE
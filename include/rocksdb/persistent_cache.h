@@ -71,4 +71,15 @@ Status NewPersistentCache(Env* const env, const std::string& path,
                           const std::shared_ptr<Logger>& log,
                           const bool optimized_for_nvm,
                           std::shared_ptr<PersistentCache>* cache);
+
+class SecondaryCache;
+
+// Wrap a persistent cache as a SecondaryCache so it can serve as the
+// second tier of the block cache (LRUCacheOptions::secondary_cache) instead
+// of going through the legacy BlockBasedTableOptions::persistent_cache hook.
+// The persistent cache must store uncompressed data (IsCompressed() must
+// return false); otherwise, or if persistent_cache is nullptr, this returns
+// nullptr.
+std::shared_ptr<SecondaryCache> NewPersistentCacheSecondaryCache(
+    const std::shared_ptr<PersistentCache>& persistent_cache);
 }  // namespace ROCKSDB_NAMESPACE
@@ -145,7 +145,11 @@ class RateLimiter {
 // from flush. Low-pri requests can get blocked if flush requests come in
 // continuously. This fairness parameter grants low-pri requests permission by
 // 1/fairness chance even though high-pri requests exist to avoid starvation.
-// You should be good by leaving it at default 10.
+// You should be good by leaving it at default 10. Setting fairness to 0
+// disables this lottery entirely: queues are always served in strict priority
+// order, so e.g. a flush (high-pri) write never waits behind queued
+// compaction (low-pri) grants, at the cost of possibly starving low-pri
+// requests.
 // @mode: Mode indicates which types of operations count against the limit.
 // @auto_tuned: Enables dynamic adjustment of rate limit within the range
 //              `[rate_bytes_per_sec / 20, rate_bytes_per_sec]`, according to
@@ -156,4 +160,27 @@ extern RateLimiter* NewGenericRateLimiter(
     RateLimiter::Mode mode = RateLimiter::Mode::kWritesOnly,
     bool auto_tuned = false);
 
+// Create a RateLimiter that enforces the limit like NewGenericRateLimiter but
+// adjusts the limit itself from foreground latency instead of background I/O
+// demand. Every tuning window the limiter reads `latency_histogram` (e.g.
+// DB_GET or DB_WRITE) from `statistics` and compares the average operation
+// latency of that window, in microseconds, against `target_latency_micros`:
+// - above the target, the background I/O budget is cut to relieve pressure;
+// - below 3/4 of the target, the budget is raised back towards
+//   `max_rate_bytes_per_sec` to use the available headroom.
+// The computed limit stays within
+// `[max_rate_bytes_per_sec / 20, max_rate_bytes_per_sec]`.
+// `statistics` should be the Statistics object the DB(s) sharing this limiter
+// record into, and must outlive the limiter.
+// Note the controller holds the windowed average latency under the target:
+// the Statistics interface only exposes cumulative histogram summaries, of
+// which the sample count and sum can be differenced between windows while
+// tail percentiles cannot.
+extern RateLimiter* NewLatencyTunedRateLimiter(
+    int64_t max_rate_bytes_per_sec,
+    const std::shared_ptr<Statistics>& statistics, uint32_t latency_histogram,
+    uint64_t target_latency_micros, int64_t refill_period_us = 100 * 1000,
+    int32_t fairness = 10,
+    RateLimiter::Mode mode = RateLimiter::Mode::kWritesOnly);
+
 }  // namespace ROCKSDB_NAMESPACE
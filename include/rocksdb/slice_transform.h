@@ -14,10 +14,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <string>
 
 #include "rocksdb/customizable.h"
+#include "rocksdb/slice.h"
 #include "rocksdb/rocksdb_namespace.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -119,6 +123,55 @@ class SliceTransform : public Customizable {
   virtual bool SameResultWhenAppended(const Slice& /*prefix*/) const {
     return false;
   }
+
+  // Tag identifying the built-in transforms, so hot paths (per-seek prefix
+  // extraction, prefix Bloom probes) can perform the extraction inline
+  // instead of through virtual dispatch. User-defined transforms keep
+  // kGeneral and always go through the virtuals.
+  enum class Kind : uint8_t { kGeneral = 0, kFixed, kCapped, kNoop };
+
+  Kind kind() const { return kind_; }
+
+  // Equivalent to Transform(), devirtualized for the built-in fixed /
+  // capped / noop transforms.
+  Slice TransformInline(const Slice& key) const {
+    switch (kind_) {
+      case Kind::kFixed:
+        assert(key.size() >= kind_len_);
+        return Slice(key.data(), kind_len_);
+      case Kind::kCapped:
+        return Slice(key.data(), std::min(kind_len_, key.size()));
+      case Kind::kNoop:
+        return key;
+      default:
+        return Transform(key);
+    }
+  }
+
+  // Equivalent to InDomain(), devirtualized for the built-in transforms.
+  bool InDomainInline(const Slice& key) const {
+    switch (kind_) {
+      case Kind::kFixed:
+        return key.size() >= kind_len_;
+      case Kind::kCapped:
+      case Kind::kNoop:
+        return true;
+      default:
+        return InDomain(key);
+    }
+  }
+
+ protected:
+  // Only for the built-in transforms: records the subclass and its prefix
+  // length so the *Inline() methods above can bypass virtual dispatch.
+  void MarkAsBuiltin(Kind kind, size_t len) {
+    kind_ = kind;
+    kind_len_ = len;
+  }
+
+ private:
+  Kind kind_ = Kind::kGeneral;
+  size_t kind_len_ = 0;
 };
 
 // The prefix is the first `prefix_len` bytes of the key, and keys shorter
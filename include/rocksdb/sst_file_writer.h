@@ -8,6 +8,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "rocksdb/env.h"
 #include "rocksdb/options.h"
@@ -126,6 +128,18 @@ class SstFileWriter {
   // the comparator.
   Status Put(const Slice& user_key, const Slice& timestamp, const Slice& value);
 
+  // Add a batch of Put (key, value) pairs to the currently opened file.
+  // Equivalent to calling Put() on each pair in order, but validates the
+  // whole batch up front (nothing is added on error) and amortizes the
+  // per-entry bookkeeping, which helps bulk-load pipelines that are
+  // CPU-bound in the writer thread. Combine with
+  // CompressionOptions::parallel_threads to move block compression and
+  // checksumming off this thread as well.
+  // REQUIRES: pairs are sorted in strict ascending key order, and the first
+  // key is after any previously added key according to comparator.
+  // REQUIRES: comparator is *not* timestamp-aware.
+  Status AddBatch(const std::vector<std::pair<Slice, Slice>>& batch);
+
   // Add a Merge key with value to currently opened file
   // REQUIRES: key is after any previously added key according to comparator.
   // REQUIRES: comparator is *not* timestamp-aware.
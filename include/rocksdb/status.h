@@ -35,6 +35,7 @@
 #include <stdlib.h>
 #endif
 
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -156,7 +157,7 @@ class Status {
   // Returns a C style string indicating the message of the Status
   const char* getState() const {
     MarkChecked();
-    return state_.get();
+    return state_is_inline_ ? inline_state_ : state_.get();
   }
 
   // Return a success status.
@@ -473,8 +474,15 @@ class Status {
   bool data_loss_;
   unsigned char scope_;
   // A nullptr state_ (which is at least the case for OK) means the extra
-  // message is empty.
+  // message is empty, unless it is stored inline (see below).
   std::unique_ptr<const char[]> state_;
+  // Messages shorter than kInlineStateSize are stored in inline_state_
+  // instead of on the heap, so that error paths (which often fire exactly
+  // when the system is slowest) do not allocate. When state_is_inline_ is
+  // true, state_ is nullptr and the message lives in inline_state_.
+  static constexpr size_t kInlineStateSize = 40;
+  char inline_state_[kInlineStateSize];
+  bool state_is_inline_ = false;
 #ifdef ROCKSDB_ASSERT_STATUS_CHECKED
   mutable bool checked_ = false;
 #endif  // ROCKSDB_ASSERT_STATUS_CHECKED
@@ -503,6 +511,21 @@ class Status {
 
   static std::unique_ptr<const char[]> CopyState(const char* s);
 
+  // Stores the "msg[: msg2]" extra message, inline when it fits and on the
+  // heap otherwise.
+  void SetState(const Slice& msg, const Slice& msg2);
+
+  // Copies the extra message (inline or heap) from s into this status.
+  void CopyStateFrom(const Status& s) {
+    state_is_inline_ = s.state_is_inline_;
+    if (state_is_inline_) {
+      std::memcpy(inline_state_, s.inline_state_, kInlineStateSize);
+      state_.reset();
+    } else {
+      state_ = (s.state_ == nullptr) ? nullptr : CopyState(s.state_.get());
+    }
+  }
+
   inline void MarkChecked() const {
 #ifdef ROCKSDB_ASSERT_STATUS_CHECKED
     checked_ = true;
@@ -518,7 +541,7 @@ inline Status::Status(const Status& s)
       data_loss_(s.data_loss_),
       scope_(s.scope_) {
   s.MarkChecked();
-  state_ = (s.state_ == nullptr) ? nullptr : CopyState(s.state_.get());
+  CopyStateFrom(s);
 }
 inline Status::Status(const Status& s, Severity sev)
     : code_(s.code_),
@@ -528,7 +551,7 @@ inline Status::Status(const Status& s, Severity sev)
       data_loss_(s.data_loss_),
       scope_(s.scope_) {
   s.MarkChecked();
-  state_ = (s.state_ == nullptr) ? nullptr : CopyState(s.state_.get());
+  CopyStateFrom(s);
 }
 inline Status& Status::operator=(const Status& s) {
   if (this != &s) {
@@ -540,7 +563,7 @@ inline Status& Status::operator=(const Status& s) {
     retryable_ = s.retryable_;
     data_loss_ = s.data_loss_;
     scope_ = s.scope_;
-    state_ = (s.state_ == nullptr) ? nullptr : CopyState(s.state_.get());
+    CopyStateFrom(s);
   }
   return *this;
 }
@@ -567,6 +590,11 @@ inline Status& Status::operator=(Status&& s) noexcept {
     scope_ = std::move(s.scope_);
     s.scope_ = 0;
     state_ = std::move(s.state_);
+    state_is_inline_ = s.state_is_inline_;
+    if (state_is_inline_) {
+      std::memcpy(inline_state_, s.inline_state_, kInlineStateSize);
+      s.state_is_inline_ = false;
+    }
   }
   return *this;
 }
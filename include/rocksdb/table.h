@@ -300,6 +300,14 @@ struct BlockBasedTableOptions {
   // value will be silently overwritten with 1.
   int block_restart_interval = 16;
 
+  // If true, the restart interval of data blocks is tuned per block while
+  // the block is built: runs of keys sharing almost no prefix get restart
+  // points as often as every block_restart_interval / 4 keys (cheap in space,
+  // faster in-block search), while highly compressible runs space them up to
+  // 2 * block_restart_interval keys apart. Blocks remain readable by any
+  // release, since the restart array fully describes restart placement.
+  bool adaptive_block_restart_interval = false;
+
   // Same as block_restart_interval but used for the index block.
   int index_block_restart_interval = 1;
 
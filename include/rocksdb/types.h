@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <string>
+
 #include "rocksdb/slice.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -91,4 +93,27 @@ enum class WriteStallCondition {
   kNormal,
 };
 
+// A single write stall state transition of one column family, as recorded by
+// the in-memory stall timeline and returned by DB::GetWriteStallTimeline().
+struct WriteStallTimelineEvent {
+  // the name of the column family
+  std::string cf_name;
+  // condition before and after the transition
+  WriteStallCondition prev_condition = WriteStallCondition::kNormal;
+  WriteStallCondition cur_condition = WriteStallCondition::kNormal;
+  // what triggered cur_condition; kNone when the column family went back to
+  // kNormal
+  WriteStallCause cause = WriteStallCause::kNone;
+  // value of the triggering metric at transition time: number of unflushed
+  // memtables for kMemtableLimit, number of level-0 files for
+  // kL0FileCountLimit, estimated pending compaction bytes for
+  // kPendingCompactionBytes; 0 otherwise
+  uint64_t trigger_value = 0;
+  // wall clock time of the transition, in nanoseconds
+  uint64_t time_ns = 0;
+  // how long prev_condition had been in effect, in nanoseconds; 0 for the
+  // first recorded transition of a column family
+  uint64_t prev_condition_duration_ns = 0;
+};
+
 }  // namespace ROCKSDB_NAMESPACE
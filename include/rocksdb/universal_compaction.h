@@ -81,6 +81,17 @@ class CompactionOptionsUniversal {
   // Default: false
   bool incremental;
 
+  // EXPERIMENTAL
+  // If true, the size-ratio picker evaluates every eligible window of sorted
+  // runs and picks the one with the lowest projected bytes rewritten per
+  // sorted run removed, instead of greedily taking the first window that
+  // satisfies the size ratio. This avoids committing to a large merge when a
+  // much cheaper one further down the run list removes as many runs, at the
+  // cost of scanning all windows (quadratic in the number of sorted runs,
+  // which is small).
+  // Default: false
+  bool lookahead_scheduling;
+
   // Default set of parameters
   CompactionOptionsUniversal()
       : size_ratio(1),
@@ -90,7 +101,8 @@ class CompactionOptionsUniversal {
         compression_size_percent(-1),
         stop_style(kCompactionStopStyleTotalSize),
         allow_trivial_move(false),
-        incremental(false) {}
+        incremental(false),
+        lookahead_scheduling(false) {}
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,126 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "rocksdb/listener.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Wraps an EventListener so that its callbacks run on a dedicated notifier
+// thread instead of the background flush/compaction thread that produced the
+// event. Use it at registration time when a listener does slow work -- for
+// example exporting to a metrics daemon -- that must not extend flush or
+// compaction duration:
+//
+//   options.listeners.push_back(AsyncEventListener::Wrap(my_listener));
+//
+// Event info objects are copied into a bounded queue; when the queue is full
+// the event is dropped and counted (see GetOverflowCount()) rather than
+// blocking the producer. Callbacks through which the listener mutates engine
+// state (OnBackgroundError, OnErrorRecoveryBegin), the per-file-operation
+// callbacks (whose info objects hold references into the caller's stack) and
+// OnColumnFamilyHandleDeletionStarted (whose handle is about to go away) are
+// forwarded synchronously.
+//
+// Queued events may be delivered after the originating DB has been closed,
+// so the wrapped listener must not dereference the DB pointer from an
+// asynchronously dispatched callback. The destructor delivers all queued
+// events before returning.
+class AsyncEventListener : public EventListener {
+ public:
+  static std::shared_ptr<AsyncEventListener> Wrap(
+      std::shared_ptr<EventListener> target, size_t max_queue_depth = 1024);
+
+  ~AsyncEventListener() override;
+
+  const char* Name() const override { return "AsyncEventListener"; }
+
+  // Number of events dropped because the queue was full.
+  uint64_t GetOverflowCount() const;
+
+  // Blocks until every event queued so far has been delivered.
+  void WaitForPendingEvents();
+
+  // Asynchronously dispatched callbacks.
+  void OnFlushBegin(DB* db, const FlushJobInfo& info) override;
+  void OnFlushCompleted(DB* db, const FlushJobInfo& info) override;
+  void OnCompactionBegin(DB* db, const CompactionJobInfo& ci) override;
+  void OnCompactionCompleted(DB* db, const CompactionJobInfo& ci) override;
+  void OnSubcompactionBegin(const SubcompactionJobInfo& si) override;
+  void OnSubcompactionCompleted(const SubcompactionJobInfo& si) override;
+  void OnTableFileCreated(const TableFileCreationInfo& info) override;
+  void OnTableFileCreationStarted(
+      const TableFileCreationBriefInfo& info) override;
+  void OnTableFileDeleted(const TableFileDeletionInfo& info) override;
+  void OnMemTableSealed(const MemTableInfo& info) override;
+  void OnExternalFileIngested(DB* db,
+                              const ExternalFileIngestionInfo& info) override;
+  void OnStallConditionsChanged(const WriteStallInfo& info) override;
+  void OnTuningReport(DB* db, const std::string& report) override;
+  void OnErrorRecoveryEnd(const BackgroundErrorRecoveryInfo& info) override;
+  void OnBlobFileCreationStarted(
+      const BlobFileCreationBriefInfo& info) override;
+  void OnBlobFileCreated(const BlobFileCreationInfo& info) override;
+  void OnBlobFileDeleted(const BlobFileDeletionInfo& info) override;
+  void OnIOError(const IOErrorInfo& info) override;
+
+  // Synchronously forwarded callbacks; see the class comment.
+  void OnBackgroundError(BackgroundErrorReason reason,
+                         Status* bg_error) override;
+  void OnErrorRecoveryBegin(BackgroundErrorReason reason, Status bg_error,
+                            bool* auto_recovery) override;
+  void OnColumnFamilyHandleDeletionStarted(ColumnFamilyHandle* handle) override;
+  void OnFileReadFinish(const FileOperationInfo& info) override;
+  void OnFileWriteFinish(const FileOperationInfo& info) override;
+  void OnFileFlushFinish(const FileOperationInfo& info) override;
+  void OnFileSyncFinish(const FileOperationInfo& info) override;
+  void OnFileRangeSyncFinish(const FileOperationInfo& info) override;
+  void OnFileTruncateFinish(const FileOperationInfo& info) override;
+  void OnFileCloseFinish(const FileOperationInfo& info) override;
+  bool ShouldBeNotifiedOnFileIO() override;
+
+ private:
+  AsyncEventListener(std::shared_ptr<EventListener> target,
+                     size_t max_queue_depth);
+
+  // Queues the event for the notifier thread, dropping it when the queue is
+  // at capacity.
+  void Enqueue(std::function<void()>&& event);
+
+  void NotifierThread();
+
+  const std::shared_ptr<EventListener> target_;
+  const size_t max_queue_depth_;
+
+  mutable std::mutex mu_;
+  std::condition_variable events_ready_;
+  std::condition_variable events_drained_;
+  std::deque<std::function<void()>> events_;
+  bool delivering_ = false;
+  bool shutting_down_ = false;
+  uint64_t overflow_count_ = 0;
+  std::thread notifier_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
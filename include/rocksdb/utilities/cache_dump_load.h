@@ -137,4 +137,25 @@ Status NewDefaultCacheDumpedLoader(
     std::unique_ptr<CacheDumpReader>&& reader,
     std::unique_ptr<CacheDumpedLoader>* cache_dump_loader);
 
+// Convenience wrapper performing a complete cache dump in one call: creates a
+// file-backed writer at `file_name`, dumps the blocks of `cache` that belong
+// to the DBs in `db_list` (pass an empty list to dump every block) and closes
+// the file. Intended for saving the block cache warm state before a planned
+// restart; pair with LoadDumpedCacheFromFile() after reopening the DB.
+IOStatus DumpCacheToFile(SystemClock* clock,
+                         const std::shared_ptr<Cache>& cache,
+                         const std::vector<DB*>& db_list,
+                         const std::shared_ptr<FileSystem>& fs,
+                         const std::string& file_name);
+
+// Convenience wrapper for the restore side: reads the dump written by
+// DumpCacheToFile() (or any NewToFileCacheDumpWriter-based dump) from
+// `file_name` and inserts the blocks into `secondary_cache`, from which they
+// are promoted to the block cache on first access. Call this after DB::Open,
+// before serving traffic, to avoid the cold-cache period of demand misses.
+IOStatus LoadDumpedCacheFromFile(
+    SystemClock* clock, const BlockBasedTableOptions& toptions,
+    const std::shared_ptr<SecondaryCache>& secondary_cache,
+    const std::shared_ptr<FileSystem>& fs, const std::string& file_name);
+
 }  // namespace ROCKSDB_NAMESPACE
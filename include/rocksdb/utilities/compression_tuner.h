@@ -0,0 +1,109 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rocksdb/compression_type.h"
+#include "rocksdb/listener.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class ColumnFamilyHandle;
+class DB;
+
+struct CompressionTunerOptions {
+  // Compression used per LSM level while the column family keeps up with its
+  // compactions. Typically the tighter (more CPU-hungry) setting.
+  std::vector<CompressionType> tight_compression_per_level;
+
+  // Compression used per LSM level while the column family is under
+  // compaction pressure. Typically a cheap codec (or none) for the lower
+  // levels so compactions catch up faster.
+  std::vector<CompressionType> fast_compression_per_level;
+
+  // Pressure is declared when the estimated pending compaction bytes reach
+  // this fraction of soft_pending_compaction_bytes_limit. The signal is
+  // skipped when the limit is 0 (unlimited).
+  double pending_compaction_bytes_ratio = 0.5;
+
+  // Pressure is also declared when the number of L0 files reaches this
+  // fraction of level0_slowdown_writes_trigger. The signal is skipped when
+  // the trigger is disabled.
+  double l0_files_ratio = 0.5;
+
+  // Number of consecutive flush/compaction completions without pressure
+  // before switching back to the tight profile, to avoid flapping at the
+  // threshold.
+  int calm_events_before_tightening = 4;
+};
+
+// An EventListener that switches managed column families between two
+// compression_per_level profiles through SetOptions(), so compression CPU is
+// traded for ratio only while compaction bandwidth can absorb it. Pressure
+// is re-evaluated after every flush and compaction of a managed column
+// family using the same signals that drive write throttling (pending
+// compaction bytes and the L0 file count).
+//
+// Usage: add the tuner to DBOptions::listeners before opening the DB, then
+// hand it each column family to manage once the DB is open:
+//
+//   auto tuner = std::make_shared<CompressionTuner>(tuner_options);
+//   options.listeners.push_back(tuner);
+//   // ... open the DB ...
+//   tuner->ManageColumnFamily(db, db->DefaultColumnFamily());
+//
+// Unmanaged column families are left alone.
+class CompressionTuner : public EventListener {
+ public:
+  explicit CompressionTuner(const CompressionTunerOptions& options);
+  ~CompressionTuner() override;
+
+  static const char* kClassName() { return "CompressionTuner"; }
+  const char* Name() const override { return kClassName(); }
+
+  // Starts managing `cf` of `db` and applies the tight profile so that the
+  // tuner's state matches the column family's options. The handle must stay
+  // valid until the DB is closed.
+  Status ManageColumnFamily(DB* db, ColumnFamilyHandle* cf);
+
+  // Whether the given column family is currently on the fast profile.
+  bool IsOnFastProfile(const std::string& cf_name) const;
+
+  void OnFlushCompleted(DB* db, const FlushJobInfo& info) override;
+  void OnCompactionCompleted(DB* db, const CompactionJobInfo& info) override;
+
+ protected:
+  // The bottleneck signal; overridable for tests and for deployments that
+  // have a better one (e.g. host-level CPU accounting).
+  virtual bool IsUnderPressure(DB* db, ColumnFamilyHandle* cf) const;
+
+ private:
+  struct CFState;
+
+  void Evaluate(DB* db, const std::string& cf_name);
+  Status ApplyProfile(DB* db, ColumnFamilyHandle* cf, bool fast) const;
+
+  const CompressionTunerOptions options_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<CFState>> cf_states_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
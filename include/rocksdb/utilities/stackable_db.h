@@ -301,6 +301,20 @@ class StackableDB : public DB {
     return db_->GetApproximateMemTableStats(column_family, range, count, size);
   }
 
+  using DB::EstimateKeysInRange;
+  virtual Status EstimateKeysInRange(ColumnFamilyHandle* column_family,
+                                     const Range& range,
+                                     uint64_t* count) override {
+    return db_->EstimateKeysInRange(column_family, range, count);
+  }
+
+  using DB::EstimateBytesInRange;
+  virtual Status EstimateBytesInRange(ColumnFamilyHandle* column_family,
+                                      const Range& range,
+                                      uint64_t* bytes) override {
+    return db_->EstimateBytesInRange(column_family, range, bytes);
+  }
+
   using DB::CompactRange;
   virtual Status CompactRange(const CompactRangeOptions& options,
                               ColumnFamilyHandle* column_family,
@@ -564,6 +578,12 @@ class StackableDB : public DB {
     return db_->PromoteL0(column_family, target_level);
   }
 
+  virtual Status SplitSstFile(ColumnFamilyHandle* column_family,
+                              uint64_t file_number,
+                              const Slice& split_user_key) override {
+    return db_->SplitSstFile(column_family, file_number, split_user_key);
+  }
+
   virtual ColumnFamilyHandle* DefaultColumnFamily() const override {
     return db_->DefaultColumnFamily();
   }
@@ -0,0 +1,100 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rocksdb/statistics.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class Env;
+class RandomRWFile;
+
+// One decoded statistics snapshot from a StatsRingFile.
+struct StatsSnapshot {
+  // Monotonically increasing snapshot number; older snapshots are
+  // overwritten in ring order once the file is full.
+  uint64_t sequence = 0;
+  // Wall-clock time the snapshot was taken, in microseconds.
+  uint64_t timestamp_micros = 0;
+  // Ticker values indexed by the Tickers enum (TickersNameMap order).
+  std::vector<uint64_t> tickers;
+  // Histogram snapshots indexed by the Histograms enum.
+  std::vector<HistogramData> histograms;
+};
+
+// A fixed-size binary ring file of statistics snapshots, meant as a direct
+// persistence target for telemetry that would otherwise be written through
+// the LSM (persist_stats_to_disk stores the same data as key-value pairs in
+// a hidden column family and so generates flush and compaction load).
+//
+// The file holds a small header plus `capacity` fixed-width records, one per
+// snapshot: every ticker and every histogram of the attached Statistics
+// object, checksummed with crc32c. Append() overwrites the oldest record
+// once the ring is full, so disk usage is bounded and constant; a snapshot
+// is a single positioned write with no allocation beyond the record buffer.
+//
+// Typical use is to disable persist_stats_to_disk and call Append() from the
+// application's own telemetry cadence:
+//
+//   std::unique_ptr<StatsRingFile> ring;
+//   StatsRingFile::Open(Env::Default(), "/var/log/db_stats.ring", 1024,
+//                       &ring);
+//   ring->Append(options.statistics.get());  // periodically
+//
+// Reopening an existing file resumes after the highest sequence number
+// present. A file written with a different ticker or histogram schema (e.g.
+// by another release) is rejected with Status::InvalidArgument rather than
+// misread. All methods are thread-safe.
+class StatsRingFile {
+ public:
+  // Opens or creates `fname` with room for `capacity` snapshots. Fails if
+  // the file exists with a different capacity or statistics schema.
+  static Status Open(Env* env, const std::string& fname, uint32_t capacity,
+                     std::unique_ptr<StatsRingFile>* ring);
+
+  ~StatsRingFile();
+
+  // Snapshots all tickers and histograms of `statistics` into the next ring
+  // slot.
+  Status Append(Statistics* statistics);
+
+  // Decodes all valid records, ordered from oldest to newest snapshot.
+  // Slots that were never written or only partially written (e.g. torn by a
+  // crash) fail their checksum and are skipped.
+  Status ReadAll(std::vector<StatsSnapshot>* snapshots) const;
+
+  uint32_t capacity() const { return capacity_; }
+
+ private:
+  StatsRingFile(Env* env, std::unique_ptr<RandomRWFile>&& file,
+                uint32_t capacity, uint64_t next_sequence);
+
+  Status ReadRecord(uint32_t slot, StatsSnapshot* snapshot) const;
+
+  Env* env_;
+  std::unique_ptr<RandomRWFile> file_;
+  const uint32_t capacity_;
+
+  mutable std::mutex mutex_;
+  uint64_t next_sequence_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -160,6 +160,8 @@ struct TransactionDBOptions {
   // Increasing this value will increase the concurrency by dividing the lock
   // table (per column family) into more sub-tables, each with their own
   // separate mutex.
+  // If 0, the number of stripes is scaled to the number of cores on the
+  // machine instead of using a fixed count.
   size_t num_stripes = 16;
 
   // If positive, specifies the default wait timeout in milliseconds when
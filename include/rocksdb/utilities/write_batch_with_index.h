@@ -94,10 +94,20 @@ class WriteBatchWithIndex : public WriteBatchBase {
   // overwrite_key: if true, overwrite the key in the index when inserting
   //                the same key as previously, so iterator will never
   //                show two entries with the same key.
+  // defer_index_build: if true, index maintenance is deferred until the batch
+  //                    is first read (NewIterator*(), GetFromBatch*(),
+  //                    SubBatchCnt()), at which point the whole index is built
+  //                    in one pass over the batch contents. Batches that are
+  //                    written and cleared without ever being read skip index
+  //                    maintenance entirely. The observable index contents are
+  //                    the same as with eager indexing. Note that every read
+  //                    that follows new mutations pays a full rebuild, so this
+  //                    mode is only a win for write-mostly batches.
   explicit WriteBatchWithIndex(
       const Comparator* backup_index_comparator = BytewiseComparator(),
       size_t reserved_bytes = 0, bool overwrite_key = false,
-      size_t max_bytes = 0, size_t protection_bytes_per_key = 0);
+      size_t max_bytes = 0, size_t protection_bytes_per_key = 0,
+      bool defer_index_build = false);
 
   ~WriteBatchWithIndex() override;
   WriteBatchWithIndex(WriteBatchWithIndex&&);
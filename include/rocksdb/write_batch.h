@@ -100,6 +100,31 @@ class WriteBatch : public WriteBatchBase {
     return Put(nullptr, key, value);
   }
 
+  // Ensure the batch's internal buffer can hold at least `total_bytes` of
+  // serialized data (header, per-entry overhead and payload included)
+  // without reallocating. Useful when the final batch size is known up
+  // front, to avoid geometric growth copies while the batch is built.
+  void Reserve(size_t total_bytes);
+
+  // Append a Put record whose key and value contents are filled in by the
+  // caller afterwards: the record is sized for `key_len` and `value_len`
+  // bytes and `*key_out` / `*value_out` are set to writable buffers of those
+  // lengths inside the batch, letting serializers build keys and values in
+  // place instead of copying them in. The buffers are only valid until the
+  // next operation on the batch, and every byte must be written before the
+  // batch is used.
+  // When user-defined timestamps are enabled for the column family, the
+  // timestamp must be accounted for at the end of the `key_len` bytes, as
+  // with the contiguous-buffer Put() above.
+  // Not supported on batches created with `protection_bytes_per_key` > 0,
+  // since the protection info covers key and value contents.
+  Status PutUninitialized(ColumnFamilyHandle* column_family, size_t key_len,
+                          size_t value_len, char** key_out, char** value_out);
+  Status PutUninitialized(size_t key_len, size_t value_len, char** key_out,
+                          char** value_out) {
+    return PutUninitialized(nullptr, key_len, value_len, key_out, value_out);
+  }
+
   // Store the mapping "key->{column1:value1, column2:value2, ...}" in the
   // column family specified by "column_family".
   using WriteBatchBase::PutEntity;
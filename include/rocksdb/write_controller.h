@@ -135,7 +135,14 @@ class WriteController {
   // and the Id (void*) is simply the pointer to their obj
   using ClientIdToRateMap = std::unordered_map<void*, uint64_t>;
 
-  void HandleNewDelayReq(void* client_id, uint64_t client_write_rate);
+  // Record a client's delay requirement. weight (in (0, 1], default 1) caps
+  // how much of the requested slowdown this client may impose on the shared
+  // rate: the recorded rate is max_rate - weight * (max_rate - rate), so a
+  // low-weight client cannot drag every other writer all the way down to its
+  // own requested rate (see AdvancedColumnFamilyOptions::write_delay_weight).
+  // Values outside (0, 1] are treated as 1.
+  void HandleNewDelayReq(void* client_id, uint64_t client_write_rate,
+                         double weight = 1.0);
 
   // Removes a client's delay and updates the Write Controller's effective
   // delayed write rate if applicable
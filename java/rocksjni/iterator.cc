@@ -11,6 +11,7 @@
 #include <jni.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <algorithm>
 
@@ -338,3 +339,63 @@ jint Java_org_rocksdb_RocksIterator_valueByteArray0(
 
   return static_cast<jsize>(value_slice.size());
 }
+
+/*
+ * Each entry is encoded as a 4 byte big-endian key length, the key bytes,
+ * a 4 byte big-endian value length and the value bytes, matching the
+ * default byte order of java.nio.ByteBuffer.
+ *
+ * Class:     org_rocksdb_RocksIterator
+ * Method:    nextBatchDirect0
+ * Signature: (JLjava/nio/ByteBuffer;II)I
+ */
+jint Java_org_rocksdb_RocksIterator_nextBatchDirect0(
+    JNIEnv* env, jobject /*jobj*/, jlong handle, jobject jtarget,
+    jint jtarget_off, jint jtarget_len) {
+  auto* it = reinterpret_cast<ROCKSDB_NAMESPACE::Iterator*>(handle);
+  char* target =
+      reinterpret_cast<char*>(env->GetDirectBufferAddress(jtarget));
+  if (target == nullptr) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env,
+        "Invalid target argument (argument is not a valid direct ByteBuffer)");
+    return 0;
+  }
+  if (env->GetDirectBufferCapacity(jtarget) < (jtarget_off + jtarget_len)) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env,
+        "Invalid target argument. Capacity is less than requested region "
+        "(offset + length).");
+    return 0;
+  }
+
+  auto put_length = [](char* buf, uint32_t len) {
+    buf[0] = static_cast<char>(len >> 24);
+    buf[1] = static_cast<char>(len >> 16);
+    buf[2] = static_cast<char>(len >> 8);
+    buf[3] = static_cast<char>(len);
+  };
+
+  char* pos = target + jtarget_off;
+  char* const end = pos + jtarget_len;
+  while (it->Valid()) {
+    const ROCKSDB_NAMESPACE::Slice key_slice = it->key();
+    const ROCKSDB_NAMESPACE::Slice value_slice = it->value();
+    const size_t entry_size =
+        2 * sizeof(uint32_t) + key_slice.size() + value_slice.size();
+    if (entry_size > static_cast<size_t>(end - pos)) {
+      break;
+    }
+    put_length(pos, static_cast<uint32_t>(key_slice.size()));
+    pos += sizeof(uint32_t);
+    memcpy(pos, key_slice.data(), key_slice.size());
+    pos += key_slice.size();
+    put_length(pos, static_cast<uint32_t>(value_slice.size()));
+    pos += sizeof(uint32_t);
+    memcpy(pos, value_slice.data(), value_slice.size());
+    pos += value_slice.size();
+    it->Next();
+  }
+
+  return static_cast<jint>(pos - (target + jtarget_off));
+}
@@ -110,6 +110,38 @@ public class RocksIterator extends AbstractRocksIterator<RocksDB> {
     return result;
   }
 
+  /**
+   * <p>Copy a batch of entries into {@code buffer} and advance the iterator
+   * past them, all within a single JNI call. Starting at the current entry,
+   * as many entries as fit into the remaining space of {@code buffer} are
+   * written; each entry is encoded as a 4-byte big-endian key length, the
+   * key bytes, a 4-byte big-endian value length and the value bytes, so the
+   * entries can be decoded with {@link ByteBuffer#getInt()} and bulk
+   * {@link ByteBuffer#get(byte[])} reads. The buffer's position is advanced
+   * past the written entries.</p>
+   *
+   * <p>A return value of 0 means either that the iterator is exhausted
+   * ({@link #isValid()} is false) or that the next entry does not fit into
+   * the remaining space of {@code buffer}; use {@link #isValid()} to tell
+   * the two apart. After the iterator is exhausted, {@link #status()}
+   * should be consulted as with plain {@link #next()} iteration.</p>
+   *
+   * <p>REQUIRES: {@link #isValid()}</p>
+   *
+   * @param buffer the direct buffer to receive the encoded entries.
+   * @return the number of bytes written into {@code buffer}.
+   */
+  public int nextBatch(final ByteBuffer buffer) {
+    assert isOwningHandle();
+    if (!buffer.isDirect()) {
+      throw new IllegalArgumentException("buffer must be a direct ByteBuffer");
+    }
+    final int written =
+        nextBatchDirect0(nativeHandle_, buffer, buffer.position(), buffer.remaining());
+    buffer.position(buffer.position() + written);
+    return written;
+  }
+
   @Override protected final native void disposeInternal(final long handle);
   @Override final native boolean isValid0(long handle);
   @Override final native void seekToFirst0(long handle);
@@ -137,4 +169,5 @@ public class RocksIterator extends AbstractRocksIterator<RocksDB> {
   private native int keyByteArray0(long handle, byte[] array, int arrayOffset, int arrayLen);
   private native int valueDirect0(long handle, ByteBuffer buffer, int bufferOffset, int bufferLen);
   private native int valueByteArray0(long handle, byte[] array, int arrayOffset, int arrayLen);
+  private native int nextBatchDirect0(long handle, ByteBuffer buffer, int bufferOffset, int bufferLen);
 }
@@ -44,6 +44,52 @@ public class RocksIteratorTest {
     validateByteBufferResult(iterator.value(byteBuffer), byteBuffer, value);
   }
 
+  @Test
+  public void rocksIteratorNextBatch() throws RocksDBException {
+    try (final Options options =
+             new Options().setCreateIfMissing(true).setCreateMissingColumnFamilies(true);
+         final RocksDB db = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath())) {
+      db.put("key1".getBytes(), "value1".getBytes());
+      db.put("key2".getBytes(), "value2".getBytes());
+      db.put("key3".getBytes(), "value3".getBytes());
+
+      try (final RocksIterator iterator = db.newIterator()) {
+        // A buffer large enough for all entries drains the iterator in one
+        // native call.
+        iterator.seekToFirst();
+        final ByteBuffer batch = ByteBuffer.allocateDirect(64);
+        final int written = iterator.nextBatch(batch);
+        assertThat(written).isEqualTo(3 * (4 + 4 + 4 + 6));
+        assertThat(iterator.isValid()).isFalse();
+        iterator.status();
+
+        batch.flip();
+        for (int i = 1; i <= 3; i++) {
+          final byte[] key = new byte[batch.getInt()];
+          batch.get(key);
+          assertThat(key).isEqualTo(("key" + i).getBytes());
+          final byte[] value = new byte[batch.getInt()];
+          batch.get(value);
+          assertThat(value).isEqualTo(("value" + i).getBytes());
+        }
+        assertThat(batch.hasRemaining()).isFalse();
+
+        // A buffer that only fits one entry leaves the iterator on the next
+        // entry; a buffer too small for any entry writes nothing.
+        iterator.seekToFirst();
+        final ByteBuffer small = ByteBuffer.allocateDirect(4 + 4 + 4 + 6);
+        assertThat(iterator.nextBatch(small)).isEqualTo(4 + 4 + 4 + 6);
+        assertThat(iterator.isValid()).isTrue();
+        assertThat(iterator.key()).isEqualTo("key2".getBytes());
+
+        final ByteBuffer tiny = ByteBuffer.allocateDirect(8);
+        assertThat(iterator.nextBatch(tiny)).isEqualTo(0);
+        assertThat(iterator.isValid()).isTrue();
+        assertThat(iterator.key()).isEqualTo("key2".getBytes());
+      }
+    }
+  }
+
   @Test
   public void rocksIterator() throws RocksDBException {
     try (final Options options =
@@ -30,10 +30,65 @@
 #include "port/port.h"
 #include "rocksdb/env.h"
 #include "test_util/sync_point.h"
+#include "util/mutexlock.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+
+// Keep at most a handful of memtables' worth of blocks around so that an
+// idle process does not hoard memory; with the default 8MB arena block of a
+// 64MB write buffer this is 8 blocks.
+constexpr size_t kFreeListMaxBytes = 64 << 20;
+
+struct BlockFreeListImpl {
+  port::Mutex mu;
+  std::deque<MemMapping> blocks;
+  size_t total_bytes = 0;
+};
+
+BlockFreeListImpl* GetBlockFreeList() {
+  static BlockFreeListImpl instance;
+  return &instance;
+}
+
+}  // namespace
+
+MemMapping ArenaBlockFreeList::Take(size_t length) {
+  BlockFreeListImpl* fl = GetBlockFreeList();
+  MutexLock l(&fl->mu);
+  for (auto it = fl->blocks.begin(); it != fl->blocks.end(); ++it) {
+    if (it->Length() == length) {
+      MemMapping mm = std::move(*it);
+      fl->blocks.erase(it);
+      fl->total_bytes -= length;
+      return mm;
+    }
+  }
+  return MemMapping();
+}
+
+void ArenaBlockFreeList::Return(MemMapping&& mm) {
+  if (mm.Get() == nullptr) {
+    return;
+  }
+  BlockFreeListImpl* fl = GetBlockFreeList();
+  MutexLock l(&fl->mu);
+  if (fl->total_bytes + mm.Length() > kFreeListMaxBytes) {
+    // Let it unmap.
+    return;
+  }
+  fl->total_bytes += mm.Length();
+  fl->blocks.push_back(std::move(mm));
+}
+
+size_t ArenaBlockFreeList::CachedBytes() {
+  BlockFreeListImpl* fl = GetBlockFreeList();
+  MutexLock l(&fl->mu);
+  return fl->total_bytes;
+}
+
 size_t Arena::OptimizeBlockSize(size_t block_size) {
   // Make sure block_size is in optimal range
   block_size = std::max(Arena::kMinBlockSize, block_size);
@@ -68,6 +123,12 @@ Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
 }
 
 Arena::~Arena() {
+  // Recycle the mapped blocks instead of unmapping them, so the next
+  // memtable generation with the same block size skips the mmap and the
+  // page faults.
+  for (auto& mm : huge_blocks_) {
+    ArenaBlockFreeList::Return(std::move(mm));
+  }
   if (tracker_ != nullptr) {
     assert(tracker_->IsMemoryFreed());
     tracker_->FreeMem();
@@ -107,7 +168,16 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
 }
 
 char* Arena::AllocateFromHugePage(size_t bytes) {
-  MemMapping mm = MemMapping::AllocateHuge(bytes);
+  MemMapping mm = ArenaBlockFreeList::Take(bytes);
+  if (mm.Get() == nullptr) {
+    mm = MemMapping::AllocateHuge(bytes);
+  }
+  if (mm.Get() == nullptr) {
+    // Without explicitly reserved huge pages (vm.nr_hugepages), fall back to
+    // an anonymous mapping advised to use transparent huge pages rather than
+    // losing huge page backing entirely.
+    mm = MemMapping::AllocateAnonymousTransparentHuge(bytes);
+  }
   auto addr = static_cast<char*>(mm.Get());
   if (addr) {
     huge_blocks_.push_back(std::move(mm));
@@ -22,6 +22,26 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+// A process-wide, bounded cache of memory-mapped arena blocks. Arenas using
+// huge-page backing return their mappings here on destruction instead of
+// unmapping them, and later arenas with the same block size reuse them. The
+// reused blocks are already faulted in (and already huge-page backed when
+// the kernel granted it), which avoids the mmap/munmap churn and the
+// minor-fault storm otherwise seen at every memtable switch.
+class ArenaBlockFreeList {
+ public:
+  // Returns a cached mapping of exactly `length` bytes, or an empty mapping
+  // if none is cached.
+  static MemMapping Take(size_t length);
+
+  // Offers a mapping for reuse. It is unmapped instead if the cache is at
+  // capacity or the mapping is empty.
+  static void Return(MemMapping&& mm);
+
+  // Total bytes currently cached; for tests and stats.
+  static size_t CachedBytes();
+};
+
 class Arena : public Allocator {
  public:
   // No copying allowed
@@ -256,6 +256,31 @@ TEST(MmapTest, AllocateLazyZeroed) {
   }
 }
 
+TEST_F(ArenaTest, BlockFreeListReuse) {
+  if (!MemMapping::kHugePageSupported) {
+    ROCKSDB_GTEST_SKIP("Huge page backing is not supported on this platform");
+    return;
+  }
+  // Earlier tests may have left recycled blocks behind, so compare against
+  // the cached size observed while the first arena owns its block.
+  size_t during;
+  {
+    Arena arena(Arena::kMinBlockSize, nullptr, kHugePageSize);
+    char* p = arena.AllocateAligned(kHugePageSize, kHugePageSize);
+    ASSERT_NE(p, nullptr);
+    during = ArenaBlockFreeList::CachedBytes();
+  }
+  // Destroying the arena recycles the mapped block rather than unmapping it.
+  ASSERT_EQ(ArenaBlockFreeList::CachedBytes(), during + kHugePageSize);
+  {
+    // A new arena with the same block size takes it back out of the cache.
+    Arena arena(Arena::kMinBlockSize, nullptr, kHugePageSize);
+    char* p = arena.AllocateAligned(kHugePageSize, kHugePageSize);
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(ArenaBlockFreeList::CachedBytes(), during);
+  }
+}
+
 TEST_F(ArenaTest, UnmappedAllocation) {
   // Verify that it's possible to get unmapped pages in large allocations,
   // for memory efficiency and to ensure we don't accidentally waste time &
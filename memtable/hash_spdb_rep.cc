@@ -14,7 +14,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "db/memtable.h"
@@ -29,29 +31,112 @@
 #include "rocksdb/utilities/options_type.h"
 #include "util/hash.h"
 #include "util/heap.h"
+#include "util/math.h"
+#include "util/random.h"
 #include "util/murmurhash.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace ROCKSDB_NAMESPACE {
 namespace {
 struct SpdbKeyHandle {
-  SpdbKeyHandle* GetNextBucketItem() {
-    return next_.load(std::memory_order_acquire);
-  }
-  void SetNextBucketItem(SpdbKeyHandle* handle) {
-    next_.store(handle, std::memory_order_release);
-  }
-  std::atomic<SpdbKeyHandle*> next_ = nullptr;
   char key_[1];
 };
 
+Slice UserKeyWithoutTimestamp(const Slice internal_key,
+                              const MemTableRep::KeyComparator& compare) {
+  auto key_comparator = static_cast<const MemTable::KeyComparator*>(&compare);
+  const Comparator* user_comparator =
+      key_comparator->comparator.user_comparator();
+  const size_t ts_sz = user_comparator->timestamp_size();
+  return ExtractUserKeyAndStripTimestamp(internal_key, ts_sz);
+}
+
+// Width of one vectorized tag probe. Buckets keep an 8-bit tag per entry
+// (taken from the high bits of the user-key hash, same as the data block
+// hash index) so a chain walk only pays the full KeyComparator call on
+// entries whose tag matches the lookup key.
+constexpr size_t kTagGroupSize = 16;
+
+// Returns a bitmask with bit i set iff tags[i] == tag, for one group of
+// kTagGroupSize tags. The scalar fallback compiles to a short branchless
+// loop on targets without SSE2/NEON.
+inline uint32_t TagMatchMask(const uint8_t* tags, uint8_t tag) {
+#ifdef __SSE2__
+  const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags));
+  const __m128i match = _mm_cmpeq_epi8(group, _mm_set1_epi8(tag));
+  return static_cast<uint32_t>(_mm_movemask_epi8(match));
+#elif defined(__ARM_NEON)
+  const uint8x16_t match = vceqq_u8(vld1q_u8(tags), vdupq_n_u8(tag));
+  // Collapse each byte lane to a single bit, NEON has no movemask.
+  const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(match), 4);
+  const uint64_t matches = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kTagGroupSize; ++i) {
+    mask |= static_cast<uint32_t>((matches >> (i * 4)) & 1) << i;
+  }
+  return mask;
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kTagGroupSize; ++i) {
+    mask |= static_cast<uint32_t>(tags[i] == tag) << i;
+  }
+  return mask;
+#endif
+}
+
 struct BucketHeader {
   port::RWMutexWr rwlock_;  // this mutex probably wont cause delay
-  std::atomic<SpdbKeyHandle*> items_ = nullptr;
   std::atomic<uint32_t> elements_num_ = 0;
+  uint32_t capacity_ = 0;
+  // Sorted by internal key, packed into a single cache-line-multiple slab
+  // bump-allocated from the memtable Allocator: the handle pointers first,
+  // then the tag bytes (rounded up to kTagGroupSize so vector probes never
+  // read past the slab). Grown slabs abandon the old one to the arena, the
+  // same way the hash-based reps leak their resized bucket arrays.
+  SpdbKeyHandle** items_ = nullptr;
+  uint8_t* tags_ = nullptr;
 
   BucketHeader() {}
 
-  bool Contains(const char* check_key,
+  static size_t TagArraySize(uint32_t capacity) {
+    return (capacity + kTagGroupSize - 1) / kTagGroupSize * kTagGroupSize;
+  }
+
+  // bitmask of the lanes in the group starting at base that hold real
+  // entries, everything above elements_num_ is slab padding
+  uint32_t ValidLanes(size_t base) const {
+    const size_t left = elements_num_ - base;
+    return (left >= kTagGroupSize) ? 0xffffu
+                                   : ((1u << left) - 1);
+  }
+
+  void EnsureCapacity(Allocator* allocator) {
+    if (elements_num_ < capacity_) {
+      return;
+    }
+    const uint32_t new_capacity =
+        (capacity_ == 0) ? (CACHE_LINE_SIZE / sizeof(SpdbKeyHandle*))
+                         : capacity_ * 2;
+    char* const slab = allocator->AllocateAligned(
+        new_capacity * sizeof(SpdbKeyHandle*) + TagArraySize(new_capacity));
+    SpdbKeyHandle** const new_items = reinterpret_cast<SpdbKeyHandle**>(slab);
+    uint8_t* const new_tags = reinterpret_cast<uint8_t*>(
+        slab + new_capacity * sizeof(SpdbKeyHandle*));
+    if (elements_num_ > 0) {
+      memcpy(new_items, items_, elements_num_ * sizeof(SpdbKeyHandle*));
+      memcpy(new_tags, tags_, elements_num_);
+    }
+    items_ = new_items;
+    tags_ = new_tags;
+    capacity_ = new_capacity;
+  }
+
+  bool Contains(const char* check_key, uint8_t tag,
                 const MemTableRep::KeyComparator& comparator, bool needs_lock) {
     bool index_exist = false;
     if (elements_num_.load() == 0) {
@@ -60,14 +145,17 @@ struct BucketHeader {
     if (needs_lock) {
       rwlock_.ReadLock();
     }
-    SpdbKeyHandle* anchor = items_.load(std::memory_order_acquire);
-    for (auto k = anchor; k != nullptr; k = k->GetNextBucketItem()) {
-      const int cmp_res = comparator(k->key_, check_key);
-      if (cmp_res == 0) {
-        index_exist = true;
-        break;
+    for (size_t base = 0; base < elements_num_; base += kTagGroupSize) {
+      uint32_t mask = TagMatchMask(tags_ + base, tag) & ValidLanes(base);
+      while (mask != 0) {
+        const size_t i = base + CountTrailingZeroBits(mask);
+        mask &= mask - 1;
+        if (comparator(items_[i]->key_, check_key) == 0) {
+          index_exist = true;
+          break;
+        }
       }
-      if (cmp_res > 0) {
+      if (index_exist) {
         break;
       }
     }
@@ -77,14 +165,29 @@ struct BucketHeader {
     return index_exist;
   }
 
-  bool Add(SpdbKeyHandle* handle,
-           const MemTableRep::KeyComparator& comparator) {
+  bool Add(SpdbKeyHandle* handle, uint8_t tag,
+           const MemTableRep::KeyComparator& comparator, Allocator* allocator) {
+    WriteLock wl(&rwlock_);
+    return AddUnderLock(handle, tag, comparator, allocator);
+  }
+
+  // insert a run of handles destined for this bucket while holding the
+  // bucket lock once; results[i] gets the InsertKey() return value
+  void AddRange(SpdbKeyHandle** handles, const uint8_t* tags, size_t num,
+                const MemTableRep::KeyComparator& comparator,
+                Allocator* allocator, bool* results) {
     WriteLock wl(&rwlock_);
-    SpdbKeyHandle* iter = items_.load(std::memory_order_acquire);
-    SpdbKeyHandle* prev = nullptr;
+    for (size_t i = 0; i < num; ++i) {
+      results[i] = AddUnderLock(handles[i], tags[i], comparator, allocator);
+    }
+  }
 
-    for (size_t i = 0; i < elements_num_; i++) {
-      const int cmp_res = comparator(iter->key_, handle->key_);
+  bool AddUnderLock(SpdbKeyHandle* handle, uint8_t tag,
+                    const MemTableRep::KeyComparator& comparator,
+                    Allocator* allocator) {
+    size_t pos = 0;
+    for (; pos < elements_num_; ++pos) {
+      const int cmp_res = comparator(items_[pos]->key_, handle->key_);
       if (cmp_res == 0) {
         // exist!
         return false;
@@ -93,21 +196,21 @@ struct BucketHeader {
         // need to insert before
         break;
       }
-      prev = iter;
-      iter = iter->GetNextBucketItem();
     }
-    handle->SetNextBucketItem(iter);
-    if (prev) {
-      prev->SetNextBucketItem(handle);
-    } else {
-      items_ = handle;
+    EnsureCapacity(allocator);
+    const size_t tail = elements_num_ - pos;
+    if (tail > 0) {
+      memmove(items_ + pos + 1, items_ + pos, tail * sizeof(SpdbKeyHandle*));
+      memmove(tags_ + pos + 1, tags_ + pos, tail);
     }
+    items_[pos] = handle;
+    tags_[pos] = tag;
     elements_num_++;
     return true;
   }
 
-  void Get(const LookupKey& k, const MemTableRep::KeyComparator& comparator,
-           void* callback_args,
+  void Get(const LookupKey& k, uint8_t tag,
+           const MemTableRep::KeyComparator& comparator, void* callback_args,
            bool (*callback_func)(void* arg, const char* entry),
            bool needs_lock) {
     if (elements_num_.load() == 0) {
@@ -117,14 +220,24 @@ struct BucketHeader {
     if (needs_lock) {
       rwlock_.ReadLock();
     }
-    auto iter = items_.load(std::memory_order_acquire);
-    for (; iter != nullptr; iter = iter->GetNextBucketItem()) {
-      if (comparator(iter->key_, k.internal_key()) >= 0) {
-        break;
+    // Only entries carrying the lookup key's tag can be the first entry
+    // >= the lookup key with a matching user key; anything else would make
+    // the callback bail out immediately anyway.
+    size_t start = elements_num_;
+    for (size_t base = 0; base < elements_num_ && start == elements_num_;
+         base += kTagGroupSize) {
+      uint32_t mask = TagMatchMask(tags_ + base, tag) & ValidLanes(base);
+      while (mask != 0) {
+        const size_t i = base + CountTrailingZeroBits(mask);
+        mask &= mask - 1;
+        if (comparator(items_[i]->key_, k.internal_key()) >= 0) {
+          start = i;
+          break;
+        }
       }
     }
-    for (; iter != nullptr; iter = iter->GetNextBucketItem()) {
-      if (!callback_func(callback_args, iter->key_)) {
+    for (size_t i = start; i < elements_num_; ++i) {
+      if (!callback_func(callback_args, items_[i]->key_)) {
         break;
       }
     }
@@ -140,25 +253,77 @@ struct SpdbHashTable {
 
   SpdbHashTable(size_t n_buckets) : buckets_(n_buckets) {}
 
-  bool Add(SpdbKeyHandle* handle,
-           const MemTableRep::KeyComparator& comparator) {
-    BucketHeader* bucket = GetBucket(handle->key_, comparator);
-    return bucket->Add(handle, comparator);
+  bool Add(SpdbKeyHandle* handle, const MemTableRep::KeyComparator& comparator,
+           Allocator* allocator) {
+    uint8_t tag = 0;
+    BucketHeader* bucket = GetBucket(handle->key_, comparator, &tag);
+    return bucket->Add(handle, tag, comparator, allocator);
+  }
+
+  // Insert a batch of handles, visiting each destination bucket once: the
+  // handles are regrouped by bucket so a bucket's lock and cache lines are
+  // only touched for one contiguous run.
+  bool AddBatch(SpdbKeyHandle** handles, size_t num,
+                const MemTableRep::KeyComparator& comparator,
+                Allocator* allocator, bool* results) {
+    struct BatchItem {
+      SpdbKeyHandle* handle;
+      BucketHeader* bucket;
+      uint8_t tag;
+      size_t pos;  // position in the caller's batch
+    };
+    std::vector<BatchItem> items(num);
+    for (size_t i = 0; i < num; ++i) {
+      items[i].handle = handles[i];
+      items[i].bucket = GetBucket(handles[i]->key_, comparator, &items[i].tag);
+      items[i].pos = i;
+    }
+    std::stable_sort(items.begin(), items.end(),
+                     [](const BatchItem& a, const BatchItem& b) {
+                       return a.bucket < b.bucket;
+                     });
+    bool added_all = true;
+    std::vector<SpdbKeyHandle*> run_handles;
+    std::vector<uint8_t> run_tags;
+    std::unique_ptr<bool[]> run_results(new bool[num]);
+    for (size_t i = 0; i < num;) {
+      size_t run_end = i;
+      while (run_end < num && items[run_end].bucket == items[i].bucket) {
+        ++run_end;
+      }
+      run_handles.clear();
+      run_tags.clear();
+      for (size_t j = i; j < run_end; ++j) {
+        run_handles.push_back(items[j].handle);
+        run_tags.push_back(items[j].tag);
+      }
+      items[i].bucket->AddRange(run_handles.data(), run_tags.data(),
+                                run_end - i, comparator, allocator,
+                                run_results.get());
+      for (size_t j = i; j < run_end; ++j) {
+        results[items[j].pos] = run_results[j - i];
+        added_all = run_results[j - i] && added_all;
+      }
+      i = run_end;
+    }
+    return added_all;
   }
 
   bool Contains(const char* check_key,
                 const MemTableRep::KeyComparator& comparator,
                 bool needs_lock) const {
-    BucketHeader* bucket = GetBucket(check_key, comparator);
-    return bucket->Contains(check_key, comparator, needs_lock);
+    uint8_t tag = 0;
+    BucketHeader* bucket = GetBucket(check_key, comparator, &tag);
+    return bucket->Contains(check_key, tag, comparator, needs_lock);
   }
 
   void Get(const LookupKey& k, const MemTableRep::KeyComparator& comparator,
            void* callback_args,
            bool (*callback_func)(void* arg, const char* entry),
            bool needs_lock) const {
-    BucketHeader* bucket = GetBucket(k.internal_key(), comparator);
-    bucket->Get(k, comparator, callback_args, callback_func, needs_lock);
+    uint8_t tag = 0;
+    BucketHeader* bucket = GetBucket(k.internal_key(), comparator, &tag);
+    bucket->Get(k, tag, comparator, callback_args, callback_func, needs_lock);
   }
 
  private:
@@ -167,24 +332,20 @@ struct SpdbHashTable {
                       static_cast<int>(user_key_without_ts.size()), 0);
   }
 
-  static Slice UserKeyWithoutTimestamp(
-      const Slice internal_key, const MemTableRep::KeyComparator& compare) {
-    auto key_comparator = static_cast<const MemTable::KeyComparator*>(&compare);
-    const Comparator* user_comparator =
-        key_comparator->comparator.user_comparator();
-    const size_t ts_sz = user_comparator->timestamp_size();
-    return ExtractUserKeyAndStripTimestamp(internal_key, ts_sz);
-  }
-
   BucketHeader* GetBucket(const char* key,
-                          const MemTableRep::KeyComparator& comparator) const {
-    return GetBucket(comparator.decode_key(key), comparator);
+                          const MemTableRep::KeyComparator& comparator,
+                          uint8_t* tag) const {
+    return GetBucket(comparator.decode_key(key), comparator, tag);
   }
 
   BucketHeader* GetBucket(const Slice& internal_key,
-                          const MemTableRep::KeyComparator& comparator) const {
+                          const MemTableRep::KeyComparator& comparator,
+                          uint8_t* tag) const {
     const size_t hash =
         GetHash(UserKeyWithoutTimestamp(internal_key, comparator));
+    // The bucket index consumes the low hash bits, so take the tag from the
+    // high byte to keep the two as independent as possible.
+    *tag = static_cast<uint8_t>(hash >> 24);
     BucketHeader* bucket =
         const_cast<BucketHeader*>(&buckets_[hash % buckets_.size()]);
     return bucket;
@@ -193,7 +354,7 @@ struct SpdbHashTable {
 
 // SpdbVector implemntation
 
-bool SpdbVector::Add(const char* key) {
+bool SpdbVector::Add(const char* key, uint32_t prefix_hash, bool has_prefix) {
   ReadLock rl(&add_rwlock_);
   if (sorted_) {
     // it means this  entry arrived after an iterator was created and this
@@ -202,6 +363,11 @@ bool SpdbVector::Add(const char* key) {
   }
   const size_t location = n_elements_.fetch_add(1, std::memory_order_relaxed);
   if (location < items_.size()) {
+    if (has_prefix && prefix_bloom_ != nullptr) {
+      // recorded under the add lock, so a Sort() that makes this vector
+      // visible to iterators always observes the bloom entry as well
+      prefix_bloom_->AddHashConcurrently(prefix_hash);
+    }
     items_[location] = key;
     return true;
   }
@@ -273,16 +439,27 @@ SpdbVector::Iterator SpdbVector::Seek(
 }
 
 // SpdbVectorContainer implemanmtation
-bool SpdbVectorContainer::InternalInsert(const char* key) {
-  return curr_vector_.load()->Add(key);
+bool SpdbVectorContainer::InternalInsert(const char* key, uint32_t prefix_hash,
+                                         bool has_prefix) {
+  return curr_vector_.load()->Add(key, prefix_hash, has_prefix);
 }
 
 void SpdbVectorContainer::Insert(const char* key) {
+  uint32_t prefix_hash = 0;
+  bool has_prefix = false;
+  if (transform_ != nullptr) {
+    const Slice user_key =
+        UserKeyWithoutTimestamp(comparator_.decode_key(key), comparator_);
+    if (transform_->InDomain(user_key)) {
+      prefix_hash = BloomHash(transform_->Transform(user_key));
+      has_prefix = true;
+    }
+  }
   num_elements_.fetch_add(1, std::memory_order_relaxed);
   {
     ReadLock rl(&spdb_vectors_add_rwlock_);
 
-    if (InternalInsert(key)) {
+    if (InternalInsert(key, prefix_hash, has_prefix)) {
       return;
     }
   }
@@ -292,13 +469,14 @@ void SpdbVectorContainer::Insert(const char* key) {
   {
     WriteLock wl(&spdb_vectors_add_rwlock_);
 
-    if (InternalInsert(key)) {
+    if (InternalInsert(key, prefix_hash, has_prefix)) {
       return;
     }
 
     {
       MutexLock l(&spdb_vectors_mutex_);
-      SpdbVectorPtr spdb_vector(new SpdbVector(switch_spdb_vector_limit_));
+      SpdbVectorPtr spdb_vector(
+          new SpdbVector(switch_spdb_vector_limit_, NewVectorBloom()));
       spdb_vectors_.push_back(spdb_vector);
       spdb_vector->SetVectorListIter(std::prev(spdb_vectors_.end()));
       curr_vector_.store(spdb_vector.get());
@@ -306,7 +484,7 @@ void SpdbVectorContainer::Insert(const char* key) {
 
     notify_sort_thread = true;
 
-    if (!InternalInsert(key)) {
+    if (!InternalInsert(key, prefix_hash, has_prefix)) {
       assert(false);
       return;
     }
@@ -330,7 +508,8 @@ bool SpdbVectorContainer::InitIterator(IterAnchors& iter_anchor,
     if (!(*last_iter)->IsEmpty()) {
       {
         MutexLock l(&spdb_vectors_mutex_);
-        SpdbVectorPtr spdb_vector(new SpdbVector(switch_spdb_vector_limit_));
+        SpdbVectorPtr spdb_vector(
+            new SpdbVector(switch_spdb_vector_limit_, NewVectorBloom()));
         spdb_vectors_.push_back(spdb_vector);
         spdb_vector->SetVectorListIter(std::prev(spdb_vectors_.end()));
         curr_vector_.store(spdb_vector.get());
@@ -362,9 +541,24 @@ void SpdbVectorContainer::InitIterator(
 void SpdbVectorContainer::SeekIter(const IterAnchors& iter_anchor,
                                    IterHeapInfo* iter_heap_info,
                                    const Slice* seek_key,
-                                   bool up_iter_direction) {
+                                   bool up_iter_direction, bool prefix_seek) {
+  uint32_t prefix_hash = 0;
+  bool filter_by_prefix = false;
+  if (prefix_seek && transform_ != nullptr && seek_key != nullptr) {
+    const Slice user_key = UserKeyWithoutTimestamp(*seek_key, comparator_);
+    if (transform_->InDomain(user_key)) {
+      prefix_hash = BloomHash(transform_->Transform(user_key));
+      filter_by_prefix = true;
+    }
+  }
   iter_heap_info->Reset(up_iter_direction);
   for (auto const& iter : iter_anchor) {
+    if (filter_by_prefix &&
+        !iter->spdb_vector_->MayMatchPrefix(prefix_hash)) {
+      // the caller only needs keys sharing the seek prefix, and this
+      // vector provably has none; skip its sort and merge entirely
+      continue;
+    }
     if (iter->spdb_vector_->Sort(comparator_)) {
       iter->curr_iter_ =
           iter->spdb_vector_->Seek(comparator_, seek_key, up_iter_direction);
@@ -377,24 +571,50 @@ void SpdbVectorContainer::SeekIter(const IterAnchors& iter_anchor,
 
 void SpdbVectorContainer::SortThread() {
   std::unique_lock<std::mutex> lck(sort_thread_mutex_);
-  std::list<SpdbVectorPtr>::iterator sort_iter_anchor = spdb_vectors_.begin();
 
   for (;;) {
-    sort_thread_cv_.wait(lck);
-
-    if (immutable_) {
-      break;
-    }
-
-    std::list<SpdbVectorPtr>::iterator last;
-    last = std::prev(spdb_vectors_.end());
-
-    if (last == sort_iter_anchor) {
+    if (sort_iter_anchor_ == std::prev(spdb_vectors_.end())) {
+      if (immutable_) {
+        break;
+      }
+      sort_thread_cv_.wait(lck);
+      if (immutable_) {
+        break;
+      }
       continue;
     }
+    // claim the next unsorted vector and sort it outside the lock so the
+    // other workers can proceed in parallel
+    auto sort_iter = sort_iter_anchor_;
+    ++sort_iter_anchor_;
+    lck.unlock();
+    (*sort_iter)->Sort(comparator_);
+    lck.lock();
+  }
+}
 
-    for (; sort_iter_anchor != last; ++sort_iter_anchor) {
-      (*sort_iter_anchor)->Sort(comparator_);
+void SpdbVectorContainer::UniqueRandomSample(
+    uint64_t num_entries, uint64_t target_sample_size,
+    std::unordered_set<const char*>* entries) {
+  entries->clear();
+  assert(target_sample_size > 0);
+  Random* rnd = Random::GetTLSInstance();
+  MutexLock l(&spdb_vectors_mutex_);
+  // One linear pass with the select-with-probability
+  // (samples left / entries remaining) scheme used by the skip list rep;
+  // unlike there, each step is a plain vector access, so the pass costs no
+  // key comparisons and no node hops.
+  uint64_t remaining = num_entries;
+  uint64_t num_samples_left = target_sample_size;
+  for (SpdbVectorPtr& spdb_vector : spdb_vectors_) {
+    const size_t n = spdb_vector->Size();
+    for (size_t i = 0; i < n && num_samples_left > 0 && remaining > 0;
+         i++, remaining--) {
+      if (rnd->Next() % remaining < num_samples_left) {
+        if (entries->insert(spdb_vector->At(i)).second) {
+          --num_samples_left;
+        }
+      }
     }
   }
 }
@@ -402,12 +622,14 @@ void SpdbVectorContainer::SortThread() {
 class HashSpdbRep : public MemTableRep {
  public:
   HashSpdbRep(const MemTableRep::KeyComparator& compare, Allocator* allocator,
-              size_t bucket_size, bool use_merge);
+              size_t bucket_size, bool use_merge, size_t sort_thread_count,
+              const SliceTransform* transform);
 
   HashSpdbRep(Allocator* allocator, size_t bucket_size);
 
   void PostCreate(const MemTableRep::KeyComparator& compare,
-                  Allocator* allocator, bool use_merge);
+                  Allocator* allocator, bool use_merge,
+                  size_t sort_thread_count, const SliceTransform* transform);
 
   KeyHandle Allocate(const size_t len, char** buf) override;
 
@@ -427,6 +649,8 @@ class HashSpdbRep : public MemTableRep {
     return InsertKey(handle);
   }
 
+  bool InsertBatch(KeyHandle* handles, size_t num) override;
+
   void MarkReadOnly() override;
 
   bool Contains(const char* key) const override;
@@ -436,11 +660,21 @@ class HashSpdbRep : public MemTableRep {
   void Get(const LookupKey& k, void* callback_args,
            bool (*callback_func)(void* arg, const char* entry)) override;
 
+  void UniqueRandomSample(const uint64_t num_entries,
+                          const uint64_t target_sample_size,
+                          std::unordered_set<const char*>* entries) override {
+    spdb_vectors_cont_->UniqueRandomSample(num_entries, target_sample_size,
+                                           entries);
+  }
+
   ~HashSpdbRep() override;
 
   MemTableRep::Iterator* GetIterator(Arena* arena = nullptr,
                                      bool part_of_flush = false) override;
 
+  MemTableRep::Iterator* GetDynamicPrefixIterator(
+      Arena* arena = nullptr) override;
+
   const MemTableRep::KeyComparator& GetComparator() const {
     return spdb_vectors_cont_->GetComparator();
   }
@@ -452,20 +686,23 @@ class HashSpdbRep : public MemTableRep {
 
 HashSpdbRep::HashSpdbRep(const MemTableRep::KeyComparator& compare,
                          Allocator* allocator, size_t bucket_size,
-                         bool use_merge)
+                         bool use_merge, size_t sort_thread_count,
+                         const SliceTransform* transform)
     : HashSpdbRep(allocator, bucket_size) {
-  spdb_vectors_cont_ =
-      std::make_shared<SpdbVectorContainer>(compare, use_merge);
+  spdb_vectors_cont_ = std::make_shared<SpdbVectorContainer>(
+      compare, use_merge, sort_thread_count, transform);
 }
 
 HashSpdbRep::HashSpdbRep(Allocator* allocator, size_t bucket_size)
     : MemTableRep(allocator), spdb_hash_table_(bucket_size) {}
 
 void HashSpdbRep::PostCreate(const MemTableRep::KeyComparator& compare,
-                             Allocator* allocator, bool use_merge) {
+                             Allocator* allocator, bool use_merge,
+                             size_t sort_thread_count,
+                             const SliceTransform* transform) {
   allocator_ = allocator;
-  spdb_vectors_cont_ =
-      std::make_shared<SpdbVectorContainer>(compare, use_merge);
+  spdb_vectors_cont_ = std::make_shared<SpdbVectorContainer>(
+      compare, use_merge, sort_thread_count, transform);
 }
 
 HashSpdbRep::~HashSpdbRep() {
@@ -490,7 +727,7 @@ KeyHandle HashSpdbRep::Allocate(const size_t len, char** buf) {
 
 bool HashSpdbRep::InsertKey(KeyHandle handle) {
   SpdbKeyHandle* spdb_handle = static_cast<SpdbKeyHandle*>(handle);
-  if (!spdb_hash_table_.Add(spdb_handle, GetComparator())) {
+  if (!spdb_hash_table_.Add(spdb_handle, GetComparator(), allocator_)) {
     return false;
   }
   // insert to later sorter list
@@ -498,6 +735,20 @@ bool HashSpdbRep::InsertKey(KeyHandle handle) {
   return true;
 }
 
+bool HashSpdbRep::InsertBatch(KeyHandle* handles, size_t num) {
+  std::unique_ptr<bool[]> added(new bool[num]);
+  const bool inserted_all = spdb_hash_table_.AddBatch(
+      reinterpret_cast<SpdbKeyHandle**>(handles), num, GetComparator(),
+      allocator_, added.get());
+  for (size_t i = 0; i < num; ++i) {
+    if (added[i]) {
+      spdb_vectors_cont_->Insert(
+          static_cast<SpdbKeyHandle*>(handles[i])->key_);
+    }
+  }
+  return inserted_all;
+}
+
 bool HashSpdbRep::Contains(const char* key) const {
   if (spdb_vectors_cont_->IsEmpty()) {
     return false;
@@ -533,9 +784,25 @@ MemTableRep::Iterator* HashSpdbRep::GetIterator(Arena* arena,
   return new SpdbVectorIterator(spdb_vectors_cont_, GetComparator(),
                                 part_of_flush);
 }
+
+MemTableRep::Iterator* HashSpdbRep::GetDynamicPrefixIterator(Arena* arena) {
+  if (arena != nullptr) {
+    void* mem;
+    mem = arena->AllocateAligned(sizeof(SpdbVectorIterator));
+    return new (mem) SpdbVectorIterator(spdb_vectors_cont_, GetComparator(),
+                                        false /* part_of_flush */,
+                                        true /* prefix_seek */);
+  }
+  return new SpdbVectorIterator(spdb_vectors_cont_, GetComparator(),
+                                false /* part_of_flush */,
+                                true /* prefix_seek */);
+}
 struct HashSpdbRepOptions {
   static const char* kName() { return "HashSpdbRepOptions"; }
   size_t hash_bucket_count;
+  // number of background threads sorting the immutable vectors; raising it
+  // flattens iterator-creation latency on a just-switched memtable
+  size_t sort_thread_count;
   bool use_merge;
 };
 
@@ -545,6 +812,10 @@ static std::unordered_map<std::string, OptionTypeInfo> hash_spdb_factory_info =
          {offsetof(struct HashSpdbRepOptions, hash_bucket_count),
           OptionType::kSizeT, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"sort_thread_count",
+         {offsetof(struct HashSpdbRepOptions, sort_thread_count),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"use_merge",
          {offsetof(struct HashSpdbRepOptions, use_merge), OptionType::kBoolean,
           OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
@@ -553,8 +824,10 @@ static std::unordered_map<std::string, OptionTypeInfo> hash_spdb_factory_info =
 class HashSpdbRepFactory : public MemTableRepFactory {
  public:
   explicit HashSpdbRepFactory(size_t hash_bucket_count = 1000000,
-                              bool use_merge = true) {
+                              bool use_merge = true,
+                              size_t sort_thread_count = 1) {
     options_.hash_bucket_count = hash_bucket_count;
+    options_.sort_thread_count = sort_thread_count;
     options_.use_merge = use_merge;
     RegisterOptions(&options_, &hash_spdb_factory_info);
   }
@@ -590,17 +863,19 @@ MemTableRep* HashSpdbRepFactory::PreCreateMemTableRep() {
 
 void HashSpdbRepFactory::PostCreateMemTableRep(
     MemTableRep* switch_mem, const MemTableRep::KeyComparator& compare,
-    Allocator* allocator, const SliceTransform* /*transform*/,
+    Allocator* allocator, const SliceTransform* transform,
     Logger* /*logger*/) {
   static_cast<HashSpdbRep*>(switch_mem)
-      ->PostCreate(compare, allocator, options_.use_merge);
+      ->PostCreate(compare, allocator, options_.use_merge,
+                   options_.sort_thread_count, transform);
 }
 
 MemTableRep* HashSpdbRepFactory::CreateMemTableRep(
     const MemTableRep::KeyComparator& compare, Allocator* allocator,
-    const SliceTransform* /*transform*/, Logger* /*logger*/) {
+    const SliceTransform* transform, Logger* /*logger*/) {
   return new HashSpdbRep(compare, allocator, options_.hash_bucket_count,
-                         options_.use_merge);
+                         options_.use_merge, options_.sort_thread_count,
+                         transform);
 }
 
 MemTableRepFactory* NewHashSpdbRepFactory(size_t bucket_count, bool use_merge) {
@@ -3,20 +3,88 @@
 //  COPYING file in the root directory) and Apache 2.0 License
 //  (found in the LICENSE.Apache file in the root directory).
 //
+#include <algorithm>
 #include <random>
 
 #include "db/memtable.h"
 #include "memory/arena.h"
 #include "memtable/inlineskiplist.h"
+#include "monitoring/perf_context_imp.h"
 #include "rocksdb/memtablerep.h"
 #include "rocksdb/utilities/options_type.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace {
-class SkipListRep : public MemTableRep {
-  InlineSkipList<const MemTableRep::KeyComparator&> skip_list_;
+
+// Comparator handed to the skip list by value. When the memtable key
+// comparator reports the default ordering over the builtin forward bytewise
+// user comparator, comparisons run inline here - length-prefix decode,
+// memcmp of the user keys and a seqno trailer compare - instead of making a
+// virtual KeyComparator call for every node visited during a descent.
+class SkipListKeyCompare {
+ public:
+  using DecodedType = Slice;
+
+  explicit SkipListKeyCompare(const MemTableRep::KeyComparator& cmp)
+      : cmp_(cmp), bytewise_(cmp.IsForwardBytewise()) {}
+
+  Slice decode_key(const char* key) const {
+    return GetLengthPrefixedSlice(key);
+  }
+
+  int operator()(const char* prefix_len_key1,
+                 const char* prefix_len_key2) const {
+    if (bytewise_) {
+      return CompareBytewise(GetLengthPrefixedSlice(prefix_len_key1),
+                             GetLengthPrefixedSlice(prefix_len_key2));
+    }
+    return cmp_(prefix_len_key1, prefix_len_key2);
+  }
+
+  int operator()(const char* prefix_len_key, const Slice& key) const {
+    if (bytewise_) {
+      return CompareBytewise(GetLengthPrefixedSlice(prefix_len_key), key);
+    }
+    return cmp_(prefix_len_key, key);
+  }
+
+ private:
+  // Same ordering as InternalKeyComparator::CompareKeySeq for a bytewise
+  // user comparator: increasing user key, then decreasing sequence number
+  // (the type byte is excluded, as there).
+  static int CompareBytewise(const Slice& ak, const Slice& bk) {
+    PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    assert(ak.size() >= kNumInternalBytes && bk.size() >= kNumInternalBytes);
+    const size_t a_user = ak.size() - kNumInternalBytes;
+    const size_t b_user = bk.size() - kNumInternalBytes;
+    const size_t min_len = std::min(a_user, b_user);
+    int r = memcmp(ak.data(), bk.data(), min_len);
+    if (r == 0) {
+      if (a_user < b_user) {
+        r = -1;
+      } else if (a_user > b_user) {
+        r = +1;
+      } else {
+        const uint64_t anum = DecodeFixed64(ak.data() + a_user) >> 8;
+        const uint64_t bnum = DecodeFixed64(bk.data() + b_user) >> 8;
+        if (anum > bnum) {
+          r = -1;
+        } else if (anum < bnum) {
+          r = +1;
+        }
+      }
+    }
+    return r;
+  }
+
   const MemTableRep::KeyComparator& cmp_;
+  bool bytewise_;
+};
+
+class SkipListRep : public MemTableRep {
+  InlineSkipList<SkipListKeyCompare> skip_list_;
+  const SkipListKeyCompare cmp_;
   const SliceTransform* transform_;
   const size_t lookahead_;
 
@@ -27,7 +95,7 @@ class SkipListRep : public MemTableRep {
                        Allocator* allocator, const SliceTransform* transform,
                        const size_t lookahead)
       : MemTableRep(allocator),
-        skip_list_(compare, allocator),
+        skip_list_(SkipListKeyCompare(compare), allocator),
         cmp_(compare),
         transform_(transform),
         lookahead_(lookahead) {}
@@ -72,6 +140,20 @@ class SkipListRep : public MemTableRep {
     return skip_list_.InsertConcurrently(static_cast<char*>(handle));
   }
 
+  bool InsertBatch(KeyHandle* handles, size_t num) override {
+    // Consecutive keys of a WriteBatch are frequently close together, so
+    // carrying one splice hint across the whole batch skips most of the
+    // per-key descent from the top level.
+    void* hint = nullptr;
+    bool inserted_all = true;
+    for (size_t i = 0; i < num; ++i) {
+      inserted_all =
+          skip_list_.InsertWithHint(static_cast<char*>(handles[i]), &hint) &&
+          inserted_all;
+    }
+    return inserted_all;
+  }
+
   // Returns true iff an entry that compares equal to key is in the list.
   bool Contains(const char* key) const override {
     return skip_list_.Contains(key);
@@ -165,13 +247,13 @@ class SkipListRep : public MemTableRep {
 
   // Iteration over the contents of a skip list
   class Iterator : public MemTableRep::Iterator {
-    InlineSkipList<const MemTableRep::KeyComparator&>::Iterator iter_;
+    InlineSkipList<SkipListKeyCompare>::Iterator iter_;
 
    public:
     // Initialize an iterator over the specified list.
     // The returned iterator is not valid.
     explicit Iterator(
-        const InlineSkipList<const MemTableRep::KeyComparator&>* list)
+        const InlineSkipList<SkipListKeyCompare>* list)
         : iter_(list) {}
 
     ~Iterator() override {}
@@ -319,8 +401,8 @@ class SkipListRep : public MemTableRep {
 
    private:
     const SkipListRep& rep_;
-    InlineSkipList<const MemTableRep::KeyComparator&>::Iterator iter_;
-    InlineSkipList<const MemTableRep::KeyComparator&>::Iterator prev_;
+    InlineSkipList<SkipListKeyCompare>::Iterator iter_;
+    InlineSkipList<SkipListKeyCompare>::Iterator prev_;
   };
 
   MemTableRep::Iterator* GetIterator(Arena* arena = nullptr,
@@ -16,9 +16,12 @@
 
 #include <atomic>
 
+#include "memory/arena.h"
 #include "port/port.h"
 #include "rocksdb/memtablerep.h"
 #include "rocksdb/slice_transform.h"
+#include "util/autovector.h"
+#include "util/dynamic_bloom.h"
 #include "util/heap.h"
 #include "util/mutexlock.h"
 
@@ -31,8 +34,11 @@ class SpdbVector {
   using Vec = std::vector<const char*>;
   using Iterator = Vec::iterator;
 
-  SpdbVector(size_t switch_spdb_vector_limit)
-      : SpdbVector(Vec(switch_spdb_vector_limit), 0) {}
+  SpdbVector(size_t switch_spdb_vector_limit,
+             DynamicBloom* prefix_bloom = nullptr)
+      : SpdbVector(Vec(switch_spdb_vector_limit), 0) {
+    prefix_bloom_ = prefix_bloom;
+  }
 
   SpdbVector(Vec items, size_t n)
       : items_(std::move(items)),
@@ -48,7 +54,15 @@ class SpdbVector {
     return iter_;
   }
 
-  bool Add(const char* key);
+  bool Add(const char* key) { return Add(key, 0, false); }
+
+  bool Add(const char* key, uint32_t prefix_hash, bool has_prefix);
+
+  // false means no key with the given prefix hash is in this vector;
+  // always true when the memtable has no prefix bloom
+  bool MayMatchPrefix(uint32_t prefix_hash) const {
+    return prefix_bloom_ == nullptr || prefix_bloom_->MayContainHash(prefix_hash);
+  }
 
   bool IsEmpty() const { return n_elements_ == 0; }
 
@@ -83,10 +97,15 @@ class SpdbVector {
 
   size_t Size() const { return n_elements_; }
 
+  // random access to the i-th inserted entry; i must be < Size()
+  const char* At(size_t i) const { return items_[i]; }
+
   Iterator End() { return items_.end(); }
 
  private:
   Vec items_;
+  // backing memory is owned by the container's arena
+  DynamicBloom* prefix_bloom_ = nullptr;
   std::atomic<size_t> n_elements_;
   std::atomic<bool> sorted_;
   // this is the iter the SpdbVector
@@ -138,46 +157,100 @@ using IterHeap = BinaryHeap<SortHeapItem*, IteratorComparator>;
 class IterHeapInfo {
  public:
   IterHeapInfo(const MemTableRep::KeyComparator& comparator)
-      : iter_heap_(new IterHeap(IteratorComparator(comparator, true))),
-        comparator_(comparator) {}
+      : comparator_(comparator) {}
+
+  // Up to this many merge runs the winner is picked with a linear scan of a
+  // flat array instead of a binary heap. A memtable is typically flushed
+  // with only a handful of vectors, and for such small fan-in the scan does
+  // the same number of comparisons as a heap rebalance without the sift
+  // overhead and pointer churn per key.
+  static constexpr size_t kMaxSmallMergeRuns = 4;
 
   void Reset(bool up_iter_direction) {
-    iter_heap_.reset(
-        new IterHeap(IteratorComparator(comparator_, up_iter_direction)));
+    up_iter_direction_ = up_iter_direction;
+    small_items_.clear();
+    small_top_ = 0;
+    iter_heap_.reset();
   }
 
   const char* Key() const {
-    if (iter_heap_.get()->size() != 0) {
-      return iter_heap_.get()->top()->Key();
+    if (iter_heap_) {
+      return iter_heap_->size() != 0 ? iter_heap_->top()->Key() : nullptr;
     }
-    return nullptr;
+    return small_items_.empty() ? nullptr : small_items_[small_top_]->Key();
   }
 
-  bool Valid() const { return iter_heap_.get()->size() != 0; }
+  bool Valid() const {
+    return iter_heap_ ? iter_heap_->size() != 0 : !small_items_.empty();
+  }
 
   SortHeapItem* Get() {
     if (!Valid()) {
       return nullptr;
     }
-    return iter_heap_.get()->top();
+    return iter_heap_ ? iter_heap_->top() : small_items_[small_top_];
   }
 
   void Update(SortHeapItem* sort_item) {
-    if (sort_item->Valid()) {
-      iter_heap_.get()->replace_top(sort_item);
-    } else {
-      iter_heap_.get()->pop();
+    if (iter_heap_) {
+      if (sort_item->Valid()) {
+        iter_heap_->replace_top(sort_item);
+      } else {
+        iter_heap_->pop();
+      }
+      return;
     }
+    assert(small_items_[small_top_] == sort_item);
+    if (!sort_item->Valid()) {
+      small_items_[small_top_] = small_items_.back();
+      small_items_.pop_back();
+    }
+    RefreshSmallTop();
   }
 
-  void Insert(SortHeapItem* sort_item) { iter_heap_.get()->push(sort_item); }
-
-  bool Prev(SortHeapItem* sort_item);
+  void Insert(SortHeapItem* sort_item) {
+    if (iter_heap_) {
+      iter_heap_->push(sort_item);
+      return;
+    }
+    if (small_items_.size() < kMaxSmallMergeRuns) {
+      small_items_.push_back(sort_item);
+      RefreshSmallTop();
+      return;
+    }
+    // Too many runs for the flat array; spill everything into a heap.
+    iter_heap_.reset(
+        new IterHeap(IteratorComparator(comparator_, up_iter_direction_)));
+    for (SortHeapItem* item : small_items_) {
+      iter_heap_->push(item);
+    }
+    small_items_.clear();
+    iter_heap_->push(sort_item);
+  }
 
   const MemTableRep::KeyComparator& Comparator() const { return comparator_; }
 
  private:
+  // true if a sorts before b in the current iteration direction
+  bool Before(const SortHeapItem* a, const SortHeapItem* b) const {
+    const int c = comparator_(a->Key(), b->Key());
+    return up_iter_direction_ ? c < 0 : c > 0;
+  }
+
+  void RefreshSmallTop() {
+    small_top_ = 0;
+    for (size_t i = 1; i < small_items_.size(); i++) {
+      if (Before(small_items_[i], small_items_[small_top_])) {
+        small_top_ = i;
+      }
+    }
+  }
+
+  // nullptr while merging at most kMaxSmallMergeRuns runs
   std::unique_ptr<IterHeap> iter_heap_;
+  autovector<SortHeapItem*, kMaxSmallMergeRuns> small_items_;
+  size_t small_top_ = 0;
+  bool up_iter_direction_ = true;
   const MemTableRep::KeyComparator& comparator_;
 };
 
@@ -186,25 +259,34 @@ using IterAnchors = std::list<SortHeapItem*>;
 class SpdbVectorContainer {
  public:
   SpdbVectorContainer(const MemTableRep::KeyComparator& comparator,
-                      bool use_merge)
+                      bool use_merge, size_t sort_thread_count = 1,
+                      const SliceTransform* transform = nullptr)
       : comparator_(comparator),
         switch_spdb_vector_limit_(10000),
         immutable_(false),
         num_elements_(0),
-        use_merge_(use_merge) {
-    SpdbVectorPtr spdb_vector(new SpdbVector(switch_spdb_vector_limit_));
+        use_merge_(use_merge),
+        transform_(transform) {
+    SpdbVectorPtr spdb_vector(
+        new SpdbVector(switch_spdb_vector_limit_, NewVectorBloom()));
     spdb_vectors_.push_front(spdb_vector);
     spdb_vector->SetVectorListIter(std::prev(spdb_vectors_.end()));
     curr_vector_.store(spdb_vector.get());
-    sort_thread_ = port::Thread(&SpdbVectorContainer::SortThread, this);
+    sort_iter_anchor_ = spdb_vectors_.begin();
+    sort_threads_.reserve(std::max<size_t>(sort_thread_count, 1));
+    for (size_t i = 0; i < std::max<size_t>(sort_thread_count, 1); ++i) {
+      sort_threads_.emplace_back(&SpdbVectorContainer::SortThread, this);
+    }
   }
 
   ~SpdbVectorContainer() {
     MarkReadOnly();
-    sort_thread_.join();
+    for (auto& sort_thread : sort_threads_) {
+      sort_thread.join();
+    }
   }
 
-  bool InternalInsert(const char* key);
+  bool InternalInsert(const char* key, uint32_t prefix_hash, bool has_prefix);
 
   void Insert(const char* key);
 
@@ -216,6 +298,12 @@ class SpdbVectorContainer {
 
   bool IsReadOnly() const { return immutable_.load(); }
 
+  // Collect ~target_sample_size unique random entries for the mempurge
+  // decider; see MemTableRep::UniqueRandomSample(). Unlike the skip list
+  // rep, the vectors allow sampling without any key comparisons.
+  void UniqueRandomSample(uint64_t num_entries, uint64_t target_sample_size,
+                          std::unordered_set<const char*>* entries);
+
   // create a list of current vectors
   bool InitIterator(IterAnchors& iter_anchor, bool part_of_flush);
 
@@ -223,9 +311,11 @@ class SpdbVectorContainer {
                     std::list<SpdbVectorPtr>::iterator start,
                     std::list<SpdbVectorPtr>::iterator last);
 
-  // seek & build the heap
+  // seek & build the heap; with prefix_seek, vectors whose prefix bloom
+  // rules out the seek key prefix are not sorted or merged at all
   void SeekIter(const IterAnchors& iter_anchor, IterHeapInfo* iter_heap_info,
-                const Slice* seek_key, bool up_iter_direction);
+                const Slice* seek_key, bool up_iter_direction,
+                bool prefix_seek = false);
 
   void MarkReadOnly() {
     {
@@ -233,7 +323,7 @@ class SpdbVectorContainer {
       WriteLock wl(&spdb_vectors_add_rwlock_);
       immutable_.store(true);
     }
-    sort_thread_cv_.notify_one();
+    sort_thread_cv_.notify_all();
   }
   const MemTableRep::KeyComparator& GetComparator() const {
     return comparator_;
@@ -242,6 +332,18 @@ class SpdbVectorContainer {
  private:
   void SortThread();
 
+  // one bloom per vector, sized for the vector switch limit; nullptr when
+  // no prefix extractor is configured
+  DynamicBloom* NewVectorBloom() {
+    if (transform_ == nullptr) {
+      return nullptr;
+    }
+    auto* mem = bloom_arena_.AllocateAligned(sizeof(DynamicBloom));
+    return new (mem) DynamicBloom(
+        &bloom_arena_,
+        static_cast<uint32_t>(switch_spdb_vector_limit_ * 10), 6);
+  }
+
  private:
   port::RWMutexWr spdb_vectors_add_rwlock_;
   port::Mutex spdb_vectors_mutex_;
@@ -253,7 +355,14 @@ class SpdbVectorContainer {
   // sort thread info
   std::atomic<size_t> num_elements_;
   bool use_merge_;
-  port::Thread sort_thread_;
+  const SliceTransform* transform_;
+  // holds the per-vector prefix blooms; only touched under
+  // spdb_vectors_mutex_ (or single-threaded construction)
+  Arena bloom_arena_;
+  // workers share sort_iter_anchor_, protected by sort_thread_mutex_; each
+  // claims the next unsorted vector and sorts it outside the lock
+  std::vector<port::Thread> sort_threads_;
+  std::list<SpdbVectorPtr>::iterator sort_iter_anchor_;
   std::mutex sort_thread_mutex_;
   std::condition_variable sort_thread_cv_;
 };
@@ -264,11 +373,12 @@ class SpdbVectorIterator : public MemTableRep::Iterator {
   // The returned iterator is not valid.
   SpdbVectorIterator(std::shared_ptr<SpdbVectorContainer> spdb_vectors_cont,
                      const MemTableRep::KeyComparator& comparator,
-                     bool part_of_flush)
+                     bool part_of_flush, bool prefix_seek = false)
       : spdb_vectors_cont_holder_(spdb_vectors_cont),
         spdb_vectors_cont_(spdb_vectors_cont.get()),
         iter_heap_info_(comparator),
-        up_iter_direction_(true) {
+        up_iter_direction_(true),
+        prefix_seek_(prefix_seek) {
     is_empty_ = !spdb_vectors_cont_->InitIterator(iter_anchor_, part_of_flush);
   }
 
@@ -304,7 +414,7 @@ class SpdbVectorIterator : public MemTableRep::Iterator {
   void InternalSeek(const Slice* seek_key) {
     if (!is_empty_) {
       spdb_vectors_cont_->SeekIter(iter_anchor_, &iter_heap_info_, seek_key,
-                                   up_iter_direction_);
+                                   up_iter_direction_, prefix_seek_);
     }
     return;
   }
@@ -399,6 +509,7 @@ class SpdbVectorIterator : public MemTableRep::Iterator {
   IterAnchors iter_anchor_;
   IterHeapInfo iter_heap_info_;
   bool up_iter_direction_;
+  bool prefix_seek_ = false;
   bool is_empty_;
 };
 
@@ -0,0 +1,362 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Microbenchmarks for the Speedb write flow and memtable representations:
+// write-group formation cost of the Speedb write flow (use_spdb_writes)
+// against the legacy WriteThread path across thread counts, and
+// insert/get/scan cost of HashSpdbRep against the default InlineSkipList
+// across memtable fill levels and key sizes. All memtable rep benchmarks
+// keep the working set in the (large) memtable so that only the rep itself
+// is measured.
+
+#ifndef OS_WIN
+#include <unistd.h>
+#endif  // ! OS_WIN
+
+#include <cstring>
+
+#include "benchmark/benchmark.h"
+#include "db/db_impl/db_impl.h"
+#include "rocksdb/db.h"
+#include "rocksdb/memtablerep.h"
+#include "rocksdb/options.h"
+#include "rocksdb/statistics.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// Generates a fixed-size key whose trailing bytes hold the big-endian value,
+// so that lexicographic order matches numeric order.
+Slice EncodeKey(uint64_t v, size_t key_size, char* buff) {
+  memset(buff, 0, key_size);
+  for (size_t i = 0; i < sizeof(uint64_t) && i < key_size; i++) {
+    buff[key_size - 1 - i] = static_cast<char>(v & 0xff);
+    v >>= 8;
+  }
+  return {buff, key_size};
+}
+
+void SetupDB(benchmark::State& state, Options& options,
+             std::unique_ptr<DB>* db, const std::string& test_name) {
+  options.create_if_missing = true;
+  auto env = Env::Default();
+  std::string db_path;
+  Status s = env->GetTestDirectory(&db_path);
+  if (!s.ok()) {
+    state.SkipWithError(s.ToString().c_str());
+    return;
+  }
+  std::string db_name =
+      db_path + kFilePathSeparator + test_name + std::to_string(getpid());
+  DestroyDB(db_name, options);
+
+  DB* db_ptr = nullptr;
+  s = DB::Open(options, db_name, &db_ptr);
+  if (!s.ok()) {
+    state.SkipWithError(s.ToString().c_str());
+    return;
+  }
+  db->reset(db_ptr);
+}
+
+void TeardownDB(benchmark::State& state, const std::unique_ptr<DB>& db,
+                const Options& options) {
+  std::string db_name = db->GetName();
+  Status s = db->Close();
+  if (!s.ok()) {
+    state.SkipWithError(s.ToString().c_str());
+  }
+  DestroyDB(db_name, options);
+}
+
+// Returns Options tuned so that all the benchmark's data stays in a single
+// mutable memtable and only the memtable rep is exercised.
+Options MemTableRepOptions(bool use_hash_spdb) {
+  Options options;
+  options.write_buffer_size = 1ull << 30;
+  options.max_write_buffer_number = 2;
+  options.disable_auto_compactions = true;
+  if (use_hash_spdb) {
+    options.memtable_factory.reset(NewHashSpdbRepFactory());
+  }
+  return options;
+}
+
+}  // namespace
+
+// Measure DB::Put() latency of the Speedb write flow against the legacy
+// WriteThread path. With the WAL disabled and inserts going to the memtable
+// only, the difference between the two paths is dominated by write-group
+// formation, which is what we want to compare across thread counts.
+static void DBWriteFlow(benchmark::State& state) {
+  bool use_spdb_writes = state.range(0);
+  uint64_t per_key_size = state.range(1);
+  bool enable_wal = state.range(2);
+
+  // setup DB
+  static std::unique_ptr<DB> db = nullptr;
+  Options options;
+  options.use_spdb_writes = use_spdb_writes;
+  options.statistics = CreateDBStatistics();
+
+  auto rnd = Random(301 + state.thread_index());
+
+  if (state.thread_index() == 0) {
+    SetupDB(state, options, &db, "DBWriteFlow");
+  }
+
+  auto wo = WriteOptions();
+  wo.disableWAL = !enable_wal;
+
+  char key_buff[64];
+  for (auto _ : state) {
+    state.PauseTiming();
+    Slice key = EncodeKey(rnd.Next64(), sizeof(key_buff), key_buff);
+    std::string val = rnd.RandomString(static_cast<int>(per_key_size));
+    state.ResumeTiming();
+    Status s = db->Put(wo, key, val);
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+  }
+
+  if (state.thread_index() == 0) {
+    auto db_full = static_cast_with_check<DBImpl>(db.get());
+    Status s = db_full->WaitForCompact(true);
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      return;
+    }
+    HistogramData histogram_data;
+    options.statistics->histogramData(DB_WRITE, &histogram_data);
+    state.counters["put_mean"] = histogram_data.average * std::milli::den;
+    state.counters["put_p95"] = histogram_data.percentile95 * std::milli::den;
+    state.counters["put_p99"] = histogram_data.percentile99 * std::milli::den;
+
+    TeardownDB(state, db, options);
+  }
+}
+
+static void DBWriteFlowArguments(benchmark::internal::Benchmark* b) {
+  for (bool use_spdb_writes : {false, true}) {
+    for (int64_t per_key_size : {64, 1024}) {
+      for (bool wal : {false, true}) {
+        b->Args({use_spdb_writes, per_key_size, wal});
+      }
+    }
+  }
+  b->ArgNames({"use_spdb_writes", "per_key_size", "wal"});
+}
+
+static constexpr uint64_t kDBWriteFlowNum = 409600l;
+BENCHMARK(DBWriteFlow)
+    ->Threads(1)
+    ->Iterations(kDBWriteFlowNum)
+    ->Apply(DBWriteFlowArguments);
+BENCHMARK(DBWriteFlow)
+    ->Threads(4)
+    ->Iterations(kDBWriteFlowNum / 4)
+    ->Apply(DBWriteFlowArguments);
+BENCHMARK(DBWriteFlow)
+    ->Threads(8)
+    ->Iterations(kDBWriteFlowNum / 8)
+    ->Apply(DBWriteFlowArguments);
+
+// Measure memtable rep insert cost at a given fill level: the memtable is
+// prefilled with prefill_num keys, then random keys from the same key space
+// are inserted (some of them overwrites, as in a running workload).
+static void MemTableRepFill(benchmark::State& state) {
+  bool use_hash_spdb = state.range(0);
+  uint64_t prefill_num = state.range(1);
+  uint64_t key_size = state.range(2);
+
+  // setup DB
+  static std::unique_ptr<DB> db = nullptr;
+  Options options = MemTableRepOptions(use_hash_spdb);
+
+  auto rnd = Random(301 + state.thread_index());
+
+  auto wo = WriteOptions();
+  wo.disableWAL = true;
+
+  char key_buff[256];
+  if (state.thread_index() == 0) {
+    SetupDB(state, options, &db, "MemTableRepFill");
+    for (uint64_t i = 0; i < prefill_num; i++) {
+      Status s = db->Put(wo, EncodeKey(i, key_size, key_buff), "val");
+      if (!s.ok()) {
+        state.SkipWithError(s.ToString().c_str());
+      }
+    }
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    Slice key = EncodeKey(rnd.Next64() % (2 * prefill_num), key_size, key_buff);
+    state.ResumeTiming();
+    Status s = db->Put(wo, key, "val");
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+  }
+
+  if (state.thread_index() == 0) {
+    TeardownDB(state, db, options);
+  }
+}
+
+// Measure memtable rep point lookup cost across fill levels and key sizes.
+static void MemTableRepGet(benchmark::State& state) {
+  bool use_hash_spdb = state.range(0);
+  uint64_t prefill_num = state.range(1);
+  uint64_t key_size = state.range(2);
+  bool negative_query = state.range(3);
+
+  // setup DB
+  static std::unique_ptr<DB> db = nullptr;
+  Options options = MemTableRepOptions(use_hash_spdb);
+
+  auto rnd = Random(301 + state.thread_index());
+
+  char key_buff[256];
+  if (state.thread_index() == 0) {
+    SetupDB(state, options, &db, "MemTableRepGet");
+    auto wo = WriteOptions();
+    wo.disableWAL = true;
+    for (uint64_t i = 0; i < prefill_num; i++) {
+      Status s = db->Put(wo, EncodeKey(i, key_size, key_buff), "val");
+      if (!s.ok()) {
+        state.SkipWithError(s.ToString().c_str());
+      }
+    }
+  }
+
+  auto ro = ReadOptions();
+  uint64_t not_found = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Negative queries look up keys above the filled key range.
+    uint64_t k = (rnd.Next64() % prefill_num) +
+                 (negative_query ? prefill_num : uint64_t{0});
+    Slice key = EncodeKey(k, key_size, key_buff);
+    std::string val;
+    state.ResumeTiming();
+    Status s = db->Get(ro, key, &val);
+    if (s.IsNotFound()) {
+      not_found++;
+    } else if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+  }
+  state.counters["not_found_pct"] = benchmark::Counter(
+      static_cast<double>(not_found * 100), benchmark::Counter::kAvgIterations);
+
+  if (state.thread_index() == 0) {
+    TeardownDB(state, db, options);
+  }
+}
+
+// Measure memtable rep forward scan cost. HashSpdbRep maintains a sorted
+// list next to its hash buckets, so scans are expected to cross over with
+// InlineSkipList at a different fill level than point lookups.
+static void MemTableRepScan(benchmark::State& state) {
+  bool use_hash_spdb = state.range(0);
+  uint64_t prefill_num = state.range(1);
+  uint64_t key_size = state.range(2);
+
+  // setup DB
+  static std::unique_ptr<DB> db = nullptr;
+  Options options = MemTableRepOptions(use_hash_spdb);
+
+  auto rnd = Random(301 + state.thread_index());
+
+  char key_buff[256];
+  if (state.thread_index() == 0) {
+    SetupDB(state, options, &db, "MemTableRepScan");
+    auto wo = WriteOptions();
+    wo.disableWAL = true;
+    for (uint64_t i = 0; i < prefill_num; i++) {
+      Status s = db->Put(wo, EncodeKey(i, key_size, key_buff), "val");
+      if (!s.ok()) {
+        state.SkipWithError(s.ToString().c_str());
+      }
+    }
+  }
+
+  std::unique_ptr<Iterator> iter{db->NewIterator(ReadOptions())};
+  for (auto _ : state) {
+    state.PauseTiming();
+    while (!iter->Valid()) {
+      iter->Seek(EncodeKey(rnd.Next64() % prefill_num, key_size, key_buff));
+      if (!iter->status().ok()) {
+        state.SkipWithError(iter->status().ToString().c_str());
+      }
+    }
+    state.ResumeTiming();
+    iter->Next();
+  }
+  iter.reset();
+
+  if (state.thread_index() == 0) {
+    TeardownDB(state, db, options);
+  }
+}
+
+static void MemTableRepFillArguments(benchmark::internal::Benchmark* b) {
+  for (bool use_hash_spdb : {false, true}) {
+    for (int64_t prefill_num : {16l << 10, 256l << 10, 2l << 20}) {
+      for (int64_t key_size : {16, 128}) {
+        b->Args({use_hash_spdb, prefill_num, key_size});
+      }
+    }
+  }
+  b->ArgNames({"use_hash_spdb", "prefill_num", "key_size"});
+}
+
+static void MemTableRepGetArguments(benchmark::internal::Benchmark* b) {
+  for (bool use_hash_spdb : {false, true}) {
+    for (int64_t prefill_num : {16l << 10, 256l << 10, 2l << 20}) {
+      for (int64_t key_size : {16, 128}) {
+        for (bool negative_query : {false, true}) {
+          b->Args({use_hash_spdb, prefill_num, key_size, negative_query});
+        }
+      }
+    }
+  }
+  b->ArgNames({"use_hash_spdb", "prefill_num", "key_size", "negative_query"});
+}
+
+static constexpr uint64_t kMemTableRepNum = 64l << 10;
+BENCHMARK(MemTableRepFill)
+    ->Threads(1)
+    ->Iterations(kMemTableRepNum)
+    ->Apply(MemTableRepFillArguments);
+BENCHMARK(MemTableRepGet)
+    ->Threads(1)
+    ->Iterations(kMemTableRepNum)
+    ->Apply(MemTableRepGetArguments);
+BENCHMARK(MemTableRepGet)
+    ->Threads(8)
+    ->Iterations(kMemTableRepNum / 8)
+    ->Apply(MemTableRepGetArguments);
+BENCHMARK(MemTableRepScan)
+    ->Threads(1)
+    ->Iterations(kMemTableRepNum)
+    ->Apply(MemTableRepFillArguments);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
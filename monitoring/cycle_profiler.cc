@@ -0,0 +1,89 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "monitoring/cycle_profiler.h"
+
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+const char* const kCycleStageNames[kNumCycleStages] = {
+    "cycles.memtable.get",
+    "cycles.filter.key-may-match",
+    "cycles.index.seek",
+    "cycles.block.read",
+};
+}  // namespace
+
+CycleProfiler* CycleProfiler::Instance() {
+  static CycleProfiler profiler;
+  return &profiler;
+}
+
+void CycleProfiler::GetStage(CycleStage stage, uint64_t* count,
+                             uint64_t* cycles) const {
+  assert(stage < kNumCycleStages);
+  uint64_t total_count = 0;
+  uint64_t total_cycles = 0;
+  for (size_t core_idx = 0; core_idx < per_core_data_.Size(); ++core_idx) {
+    const StageData* data = per_core_data_.AccessAtCore(core_idx);
+    total_count += data->count[stage].load(std::memory_order_relaxed);
+    total_cycles += data->cycles[stage].load(std::memory_order_relaxed);
+  }
+  *count = total_count;
+  *cycles = total_cycles;
+}
+
+std::string CycleProfiler::Report() const {
+  std::string res;
+  res.reserve(20 * 100);
+  for (uint32_t stage = 0; stage < kNumCycleStages; ++stage) {
+    uint64_t count = 0;
+    uint64_t cycles = 0;
+    GetStage(static_cast<CycleStage>(stage), &count, &cycles);
+    char buffer[200];
+    snprintf(buffer, sizeof(buffer),
+             "%s COUNT : %" PRIu64 " CYCLES : %" PRIu64 " AVG : %.1f\n",
+             kCycleStageNames[stage], count, cycles,
+             count == 0 ? 0.0 : static_cast<double>(cycles) / count);
+    res.append(buffer);
+  }
+  res.shrink_to_fit();
+  return res;
+}
+
+void CycleProfiler::Reset() {
+  for (size_t core_idx = 0; core_idx < per_core_data_.Size(); ++core_idx) {
+    StageData* data = per_core_data_.AccessAtCore(core_idx);
+    for (uint32_t stage = 0; stage < kNumCycleStages; ++stage) {
+      data->count[stage].store(0, std::memory_order_relaxed);
+      data->cycles[stage].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void SetCycleProfilerSamplePeriod(uint32_t every_n) {
+  CycleProfiler::Instance()->SetSamplePeriod(every_n);
+}
+
+uint32_t GetCycleProfilerSamplePeriod() {
+  return CycleProfiler::Instance()->GetSamplePeriod();
+}
+
+std::string GetCycleProfilerReport() {
+  return CycleProfiler::Instance()->Report();
+}
+
+void GetCycleProfilerStage(CycleStage stage, uint64_t* count,
+                           uint64_t* cycles) {
+  CycleProfiler::Instance()->GetStage(stage, count, cycles);
+}
+
+void ResetCycleProfiler() { CycleProfiler::Instance()->Reset(); }
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,134 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "port/port.h"
+#include "rocksdb/cycle_profiler.h"
+#include "util/core_local.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Timestamp-counter read for the cycle profiler. Cheap (no serialization) and
+// monotonic enough for aggregate attribution; not suitable for ordering
+// individual events.
+inline uint64_t CycleNow() {
+#if defined(__x86_64__)
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+#elif defined(__aarch64__)
+  uint64_t v;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#else
+  // No cheap cycle counter on this platform: the profiler stays compiled in
+  // but records zero-cycle samples (sample counts are still meaningful).
+  return 0;
+#endif
+}
+
+// Process-wide, sampled cycle attribution for the major read-path stages.
+// See rocksdb/cycle_profiler.h for the public control functions.
+//
+// Counters are aggregated per core (like Statistics) so concurrent samples
+// never contend on a cache line, and sampling is 1-in-N per thread so an
+// enabled profiler touches the counters only on sampled operations. When
+// disabled (the default), each instrumented site costs one relaxed atomic
+// load and a predictable branch.
+class CycleProfiler {
+ public:
+  static CycleProfiler* Instance();
+
+  void SetSamplePeriod(uint32_t every_n) {
+    period_.store(every_n, std::memory_order_relaxed);
+  }
+  uint32_t GetSamplePeriod() const {
+    return period_.load(std::memory_order_relaxed);
+  }
+
+  // Returns true if the current operation should be timed. 1-in-N per
+  // thread; the countdown deliberately starts at 1 so enabling the profiler
+  // takes effect on each thread's next operation.
+  bool Sample() {
+    uint32_t period = period_.load(std::memory_order_relaxed);
+    if (period == 0) {
+      return false;
+    }
+    static thread_local uint32_t countdown = 1;
+    if (--countdown == 0) {
+      countdown = period;
+      return true;
+    }
+    return false;
+  }
+
+  void Add(CycleStage stage, uint64_t cycles) {
+    StageData* data = per_core_data_.Access();
+    data->count[stage].fetch_add(1, std::memory_order_relaxed);
+    data->cycles[stage].fetch_add(cycles, std::memory_order_relaxed);
+  }
+
+  // Sums the per-core counters for `stage`.
+  void GetStage(CycleStage stage, uint64_t* count, uint64_t* cycles) const;
+
+  std::string Report() const;
+
+  void Reset();
+
+ private:
+  CycleProfiler() = default;
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) StageData {
+    std::atomic<uint64_t> count[kNumCycleStages] = {};
+    std::atomic<uint64_t> cycles[kNumCycleStages] = {};
+
+    void* operator new(size_t s) { return port::cacheline_aligned_alloc(s); }
+    void* operator new[](size_t s) { return port::cacheline_aligned_alloc(s); }
+    void operator delete(void* p) { port::cacheline_aligned_free(p); }
+    void operator delete[](void* p) { port::cacheline_aligned_free(p); }
+  };
+
+  std::atomic<uint32_t> period_{0};
+  CoreLocalArray<StageData> per_core_data_;
+};
+
+// Scoped timer for one read-path stage. Consults CycleProfiler::Sample() at
+// construction, so unsampled operations never read the timestamp counter.
+class ScopedCycleTimer {
+ public:
+  explicit ScopedCycleTimer(CycleStage stage)
+      : stage_(stage), active_(CycleProfiler::Instance()->Sample()) {
+    if (active_) {
+      start_ = CycleNow();
+    }
+  }
+
+  ~ScopedCycleTimer() {
+    if (active_) {
+      CycleProfiler::Instance()->Add(stage_, CycleNow() - start_);
+    }
+  }
+
+ private:
+  CycleStage stage_;
+  bool active_;
+  uint64_t start_ = 0;
+};
+
+// Instrumentation entry point; compiles away entirely with
+// -DROCKSDB_DISABLE_CYCLE_PROFILING (cmake -DWITH_CYCLE_PROFILING=OFF).
+#ifndef ROCKSDB_DISABLE_CYCLE_PROFILING
+#define CYCLE_PROFILE_GUARD(stage) \
+  ScopedCycleTimer cycle_profile_guard_##stage(stage)
+#else
+#define CYCLE_PROFILE_GUARD(stage)
+#endif
+
+}  // namespace ROCKSDB_NAMESPACE
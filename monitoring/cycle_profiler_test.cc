@@ -0,0 +1,102 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "monitoring/cycle_profiler.h"
+
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+void RunGuardedOp() { CYCLE_PROFILE_GUARD(kCycleStageMemtableGet); }
+}  // namespace
+
+class CycleProfilerTest : public testing::Test {
+ public:
+  CycleProfilerTest() {
+    SetCycleProfilerSamplePeriod(0);
+    ResetCycleProfiler();
+  }
+  ~CycleProfilerTest() override {
+    SetCycleProfilerSamplePeriod(0);
+    ResetCycleProfiler();
+  }
+};
+
+TEST_F(CycleProfilerTest, DisabledRecordsNothing) {
+  ASSERT_EQ(0u, GetCycleProfilerSamplePeriod());
+  for (int i = 0; i < 100; ++i) {
+    RunGuardedOp();
+  }
+  uint64_t count = 0;
+  uint64_t cycles = 0;
+  GetCycleProfilerStage(kCycleStageMemtableGet, &count, &cycles);
+  ASSERT_EQ(0u, count);
+  ASSERT_EQ(0u, cycles);
+}
+
+#ifndef ROCKSDB_DISABLE_CYCLE_PROFILING
+TEST_F(CycleProfilerTest, SamplePeriodOne) {
+  SetCycleProfilerSamplePeriod(1);
+  ASSERT_EQ(1u, GetCycleProfilerSamplePeriod());
+  constexpr uint64_t kOps = 100;
+  for (uint64_t i = 0; i < kOps; ++i) {
+    RunGuardedOp();
+  }
+  uint64_t count = 0;
+  uint64_t cycles = 0;
+  GetCycleProfilerStage(kCycleStageMemtableGet, &count, &cycles);
+  ASSERT_EQ(kOps, count);
+  // Other stages remain untouched.
+  GetCycleProfilerStage(kCycleStageBlockRead, &count, &cycles);
+  ASSERT_EQ(0u, count);
+  ASSERT_EQ(0u, cycles);
+}
+
+TEST_F(CycleProfilerTest, SamplePeriodN) {
+  constexpr uint32_t kPeriod = 10;
+  constexpr uint64_t kOps = 100;
+  SetCycleProfilerSamplePeriod(kPeriod);
+  for (uint64_t i = 0; i < kOps; ++i) {
+    RunGuardedOp();
+  }
+  uint64_t count = 0;
+  uint64_t cycles = 0;
+  GetCycleProfilerStage(kCycleStageMemtableGet, &count, &cycles);
+  // The per-thread countdown may have any phase left over from earlier
+  // activity on this thread, so allow one sample of slack on each side.
+  ASSERT_GE(count, kOps / kPeriod - 1);
+  ASSERT_LE(count, kOps / kPeriod + 1);
+}
+
+TEST_F(CycleProfilerTest, ResetZeroesCounters) {
+  SetCycleProfilerSamplePeriod(1);
+  RunGuardedOp();
+  uint64_t count = 0;
+  uint64_t cycles = 0;
+  GetCycleProfilerStage(kCycleStageMemtableGet, &count, &cycles);
+  ASSERT_GT(count, 0u);
+  ResetCycleProfiler();
+  GetCycleProfilerStage(kCycleStageMemtableGet, &count, &cycles);
+  ASSERT_EQ(0u, count);
+  ASSERT_EQ(0u, cycles);
+}
+#endif  // !ROCKSDB_DISABLE_CYCLE_PROFILING
+
+TEST_F(CycleProfilerTest, ReportNamesAllStages) {
+  std::string report = GetCycleProfilerReport();
+  ASSERT_NE(std::string::npos, report.find("cycles.memtable.get"));
+  ASSERT_NE(std::string::npos, report.find("cycles.filter.key-may-match"));
+  ASSERT_NE(std::string::npos, report.find("cycles.index.seek"));
+  ASSERT_NE(std::string::npos, report.find("cycles.block.read"));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
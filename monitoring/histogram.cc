@@ -18,6 +18,7 @@
 
 #include "port/port.h"
 #include "util/cast_util.h"
+#include "util/math.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -40,15 +41,31 @@ HistogramBucketMapper::HistogramBucketMapper() {
   }
   maxBucketValue_ = bucketValues_.back();
   minBucketValue_ = bucketValues_.front();
+
+  // The buckets grow by a factor of 1.5, so any power-of-two range contains
+  // at most a few of them. Caching the first candidate index per power of two
+  // reduces the per-sample lookup to a table load plus a short scan.
+  size_t index = 0;
+  for (int bits = 0; bits < 64; bits++) {
+    const uint64_t pow2 = uint64_t{1} << bits;
+    while (index + 1 < bucketValues_.size() && bucketValues_[index] < pow2) {
+      index++;
+    }
+    firstIndexForPow2_[bits] = index;
+  }
 }
 
 size_t HistogramBucketMapper::IndexForValue(const uint64_t value) const {
-  auto beg = bucketValues_.begin();
-  auto end = bucketValues_.end();
-  if (value >= maxBucketValue_)
-    return end - beg - 1;  // bucketValues_.size() - 1
-  else
-    return std::lower_bound(beg, end, value) - beg;
+  if (value >= maxBucketValue_) {
+    return bucketValues_.size() - 1;
+  }
+  // First bucket that could hold the value, i.e. the cached lower bound for
+  // 2^FloorLog2(value). `value | 1` keeps FloorLog2's precondition for zero.
+  size_t index = firstIndexForPow2_[FloorLog2(value | 1)];
+  while (bucketValues_[index] < value) {
+    index++;
+  }
+  return index;
 }
 
 namespace {
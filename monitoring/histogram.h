@@ -55,6 +55,10 @@ class HistogramBucketMapper {
   std::vector<uint64_t> bucketValues_;
   uint64_t maxBucketValue_;
   uint64_t minBucketValue_;
+  // For every power of two, the index of the first bucket whose upper limit
+  // is at least that value. Lets IndexForValue() skip straight to the right
+  // neighborhood instead of binary searching the whole bucket table.
+  size_t firstIndexForPow2_[64];
 };
 
 struct HistogramStat {
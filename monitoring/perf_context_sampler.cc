@@ -0,0 +1,115 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "monitoring/perf_context_sampler.h"
+
+#include <mutex>
+
+#include "monitoring/perf_context_imp.h"
+#include "rocksdb/system_clock.h"
+#include "util/core_local.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+struct SampleRing {
+  std::mutex mu;
+  // Total number of samples ever written to this ring; the ring holds the
+  // most recent kSamplesPerCore of them.
+  uint64_t count = 0;
+  uint64_t timestamps_us[PerfContextSampler::kSamplesPerCore] = {};
+  PerfContext slots[PerfContextSampler::kSamplesPerCore];
+};
+
+CoreLocalArray<SampleRing>& SampleRings() {
+  static CoreLocalArray<SampleRing> rings;
+  return rings;
+}
+
+}  // namespace
+
+std::atomic<uint64_t> PerfContextSampler::sample_period_{0};
+
+void PerfContextSampler::Enable(uint64_t sample_period) {
+  if (sample_period != 0) {
+    // Make sure the rings exist before the first Record() so that concurrent
+    // first-time initialization of the function-local static cannot happen on
+    // a sampled operation.
+    SampleRings();
+  }
+  sample_period_.store(sample_period, std::memory_order_relaxed);
+}
+
+void PerfContextSampler::Record(const PerfContext& ctx) {
+  SampleRing* ring = SampleRings().Access();
+  const uint64_t now_us = SystemClock::Default()->NowMicros();
+  std::lock_guard<std::mutex> lock(ring->mu);
+  const size_t slot = ring->count % kSamplesPerCore;
+  ring->slots[slot] = ctx;
+  ring->timestamps_us[slot] = now_us;
+  ring->count++;
+}
+
+ScopedPerfContextSample::ScopedPerfContextSample() {
+  const uint64_t period = PerfContextSampler::sample_period();
+  if (period == 0) {
+    return;
+  }
+  static thread_local uint64_t ops_since_last_sample = 0;
+  if (++ops_since_last_sample < period) {
+    return;
+  }
+  ops_since_last_sample = 0;
+  active_ = true;
+  saved_level_ = GetPerfLevel();
+  if (saved_level_ < PerfLevel::kEnableTimeExceptForMutex) {
+    SetPerfLevel(PerfLevel::kEnableTimeExceptForMutex);
+  }
+  PerfContext* ctx = get_perf_context();
+  saved_context_.reset(new PerfContext(*ctx));
+  ctx->Reset();
+}
+
+ScopedPerfContextSample::~ScopedPerfContextSample() {
+  if (!active_) {
+    return;
+  }
+  PerfContext* ctx = get_perf_context();
+  PerfContextSampler::Record(*ctx);
+  *ctx = *saved_context_;
+  SetPerfLevel(saved_level_);
+}
+
+void EnablePerfContextSampling(uint64_t sample_period) {
+  PerfContextSampler::Enable(sample_period);
+}
+
+void DisablePerfContextSampling() { PerfContextSampler::Disable(); }
+
+std::vector<std::string> GetSampledPerfContexts(bool exclude_zero_counters) {
+  std::vector<std::string> result;
+  CoreLocalArray<SampleRing>& rings = SampleRings();
+  for (size_t i = 0; i < rings.Size(); ++i) {
+    SampleRing* ring = rings.AccessAtCore(i);
+    std::lock_guard<std::mutex> lock(ring->mu);
+    const uint64_t n =
+        std::min(ring->count,
+                 static_cast<uint64_t>(PerfContextSampler::kSamplesPerCore));
+    // Oldest retained sample first.
+    for (uint64_t j = ring->count - n; j < ring->count; ++j) {
+      const size_t slot = j % PerfContextSampler::kSamplesPerCore;
+      std::string sample = "timestamp_us = ";
+      sample.append(std::to_string(ring->timestamps_us[slot]));
+      sample.append(", ");
+      sample.append(ring->slots[slot].ToString(exclude_zero_counters));
+      result.push_back(std::move(sample));
+    }
+    ring->count = 0;
+  }
+  return result;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,64 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "rocksdb/perf_context.h"
+#include "rocksdb/perf_level.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Collects full PerfContext snapshots for roughly one out of every
+// `sample_period` guarded operations per thread into per-core ring buffers,
+// without requiring timers to be enabled globally: for a sampled operation
+// the thread's perf level is temporarily raised to kEnableTimeExceptForMutex
+// and the thread's PerfContext is saved, zeroed for the duration of the
+// operation and restored afterwards, so concurrent user-driven perf context
+// measurement is unaffected (except that counts the user's level would have
+// accrued during the sampled operation are lost).
+//
+// Enabled through EnablePerfContextSampling() and drained through
+// GetSampledPerfContexts(), both declared in rocksdb/perf_context.h.
+class PerfContextSampler {
+ public:
+  // Number of retained samples per core; older samples are overwritten.
+  static constexpr size_t kSamplesPerCore = 8;
+
+  // `sample_period` == 0 disables sampling.
+  static void Enable(uint64_t sample_period);
+  static void Disable() { Enable(0); }
+
+  static uint64_t sample_period() {
+    return sample_period_.load(std::memory_order_relaxed);
+  }
+
+  // Append a snapshot to the calling core's ring buffer.
+  static void Record(const PerfContext& ctx);
+
+ private:
+  static std::atomic<uint64_t> sample_period_;
+};
+
+// RAII helper placed at the entry of an operation eligible for sampling.
+// Cheap when the operation is not sampled: one thread-local counter update.
+class ScopedPerfContextSample {
+ public:
+  ScopedPerfContextSample();
+  ~ScopedPerfContextSample();
+
+  // No copying allowed
+  ScopedPerfContextSample(const ScopedPerfContextSample&) = delete;
+  void operator=(const ScopedPerfContextSample&) = delete;
+
+ private:
+  bool active_ = false;
+  PerfLevel saved_level_ = PerfLevel::kUninitialized;
+  std::unique_ptr<PerfContext> saved_context_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
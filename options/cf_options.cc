@@ -139,6 +139,15 @@ static Status ParseCompressionOptions(const std::string& value,
     compression_opts.use_zstd_dict_trainer = ParseBoolean("", field);
   }
 
+  // shared_dict_per_compaction is optional for backwards compatibility
+  if (!field_stream.eof()) {
+    if (!std::getline(field_stream, field, kDelimiter)) {
+      return Status::InvalidArgument(
+          "unable to parse the specified CF option " + name);
+    }
+    compression_opts.shared_dict_per_compaction = ParseBoolean("", field);
+  }
+
   if (!field_stream.eof()) {
     return Status::InvalidArgument("unable to parse the specified CF option " +
                                    name);
@@ -183,6 +192,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct CompressionOptions, use_zstd_dict_trainer),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"shared_dict_per_compaction",
+         {offsetof(struct CompressionOptions, shared_dict_per_compaction),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
 };
 
 static std::unordered_map<std::string, OptionTypeInfo>
@@ -237,6 +250,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
           OptionTypeFlags::kMutable}},
         {"allow_trivial_move",
          {offsetof(class CompactionOptionsUniversal, allow_trivial_move),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"lookahead_scheduling",
+         {offsetof(class CompactionOptionsUniversal, lookahead_scheduling),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}}};
 
@@ -274,6 +291,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    hard_pending_compaction_bytes_limit),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"write_delay_weight",
+         {offsetof(struct MutableCFOptions, write_delay_weight),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"hard_rate_limit",
          {0, OptionType::kDouble, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kMutable}},
@@ -444,6 +465,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableCFOptions, min_blob_size),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"blob_adaptive_inline_ratio",
+         {offsetof(struct MutableCFOptions, blob_adaptive_inline_ratio),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"blob_file_size",
          {offsetof(struct MutableCFOptions, blob_file_size),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
@@ -582,6 +607,9 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableCFOptions, force_consistency_checks),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"wal_free",
+         {offsetof(struct ImmutableCFOptions, wal_free), OptionType::kBoolean,
+          OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
         {"preclude_last_level_data_seconds",
          {offsetof(struct ImmutableCFOptions, preclude_last_level_data_seconds),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
@@ -924,6 +952,7 @@ ImmutableCFOptions::ImmutableCFOptions(const ColumnFamilyOptions& cf_options)
       num_levels(cf_options.num_levels),
       optimize_filters_for_hits(cf_options.optimize_filters_for_hits),
       force_consistency_checks(cf_options.force_consistency_checks),
+      wal_free(cf_options.wal_free),
       preclude_last_level_data_seconds(
           cf_options.preclude_last_level_data_seconds),
       preserve_internal_time_seconds(cf_options.preserve_internal_time_seconds),
@@ -1044,6 +1073,8 @@ void MutableCFOptions::Dump(Logger* log) const {
                  soft_pending_compaction_bytes_limit);
   ROCKS_LOG_INFO(log, "      hard_pending_compaction_bytes_limit: %" PRIu64,
                  hard_pending_compaction_bytes_limit);
+  ROCKS_LOG_INFO(log, "                       write_delay_weight: %f",
+                 write_delay_weight);
   ROCKS_LOG_INFO(log, "       level0_file_num_compaction_trigger: %d",
                  level0_file_num_compaction_trigger);
   ROCKS_LOG_INFO(log, "           level0_slowdown_writes_trigger: %d",
@@ -1114,6 +1145,9 @@ void MutableCFOptions::Dump(Logger* log) const {
       static_cast<int>(compaction_options_universal.allow_trivial_move));
   ROCKS_LOG_INFO(log, "compaction_options_universal.incremental        : %d",
                  static_cast<int>(compaction_options_universal.incremental));
+  ROCKS_LOG_INFO(
+      log, "compaction_options_universal.lookahead_scheduling: %d",
+      static_cast<int>(compaction_options_universal.lookahead_scheduling));
 
   // FIFO Compaction Options
   ROCKS_LOG_INFO(log, "compaction_options_fifo.max_table_files_size : %" PRIu64,
@@ -1126,6 +1160,8 @@ void MutableCFOptions::Dump(Logger* log) const {
                  enable_blob_files ? "true" : "false");
   ROCKS_LOG_INFO(log, "                            min_blob_size: %" PRIu64,
                  min_blob_size);
+  ROCKS_LOG_INFO(log, "               blob_adaptive_inline_ratio: %f",
+                 blob_adaptive_inline_ratio);
   ROCKS_LOG_INFO(log, "                           blob_file_size: %" PRIu64,
                  blob_file_size);
   ROCKS_LOG_INFO(log, "                    blob_compression_type: %s",
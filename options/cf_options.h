@@ -86,6 +86,8 @@ struct ImmutableCFOptions {
 
   bool force_consistency_checks;
 
+  bool wal_free;
+
   uint64_t preclude_last_level_data_seconds;
 
   uint64_t preserve_internal_time_seconds;
@@ -139,6 +141,7 @@ struct MutableCFOptions {
             options.soft_pending_compaction_bytes_limit),
         hard_pending_compaction_bytes_limit(
             options.hard_pending_compaction_bytes_limit),
+        write_delay_weight(options.write_delay_weight),
         level0_file_num_compaction_trigger(
             options.level0_file_num_compaction_trigger),
         level0_slowdown_writes_trigger(options.level0_slowdown_writes_trigger),
@@ -158,6 +161,7 @@ struct MutableCFOptions {
         compaction_options_universal(options.compaction_options_universal),
         enable_blob_files(options.enable_blob_files),
         min_blob_size(options.min_blob_size),
+        blob_adaptive_inline_ratio(options.blob_adaptive_inline_ratio),
         blob_file_size(options.blob_file_size),
         blob_compression_type(options.blob_compression_type),
         enable_blob_garbage_collection(options.enable_blob_garbage_collection),
@@ -204,6 +208,7 @@ struct MutableCFOptions {
         disable_auto_compactions(false),
         soft_pending_compaction_bytes_limit(0),
         hard_pending_compaction_bytes_limit(0),
+        write_delay_weight(1.0),
         level0_file_num_compaction_trigger(0),
         level0_slowdown_writes_trigger(0),
         level0_stop_writes_trigger(0),
@@ -218,6 +223,7 @@ struct MutableCFOptions {
         compaction_options_fifo(),
         enable_blob_files(false),
         min_blob_size(0),
+        blob_adaptive_inline_ratio(0.0),
         blob_file_size(0),
         blob_compression_type(kNoCompression),
         enable_blob_garbage_collection(false),
@@ -287,6 +293,7 @@ struct MutableCFOptions {
   bool disable_auto_compactions;
   uint64_t soft_pending_compaction_bytes_limit;
   uint64_t hard_pending_compaction_bytes_limit;
+  double write_delay_weight;
   int level0_file_num_compaction_trigger;
   int level0_slowdown_writes_trigger;
   int level0_stop_writes_trigger;
@@ -305,6 +312,7 @@ struct MutableCFOptions {
   // Blob file related options
   bool enable_blob_files;
   uint64_t min_blob_size;
+  double blob_adaptive_inline_ratio;
   uint64_t blob_file_size;
   CompressionType blob_compression_type;
   bool enable_blob_garbage_collection;
@@ -148,6 +148,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableDBOptions, compaction_readahead_size),
           OptionType::kSizeT, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"cold_tier_compaction_readahead_size",
+         {offsetof(struct MutableDBOptions,
+                   cold_tier_compaction_readahead_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"max_background_flushes",
          {offsetof(struct MutableDBOptions, max_background_flushes),
           OptionType::kInt, OptionVerificationType::kNormal,
@@ -194,6 +199,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    use_direct_io_for_flush_and_compaction),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"use_direct_io_for_wal",
+         {offsetof(struct ImmutableDBOptions, use_direct_io_for_wal),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"allow_2pc",
          {offsetof(struct ImmutableDBOptions, allow_2pc), OptionType::kBoolean,
           OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
@@ -254,6 +263,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, verify_sst_unique_id_in_manifest),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"verify_options_file_on_persist",
+         {offsetof(struct ImmutableDBOptions, verify_options_file_on_persist),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"skip_log_error_on_recovery",
          {0, OptionType::kBoolean, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kNone}},
@@ -414,6 +427,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, wal_compression),
           OptionType::kCompressionType, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"wal_tag_column_family_ids",
+         {offsetof(struct ImmutableDBOptions, wal_tag_column_family_ids),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"seq_per_batch",
          {0, OptionType::kBoolean, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kNone}},
@@ -585,6 +602,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, use_clean_delete_during_flush),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"recycle_iterators",
+         {offsetof(struct ImmutableDBOptions, recycle_iterators),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"manifest_delta_encoding",
+         {offsetof(struct ImmutableDBOptions, manifest_delta_encoding),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 const std::string OptionsHelper::kDBOptionsName = "DBOptions";
@@ -710,6 +735,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
           options.track_and_verify_wals_in_manifest),
       verify_sst_unique_id_in_manifest(
           options.verify_sst_unique_id_in_manifest),
+      verify_options_file_on_persist(options.verify_options_file_on_persist),
       env(options.env),
       rate_limiter(options.rate_limiter),
       sst_file_manager(options.sst_file_manager),
@@ -737,6 +763,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       use_direct_reads(options.use_direct_reads),
       use_direct_io_for_flush_and_compaction(
           options.use_direct_io_for_flush_and_compaction),
+      use_direct_io_for_wal(options.use_direct_io_for_wal),
       allow_fallocate(options.allow_fallocate),
       is_fd_close_on_exec(options.is_fd_close_on_exec),
       advise_random_on_open(options.advise_random_on_open),
@@ -770,6 +797,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       two_write_queues(options.two_write_queues),
       manual_wal_flush(options.manual_wal_flush),
       wal_compression(options.wal_compression),
+      wal_tag_column_family_ids(options.wal_tag_column_family_ids),
       atomic_flush(options.atomic_flush),
       avoid_unnecessary_blocking_io(options.avoid_unnecessary_blocking_io),
       persist_stats_to_disk(options.persist_stats_to_disk),
@@ -786,7 +814,9 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       compaction_service(options.compaction_service),
       use_dynamic_delay(options.use_dynamic_delay),
       enforce_single_del_contracts(options.enforce_single_del_contracts),
-      use_clean_delete_during_flush(options.use_clean_delete_during_flush) {
+      use_clean_delete_during_flush(options.use_clean_delete_during_flush),
+      recycle_iterators(options.recycle_iterators),
+      manifest_delta_encoding(options.manifest_delta_encoding) {
   fs = env->GetFileSystem();
   clock = env->GetSystemClock().get();
   logger = info_log.get();
@@ -808,6 +838,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    track_and_verify_wals_in_manifest);
   ROCKS_LOG_HEADER(log, "       Options.verify_sst_unique_id_in_manifest: %d",
                    verify_sst_unique_id_in_manifest);
+  ROCKS_LOG_HEADER(log, "         Options.verify_options_file_on_persist: %d",
+                   verify_options_file_on_persist);
   ROCKS_LOG_HEADER(log, "                                    Options.env: %p",
                    env);
   ROCKS_LOG_HEADER(log, "                                     Options.fs: %s",
@@ -847,6 +879,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    "                       "
                    "Options.use_direct_io_for_flush_and_compaction: %d",
                    use_direct_io_for_flush_and_compaction);
+  ROCKS_LOG_HEADER(log, "                 Options.use_direct_io_for_wal: %d",
+                   use_direct_io_for_wal);
   ROCKS_LOG_HEADER(log, "         Options.create_missing_column_families: %d",
                    create_missing_column_families);
   ROCKS_LOG_HEADER(log, "                             Options.db_log_dir: %s",
@@ -938,6 +972,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    manual_wal_flush);
   ROCKS_LOG_HEADER(log, "            Options.wal_compression: %d",
                    wal_compression);
+  ROCKS_LOG_HEADER(log, "            Options.wal_tag_column_family_ids: %d",
+                   wal_tag_column_family_ids);
   ROCKS_LOG_HEADER(log, "            Options.atomic_flush: %d", atomic_flush);
   ROCKS_LOG_HEADER(log,
                    "            Options.avoid_unnecessary_blocking_io: %d",
@@ -967,6 +1003,10 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    enforce_single_del_contracts ? "true" : "false");
   ROCKS_LOG_HEADER(log, "            Options.use_clean_delete_during_flush: %s",
                    use_clean_delete_during_flush ? "true" : "false");
+  ROCKS_LOG_HEADER(log, "            Options.recycle_iterators: %s",
+                   recycle_iterators ? "true" : "false");
+  ROCKS_LOG_HEADER(log, "            Options.manifest_delta_encoding: %s",
+                   manifest_delta_encoding ? "true" : "false");
 }
 
 bool ImmutableDBOptions::IsWalDirSameAsDBPath() const {
@@ -1022,6 +1062,7 @@ MutableDBOptions::MutableDBOptions()
       wal_bytes_per_sync(0),
       strict_bytes_per_sync(false),
       compaction_readahead_size(0),
+      cold_tier_compaction_readahead_size(0),
       max_background_flushes(-1) {}
 
 MutableDBOptions::MutableDBOptions(const DBOptions& options)
@@ -1044,6 +1085,8 @@ MutableDBOptions::MutableDBOptions(const DBOptions& options)
       wal_bytes_per_sync(options.wal_bytes_per_sync),
       strict_bytes_per_sync(options.strict_bytes_per_sync),
       compaction_readahead_size(options.compaction_readahead_size),
+      cold_tier_compaction_readahead_size(
+          options.cold_tier_compaction_readahead_size),
       max_background_flushes(options.max_background_flushes) {}
 
 void MutableDBOptions::Dump(Logger* log) const {
@@ -1093,6 +1136,9 @@ void MutableDBOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(log,
                    "      Options.compaction_readahead_size: %" ROCKSDB_PRIszt,
                    compaction_readahead_size);
+  ROCKS_LOG_HEADER(
+      log, "      Options.cold_tier_compaction_readahead_size: %" ROCKSDB_PRIszt,
+      cold_tier_compaction_readahead_size);
   ROCKS_LOG_HEADER(log, "                 Options.max_background_flushes: %d",
                           max_background_flushes);
 }
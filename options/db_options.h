@@ -41,6 +41,7 @@ struct ImmutableDBOptions {
   bool flush_verify_memtable_count;
   bool track_and_verify_wals_in_manifest;
   bool verify_sst_unique_id_in_manifest;
+  bool verify_options_file_on_persist;
   Env* env;
   std::shared_ptr<RateLimiter> rate_limiter;
   std::shared_ptr<SstFileManager> sst_file_manager;
@@ -69,6 +70,7 @@ struct ImmutableDBOptions {
   bool allow_mmap_writes;
   bool use_direct_reads;
   bool use_direct_io_for_flush_and_compaction;
+  bool use_direct_io_for_wal;
   bool allow_fallocate;
   bool is_fd_close_on_exec;
   bool advise_random_on_open;
@@ -100,6 +102,7 @@ struct ImmutableDBOptions {
   bool two_write_queues;
   bool manual_wal_flush;
   CompressionType wal_compression;
+  bool wal_tag_column_family_ids;
   bool atomic_flush;
   bool avoid_unnecessary_blocking_io;
   bool persist_stats_to_disk;
@@ -122,6 +125,8 @@ struct ImmutableDBOptions {
   bool use_dynamic_delay;
   bool enforce_single_del_contracts;
   bool use_clean_delete_during_flush;
+  bool recycle_iterators;
+  bool manifest_delta_encoding;
 
   bool IsWalDirSameAsDBPath() const;
   bool IsWalDirSameAsDBPath(const std::string& path) const;
@@ -154,6 +159,7 @@ struct MutableDBOptions {
   uint64_t wal_bytes_per_sync;
   bool strict_bytes_per_sync;
   size_t compaction_readahead_size;
+  size_t cold_tier_compaction_readahead_size;
   int max_background_flushes;
 };
 
@@ -95,6 +95,7 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
           options.soft_pending_compaction_bytes_limit),
       hard_pending_compaction_bytes_limit(
           options.hard_pending_compaction_bytes_limit),
+      write_delay_weight(options.write_delay_weight),
       compaction_style(options.compaction_style),
       compaction_pri(options.compaction_pri),
       compaction_options_universal(options.compaction_options_universal),
@@ -108,6 +109,7 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       optimize_filters_for_hits(options.optimize_filters_for_hits),
       paranoid_file_checks(options.paranoid_file_checks),
       force_consistency_checks(options.force_consistency_checks),
+      wal_free(options.wal_free),
       report_bg_io_stats(options.report_bg_io_stats),
       ttl(options.ttl),
       periodic_compaction_seconds(options.periodic_compaction_seconds),
@@ -117,6 +119,7 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       preserve_internal_time_seconds(options.preserve_internal_time_seconds),
       enable_blob_files(options.enable_blob_files),
       min_blob_size(options.min_blob_size),
+      blob_adaptive_inline_ratio(options.blob_adaptive_inline_ratio),
       blob_file_size(options.blob_file_size),
       blob_compression_type(options.blob_compression_type),
       enable_blob_garbage_collection(options.enable_blob_garbage_collection),
@@ -313,6 +316,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(log,
                      "  Options.hard_pending_compaction_bytes_limit: %" PRIu64,
                      hard_pending_compaction_bytes_limit);
+    ROCKS_LOG_HEADER(log, "                Options.write_delay_weight: %f",
+                     write_delay_weight);
     ROCKS_LOG_HEADER(log, "               Options.disable_auto_compactions: %d",
                      disable_auto_compactions);
 
@@ -417,6 +422,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                      paranoid_file_checks);
     ROCKS_LOG_HEADER(log, "               Options.force_consistency_checks: %d",
                      force_consistency_checks);
+    ROCKS_LOG_HEADER(log, "                                Options.wal_free: %d",
+                     wal_free);
     ROCKS_LOG_HEADER(log, "               Options.report_bg_io_stats: %d",
                      report_bg_io_stats);
     ROCKS_LOG_HEADER(log, "                              Options.ttl: %" PRIu64,
@@ -433,6 +440,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(
         log, "                          Options.min_blob_size: %" PRIu64,
         min_blob_size);
+    ROCKS_LOG_HEADER(log,
+                     "             Options.blob_adaptive_inline_ratio: %f",
+                     blob_adaptive_inline_ratio);
     ROCKS_LOG_HEADER(
         log, "                         Options.blob_file_size: %" PRIu64,
         blob_file_size);
@@ -830,6 +840,8 @@ DBOptions* DBOptions::IncreaseParallelism(int total_threads) {
 
 ReadOptions::ReadOptions()
     : snapshot(nullptr),
+      snapshot_seqno(0),
+      allow_stale_immutable_view(false),
       iterate_lower_bound(nullptr),
       iterate_upper_bound(nullptr),
       readahead_size(0),
@@ -856,6 +868,8 @@ ReadOptions::ReadOptions()
 
 ReadOptions::ReadOptions(bool cksum, bool cache)
     : snapshot(nullptr),
+      snapshot_seqno(0),
+      allow_stale_immutable_view(false),
       iterate_lower_bound(nullptr),
       iterate_upper_bound(nullptr),
       readahead_size(0),
@@ -138,6 +138,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
       immutable_db_options.track_and_verify_wals_in_manifest;
   options.verify_sst_unique_id_in_manifest =
       immutable_db_options.verify_sst_unique_id_in_manifest;
+  options.verify_options_file_on_persist =
+      immutable_db_options.verify_options_file_on_persist;
   options.env = immutable_db_options.env;
   options.rate_limiter = immutable_db_options.rate_limiter;
   options.sst_file_manager = immutable_db_options.sst_file_manager;
@@ -178,6 +180,7 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.use_direct_reads = immutable_db_options.use_direct_reads;
   options.use_direct_io_for_flush_and_compaction =
       immutable_db_options.use_direct_io_for_flush_and_compaction;
+  options.use_direct_io_for_wal = immutable_db_options.use_direct_io_for_wal;
   options.allow_fallocate = immutable_db_options.allow_fallocate;
   options.is_fd_close_on_exec = immutable_db_options.is_fd_close_on_exec;
   options.stats_dump_period_sec = mutable_db_options.stats_dump_period_sec;
@@ -194,6 +197,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
       immutable_db_options.access_hint_on_compaction_start;
   options.compaction_readahead_size =
       mutable_db_options.compaction_readahead_size;
+  options.cold_tier_compaction_readahead_size =
+      mutable_db_options.cold_tier_compaction_readahead_size;
   options.random_access_max_buffer_size =
       immutable_db_options.random_access_max_buffer_size;
   options.writable_file_max_buffer_size =
@@ -256,6 +261,9 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.refresh_options_file = mutable_db_options.refresh_options_file;
   options.use_clean_delete_during_flush =
       immutable_db_options.use_clean_delete_during_flush;
+  options.recycle_iterators = immutable_db_options.recycle_iterators;
+  options.manifest_delta_encoding =
+      immutable_db_options.manifest_delta_encoding;
   return options;
 }
 
@@ -293,6 +301,7 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
       moptions.soft_pending_compaction_bytes_limit;
   cf_opts->hard_pending_compaction_bytes_limit =
       moptions.hard_pending_compaction_bytes_limit;
+  cf_opts->write_delay_weight = moptions.write_delay_weight;
   cf_opts->level0_file_num_compaction_trigger =
       moptions.level0_file_num_compaction_trigger;
   cf_opts->level0_slowdown_writes_trigger =
@@ -320,6 +329,7 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
   // Blob file related options
   cf_opts->enable_blob_files = moptions.enable_blob_files;
   cf_opts->min_blob_size = moptions.min_blob_size;
+  cf_opts->blob_adaptive_inline_ratio = moptions.blob_adaptive_inline_ratio;
   cf_opts->blob_file_size = moptions.blob_file_size;
   cf_opts->blob_compression_type = moptions.blob_compression_type;
   cf_opts->enable_blob_garbage_collection =
@@ -378,6 +388,7 @@ void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
   cf_opts->num_levels = ioptions.num_levels;
   cf_opts->optimize_filters_for_hits = ioptions.optimize_filters_for_hits;
   cf_opts->force_consistency_checks = ioptions.force_consistency_checks;
+  cf_opts->wal_free = ioptions.wal_free;
   cf_opts->memtable_insert_with_hint_prefix_extractor =
       ioptions.memtable_insert_with_hint_prefix_extractor;
   cf_opts->cf_paths = ioptions.cf_paths;
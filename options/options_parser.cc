@@ -149,7 +149,11 @@ Status PersistRocksDBOptions(const ConfigOptions& config_options_in,
   if (s.ok()) {
     s = writable->Close();
   }
-  if (s.ok()) {
+  if (s.ok() && db_opt.verify_options_file_on_persist) {
+    // Parse the file we just wrote back in full and compare it against the
+    // in-memory options. This rebuilds every column family's options from
+    // text, which can dominate DB::Open time at high column family counts;
+    // see DBOptions::verify_options_file_on_persist.
     return RocksDBOptionsParser::VerifyRocksDBOptionsFromFile(
         config_options, db_opt, cf_names, cf_opts, file_name, fs);
   }
@@ -205,6 +205,7 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "checksum=kxxHash;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;"
       "block_size_deviation=8;block_restart_interval=4; "
+      "adaptive_block_restart_interval=true;"
       "metadata_block_size=1024;"
       "partition_filters=false;"
       "optimize_filters_for_memory=true;"
@@ -323,6 +324,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "use_adaptive_mutex=false;"
                              "max_total_wal_size=4295005604;"
                              "compaction_readahead_size=0;"
+                             "cold_tier_compaction_readahead_size=0;"
                              "keep_log_file_num=4890;"
                              "skip_stats_update_on_db_open=false;"
                              "skip_checking_sst_file_sizes_on_db_open=false;"
@@ -333,6 +335,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "flush_verify_memtable_count=true;"
                              "track_and_verify_wals_in_manifest=true;"
                              "verify_sst_unique_id_in_manifest=true;"
+                             "verify_options_file_on_persist=true;"
                              "is_fd_close_on_exec=false;"
                              "bytes_per_sync=4295013613;"
                              "strict_bytes_per_sync=true;"
@@ -354,6 +357,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "allow_mmap_reads=false;"
                              "use_direct_reads=false;"
                              "use_direct_io_for_flush_and_compaction=false;"
+                             "use_direct_io_for_wal=false;"
                              "max_log_file_size=4607;"
                              "random_access_max_buffer_size=1048576;"
                              "advise_random_on_open=true;"
@@ -376,6 +380,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "two_write_queues=false;"
                              "manual_wal_flush=false;"
                              "wal_compression=kZSTD;"
+                             "wal_tag_column_family_ids=false;"
                              "seq_per_batch=false;"
                              "atomic_flush=false;"
                              "avoid_unnecessary_blocking_io=false;"
@@ -391,7 +396,9 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "refresh_options_sec=0;"
                              "refresh_options_file=Options.new;"
                              "use_dynamic_delay=true;"
-                             "use_clean_delete_during_flush=false;",
+                             "use_clean_delete_during_flush=false;"
+                             "recycle_iterators=false;"
+                             "manifest_delta_encoding=false;",
                              new_options));
 
   ASSERT_EQ(unset_bytes_base, NumUnsetBytes(new_options_ptr, sizeof(DBOptions),
@@ -524,8 +531,8 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "max_bytes_for_level_multiplier=60;"
       "memtable_factory=SkipListFactory;"
       "compression=kNoCompression;"
-      "compression_opts=5:6:7:8:9:10:true:11:false;"
-      "bottommost_compression_opts=4:5:6:7:8:9:true:10:true;"
+      "compression_opts=5:6:7:8:9:10:true:11:false:true;"
+      "bottommost_compression_opts=4:5:6:7:8:9:true:10:true:true;"
       "bottommost_compression=kDisableCompressionOption;"
       "level0_stop_writes_trigger=33;"
       "num_levels=99;"
@@ -542,6 +549,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "check_flush_compaction_key_order=false;"
       "paranoid_file_checks=true;"
       "force_consistency_checks=true;"
+      "wal_free=false;"
       "inplace_update_num_locks=7429;"
       "experimental_mempurge_threshold=0.0001;"
       "optimize_filters_for_hits=false;"
@@ -551,6 +559,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "compaction_style=kCompactionStyleFIFO;"
       "compaction_pri=kMinOverlappingRatio;"
       "hard_pending_compaction_bytes_limit=0;"
+      "write_delay_weight=0.5;"
       "disable_auto_compactions=false;"
       "report_bg_io_stats=true;"
       "ttl=60;"
@@ -558,6 +567,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "sample_for_compression=0;"
       "enable_blob_files=true;"
       "min_blob_size=256;"
+      "blob_adaptive_inline_ratio=0.25;"
       "blob_file_size=1000000;"
       "blob_compression_type=kBZip2Compression;"
       "enable_blob_garbage_collection=true;"
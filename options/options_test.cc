@@ -101,7 +101,7 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
        "kZSTDNotFinalCompression"},
       {"bottommost_compression", "kLZ4Compression"},
       {"bottommost_compression_opts", "5:6:7:8:10:true"},
-      {"compression_opts", "4:5:6:7:8:2:true:100:false"},
+      {"compression_opts", "4:5:6:7:8:2:true:100:false:true"},
       {"num_levels", "8"},
       {"level0_file_num_compaction_trigger", "8"},
       {"level0_slowdown_writes_trigger", "9"},
@@ -230,6 +230,7 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
   ASSERT_EQ(new_cf_opt.compression_opts.enabled, true);
   ASSERT_EQ(new_cf_opt.compression_opts.max_dict_buffer_bytes, 100u);
   ASSERT_EQ(new_cf_opt.compression_opts.use_zstd_dict_trainer, false);
+  ASSERT_EQ(new_cf_opt.compression_opts.shared_dict_per_compaction, true);
   ASSERT_EQ(new_cf_opt.bottommost_compression, kLZ4Compression);
   ASSERT_EQ(new_cf_opt.bottommost_compression_opts.window_bits, 5);
   ASSERT_EQ(new_cf_opt.bottommost_compression_opts.level, 6);
@@ -241,6 +242,8 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
   ASSERT_EQ(new_cf_opt.bottommost_compression_opts.enabled, true);
   ASSERT_EQ(new_cf_opt.bottommost_compression_opts.use_zstd_dict_trainer,
             CompressionOptions().use_zstd_dict_trainer);
+  ASSERT_EQ(new_cf_opt.bottommost_compression_opts.shared_dict_per_compaction,
+            CompressionOptions().shared_dict_per_compaction);
   ASSERT_EQ(new_cf_opt.num_levels, 8);
   ASSERT_EQ(new_cf_opt.level0_file_num_compaction_trigger, 8);
   ASSERT_EQ(new_cf_opt.level0_slowdown_writes_trigger, 9);
@@ -2626,6 +2629,7 @@ TEST_F(OptionsOldApiTest, GetOptionsFromMapTest) {
   ASSERT_EQ(new_cf_opt.compression_opts.enabled, true);
   ASSERT_EQ(new_cf_opt.compression_opts.max_dict_buffer_bytes, 10u);
   ASSERT_EQ(new_cf_opt.compression_opts.use_zstd_dict_trainer, false);
+  ASSERT_EQ(new_cf_opt.compression_opts.shared_dict_per_compaction, true);
   ASSERT_EQ(new_cf_opt.bottommost_compression, kLZ4Compression);
   ASSERT_EQ(new_cf_opt.bottommost_compression_opts.window_bits, 5);
   ASSERT_EQ(new_cf_opt.bottommost_compression_opts.level, 6);
@@ -2639,6 +2643,8 @@ TEST_F(OptionsOldApiTest, GetOptionsFromMapTest) {
             CompressionOptions().max_dict_buffer_bytes);
   ASSERT_EQ(new_cf_opt.bottommost_compression_opts.use_zstd_dict_trainer,
             CompressionOptions().use_zstd_dict_trainer);
+  ASSERT_EQ(new_cf_opt.bottommost_compression_opts.shared_dict_per_compaction,
+            CompressionOptions().shared_dict_per_compaction);
   ASSERT_EQ(new_cf_opt.num_levels, 8);
   ASSERT_EQ(new_cf_opt.level0_file_num_compaction_trigger, 8);
   ASSERT_EQ(new_cf_opt.level0_slowdown_writes_trigger, 9);
@@ -3893,6 +3899,35 @@ TEST_F(OptionsParserTest, Readahead) {
   ASSERT_GE(fs_->num_seq_file_read_.load(), (file_size - 1) / (512 * 1024) + 1);
 }
 
+TEST_F(OptionsParserTest, SkipVerifyOnPersist) {
+  DBOptions base_db_opt;
+  std::vector<ColumnFamilyOptions> base_cf_opts;
+  base_cf_opts.emplace_back();
+  std::vector<std::string> cf_names = {"default"};
+  const std::string kOptionsFileName = "test-persisted-options.ini";
+
+  // By default the freshly written file is parsed back for verification,
+  // which reads the file.
+  fs_->num_seq_file_read_ = 0;
+  ASSERT_OK(PersistRocksDBOptions(base_db_opt, cf_names, base_cf_opts,
+                                  kOptionsFileName, fs_.get()));
+  ASSERT_GT(fs_->num_seq_file_read_.load(), 0);
+
+  // With verify_options_file_on_persist false, the file is written but never
+  // read back.
+  base_db_opt.verify_options_file_on_persist = false;
+  fs_->num_seq_file_read_ = 0;
+  ASSERT_OK(PersistRocksDBOptions(base_db_opt, cf_names, base_cf_opts,
+                                  kOptionsFileName, fs_.get()));
+  ASSERT_EQ(fs_->num_seq_file_read_.load(), 0);
+
+  // The file content is unaffected by skipping verification.
+  ConfigOptions config_options;
+  ASSERT_OK(RocksDBOptionsParser::VerifyRocksDBOptionsFromFile(
+      config_options, base_db_opt, cf_names, base_cf_opts, kOptionsFileName,
+      fs_.get()));
+}
+
 TEST_F(OptionsParserTest, DumpAndParse) {
   DBOptions base_db_opt;
   std::vector<ColumnFamilyOptions> base_cf_opts;
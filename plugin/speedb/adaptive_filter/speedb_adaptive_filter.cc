@@ -0,0 +1,95 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "plugin/speedb/adaptive_filter/speedb_adaptive_filter.h"
+
+#include "rocksdb/statistics.h"
+#include "rocksdb/utilities/object_registry.h"
+#include "table/block_based/filter_policy_internal.h"
+#include "util/string_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+SpdbAdaptiveFilterPolicy::SpdbAdaptiveFilterPolicy(
+    double bits_per_key, std::shared_ptr<Statistics> statistics)
+    : bits_per_key_(bits_per_key),
+      statistics_(std::move(statistics)),
+      bloom_policy_(NewBloomFilterPolicy(bits_per_key)),
+      // bloom_before_level == -1: the delegate builds ribbon for every
+      // file it is asked about; the level-based choice is made here
+      ribbon_policy_(NewRibbonFilterPolicy(bits_per_key,
+                                           /*bloom_before_level=*/-1)) {}
+
+FilterBitsBuilder* SpdbAdaptiveFilterPolicy::GetBuilderWithContext(
+    const FilterBuildingContext& context) const {
+  // Bottommost files hold most of the data and are rewritten rarely, so
+  // ribbon's memory savings outweigh its slower construction and queries.
+  if (context.is_bottommost) {
+    return ribbon_policy_->GetBuilderWithContext(context);
+  }
+  // When the workload's filter checks are rarely useful, bloom's query
+  // speed buys nothing and ribbon's footprint wins everywhere.
+  if (FiltersRarelyUseful()) {
+    return ribbon_policy_->GetBuilderWithContext(context);
+  }
+  return bloom_policy_->GetBuilderWithContext(context);
+}
+
+FilterBitsReader* SpdbAdaptiveFilterPolicy::GetFilterBitsReader(
+    const Slice& contents) const {
+  // The built-in metadata dispatch recognizes both bloom and ribbon
+  // filter blocks, so either delegate would do here.
+  return bloom_policy_->GetFilterBitsReader(contents);
+}
+
+bool SpdbAdaptiveFilterPolicy::FiltersRarelyUseful() const {
+  if (statistics_ == nullptr) {
+    return false;
+  }
+  const uint64_t useful = statistics_->getTickerCount(BLOOM_FILTER_USEFUL);
+  const uint64_t full_positive =
+      statistics_->getTickerCount(BLOOM_FILTER_FULL_POSITIVE);
+  const uint64_t checks = useful + full_positive;
+  if (checks < kMinFilterChecks) {
+    return false;
+  }
+  return useful * 100 < checks * kMinUsefulPercent;
+}
+
+const char* SpdbAdaptiveFilterPolicy::CompatibilityName() const {
+  return bloom_policy_->CompatibilityName();
+}
+
+std::string SpdbAdaptiveFilterPolicy::GetId() const {
+  return Name() + BloomLikeFilterPolicy::GetBitsPerKeySuffix(
+                      static_cast<int>(bits_per_key_ * 1000.0 + 0.500001));
+}
+
+bool SpdbAdaptiveFilterPolicy::IsInstanceOf(const std::string& name) const {
+  if (name == kClassName()) {
+    return true;
+  } else {
+    return FilterPolicy::IsInstanceOf(name);
+  }
+}
+
+const char* SpdbAdaptiveFilterPolicy::kClassName() {
+  return "speedb_adaptive_filter";
+}
+
+const char* SpdbAdaptiveFilterPolicy::kNickName() {
+  return "speedb.AdaptiveFilter";
+}
+
+}  // namespace ROCKSDB_NAMESPACE
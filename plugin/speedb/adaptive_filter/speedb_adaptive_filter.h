@@ -0,0 +1,100 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "rocksdb/filter_policy.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Forward Declarations
+class ObjectLibrary;
+class Statistics;
+struct FilterBuildingContext;
+
+// A filter policy that picks between the built-in cache-local bloom filter
+// and the Standard128 ribbon filter separately for each SST file, based on
+// where the file is going and on how useful the filters of this DB have
+// actually been so far.
+//
+// The built-in bloom filter is the cheapest to build and to query, which
+// matters on the flush path and in upper levels that are rewritten often.
+// The ribbon filter takes ~30% less memory for the same false positive rate
+// but costs ~4x more CPU to build and noticeably more to query, which is a
+// good deal for bottommost files: they hold most of the data, are rewritten
+// rarely, and their filters dominate the filter memory footprint.
+//
+// On top of the level-based split, when a Statistics object is provided the
+// policy watches the bloom usefulness tickers (BLOOM_FILTER_USEFUL vs.
+// BLOOM_FILTER_FULL_POSITIVE). When filters rarely prevent reads - e.g. the
+// workload mostly looks up keys that exist - paying bloom's memory premium
+// for query speed is wasted, and the policy switches the non-bottommost
+// levels to ribbon as well.
+//
+// Both delegate filters belong to the built-in read-compatible family, so
+// files written with either format are readable through this policy (and
+// through the stock built-in policies). The Speedb paired block bloom filter
+// deliberately does not participate: its filter block format is not
+// readable by the built-in family (it has its own CompatibilityName), so it
+// cannot be mixed per file under a single policy.
+class SpdbAdaptiveFilterPolicy : public FilterPolicy {
+ public:
+  // Below this many recorded filter checks the usefulness feedback is
+  // considered noise and only the level-based selection applies.
+  static constexpr uint64_t kMinFilterChecks = 100000;
+  // Non-bottommost levels fall back to ribbon when fewer than this percent
+  // of filter checks turned out useful (i.e. avoided a read).
+  static constexpr uint64_t kMinUsefulPercent = 10;
+
+ public:
+  explicit SpdbAdaptiveFilterPolicy(
+      double bits_per_key, std::shared_ptr<Statistics> statistics = nullptr);
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext& context) const override;
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override;
+
+  // Plug-In Support
+ public:
+  static const char* kClassName();
+  const char* Name() const override { return kClassName(); }
+  static const char* kNickName();
+  const char* NickName() const override { return kNickName(); }
+
+  std::string GetId() const override;
+
+  bool IsInstanceOf(const std::string& name) const override;
+
+  // Compatible with the RocksDB built-in filters (both delegates are)
+  const char* CompatibilityName() const override;
+
+ private:
+  // True when the observed usefulness tickers say filters rarely help
+  bool FiltersRarelyUseful() const;
+
+ private:
+  double bits_per_key_;
+  std::shared_ptr<Statistics> statistics_;
+
+  // Delegate policies; which one builds a filter is decided per file in
+  // GetBuilderWithContext(). Reading goes through the shared built-in
+  // metadata dispatch, so either delegate can read both formats.
+  std::shared_ptr<const FilterPolicy> bloom_policy_;
+  std::shared_ptr<const FilterPolicy> ribbon_policy_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,188 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "plugin/speedb/memtable/adaptive_memtable_factory.h"
+
+#include "rocksdb/utilities/options_type.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// Forwards every MemTableRep call to the chosen rep while bumping the
+// factory's shared operation counters, so the next create can look at how
+// this memtable was actually used.
+class CountingMemTableRep : public MemTableRep {
+ public:
+  CountingMemTableRep(
+      std::unique_ptr<MemTableRep> target,
+      std::shared_ptr<SpdbAdaptiveMemTableFactory::OpCounters> counters)
+      : MemTableRep(nullptr),
+        target_(std::move(target)),
+        counters_(std::move(counters)) {}
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    return target_->Allocate(len, buf);
+  }
+
+  void Insert(KeyHandle handle) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    target_->Insert(handle);
+  }
+
+  bool InsertKey(KeyHandle handle) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    return target_->InsertKey(handle);
+  }
+
+  void InsertWithHint(KeyHandle handle, void** hint) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    target_->InsertWithHint(handle, hint);
+  }
+
+  bool InsertKeyWithHint(KeyHandle handle, void** hint) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    return target_->InsertKeyWithHint(handle, hint);
+  }
+
+  void InsertWithHintConcurrently(KeyHandle handle, void** hint) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    target_->InsertWithHintConcurrently(handle, hint);
+  }
+
+  bool InsertKeyWithHintConcurrently(KeyHandle handle, void** hint) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    return target_->InsertKeyWithHintConcurrently(handle, hint);
+  }
+
+  void InsertConcurrently(KeyHandle handle) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    target_->InsertConcurrently(handle);
+  }
+
+  bool InsertKeyConcurrently(KeyHandle handle) override {
+    counters_->inserts.fetch_add(1, std::memory_order_relaxed);
+    return target_->InsertKeyConcurrently(handle);
+  }
+
+  bool Contains(const char* key) const override {
+    return target_->Contains(key);
+  }
+
+  void MarkReadOnly() override { target_->MarkReadOnly(); }
+
+  void MarkFlushed() override { target_->MarkFlushed(); }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    counters_->gets.fetch_add(1, std::memory_order_relaxed);
+    target_->Get(k, callback_args, callback_func);
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey,
+                                 const Slice& end_ikey) override {
+    return target_->ApproximateNumEntries(start_ikey, end_ikey);
+  }
+
+  void UniqueRandomSample(const uint64_t num_entries,
+                          const uint64_t target_sample_size,
+                          std::unordered_set<const char*>* entries) override {
+    target_->UniqueRandomSample(num_entries, target_sample_size, entries);
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    return target_->ApproximateMemoryUsage();
+  }
+
+  Iterator* GetIterator(Arena* arena = nullptr,
+                        bool part_of_flush = false) override {
+    if (!part_of_flush) {
+      counters_->iters.fetch_add(1, std::memory_order_relaxed);
+    }
+    return target_->GetIterator(arena, part_of_flush);
+  }
+
+  Iterator* GetDynamicPrefixIterator(Arena* arena = nullptr) override {
+    counters_->iters.fetch_add(1, std::memory_order_relaxed);
+    return target_->GetDynamicPrefixIterator(arena);
+  }
+
+  bool IsMergeOperatorSupported() const override {
+    return target_->IsMergeOperatorSupported();
+  }
+
+  bool IsSnapshotSupported() const override {
+    return target_->IsSnapshotSupported();
+  }
+
+ private:
+  std::unique_ptr<MemTableRep> target_;
+  std::shared_ptr<SpdbAdaptiveMemTableFactory::OpCounters> counters_;
+};
+
+static std::unordered_map<std::string, OptionTypeInfo>
+    spdb_adaptive_factory_info = {
+        {"scan_percent_threshold",
+         {offsetof(struct SpdbAdaptiveMemTableOptions, scan_percent_threshold),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"min_ops_for_decision",
+         {offsetof(struct SpdbAdaptiveMemTableOptions, min_ops_for_decision),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"hash_bucket_count",
+         {offsetof(struct SpdbAdaptiveMemTableOptions, hash_bucket_count),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+};
+
+}  // namespace
+
+SpdbAdaptiveMemTableFactory::SpdbAdaptiveMemTableFactory(
+    const SpdbAdaptiveMemTableOptions& options)
+    : options_(options),
+      counters_(std::make_shared<OpCounters>()),
+      skip_list_factory_(new SkipListFactory()),
+      hash_spdb_factory_(
+          NewHashSpdbRepFactory(options.hash_bucket_count)) {
+  RegisterOptions(&options_, &spdb_adaptive_factory_info);
+}
+
+bool SpdbAdaptiveMemTableFactory::ScanHeavy() {
+  const uint64_t gets = counters_->gets.exchange(0, std::memory_order_relaxed);
+  const uint64_t inserts =
+      counters_->inserts.exchange(0, std::memory_order_relaxed);
+  const uint64_t iters =
+      counters_->iters.exchange(0, std::memory_order_relaxed);
+  const uint64_t total = gets + inserts + iters;
+  if (total < options_.min_ops_for_decision) {
+    return use_skip_list_.load(std::memory_order_relaxed);
+  }
+  const bool scan_heavy =
+      iters * 100 >= options_.scan_percent_threshold * total;
+  use_skip_list_.store(scan_heavy, std::memory_order_relaxed);
+  return scan_heavy;
+}
+
+MemTableRep* SpdbAdaptiveMemTableFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, Allocator* allocator,
+    const SliceTransform* transform, Logger* logger) {
+  MemTableRepFactory* chosen =
+      ScanHeavy() ? skip_list_factory_.get() : hash_spdb_factory_.get();
+  std::unique_ptr<MemTableRep> rep(
+      chosen->CreateMemTableRep(compare, allocator, transform, logger));
+  return new CountingMemTableRep(std::move(rep), counters_);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
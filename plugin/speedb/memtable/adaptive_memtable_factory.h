@@ -0,0 +1,89 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "rocksdb/memtablerep.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct SpdbAdaptiveMemTableOptions {
+  static const char* kName() { return "SpdbAdaptiveMemTableOptions"; }
+
+  static constexpr uint32_t kDefaultScanPercentThreshold = 10;
+  static constexpr uint64_t kDefaultMinOpsForDecision = 1024;
+
+  // A memtable whose share of iterator creations (out of all Get, Insert
+  // and iterator operations it served) reaches this percentage steers the
+  // next memtable of the column family to the skip list; below it the hash
+  // rep is used.
+  uint32_t scan_percent_threshold = kDefaultScanPercentThreshold;
+
+  // Memtables that served fewer operations than this keep the previous
+  // choice instead of deciding on noise.
+  uint64_t min_ops_for_decision = kDefaultMinOpsForDecision;
+
+  // Forwarded to the underlying HashSpdbRepFactory.
+  size_t hash_bucket_count = 1000000;
+};
+
+// A MemTableRepFactory that keeps each column family on its fastest
+// memtable structure automatically: it counts Get/Insert/iterator
+// operations on the memtables it creates and, when asked for the next
+// memtable, picks InlineSkipList for scan-heavy recent traffic and
+// HashSpdbRep for point-heavy traffic.
+class SpdbAdaptiveMemTableFactory : public MemTableRepFactory {
+ public:
+  explicit SpdbAdaptiveMemTableFactory(
+      const SpdbAdaptiveMemTableOptions& options =
+          SpdbAdaptiveMemTableOptions());
+  ~SpdbAdaptiveMemTableFactory() override = default;
+
+  static const char* kClassName() { return "SpdbAdaptiveMemTableFactory"; }
+  static const char* kNickName() { return "speedb.adaptive"; }
+  const char* Name() const override { return kClassName(); }
+  const char* NickName() const override { return kNickName(); }
+
+  using MemTableRepFactory::CreateMemTableRep;
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator& compare,
+                                 Allocator* allocator,
+                                 const SliceTransform* transform,
+                                 Logger* logger) override;
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+  bool CanHandleDuplicatedKey() const override { return true; }
+
+  // Counters shared between the factory and the reps it hands out; the
+  // factory reads-and-resets them on every create.
+  struct OpCounters {
+    std::atomic<uint64_t> gets{0};
+    std::atomic<uint64_t> inserts{0};
+    std::atomic<uint64_t> iters{0};
+  };
+
+ private:
+  bool ScanHeavy();
+
+  SpdbAdaptiveMemTableOptions options_;
+  std::shared_ptr<OpCounters> counters_;
+  std::unique_ptr<MemTableRepFactory> skip_list_factory_;
+  std::unique_ptr<MemTableRepFactory> hash_spdb_factory_;
+  // last decision, kept when a memtable saw too little traffic to re-decide
+  std::atomic<bool> use_skip_list_{false};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -24,6 +24,7 @@
 
 #include "port/likely.h"  // for LIKELY
 #include "port/port.h"    // for PREFETCH
+#include "table/multiget_context.h"
 #include "test_util/sync_point.h"
 #include "util/bloom_impl.h"
 #include "util/fastrange.h"
@@ -850,12 +851,61 @@ bool SpdbPairedBloomBitsReader::MayMatch(const Slice& key) {
   return HashMayMatch(hash);
 }
 
-// TODO: COPY Rocksdb's approach for multi-keys to improve performance
-// (prefetch blocks)
+// Batched version used by MultiGet. The single-key path above suffers two
+// serial dependent loads per key (the pairing byte of the primary block must
+// be read before the secondary block's address is even known). Processing the
+// batch in passes hides those latencies: all primary blocks are prefetched
+// up front, then each pairing byte is read and the secondary prefetch issued
+// while the primary bits (AVX2 when available) are being tested, and only the
+// survivors touch their secondary block in the last pass.
 void SpdbPairedBloomBitsReader::MayMatch(int num_keys, Slice** keys,
                                          bool* may_match) {
-  for (auto i = 0; i < num_keys; ++i) {
-    may_match[i] = MayMatch(*keys[i]);
+  assert(num_keys <= static_cast<int>(MultiGetContext::MAX_BATCH_SIZE));
+  std::array<uint32_t, MultiGetContext::MAX_BATCH_SIZE> upper_32_bits_of_hashes;
+  std::array<uint32_t, MultiGetContext::MAX_BATCH_SIZE> primary_block_idxs;
+  std::array<uint32_t, MultiGetContext::MAX_BATCH_SIZE> secondary_block_idxs;
+  std::array<uint8_t, MultiGetContext::MAX_BATCH_SIZE> hash_selectors;
+
+  // Pass 1: hash all the keys and prefetch every primary block
+  for (int i = 0; i < num_keys; ++i) {
+    uint64_t hash = GetSliceHash64(*keys[i]);
+    primary_block_idxs[i] =
+        HashToGlobalBlockIdx(Lower32of64(hash), data_len_bytes_);
+    PrefetchBlock(GetBlockAddress(data_, primary_block_idxs[i]));
+    upper_32_bits_of_hashes[i] = Upper32of64(hash);
+  }
+
+  const size_t hash_set_size = num_probes_ / 2;
+
+  // Pass 2: read each pairing byte (the primary blocks should be in cache by
+  // now), prefetch the secondary block, and test the primary bloom bits while
+  // the secondary prefetches are in flight
+  for (int i = 0; i < num_keys; ++i) {
+    ReadBlock primary_block(data_, primary_block_idxs[i],
+                            false /* prefetch_block */);
+    const uint8_t primary_in_batch_block_idx =
+        GetInBatchBlockIdx(primary_block_idxs[i]);
+    const uint8_t secondary_in_batch_block_idx =
+        primary_block.GetInBatchBlockIdxOfPair();
+    hash_selectors[i] = GetHashSetSelector(primary_in_batch_block_idx,
+                                           secondary_in_batch_block_idx);
+    const uint32_t batch_idx = GetContainingBatchIdx(primary_block_idxs[i]);
+    secondary_block_idxs[i] =
+        GetFirstGlobalBlockIdxOfBatch(batch_idx) + secondary_in_batch_block_idx;
+    PrefetchBlock(GetBlockAddress(data_, secondary_block_idxs[i]));
+
+    may_match[i] = primary_block.AreAllBlockBloomBitsSet(
+        upper_32_bits_of_hashes[i], hash_selectors[i], hash_set_size);
+  }
+
+  // Pass 3: test the secondary block of every key that survived its primary
+  for (int i = 0; i < num_keys; ++i) {
+    if (may_match[i]) {
+      ReadBlock secondary_block(data_, secondary_block_idxs[i],
+                                false /* prefetch_block */);
+      may_match[i] = secondary_block.AreAllBlockBloomBitsSet(
+          upper_32_bits_of_hashes[i], 1 - hash_selectors[i], hash_set_size);
+    }
   }
 }
 
@@ -14,6 +14,8 @@
 
 speedb_SOURCES = \
      speedb_registry.cc                            \
+     adaptive_filter/speedb_adaptive_filter.cc     \
+     memtable/adaptive_memtable_factory.cc         \
      paired_filter/speedb_paired_bloom.cc          \
      paired_filter/speedb_paired_bloom_internal.cc \
      pinning_policy/scoped_pinning_policy.cc       \
@@ -22,6 +24,8 @@ speedb_SOURCES = \
 speedb_FUNC = register_SpeedbPlugins
 
 speedb_HEADERS = \
+     adaptive_filter/speedb_adaptive_filter.h      \
+     memtable/adaptive_memtable_factory.h          \
      paired_filter/speedb_paired_bloom.h           \
      pinning_policy/scoped_pinning_policy.h        \
 
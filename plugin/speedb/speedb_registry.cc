@@ -15,6 +15,8 @@
 #include "plugin/speedb/speedb_registry.h"
 
 #include "paired_filter/speedb_paired_bloom.h"
+#include "plugin/speedb/adaptive_filter/speedb_adaptive_filter.h"
+#include "plugin/speedb/memtable/adaptive_memtable_factory.h"
 #include "plugin/speedb/pinning_policy/scoped_pinning_policy.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "util/string_util.h"
@@ -40,6 +42,26 @@ int register_SpeedbPlugins(ObjectLibrary& library, const std::string&) {
         guard->reset(NewSpdbPairedBloomFilterWithBits(uri));
         return guard->get();
       });
+  library.AddFactory<const FilterPolicy>(
+      ObjectLibrary::PatternEntry(SpdbAdaptiveFilterPolicy::kClassName(),
+                                  false)
+          .AnotherName(SpdbAdaptiveFilterPolicy::kNickName())
+          .AddNumber(":", false),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        guard->reset(new SpdbAdaptiveFilterPolicy(
+            FilterPolicy::ExtractBitsPerKeyFromUri(uri)));
+        return guard->get();
+      });
+  library.AddFactory<MemTableRepFactory>(
+      ObjectLibrary::PatternEntry(SpdbAdaptiveMemTableFactory::kClassName(),
+                                  true)
+          .AnotherName(SpdbAdaptiveMemTableFactory::kNickName()),
+      [](const std::string& /*uri*/, std::unique_ptr<MemTableRepFactory>* guard,
+         std::string* /* errmsg */) {
+        guard->reset(new SpdbAdaptiveMemTableFactory());
+        return guard->get();
+      });
   library.AddFactory<TablePinningPolicy>(
       ObjectLibrary::PatternEntry::AsIndividualId(
           ScopedPinningPolicy::kClassName()),
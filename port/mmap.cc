@@ -91,6 +91,17 @@ MemMapping MemMapping::AllocateHuge(size_t length) {
   return AllocateAnonymous(length, /*huge*/ true);
 }
 
+MemMapping MemMapping::AllocateAnonymousTransparentHuge(size_t length) {
+  MemMapping mm = AllocateAnonymous(length, /*huge*/ false);
+#if !defined(OS_WIN) && defined(MADV_HUGEPAGE)
+  if (mm.addr_ != nullptr) {
+    // Best effort; the mapping is usable either way.
+    (void)madvise(mm.addr_, mm.length_, MADV_HUGEPAGE);
+  }
+#endif
+  return mm;
+}
+
 MemMapping MemMapping::AllocateLazyZeroed(size_t length) {
   return AllocateAnonymous(length, /*huge*/ false);
 }
@@ -32,6 +32,13 @@ class MemMapping {
   // Allocate memory requesting to be backed by huge pages
   static MemMapping AllocateHuge(size_t length);
 
+  // Allocate anonymous memory advised (but not guaranteed) to be backed by
+  // transparent huge pages, on platforms with madvise(MADV_HUGEPAGE). Unlike
+  // AllocateHuge, this does not require explicitly reserved huge pages;
+  // without the advice support it degrades to an ordinary lazily-mapped
+  // allocation.
+  static MemMapping AllocateAnonymousTransparentHuge(size_t length);
+
   // Allocate memory that is only lazily mapped to resident memory and
   // guaranteed to be zero-initialized. Note that some platforms like
   // Linux allow memory over-commit, where only the used portion of memory
@@ -39,6 +46,9 @@ class MemMapping {
   // back the full mapping.
   static MemMapping AllocateLazyZeroed(size_t length);
 
+  // An empty mapping
+  MemMapping() {}
+
   // No copies
   MemMapping(const MemMapping&) = delete;
   MemMapping& operator=(const MemMapping&) = delete;
@@ -53,8 +63,6 @@ class MemMapping {
   inline size_t Length() const { return length_; }
 
  private:
-  MemMapping() {}
-
   // The mapped memory, or nullptr on failure / not supported
   void* addr_ = nullptr;
   // The known usable number of bytes starting at that address
@@ -48,6 +48,17 @@ struct DecodeEntry {
     if ((*shared | *non_shared | *value_length) < 128) {
       // Fast path: all three values are encoded in one byte each
       p += 3;
+    } else if ((*shared | *non_shared) < 128 && limit - p >= 4 &&
+               reinterpret_cast<const unsigned char*>(p)[3] < 128) {
+      // Second fast path: one-byte shared and non_shared sizes and a two-byte
+      // value size, which covers values between 128 bytes and 16KB. The first
+      // test failing with one-byte shared and non_shared sizes implies the
+      // continuation bit of the value size is set.
+      *value_length =
+          (*value_length & 0x7f) |
+          (static_cast<uint32_t>(reinterpret_cast<const unsigned char*>(p)[3])
+           << 7);
+      p += 4;
     } else {
       if ((p = GetVarint32Ptr(p, limit, shared)) == nullptr) return nullptr;
       if ((p = GetVarint32Ptr(p, limit, non_shared)) == nullptr) return nullptr;
@@ -81,6 +92,14 @@ struct CheckAndDecodeEntry {
     if ((*shared | *non_shared | *value_length) < 128) {
       // Fast path: all three values are encoded in one byte each
       p += 3;
+    } else if ((*shared | *non_shared) < 128 && limit - p >= 4 &&
+               reinterpret_cast<const unsigned char*>(p)[3] < 128) {
+      // Second fast path: see DecodeEntry
+      *value_length =
+          (*value_length & 0x7f) |
+          (static_cast<uint32_t>(reinterpret_cast<const unsigned char*>(p)[3])
+           << 7);
+      p += 4;
     } else {
       if ((p = GetVarint32Ptr(p, limit, shared)) == nullptr) return nullptr;
       if ((p = GetVarint32Ptr(p, limit, non_shared)) == nullptr) return nullptr;
@@ -189,7 +208,16 @@ void MetaBlockIter::PrevImpl() {
   }
 }
 
-// Similar to IndexBlockIter::PrevImpl but also caches the prev entries
+// Similar to IndexBlockIter::PrevImpl but also caches the prev entries.
+//
+// Each cache miss materializes the entries between the preceding restart
+// point and the current position, and subsequent Prev()s are served from
+// the cache by index. Since consecutive misses cover disjoint segments of
+// the block, a full reverse scan of a block parses every entry exactly
+// once, same as a forward scan. Entries are deliberately not materialized
+// beyond the current restart segment: callers such as DBIter often step
+// back only a few entries, and parsing the whole block up front would make
+// those short backward walks pay for entries they never visit.
 void DataBlockIter::PrevImpl() {
   assert(Valid());
 
@@ -279,7 +307,17 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok;
+  if (seek_hint_cache_ != nullptr && SeekHintProbe(seek_key, &index)) {
+    // The target falls inside a recently used restart interval; linear scan
+    // from that restart point, exactly as after a successful binary seek.
+    ok = true;
+  } else {
+    ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+    if (ok && seek_hint_cache_ != nullptr) {
+      seek_hint_cache_->Remember(index);
+    }
+  }
 
   if (!ok) {
     return;
@@ -287,6 +325,47 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   FindKeyAfterBinarySeek(seek_key, index, skip_linear_scan);
 }
 
+bool DataBlockIter::SeekHintProbe(const Slice& target, uint32_t* index) {
+  assert(seek_hint_cache_ != nullptr);
+  // Compares the target against the first key of restart interval
+  // `restart_index`; returns the comparison result or kProbeError on a
+  // decode failure (the binary seek fallback reports the corruption).
+  constexpr int kProbeError = std::numeric_limits<int>::min();
+  auto compare_restart_key = [&](uint32_t restart_index) {
+    const uint32_t region_offset = GetRestartPoint(restart_index);
+    uint32_t shared, non_shared;
+    const char* key_ptr = DecodeKey()(data_ + region_offset, data_ + restarts_,
+                                      &shared, &non_shared);
+    if (key_ptr == nullptr || shared != 0) {
+      return kProbeError;
+    }
+    raw_key_.SetKey(Slice(key_ptr, non_shared), false /* copy */);
+    return CompareCurrentKey(target);
+  };
+
+  for (const auto& entry : seek_hint_cache_->restart_indices) {
+    const uint32_t hint = entry.load(std::memory_order_relaxed);
+    if (hint >= num_restarts_) {
+      continue;
+    }
+    const int cmp = compare_restart_key(hint);
+    if (cmp == kProbeError || cmp > 0) {
+      continue;
+    }
+    if (hint + 1 < num_restarts_) {
+      const int next_cmp = compare_restart_key(hint + 1);
+      if (next_cmp == kProbeError || next_cmp <= 0) {
+        continue;
+      }
+    }
+    // First key of interval `hint` is <= target and the next interval (if
+    // any) starts past it: same contract as the index BinarySeek returns.
+    *index = hint;
+    return true;
+  }
+  return false;
+}
+
 void MetaBlockIter::SeekImpl(const Slice& target) {
   Slice seek_key = target;
   PERF_TIMER_GUARD(block_seek_nanos);
@@ -333,6 +412,28 @@ bool DataBlockIter::SeekForGetImpl(const Slice& target) {
   uint8_t entry =
       data_block_hash_index_->Lookup(data_, map_offset, target_user_key);
 
+  return SeekForGetWithEntry(target, entry);
+}
+
+void DataBlockIter::SeekForGetBatchProbe(const Slice* targets,
+                                         size_t num_targets, uint8_t* entries) {
+  assert(data_block_hash_index_);
+  uint32_t map_offset = restarts_ + num_restarts_ * sizeof(uint32_t);
+  constexpr size_t kProbeChunk = 16;
+  Slice user_keys[kProbeChunk];
+  for (size_t base = 0; base < num_targets; base += kProbeChunk) {
+    size_t n = std::min(kProbeChunk, num_targets - base);
+    for (size_t i = 0; i < n; i++) {
+      user_keys[i] = ExtractUserKey(targets[base + i]);
+    }
+    data_block_hash_index_->MultiLookup(data_, map_offset, user_keys, n,
+                                        entries + base);
+  }
+}
+
+bool DataBlockIter::SeekForGetWithEntry(const Slice& target, uint8_t entry) {
+  Slice target_user_key = ExtractUserKey(target);
+
   if (entry == kCollision) {
     // HashSeek not effective, falling back
     SeekImpl(target);
@@ -774,6 +875,23 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
     uint32_t region_offset = GetRestartPoint(static_cast<uint32_t>(mid));
+    if (right - left > 1) {
+      // Pipeline the search: whichever way the comparison below goes, the
+      // next midpoint is one of these two, so start pulling their key bytes
+      // into cache while the current key is being compared. The restart
+      // array itself is small and contiguous, so reading it here to compute
+      // the prefetch addresses is cheap.
+      const int64_t next_right = mid + (right - mid + 1) / 2;
+      const int64_t next_left = left + (mid - left) / 2;
+      if (next_right > mid && next_right <= right) {
+        PREFETCH(data_ + GetRestartPoint(static_cast<uint32_t>(next_right)),
+                 0 /* rw */, 1 /* locality */);
+      }
+      if (next_left > left && next_left < mid) {
+        PREFETCH(data_ + GetRestartPoint(static_cast<uint32_t>(next_left)),
+                 0 /* rw */, 1 /* locality */);
+      }
+    }
     uint32_t shared, non_shared;
     const char* key_ptr = DecodeKeyFunc()(
         data_ + region_offset, data_ + restarts_, &shared, &non_shared);
@@ -1072,7 +1190,8 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
         read_amp_bitmap_.get(), block_contents_pinned,
-        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr);
+        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
+        &seek_hint_cache_);
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
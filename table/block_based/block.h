@@ -11,10 +11,14 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <array>
+#include <atomic>
+#include <limits>
 #include <string>
 #include <vector>
 
 #include "db/pinned_iterators_manager.h"
+#include "port/likely.h"
 #include "port/malloc.h"
 #include "rocksdb/advanced_cache.h"
 #include "rocksdb/iterator.h"
@@ -171,6 +175,34 @@ class Block {
 
   BlockBasedTableOptions::DataBlockIndexType IndexType() const;
 
+  // A tiny cache of recently used restart points, shared by all iterators
+  // over this block, across threads (hence the atomics). A seek whose target
+  // falls inside the restart interval of a remembered entry can start its
+  // linear scan there and skip the binary search entirely, which pays off
+  // when consecutive point lookups land near each other in the same cached
+  // block. Entries are scheduling hints only: a stale or bogus index is
+  // filtered by range checks before use.
+  struct SeekHintCache {
+    static constexpr size_t kNumEntries = 4;
+    static constexpr uint32_t kInvalidRestart =
+        std::numeric_limits<uint32_t>::max();
+
+    SeekHintCache() {
+      for (auto& entry : restart_indices) {
+        entry.store(kInvalidRestart, std::memory_order_relaxed);
+      }
+    }
+
+    void Remember(uint32_t restart_index) {
+      const uint32_t slot =
+          next_slot.fetch_add(1, std::memory_order_relaxed) % kNumEntries;
+      restart_indices[slot].store(restart_index, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint32_t>, kNumEntries> restart_indices;
+    std::atomic<uint32_t> next_slot{0};
+  };
+
   // raw_ucmp is a raw (i.e., not wrapped by `UserComparatorWrapper`) user key
   // comparator.
   //
@@ -248,6 +280,7 @@ class Block {
   uint32_t num_restarts_;
   std::unique_ptr<BlockReadAmpBitmap> read_amp_bitmap_;
   DataBlockHashIndex data_block_hash_index_;
+  mutable SeekHintCache seek_hint_cache_;
 };
 
 // A `BlockIter` iterates over the entries in a `Block`'s data buffer. The
@@ -382,6 +415,10 @@ class BlockIter : public InternalIteratorBase<TValue> {
   // as long as the cleanup functions are transferred to another class,
   // e.g. PinnableSlice, the pointer to the bytes will still be valid.
   bool block_contents_pinned_;
+  // True iff the block's user comparator is the forward BytewiseComparator()
+  // singleton; lets CompareCurrentKey() dispatch straight to memcmp instead
+  // of through the comparator's virtual Compare().
+  bool ucmp_is_forward_bytewise_;
   SequenceNumber global_seqno_;
 
   virtual void SeekToFirstImpl() = 0;
@@ -402,6 +439,7 @@ class BlockIter : public InternalIteratorBase<TValue> {
     assert(num_restarts > 0);  // Ensure the param is valid
 
     icmp_ = std::make_unique<InternalKeyComparator>(raw_ucmp);
+    ucmp_is_forward_bytewise_ = (raw_ucmp == BytewiseComparator());
     data_ = data;
     restarts_ = restarts;
     num_restarts_ = num_restarts;
@@ -424,7 +462,9 @@ class BlockIter : public InternalIteratorBase<TValue> {
       assert(global_seqno_ == kDisableGlobalSequenceNumber);
       key_ = raw_key_.GetUserKey();
       key_pinned_ = raw_key_.IsKeyPinned();
-    } else if (global_seqno_ == kDisableGlobalSequenceNumber) {
+    } else if (LIKELY(global_seqno_ == kDisableGlobalSequenceNumber)) {
+      // Only freshly ingested files carry a global seqno, so this is the
+      // per-entry path nearly all reads and compactions take.
       key_ = raw_key_.GetInternalKey();
       key_pinned_ = raw_key_.IsKeyPinned();
     } else {
@@ -435,14 +475,41 @@ class BlockIter : public InternalIteratorBase<TValue> {
     }
   }
 
+  // Inline equivalent of InternalKeyComparator::Compare() for the forward
+  // bytewise comparator: user keys by memcmp, then the 8-byte packed
+  // seqno+type trailer in decreasing order.
+  static int CompareBytewiseInternalKeys(const Slice& a, const Slice& b) {
+    int r = ExtractUserKey(a).compare(ExtractUserKey(b));
+    if (r == 0) {
+      const uint64_t anum =
+          DecodeFixed64(a.data() + a.size() - kNumInternalBytes);
+      const uint64_t bnum =
+          DecodeFixed64(b.data() + b.size() - kNumInternalBytes);
+      if (anum > bnum) {
+        r = -1;
+      } else if (anum < bnum) {
+        r = +1;
+      }
+    }
+    return r;
+  }
+
   // Returns the result of `Comparator::Compare()`, where the appropriate
   // comparator is used for the block contents, the LHS argument is the current
-  // key with global seqno applied, and the RHS argument is `other`.
+  // key with global seqno applied, and the RHS argument is `other`. This is
+  // the highest-frequency comparison in the read path, so the common bytewise
+  // case skips the virtual comparator dispatch.
   int CompareCurrentKey(const Slice& other) {
     if (raw_key_.IsUserKey()) {
       assert(global_seqno_ == kDisableGlobalSequenceNumber);
+      if (LIKELY(ucmp_is_forward_bytewise_)) {
+        return raw_key_.GetUserKey().compare(other);
+      }
       return icmp_->user_comparator()->Compare(raw_key_.GetUserKey(), other);
-    } else if (global_seqno_ == kDisableGlobalSequenceNumber) {
+    } else if (LIKELY(global_seqno_ == kDisableGlobalSequenceNumber)) {
+      if (LIKELY(ucmp_is_forward_bytewise_)) {
+        return CompareBytewiseInternalKeys(raw_key_.GetInternalKey(), other);
+      }
       return icmp_->Compare(raw_key_.GetInternalKey(), other);
     }
     return icmp_->Compare(raw_key_.GetInternalKey(), global_seqno_, other,
@@ -493,7 +560,10 @@ class BlockIter : public InternalIteratorBase<TValue> {
 class DataBlockIter final : public BlockIter<Slice> {
  public:
   DataBlockIter()
-      : BlockIter(), read_amp_bitmap_(nullptr), last_bitmap_offset_(0) {}
+      : BlockIter(),
+        read_amp_bitmap_(nullptr),
+        last_bitmap_offset_(0),
+        seek_hint_cache_(nullptr) {}
   DataBlockIter(const Comparator* raw_ucmp, const char* data, uint32_t restarts,
                 uint32_t num_restarts, SequenceNumber global_seqno,
                 BlockReadAmpBitmap* read_amp_bitmap, bool block_contents_pinned,
@@ -507,13 +577,15 @@ class DataBlockIter final : public BlockIter<Slice> {
                   SequenceNumber global_seqno,
                   BlockReadAmpBitmap* read_amp_bitmap,
                   bool block_contents_pinned,
-                  DataBlockHashIndex* data_block_hash_index) {
+                  DataBlockHashIndex* data_block_hash_index,
+                  Block::SeekHintCache* seek_hint_cache = nullptr) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts, global_seqno,
                    block_contents_pinned);
     raw_key_.SetIsUserKey(false);
     read_amp_bitmap_ = read_amp_bitmap;
     last_bitmap_offset_ = current_ + 1;
     data_block_hash_index_ = data_block_hash_index;
+    seek_hint_cache_ = seek_hint_cache;
   }
 
   Slice value() const override {
@@ -538,6 +610,29 @@ class DataBlockIter final : public BlockIter<Slice> {
     return res;
   }
 
+  // Variant of SeekForGet() that consumes a hash-index entry previously
+  // obtained from SeekForGetBatchProbe() instead of probing the index again.
+  // REQUIRES: HasDataBlockHashIndex() and `hash_entry` was produced by
+  // SeekForGetBatchProbe() on this block for the same `target`.
+  inline bool SeekForGet(const Slice& target, uint8_t hash_entry) {
+    assert(data_block_hash_index_);
+    bool res = SeekForGetWithEntry(target, hash_entry);
+    UpdateKey();
+    return res;
+  }
+
+  inline bool HasDataBlockHashIndex() const {
+    return data_block_hash_index_ != nullptr;
+  }
+
+  // Probes the block's hash index for a batch of point-lookup targets
+  // (internal keys) in one pass, so keys that share this block in MultiGet
+  // also share the hashing and bucket-table cache misses. Fills entries[i]
+  // for later consumption by SeekForGet(target, hash_entry).
+  // REQUIRES: HasDataBlockHashIndex().
+  void SeekForGetBatchProbe(const Slice* targets, size_t num_targets,
+                            uint8_t* entries);
+
   void Invalidate(const Status& s) override {
     BlockIter::Invalidate(s);
     // Clear prev entries cache.
@@ -587,7 +682,17 @@ class DataBlockIter final : public BlockIter<Slice> {
 
   DataBlockHashIndex* data_block_hash_index_;
 
+  Block::SeekHintCache* seek_hint_cache_;
+
+  // Probes the block's seek-hint cache for a remembered restart interval
+  // containing `target`. On a hit, sets *index to that restart point and
+  // returns true; the caller can then skip the binary search.
+  bool SeekHintProbe(const Slice& target, uint32_t* index);
+
   bool SeekForGetImpl(const Slice& target);
+  // The tail of SeekForGetImpl once the hash-index entry for `target` is
+  // known; shared with the batched-probe path.
+  bool SeekForGetWithEntry(const Slice& target, uint8_t entry);
 };
 
 // Iterator over MetaBlocks.  MetaBlocks are similar to Data Blocks and
@@ -213,10 +213,14 @@ class BlockBasedTableBuilder::BlockBasedTablePropertiesCollector
         whole_key_filtering_(whole_key_filtering),
         prefix_filtering_(prefix_filtering) {}
 
-  Status InternalAdd(const Slice& /*key*/, const Slice& /*value*/,
+  bool NeedsInternalAdd() const override {
+    // Have no interest in collecting stats for individual key/value pairs.
+    return false;
+  }
+
+  Status InternalAdd(const ParsedInternalKey& /*ikey*/, const Slice& /*value*/,
                      uint64_t /*file_size*/) override {
-    // Intentionally left blank. Have no interest in collecting stats for
-    // individual key/value pairs.
+    // Never called since NeedsInternalAdd() is false.
     return Status::OK();
   }
 
@@ -289,6 +293,10 @@ struct BlockBasedTableBuilder::Rep {
   std::vector<std::unique_ptr<UncompressionContext>> verify_ctxs;
   std::unique_ptr<UncompressionDict> verify_dict;
 
+  // Set when the output files of one compaction share a dictionary; see
+  // CompressionOptions::shared_dict_per_compaction.
+  std::shared_ptr<SharedCompressionDict> compression_dict_share;
+
   size_t data_begin_offset = 0;
 
   TableProperties props;
@@ -324,10 +332,21 @@ struct BlockBasedTableBuilder::Rep {
       compression_dict_buffer_cache_res_mgr;
   const bool use_delta_encoding_for_index_values;
   std::unique_ptr<FilterBlockBuilder> filter_builder;
+  // When parallel compression is enabled, the filter's bit placement is run
+  // on a helper thread while Finish() drains the compression/write pipeline,
+  // and the result is parked here for WriteFilterBlock() to pick up.
+  bool filter_precomputed = false;
+  Slice precomputed_filter_content;
+  Status precomputed_filter_status;
+  std::unique_ptr<const char[]> precomputed_filter_data;
   OffsetableCacheKey base_cache_key;
   const TableFileCreationReason reason;
 
   BlockHandle pending_handle;  // Handle to add to index block
+  // True if pending_handle refers to a data block copied in verbatim through
+  // AddCompressedDataBlock() whose index entry is deferred until the next
+  // key is seen, so the separator can be shortened against it.
+  bool pending_index_entry_from_block_copy = false;
 
   std::string compressed_output;
   std::unique_ptr<FlushBlockPolicy> flush_block_policy;
@@ -421,7 +440,8 @@ struct BlockBasedTableBuilder::Rep {
                            ->CanKeysWithDifferentByteContentsBeEqual()
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
-                   table_options.data_block_hash_table_util_ratio),
+                   table_options.data_block_hash_table_util_ratio,
+                   table_options.adaptive_block_restart_interval),
         range_del_block(1 /* block_restart_interval */),
         internal_prefix_transform(tbo.moptions.prefix_extractor.get()),
         compression_type(tbo.compression_type),
@@ -449,6 +469,21 @@ struct BlockBasedTableBuilder::Rep {
                            compression_type == kZSTDNotFinalCompression),
         status_ok(true),
         io_status_ok(true) {
+    if (tbo.compression_dict_share != nullptr) {
+      compression_dict_share = tbo.compression_dict_share;
+      std::string dict;
+      if (state == State::kBuffered && compression_dict_share->GetDict(&dict)) {
+        // An earlier output file of the same compaction already trained a
+        // dictionary; reuse it and skip buffering entirely.
+        compression_dict.reset(
+            new CompressionDict(dict, compression_type,
+                                tbo.compression_opts.level));
+        verify_dict.reset(new UncompressionDict(
+            dict, compression_type == kZSTD ||
+                      compression_type == kZSTDNotFinalCompression));
+        state = State::kUnbuffered;
+      }
+    }
     if (tbo.target_file_size == 0) {
       buffer_limit = compression_opts.max_dict_buffer_bytes;
     } else if (compression_opts.max_dict_buffer_bytes == 0) {
@@ -929,6 +964,13 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
     }
 #endif  // !NDEBUG
 
+    if (r->pending_index_entry_from_block_copy) {
+      // Cut the index entry deferred by AddCompressedDataBlock() now that
+      // the first key following the copied block is known.
+      r->index_builder->AddIndexEntry(&r->last_key, &key, r->pending_handle);
+      r->pending_index_entry_from_block_copy = false;
+    }
+
     auto should_flush = r->flush_block_policy->Update(key, value);
     if (should_flush) {
       assert(!r->data_block.empty());
@@ -1026,6 +1068,60 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
   }
 }
 
+Status BlockBasedTableBuilder::AddCompressedDataBlock(
+    const Slice& compressed_block_contents, CompressionType compression_type,
+    const Slice& first_key_in_block, const Slice& last_key_in_block,
+    uint64_t num_entries) {
+  Rep* r = rep_;
+  assert(r->state != Rep::State::kClosed);
+  if (!ok()) return status();
+  if (r->state == Rep::State::kBuffered || r->IsParallelCompressionEnabled()) {
+    return Status::NotSupported(
+        "Verbatim block copy is not supported in buffered mode or with "
+        "parallel compression");
+  }
+  if (r->filter_builder != nullptr) {
+    // The keys inside the copied block never reach the filter builder, so
+    // any filter built here would return false negatives for them.
+    return Status::NotSupported(
+        "Verbatim block copy requires building without a filter");
+  }
+  if (r->compression_dict != nullptr && compression_type != kNoCompression) {
+    // Readers decompress data blocks with this table's dictionary, which the
+    // copied block was not compressed with.
+    return Status::NotSupported(
+        "Verbatim block copy of a compressed block is not supported with a "
+        "compression dictionary");
+  }
+  if (r->pending_index_entry_from_block_copy) {
+    // Index entry for the previously copied block, shortened against this
+    // block's first key.
+    r->index_builder->AddIndexEntry(&r->last_key, &first_key_in_block,
+                                    r->pending_handle);
+    r->pending_index_entry_from_block_copy = false;
+  }
+  if (!r->data_block.empty()) {
+    // Flush keys added through Add() and cut their index entry at the copied
+    // block's first key, as Add() would at a natural block boundary.
+    Flush();
+    if (ok()) {
+      r->index_builder->AddIndexEntry(&r->last_key, &first_key_in_block,
+                                      r->pending_handle);
+    }
+  }
+  if (!ok()) return status();
+  r->index_builder->OnKeyAdded(first_key_in_block);
+  WriteMaybeCompressedBlock(compressed_block_contents, compression_type,
+                            &r->pending_handle, BlockType::kData);
+  if (!ok()) return status();
+  r->props.data_size = r->get_offset();
+  ++r->props.num_data_blocks;
+  r->props.num_entries += num_entries;
+  r->last_key.assign(last_key_in_block.data(), last_key_in_block.size());
+  r->pending_index_entry_from_block_copy = true;
+  return status();
+}
+
 void BlockBasedTableBuilder::Flush() {
   Rep* r = rep_;
   assert(rep_->state != Rep::State::kClosed);
@@ -1244,9 +1340,12 @@ void BlockBasedTableBuilder::WriteMaybeCompressedBlock(
   handle->set_size(block_contents.size());
   assert(status().ok());
   assert(io_status().ok());
+  // Blocks copied verbatim from another file arrive without their
+  // uncompressed contents, so they cannot be used to warm the block cache.
+  const bool have_uncompressed =
+      uncompressed_block_data != nullptr || type == kNoCompression;
   if (uncompressed_block_data == nullptr) {
     uncompressed_block_data = &block_contents;
-    assert(type == kNoCompression);
   }
 
   {
@@ -1297,7 +1396,7 @@ void BlockBasedTableBuilder::WriteMaybeCompressedBlock(
         assert(false);
         warm_cache = false;
     }
-    if (warm_cache) {
+    if (warm_cache && have_uncompressed) {
       Status s = InsertBlockInCacheHelper(*uncompressed_block_data, handle,
                                           block_type);
       if (!s.ok()) {
@@ -1451,8 +1550,10 @@ void BlockBasedTableBuilder::WriteFilterBlock(
   BlockHandle filter_block_handle;
   bool is_partitioned_filter = rep_->table_options.partition_filters;
   if (ok()) {
-    rep_->props.num_filter_entries +=
-        rep_->filter_builder->EstimateEntriesAdded();
+    if (!rep_->filter_precomputed) {
+      rep_->props.num_filter_entries +=
+          rep_->filter_builder->EstimateEntriesAdded();
+    }
     Status s = Status::Incomplete();
     while (ok() && s.IsIncomplete()) {
       // filter_data is used to store the transferred filter data payload from
@@ -1464,8 +1565,17 @@ void BlockBasedTableBuilder::WriteFilterBlock(
       // transferred filter data payload among different FilterBlockBuilder
       // subtypes.
       std::unique_ptr<const char[]> filter_data;
-      Slice filter_content =
-          rep_->filter_builder->Finish(filter_block_handle, &s, &filter_data);
+      Slice filter_content;
+      if (rep_->filter_precomputed) {
+        // Finish() already ran the filter builder on a helper thread while
+        // the compression pipeline was draining; consume its result.
+        filter_content = rep_->precomputed_filter_content;
+        s = rep_->precomputed_filter_status;
+        filter_data = std::move(rep_->precomputed_filter_data);
+      } else {
+        filter_content =
+            rep_->filter_builder->Finish(filter_block_handle, &s, &filter_data);
+      }
 
       assert(s.ok() || s.IsIncomplete() || s.IsCorruption());
       if (s.IsCorruption()) {
@@ -1784,6 +1894,11 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
   } else {
     dict = std::move(compression_dict_samples);
   }
+  if (r->compression_dict_share != nullptr) {
+    // Make the trained dictionary available to the remaining output files of
+    // this compaction.
+    r->compression_dict_share->SetDict(dict);
+  }
   r->compression_dict.reset(new CompressionDict(dict, r->compression_type,
                                                 r->compression_opts.level));
   r->verify_dict.reset(new UncompressionDict(
@@ -1883,7 +1998,29 @@ Status BlockBasedTableBuilder::Finish() {
     EnterUnbuffered();
   }
   if (r->IsParallelCompressionEnabled()) {
+    // Full (non-partitioned) filters defer bit placement until Finish(), so
+    // their construction can run on a helper thread while the compression
+    // pipeline is drained, instead of serially afterwards. Partitioned
+    // filters interleave with index building and stay on this thread.
+    port::Thread filter_thread;
+    if (ok() && !r->table_options.partition_filters &&
+        r->filter_builder != nullptr && !r->filter_builder->IsEmpty()) {
+      // The bits builder forgets its entry count once its Finish() runs, so
+      // record it before handing the builder to the helper thread.
+      r->props.num_filter_entries += r->filter_builder->EstimateEntriesAdded();
+      r->filter_precomputed = true;
+      filter_thread = port::Thread([r] {
+        // Full filter builders ignore the last-partition handle.
+        BlockHandle unused_handle;
+        r->precomputed_filter_content = r->filter_builder->Finish(
+            unused_handle, &r->precomputed_filter_status,
+            &r->precomputed_filter_data);
+      });
+    }
     StopParallelCompression();
+    if (filter_thread.joinable()) {
+      filter_thread.join();
+    }
 #ifndef NDEBUG
     for (const auto& br : r->pc_rep->block_rep_buf) {
       assert(br.status.ok());
@@ -1892,9 +2029,11 @@ Status BlockBasedTableBuilder::Finish() {
   } else {
     // To make sure properties block is able to keep the accurate size of index
     // block, we will finish writing all index entries first.
-    if (ok() && !empty_data_block) {
+    if (ok() &&
+        (!empty_data_block || r->pending_index_entry_from_block_copy)) {
       r->index_builder->AddIndexEntry(
           &r->last_key, nullptr /* no next data block */, r->pending_handle);
+      r->pending_index_entry_from_block_copy = false;
     }
   }
 
@@ -57,6 +57,23 @@ class BlockBasedTableBuilder : public TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called
   void Add(const Slice& key, const Slice& value) override;
 
+  // Append an already-compressed data block verbatim, bypassing block
+  // construction and compression. This is the building block for relinking
+  // unmodified data blocks from a compaction input into the output without
+  // recompressing them; only index and metadata are rebuilt. The keys inside
+  // the block are never seen by this builder, so the table must be built
+  // without a filter policy, and a compressed block cannot be copied into a
+  // table that uses a compression dictionary. num_entries is the number of
+  // entries inside the block and is only used for table properties.
+  // REQUIRES: first/last_key_in_block are the block's boundary internal keys
+  //           and first_key_in_block is after any previously added key.
+  // REQUIRES: Finish(), Abandon() have not been called
+  Status AddCompressedDataBlock(const Slice& compressed_block_contents,
+                                CompressionType compression_type,
+                                const Slice& first_key_in_block,
+                                const Slice& last_key_in_block,
+                                uint64_t num_entries);
+
   // Return non-ok iff some error has been detected.
   Status status() const override;
 
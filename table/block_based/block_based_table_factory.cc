@@ -354,6 +354,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
                *interval = std::max(1, *interval);
                return Status::OK();
              })},
+        {"adaptive_block_restart_interval",
+         {offsetof(struct BlockBasedTableOptions,
+                   adaptive_block_restart_interval),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"index_block_restart_interval",
          OptionTypeInfo(offsetof(struct BlockBasedTableOptions,
                                  index_block_restart_interval),
@@ -968,6 +973,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  block_restart_interval: %d\n",
            table_options_.block_restart_interval);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  adaptive_block_restart_interval: %d\n",
+           table_options_.adaptive_block_restart_interval);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  index_block_restart_interval: %d\n",
            table_options_.index_block_restart_interval);
   ret.append(buffer);
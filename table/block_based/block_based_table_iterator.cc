@@ -10,7 +10,7 @@
 
 namespace ROCKSDB_NAMESPACE {
 
-void BlockBasedTableIterator::SeekToFirst() { SeekImpl(nullptr, false); }
+void BlockBasedTableIterator::SeekToFirst() { SeekImpl(nullptr, true); }
 
 void BlockBasedTableIterator::Seek(const Slice& target) {
   SeekImpl(&target, true);
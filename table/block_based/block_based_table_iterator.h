@@ -34,16 +34,25 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
         pinned_iters_mgr_(nullptr),
         prefix_extractor_(prefix_extractor),
         lookup_context_(caller),
-        block_prefetcher_(
-            compaction_readahead_size,
-            table_->get_rep()->table_options.initial_auto_readahead_size),
+        block_prefetcher_(compaction_readahead_size,
+                          table_->get_rep()->SeededAutoReadaheadSize()),
         allow_unprepared_value_(allow_unprepared_value),
         block_iter_points_to_real_block_(false),
         check_filter_(check_filter),
         need_upper_bound_check_(need_upper_bound_check),
         async_read_in_progress_(false) {}
 
-  ~BlockBasedTableIterator() {}
+  ~BlockBasedTableIterator() {
+    // Remember how far auto readahead ramped up for this iterator so the
+    // next iterator over the same file starts from there instead of from
+    // initial_auto_readahead_size. Compaction and explicit readahead use
+    // fixed sizes, so there is nothing to learn from them.
+    if (read_options_.readahead_size == 0 &&
+        lookup_context_.caller != TableReaderCaller::kCompaction) {
+      table_->get_rep()->UpdateLearnedReadaheadSize(
+          block_prefetcher_.CurrentReadaheadSize());
+    }
+  }
 
   void Seek(const Slice& target) override;
   void SeekForPrev(const Slice& target) override;
@@ -965,6 +965,28 @@ Status BlockBasedTable::ReadRangeDelBlock(
         "Error when seeking to range delete tombstones block from file: %s",
         s.ToString().c_str());
   } else if (!range_del_handle.IsNull()) {
+    // The fragmented structure is built from immutable SST contents, so one
+    // instance can be shared by every reader of this file generation: cache
+    // it in the block cache under its own entry role so it survives table
+    // re-opens and version installs instead of being re-fragmented each
+    // time. Its key is the file's base cache key with an offset past the end
+    // of the file, which cannot collide with any raw block (including the
+    // raw range deletion block cached under the handle's offset).
+    using RangeDelFragmentsCacheInterface =
+        BasicTypedCacheInterface<FragmentedRangeTombstoneList,
+                                 CacheEntryRole::kFragmentedRangeTombstoneList>;
+    Cache* block_cache = rep_->table_options.block_cache.get();
+    RangeDelFragmentsCacheInterface fragments_cache{block_cache};
+    CacheKey cache_key;
+    if (block_cache != nullptr) {
+      cache_key = rep_->base_cache_key.WithOffset(rep_->file_size + 1);
+      auto* cache_handle =
+          fragments_cache.Lookup(cache_key.AsSlice(), rep_->ioptions.stats);
+      if (cache_handle != nullptr) {
+        rep_->fragmented_range_dels = fragments_cache.SharedGuard(cache_handle);
+        return s;
+      }
+    }
     Status tmp_status;
     std::unique_ptr<InternalIterator> iter(NewDataBlockIterator<DataBlockIter>(
         read_options, range_del_handle,
@@ -980,9 +1002,25 @@ Status BlockBasedTable::ReadRangeDelBlock(
           s.ToString().c_str());
       IGNORE_STATUS_IF_ERROR(s);
     } else {
-      rep_->fragmented_range_dels =
-          std::make_shared<FragmentedRangeTombstoneList>(std::move(iter),
-                                                         internal_comparator);
+      auto fragments = std::make_unique<FragmentedRangeTombstoneList>(
+          std::move(iter), internal_comparator);
+      if (block_cache != nullptr) {
+        RangeDelFragmentsCacheInterface::TypedHandle* cache_handle = nullptr;
+        Status insert_status = fragments_cache.Insert(
+            cache_key.AsSlice(), fragments.get(),
+            fragments->ApproximateMemoryUsage(), &cache_handle);
+        if (insert_status.ok()) {
+          // The cache owns the object now; hold it through the handle.
+          fragments.release();
+          rep_->fragmented_range_dels =
+              fragments_cache.SharedGuard(cache_handle);
+        }
+      }
+      if (rep_->fragmented_range_dels == nullptr) {
+        // No cache, or insertion failed (e.g. strict capacity limit): fall
+        // back to per-reader ownership as before.
+        rep_->fragmented_range_dels = std::move(fragments);
+      }
     }
   }
   return s;
@@ -1093,7 +1131,8 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
   // are hence follow the configuration for pin and prefetch regardless of
   // the value of cache_index_and_filter_blocks
   if (prefetch_all || pin_partition) {
-    s = rep_->index_reader->CacheDependencies(ro, pin_partition);
+    s = rep_->index_reader->CacheDependencies(ro, pinning_options,
+                                              pin_partition);
   }
   if (!s.ok()) {
     return s;
@@ -1120,7 +1159,7 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
     if (filter) {
       // Refer to the comment above about paritioned indexes always being cached
       if (prefetch_all || pin_partition) {
-        s = filter->CacheDependencies(ro, pin_partition);
+        s = filter->CacheDependencies(ro, pinning_options, pin_partition);
         if (!s.ok()) {
           return s;
         }
@@ -1308,7 +1347,8 @@ WithBlocklikeCheck<Status, TBlocklike> BlockBasedTable::PutDataBlockToCache(
     CachableEntry<TBlocklike>* out_parsed_block, BlockContents&& block_contents,
     CompressionType block_comp_type,
     const UncompressionDict& uncompression_dict,
-    MemoryAllocator* memory_allocator, GetContext* get_context) const {
+    MemoryAllocator* memory_allocator, GetContext* get_context,
+    bool for_compaction) const {
   const ImmutableOptions& ioptions = rep_->ioptions;
   const uint32_t format_version = rep_->table_options.format_version;
   assert(out_parsed_block);
@@ -1340,8 +1380,14 @@ WithBlocklikeCheck<Status, TBlocklike> BlockBasedTable::PutDataBlockToCache(
   if (block_cache && block_holder->own_bytes()) {
     size_t charge = block_holder->ApproximateMemoryUsage();
     BlockCacheTypedHandle<TBlocklike>* cache_handle = nullptr;
+    // Blocks fetched for a compaction go in at bottom priority: they are
+    // read once, and an admission policy (see CacheAdmissionPolicy) can
+    // recognize and reject them outright.
+    const Cache::Priority priority = for_compaction
+                                         ? Cache::Priority::BOTTOM
+                                         : GetCachePriority<TBlocklike>();
     s = block_cache.InsertFull(cache_key, block_holder.get(), charge,
-                               &cache_handle, GetCachePriority<TBlocklike>(),
+                               &cache_handle, priority,
                                rep_->ioptions.lowest_used_cache_tier,
                                rep_->cache_owner_id);
 
@@ -1544,7 +1590,8 @@ BlockBasedTable::MaybeReadBlockAndLoadToCache(
         s = PutDataBlockToCache(
             key, block_cache, out_parsed_block, std::move(*contents),
             contents_comp_type, uncompression_dict,
-            GetMemoryAllocator(rep_->table_options), get_context);
+            GetMemoryAllocator(rep_->table_options), get_context,
+            for_compaction);
       }
     }
   }
@@ -1759,7 +1806,7 @@ bool BlockBasedTable::PrefixRangeMayMatch(
   auto ts_sz = rep_->internal_comparator.user_comparator()->timestamp_size();
   auto user_key_without_ts =
       ExtractUserKeyAndStripTimestamp(internal_key, ts_sz);
-  if (!prefix_extractor->InDomain(user_key_without_ts)) {
+  if (!prefix_extractor->InDomainInline(user_key_without_ts)) {
     return true;
   }
 
@@ -1863,9 +1910,9 @@ bool BlockBasedTable::FullFilterKeyMayMatch(
         filter->KeyMayMatch(user_key_without_ts, no_io, const_ikey_ptr,
                             get_context, lookup_context, rate_limiter_priority);
   } else if (!PrefixExtractorChanged(prefix_extractor) &&
-             prefix_extractor->InDomain(user_key_without_ts) &&
+             prefix_extractor->InDomainInline(user_key_without_ts) &&
              !filter->PrefixMayMatch(
-                 prefix_extractor->Transform(user_key_without_ts), no_io,
+                 prefix_extractor->TransformInline(user_key_without_ts), no_io,
                  const_ikey_ptr, get_context, lookup_context,
                  rate_limiter_priority)) {
     // FIXME ^^^: there should be no reason for Get() to depend on current
@@ -1931,8 +1978,8 @@ Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
   // `CacheDependencies()` brings all the blocks into cache using one I/O. That
   // way the full index scan usually finds the index data it is looking for in
   // cache rather than doing an I/O for each "dependency" (partition).
-  Status s =
-      rep_->index_reader->CacheDependencies(read_options, false /* pin */);
+  Status s = rep_->index_reader->CacheDependencies(
+      read_options, TablePinningOptions(), false /* pin */);
   if (!s.ok()) {
     return s;
   }
@@ -2181,6 +2228,65 @@ Status BlockBasedTable::MultiGetFilter(const ReadOptions& read_options,
   return Status::OK();
 }
 
+IOStatus BlockBasedTable::ReadMultipleBlocksAsync(
+    RandomAccessFileReader* file, const IOOptions& opts,
+    FSReadRequest* read_reqs, size_t num_reqs,
+    Env::IOPriority rate_limiter_priority) const {
+  assert(!file->use_direct_io());
+  // The callback only has to hand the completed read back to the request the
+  // caller is going to inspect. Poll() guarantees the callbacks have run by
+  // the time it returns, so no synchronization is needed beyond that.
+  std::function<void(const FSReadRequest&, void*)> read_cb =
+      [](const FSReadRequest& completed, void* cb_arg) {
+        FSReadRequest* orig = static_cast<FSReadRequest*>(cb_arg);
+        orig->result = completed.result;
+        orig->status = completed.status;
+      };
+
+  autovector<void*, MultiGetContext::MAX_BATCH_SIZE> io_handles;
+  autovector<IOHandleDeleter, MultiGetContext::MAX_BATCH_SIZE> del_fns;
+  IOStatus s;
+  size_t num_issued = 0;
+  while (num_issued < num_reqs) {
+    FSReadRequest req;
+    req.offset = read_reqs[num_issued].offset;
+    req.len = read_reqs[num_issued].len;
+    req.scratch = read_reqs[num_issued].scratch;
+    req.status.PermitUncheckedError();
+    void* io_handle = nullptr;
+    IOHandleDeleter del_fn;
+    s = file->ReadAsync(req, opts, read_cb, &read_reqs[num_issued], &io_handle,
+                        &del_fn, /*aligned_buf=*/nullptr);
+    if (!s.ok()) {
+      break;
+    }
+    if (io_handle != nullptr) {
+      io_handles.emplace_back(io_handle);
+      del_fns.emplace_back(std::move(del_fn));
+    }
+    ++num_issued;
+  }
+
+  if (!io_handles.empty()) {
+    std::vector<void*> handles(io_handles.begin(), io_handles.end());
+    rep_->ioptions.fs->Poll(handles, handles.size()).PermitUncheckedError();
+    for (size_t i = 0; i < io_handles.size(); ++i) {
+      if (del_fns[i]) {
+        del_fns[i](io_handles[i]);
+      }
+    }
+  }
+
+  if (!s.ok()) {
+    // Most commonly the file system simply does not implement ReadAsync.
+    // Whatever was issued already has completed above; read the rest the
+    // regular way.
+    s = file->MultiRead(opts, read_reqs + num_issued, num_reqs - num_issued,
+                        /*aligned_buf=*/nullptr, rate_limiter_priority);
+  }
+  return s;
+}
+
 Status BlockBasedTable::Prefetch(const Slice* const begin,
                                  const Slice* const end) {
   auto& comparator = rep_->internal_comparator;
@@ -238,8 +238,11 @@ class BlockBasedTable : public TableReader {
     // memory that was allocated in block cache.
     virtual size_t ApproximateMemoryUsage() const = 0;
     // Cache the dependencies of the index reader (e.g. the partitions
-    // of a partitioned index).
+    // of a partitioned index). When `pin` is set, the pinned partitions
+    // are admitted through the table's pinning policy using `tpo`, so the
+    // policy can account for (and cap) the memory they occupy.
     virtual Status CacheDependencies(const ReadOptions& /*ro*/,
+                                     const TablePinningOptions& /*tpo*/,
                                      bool /* pin */) {
       return Status::OK();
     }
@@ -379,6 +382,19 @@ class BlockBasedTable : public TableReader {
       Status* statuses, CachableEntry<Block>* results, char* scratch,
       const UncompressionDict& uncompression_dict);
 
+  // Issue all the reads in read_reqs through FSRandomAccessFile::ReadAsync
+  // and wait for every one of them with FileSystem::Poll, so the requests
+  // are in flight concurrently. This gives the synchronous MultiGet path the
+  // same read overlap as the coroutine path without requiring a folly build.
+  // Requests that could not be issued asynchronously (most commonly because
+  // the file system does not implement ReadAsync) are read with MultiRead
+  // instead. Not for use with direct IO; the caller is expected to keep
+  // direct IO reads on the MultiRead path, which realigns and merges them.
+  IOStatus ReadMultipleBlocksAsync(RandomAccessFileReader* file,
+                                   const IOOptions& opts,
+                                   FSReadRequest* read_reqs, size_t num_reqs,
+                                   Env::IOPriority rate_limiter_priority) const;
+
   // Get the iterator from the index reader.
   //
   // If input_iter is not set, return a new Iterator.
@@ -420,13 +436,17 @@ class BlockBasedTable : public TableReader {
   // PutDataBlockToCache(). After the call, the object will be invalid.
   // @param uncompression_dict Data for presetting the compression library's
   //    dictionary.
+  // @param for_compaction Whether the block was read on behalf of a
+  //    compaction; such blocks are inserted at bottom priority so one-pass
+  //    compaction reads do not evict the hot working set.
   template <typename TBlocklike>
   WithBlocklikeCheck<Status, TBlocklike> PutDataBlockToCache(
       const Slice& cache_key, BlockCacheInterface<TBlocklike> block_cache,
       CachableEntry<TBlocklike>* cached_block, BlockContents&& block_contents,
       CompressionType block_comp_type,
       const UncompressionDict& uncompression_dict,
-      MemoryAllocator* memory_allocator, GetContext* get_context) const;
+      MemoryAllocator* memory_allocator, GetContext* get_context,
+      bool for_compaction) const;
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -659,28 +679,51 @@ struct BlockBasedTable::Rep {
   uint64_t sst_number_for_tracing() const {
     return file ? TableFileNameToNumber(file->file_name()) : UINT64_MAX;
   }
+
+  // Readahead size the auto-readahead heuristics of the last finished
+  // iterator over this file had ramped up to; 0 until an iterator reports.
+  // New iterators seed from it (see SeededAutoReadaheadSize()) so that
+  // repeated scans over the same file do not pay the exponential ramp-up
+  // from initial_auto_readahead_size every time. Last writer wins, which
+  // also unlearns the value once access to the file turns random and the
+  // ramp is reset.
+  mutable std::atomic<size_t> learned_readahead_size{0};
+
+  size_t SeededAutoReadaheadSize() const {
+    size_t learned = learned_readahead_size.load(std::memory_order_relaxed);
+    size_t initial = table_options.initial_auto_readahead_size;
+    if (learned <= initial) {
+      return initial;
+    }
+    return std::min(learned, table_options.max_auto_readahead_size);
+  }
+
+  void UpdateLearnedReadaheadSize(size_t observed) const {
+    learned_readahead_size.store(observed, std::memory_order_relaxed);
+  }
+
   void CreateFilePrefetchBuffer(
       size_t readahead_size, size_t max_readahead_size,
       std::unique_ptr<FilePrefetchBuffer>* fpb, bool implicit_auto_readahead,
-      uint64_t num_file_reads,
-      uint64_t num_file_reads_for_auto_readahead) const {
+      uint64_t num_file_reads, uint64_t num_file_reads_for_auto_readahead,
+      FilePrefetchBufferUsage usage = FilePrefetchBufferUsage::kUnknown) const {
     fpb->reset(new FilePrefetchBuffer(
         readahead_size, max_readahead_size,
         !ioptions.allow_mmap_reads /* enable */, false /* track_min_offset */,
         implicit_auto_readahead, num_file_reads,
         num_file_reads_for_auto_readahead, ioptions.fs.get(), ioptions.clock,
-        ioptions.stats));
+        ioptions.stats, usage));
   }
 
   void CreateFilePrefetchBufferIfNotExists(
       size_t readahead_size, size_t max_readahead_size,
       std::unique_ptr<FilePrefetchBuffer>* fpb, bool implicit_auto_readahead,
-      uint64_t num_file_reads,
-      uint64_t num_file_reads_for_auto_readahead) const {
+      uint64_t num_file_reads, uint64_t num_file_reads_for_auto_readahead,
+      FilePrefetchBufferUsage usage = FilePrefetchBufferUsage::kUnknown) const {
     if (!(*fpb)) {
       CreateFilePrefetchBuffer(readahead_size, max_readahead_size, fpb,
                                implicit_auto_readahead, num_file_reads,
-                               num_file_reads_for_auto_readahead);
+                               num_file_reads_for_auto_readahead, usage);
     }
   }
 
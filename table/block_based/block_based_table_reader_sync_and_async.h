@@ -143,6 +143,14 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
     if (s.ok()) {
 #if defined(WITH_COROUTINES)
       if (file->use_direct_io()) {
+#else
+      // Even without coroutines, ReadOptions::async_io buys overlap here:
+      // every request of the batch is issued through
+      // FSRandomAccessFile::ReadAsync and then waited for at once, instead of
+      // MultiRead serializing the reads on file systems that do not batch
+      // internally. Direct IO stays on the MultiRead path, which realigns
+      // and merges the requests.
+      if (!options.async_io || file->use_direct_io() || read_reqs.size() < 2) {
 #endif  // WITH_COROUTINES
         s = file->MultiRead(opts, &read_reqs[0], read_reqs.size(),
                             &direct_io_buf, options.rate_limiter_priority);
@@ -151,6 +159,11 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
         co_await batch->context()->reader().MultiReadAsync(
             file, opts, &read_reqs[0], read_reqs.size(), &direct_io_buf);
       }
+#else
+      } else {
+        s = ReadMultipleBlocksAsync(file, opts, &read_reqs[0], read_reqs.size(),
+                                    options.rate_limiter_priority);
+      }
 #endif  // WITH_COROUTINES
     }
     if (!s.ok()) {
@@ -162,6 +175,42 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
     }
   }
 
+  // Verify the checksums of the whole batch up front, before any block is
+  // decompressed, copied or inserted into the cache. Running the checksum
+  // kernel back-to-back over the (mostly contiguous) read buffers keeps it
+  // hot in the instruction cache and lets the hardware-accelerated
+  // implementations stream, instead of interleaving each CRC with the
+  // per-block decode work below.
+  autovector<Status, MultiGetContext::MAX_BATCH_SIZE> checksum_s;
+  if (options.verify_checksums) {
+    PERF_TIMER_GUARD(block_checksum_time);
+    size_t valid_idx = 0;
+    for (size_t i = 0; i < handles->size(); ++i) {
+      const BlockHandle& handle = (*handles)[i];
+      if (handle.IsNull()) {
+        continue;
+      }
+      assert(valid_idx < req_idx_for_block.size());
+      FSReadRequest& req = read_reqs[req_idx_for_block[valid_idx]];
+      size_t req_offset = req_offset_for_block[valid_idx];
+      valid_idx++;
+      if (!req.status.ok() || req.result.size() != req.len ||
+          req_offset + BlockSizeWithTrailer(handle) > req.result.size()) {
+        // Failed or truncated read; the loop below reports the error
+        checksum_s.emplace_back(Status::OK());
+        continue;
+      }
+      // Since the scratch might be shared, the offset of the data block in
+      // the buffer might not be 0. req.result.data() only points to the
+      // begin address of each read request; we need to add the offset in
+      // each read request. Checksum is stored in the block trailer, beyond
+      // the payload size.
+      checksum_s.emplace_back(VerifyBlockChecksum(
+          footer.checksum_type(), req.result.data() + req_offset,
+          handle.size(), rep_->file->file_name(), handle.offset()));
+    }
+  }
+
   idx_in_batch = 0;
   size_t valid_batch_idx = 0;
   for (auto mget_iter = batch->begin(); mget_iter != batch->end();
@@ -213,16 +262,9 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
 #endif
 
       if (options.verify_checksums) {
-        PERF_TIMER_GUARD(block_checksum_time);
-        const char* data = req.result.data();
-        // Since the scratch might be shared, the offset of the data block in
-        // the buffer might not be 0. req.result.data() only point to the
-        // begin address of each read request, we need to add the offset
-        // in each read request. Checksum is stored in the block trailer,
-        // beyond the payload size.
-        s = VerifyBlockChecksum(footer.checksum_type(), data + req_offset,
-                                handle.size(), rep_->file->file_name(),
-                                handle.offset());
+        // Verified in the batch pass above
+        assert(valid_batch_idx - 1 < checksum_s.size());
+        s = checksum_s[valid_batch_idx - 1];
         TEST_SYNC_POINT_CALLBACK("RetrieveMultipleBlocks:VerifyChecksum", &s);
       }
     } else if (!use_shared_buffer) {
@@ -537,6 +579,12 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
     DataBlockIter next_biter;
     size_t idx_in_batch = 0;
     SharedCleanablePtr shared_cleanable;
+    // When several consecutive keys of the batch share one data block, their
+    // hash-index probes are issued together the first time the block is seen
+    // (SeekForGetBatchProbe) and consumed here one key at a time.
+    autovector<uint8_t, MultiGetContext::MAX_BATCH_SIZE> batch_probe_entries;
+    size_t batch_probe_begin = 0;
+    size_t batch_probe_count = 0;
     for (auto miter = sst_file_range.begin(); miter != sst_file_range.end();
          ++miter) {
       Status s;
@@ -555,6 +603,7 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
             TableReaderCaller::kUserMultiGet, tracing_mget_id,
             /*_get_from_user_specified_snapshot=*/read_options.snapshot !=
                 nullptr);
+        size_t my_idx = idx_in_batch;
         if (first_block) {
           if (!block_handles[idx_in_batch].IsNull() ||
               !results[idx_in_batch].IsEmpty()) {
@@ -610,6 +659,28 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
           break;
         }
 
+        if (first_block && !reusing_prev_block && later_reused &&
+            biter->HasDataBlockHashIndex()) {
+          // This block also serves the following keys of the batch: probe
+          // the hash index for the whole run at once so those keys share
+          // the hashing and bucket-table cache misses.
+          autovector<Slice, MultiGetContext::MAX_BATCH_SIZE> probe_keys;
+          probe_keys.push_back(key);
+          auto scan = miter;
+          for (++scan; scan != sst_file_range.end(); ++scan) {
+            size_t idx = my_idx + probe_keys.size();
+            if (!block_handles[idx].IsNull() || !results[idx].IsEmpty()) {
+              break;
+            }
+            probe_keys.push_back(scan->ikey);
+          }
+          batch_probe_entries.resize(probe_keys.size());
+          biter->SeekForGetBatchProbe(&probe_keys[0], probe_keys.size(),
+                                      &batch_probe_entries[0]);
+          batch_probe_begin = my_idx;
+          batch_probe_count = probe_keys.size();
+        }
+
         // Reusing blocks complicates pinning/Cleanable, because the cache
         // entry referenced by biter can only be released once all returned
         // pinned values are released. This code previously did an extra
@@ -652,7 +723,14 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
           value_pinner = nullptr;
         }
 
-        bool may_exist = biter->SeekForGet(key);
+        bool may_exist;
+        if (first_block && my_idx >= batch_probe_begin &&
+            my_idx < batch_probe_begin + batch_probe_count) {
+          may_exist = biter->SeekForGet(
+              key, batch_probe_entries[my_idx - batch_probe_begin]);
+        } else {
+          may_exist = biter->SeekForGet(key);
+        }
         if (!may_exist) {
           // HashSeek cannot find the key this block and the the iter is not
           // the end of the block, i.e. cannot be in the following blocks
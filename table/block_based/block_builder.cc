@@ -44,12 +44,24 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+// In adaptive mode, a key sharing at most this many bytes with its
+// predecessor is considered high-entropy: storing it in full at a restart
+// point costs little beyond the 4-byte restart array slot.
+constexpr size_t kAdaptiveRestartSharedPrefixThreshold = 8;
+}  // namespace
+
 BlockBuilder::BlockBuilder(
     int block_restart_interval, bool use_delta_encoding,
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    double data_block_hash_table_util_ratio)
-    : block_restart_interval_(block_restart_interval),
+    double data_block_hash_table_util_ratio, bool adaptive_restart_interval)
+    : restart_interval_min_(adaptive_restart_interval
+                                ? std::max(1, block_restart_interval / 4)
+                                : block_restart_interval),
+      restart_interval_max_(adaptive_restart_interval
+                                ? block_restart_interval * 2
+                                : block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
       restarts_(1, 0),  // First restart point is at offset 0
@@ -65,7 +77,7 @@ BlockBuilder::BlockBuilder(
     default:
       assert(0);
   }
-  assert(block_restart_interval_ >= 1);
+  assert(restart_interval_min_ >= 1);
   estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
 }
 
@@ -99,11 +111,11 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
   // In value delta encoding we estimate the value delta size as half the full
   // value size since only the size field of block handle is encoded.
   estimate +=
-      !use_value_delta_encoding_ || (counter_ >= block_restart_interval_)
+      !use_value_delta_encoding_ || (counter_ >= restart_interval_max_)
           ? value.size()
           : value.size() / 2;
 
-  if (counter_ >= block_restart_interval_) {
+  if (counter_ >= restart_interval_max_) {
     estimate += sizeof(uint32_t);  // a new restart entry.
   }
 
@@ -111,7 +123,7 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
   // Note: this is an imprecise estimate as we will have to encoded size, one
   // for shared key and one for non-shared key.
   estimate += VarintLength(key.size());  // varint for key length.
-  if (!use_value_delta_encoding_ || (counter_ >= block_restart_interval_)) {
+  if (!use_value_delta_encoding_ || (counter_ >= restart_interval_max_)) {
     estimate += VarintLength(value.size());  // varint for value length.
   }
 
@@ -185,10 +197,10 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
                                              const Slice* const delta_value,
                                              size_t buffer_size) {
   assert(!finished_);
-  assert(counter_ <= block_restart_interval_);
+  assert(counter_ <= restart_interval_max_);
   assert(!use_value_delta_encoding_ || delta_value);
   size_t shared = 0;  // number of bytes shared with prev key
-  if (counter_ >= block_restart_interval_) {
+  if (counter_ >= restart_interval_max_) {
     // Restart compression
     restarts_.push_back(static_cast<uint32_t>(buffer_size));
     estimate_ += sizeof(uint32_t);
@@ -196,6 +208,16 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
   } else if (use_delta_encoding_) {
     // See how much sharing to do with previous string
     shared = key.difference_offset(last_key);
+    if (counter_ >= restart_interval_min_ &&
+        shared <= kAdaptiveRestartSharedPrefixThreshold) {
+      // Adaptive mode (restart_interval_min_ < restart_interval_max_):
+      // negligible sharing means this entry is nearly a full key anyway, so
+      // turn it into a restart point early to shorten in-block linear scans.
+      restarts_.push_back(static_cast<uint32_t>(buffer_size));
+      estimate_ += sizeof(uint32_t);
+      counter_ = 0;
+      shared = 0;
+    }
   }
 
   const size_t non_shared = key.size() - shared;
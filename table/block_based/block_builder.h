@@ -23,12 +23,21 @@ class BlockBuilder {
   BlockBuilder(const BlockBuilder&) = delete;
   void operator=(const BlockBuilder&) = delete;
 
+  // When `adaptive_restart_interval` is set, `block_restart_interval` is
+  // treated as a midpoint rather than a fixed period: keys that share almost
+  // no prefix with their predecessor may become restart points after as few
+  // as block_restart_interval / 4 entries (a restart costs nearly nothing
+  // there and speeds up in-block search), while highly compressible runs
+  // defer the restart up to 2 * block_restart_interval entries to save
+  // space. The resulting blocks use the standard restart array format and
+  // need no reader-side support.
   explicit BlockBuilder(int block_restart_interval,
                         bool use_delta_encoding = true,
                         bool use_value_delta_encoding = false,
                         BlockBasedTableOptions::DataBlockIndexType index_type =
                             BlockBasedTableOptions::kDataBlockBinarySearch,
-                        double data_block_hash_table_util_ratio = 0.75);
+                        double data_block_hash_table_util_ratio = 0.75,
+                        bool adaptive_restart_interval = false);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -81,7 +90,10 @@ class BlockBuilder {
                                  const Slice* const delta_value,
                                  size_t buffer_size);
 
-  const int block_restart_interval_;
+  // Minimum/maximum number of entries between restart points. Both equal the
+  // configured block_restart_interval unless adaptive mode is on.
+  const int restart_interval_min_;
+  const int restart_interval_max_;
   // TODO(myabandeh): put it into a separate IndexBlockBuilder
   const bool use_delta_encoding_;
   // Refer to BlockIter::DecodeCurrentValue for format of delta encoded values
@@ -46,6 +46,19 @@ class BlockPrefetcher {
     return;
   }
 
+  // The readahead size the auto-readahead heuristics have currently ramped
+  // up to: the internal prefetch buffer's when one was created, the
+  // OS-prefetch ramp's otherwise. Used to seed later iterators over the same
+  // file (see BlockBasedTable::Rep::SeededAutoReadaheadSize()).
+  size_t CurrentReadaheadSize() {
+    if (prefetch_buffer_ != nullptr) {
+      ReadaheadFileInfo::ReadaheadInfo readahead_info;
+      prefetch_buffer_->GetReadaheadState(&readahead_info);
+      return readahead_info.readahead_size;
+    }
+    return readahead_size_;
+  }
+
   void SetReadaheadState(ReadaheadFileInfo::ReadaheadInfo* readahead_info) {
     num_file_reads_ = readahead_info->num_file_reads;
     initial_auto_readahead_size_ = readahead_info->readahead_size;
@@ -127,6 +127,185 @@ TEST_F(BlockTest, SimpleTest) {
   delete iter;
 }
 
+// Repeated point seeks that land near each other must stay correct when
+// served through the block's seek-hint cache, which lets a seek start its
+// linear scan from a recently used restart point instead of binary
+// searching. Each seek uses a fresh iterator, as separate Get calls would.
+TEST_F(BlockTest, SeekHintMemoization) {
+  Options options = Options();
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  BlockBuilder builder(16);
+  int num_records = 10000;
+
+  GenerateRandomKVs(&keys, &values, 0, num_records);
+  for (int i = 0; i < num_records; i++) {
+    builder.Add(keys[i], values[i]);
+  }
+  Slice rawblock = builder.Finish();
+
+  BlockContents contents;
+  contents.data = rawblock;
+  Block reader(std::move(contents));
+
+  auto seek_and_check = [&](int index) {
+    std::unique_ptr<InternalIterator> iter(reader.NewDataIterator(
+        options.comparator, kDisableGlobalSequenceNumber));
+    iter->Seek(Slice(keys[index]));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(0, iter->key().ToString().compare(keys[index]));
+    ASSERT_EQ(0, iter->value().ToString().compare(values[index]));
+  };
+
+  // Sequential-ish point reads: consecutive seeks fall into the restart
+  // interval remembered by the previous one.
+  for (int i = 0; i < 200; i++) {
+    seek_and_check(i);
+  }
+  // Far jumps invalidate nothing; hints simply miss and the binary seek
+  // repopulates them.
+  Random rnd(301);
+  for (int i = 0; i < 200; i++) {
+    seek_and_check(rnd.Uniform(num_records));
+  }
+  // Revisiting a warm neighborhood hits the remembered restart points again.
+  for (int i = 200; i > 0; i--) {
+    seek_and_check(i);
+  }
+}
+
+// Blocks built with an adaptive restart interval must stay fully readable
+// through the standard reader, and the interval must shrink for
+// low-sharing keys and stretch for highly compressible runs.
+TEST_F(BlockTest, AdaptiveRestartInterval) {
+  Random rnd(301);
+  Options options = Options();
+  const int kInterval = 16;
+  int num_records = 10000;
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  // Long random padding makes consecutive keys share almost nothing.
+  GenerateRandomKVs(&keys, &values, 0, num_records, 1 /* step */,
+                    24 /* padding_size */);
+
+  BlockBuilder fixed_builder(kInterval);
+  BlockBuilder adaptive_builder(kInterval, true /* use_delta_encoding */,
+                                false /* use_value_delta_encoding */,
+                                BlockBasedTableOptions::kDataBlockBinarySearch,
+                                0.75, true /* adaptive_restart_interval */);
+  for (int i = 0; i < num_records; i++) {
+    fixed_builder.Add(keys[i], values[i]);
+    adaptive_builder.Add(keys[i], values[i]);
+  }
+  Slice fixed_block = fixed_builder.Finish();
+  Slice adaptive_block = adaptive_builder.Finish();
+
+  auto num_restarts = [](const Slice &rawblock) {
+    BlockContents contents;
+    contents.data = rawblock;
+    Block reader(std::move(contents));
+    return reader.NumRestarts();
+  };
+  // High-entropy keys: restarts roughly every kInterval / 4 entries.
+  ASSERT_GT(num_restarts(adaptive_block), num_restarts(fixed_block));
+
+  // All records must come back through the regular reader.
+  BlockContents contents;
+  contents.data = adaptive_block;
+  Block reader(std::move(contents));
+  InternalIterator *iter =
+      reader.NewDataIterator(options.comparator, kDisableGlobalSequenceNumber);
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); count++, iter->Next()) {
+    ASSERT_EQ(iter->key().ToString(), keys[count]);
+    ASSERT_EQ(iter->value().ToString(), values[count]);
+  }
+  ASSERT_EQ(count, num_records);
+  for (int i = 0; i < 100; i++) {
+    int index = rnd.Uniform(num_records);
+    iter->Seek(Slice(keys[index]));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->value().ToString(), values[index]);
+  }
+  delete iter;
+
+  // Monotonic keys sharing long prefixes: restarts get spaced further
+  // apart than the configured interval.
+  std::vector<std::string> mono_keys;
+  for (int i = 0; i < num_records; i++) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "prefix-shared-by-all-%08d", i);
+    std::string k(buf);
+    AppendInternalKeyFooter(&k, 0 /* seqno */, kTypeValue);
+    mono_keys.push_back(k);
+  }
+  BlockBuilder mono_fixed_builder(kInterval);
+  BlockBuilder mono_adaptive_builder(
+      kInterval, true /* use_delta_encoding */,
+      false /* use_value_delta_encoding */,
+      BlockBasedTableOptions::kDataBlockBinarySearch, 0.75,
+      true /* adaptive_restart_interval */);
+  for (int i = 0; i < num_records; i++) {
+    mono_fixed_builder.Add(mono_keys[i], values[i]);
+    mono_adaptive_builder.Add(mono_keys[i], values[i]);
+  }
+  Slice mono_fixed_block = mono_fixed_builder.Finish();
+  Slice mono_adaptive_block = mono_adaptive_builder.Finish();
+  ASSERT_LT(num_restarts(mono_adaptive_block), num_restarts(mono_fixed_block));
+  ASSERT_LT(mono_adaptive_block.size(), mono_fixed_block.size());
+}
+
+// Same as SimpleTest but with value sizes that need one-, two- and
+// three-byte varint length encodings, to exercise all the entry header
+// decoding paths.
+TEST_F(BlockTest, SimpleTestLargeValues) {
+  Random rnd(301);
+  Options options = Options();
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  BlockBuilder builder(16);
+  const int num_records = 500;
+  const int value_sizes[] = {100, 500, 20000};
+
+  {
+    Random key_rnd(302);
+    for (int i = 0; i < num_records; i++) {
+      keys.emplace_back(GenerateInternalKey(i, 0, 0, &key_rnd));
+      values.emplace_back(rnd.RandomString(value_sizes[i % 3]));
+      builder.Add(keys.back(), values.back());
+    }
+  }
+
+  Slice rawblock = builder.Finish();
+
+  BlockContents contents;
+  contents.data = rawblock;
+  Block reader(std::move(contents));
+
+  int count = 0;
+  InternalIterator *iter =
+      reader.NewDataIterator(options.comparator, kDisableGlobalSequenceNumber);
+  for (iter->SeekToFirst(); iter->Valid(); count++, iter->Next()) {
+    ASSERT_EQ(iter->key().ToString(), keys[count]);
+    ASSERT_EQ(iter->value().ToString(), values[count]);
+  }
+  ASSERT_EQ(count, num_records);
+  delete iter;
+
+  iter =
+      reader.NewDataIterator(options.comparator, kDisableGlobalSequenceNumber);
+  for (int i = 0; i < num_records; i++) {
+    int index = rnd.Uniform(num_records);
+    iter->Seek(Slice(keys[index]));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->value().ToString(), values[index]);
+  }
+  delete iter;
+}
+
 // return the block contents
 BlockContents GetBlockContents(std::unique_ptr<BlockBuilder> *builder,
                                const std::vector<std::string> &keys,
@@ -4,15 +4,30 @@
 //  (found in the LICENSE.Apache file in the root directory).
 #include "table/block_based/data_block_hash_index.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include "port/port.h"
 #include "rocksdb/slice.h"
 #include "util/coding.h"
 #include "util/hash.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+// Per-file util ratio tuning. A block whose keys land behind collision
+// markers at more than kCollisionRateHigh gets the hash table of the
+// following blocks grown by kTuneUpFactor (down to a util ratio floor of
+// 1 / kMaxBucketPerKey); once the rate falls below kCollisionRateLow the
+// table slowly shrinks back toward the configured ratio.
+constexpr double kCollisionRateHigh = 0.10;
+constexpr double kCollisionRateLow = 0.02;
+constexpr double kTuneUpFactor = 1.25;
+constexpr double kTuneDownFactor = 0.95;
+constexpr double kMaxBucketPerKey = 2.5;  // util ratio floor of 0.4
+}  // namespace
+
 void DataBlockHashIndexBuilder::Add(const Slice& key,
                                     const size_t restart_index) {
   assert(Valid());
@@ -55,6 +70,19 @@ void DataBlockHashIndexBuilder::Finish(std::string& buffer) {
     }
   }
 
+  // Count the keys that ended up behind a collision marker (and will fall
+  // back to binary seek on lookup) and feed the per-file tuning, so the
+  // remaining blocks of this file get a table sized for the observed key
+  // distribution.
+  size_t num_collision_keys = 0;
+  for (auto& entry : hash_and_restart_pairs_) {
+    uint16_t buck_idx = static_cast<uint16_t>(entry.first % num_buckets);
+    if (buckets[buck_idx] == kCollision) {
+      num_collision_keys++;
+    }
+  }
+  TuneUtilRatio(hash_and_restart_pairs_.size(), num_collision_keys);
+
   for (uint8_t restart_index : buckets) {
     buffer.append(
         const_cast<const char*>(reinterpret_cast<char*>(&restart_index)),
@@ -67,6 +95,23 @@ void DataBlockHashIndexBuilder::Finish(std::string& buffer) {
   assert(buffer.size() <= kMaxBlockSizeSupportedByHashIndex);
 }
 
+void DataBlockHashIndexBuilder::TuneUtilRatio(size_t num_keys,
+                                              size_t num_collision_keys) {
+  if (num_keys == 0) {
+    return;
+  }
+  double collision_rate =
+      static_cast<double>(num_collision_keys) / static_cast<double>(num_keys);
+  if (collision_rate > kCollisionRateHigh) {
+    bucket_per_key_ = std::min(bucket_per_key_ * kTuneUpFactor,
+                               kMaxBucketPerKey);
+  } else if (collision_rate < kCollisionRateLow &&
+             bucket_per_key_ > configured_bucket_per_key_) {
+    bucket_per_key_ = std::max(bucket_per_key_ * kTuneDownFactor,
+                               configured_bucket_per_key_);
+  }
+}
+
 void DataBlockHashIndexBuilder::Reset() {
   estimated_num_buckets_ = 0;
   valid_ = true;
@@ -91,4 +136,25 @@ uint8_t DataBlockHashIndex::Lookup(const char* data, uint32_t map_offset,
   return static_cast<uint8_t>(*(bucket_table + idx * sizeof(uint8_t)));
 }
 
+void DataBlockHashIndex::MultiLookup(const char* data, uint32_t map_offset,
+                                     const Slice* keys, size_t num_keys,
+                                     uint8_t* entries) const {
+  const char* bucket_table = data + map_offset;
+  constexpr size_t kProbeChunk = 16;
+  uint16_t idx[kProbeChunk];
+  for (size_t base = 0; base < num_keys; base += kProbeChunk) {
+    size_t n = std::min(kProbeChunk, num_keys - base);
+    for (size_t i = 0; i < n; i++) {
+      idx[i] = static_cast<uint16_t>(GetSliceHash(keys[base + i]) %
+                                     num_buckets_);
+      PREFETCH(bucket_table + idx[i] * sizeof(uint8_t), 0 /* rw */,
+               1 /* locality */);
+    }
+    for (size_t i = 0; i < n; i++) {
+      entries[base + i] =
+          static_cast<uint8_t>(*(bucket_table + idx[i] * sizeof(uint8_t)));
+    }
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -71,10 +71,18 @@ const uint8_t kMaxRestartSupportedByHashIndex = 253;
 const size_t kMaxBlockSizeSupportedByHashIndex = 1u << 16;
 const double kDefaultUtilRatio = 0.75;
 
+// The builder lives for the duration of a table file (it is reset between
+// blocks but not re-initialized), so it can observe the collision rate of
+// every block it finishes and auto-tune the effective util ratio for the
+// remaining blocks of the file: key distributions that collide a lot get a
+// sparser table (more buckets per key), well-behaved ones drift back to the
+// configured ratio. The serialized format is unchanged; only the number of
+// buckets per block varies.
 class DataBlockHashIndexBuilder {
  public:
   DataBlockHashIndexBuilder()
       : bucket_per_key_(-1 /*uninitialized marker*/),
+        configured_bucket_per_key_(-1),
         estimated_num_buckets_(0),
         valid_(false) {}
 
@@ -83,6 +91,7 @@ class DataBlockHashIndexBuilder {
       util_ratio = kDefaultUtilRatio;  // sanity check
     }
     bucket_per_key_ = 1 / util_ratio;
+    configured_bucket_per_key_ = bucket_per_key_;
     valid_ = true;
   }
 
@@ -102,7 +111,14 @@ class DataBlockHashIndexBuilder {
   }
 
  private:
+  // Adjusts bucket_per_key_ for the following blocks of the file from the
+  // collision rate observed in the block just finished.
+  void TuneUtilRatio(size_t num_keys, size_t num_collision_keys);
+
   double bucket_per_key_;  // is the multiplicative inverse of util_ratio_
+  // The ratio requested through Initialize(); bucket_per_key_ never tunes
+  // below it.
+  double configured_bucket_per_key_;
   double estimated_num_buckets_;
 
   // Now the only usage for `valid_` is to mark false when the inserted
@@ -122,6 +138,14 @@ class DataBlockHashIndex {
 
   uint8_t Lookup(const char* data, uint32_t map_offset, const Slice& key) const;
 
+  // Batched Lookup for MultiGet: probes `num_keys` user keys against the
+  // same block in two passes, hashing every key and prefetching its bucket
+  // before any bucket is read, so the probes overlap cache misses instead of
+  // serializing on them. Fills entries[i] with the same value Lookup(keys[i])
+  // would return.
+  void MultiLookup(const char* data, uint32_t map_offset, const Slice* keys,
+                   size_t num_keys, uint8_t* entries) const;
+
   inline bool Valid() { return num_buckets_ != 0; }
 
  private:
@@ -184,6 +184,80 @@ TEST(DataBlockHashIndex, DataBlockHashTestCollision) {
   }
 }
 
+TEST(DataBlockHashIndex, DataBlockHashTestAutoTune) {
+  // The builder survives Reset() between blocks of a file. With every key in
+  // its own restart interval the collision rate at util_ratio 0.75 is high,
+  // so successive blocks of identical key count must get more buckets as the
+  // per-file tuning lowers the effective util ratio.
+  DataBlockHashIndexBuilder builder;
+  builder.Initialize(0.75 /*util_ratio*/);
+
+  size_t first_num_buckets = 0;
+  size_t last_num_buckets = 0;
+  for (int block = 0; block < 6; block++) {
+    for (uint8_t i = 0; i < 100; i++) {
+      std::string key("key" + std::to_string(i));
+      builder.Add(key, i /*restart_point*/);
+    }
+
+    size_t estimated_size = builder.EstimateSize();
+
+    std::string buffer("fake");
+    size_t original_size = buffer.size();
+    estimated_size += original_size;
+    builder.Finish(buffer);
+
+    // EstimateSize() must stay consistent with Finish() while tuning.
+    ASSERT_EQ(buffer.size(), estimated_size);
+
+    Slice s(buffer);
+    DataBlockHashIndex index;
+    uint16_t map_offset;
+    index.Initialize(s.data(), static_cast<uint16_t>(s.size()), &map_offset);
+    size_t num_buckets = s.size() - sizeof(uint16_t) - map_offset;
+    if (block == 0) {
+      first_num_buckets = num_buckets;
+    }
+    last_num_buckets = num_buckets;
+    builder.Reset();
+  }
+  ASSERT_GT(last_num_buckets, first_num_buckets);
+}
+
+TEST(DataBlockHashIndex, DataBlockHashTestMultiLookup) {
+  DataBlockHashIndexBuilder builder;
+  builder.Initialize(0.75 /*util_ratio*/);
+
+  std::vector<std::string> keys;
+  for (uint8_t i = 0; i < 100; i++) {
+    keys.emplace_back("key" + std::to_string(i));
+    builder.Add(keys.back(), i /*restart_point*/);
+  }
+
+  std::string buffer("fake content");
+  builder.Finish(buffer);
+
+  Slice s(buffer);
+  DataBlockHashIndex index;
+  uint16_t map_offset;
+  index.Initialize(s.data(), static_cast<uint16_t>(s.size()), &map_offset);
+
+  // The batched probe must agree with the single-key Lookup for every key,
+  // including batch sizes that are not a multiple of the internal chunking.
+  for (size_t num : {1u, 7u, 16u, 33u, 100u}) {
+    std::vector<Slice> slices;
+    for (size_t i = 0; i < num; i++) {
+      slices.emplace_back(keys[i]);
+    }
+    std::vector<uint8_t> entries(num);
+    index.MultiLookup(s.data(), map_offset, slices.data(), num,
+                      entries.data());
+    for (size_t i = 0; i < num; i++) {
+      ASSERT_EQ(entries[i], index.Lookup(s.data(), map_offset, slices[i]));
+    }
+  }
+}
+
 TEST(DataBlockHashIndex, DataBlockHashTestLarge) {
   DataBlockHashIndexBuilder builder;
   builder.Initialize(0.75 /*util_ratio*/);
@@ -33,6 +33,7 @@ namespace ROCKSDB_NAMESPACE {
 
 const uint64_t kNotValid = ULLONG_MAX;
 class FilterPolicy;
+struct TablePinningOptions;
 
 class GetContext;
 using MultiGetRange = MultiGetContext::Range;
@@ -164,7 +165,9 @@ class FilterBlockReader {
     return error_msg;
   }
 
-  virtual Status CacheDependencies(const ReadOptions& /*ro*/, bool /*pin*/) {
+  virtual Status CacheDependencies(const ReadOptions& /*ro*/,
+                                   const TablePinningOptions& /*tpo*/,
+                                   bool /*pin*/) {
     return Status::OK();
   }
 
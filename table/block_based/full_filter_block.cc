@@ -22,6 +22,7 @@
 #include <array>
 
 #include "block_type.h"
+#include "monitoring/cycle_profiler.h"
 #include "monitoring/perf_context_imp.h"
 #include "port/malloc.h"
 #include "port/port.h"
@@ -144,6 +145,7 @@ bool FullFilterBlockReader::KeyMayMatch(const Slice& key, const bool no_io,
                                         GetContext* get_context,
                                         BlockCacheLookupContext* lookup_context,
                                         Env::IOPriority rate_limiter_priority) {
+  CYCLE_PROFILE_GUARD(kCycleStageFilterKeyMayMatch);
   if (!whole_key_filtering()) {
     return true;
   }
@@ -19,6 +19,7 @@
 
 #include "table/block_based/partitioned_filter_block.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "block_cache.h"
@@ -206,6 +207,15 @@ PartitionedFilterBlockReader::PartitionedFilterBlockReader(
     std::unique_ptr<PinnedEntry>&& pinned)
     : FilterBlockReaderCommon(t, std::move(filter_block), std::move(pinned)) {}
 
+PartitionedFilterBlockReader::~PartitionedFilterBlockReader() {
+  if (pinned_partitions_) {
+    table()->UnPinData(std::move(pinned_partitions_));
+  }
+  for (auto& pinned : pinned_hot_partitions_) {
+    table()->UnPinData(std::move(pinned));
+  }
+}
+
 std::unique_ptr<FilterBlockReader> PartitionedFilterBlockReader::Create(
     const BlockBasedTable* table, const ReadOptions& ro,
     const TablePinningOptions& tpo, FilePrefetchBuffer* prefetch_buffer,
@@ -321,7 +331,7 @@ Status PartitionedFilterBlockReader::GetFilterPartitionBlock(
   assert(filter_block);
   assert(filter_block->IsEmpty());
 
-  if (!filter_map_.empty()) {
+  if (filter_map_populated_.load(std::memory_order_acquire)) {
     auto iter = filter_map_.find(fltr_blk_handle.offset());
     // This is a possible scenario since block cache might not have had space
     // for the partition
@@ -329,6 +339,8 @@ Status PartitionedFilterBlockReader::GetFilterPartitionBlock(
       filter_block->SetUnownedValue(iter->second.GetValue());
       return Status::OK();
     }
+  } else if (!partition_heat_.empty()) {
+    RecordPartitionHit(fltr_blk_handle);
   }
 
   ReadOptions read_options;
@@ -472,8 +484,8 @@ size_t PartitionedFilterBlockReader::ApproximateMemoryUsage() const {
 }
 
 // TODO(myabandeh): merge this with the same function in IndexReader
-Status PartitionedFilterBlockReader::CacheDependencies(const ReadOptions& ro,
-                                                       bool pin) {
+Status PartitionedFilterBlockReader::CacheDependencies(
+    const ReadOptions& ro, const TablePinningOptions& tpo, bool pin) {
   assert(table());
 
   const BlockBasedTable::Rep* const rep = table()->get_rep();
@@ -534,6 +546,8 @@ Status PartitionedFilterBlockReader::CacheDependencies(const ReadOptions& ro,
   }
 
   // After prefetch, read the partitions one by one
+  UnorderedMap<uint64_t, CachableEntry<ParsedFullFilterBlock>> map_in_progress;
+  size_t partitions_usage = 0;
   for (biter.SeekToFirst(); biter.Valid(); biter.Next()) {
     handle = biter.value().handle;
 
@@ -552,12 +566,96 @@ Status PartitionedFilterBlockReader::CacheDependencies(const ReadOptions& ro,
     if (block.GetValue() != nullptr) {
       if (block.IsCached()) {
         if (pin) {
-          filter_map_[handle.offset()] = std::move(block);
+          partitions_usage += block.GetValue()->ApproximateMemoryUsage();
+          map_in_progress[handle.offset()] = std::move(block);
+          partition_heat_[handle.offset()].handle = handle;
         }
       }
     }
   }
-  return biter.status();
+  s = biter.status();
+  // The pinned partitions stay in memory for the lifetime of this reader, so
+  // now that their total size is known, let the pinning policy decide whether
+  // to admit them and account for the memory they hold.
+  if (s.ok() && !map_in_progress.empty()) {
+    if (table()->PinData(tpo, TablePinningPolicy::kPartition, partitions_usage,
+                         &pinned_partitions_)) {
+      std::swap(filter_map_, map_in_progress);
+      partition_heat_.clear();
+      filter_map_populated_.store(true, std::memory_order_release);
+    } else {
+      // The full partition set exceeds the pinning budget. Instead of pinning
+      // nothing, count filter probes per partition and pin only the hottest
+      // partitions that do fit the budget once a warm-up period has passed
+      // (see PromoteHotPartitions()). The remaining partitions stay in the
+      // block cache and migrate to the secondary cache on eviction like any
+      // other block.
+      heat_tpo_ = tpo;
+    }
+  } else {
+    partition_heat_.clear();
+  }
+  return s;
+}
+
+void PartitionedFilterBlockReader::RecordPartitionHit(
+    const BlockHandle& handle) const {
+  auto it = partition_heat_.find(handle.offset());
+  if (it != partition_heat_.end()) {
+    it->second.hits.fetch_add(1, std::memory_order_relaxed);
+  }
+  // fetch_add hands out each count exactly once, so exactly one thread runs
+  // the promotion.
+  if (heat_probes_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+      kHeatPromotionProbes) {
+    PromoteHotPartitions();
+  }
+}
+
+void PartitionedFilterBlockReader::PromoteHotPartitions() const {
+  assert(!filter_map_populated_.load(std::memory_order_relaxed));
+
+  // Rank the partitions that saw any traffic, hottest first.
+  std::vector<std::pair<uint64_t, uint64_t>> ranked;  // {hits, offset}
+  ranked.reserve(partition_heat_.size());
+  for (const auto& heat : partition_heat_) {
+    const uint64_t hits = heat.second.hits.load(std::memory_order_relaxed);
+    if (hits > 0) {
+      ranked.emplace_back(hits, heat.first);
+    }
+  }
+  std::sort(ranked.begin(), ranked.end(),
+            std::greater<std::pair<uint64_t, uint64_t>>());
+
+  // Only partitions still resident in the block cache are candidates: a
+  // partition that was evicted despite the warm-up traffic is not hot enough
+  // to pin, and reading it back here would turn a filter probe into an IO.
+  ReadOptions read_options;
+  read_options.read_tier = kBlockCacheTier;
+  BlockCacheLookupContext lookup_context{TableReaderCaller::kPrefetch};
+  for (const auto& candidate : ranked) {
+    const BlockHandle& handle = partition_heat_.at(candidate.second).handle;
+    CachableEntry<ParsedFullFilterBlock> block;
+    Status s = table()->RetrieveBlock(
+        nullptr /* prefetch_buffer */, read_options, handle,
+        UncompressionDict::GetEmptyDict(), &block, nullptr /* get_context */,
+        &lookup_context, /* for_compaction */ false, /* use_cache */ true,
+        /* async_read */ false);
+    if (!s.ok() || block.GetValue() == nullptr || !block.IsCached()) {
+      IGNORE_STATUS_IF_ERROR(s);
+      continue;
+    }
+    std::unique_ptr<PinnedEntry> pinned;
+    if (!table()->PinData(heat_tpo_, TablePinningPolicy::kPartition,
+                          block.GetValue()->ApproximateMemoryUsage(),
+                          &pinned)) {
+      // Budget exhausted; colder partitions would not fit either.
+      break;
+    }
+    pinned_hot_partitions_.emplace_back(std::move(pinned));
+    filter_map_[candidate.second] = std::move(block);
+  }
+  filter_map_populated_.store(true, std::memory_order_release);
 }
 
 const InternalKeyComparator* PartitionedFilterBlockReader::internal_comparator()
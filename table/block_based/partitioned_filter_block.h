@@ -19,10 +19,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "block_cache.h"
 #include "rocksdb/options.h"
@@ -121,6 +123,8 @@ class PartitionedFilterBlockReader
       const BlockBasedTable* t,
       CachableEntry<Block_kFilterPartitionIndex>&& filter_block,
       std::unique_ptr<PinnedEntry>&& pinned);
+  ~PartitionedFilterBlockReader() override;
+
   static std::unique_ptr<FilterBlockReader> Create(
       const BlockBasedTable* table, const ReadOptions& ro,
       const TablePinningOptions& tpo, FilePrefetchBuffer* prefetch_buffer,
@@ -159,6 +163,13 @@ class PartitionedFilterBlockReader
       Env::IOPriority rate_limiter_priority,
       CachableEntry<ParsedFullFilterBlock>* filter_block) const;
 
+  // Heat-aware partial pinning, engaged when the pinning policy refuses to
+  // pin the full partition set at open (see CacheDependencies()). Probes are
+  // counted per partition and, once kHeatPromotionProbes of them have been
+  // seen, the hottest partitions that fit the pinning budget are pinned.
+  void RecordPartitionHit(const BlockHandle& handle) const;
+  void PromoteHotPartitions() const;
+
   using FilterFunction = bool (FullFilterBlockReader::*)(
       const Slice& slice, const bool no_io, const Slice* const const_ikey_ptr,
       GetContext* get_context, BlockCacheLookupContext* lookup_context,
@@ -182,7 +193,8 @@ class PartitionedFilterBlockReader
                          BlockCacheLookupContext* lookup_context,
                          Env::IOPriority rate_limiter_priority,
                          FilterManyFunction filter_function) const;
-  Status CacheDependencies(const ReadOptions& ro, bool pin) override;
+  Status CacheDependencies(const ReadOptions& ro,
+                           const TablePinningOptions& tpo, bool pin) override;
 
   const InternalKeyComparator* internal_comparator() const;
   bool index_key_includes_seq() const;
@@ -190,8 +202,32 @@ class PartitionedFilterBlockReader
 
  protected:
   // For partition blocks pinned in cache. Can be a subset of blocks
-  // in case some fail insertion on attempt to pin.
-  UnorderedMap<uint64_t, CachableEntry<ParsedFullFilterBlock>> filter_map_;
+  // in case some fail insertion on attempt to pin. Only consulted after
+  // filter_map_populated_ has been published, and immutable from then on.
+  mutable UnorderedMap<uint64_t, CachableEntry<ParsedFullFilterBlock>>
+      filter_map_;
+  // Set (release) once filter_map_ is final; readers must load-acquire it
+  // before consulting the map, since the map may be filled by a promotion
+  // that runs concurrently with other filter probes.
+  mutable std::atomic<bool> filter_map_populated_{false};
+  // The pinning policy's record for the partitions held in filter_map_,
+  // so the memory they occupy is accounted for (and capped) by the policy.
+  std::unique_ptr<PinnedEntry> pinned_partitions_;
+
+  // Per-partition probe counters, built at open when heat tracking is
+  // engaged and structurally immutable afterwards (only the counters move).
+  struct PartitionHeat {
+    std::atomic<uint64_t> hits{0};
+    BlockHandle handle;
+  };
+  static constexpr uint64_t kHeatPromotionProbes = 1024;
+  mutable UnorderedMap<uint64_t, PartitionHeat> partition_heat_;
+  mutable std::atomic<uint64_t> heat_probes_{0};
+  // The per-partition policy records for the partitions pinned by
+  // PromoteHotPartitions().
+  mutable std::vector<std::unique_ptr<PinnedEntry>> pinned_hot_partitions_;
+  // The pinning options under which the promotion decides admission.
+  TablePinningOptions heat_tpo_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
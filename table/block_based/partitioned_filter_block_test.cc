@@ -69,6 +69,7 @@ class MyPartitionedFilterBlockReader : public PartitionedFilterBlockReader {
           true /* own_value */);
       filter_map_[offset] = std::move(block);
     }
+    filter_map_populated_.store(true, std::memory_order_release);
   }
 };
 
@@ -8,12 +8,21 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "table/block_based/partitioned_index_iterator.h"
 
+#include "monitoring/cycle_profiler.h"
+
 namespace ROCKSDB_NAMESPACE {
 void PartitionedIndexIterator::Seek(const Slice& target) { SeekImpl(&target); }
 
 void PartitionedIndexIterator::SeekToFirst() { SeekImpl(nullptr); }
 
 void PartitionedIndexIterator::SeekImpl(const Slice* target) {
+  CYCLE_PROFILE_GUARD(kCycleStageIndexSeek);
+  bool is_first_pass = true;
+  if (async_read_in_progress_) {
+    AsyncInitPartitionedIndexBlock(false);
+    is_first_pass = false;
+  }
+
   SavePrevIndexValue();
 
   if (target) {
@@ -27,7 +36,20 @@ void PartitionedIndexIterator::SeekImpl(const Slice* target) {
     return;
   }
 
-  InitPartitionedIndexBlock();
+  if (read_options_.async_io) {
+    if (is_first_pass) {
+      AsyncInitPartitionedIndexBlock(is_first_pass);
+    }
+    if (async_read_in_progress_) {
+      // Status::TryAgain indicates asynchronous request for retrieval of the
+      // index partition has been submitted. So it should return at this point
+      // and Seek should be called again to retrieve the requested partition
+      // and execute the remaining code.
+      return;
+    }
+  } else {
+    InitPartitionedIndexBlock();
+  }
 
   if (target) {
     block_iter_.Seek(*target);
@@ -108,6 +130,59 @@ void PartitionedIndexIterator::InitPartitionedIndexBlock() {
   }
 }
 
+void PartitionedIndexIterator::AsyncInitPartitionedIndexBlock(
+    bool is_first_pass) {
+  BlockHandle partitioned_index_handle = index_iter_->value().handle;
+  bool is_for_compaction =
+      lookup_context_.caller == TableReaderCaller::kCompaction;
+  if (is_first_pass) {
+    if (!block_iter_points_to_real_block_ ||
+        partitioned_index_handle.offset() != prev_block_offset_ ||
+        // if previous attempt of reading the block missed cache, try again
+        block_iter_.status().IsIncomplete()) {
+      if (block_iter_points_to_real_block_) {
+        ResetPartitionedIndexIter();
+      }
+      auto* rep = table_->get_rep();
+      // In case of async_io with Implicit readahead, block_prefetcher_ will
+      // always the create the prefetch buffer by setting no_sequential_checking
+      // = true. Reading through the prefetch buffer keeps the next index
+      // partition being fetched in the background while entries of the
+      // current one are served, so forward scans don't stall at partition
+      // boundaries.
+      block_prefetcher_.PrefetchIfNeeded(
+          rep, partitioned_index_handle, read_options_.readahead_size,
+          is_for_compaction, /*no_sequential_checking=*/read_options_.async_io,
+          read_options_.rate_limiter_priority);
+
+      Status s;
+      table_->NewDataBlockIterator<IndexBlockIter>(
+          read_options_, partitioned_index_handle, &block_iter_,
+          BlockType::kIndex,
+          /*get_context=*/nullptr, &lookup_context_,
+          block_prefetcher_.prefetch_buffer(),
+          /*for_compaction=*/is_for_compaction, /*async_read=*/true, s);
+
+      if (s.IsTryAgain()) {
+        async_read_in_progress_ = true;
+        return;
+      }
+    }
+  } else {
+    // Second pass will call the Poll to get the index partition which has
+    // been requested asynchronously.
+    Status s;
+    table_->NewDataBlockIterator<IndexBlockIter>(
+        read_options_, partitioned_index_handle, &block_iter_,
+        BlockType::kIndex,
+        /*get_context=*/nullptr, &lookup_context_,
+        block_prefetcher_.prefetch_buffer(),
+        /*for_compaction=*/is_for_compaction, /*async_read=*/false, s);
+  }
+  block_iter_points_to_real_block_ = true;
+  async_read_in_progress_ = false;
+}
+
 void PartitionedIndexIterator::FindKeyForward() {
   // This method's code is kept short to make it likely to be inlined.
 
@@ -37,8 +37,8 @@ class PartitionedIndexIterator : public InternalIteratorBase<IndexValue> {
         lookup_context_(caller),
         block_prefetcher_(
             compaction_readahead_size,
-            table_->get_rep()->table_options.initial_auto_readahead_size) {
-  }
+            table_->get_rep()->table_options.initial_auto_readahead_size),
+        async_read_in_progress_(false) {}
 
   ~PartitionedIndexIterator() override {}
 
@@ -76,6 +76,8 @@ class PartitionedIndexIterator : public InternalIteratorBase<IndexValue> {
       return index_iter_->status();
     } else if (block_iter_points_to_real_block_) {
       return block_iter_.status();
+    } else if (async_read_in_progress_) {
+      return Status::TryAgain();
     } else {
       return Status::OK();
     }
@@ -149,10 +151,15 @@ class PartitionedIndexIterator : public InternalIteratorBase<IndexValue> {
   BlockCacheLookupContext lookup_context_;
   BlockPrefetcher block_prefetcher_;
 
+  // True if an asynchronous read of the next index partition has been
+  // submitted and Seek needs to be called again to poll for the result.
+  bool async_read_in_progress_;
+
   // If `target` is null, seek to first.
   void SeekImpl(const Slice* target);
 
   void InitPartitionedIndexBlock();
+  void AsyncInitPartitionedIndexBlock(bool is_first_pass);
   void FindKeyForward();
   void FindBlockForward();
   void FindKeyBackward();
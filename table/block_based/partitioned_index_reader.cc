@@ -134,7 +134,14 @@ InternalIteratorBase<IndexValue>* PartitionIndexReader::NewIterator(
   // the first level iter is always on heap and will attempt to delete it
   // in its destructor.
 }
+PartitionIndexReader::~PartitionIndexReader() {
+  if (pinned_partitions_) {
+    table()->UnPinData(std::move(pinned_partitions_));
+  }
+}
+
 Status PartitionIndexReader::CacheDependencies(const ReadOptions& ro,
+                                               const TablePinningOptions& tpo,
                                                bool pin) {
   if (!partition_map_.empty()) {
     // The dependencies are already cached since `partition_map_` is filled in
@@ -203,6 +210,7 @@ Status PartitionIndexReader::CacheDependencies(const ReadOptions& ro,
 
   // For saving "all or nothing" to partition_map_
   UnorderedMap<uint64_t, CachableEntry<Block>> map_in_progress;
+  size_t partitions_usage = 0;
 
   // After prefetch, read the partitions one by one
   biter.SeekToFirst();
@@ -228,14 +236,22 @@ Status PartitionIndexReader::CacheDependencies(const ReadOptions& ro,
       // compressed (mmap eligible)
       if (block.IsCached() || block.GetOwnValue()) {
         if (pin) {
+          partitions_usage += block.GetValue()->ApproximateMemoryUsage();
           map_in_progress[handle.offset()] = std::move(block);
         }
       }
     }
   }
   Status s = biter.status();
-  // Save (pin) them only if everything checks out
-  if (map_in_progress.size() == partition_count && s.ok()) {
+  // Save (pin) them only if everything checks out. The partitions stay
+  // pinned for the lifetime of this reader, so now that their total decoded
+  // size is known, let the pinning policy decide whether to admit them and
+  // account for the memory they hold. If the policy refuses, the partitions
+  // simply stay in the block cache.
+  if (map_in_progress.size() == partition_count && s.ok() &&
+      !map_in_progress.empty() &&
+      table()->PinData(tpo, TablePinningPolicy::kPartition, partitions_usage,
+                       &pinned_partitions_)) {
     std::swap(partition_map_, map_in_progress);
   }
   return s;
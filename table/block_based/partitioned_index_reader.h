@@ -45,7 +45,10 @@ class PartitionIndexReader : public BlockBasedTable::IndexReaderCommon {
       IndexBlockIter* iter, GetContext* get_context,
       BlockCacheLookupContext* lookup_context) override;
 
-  Status CacheDependencies(const ReadOptions& ro, bool pin) override;
+  ~PartitionIndexReader() override;
+
+  Status CacheDependencies(const ReadOptions& ro,
+                           const TablePinningOptions& tpo, bool pin) override;
   size_t ApproximateMemoryUsage() const override {
     size_t usage = ApproximateIndexBlockMemoryUsage();
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
@@ -67,5 +70,8 @@ class PartitionIndexReader : public BlockBasedTable::IndexReaderCommon {
   // none" so that !partition_map_.empty() can use an iterator expecting
   // all partitions to be saved here.
   UnorderedMap<uint64_t, CachableEntry<Block>> partition_map_;
+  // The pinning policy's record for the partitions held in partition_map_,
+  // so the memory they occupy is accounted for (and capped) by the policy.
+  std::unique_ptr<PinnedEntry> pinned_partitions_;
 };
 }  // namespace ROCKSDB_NAMESPACE
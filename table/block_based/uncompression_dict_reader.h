@@ -38,6 +38,18 @@ struct UncompressionDict;
 // Provides access to the uncompression dictionary regardless of whether
 // it is owned by the reader or stored in the cache, or whether it is pinned
 // in the cache or not.
+//
+// Note on the hot path: when the pinning policy pins the dictionary at table
+// open (TablePinningPolicy::kDictionary, driven by
+// MetadataCacheOptions/pinning_policy), or when
+// cache_index_and_filter_blocks is off, uncompression_dict_ is non-empty and
+// GetOrReadUncompressionDictionary() returns it without touching the block
+// cache. The per-read cache lookup only happens for unpinned dictionaries.
+// The expensive parts of dictionary decompression are likewise paid once,
+// not per read: the digested ZSTD_DDict is built when the UncompressionDict
+// is created (see UncompressionDict in util/compression.h) and lives as long
+// as the pinned/cached entry, and ZSTD decompression contexts come from the
+// per-core CompressionContextCache rather than being set up per block.
 class UncompressionDictReader {
  public:
   static Status Create(
@@ -15,6 +15,7 @@
 
 #include "logging/logging.h"
 #include "memory/memory_allocator.h"
+#include "monitoring/cycle_profiler.h"
 #include "monitoring/perf_context_imp.h"
 #include "rocksdb/compression_type.h"
 #include "rocksdb/env.h"
@@ -32,20 +33,66 @@ namespace ROCKSDB_NAMESPACE {
 inline void BlockFetcher::ProcessTrailerIfPresent() {
   if (footer_.GetBlockTrailerSize() > 0) {
     assert(footer_.GetBlockTrailerSize() == BlockBasedTable::kBlockTrailerSize);
+    compression_type_ =
+        BlockBasedTable::GetBlockCompressionType(slice_.data(), block_size_);
     if (read_options_.verify_checksums) {
-      io_status_ = status_to_io_status(VerifyBlockChecksum(
-          footer_.checksum_type(), slice_.data(), block_size_,
-          file_->file_name(), handle_.offset()));
+      if (footer_.checksum_type() == kXXH3 && compression_type_ == kZSTD &&
+          do_uncompress_ && !cache_options_.persistent_cache) {
+        // Defer verification so that UncompressBlock() can compute the
+        // checksum on each chunk of compressed input as it is decompressed,
+        // reading the block bytes from DRAM once instead of twice. (Not done
+        // with a persistent cache configured, so that only verified blocks
+        // are inserted into it.)
+        fuse_checksum_and_uncompress_ = true;
+      } else {
+        io_status_ = status_to_io_status(VerifyBlockChecksum(
+            footer_.checksum_type(), slice_.data(), block_size_,
+            file_->file_name(), handle_.offset()));
+      }
       RecordTick(ioptions_.stats, BLOCK_CHECKSUM_COMPUTE_COUNT);
     }
-    compression_type_ =
-        BlockBasedTable::GetBlockCompressionType(slice_.data(), block_size_);
   } else {
     // E.g. plain table or cuckoo table
     compression_type_ = kNoCompression;
   }
 }
 
+inline void BlockFetcher::UncompressBlock() {
+  PERF_TIMER_GUARD(block_decompress_time);
+  // compressed page, uncompress, update cache
+  UncompressionContext context(compression_type_);
+  UncompressionInfo info(context, uncompression_dict_, compression_type_);
+  Status s;
+  if (fuse_checksum_and_uncompress_) {
+    fuse_checksum_and_uncompress_ = false;
+    s = VerifyChecksumAndUncompressSerializedBlock(
+        info, slice_.data(), block_size_, contents_, footer_.format_version(),
+        ioptions_, memory_allocator_, file_->file_name(), handle_.offset());
+    if (s.IsNotSupported()) {
+      // Fall back to separate verification and decompression; this also
+      // produces a precise error when the fused path bailed out on corrupt
+      // input.
+      s = VerifyBlockChecksum(footer_.checksum_type(), slice_.data(),
+                              block_size_, file_->file_name(),
+                              handle_.offset());
+      if (s.ok()) {
+        s = UncompressSerializedBlock(info, slice_.data(), block_size_,
+                                      contents_, footer_.format_version(),
+                                      ioptions_, memory_allocator_);
+      }
+    }
+  } else {
+    s = UncompressSerializedBlock(info, slice_.data(), block_size_, contents_,
+                                  footer_.format_version(), ioptions_,
+                                  memory_allocator_);
+  }
+  io_status_ = status_to_io_status(std::move(s));
+#ifndef NDEBUG
+  num_heap_buf_memcpy_++;
+#endif
+  compression_type_ = kNoCompression;
+}
+
 inline bool BlockFetcher::TryGetUncompressBlockFromPersistentCache() {
   if (cache_options_.persistent_cache &&
       !cache_options_.persistent_cache->IsCompressed()) {
@@ -73,7 +120,7 @@ inline bool BlockFetcher::TryGetFromPrefetchBuffer() {
     IOStatus io_s = file_->PrepareIOOptions(read_options_, opts);
     if (io_s.ok()) {
       bool read_from_prefetch_buffer = false;
-      if (read_options_.async_io && !for_compaction_) {
+      if (read_options_.async_io) {
         read_from_prefetch_buffer = prefetch_buffer_->TryReadFromCacheAsync(
             opts, file_, handle_.offset(), block_size_with_trailer_, &slice_,
             &io_s, read_options_.rate_limiter_priority);
@@ -206,7 +253,12 @@ inline void BlockFetcher::CopyBufferToCompressedBuf() {
 // compressed_buf_, otherwise should be in heap_buf_.
 inline void BlockFetcher::GetBlockContents() {
   if (slice_.data() != used_buf_) {
-    // the slice content is not the buffer provided
+    // The file reader returned a pointer to its own memory instead of filling
+    // the scratch buffer - e.g. PosixMmapReadableFile returns a slice straight
+    // into the mapping. Hand the caller an unowned BlockContents referencing
+    // that memory: for uncompressed blocks this is the zero-copy path, the
+    // bytes are never duplicated and cache entries built from these contents
+    // keep referencing the mapping (BlockContents::own_bytes() is false).
     *contents_ = BlockContents(Slice(slice_.data(), block_size_));
   } else {
     // page can be either uncompressed or compressed, the buffer either stack
@@ -236,6 +288,7 @@ inline void BlockFetcher::GetBlockContents() {
 }
 
 IOStatus BlockFetcher::ReadBlockContents() {
+  CYCLE_PROFILE_GUARD(kCycleStageBlockRead);
   if (TryGetUncompressBlockFromPersistentCache()) {
     compression_type_ = kNoCompression;
 #ifndef NDEBUG
@@ -320,17 +373,7 @@ IOStatus BlockFetcher::ReadBlockContents() {
   }
 
   if (do_uncompress_ && compression_type_ != kNoCompression) {
-    PERF_TIMER_GUARD(block_decompress_time);
-    // compressed page, uncompress, update cache
-    UncompressionContext context(compression_type_);
-    UncompressionInfo info(context, uncompression_dict_, compression_type_);
-    io_status_ = status_to_io_status(UncompressSerializedBlock(
-        info, slice_.data(), block_size_, contents_, footer_.format_version(),
-        ioptions_, memory_allocator_));
-#ifndef NDEBUG
-    num_heap_buf_memcpy_++;
-#endif
-    compression_type_ = kNoCompression;
+    UncompressBlock();
   } else {
     GetBlockContents();
   }
@@ -370,18 +413,7 @@ IOStatus BlockFetcher::ReadAsyncBlockContents() {
         used_buf_ = const_cast<char*>(slice_.data());
 
         if (do_uncompress_ && compression_type_ != kNoCompression) {
-          PERF_TIMER_GUARD(block_decompress_time);
-          // compressed page, uncompress, update cache
-          UncompressionContext context(compression_type_);
-          UncompressionInfo info(context, uncompression_dict_,
-                                 compression_type_);
-          io_status_ = status_to_io_status(UncompressSerializedBlock(
-              info, slice_.data(), block_size_, contents_,
-              footer_.format_version(), ioptions_, memory_allocator_));
-#ifndef NDEBUG
-          num_heap_buf_memcpy_++;
-#endif
-          compression_type_ = kNoCompression;
+          UncompressBlock();
         } else {
           GetBlockContents();
         }
@@ -123,6 +123,10 @@ class BlockFetcher {
   bool got_from_prefetch_buffer_ = false;
   CompressionType compression_type_;
   bool for_compaction_ = false;
+  // Set by ProcessTrailerIfPresent() when checksum verification has been
+  // deferred so it can share one pass over the block bytes with
+  // decompression; consumed by UncompressBlock().
+  bool fuse_checksum_and_uncompress_ = false;
 
   // return true if found
   bool TryGetUncompressBlockFromPersistentCache();
@@ -135,6 +139,7 @@ class BlockFetcher {
   // Copy content from used_buf_ to new compressed_buf_.
   void CopyBufferToCompressedBuf();
   void GetBlockContents();
+  void UncompressBlock();
   void InsertCompressedBlockToPersistentCacheIfNeeded();
   void InsertUncompressedBlockToPersistentCacheIfNeeded();
   void ProcessTrailerIfPresent();
@@ -8,12 +8,15 @@
 #include <assert.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "db/dbformat.h"
 #include "file/writable_file_writer.h"
+#include "port/port.h"
 #include "rocksdb/env.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block_builder.h"
@@ -198,9 +201,66 @@ Slice CuckooTableBuilder::GetValue(uint64_t idx) const {
       static_cast<size_t>(value_size_));
 }
 
+inline uint64_t CuckooTableBuilder::GetHash(uint64_t idx,
+                                            uint32_t hash_cnt) const {
+  if (hash_cnt < num_precomputed_hash_func_) {
+    return precomputed_hashes_[static_cast<size_t>(idx) *
+                                   num_precomputed_hash_func_ +
+                               hash_cnt];
+  }
+  return CuckooHash(GetUserKey(idx), hash_cnt, use_module_hash_,
+                    hash_table_size_, identity_as_first_hash_,
+                    get_slice_hash_);
+}
+
+void CuckooTableBuilder::PrecomputeHashes() {
+  num_precomputed_hash_func_ = num_hash_func_;
+  precomputed_hashes_.resize(static_cast<size_t>(num_entries_) *
+                             num_precomputed_hash_func_);
+
+  std::atomic<uint64_t> next_idx(0);
+  constexpr uint64_t kBatchSize = 1024;
+  auto hash_batches_func = [&]() {
+    uint64_t start;
+    while ((start = next_idx.fetch_add(kBatchSize,
+                                       std::memory_order_relaxed)) <
+           num_entries_) {
+      uint64_t end = std::min(start + kBatchSize, num_entries_);
+      for (uint64_t idx = start; idx < end; idx++) {
+        Slice user_key = GetUserKey(idx);
+        for (uint32_t hash_cnt = 0; hash_cnt < num_precomputed_hash_func_;
+             ++hash_cnt) {
+          precomputed_hashes_[static_cast<size_t>(idx) *
+                                  num_precomputed_hash_func_ +
+                              hash_cnt] =
+              CuckooHash(user_key, hash_cnt, use_module_hash_,
+                         hash_table_size_, identity_as_first_hash_,
+                         get_slice_hash_);
+        }
+      }
+    }
+  };
+
+  // Hashing is embarrassingly parallel and dominates the build for large
+  // tables, so fan it out; small tables are not worth the thread spawns.
+  constexpr uint64_t kMinEntriesPerHashThread = 1 << 16;
+  size_t num_threads = static_cast<size_t>(
+      std::min<uint64_t>(std::thread::hardware_concurrency(),
+                         num_entries_ / kMinEntriesPerHashThread));
+  std::vector<port::Thread> hash_threads;
+  for (size_t i = 0; i + 1 < num_threads; i++) {
+    hash_threads.emplace_back(hash_batches_func);
+  }
+  hash_batches_func();
+  for (auto& t : hash_threads) {
+    t.join();
+  }
+}
+
 Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
   buckets->resize(
       static_cast<size_t>(hash_table_size_ + cuckoo_block_size_ - 1));
+  PrecomputeHashes();
   uint32_t make_space_for_key_call_id = 0;
   for (uint32_t vector_idx = 0; vector_idx < num_entries_; vector_idx++) {
     uint64_t bucket_id = 0;
@@ -209,9 +269,7 @@ Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
     Slice user_key = GetUserKey(vector_idx);
     for (uint32_t hash_cnt = 0; hash_cnt < num_hash_func_ && !bucket_found;
          ++hash_cnt) {
-      uint64_t hash_val =
-          CuckooHash(user_key, hash_cnt, use_module_hash_, hash_table_size_,
-                     identity_as_first_hash_, get_slice_hash_);
+      uint64_t hash_val = GetHash(vector_idx, hash_cnt);
       // If there is a collision, check next cuckoo_block_size_ locations for
       // empty locations. While checking, if we reach end of the hash table,
       // stop searching and proceed for next hash function.
@@ -241,9 +299,7 @@ Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
       }
       // We don't really need to rehash the entire table because old hashes are
       // still valid and we only increased the number of hash functions.
-      uint64_t hash_val = CuckooHash(user_key, num_hash_func_, use_module_hash_,
-                                     hash_table_size_, identity_as_first_hash_,
-                                     get_slice_hash_);
+      uint64_t hash_val = GetHash(vector_idx, num_hash_func_);
       ++num_hash_func_;
       for (uint32_t block_idx = 0; block_idx < cuckoo_block_size_;
            ++block_idx, ++hash_val) {
@@ -274,6 +330,9 @@ Status CuckooTableBuilder::Finish() {
           static_cast<uint64_t>(num_entries_ / max_hash_table_ratio_);
     }
     status_ = MakeHashTable(&buckets);
+    // The hash cache is only needed while placing keys.
+    std::vector<uint64_t>().swap(precomputed_hashes_);
+    num_precomputed_hash_func_ = 0;
     if (!status_.ok()) {
       return status_;
     }
@@ -491,9 +550,7 @@ bool CuckooTableBuilder::MakeSpaceForKey(
         (*buckets)[static_cast<size_t>(curr_node.bucket_id)];
     for (uint32_t hash_cnt = 0; hash_cnt < num_hash_func_ && !null_found;
          ++hash_cnt) {
-      uint64_t child_bucket_id = CuckooHash(
-          GetUserKey(curr_bucket.vector_idx), hash_cnt, use_module_hash_,
-          hash_table_size_, identity_as_first_hash_, get_slice_hash_);
+      uint64_t child_bucket_id = GetHash(curr_bucket.vector_idx, hash_cnt);
       // Iterate inside Cuckoo Block.
       for (uint32_t block_idx = 0; block_idx < cuckoo_block_size_;
            ++block_idx, ++child_bucket_id) {
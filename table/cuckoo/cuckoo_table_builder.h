@@ -92,6 +92,13 @@ class CuckooTableBuilder : public TableBuilder {
                        std::vector<CuckooBucket>* buckets, uint64_t* bucket_id);
   Status MakeHashTable(std::vector<CuckooBucket>* buckets);
 
+  // Fills precomputed_hashes_ with the first num_hash_func_ hash values of
+  // every key, hashing in parallel for large tables.
+  void PrecomputeHashes();
+  // Returns the hash_cnt-th hash value of the key at idx, served from
+  // precomputed_hashes_ when available.
+  inline uint64_t GetHash(uint64_t idx, uint32_t hash_cnt) const;
+
   inline bool IsDeletedKey(uint64_t idx) const;
   inline Slice GetKey(uint64_t idx) const;
   inline Slice GetUserKey(uint64_t idx) const;
@@ -129,6 +136,13 @@ class CuckooTableBuilder : public TableBuilder {
   std::string largest_user_key_ = "";
   std::string smallest_user_key_ = "";
 
+  // Hash values of the first num_precomputed_hash_func_ hash functions for
+  // every key, laid out per key. Only populated during Finish() and released
+  // once the hash table is built; hash functions added later during
+  // displacement are computed on demand.
+  std::vector<uint64_t> precomputed_hashes_;
+  uint32_t num_precomputed_hash_func_ = 0;
+
   bool closed_;  // Either Finish() or Abandon() has been called.
 };
 
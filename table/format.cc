@@ -569,6 +569,70 @@ Status UncompressSerializedBlock(const UncompressionInfo& uncompression_info,
                              format_version, ioptions, allocator);
 }
 
+Status VerifyChecksumAndUncompressSerializedBlock(
+    const UncompressionInfo& uncompression_info, const char* data, size_t size,
+    BlockContents* out_contents, uint32_t format_version,
+    const ImmutableOptions& ioptions, MemoryAllocator* allocator,
+    const std::string& file_name, uint64_t offset) {
+  assert(data[size] == static_cast<char>(kZSTD));
+  assert(uncompression_info.type() == kZSTD);
+#if defined(ZSTD) && defined(ZSTD_STREAMING)
+  (void)format_version;  // ZSTD blocks always carry the size prefix
+  StopWatchNano timer(ioptions.clock,
+                      ShouldReportDetailedTime(ioptions.env, ioptions.stats));
+  XXH3_state_t* const state = XXH3_createState();
+  XXH3_64bits_reset(state);
+  size_t uncompressed_size = 0;
+  CacheAllocationPtr ubuf = ZSTD_UncompressWithVisitor(
+      uncompression_info, data, size, &uncompressed_size,
+      [state](const char* chunk, size_t chunk_size) {
+        XXH3_64bits_update(state, chunk, chunk_size);
+      },
+      allocator);
+  const uint64_t digest = XXH3_64bits_digest(state);
+  XXH3_freeState(state);
+  if (!ubuf) {
+    // Let the caller's fallback path distinguish an unsupported build from
+    // corrupt input (re-verifying the checksum on the way).
+    return Status::NotSupported("Streaming ZSTD decompression unavailable");
+  }
+  // As in ComputeBuiltinChecksum for kXXH3, the compression type byte is
+  // folded into the digest of the preceding bytes.
+  const uint32_t computed =
+      ModifyChecksumForLastByte(Lower32of64(digest), data[size]);
+  const uint32_t stored = DecodeFixed32(data + size + 1);
+  if (stored != computed) {
+    return Status::Corruption(
+        "block checksum mismatch: stored = " + std::to_string(stored) +
+        ", computed = " + std::to_string(computed) +
+        ", type = " + std::to_string(kXXH3) + "  in " + file_name +
+        " offset " + std::to_string(offset) + " size " + std::to_string(size));
+  }
+
+  *out_contents = BlockContents(std::move(ubuf), uncompressed_size);
+
+  if (ShouldReportDetailedTime(ioptions.env, ioptions.stats)) {
+    RecordTimeToHistogram(ioptions.stats, DECOMPRESSION_TIMES_NANOS,
+                          timer.ElapsedNanos());
+  }
+  RecordTimeToHistogram(ioptions.stats, BYTES_DECOMPRESSED,
+                        out_contents->data.size());
+  RecordTick(ioptions.stats, NUMBER_BLOCK_DECOMPRESSED);
+  return Status::OK();
+#else
+  (void)uncompression_info;
+  (void)data;
+  (void)size;
+  (void)out_contents;
+  (void)format_version;
+  (void)ioptions;
+  (void)allocator;
+  (void)file_name;
+  (void)offset;
+  return Status::NotSupported("Streaming ZSTD decompression unavailable");
+#endif  // defined(ZSTD) && defined(ZSTD_STREAMING)
+}
+
 // Replace the contents of db_host_id with the actual hostname, if db_host_id
 // matches the keyword kHostnameForDbHostId
 Status ReifyDbHostIdProperty(Env* env, std::string* db_host_id) {
@@ -354,6 +354,21 @@ Status UncompressSerializedBlock(const UncompressionInfo& info,
                                  const ImmutableOptions& ioptions,
                                  MemoryAllocator* allocator = nullptr);
 
+// Fused variant of VerifyBlockChecksum + UncompressSerializedBlock for blocks
+// with a kXXH3 checksum and ZSTD compression: the checksum is computed over
+// each chunk of compressed input as it is handed to the streaming
+// decompressor, so the block bytes are read from DRAM once instead of in two
+// passes. The block trailer (compression type byte and stored checksum) must
+// follow `data + size`. Returns NotSupported when the fused path is
+// unavailable in this build; callers should then fall back to separate
+// verification and decompression, which also produces precise errors for
+// corrupt input.
+Status VerifyChecksumAndUncompressSerializedBlock(
+    const UncompressionInfo& info, const char* data, size_t size,
+    BlockContents* out_contents, uint32_t format_version,
+    const ImmutableOptions& ioptions, MemoryAllocator* allocator,
+    const std::string& file_name, uint64_t offset);
+
 // This is a variant of UncompressSerializedBlock that does not expect a
 // block trailer beyond `size`. (CompressionType is taken from `info`.)
 Status UncompressBlockData(const UncompressionInfo& info, const char* data,
@@ -43,7 +43,8 @@ GetContext::GetContext(
     bool do_merge, SequenceNumber* _max_covering_tombstone_seq,
     SystemClock* clock, SequenceNumber* seq,
     PinnedIteratorsManager* _pinned_iters_mgr, ReadCallback* callback,
-    bool* is_blob_index, uint64_t tracing_get_id, BlobFetcher* blob_fetcher)
+    bool* is_blob_index, uint64_t tracing_get_id, BlobFetcher* blob_fetcher,
+    bool stop_when_should_merge)
     : ucmp_(ucmp),
       merge_operator_(merge_operator),
       logger_(logger),
@@ -62,6 +63,7 @@ GetContext::GetContext(
       pinned_iters_mgr_(_pinned_iters_mgr),
       callback_(callback),
       do_merge_(do_merge),
+      stop_when_should_merge_(stop_when_should_merge),
       is_blob_index_(is_blob_index),
       tracing_get_id_(tracing_get_id),
       blob_fetcher_(blob_fetcher) {
@@ -69,6 +71,24 @@ GetContext::GetContext(
     *seq_ = kMaxSequenceNumber;
   }
   sample_ = should_sample_file_read();
+  save_value_fn_ =
+      SelectSaveValueFn(merge_operator_ != nullptr,
+                        ucmp_->timestamp_size() > 0, is_blob_index_ != nullptr);
+}
+
+GetContext::SaveValueFn GetContext::SelectSaveValueFn(bool have_merge,
+                                                      bool have_timestamp,
+                                                      bool have_blob) {
+  static constexpr SaveValueFn kFns[2][2][2] = {
+      {{&GetContext::SaveValueImpl<false, false, false>,
+        &GetContext::SaveValueImpl<false, false, true>},
+       {&GetContext::SaveValueImpl<false, true, false>,
+        &GetContext::SaveValueImpl<false, true, true>}},
+      {{&GetContext::SaveValueImpl<true, false, false>,
+        &GetContext::SaveValueImpl<true, false, true>},
+       {&GetContext::SaveValueImpl<true, true, false>,
+        &GetContext::SaveValueImpl<true, true, true>}}};
+  return kFns[have_merge][have_timestamp][have_blob];
 }
 
 GetContext::GetContext(const Comparator* ucmp,
@@ -81,12 +101,13 @@ GetContext::GetContext(const Comparator* ucmp,
                        SystemClock* clock, SequenceNumber* seq,
                        PinnedIteratorsManager* _pinned_iters_mgr,
                        ReadCallback* callback, bool* is_blob_index,
-                       uint64_t tracing_get_id, BlobFetcher* blob_fetcher)
+                       uint64_t tracing_get_id, BlobFetcher* blob_fetcher,
+                       bool stop_when_should_merge)
     : GetContext(ucmp, merge_operator, logger, statistics, init_state, user_key,
                  pinnable_val, columns, /*timestamp=*/nullptr, value_found,
                  merge_context, do_merge, _max_covering_tombstone_seq, clock,
                  seq, _pinned_iters_mgr, callback, is_blob_index,
-                 tracing_get_id, blob_fetcher) {}
+                 tracing_get_id, blob_fetcher, stop_when_should_merge) {}
 
 // Called from TableCache::Get and Table::Get when file/block in which
 // key may exist are not there in TableCache/BlockCache respectively. In this
@@ -218,6 +239,16 @@ void GetContext::ReportCounters() {
 bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
                            const Slice& value, bool* matched,
                            Cleanable* value_pinner) {
+  return (this->*save_value_fn_)(parsed_key, value, matched, value_pinner);
+}
+
+template <bool kHaveMerge, bool kHaveTimestamp, bool kHaveBlob>
+bool GetContext::SaveValueImpl(const ParsedInternalKey& parsed_key,
+                               const Slice& value, bool* matched,
+                               Cleanable* value_pinner) {
+  assert(kHaveMerge == (merge_operator_ != nullptr));
+  assert(kHaveTimestamp == (ucmp_->timestamp_size() > 0));
+  assert(kHaveBlob == (is_blob_index_ != nullptr));
   assert(matched);
   assert((state_ != kMerge && parsed_key.type != kTypeMerge) ||
          merge_context_ != nullptr);
@@ -240,8 +271,8 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
       }
     }
 
-    size_t ts_sz = ucmp_->timestamp_size();
-    if (ts_sz > 0 && timestamp_ != nullptr) {
+    if (kHaveTimestamp && timestamp_ != nullptr) {
+      size_t ts_sz = ucmp_->timestamp_size();
       if (!timestamp_->empty()) {
         assert(ts_sz == timestamp_->size());
         // `timestamp` can be set before `SaveValue` is ever called
@@ -286,21 +317,21 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
       case kTypeWideColumnEntity:
         assert(state_ == kNotFound || state_ == kMerge);
         if (type == kTypeBlobIndex) {
-          if (is_blob_index_ == nullptr) {
+          if (!kHaveBlob) {
             // Blob value not supported. Stop.
             state_ = kUnexpectedBlobIndex;
             return false;
           }
         }
 
-        if (is_blob_index_ != nullptr) {
+        if (kHaveBlob) {
           *is_blob_index_ = (type == kTypeBlobIndex);
         }
 
         if (kNotFound == state_) {
           state_ = kFound;
           if (do_merge_) {
-            if (type == kTypeBlobIndex && ucmp_->timestamp_size() != 0) {
+            if (type == kTypeBlobIndex && kHaveTimestamp) {
               ukey_with_ts_found_.PinSelf(parsed_key.user_key);
             }
             if (LIKELY(pinnable_val_ != nullptr)) {
@@ -444,13 +475,22 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
         push_operand(value, value_pinner);
         PERF_COUNTER_ADD(internal_merge_point_lookup_count, 1);
 
-        if (do_merge_ && merge_operator_ != nullptr &&
+        if (kHaveMerge && do_merge_ &&
             merge_operator_->ShouldMerge(
                 merge_context_->GetOperandsDirectionBackward())) {
           state_ = kFound;
           Merge(nullptr);
           return false;
         }
+        if (kHaveMerge && !do_merge_ && stop_when_should_merge_ &&
+            merge_operator_->ShouldMerge(
+                merge_context_->GetOperandsDirectionBackward())) {
+          // Part of GetMergeOperands and the caller asked to stop as soon as
+          // ShouldMerge() is satisfied; the operands gathered so far are the
+          // result.
+          state_ = kFound;
+          return false;
+        }
         return true;
 
       default:
@@ -108,7 +108,8 @@ class GetContext {
              SequenceNumber* seq = nullptr,
              PinnedIteratorsManager* _pinned_iters_mgr = nullptr,
              ReadCallback* callback = nullptr, bool* is_blob_index = nullptr,
-             uint64_t tracing_get_id = 0, BlobFetcher* blob_fetcher = nullptr);
+             uint64_t tracing_get_id = 0, BlobFetcher* blob_fetcher = nullptr,
+             bool stop_when_should_merge = false);
   GetContext(const Comparator* ucmp, const MergeOperator* merge_operator,
              Logger* logger, Statistics* statistics, GetState init_state,
              const Slice& user_key, PinnableSlice* value,
@@ -118,7 +119,8 @@ class GetContext {
              SequenceNumber* seq = nullptr,
              PinnedIteratorsManager* _pinned_iters_mgr = nullptr,
              ReadCallback* callback = nullptr, bool* is_blob_index = nullptr,
-             uint64_t tracing_get_id = 0, BlobFetcher* blob_fetcher = nullptr);
+             uint64_t tracing_get_id = 0, BlobFetcher* blob_fetcher = nullptr,
+             bool stop_when_should_merge = false);
 
   GetContext() = delete;
 
@@ -196,6 +198,20 @@ class GetContext {
   bool GetBlobValue(const Slice& user_key, const Slice& blob_index,
                     PinnableSlice* blob_value);
 
+  // The merge/timestamp/blob branches of SaveValue() are invariant for the
+  // lifetime of a GetContext, but are evaluated for every candidate entry.
+  // SaveValueImpl stamps out one variant per combination; the constructor
+  // picks the matching one once so the per-entry code only contains the
+  // branches that can actually be taken for this Get.
+  template <bool kHaveMerge, bool kHaveTimestamp, bool kHaveBlob>
+  bool SaveValueImpl(const ParsedInternalKey& parsed_key, const Slice& value,
+                     bool* matched, Cleanable* value_pinner);
+
+  using SaveValueFn = bool (GetContext::*)(const ParsedInternalKey&,
+                                           const Slice&, bool*, Cleanable*);
+  static SaveValueFn SelectSaveValueFn(bool have_merge, bool have_timestamp,
+                                       bool have_blob);
+
   const Comparator* ucmp_;
   const MergeOperator* merge_operator_;
   // the merge operations encountered;
@@ -228,11 +244,18 @@ class GetContext {
   // called as part of DB GetMergeOperands API. When it's false merge operators
   // are never merged.
   bool do_merge_;
+  // Only relevant when do_merge_ is false (GetMergeOperands): if true, stop
+  // collecting operands once the merge operator's ShouldMerge() is satisfied.
+  // See GetMergeOperandsOptions::stop_when_should_merge.
+  bool stop_when_should_merge_;
   bool* is_blob_index_;
   // Used for block cache tracing only. A tracing get id uniquely identifies a
   // Get or a MultiGet.
   const uint64_t tracing_get_id_;
   BlobFetcher* blob_fetcher_;
+  // SaveValueImpl variant matching this context's configuration, selected at
+  // construction.
+  SaveValueFn save_value_fn_;
 };
 
 // Call this to replay a log and bring the get_context up to date. The replay
@@ -79,6 +79,20 @@ class InternalIteratorBase : public Cleanable {
   // 'target' contains user timestamp if timestamp is enabled.
   virtual void Seek(const Slice& target) = 0;
 
+  // EXPERIMENTAL
+  // Two-phase Seek used to overlap the I/O of seeks on several iterators
+  // driven by one thread. SeekIssue() starts a Seek(target) and returns true
+  // if it completed inline; when it returns false, some reads were submitted
+  // asynchronously and SeekComplete() must be called (after optionally
+  // issuing seeks on other iterators) to wait for them and finish
+  // positioning. No other method may be called in between. The default
+  // implementation seeks synchronously and never defers.
+  virtual bool SeekIssue(const Slice& target) {
+    Seek(target);
+    return true;
+  }
+  virtual void SeekComplete() {}
+
   // Position at the first key in the source that at or before target
   // The iterator is Valid() after this call iff the source contains
   // an entry that comes at or before target.
@@ -106,6 +106,21 @@ class IteratorWrapperBase {
     iter_->Seek(k);
     Update();
   }
+  // see InternalIteratorBase::SeekIssue(); the cached state is only updated
+  // once the seek completed
+  bool SeekIssue(const Slice& k) {
+    assert(iter_);
+    const bool completed = iter_->SeekIssue(k);
+    if (completed) {
+      Update();
+    }
+    return completed;
+  }
+  void SeekComplete() {
+    assert(iter_);
+    iter_->SeekComplete();
+    Update();
+  }
   void SeekForPrev(const Slice& k) {
     assert(iter_);
     iter_->SeekForPrev(k);
@@ -246,9 +246,28 @@ class MergingIterator : public InternalIterator {
     status_ = Status::OK();
     for (auto& child : children_) {
       child.iter.SeekToFirst();
+      // child.iter.status() is set to Status::TryAgain indicating asynchronous
+      // request for retrieval of data blocks has been submitted. Skip the
+      // child here so that the first block reads of all children overlap;
+      // SeekToFirst() is called again below to retrieve the requested block
+      // and add the child to min heap.
+      if (child.iter.status().IsTryAgain()) {
+        continue;
+      }
       AddToMinHeapOrCheckStatus(&child);
     }
 
+    for (auto& child : children_) {
+      if (child.iter.status().IsTryAgain()) {
+        child.iter.SeekToFirst();
+        {
+          PERF_TIMER_GUARD(seek_min_heap_time);
+          AddToMinHeapOrCheckStatus(&child);
+        }
+        PERF_COUNTER_ADD(number_async_seek, 1);
+      }
+    }
+
     for (size_t i = 0; i < range_tombstone_iters_.size(); ++i) {
       if (range_tombstone_iters_[i]) {
         range_tombstone_iters_[i]->SeekToFirst();
@@ -309,13 +328,27 @@ class MergingIterator : public InternalIterator {
     // first key >= target among children_ that is not covered by any range
     // tombstone.
     SeekImpl(target);
-    FindNextVisibleKey();
+    FinishForwardSeek();
+  }
 
-    direction_ = kForward;
-    {
-      PERF_TIMER_GUARD(seek_min_heap_time);
-      current_ = CurrentForward();
+  bool SeekIssue(const Slice& target) override {
+    SeekImpl(target, 0 /* starting_level */, false /* range_tombstone_reseek */,
+             true /* issue_only */);
+    if (seek_deferred_) {
+      // some child submitted its block read asynchronously; the caller may
+      // issue seeks on other iterators before calling SeekComplete()
+      return false;
     }
+    FinishForwardSeek();
+    return true;
+  }
+
+  void SeekComplete() override {
+    if (!seek_deferred_) {
+      return;
+    }
+    CompleteDeferredSeek();
+    FinishForwardSeek();
   }
 
   void SeekForPrev(const Slice& target) override {
@@ -567,8 +600,28 @@ class MergingIterator : public InternalIterator {
   // @param range_tombstone_reseek Whether target is some range tombstone
   // end, i.e., whether this SeekImpl() call is a part of a "cascading seek".
   // This is used only for recoding relevant perf_context.
+  // @param issue_only If true and some child deferred its read (TryAgain),
+  // return right after the first seek pass with seek_deferred_ set; the
+  // caller must then invoke CompleteDeferredSeek() to finish the seek.
   void SeekImpl(const Slice& target, size_t starting_level = 0,
-                bool range_tombstone_reseek = false);
+                bool range_tombstone_reseek = false, bool issue_only = false);
+
+  // Second seek pass: re-seek the children whose first pass deferred its
+  // read asynchronously (their requested blocks should be in flight by now)
+  // and add them to the min heap.
+  void CompleteDeferredSeek();
+
+  // Finalize a forward seek once all children completed: resolve range
+  // tombstones and position current_.
+  void FinishForwardSeek() {
+    FindNextVisibleKey();
+
+    direction_ = kForward;
+    {
+      PERF_TIMER_GUARD(seek_min_heap_time);
+      current_ = CurrentForward();
+    }
+  }
 
   // Seek to fist key <= target key (internal key) for
   // children_[starting_level:].
@@ -577,6 +630,14 @@ class MergingIterator : public InternalIterator {
 
   bool is_arena_mode_;
   bool prefix_seek_mode_;
+  // Pending state between the two seek passes of SeekImpl(); set when at
+  // least one child returned Status::TryAgain for its first pass, and
+  // consumed by CompleteDeferredSeek().
+  bool seek_deferred_ = false;
+  std::string deferred_seek_target_;
+  // (level, target) pairs for the deferred children; only filled when range
+  // tombstones may have redirected a child's seek target.
+  autovector<std::pair<size_t, std::string>> deferred_prefetched_target_;
   // Which direction is the iterator moving?
   enum Direction : uint8_t { kForward, kReverse };
   Direction direction_;
@@ -745,7 +806,7 @@ class MergingIterator : public InternalIterator {
 // >= `target` and that we pick start/end key that is > `target` to insert to
 // minHeap_.
 void MergingIterator::SeekImpl(const Slice& target, size_t starting_level,
-                               bool range_tombstone_reseek) {
+                               bool range_tombstone_reseek, bool issue_only) {
   // active range tombstones before `starting_level` remain active
   ClearHeaps(false /* clear_active */);
   ParsedInternalKey pik;
@@ -875,10 +936,37 @@ void MergingIterator::SeekImpl(const Slice& target, size_t starting_level,
     }
   }
 
+  // Stash the state for the second seek pass and run it inline unless the
+  // caller asked to defer it; either way the TryAgain children have their
+  // block reads in flight by now.
+  seek_deferred_ = false;
   if (range_tombstone_iters_.empty()) {
     for (auto& child : children_) {
       if (child.iter.status().IsTryAgain()) {
-        child.iter.Seek(target);
+        seek_deferred_ = true;
+        break;
+      }
+    }
+  } else {
+    seek_deferred_ = !prefetched_target.empty();
+  }
+  if (!seek_deferred_) {
+    return;
+  }
+  deferred_seek_target_.assign(target.data(), target.size());
+  deferred_prefetched_target_ = std::move(prefetched_target);
+  if (!issue_only) {
+    CompleteDeferredSeek();
+  }
+}
+
+void MergingIterator::CompleteDeferredSeek() {
+  assert(seek_deferred_);
+  seek_deferred_ = false;
+  if (range_tombstone_iters_.empty()) {
+    for (auto& child : children_) {
+      if (child.iter.status().IsTryAgain()) {
+        child.iter.Seek(deferred_seek_target_);
         {
           PERF_TIMER_GUARD(seek_min_heap_time);
           AddToMinHeapOrCheckStatus(&child);
@@ -887,7 +975,7 @@ void MergingIterator::SeekImpl(const Slice& target, size_t starting_level,
       }
     }
   } else {
-    for (auto& prefetch : prefetched_target) {
+    for (auto& prefetch : deferred_prefetched_target_) {
       // (level, target) pairs
       children_[prefetch.first].iter.Seek(prefetch.second);
       {
@@ -896,6 +984,7 @@ void MergingIterator::SeekImpl(const Slice& target, size_t starting_level,
       }
       PERF_COUNTER_ADD(number_async_seek, 1);
     }
+    deferred_prefetched_target_.clear();
   }
 }
 
@@ -1588,6 +1677,16 @@ void MergingIterator::InitMaxHeap() {
 // these cases, iterators are being advanced, so the minimum key should increase
 // in a finite number of steps.
 inline void MergingIterator::FindNextVisibleKey() {
+  // When there are no range tombstone iterators, the heap contains point
+  // iterators only: no DELETE_RANGE_* keys, no file boundary sentinel keys
+  // (LevelIterator only emits them when it has a range tombstone iterator),
+  // and nothing in active_. Skip the per-key bookkeeping below entirely.
+  if (range_tombstone_iters_.empty()) {
+    assert(active_.empty());
+    assert(minHeap_.empty() ||
+           minHeap_.top()->type == HeapItem::Type::ITERATOR);
+    return;
+  }
   PopDeleteRangeStart();
   // PopDeleteRangeStart() implies heap top is not DELETE_RANGE_START
   // active_ being empty implies no DELETE_RANGE_END in heap.
@@ -1603,6 +1702,11 @@ inline void MergingIterator::FindNextVisibleKey() {
 }
 
 inline void MergingIterator::FindPrevVisibleKey() {
+  // See FindNextVisibleKey().
+  if (range_tombstone_iters_.empty()) {
+    assert(active_.empty());
+    return;
+  }
   PopDeleteRangeEnd();
   // PopDeleteRangeEnd() implies heap top is not DELETE_RANGE_END
   // active_ being empty implies no DELETE_RANGE_START in heap.
@@ -182,8 +182,25 @@ bool NotifyCollectTableCollectorsOnAdd(
     const std::vector<std::unique_ptr<IntTblPropCollector>>& collectors,
     Logger* info_log) {
   bool all_succeeded = true;
+  // The internal key is parsed lazily and at most once, shared by all
+  // collectors, instead of each collector re-parsing it in InternalAdd().
+  ParsedInternalKey ikey;
+  bool ikey_parsed = false;
   for (auto& collector : collectors) {
-    Status s = collector->InternalAdd(key, value, file_size);
+    if (!collector->NeedsInternalAdd()) {
+      continue;
+    }
+    if (!ikey_parsed) {
+      Status pik_status =
+          ParseInternalKey(key, &ikey, false /* log_err_key */);  // TODO
+      if (!pik_status.ok()) {
+        LogPropertiesCollectionError(info_log, "Add" /* method */,
+                                     collector->Name());
+        return false;
+      }
+      ikey_parsed = true;
+    }
+    Status s = collector->InternalAdd(ikey, value, file_size);
     all_succeeded = all_succeeded && s.ok();
     if (!s.ok()) {
       LogPropertiesCollectionError(info_log, "Add" /* method */,
@@ -84,7 +84,8 @@ void LogPropertiesCollectionError(Logger* info_log, const std::string& method,
 // Return value indicates if there is any error occurred; if error occurred,
 // the warning message will be logged.
 // NotifyCollectTableCollectorsOnAdd() triggers the `Add` event for all
-// property collectors.
+// property collectors that need it (IntTblPropCollector::NeedsInternalAdd()).
+// The internal key is parsed at most once and shared by all collectors.
 bool NotifyCollectTableCollectorsOnAdd(
     const Slice& key, const Slice& value, uint64_t file_size,
     const std::vector<std::unique_ptr<IntTblPropCollector>>& collectors,
@@ -8,6 +8,7 @@
 #include <cinttypes>
 
 #include "logging/logging.h"
+#include "port/port.h"
 #include "util/coding.h"
 #include "util/hash.h"
 
@@ -37,6 +38,13 @@ Status PlainTableIndex::InitFromRawData(Slice data) {
   return Status::OK();
 }
 
+void PlainTableIndex::Prefetch(uint32_t prefix_hash) const {
+  if (index_size_ > 0) {
+    int bucket = GetBucketIdFromHash(prefix_hash, index_size_);
+    PREFETCH(index_ + bucket, 0, 3);
+  }
+}
+
 PlainTableIndex::IndexSearchResult PlainTableIndex::GetOffset(
     uint32_t prefix_hash, uint32_t* bucket_value) const {
   int bucket = GetBucketIdFromHash(prefix_hash, index_size_);
@@ -84,6 +84,10 @@ class PlainTableIndex {
   IndexSearchResult GetOffset(uint32_t prefix_hash,
                               uint32_t* bucket_value) const;
 
+  // Hint the CPU to load the hash bucket for `prefix_hash` into cache ahead
+  // of a GetOffset() call with the same hash.
+  void Prefetch(uint32_t prefix_hash) const;
+
   // Initialize data from `index_data`, which points to raw data for
   // index stored in the SST file.
   Status InitFromRawData(Slice index_data);
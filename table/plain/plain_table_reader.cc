@@ -537,6 +537,36 @@ Status PlainTableReader::Next(PlainTableKeyDecoder* decoder, uint32_t* offset,
   return Status::OK();
 }
 
+void PlainTableReader::MultiGet(const ReadOptions& readOptions,
+                                const MultiGetContext::Range* mget_range,
+                                const SliceTransform* prefix_extractor,
+                                bool skip_filters) {
+  // First pass over the batch: issue the bloom word and hash bucket
+  // prefetches for every key up front, so the per-key lookups below overlap
+  // their cache misses instead of stalling on them one at a time.
+  for (auto iter = mget_range->begin(); iter != mget_range->end(); ++iter) {
+    const Slice& target = iter->ikey;
+    if (IsTotalOrderMode()) {
+      if (enable_bloom_) {
+        bloom_.Prefetch(GetSliceHash(ExtractUserKey(target)));
+      }
+      // In total order mode there is a single bucket 0 for all keys.
+      index_.Prefetch(0);
+    } else {
+      uint32_t prefix_hash = GetSliceHash(GetPrefix(target));
+      if (enable_bloom_) {
+        bloom_.Prefetch(prefix_hash);
+      }
+      index_.Prefetch(prefix_hash);
+    }
+  }
+
+  for (auto iter = mget_range->begin(); iter != mget_range->end(); ++iter) {
+    *iter->s = Get(readOptions, iter->ikey, iter->get_context,
+                   prefix_extractor, skip_filters);
+  }
+}
+
 void PlainTableReader::Prepare(const Slice& target) {
   if (enable_bloom_) {
     uint32_t prefix_hash = GetSliceHash(GetPrefix(target));
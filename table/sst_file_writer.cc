@@ -143,6 +143,53 @@ struct SstFileWriter::Rep {
     return AddImpl(user_key_with_ts, value, value_type);
   }
 
+  Status AddBatch(const std::vector<std::pair<Slice, Slice>>& batch) {
+    if (internal_comparator.user_comparator()->timestamp_size() != 0) {
+      return Status::InvalidArgument("Timestamp size mismatch");
+    }
+    if (!builder) {
+      return Status::InvalidArgument("File is not opened");
+    }
+    if (batch.empty()) {
+      return Status::OK();
+    }
+
+    // Validate the whole batch before adding anything, so that a misordered
+    // batch leaves the file untouched.
+    const Comparator* ucmp = internal_comparator.user_comparator();
+    if (file_info.num_entries != 0 &&
+        ucmp->Compare(batch.front().first, file_info.largest_key) <= 0) {
+      return Status::InvalidArgument(
+          "Keys must be added in strict ascending order.");
+    }
+    for (size_t i = 1; i < batch.size(); i++) {
+      if (ucmp->Compare(batch[i].first, batch[i - 1].first) <= 0) {
+        return Status::InvalidArgument(
+            "Keys must be added in strict ascending order.");
+      }
+    }
+
+    if (file_info.num_entries == 0) {
+      file_info.smallest_key.assign(batch.front().first.data(),
+                                    batch.front().first.size());
+    }
+
+    constexpr SequenceNumber sequence_number = 0;
+    for (const auto& kv : batch) {
+      ikey.Set(kv.first, sequence_number, kTypeValue);
+      builder->Add(ikey.Encode(), kv.second);
+    }
+
+    // update file info once for the whole batch
+    file_info.num_entries += batch.size();
+    file_info.largest_key.assign(batch.back().first.data(),
+                                 batch.back().first.size());
+    file_info.file_size = builder->FileSize();
+
+    InvalidatePageCache(false /* closing */).PermitUncheckedError();
+    return Status::OK();
+  }
+
   Status DeleteRangeImpl(const Slice& begin_key, const Slice& end_key) {
     if (!builder) {
       return Status::InvalidArgument("File is not opened");
@@ -374,6 +421,11 @@ Status SstFileWriter::Put(const Slice& user_key, const Slice& timestamp,
   return rep_->Add(user_key, timestamp, value, ValueType::kTypeValue);
 }
 
+Status SstFileWriter::AddBatch(
+    const std::vector<std::pair<Slice, Slice>>& batch) {
+  return rep_->AddBatch(batch);
+}
+
 Status SstFileWriter::Merge(const Slice& user_key, const Slice& value) {
   return rep_->Add(user_key, value, ValueType::kTypeMerge);
 }
@@ -29,10 +29,15 @@ class SstFileWriterPropertiesCollector : public IntTblPropCollector {
                                             SequenceNumber global_seqno)
       : version_(version), global_seqno_(global_seqno) {}
 
-  virtual Status InternalAdd(const Slice& /*key*/, const Slice& /*value*/,
+  bool NeedsInternalAdd() const override {
+    // Have no interest in collecting stats for individual key/value pairs.
+    return false;
+  }
+
+  virtual Status InternalAdd(const ParsedInternalKey& /*ikey*/,
+                             const Slice& /*value*/,
                              uint64_t /*file_size*/) override {
-    // Intentionally left blank. Have no interest in collecting stats for
-    // individual key/value pairs.
+    // Never called since NeedsInternalAdd() is false.
     return Status::OK();
   }
 
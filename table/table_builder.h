@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -112,6 +113,40 @@ struct TableReaderOptions {
   Cache::ItemOwnerId cache_owner_id = Cache::kUnknownItemOwnerId;
 };
 
+// Holds the compression dictionary trained by the first output file of a
+// compaction so later output files of the same job reuse it instead of
+// buffering and training their own (see
+// CompressionOptions::shared_dict_per_compaction). Thread-safe because the
+// subcompactions of one job may build output files concurrently.
+class SharedCompressionDict {
+ public:
+  // Returns true and sets `*dict` if a trained dictionary is available.
+  bool GetDict(std::string* dict) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!trained_) {
+      return false;
+    }
+    *dict = dict_;
+    return true;
+  }
+
+  // Publishes a trained dictionary. The first publisher wins; a concurrent
+  // subcompaction that finished training before a shared dictionary became
+  // available keeps the one it trained for its own file.
+  void SetDict(const std::string& dict) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!trained_) {
+      dict_ = dict;
+      trained_ = true;
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  bool trained_ = false;
+  std::string dict_;
+};
+
 struct TableBuilderOptions {
   TableBuilderOptions(
       const ImmutableOptions& _ioptions, const MutableCFOptions& _moptions,
@@ -174,6 +209,9 @@ struct TableBuilderOptions {
   // want to skip filters, that should be (for example) null filter_policy
   // in the table options of the ioptions.table_factory
   bool skip_filters = false;
+  // When set, the builder reuses (or contributes) a compression dictionary
+  // shared across the output files of one compaction.
+  std::shared_ptr<SharedCompressionDict> compression_dict_share;
   const uint64_t cur_file_num;
 };
 
@@ -11,7 +11,7 @@
 
 std::vector<std::string> rocksdb_kill_exclude_prefixes;
 
-#ifndef NDEBUG
+#ifndef ROCKSDB_SYNC_POINTS_EXCLUDED
 namespace ROCKSDB_NAMESPACE {
 
 SyncPoint* SyncPoint::GetInstance() {
@@ -55,12 +55,13 @@ void SyncPoint::Process(const Slice& point, void* cb_arg) {
 }
 
 }  // namespace ROCKSDB_NAMESPACE
-#endif  // NDEBUG
+#endif  // !ROCKSDB_SYNC_POINTS_EXCLUDED
 
 namespace ROCKSDB_NAMESPACE {
 void SetupSyncPointsToMockDirectIO() {
-#if !defined(NDEBUG) && !defined(OS_MACOSX) && !defined(OS_WIN) && \
-    !defined(OS_SOLARIS) && !defined(OS_AIX) && !defined(OS_OPENBSD)
+#if !defined(ROCKSDB_SYNC_POINTS_EXCLUDED) && !defined(OS_MACOSX) && \
+    !defined(OS_WIN) && !defined(OS_SOLARIS) && !defined(OS_AIX) &&  \
+    !defined(OS_OPENBSD)
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
       "NewWritableFile:O_DIRECT", [&](void* arg) {
         int* val = static_cast<int*>(arg);
@@ -15,11 +15,28 @@
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/slice.h"
 
-#ifdef NDEBUG
-// empty in release build
+// Sync points (and the kill points built alongside them) are compiled into
+// debug builds and compiled out of release (NDEBUG) builds, where every call
+// site would otherwise cost an atomic load and block inlining. The default
+// can be overridden at configure time with cmake -DWITH_SYNC_POINTS=ON|OFF,
+// which defines ENABLE_SYNC_POINTS (compile them into an optimized build,
+// e.g. for fault-injection testing) or DISABLE_SYNC_POINTS (turn the macros
+// into no-ops in a debug build, e.g. for profiling it).
+#if defined(NDEBUG) && !defined(ENABLE_SYNC_POINTS)
+// neither the declarations nor the macros are compiled in
+#define ROCKSDB_SYNC_POINTS_EXCLUDED 1
+#endif
+#if defined(ROCKSDB_SYNC_POINTS_EXCLUDED) || defined(DISABLE_SYNC_POINTS)
+// the declarations may still be compiled in, but the macros are no-ops
+#define ROCKSDB_SYNC_POINT_MACROS_OFF 1
+#endif
+
+#ifdef ROCKSDB_SYNC_POINT_MACROS_OFF
 #define TEST_KILL_RANDOM_WITH_WEIGHT(kill_point, rocksdb_kill_odds_weight)
 #define TEST_KILL_RANDOM(kill_point)
-#else
+#endif
+
+#ifndef ROCKSDB_SYNC_POINTS_EXCLUDED
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -43,22 +60,26 @@ struct KillPoint {
   static KillPoint* GetInstance();
 };
 
+#ifndef ROCKSDB_SYNC_POINT_MACROS_OFF
 #define TEST_KILL_RANDOM_WITH_WEIGHT(kill_point, rocksdb_kill_odds_weight) \
   {                                                                        \
     KillPoint::GetInstance()->TestKillRandom(                              \
         kill_point, rocksdb_kill_odds_weight, __FILE__, __LINE__);         \
   }
 #define TEST_KILL_RANDOM(kill_point) TEST_KILL_RANDOM_WITH_WEIGHT(kill_point, 1)
+#endif  // !ROCKSDB_SYNC_POINT_MACROS_OFF
 }  // namespace ROCKSDB_NAMESPACE
 
-#endif
+#endif  // !ROCKSDB_SYNC_POINTS_EXCLUDED
 
-#ifdef NDEBUG
+#ifdef ROCKSDB_SYNC_POINT_MACROS_OFF
 #define TEST_SYNC_POINT(x)
 #define TEST_IDX_SYNC_POINT(x, index)
 #define TEST_SYNC_POINT_CALLBACK(x, y)
 #define INIT_SYNC_POINT_SINGLETONS()
-#else
+#endif
+
+#ifndef ROCKSDB_SYNC_POINTS_EXCLUDED
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -148,12 +169,13 @@ class SyncPoint {
 void SetupSyncPointsToMockDirectIO();
 }  // namespace ROCKSDB_NAMESPACE
 
+#ifndef ROCKSDB_SYNC_POINT_MACROS_OFF
 // Use TEST_SYNC_POINT to specify sync points inside code base.
 // Sync points can have happens-after dependency on other sync points,
 // configured at runtime via SyncPoint::LoadDependency. This could be
 // utilized to re-produce race conditions between threads.
 // See TransactionLogIteratorRace in db_test.cc for an example use case.
-// TEST_SYNC_POINT is no op in release build.
+// TEST_SYNC_POINT is a no op when sync points are compiled out.
 #define TEST_SYNC_POINT(x) \
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->Process(x)
 #define TEST_IDX_SYNC_POINT(x, index)                      \
@@ -163,12 +185,13 @@ void SetupSyncPointsToMockDirectIO();
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->Process(x, y)
 #define INIT_SYNC_POINT_SINGLETONS() \
   (void)ROCKSDB_NAMESPACE::SyncPoint::GetInstance();
-#endif  // NDEBUG
+#endif  // !ROCKSDB_SYNC_POINT_MACROS_OFF
+#endif  // !ROCKSDB_SYNC_POINTS_EXCLUDED
 
 // Callback sync point for any read IO errors that should be ignored by
 // the fault injection framework
-// Disable in release mode
-#ifdef NDEBUG
+// Disabled when sync points are compiled out
+#ifdef ROCKSDB_SYNC_POINT_MACROS_OFF
 #define IGNORE_STATUS_IF_ERROR(_status_)
 #else
 #define IGNORE_STATUS_IF_ERROR(_status_)            \
@@ -177,4 +200,4 @@ void SetupSyncPointsToMockDirectIO();
       TEST_SYNC_POINT("FaultInjectionIgnoreError"); \
     }                                               \
   }
-#endif  // NDEBUG
+#endif  // ROCKSDB_SYNC_POINT_MACROS_OFF
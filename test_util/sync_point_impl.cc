@@ -5,7 +5,7 @@
 
 #include "test_util/sync_point_impl.h"
 
-#ifndef NDEBUG
+#ifndef ROCKSDB_SYNC_POINTS_EXCLUDED
 namespace ROCKSDB_NAMESPACE {
 KillPoint* KillPoint::GetInstance() {
   static KillPoint kp;
@@ -22,7 +22,7 @@
 
 #pragma once
 
-#ifndef NDEBUG
+#ifndef ROCKSDB_SYNC_POINTS_EXCLUDED
 namespace ROCKSDB_NAMESPACE {
 // A hacky allocator for single use.
 // Arena depends on SyncPoint and create circular dependency.
@@ -93,4 +93,4 @@ struct SyncPoint::Data {
   void Process(const Slice& point, void* cb_arg);
 };
 }  // namespace ROCKSDB_NAMESPACE
-#endif  // NDEBUG
+#endif  // !ROCKSDB_SYNC_POINTS_EXCLUDED
@@ -47,6 +47,7 @@
 #include <condition_variable>
 #include <cstddef>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -80,6 +81,7 @@
 #include "rocksdb/stats_history.h"
 #include "rocksdb/table.h"
 #include "rocksdb/table_pinning_policy.h"
+#include "rocksdb/trace_record_result.h"
 #include "rocksdb/utilities/backup_engine.h"
 #include "rocksdb/utilities/db_ttl.h"
 #include "rocksdb/utilities/object_registry.h"
@@ -543,6 +545,17 @@ DEFINE_double(read_random_exp_range, 0.0,
 
 DEFINE_bool(histogram, false, "Print histogram of operation timings");
 
+DEFINE_string(
+    latency_slo, "",
+    "Comma-separated latency SLO assertions, each formatted as "
+    "<op>:p<percentile>:<micros> (e.g. read:p99:1000,write:p99.9:5000). "
+    "<op> is one of the per-operation histogram names (read, write, seek, "
+    "delete, merge, update, ...). After each benchmark run, every assertion "
+    "is checked against the merged per-operation latency histograms; "
+    "assertions for operation types the benchmark did not perform are "
+    "skipped. If any assertion failed, db_bench exits with a non-zero "
+    "status once all benchmarks complete, so CI runs can gate on latency.");
+
 DEFINE_bool(confidence_interval_only, false,
             "Print 95% confidence interval upper and lower bounds only for "
             "aggregate stats.");
@@ -2606,6 +2619,18 @@ class Stats {
 
   void AddBytes(int64_t n) { bytes_ += n; }
 
+  // Saves the given latency percentile (in micros) of op_type operations in
+  // *latency. Returns false if no operation of this type was recorded.
+  bool GetPercentile(OperationType op_type, double percentile,
+                     double* latency) const {
+    auto it = hist_.find(op_type);
+    if (it == hist_.end()) {
+      return false;
+    }
+    *latency = it->second->Percentile(percentile);
+    return true;
+  }
+
   void Report(const Slice& name) {
     // Pretend at least one op was done in case we are running a benchmark
     // that does not call FinishedOps().
@@ -3673,6 +3698,7 @@ class Benchmark {
     if (!SanityCheck()) {
       ErrorExit("Failed SanityCheck()");
     }
+    ParseLatencySLOs();
 
     if (num_groups > 1) {
       std::string group_title = std::string("Group ") +
@@ -4143,6 +4169,7 @@ class Benchmark {
         CombinedStats combined_stats;
         for (int i = 0; i < num_repeat; i++) {
           Stats stats = RunBenchmark(num_threads, name, method);
+          CheckLatencySLOs(stats, name);
           combined_stats.AddStats(stats);
           if (FLAGS_confidence_interval_only) {
             combined_stats.ReportWithConfidenceIntervals(name);
@@ -4208,6 +4235,10 @@ class Benchmark {
     }
   }
 
+  // Number of -latency_slo assertions that failed so far, accumulated across
+  // all benchmarks (and groups). Used to fail the process exit code.
+  int NumSLOViolations() const { return num_slo_violations_; }
+
  private:
   std::shared_ptr<TimestampEmulator> timestamp_emulator_;
   std::unique_ptr<port::Thread> secondary_update_thread_;
@@ -4254,6 +4285,69 @@ class Benchmark {
     }
   }
 
+  // A single -latency_slo assertion: fail the run if the given latency
+  // percentile of op_type operations exceeds max_micros.
+  struct SLOAssertion {
+    OperationType op_type;
+    double percentile;
+    double max_micros;
+  };
+  std::vector<SLOAssertion> slo_assertions_;
+  int num_slo_violations_ = 0;
+
+  void ParseLatencySLOs() {
+    slo_assertions_.clear();
+    for (const std::string& entry : StringSplit(FLAGS_latency_slo, ',')) {
+      std::vector<std::string> fields = StringSplit(entry, ':');
+      OperationType op_type = kOthers;
+      bool known_op = false;
+      if (fields.size() == 3) {
+        for (const auto& it : OperationTypeString) {
+          if (it.second == fields[0]) {
+            op_type = it.first;
+            known_op = true;
+            break;
+          }
+        }
+      }
+      if (!known_op || fields[1].size() < 2 || fields[1][0] != 'p') {
+        ErrorExit(
+            "Cannot parse latency SLO assertion '%s'. Expecting "
+            "<op>:p<percentile>:<micros>, e.g. read:p99:1000",
+            entry.c_str());
+      }
+      SLOAssertion assertion;
+      assertion.op_type = op_type;
+      assertion.percentile = std::stod(fields[1].substr(1));
+      assertion.max_micros = std::stod(fields[2]);
+      if (assertion.percentile <= 0.0 || assertion.percentile >= 100.0) {
+        ErrorExit("Latency SLO percentile in '%s' must be in (0, 100)",
+                  entry.c_str());
+      }
+      slo_assertions_.push_back(assertion);
+    }
+  }
+
+  void CheckLatencySLOs(const Stats& stats, const Slice& name) {
+    for (const auto& assertion : slo_assertions_) {
+      double latency;
+      if (!stats.GetPercentile(assertion.op_type, assertion.percentile,
+                               &latency)) {
+        // This benchmark did not perform operations of this type.
+        continue;
+      }
+      if (latency > assertion.max_micros) {
+        fprintf(stderr,
+                "SLO VIOLATION in %s: %s p%g latency %.1f micros exceeds "
+                "%.1f micros\n",
+                name.ToString().c_str(),
+                OperationTypeString[assertion.op_type].c_str(),
+                assertion.percentile, latency, assertion.max_micros);
+        num_slo_violations_++;
+      }
+    }
+  }
+
   Stats RunBenchmark(int n, Slice name,
                      void (Benchmark::*method)(ThreadState*)) {
     SharedState shared;
@@ -9215,6 +9309,68 @@ class Benchmark {
   }
 
 
+  // Collects the per-operation execution latencies reported through
+  // Replayer::Replay()'s result callback and prints one latency histogram
+  // per operation type once the replay finishes. Replay() dispatches each
+  // trace record at its original (scaled) timestamp without waiting for the
+  // previous one to complete, so with multiple replay threads these
+  // histograms include any queueing delay caused by the replayed workload.
+  class ReplayLatencyCollector : public TraceRecordResult::Handler {
+   public:
+    Status Handle(const StatusOnlyTraceExecutionResult& result) override {
+      AddLatency(result);
+      return Status::OK();
+    }
+    Status Handle(const SingleValueTraceExecutionResult& result) override {
+      AddLatency(result);
+      return Status::OK();
+    }
+    Status Handle(const MultiValuesTraceExecutionResult& result) override {
+      AddLatency(result);
+      return Status::OK();
+    }
+    Status Handle(const IteratorTraceExecutionResult& result) override {
+      AddLatency(result);
+      return Status::OK();
+    }
+
+    void Report() {
+      std::lock_guard<std::mutex> guard(mutex_);
+      for (const auto& it : histograms_) {
+        fprintf(stdout, "Replayed %s latency (micros):\n%s\n",
+                TraceTypeName(it.first), it.second.ToString().c_str());
+      }
+    }
+
+   private:
+    void AddLatency(const TraceExecutionResult& result) {
+      // The replay threads report results concurrently; the mutex protects
+      // the map structure (HistogramImpl::Add() itself is thread-safe).
+      std::lock_guard<std::mutex> guard(mutex_);
+      histograms_[result.GetTraceType()].Add(result.GetLatency());
+    }
+
+    static const char* TraceTypeName(TraceType type) {
+      switch (type) {
+        case kTraceWrite:
+          return "write";
+        case kTraceGet:
+          return "get";
+        case kTraceIteratorSeek:
+          return "iterator Seek";
+        case kTraceIteratorSeekForPrev:
+          return "iterator SeekForPrev";
+        case kTraceMultiGet:
+          return "multiget";
+        default:
+          return "unknown operation";
+      }
+    }
+
+    std::mutex mutex_;
+    std::map<TraceType, HistogramImpl> histograms_;
+  };
+
   void Replay(ThreadState* thread) {
     if (IsSingleDb()) {
       Replay(thread, &SingleDb());
@@ -9244,14 +9400,21 @@ class Benchmark {
       fprintf(stderr, "Prepare for replay failed. Error: %s\n",
               s.ToString().c_str());
     }
+    ReplayLatencyCollector latency_collector;
     s = replayer->Replay(
         ReplayOptions(static_cast<uint32_t>(FLAGS_trace_replay_threads),
                       FLAGS_trace_replay_fast_forward),
-        nullptr);
+        [&latency_collector](Status exec_s,
+                             std::unique_ptr<TraceRecordResult>&& result) {
+          if (exec_s.ok() && result != nullptr) {
+            result->Accept(&latency_collector).PermitUncheckedError();
+          }
+        });
     replayer.reset();
     if (s.ok()) {
       fprintf(stdout, "Replay completed from trace_file: %s\n",
               FLAGS_trace_file.c_str());
+      latency_collector.Report();
     } else {
       fprintf(stderr, "Replay failed. Error: %s\n", s.ToString().c_str());
     }
@@ -9712,6 +9875,11 @@ int db_bench_tool_run_group(int group_num, int num_groups, int argc,
       ROCKSDB_NAMESPACE::DumpMallocStats(&stats_string);
       fprintf(stdout, "Malloc stats:\n%s\n", stats_string.c_str());
     }
+    if (benchmark->NumSLOViolations() > 0) {
+      fprintf(stderr, "\n%d latency SLO assertion(s) failed\n",
+              benchmark->NumSLOViolations());
+      return 1;
+    }
   }
 
   return 0;
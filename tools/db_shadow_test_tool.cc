@@ -0,0 +1,242 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef GFLAGS
+#include "tools/db_shadow_test_tool.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/cache.h"
+#include "rocksdb/db.h"
+#include "rocksdb/env.h"
+#include "rocksdb/options.h"
+#include "rocksdb/statistics.h"
+#include "rocksdb/trace_reader_writer.h"
+#include "rocksdb/trace_record_result.h"
+#include "rocksdb/utilities/options_util.h"
+#include "rocksdb/utilities/replayer.h"
+#include "rocksdb/write_buffer_manager.h"
+#include "util/gflags_compat.h"
+
+using GFLAGS_NAMESPACE::ParseCommandLineFlags;
+
+DEFINE_string(trace_file, "", "The trace file to replay against both configs");
+DEFINE_string(db_a, "", "Path of the DB opened with -options_file_a");
+DEFINE_string(db_b, "", "Path of the DB opened with -options_file_b");
+DEFINE_string(options_file_a, "", "OPTIONS file for the first config");
+DEFINE_string(options_file_b, "", "OPTIONS file for the second config");
+DEFINE_string(name_a, "config_a", "Report label for the first config");
+DEFINE_string(name_b, "config_b", "Report label for the second config");
+DEFINE_uint64(write_buffer_manager_bytes, 0,
+              "If > 0, cap each instance's memtable memory with a private "
+              "WriteBufferManager of this many bytes");
+DEFINE_uint64(block_cache_bytes, 0,
+              "If > 0, give each instance a private LRU block cache of this "
+              "many bytes instead of the caches from its OPTIONS file. The "
+              "two instances never share a cache either way, since each "
+              "OPTIONS file is loaded into its own objects");
+DEFINE_uint32(num_threads, 1, "Number of replay threads per instance");
+DEFINE_double(fast_forward, 1.0,
+              "Replay speed relative to the captured trace timing; > 1 "
+              "speeds the replay up");
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+struct ShadowRunResult {
+  std::string name;
+  double seconds = 0.0;
+  uint64_t ops = 0;
+  uint64_t failed = 0;
+  std::shared_ptr<Statistics> stats;
+};
+
+Status RunOneConfig(const std::string& name, const std::string& db_path,
+                    const std::string& options_file, ShadowRunResult* result) {
+  result->name = name;
+  result->stats = CreateDBStatistics();
+
+  ConfigOptions config_opts;
+  DBOptions db_opts;
+  std::vector<ColumnFamilyDescriptor> cf_descs;
+  std::shared_ptr<Cache> cache;
+  Status s;
+  if (FLAGS_block_cache_bytes > 0) {
+    cache = NewLRUCache(FLAGS_block_cache_bytes);
+    s = LoadOptionsFromFile(config_opts, options_file, &db_opts, &cf_descs,
+                            &cache);
+  } else {
+    s = LoadOptionsFromFile(config_opts, options_file, &db_opts, &cf_descs);
+  }
+  if (!s.ok()) {
+    return s;
+  }
+  db_opts.statistics = result->stats;
+  if (FLAGS_write_buffer_manager_bytes > 0) {
+    // A fresh manager per instance so the two configs cannot share (or fight
+    // over) a memtable budget.
+    db_opts.write_buffer_manager =
+        std::make_shared<WriteBufferManager>(FLAGS_write_buffer_manager_bytes);
+  }
+
+  DB* db = nullptr;
+  std::vector<ColumnFamilyHandle*> handles;
+  s = DB::Open(db_opts, db_path, cf_descs, &handles, &db);
+  if (!s.ok()) {
+    return s;
+  }
+
+  Env* env = db_opts.env != nullptr ? db_opts.env : Env::Default();
+  std::unique_ptr<TraceReader> trace_reader;
+  s = NewFileTraceReader(env, EnvOptions(), FLAGS_trace_file, &trace_reader);
+  std::unique_ptr<Replayer> replayer;
+  if (s.ok()) {
+    s = db->NewDefaultReplayer(handles, std::move(trace_reader), &replayer);
+  }
+  if (s.ok()) {
+    s = replayer->Prepare();
+  }
+  if (s.ok()) {
+    std::atomic<uint64_t> ops{0};
+    std::atomic<uint64_t> failed{0};
+    const uint64_t start_micros = env->NowMicros();
+    s = replayer->Replay(
+        ReplayOptions(FLAGS_num_threads, FLAGS_fast_forward),
+        [&ops, &failed](Status exec_s,
+                        std::unique_ptr<TraceRecordResult>&& /*res*/) {
+          ops.fetch_add(1, std::memory_order_relaxed);
+          if (!exec_s.ok() && !exec_s.IsNotSupported()) {
+            failed.fetch_add(1, std::memory_order_relaxed);
+          }
+          exec_s.PermitUncheckedError();
+        });
+    result->seconds = (env->NowMicros() - start_micros) / 1000000.0;
+    result->ops = ops.load(std::memory_order_relaxed);
+    result->failed = failed.load(std::memory_order_relaxed);
+    if (s.IsIncomplete()) {
+      // The whole trace was consumed.
+      s = Status::OK();
+    }
+  }
+
+  for (ColumnFamilyHandle* handle : handles) {
+    db->DestroyColumnFamilyHandle(handle).PermitUncheckedError();
+  }
+  Status close_s = db->Close();
+  delete db;
+  return s.ok() ? close_s : s;
+}
+
+void PrintRow(const char* metric, const std::string& a, const std::string& b) {
+  fprintf(stdout, "%-36s %20s %20s\n", metric, a.c_str(), b.c_str());
+}
+
+std::string FormatDouble(double v) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.1f", v);
+  return buf;
+}
+
+std::string FormatCount(uint64_t v) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%" PRIu64, v);
+  return buf;
+}
+
+void PrintHistogram(const char* title, Histograms histogram_type,
+                    const ShadowRunResult& a, const ShadowRunResult& b) {
+  HistogramData ha;
+  HistogramData hb;
+  a.stats->histogramData(histogram_type, &ha);
+  b.stats->histogramData(histogram_type, &hb);
+  fprintf(stdout, "%s (micros)\n", title);
+  PrintRow("  count", FormatCount(ha.count), FormatCount(hb.count));
+  PrintRow("  average", FormatDouble(ha.average), FormatDouble(hb.average));
+  PrintRow("  p50", FormatDouble(ha.median), FormatDouble(hb.median));
+  PrintRow("  p95", FormatDouble(ha.percentile95),
+           FormatDouble(hb.percentile95));
+  PrintRow("  p99", FormatDouble(ha.percentile99),
+           FormatDouble(hb.percentile99));
+  PrintRow("  max", FormatDouble(ha.max), FormatDouble(hb.max));
+}
+
+void PrintReport(const ShadowRunResult& a, const ShadowRunResult& b) {
+  fprintf(stdout, "\n");
+  PrintRow("Metric", a.name, b.name);
+  fprintf(stdout, "\n");
+  PrintRow("replay wall time (sec)", FormatDouble(a.seconds),
+           FormatDouble(b.seconds));
+  PrintRow("ops replayed", FormatCount(a.ops), FormatCount(b.ops));
+  PrintRow("throughput (ops/sec)",
+           FormatDouble(a.seconds > 0 ? a.ops / a.seconds : 0),
+           FormatDouble(b.seconds > 0 ? b.ops / b.seconds : 0));
+  PrintRow("failed ops", FormatCount(a.failed), FormatCount(b.failed));
+  PrintRow("stall time (micros)",
+           FormatCount(a.stats->getTickerCount(STALL_MICROS)),
+           FormatCount(b.stats->getTickerCount(STALL_MICROS)));
+  fprintf(stdout, "\n");
+  PrintHistogram("db.get latency", DB_GET, a, b);
+  PrintHistogram("db.write latency", DB_WRITE, a, b);
+  PrintHistogram("db.multiget latency", DB_MULTIGET, a, b);
+  PrintHistogram("sst read", SST_READ_MICROS, a, b);
+  PrintHistogram("write stall", WRITE_STALL, a, b);
+}
+
+}  // namespace
+
+int db_shadow_test_tool(int argc, char** argv) {
+  GFLAGS_NAMESPACE::SetUsageMessage(
+      std::string("\nUSAGE:\n") + std::string(argv[0]) +
+      " -trace_file=<trace> -db_a=<path> -options_file_a=<OPTIONS>"
+      " -db_b=<path> -options_file_b=<OPTIONS> [OPTIONS]...");
+  ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_trace_file.empty() || FLAGS_db_a.empty() || FLAGS_db_b.empty() ||
+      FLAGS_options_file_a.empty() || FLAGS_options_file_b.empty()) {
+    fprintf(stderr,
+            "trace_file, db_a, db_b, options_file_a and options_file_b are "
+            "all required\n");
+    return 1;
+  }
+
+  ShadowRunResult result_a;
+  Status s =
+      RunOneConfig(FLAGS_name_a, FLAGS_db_a, FLAGS_options_file_a, &result_a);
+  if (!s.ok()) {
+    fprintf(stderr, "Replay against %s failed: %s\n", FLAGS_name_a.c_str(),
+            s.ToString().c_str());
+    return 1;
+  }
+
+  ShadowRunResult result_b;
+  s = RunOneConfig(FLAGS_name_b, FLAGS_db_b, FLAGS_options_file_b, &result_b);
+  if (!s.ok()) {
+    fprintf(stderr, "Replay against %s failed: %s\n", FLAGS_name_b.c_str(),
+            s.ToString().c_str());
+    return 1;
+  }
+
+  PrintReport(result_a, result_b);
+  return 0;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#endif  // GFLAGS
@@ -0,0 +1,33 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#ifdef GFLAGS
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Shadow-testing harness: replays one captured trace against two DB
+// instances opened with different OPTIONS files and prints a side-by-side
+// report of throughput, latency histograms, stall time and SST read times,
+// so "would config B beat config A" can be answered without a cluster
+// experiment. Each instance gets its own statistics object, its own
+// WriteBufferManager and (optionally) its own block cache, so the two runs
+// never share memory budgets.
+int db_shadow_test_tool(int argc, char** argv);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#endif  // GFLAGS
@@ -1243,9 +1243,52 @@ void CompactorCommand::DoCommand() {
 }
 
 // ---------------------------------------------------------------------------
+namespace {
+
+// Binary dump/load stream format: each record is a fixed32 (little endian)
+// key length, the raw key bytes, a fixed32 value length and the raw value
+// bytes. Compared to the textual format this avoids hex encoding and line
+// parsing, and is safe for arbitrary key and value bytes.
+void WriteLengthPrefixedKeyValue(const Slice& key, const Slice& value) {
+  char len_buf[sizeof(uint32_t)];
+  EncodeFixed32(len_buf, static_cast<uint32_t>(key.size()));
+  fwrite(len_buf, sizeof(len_buf), 1, stdout);
+  fwrite(key.data(), 1, key.size(), stdout);
+  EncodeFixed32(len_buf, static_cast<uint32_t>(value.size()));
+  fwrite(len_buf, sizeof(len_buf), 1, stdout);
+  fwrite(value.data(), 1, value.size(), stdout);
+}
+
+// Read one length-prefixed string from `is` into `out`. Returns false when no
+// full string could be read; `clean_eof`, when non-nullptr, is set to true if
+// the stream ended without any leftover bytes.
+bool ReadLengthPrefixedString(std::istream* is, std::string* out,
+                              bool* clean_eof) {
+  char len_buf[sizeof(uint32_t)];
+  is->read(len_buf, sizeof(len_buf));
+  if (is->gcount() != sizeof(len_buf)) {
+    if (clean_eof != nullptr) {
+      *clean_eof = (is->gcount() == 0 && is->eof());
+    }
+    return false;
+  }
+  uint32_t len = DecodeFixed32(len_buf);
+  out->resize(len);
+  if (len > 0) {
+    is->read(&(*out)[0], len);
+    if (static_cast<uint32_t>(is->gcount()) != len) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 const std::string DBLoaderCommand::ARG_DISABLE_WAL = "disable_wal";
 const std::string DBLoaderCommand::ARG_BULK_LOAD = "bulk_load";
 const std::string DBLoaderCommand::ARG_COMPACT = "compact";
+const std::string DBLoaderCommand::ARG_BINARY = "binary";
 
 DBLoaderCommand::DBLoaderCommand(
     const std::vector<std::string>& /*params*/,
@@ -1255,14 +1298,16 @@ DBLoaderCommand::DBLoaderCommand(
           options, flags, false,
           BuildCmdLineOptions({ARG_HEX, ARG_KEY_HEX, ARG_VALUE_HEX, ARG_FROM,
                                ARG_TO, ARG_CREATE_IF_MISSING, ARG_DISABLE_WAL,
-                               ARG_BULK_LOAD, ARG_COMPACT})),
+                               ARG_BULK_LOAD, ARG_COMPACT, ARG_BINARY})),
       disable_wal_(false),
       bulk_load_(false),
-      compact_(false) {
+      compact_(false),
+      binary_(false) {
   create_if_missing_ = IsFlagPresent(flags, ARG_CREATE_IF_MISSING);
   disable_wal_ = IsFlagPresent(flags, ARG_DISABLE_WAL);
   bulk_load_ = IsFlagPresent(flags, ARG_BULK_LOAD);
   compact_ = IsFlagPresent(flags, ARG_COMPACT);
+  binary_ = IsFlagPresent(flags, ARG_BINARY);
 }
 
 void DBLoaderCommand::Help(std::string& ret) {
@@ -1272,6 +1317,8 @@ void DBLoaderCommand::Help(std::string& ret) {
   ret.append(" [--" + ARG_DISABLE_WAL + "]");
   ret.append(" [--" + ARG_BULK_LOAD + "]");
   ret.append(" [--" + ARG_COMPACT + "]");
+  ret.append(" [--" + ARG_BINARY + " : read the length-prefixed binary");
+  ret.append(" format produced by dump --" + ARG_BINARY + "]");
   ret.append("\n");
 }
 
@@ -1300,17 +1347,36 @@ void DBLoaderCommand::DoCommand() {
   std::ifstream ifs_stdin("/dev/stdin");
   std::istream* istream_p = ifs_stdin.is_open() ? &ifs_stdin : &std::cin;
   Status s;
-  while (s.ok() && getline(*istream_p, line, '\n')) {
-    std::string key;
-    std::string value;
-    if (ParseKeyValue(line, &key, &value, is_key_hex_, is_value_hex_)) {
+  if (binary_) {
+    while (s.ok()) {
+      std::string key;
+      std::string value;
+      bool clean_eof = false;
+      if (!ReadLengthPrefixedString(istream_p, &key, &clean_eof)) {
+        if (!clean_eof) {
+          bad_lines++;  // truncated record
+        }
+        break;
+      }
+      if (!ReadLengthPrefixedString(istream_p, &value, nullptr)) {
+        bad_lines++;  // truncated record
+        break;
+      }
       s = db_->Put(write_options, GetCfHandle(), Slice(key), Slice(value));
-    } else if (0 == line.find("Keys in range:")) {
-      // ignore this line
-    } else if (0 == line.find("Created bg thread 0x")) {
-      // ignore this line
-    } else {
-      bad_lines++;
+    }
+  } else {
+    while (s.ok() && getline(*istream_p, line, '\n')) {
+      std::string key;
+      std::string value;
+      if (ParseKeyValue(line, &key, &value, is_key_hex_, is_value_hex_)) {
+        s = db_->Put(write_options, GetCfHandle(), Slice(key), Slice(value));
+      } else if (0 == line.find("Keys in range:")) {
+        // ignore this line
+      } else if (0 == line.find("Created bg thread 0x")) {
+        // ignore this line
+      } else {
+        bad_lines++;
+      }
     }
   }
 
@@ -1986,6 +2052,7 @@ const std::string DBDumperCommand::ARG_COUNT_ONLY = "count_only";
 const std::string DBDumperCommand::ARG_COUNT_DELIM = "count_delim";
 const std::string DBDumperCommand::ARG_STATS = "stats";
 const std::string DBDumperCommand::ARG_TTL_BUCKET = "bucket";
+const std::string DBDumperCommand::ARG_BINARY = "binary";
 
 DBDumperCommand::DBDumperCommand(
     const std::vector<std::string>& /*params*/,
@@ -1997,14 +2064,16 @@ DBDumperCommand::DBDumperCommand(
                       ARG_NO_VALUE, ARG_FROM, ARG_TO, ARG_MAX_KEYS,
                       ARG_COUNT_ONLY, ARG_COUNT_DELIM, ARG_STATS, ARG_TTL_START,
                       ARG_TTL_END, ARG_TTL_BUCKET, ARG_TIMESTAMP, ARG_PATH,
-                      ARG_DECODE_BLOB_INDEX, ARG_DUMP_UNCOMPRESSED_BLOBS})),
+                      ARG_DECODE_BLOB_INDEX, ARG_DUMP_UNCOMPRESSED_BLOBS,
+                      ARG_BINARY})),
       null_from_(true),
       null_to_(true),
       max_keys_(-1),
       count_only_(false),
       count_delim_(false),
       print_stats_(false),
-      decode_blob_index_(false) {
+      decode_blob_index_(false),
+      binary_(false) {
   auto itr = options.find(ARG_FROM);
   if (itr != options.end()) {
     null_from_ = false;
@@ -2046,6 +2115,7 @@ DBDumperCommand::DBDumperCommand(
   count_only_ = IsFlagPresent(flags, ARG_COUNT_ONLY);
   decode_blob_index_ = IsFlagPresent(flags, ARG_DECODE_BLOB_INDEX);
   dump_uncompressed_blobs_ = IsFlagPresent(flags, ARG_DUMP_UNCOMPRESSED_BLOBS);
+  binary_ = IsFlagPresent(flags, ARG_BINARY);
 
   if (is_key_hex_) {
     if (!null_from_) {
@@ -2081,6 +2151,8 @@ void DBDumperCommand::Help(std::string& ret) {
   ret.append(" [--" + ARG_PATH + "=<path_to_a_file>]");
   ret.append(" [--" + ARG_DECODE_BLOB_INDEX + "]");
   ret.append(" [--" + ARG_DUMP_UNCOMPRESSED_BLOBS + "]");
+  ret.append(" [--" + ARG_BINARY + " : write raw length-prefixed key/values");
+  ret.append(" for load --" + ARG_BINARY + "]");
   ret.append("\n");
 }
 
@@ -2255,18 +2327,24 @@ void DBDumperCommand::DoDumpCommand() {
     }
 
     if (!count_only_ && !count_delim_) {
-      if (is_db_ttl_ && timestamp_) {
-        fprintf(stdout, "%s ", TimeToHumanString(rawtime).c_str());
-      }
-      if (is_no_value_) {
-        std::string str = is_key_hex_ ? StringToHex(iter->key().ToString())
-                                      : iter->key().ToString();
-        fprintf(stdout, "%s\n", str.c_str());
+      if (binary_) {
+        // Raw length-prefixed records; the hex and timestamp options do not
+        // apply.
+        WriteLengthPrefixedKeyValue(iter->key(), iter->value());
       } else {
-        std::string str =
-            PrintKeyValue(iter->key().ToString(), iter->value().ToString(),
-                          is_key_hex_, is_value_hex_);
-        fprintf(stdout, "%s\n", str.c_str());
+        if (is_db_ttl_ && timestamp_) {
+          fprintf(stdout, "%s ", TimeToHumanString(rawtime).c_str());
+        }
+        if (is_no_value_) {
+          std::string str = is_key_hex_ ? StringToHex(iter->key().ToString())
+                                        : iter->key().ToString();
+          fprintf(stdout, "%s\n", str.c_str());
+        } else {
+          std::string str =
+              PrintKeyValue(iter->key().ToString(), iter->value().ToString(),
+                            is_key_hex_, is_value_hex_);
+          fprintf(stdout, "%s\n", str.c_str());
+        }
       }
     }
   }
@@ -2278,7 +2356,9 @@ void DBDumperCommand::DoDumpCommand() {
     fprintf(stdout, "%s => count:%" PRIu64 "\tsize:%" PRIu64 "\n",
             rtype2.c_str(), c, s2);
   } else {
-    fprintf(stdout, "Keys in range: %" PRIu64 "\n", count);
+    // In binary mode stdout carries the record stream, so the summary goes
+    // to stderr.
+    fprintf(binary_ ? stderr : stdout, "Keys in range: %" PRIu64 "\n", count);
   }
 
   if (count_only_ || print_stats_) {
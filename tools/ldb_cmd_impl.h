@@ -124,11 +124,13 @@ class DBDumperCommand : public LDBCommand {
   std::string path_;
   bool decode_blob_index_;
   bool dump_uncompressed_blobs_;
+  bool binary_;
 
   static const std::string ARG_COUNT_ONLY;
   static const std::string ARG_COUNT_DELIM;
   static const std::string ARG_STATS;
   static const std::string ARG_TTL_BUCKET;
+  static const std::string ARG_BINARY;
 };
 
 class InternalDumpCommand : public LDBCommand {
@@ -183,10 +185,12 @@ class DBLoaderCommand : public LDBCommand {
   bool disable_wal_;
   bool bulk_load_;
   bool compact_;
+  bool binary_;
 
   static const std::string ARG_DISABLE_WAL;
   static const std::string ARG_BULK_LOAD;
   static const std::string ARG_COMPACT;
+  static const std::string ARG_BINARY;
 };
 
 class ManifestDumpCommand : public LDBCommand {
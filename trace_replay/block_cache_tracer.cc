@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <string>
+#include <unordered_set>
 
 #include "db/db_impl/db_impl.h"
 #include "db/dbformat.h"
@@ -506,4 +507,47 @@ std::unique_ptr<BlockCacheTraceWriter> NewBlockCacheTraceWriter(
       clock, trace_options, std::move(trace_writer)));
 }
 
+namespace {
+class BlockCacheTraceStatsCollectorImpl : public BlockCacheTraceStatsCollector {
+ public:
+  Status WriteBlockAccess(const BlockCacheTraceRecord& record,
+                          const Slice& block_key, const Slice& /*cf_name*/,
+                          const Slice& /*referenced_key*/) override {
+    InstrumentedMutexLock lock_guard(&mutex_);
+    stats_.total_accesses++;
+    stats_.accesses_per_caller[record.caller]++;
+    stats_.accesses_per_block_type[record.block_type]++;
+    if (record.is_cache_hit) {
+      stats_.total_hits++;
+      stats_.hits_per_caller[record.caller]++;
+      stats_.hits_per_block_type[record.block_type]++;
+    }
+    if (seen_block_keys_.insert(block_key.ToString()).second) {
+      stats_.distinct_blocks++;
+      stats_.distinct_block_bytes += record.block_size;
+    }
+    return Status::OK();
+  }
+
+  // There is no trace file, so there is no header to write.
+  Status WriteHeader() override { return Status::OK(); }
+
+  BlockCacheTraceStats GetStats() const override {
+    InstrumentedMutexLock lock_guard(&mutex_);
+    return stats_;
+  }
+
+ private:
+  mutable InstrumentedMutex mutex_;
+  BlockCacheTraceStats stats_;
+  std::unordered_set<std::string> seen_block_keys_;
+};
+}  // namespace
+
+std::unique_ptr<BlockCacheTraceStatsCollector>
+NewBlockCacheTraceStatsCollector() {
+  return std::unique_ptr<BlockCacheTraceStatsCollector>(
+      new BlockCacheTraceStatsCollectorImpl());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
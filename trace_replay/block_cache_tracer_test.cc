@@ -412,6 +412,36 @@ TEST_F(BlockCacheTracerTest, HumanReadableTrace) {
   }
 }
 
+TEST_F(BlockCacheTracerTest, StatsCollector) {
+  std::unique_ptr<BlockCacheTraceStatsCollector> collector =
+      NewBlockCacheTraceStatsCollector();
+  ASSERT_OK(collector->WriteHeader());
+  // Two misses on distinct blocks, then a hit on the first block.
+  BlockCacheTraceRecord record = GenerateAccessRecord();
+  ASSERT_OK(collector->WriteBlockAccess(record, record.block_key,
+                                        record.cf_name, record.referenced_key));
+  BlockCacheTraceRecord second_record = GenerateAccessRecord();
+  second_record.block_key = kBlockKeyPrefix + std::to_string(1);
+  second_record.block_size = kBlockSize + 1;
+  ASSERT_OK(collector->WriteBlockAccess(second_record, second_record.block_key,
+                                        second_record.cf_name,
+                                        second_record.referenced_key));
+  record.is_cache_hit = true;
+  ASSERT_OK(collector->WriteBlockAccess(record, record.block_key,
+                                        record.cf_name, record.referenced_key));
+
+  BlockCacheTraceStats stats = collector->GetStats();
+  ASSERT_EQ(3, stats.total_accesses);
+  ASSERT_EQ(1, stats.total_hits);
+  ASSERT_EQ(3, stats.accesses_per_caller[record.caller]);
+  ASSERT_EQ(1, stats.hits_per_caller[record.caller]);
+  ASSERT_EQ(3, stats.accesses_per_block_type[TraceType::kBlockTraceDataBlock]);
+  ASSERT_EQ(1, stats.hits_per_block_type[TraceType::kBlockTraceDataBlock]);
+  // The repeated access to the first block does not grow the working set.
+  ASSERT_EQ(2, stats.distinct_blocks);
+  ASSERT_EQ(kBlockSize + kBlockSize + 1, stats.distinct_block_bytes);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -16,6 +16,7 @@
 #include "rocksdb/trace_reader_writer.h"
 #include "util/coding.h"
 #include "util/hash.h"
+#include "util/math.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -28,10 +29,14 @@ IOTraceWriter::IOTraceWriter(SystemClock* clock,
 
 Status IOTraceWriter::WriteIOOp(const IOTraceRecord& record,
                                 IODebugContext* dbg) {
-  uint64_t trace_file_size = trace_writer_->GetFileSize();
-  if (trace_file_size > trace_options_.max_trace_file_size) {
-    return Status::OK();
-  }
+  std::string encoded_trace;
+  EncodeIOOp(record, dbg, &encoded_trace);
+  return WriteEncoded(encoded_trace);
+}
+
+void IOTraceWriter::EncodeIOOp(const IOTraceRecord& record, IODebugContext* dbg,
+                               std::string* encoded_trace) {
+  assert(encoded_trace);
   Trace trace;
   trace.ts = record.access_timestamp;
   trace.type = record.trace_type;
@@ -51,10 +56,10 @@ Status IOTraceWriter::WriteIOOp(const IOTraceRecord& record,
   // io_op_data one by one and, update corresponsing info in the trace record,
   // unset that bit to find other set bits until io_op_data = 0.
   /* Write remaining options based on io_op_data set by file operation */
-  int64_t io_op_data = static_cast<int64_t>(record.io_op_data);
+  uint64_t io_op_data = record.io_op_data;
   while (io_op_data) {
     // Find the rightmost set bit.
-    uint32_t set_pos = static_cast<uint32_t>(log2(io_op_data & -io_op_data));
+    uint32_t set_pos = static_cast<uint32_t>(CountTrailingZeroBits(io_op_data));
     switch (set_pos) {
       case IOTraceOp::kIOFileSize:
         PutFixed64(&trace.payload, record.file_size);
@@ -72,14 +77,14 @@ Status IOTraceWriter::WriteIOOp(const IOTraceRecord& record,
     io_op_data &= (io_op_data - 1);
   }
 
-  int64_t trace_data = 0;
+  uint64_t trace_data = 0;
   if (dbg) {
-    trace_data = static_cast<int64_t>(dbg->trace_data);
+    trace_data = dbg->trace_data;
   }
   PutFixed64(&trace.payload, trace_data);
   while (trace_data) {
     // Find the rightmost set bit.
-    uint32_t set_pos = static_cast<uint32_t>(log2(trace_data & -trace_data));
+    uint32_t set_pos = static_cast<uint32_t>(CountTrailingZeroBits(trace_data));
     switch (set_pos) {
       case IODebugContext::TraceData::kRequestID: {
         Slice request_id(dbg->request_id);
@@ -92,8 +97,14 @@ Status IOTraceWriter::WriteIOOp(const IOTraceRecord& record,
     trace_data &= (trace_data - 1);
   }
 
-  std::string encoded_trace;
-  TracerHelper::EncodeTrace(trace, &encoded_trace);
+  TracerHelper::EncodeTrace(trace, encoded_trace);
+}
+
+Status IOTraceWriter::WriteEncoded(const std::string& encoded_trace) {
+  uint64_t trace_file_size = trace_writer_->GetFileSize();
+  if (trace_file_size > trace_options_.max_trace_file_size) {
+    return Status::OK();
+  }
   return trace_writer_->Write(encoded_trace);
 }
 
@@ -205,10 +216,10 @@ Status IOTraceReader::ReadIOOp(IOTraceRecord* record) {
   // unset that bit to find other set bits until io_op_data = 0.
   /* Read remaining options based on io_op_data set by file operation */
   // Assuming 63 bits will be used at max.
-  int64_t io_op_data = static_cast<int64_t>(record->io_op_data);
+  uint64_t io_op_data = record->io_op_data;
   while (io_op_data) {
     // Find the rightmost set bit.
-    uint32_t set_pos = static_cast<uint32_t>(log2(io_op_data & -io_op_data));
+    uint32_t set_pos = static_cast<uint32_t>(CountTrailingZeroBits(io_op_data));
     switch (set_pos) {
       case IOTraceOp::kIOFileSize:
         if (!GetFixed64(&enc_slice, &record->file_size)) {
@@ -239,10 +250,10 @@ Status IOTraceReader::ReadIOOp(IOTraceRecord* record) {
     return Status::Incomplete(
         "Incomplete access record: Failed to read trace op.");
   }
-  int64_t trace_data = static_cast<int64_t>(record->trace_data);
+  uint64_t trace_data = record->trace_data;
   while (trace_data) {
     // Find the rightmost set bit.
-    uint32_t set_pos = static_cast<uint32_t>(log2(trace_data & -trace_data));
+    uint32_t set_pos = static_cast<uint32_t>(CountTrailingZeroBits(trace_data));
     switch (set_pos) {
       case IODebugContext::TraceData::kRequestID: {
         Slice request_id;
@@ -290,14 +301,37 @@ void IOTracer::EndIOTrace() {
   tracing_enabled = false;
 }
 
+bool IOTracer::ShouldSample(const IOTraceRecord& record) {
+  if (trace_options_.sampling_frequency <= 1) {
+    return true;
+  }
+  // Sample every sampling_frequency-th record of each operation type
+  // independently, so that infrequent operations (e.g. Sync) are still
+  // represented when reads dominate the workload.
+  const size_t bucket =
+      static_cast<size_t>(Hash64(record.file_operation.data(),
+                                 record.file_operation.size())) %
+      kSamplingBuckets;
+  return sampling_counters_[bucket].fetch_add(1, std::memory_order_relaxed) %
+             trace_options_.sampling_frequency ==
+         0;
+}
+
 void IOTracer::WriteIOOp(const IOTraceRecord& record, IODebugContext* dbg) {
   if (!writer_.load()) {
     return;
   }
+  if (!ShouldSample(record)) {
+    return;
+  }
+  // Serialize the record before taking the mutex so that concurrent IO
+  // threads only contend for the duration of the buffered file append.
+  std::string encoded_trace;
+  IOTraceWriter::EncodeIOOp(record, dbg, &encoded_trace);
   InstrumentedMutexLock lock_guard(&trace_writer_mutex_);
   if (!writer_.load()) {
     return;
   }
-  writer_.load()->WriteIOOp(record, dbg).PermitUncheckedError();
+  writer_.load()->WriteEncoded(encoded_trace).PermitUncheckedError();
 }
 }  // namespace ROCKSDB_NAMESPACE
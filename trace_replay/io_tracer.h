@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <fstream>
 
@@ -112,6 +113,15 @@ class IOTraceWriter {
 
   Status WriteIOOp(const IOTraceRecord& record, IODebugContext* dbg);
 
+  // Serialize an IO operation record into the on-disk trace encoding. Static
+  // and side-effect free so callers can do it without holding any lock.
+  static void EncodeIOOp(const IOTraceRecord& record, IODebugContext* dbg,
+                         std::string* encoded_trace);
+
+  // Append an already-encoded record (from EncodeIOOp) to the trace file,
+  // subject to the max trace file size.
+  Status WriteEncoded(const std::string& encoded_trace);
+
   // Write a trace header at the beginning, typically on initiating a trace,
   // with some metadata like a magic number and RocksDB version.
   Status WriteHeader();
@@ -172,6 +182,14 @@ class IOTracer {
   void WriteIOOp(const IOTraceRecord& record, IODebugContext* dbg);
 
  private:
+  // Apply TraceOptions::sampling_frequency to this record. The counters are
+  // kept per operation type (hashed into a fixed number of buckets) so that
+  // rare operation types remain represented in heavily sampled traces.
+  bool ShouldSample(const IOTraceRecord& record);
+
+  // Number of independent sampling counters; operation-name hash buckets.
+  static constexpr size_t kSamplingBuckets = 64;
+
   TraceOptions trace_options_;
   // A mutex protects the writer_.
   InstrumentedMutex trace_writer_mutex_;
@@ -180,6 +198,8 @@ class IOTracer {
   // variable 'writer_' is nullptr or not in is_tracing_enabled().
   // is_tracing_enabled() is invoked multiple times by FileSystem classes.
   bool tracing_enabled;
+  // See ShouldSample().
+  std::array<std::atomic<uint64_t>, kSamplingBuckets> sampling_counters_{};
 };
 
 }  // namespace ROCKSDB_NAMESPACE
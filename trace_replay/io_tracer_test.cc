@@ -314,6 +314,46 @@ TEST_F(IOTracerTest, AtomicNoWriteAfterEndTrace) {
   }
 }
 
+TEST_F(IOTracerTest, SamplingFrequency) {
+  std::string file_name = kDummyFile + std::to_string(0);
+  {
+    uint64_t io_op_data = 0;
+    io_op_data |= (1 << IOTraceOp::kIOFileSize);
+    IOTraceRecord record(
+        0, TraceType::kIOTracer, io_op_data, GetFileOperation(0), 0 /*latency*/,
+        IOStatus::OK().ToString(), file_name, 10 /*file_size*/);
+    TraceOptions trace_opt;
+    trace_opt.sampling_frequency = 4;
+    std::unique_ptr<TraceWriter> trace_writer;
+    ASSERT_OK(NewFileTraceWriter(env_, env_options_, trace_file_path_,
+                                 &trace_writer));
+    IOTracer writer;
+    ASSERT_OK(writer.StartIOTrace(clock_, trace_opt, std::move(trace_writer)));
+    // With sampling_frequency = 4, only every 4th record of an operation type
+    // should be captured.
+    for (int i = 0; i < 8; i++) {
+      writer.WriteIOOp(record, nullptr);
+    }
+    writer.EndIOTrace();
+    ASSERT_OK(env_->FileExists(trace_file_path_));
+  }
+  {
+    // Verify trace file contains two records.
+    std::unique_ptr<TraceReader> trace_reader;
+    ASSERT_OK(NewFileTraceReader(env_, env_options_, trace_file_path_,
+                                 &trace_reader));
+    IOTraceReader reader(std::move(trace_reader));
+    IOTraceHeader header;
+    ASSERT_OK(reader.ReadHeader(&header));
+    IOTraceRecord access_record;
+    ASSERT_OK(reader.ReadIOOp(&access_record));
+    ASSERT_EQ(access_record.file_operation, GetFileOperation(0));
+    ASSERT_OK(reader.ReadIOOp(&access_record));
+    // No more records.
+    ASSERT_NOK(reader.ReadIOOp(&access_record));
+  }
+}
+
 TEST_F(IOTracerTest, AtomicMultipleWrites) {
   {
     TraceOptions trace_opt;
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
 #ifdef OS_FREEBSD
@@ -1432,6 +1433,95 @@ inline CacheAllocationPtr ZSTD_Uncompress(
 #endif
 }
 
+// Variant of ZSTD_Uncompress that feeds the compressed input to the streaming
+// decompressor in small chunks and invokes `input_visitor` on each chunk right
+// before it is consumed. This lets a streaming checksum read the compressed
+// bytes while they are hot in cache from decompression, instead of in a
+// separate pass over the block. Returns nullptr when streaming decompression
+// is unavailable in this build or decompression fails; callers should fall
+// back to separate verification and ZSTD_Uncompress (which will produce a
+// proper error for corrupt input).
+inline CacheAllocationPtr ZSTD_UncompressWithVisitor(
+    const UncompressionInfo& info, const char* input_data, size_t input_length,
+    size_t* uncompressed_size,
+    const std::function<void(const char*, size_t)>& input_visitor,
+    MemoryAllocator* allocator = nullptr) {
+#ifdef ZSTD_STREAMING
+  const char* const input_start = input_data;
+  uint32_t output_len = 0;
+  if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
+                                            &output_len)) {
+    return nullptr;
+  }
+  // The decompressed-size prefix is covered by the block checksum but is not
+  // part of the ZSTD frame, so visit it up front.
+  if (input_data != input_start) {
+    input_visitor(input_start, static_cast<size_t>(input_data - input_start));
+  }
+
+  ZSTD_DCtx* context = info.context().GetZSTDContext();
+  assert(context != nullptr);
+  ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+  size_t ret = 0;
+#ifdef ROCKSDB_ZSTD_DDICT
+  if (info.dict().GetDigestedZstdDDict() != nullptr) {
+    ret = ZSTD_DCtx_refDDict(context, info.dict().GetDigestedZstdDDict());
+  } else
+#endif  // ROCKSDB_ZSTD_DDICT
+      if (!info.dict().GetRawDict().empty()) {
+    ret = ZSTD_DCtx_loadDictionary_byReference(context,
+                                               info.dict().GetRawDict().data(),
+                                               info.dict().GetRawDict().size());
+  }
+  if (ZSTD_isError(ret)) {
+    ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+    return nullptr;
+  }
+
+  auto output = AllocateBlock(output_len, allocator);
+  ZSTD_outBuffer output_buffer = {output.get(), output_len, /*pos=*/0};
+  // Chunks small enough to stay in L1 between the visitor and the
+  // decompressor.
+  constexpr size_t kChunkSize = 4 * 1024;
+  size_t consumed = 0;
+  while (consumed < input_length) {
+    const size_t chunk_size = std::min(kChunkSize, input_length - consumed);
+    input_visitor(input_data + consumed, chunk_size);
+    ZSTD_inBuffer input_buffer = {input_data + consumed, chunk_size,
+                                  /*pos=*/0};
+    while (input_buffer.pos < input_buffer.size) {
+      const size_t prev_out_pos = output_buffer.pos;
+      const size_t prev_in_pos = input_buffer.pos;
+      ret = ZSTD_decompressStream(context, &output_buffer, &input_buffer);
+      if (ZSTD_isError(ret) || (output_buffer.pos == prev_out_pos &&
+                                input_buffer.pos == prev_in_pos)) {
+        // Error, or no progress possible (e.g. output buffer exhausted with
+        // input remaining, meaning the size prefix was wrong).
+        ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+        return nullptr;
+      }
+    }
+    consumed += chunk_size;
+  }
+  // Leave the shared context clean for subsequent one-shot use.
+  ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+  if (ret != 0 || output_buffer.pos != output_len) {
+    // Frame incomplete or shorter than the size prefix claimed.
+    return nullptr;
+  }
+  *uncompressed_size = output_buffer.pos;
+  return output;
+#else  // ZSTD_STREAMING
+  (void)info;
+  (void)input_data;
+  (void)input_length;
+  (void)uncompressed_size;
+  (void)input_visitor;
+  (void)allocator;
+  return nullptr;
+#endif  // ZSTD_STREAMING
+}
+
 inline bool ZSTD_TrainDictionarySupported() {
 #ifdef ZSTD
   // Dictionary trainer is available since v0.6.1 for static linking, but not
@@ -0,0 +1,121 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "rocksdb/slice.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A small count-min sketch for estimating key access frequency, intended
+// only to be used in memory (like DynamicBloom, it is never serialized).
+// Supports lock-free concurrent access; counts are approximate in both the
+// usual count-min sense (over-estimates under hash collisions) and because
+// concurrent updates use relaxed atomics.
+//
+// To keep the estimates reflecting *recent* frequency, all counters are
+// halved after every width * depth additions, so a key's count roughly
+// tracks its popularity within the last sampling window rather than since
+// process start.
+class CountMinSketch {
+ public:
+  static constexpr uint32_t kDepth = 4;
+
+  // width: number of counters per row; must be a power of two.
+  explicit CountMinSketch(uint32_t width = 8192)
+      : width_(width),
+        width_mask_(width - 1),
+        decay_limit_(static_cast<uint64_t>(width) * kDepth),
+        counters_(new std::atomic<uint32_t>[static_cast<size_t>(width) *
+                                            kDepth]) {
+    assert((width & (width - 1)) == 0);
+    for (size_t i = 0; i < static_cast<size_t>(width_) * kDepth; ++i) {
+      counters_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // No copying allowed
+  CountMinSketch(const CountMinSketch&) = delete;
+  void operator=(const CountMinSketch&) = delete;
+
+  // Record one access of `key` and return its updated frequency estimate.
+  // May be called concurrently.
+  uint32_t AddAndEstimate(const Slice& key) {
+    const uint64_t h = GetSliceNPHash64(key);
+    const uint32_t h1 = Lower32of64(h);
+    const uint32_t h2 = Upper32of64(h) | 1;
+    uint32_t estimate = std::numeric_limits<uint32_t>::max();
+    for (uint32_t d = 0; d < kDepth; ++d) {
+      std::atomic<uint32_t>& counter =
+          counters_[d * width_ + ((h1 + d * h2) & width_mask_)];
+      estimate =
+          std::min(estimate, counter.fetch_add(1, std::memory_order_relaxed) +
+                                 1);
+    }
+    if ((adds_.fetch_add(1, std::memory_order_relaxed) + 1) % decay_limit_ ==
+        0) {
+      Decay();
+    }
+    return estimate;
+  }
+
+  // Frequency estimate of `key` without recording an access. May be called
+  // concurrently.
+  uint32_t Estimate(const Slice& key) const {
+    const uint64_t h = GetSliceNPHash64(key);
+    const uint32_t h1 = Lower32of64(h);
+    const uint32_t h2 = Upper32of64(h) | 1;
+    uint32_t estimate = std::numeric_limits<uint32_t>::max();
+    for (uint32_t d = 0; d < kDepth; ++d) {
+      estimate = std::min(
+          estimate, counters_[d * width_ + ((h1 + d * h2) & width_mask_)].load(
+                        std::memory_order_relaxed));
+    }
+    return estimate;
+  }
+
+  uint32_t Width() const { return width_; }
+  uint64_t AddCount() const { return adds_.load(std::memory_order_relaxed); }
+  uint64_t DecayCount() const {
+    return decays_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Halve every counter so estimates age out. Concurrent additions during
+  // the sweep may be lost; that is acceptable for a frequency hint.
+  void Decay() {
+    for (size_t i = 0; i < static_cast<size_t>(width_) * kDepth; ++i) {
+      uint32_t c = counters_[i].load(std::memory_order_relaxed);
+      counters_[i].store(c / 2, std::memory_order_relaxed);
+    }
+    decays_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const uint32_t width_;
+  const uint32_t width_mask_;
+  const uint64_t decay_limit_;
+  std::unique_ptr<std::atomic<uint32_t>[]> counters_;
+  std::atomic<uint64_t> adds_{0};
+  std::atomic<uint64_t> decays_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
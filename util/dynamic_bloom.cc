@@ -67,4 +67,16 @@ DynamicBloom::DynamicBloom(Allocator* allocator, uint32_t total_bits,
   data_ = reinterpret_cast<std::atomic<uint64_t>*>(raw);
 }
 
+bool DynamicBloom::UnionWith(const DynamicBloom& other) {
+  if (kLen != other.kLen || kNumDoubleProbes != other.kNumDoubleProbes) {
+    return false;
+  }
+  for (uint32_t i = 0; i < kLen; ++i) {
+    data_[i].store(data_[i].load(std::memory_order_relaxed) |
+                       other.data_[i].load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+  }
+  return true;
+}
+
 }  // namespace ROCKSDB_NAMESPACE
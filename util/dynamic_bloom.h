@@ -72,6 +72,13 @@ class DynamicBloom {
 
   void Prefetch(uint32_t h);
 
+  // OR the bits of `other` into this filter, making this filter the union of
+  // the two: a key that misses here afterwards misses in `other` as well.
+  // Only possible when both filters share the same geometry (same length and
+  // probe count); returns false, leaving this filter unchanged, otherwise.
+  // Assuming single threaded access to this function.
+  bool UnionWith(const DynamicBloom& other);
+
  private:
   // Length of the structure, in 64-bit words. For this structure, "word"
   // will always refer to 64-bit words.
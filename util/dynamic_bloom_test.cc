@@ -88,6 +88,28 @@ TEST_F(DynamicBloomTest, Small) {
   ASSERT_TRUE(!bloom2.MayContain("foo"));
 }
 
+TEST_F(DynamicBloomTest, UnionWith) {
+  Arena arena;
+  DynamicBloom bloom1(&arena, 1000, 2);
+  DynamicBloom bloom2(&arena, 1000, 2);
+  bloom1.Add("hello");
+  bloom2.Add("world");
+
+  DynamicBloom merged(&arena, 1000, 2);
+  ASSERT_TRUE(merged.UnionWith(bloom1));
+  ASSERT_TRUE(merged.UnionWith(bloom2));
+  ASSERT_TRUE(merged.MayContain("hello"));
+  ASSERT_TRUE(merged.MayContain("world"));
+  ASSERT_TRUE(!merged.MayContain("x"));
+  ASSERT_TRUE(!merged.MayContain("foo"));
+
+  // Union requires matching geometry
+  DynamicBloom bloom3(&arena, 1000 * 100, 2);
+  ASSERT_TRUE(!merged.UnionWith(bloom3));
+  DynamicBloom bloom4(&arena, 1000, 4);
+  ASSERT_TRUE(!merged.UnionWith(bloom4));
+}
+
 TEST_F(DynamicBloomTest, SmallConcurrentAdd) {
   Arena arena;
   DynamicBloom bloom1(&arena, 100, 2);
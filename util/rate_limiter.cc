@@ -48,7 +48,8 @@ struct GenericRateLimiter::Req {
 GenericRateLimiter::GenericRateLimiter(
     int64_t rate_bytes_per_sec, int64_t refill_period_us, int32_t fairness,
     RateLimiter::Mode mode, const std::shared_ptr<SystemClock>& clock,
-    bool auto_tuned)
+    bool auto_tuned, const std::shared_ptr<Statistics>& tuning_stats,
+    uint32_t tuning_latency_histogram, uint64_t tuning_target_latency_micros)
     : RateLimiter(mode),
       refill_period_us_(refill_period_us),
       rate_bytes_per_sec_(auto_tuned ? rate_bytes_per_sec / 2
@@ -61,13 +62,18 @@ GenericRateLimiter::GenericRateLimiter(
       requests_to_wait_(0),
       available_bytes_(0),
       next_refill_us_(NowMicrosMonotonicLocked()),
-      fairness_(fairness > 100 ? 100 : fairness),
+      fairness_(fairness > 100 ? 100 : (fairness < 0 ? 0 : fairness)),
       rnd_((uint32_t)time(nullptr)),
       wait_until_refill_pending_(false),
       auto_tuned_(auto_tuned),
       num_drains_(0),
       max_bytes_per_sec_(rate_bytes_per_sec),
-      tuned_time_(NowMicrosMonotonicLocked()) {
+      tuned_time_(NowMicrosMonotonicLocked()),
+      tuning_stats_(tuning_stats),
+      tuning_latency_histogram_(tuning_latency_histogram),
+      tuning_target_latency_micros_(tuning_target_latency_micros),
+      tuning_latency_prev_count_(0),
+      tuning_latency_prev_sum_(0) {
   for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
     total_requests_[i] = 0;
     total_bytes_through_[i] = 0;
@@ -226,12 +232,16 @@ GenericRateLimiter::GeneratePriorityIterationOrderLocked() {
   // first
   pri_iteration_order[0] = Env::IO_USER;
 
-  bool high_pri_iterated_after_mid_low_pri = rnd_.OneIn(fairness_);
+  // fairness_ == 0 means strict priority order: lower-priority queues never
+  // win the lottery over higher-priority ones.
+  bool high_pri_iterated_after_mid_low_pri =
+      fairness_ > 0 && rnd_.OneIn(fairness_);
   TEST_SYNC_POINT_CALLBACK(
       "GenericRateLimiter::GeneratePriorityIterationOrderLocked::"
       "PostRandomOneInFairnessForHighPri",
       &high_pri_iterated_after_mid_low_pri);
-  bool mid_pri_itereated_after_low_pri = rnd_.OneIn(fairness_);
+  bool mid_pri_itereated_after_low_pri =
+      fairness_ > 0 && rnd_.OneIn(fairness_);
   TEST_SYNC_POINT_CALLBACK(
       "GenericRateLimiter::GeneratePriorityIterationOrderLocked::"
       "PostRandomOneInFairnessForMidPri",
@@ -312,6 +322,9 @@ int64_t GenericRateLimiter::CalculateRefillBytesPerPeriodLocked(
 }
 
 Status GenericRateLimiter::TuneLocked() {
+  if (tuning_stats_ != nullptr) {
+    return TuneByLatencyLocked();
+  }
   const int kLowWatermarkPct = 50;
   const int kHighWatermarkPct = 90;
   const int kAdjustFactorPct = 5;
@@ -361,6 +374,55 @@ Status GenericRateLimiter::TuneLocked() {
   return Status::OK();
 }
 
+Status GenericRateLimiter::TuneByLatencyLocked() {
+  const int kAdjustFactorPct = 5;
+  const int kCutFactorPct = 10;
+  const int kHeadroomWatermarkPct = 75;
+  // computed rate limit will be in
+  // `[max_bytes_per_sec_ / kAllowedRangeFactor, max_bytes_per_sec_]`.
+  const int kAllowedRangeFactor = 20;
+
+  tuned_time_ = std::chrono::microseconds(NowMicrosMonotonicLocked());
+  num_drains_ = 0;
+
+  HistogramData histogram;
+  tuning_stats_->histogramData(tuning_latency_histogram_, &histogram);
+  const uint64_t interval_count = histogram.count - tuning_latency_prev_count_;
+  const uint64_t interval_sum = histogram.sum - tuning_latency_prev_sum_;
+  tuning_latency_prev_count_ = histogram.count;
+  tuning_latency_prev_sum_ = histogram.sum;
+  if (interval_count == 0) {
+    // No foreground operations in this window, so no latency signal. Leave
+    // the budget alone rather than creeping towards either bound.
+    return Status::OK();
+  }
+  const uint64_t interval_latency = interval_sum / interval_count;
+
+  int64_t prev_bytes_per_sec = GetBytesPerSecond();
+  int64_t new_bytes_per_sec = prev_bytes_per_sec;
+  if (interval_latency > tuning_target_latency_micros_) {
+    // Over the target: cut the background budget harder than it is ever
+    // raised so a pressure spike is relieved within a few windows.
+    new_bytes_per_sec =
+        std::max(max_bytes_per_sec_ / kAllowedRangeFactor,
+                 prev_bytes_per_sec * 100 / (100 + kCutFactorPct));
+  } else if (interval_latency <
+             tuning_target_latency_micros_ * kHeadroomWatermarkPct / 100) {
+    // Comfortably under the target: give some of the headroom back to
+    // compactions and flushes.
+    int64_t sanitized_prev_bytes_per_sec = std::min(
+        prev_bytes_per_sec,
+        std::numeric_limits<int64_t>::max() / (100 + kAdjustFactorPct));
+    new_bytes_per_sec =
+        std::min(max_bytes_per_sec_,
+                 sanitized_prev_bytes_per_sec * (100 + kAdjustFactorPct) / 100);
+  }
+  if (new_bytes_per_sec != prev_bytes_per_sec) {
+    SetBytesPerSecondLocked(new_bytes_per_sec);
+  }
+  return Status::OK();
+}
+
 RateLimiter* NewGenericRateLimiter(
     int64_t rate_bytes_per_sec, int64_t refill_period_us /* = 100 * 1000 */,
     int32_t fairness /* = 10 */,
@@ -368,11 +430,29 @@ RateLimiter* NewGenericRateLimiter(
     bool auto_tuned /* = false */) {
   assert(rate_bytes_per_sec > 0);
   assert(refill_period_us > 0);
-  assert(fairness > 0);
+  assert(fairness >= 0);
   std::unique_ptr<RateLimiter> limiter(
       new GenericRateLimiter(rate_bytes_per_sec, refill_period_us, fairness,
                              mode, SystemClock::Default(), auto_tuned));
   return limiter.release();
 }
 
+RateLimiter* NewLatencyTunedRateLimiter(
+    int64_t max_rate_bytes_per_sec,
+    const std::shared_ptr<Statistics>& statistics, uint32_t latency_histogram,
+    uint64_t target_latency_micros,
+    int64_t refill_period_us /* = 100 * 1000 */, int32_t fairness /* = 10 */,
+    RateLimiter::Mode mode /* = RateLimiter::Mode::kWritesOnly */) {
+  assert(max_rate_bytes_per_sec > 0);
+  assert(statistics != nullptr);
+  assert(target_latency_micros > 0);
+  assert(refill_period_us > 0);
+  assert(fairness >= 0);
+  std::unique_ptr<RateLimiter> limiter(new GenericRateLimiter(
+      max_rate_bytes_per_sec, refill_period_us, fairness, mode,
+      SystemClock::Default(), true /* auto_tuned */, statistics,
+      latency_histogram, target_latency_micros));
+  return limiter.release();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
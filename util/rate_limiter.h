@@ -26,10 +26,13 @@ namespace ROCKSDB_NAMESPACE {
 
 class GenericRateLimiter : public RateLimiter {
  public:
-  GenericRateLimiter(int64_t refill_bytes, int64_t refill_period_us,
-                     int32_t fairness, RateLimiter::Mode mode,
-                     const std::shared_ptr<SystemClock>& clock,
-                     bool auto_tuned);
+  GenericRateLimiter(
+      int64_t refill_bytes, int64_t refill_period_us, int32_t fairness,
+      RateLimiter::Mode mode, const std::shared_ptr<SystemClock>& clock,
+      bool auto_tuned,
+      const std::shared_ptr<Statistics>& tuning_stats = nullptr,
+      uint32_t tuning_latency_histogram = 0,
+      uint64_t tuning_target_latency_micros = 0);
 
   virtual ~GenericRateLimiter();
 
@@ -106,6 +109,7 @@ class GenericRateLimiter : public RateLimiter {
   std::vector<Env::IOPriority> GeneratePriorityIterationOrderLocked();
   int64_t CalculateRefillBytesPerPeriodLocked(int64_t rate_bytes_per_sec);
   Status TuneLocked();
+  Status TuneByLatencyLocked();
   void SetBytesPerSecondLocked(int64_t bytes_per_second);
 
   uint64_t NowMicrosMonotonicLocked() {
@@ -141,6 +145,15 @@ class GenericRateLimiter : public RateLimiter {
   int64_t num_drains_;
   const int64_t max_bytes_per_sec_;
   std::chrono::microseconds tuned_time_;
+
+  // Latency feedback tuning (see NewLatencyTunedRateLimiter). When
+  // tuning_stats_ is set, TuneLocked() adjusts the limit from the windowed
+  // average latency of tuning_latency_histogram_ instead of the drain rate.
+  std::shared_ptr<Statistics> tuning_stats_;
+  uint32_t tuning_latency_histogram_;
+  uint64_t tuning_target_latency_micros_;
+  uint64_t tuning_latency_prev_count_;
+  uint64_t tuning_latency_prev_sum_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -260,6 +260,42 @@ TEST_F(RateLimiterTest, GeneratePriorityIterationOrder) {
   }
 }
 
+TEST_F(RateLimiterTest, StrictPriorityIterationOrder) {
+  // fairness = 0 disables the lottery: queues must always be iterated in
+  // strict priority order.
+  std::unique_ptr<RateLimiter> limiter(NewGenericRateLimiter(
+      200 /* rate_bytes_per_sec */, 1000 * 1000 /* refill_period_us */,
+      0 /* fairness */));
+
+  const std::vector<Env::IOPriority> strict_priority_iteration_order = {
+      Env::IO_USER, Env::IO_HIGH, Env::IO_MID, Env::IO_LOW};
+
+  int pri_iteration_order_verified_times = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "GenericRateLimiter::GeneratePriorityIterationOrderLocked::"
+      "PreReturnPriIterationOrder",
+      [&](void* arg) {
+        std::vector<Env::IOPriority>* pri_iteration_order =
+            (std::vector<Env::IOPriority>*)arg;
+        EXPECT_EQ(*pri_iteration_order, strict_priority_iteration_order);
+        ++pri_iteration_order_verified_times;
+      });
+
+  SyncPoint::GetInstance()->EnableProcessing();
+  for (int i = 0; i < 4; ++i) {
+    limiter->Request(200 /* drain the period so that refill and order
+                            generation are triggered every time */
+                     ,
+                     Env::IO_USER, nullptr /* stats */,
+                     RateLimiter::OpType::kWrite);
+  }
+  ASSERT_EQ(pri_iteration_order_verified_times, 4);
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearCallBack(
+      "GenericRateLimiter::GeneratePriorityIterationOrderLocked::"
+      "PreReturnPriIterationOrder");
+}
+
 TEST_F(RateLimiterTest, Rate) {
   auto* env = Env::Default();
   struct Arg {
@@ -467,6 +503,60 @@ TEST_F(RateLimiterTest, AutoTuneIncreaseWhenFull) {
   ASSERT_LT(new_bytes_per_sec, orig_bytes_per_sec);
 }
 
+TEST_F(RateLimiterTest, LatencyTuneFollowsForegroundLatency) {
+  const std::chrono::seconds kTimePerRefill(1);
+  const int kRefillsPerTune = 100;  // needs to match util/rate_limiter.cc
+  const uint64_t kTargetMicros = 1000;
+
+  SpecialEnv special_env(Env::Default(), /*time_elapse_only_sleep*/ true);
+
+  auto stats = CreateDBStatistics();
+  std::unique_ptr<RateLimiter> rate_limiter(new GenericRateLimiter(
+      1000 /* rate_bytes_per_sec */,
+      std::chrono::microseconds(kTimePerRefill).count(), 10 /* fairness */,
+      RateLimiter::Mode::kWritesOnly, special_env.GetSystemClock(),
+      true /* auto_tuned */, stats, DB_GET, kTargetMicros));
+
+  // Rate limiter uses `CondVar::TimedWait()`, which does not have access to
+  // the `Env` to advance its time according to the fake wait duration. The
+  // workaround is to install a callback that advance the `Env`'s mock time.
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "GenericRateLimiter::Request:PostTimedWait", [&](void* arg) {
+        int64_t time_waited_us = *static_cast<int64_t*>(arg);
+        special_env.SleepForMicroseconds(static_cast<int>(time_waited_us));
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  // verify rate limit decreases after a tuning window in which foreground
+  // latency was over the target
+  for (int i = 0; i < 100; ++i) {
+    stats->recordInHistogram(DB_GET, 10 * kTargetMicros);
+  }
+  int64_t orig_bytes_per_sec = rate_limiter->GetSingleBurstBytes();
+  while (std::chrono::microseconds(special_env.NowMicros()) <=
+         kRefillsPerTune * kTimePerRefill) {
+    rate_limiter->Request(rate_limiter->GetSingleBurstBytes(), Env::IO_HIGH,
+                          stats.get(), RateLimiter::OpType::kWrite);
+  }
+  ASSERT_LT(rate_limiter->GetSingleBurstBytes(), orig_bytes_per_sec);
+
+  // recovers once foreground latency is comfortably under the target
+  for (int i = 0; i < 100; ++i) {
+    stats->recordInHistogram(DB_GET, kTargetMicros / 10);
+  }
+  orig_bytes_per_sec = rate_limiter->GetSingleBurstBytes();
+  while (std::chrono::microseconds(special_env.NowMicros()) <=
+         2 * kRefillsPerTune * kTimePerRefill) {
+    rate_limiter->Request(rate_limiter->GetSingleBurstBytes(), Env::IO_HIGH,
+                          stats.get(), RateLimiter::OpType::kWrite);
+  }
+  ASSERT_GT(rate_limiter->GetSingleBurstBytes(), orig_bytes_per_sec);
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearCallBack(
+      "GenericRateLimiter::Request:PostTimedWait");
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
 
 #include "port/port.h"  // for PREFETCH
 #include "util/fastrange.h"
@@ -605,6 +608,106 @@ class StandardBanding : public StandardHasher<TypesAndSettings> {
     return AddRange(&input, &input + 1);
   }
 
+  // Adds a range of inputs to the banding using up to `num_threads` threads,
+  // returning true if successful. The slot space is partitioned into one
+  // contiguous range per thread; each thread bands the entries whose start
+  // slot falls in its range, and the few entries whose elimination crosses a
+  // partition boundary are set aside and added serially afterwards. Because
+  // on-the-fly Gaussian elimination reads and writes only the slot range
+  // [current start, boundary) until a row comes to rest, partitions touch
+  // disjoint slots, and because banding is insensitive to insertion order,
+  // the result is interchangeable with a serial AddRange and the query-side
+  // layout is identical.
+  //
+  // Unlike AddRange, no backtracking is performed: if false is returned,
+  // Reset this banding before any further use. Temporary memory of roughly
+  // sizeof(PendingRow) per input is used for the precomputed rows.
+  template <typename InputIterator>
+  bool AddRangeParallel(InputIterator begin, InputIterator end,
+                        size_t num_threads) {
+    assert(num_starts_ > 0 || TypesAndSettings::kAllowZeroStarts);
+    if (TypesAndSettings::kAllowZeroStarts && num_starts_ == 0) {
+      // Unusual. Can't add any in this case.
+      return begin == end;
+    }
+    const Index num_slots = num_starts_ + kCoeffBits - 1;
+    // Keep each partition many times wider than the band so that few entries
+    // cross a partition boundary, and don't bother threading small bandings.
+    num_threads = std::min(
+        num_threads, static_cast<size_t>(num_slots / (16 * kCoeffBits)));
+    if (num_threads < 2) {
+      return AddRange(begin, end);
+    }
+
+    // Phase 1 (serial): reduce each input to a pending row, bucketed by the
+    // partition owning its start slot. Hashing is cheap relative to the
+    // cache-missing elimination work in phase 2.
+    const Index width = num_slots / static_cast<Index>(num_threads);
+    std::vector<std::vector<PendingRow>> buckets(num_threads);
+    for (InputIterator cur = begin; cur != end; ++cur) {
+      Hash h = this->GetHash(*cur);
+      Index start = this->GetStart(h, num_starts_);
+      ResultRow rr =
+          this->GetResultRowFromInput(*cur) | this->GetResultRowFromHash(h);
+      CoeffRow cr = this->GetCoeffRow(h);
+      if (!kFirstCoeffAlwaysOne) {
+        // Requires/asserts that cr != 0
+        int tz = CountTrailingZeroBits(cr);
+        start += static_cast<Index>(tz);
+        cr >>= tz;
+      }
+      size_t partition =
+          std::min(static_cast<size_t>(start / width), num_threads - 1);
+      buckets[partition].push_back(PendingRow{start, cr, rr});
+    }
+
+    // Phase 2 (parallel): band each partition on its own thread. Entries
+    // whose elimination reaches the partition boundary are deferred.
+    std::vector<std::vector<PendingRow>> deferred(num_threads);
+    std::atomic<bool> failed{false};
+    auto band_partition = [&](size_t p) {
+      const Index limit = (p + 1 < num_threads)
+                              ? static_cast<Index>(p + 1) * width
+                              : num_slots;
+      for (PendingRow& row : buckets[p]) {
+        if (failed.load(std::memory_order_relaxed)) {
+          return;
+        }
+        BoundedAddResult result = BandingAddBounded(limit, &row);
+        if (result == BoundedAddResult::kDeferred) {
+          deferred[p].push_back(row);
+        } else if (result == BoundedAddResult::kFailed) {
+          failed.store(true, std::memory_order_relaxed);
+          return;
+        }
+      }
+    };
+    std::vector<port::Thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t p = 1; p < num_threads; ++p) {
+      threads.emplace_back([&band_partition, p] { band_partition(p); });
+    }
+    band_partition(0);
+    for (auto& t : threads) {
+      t.join();
+    }
+    if (failed.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    // Phase 3 (serial): stitch the boundary regions by adding the deferred
+    // rows. A reduced row never comes to rest more than kCoeffBits - 1 slots
+    // past its original start, so nothing can be deferred again here.
+    for (auto& rows : deferred) {
+      for (PendingRow& row : rows) {
+        if (BandingAddBounded(num_slots, &row) != BoundedAddResult::kAdded) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   // Return the number of "occupied" rows (with non-zero coefficients stored).
   Index GetOccupiedCount() const {
     Index count = 0;
@@ -688,6 +791,57 @@ class StandardBanding : public StandardHasher<TypesAndSettings> {
   }
 
  protected:
+  // A (partially reduced) row not yet stored in the banding, for
+  // AddRangeParallel.
+  struct PendingRow {
+    Index start;
+    CoeffRow cr;
+    ResultRow rr;
+  };
+
+  enum class BoundedAddResult { kAdded, kDeferred, kFailed };
+
+  // Like BandingAdd (see ribbon_alg.h), except that no slot at index >=
+  // `limit` is read or written, and the leading coefficient bit of row->cr
+  // must already be set (see kFirstCoeffAlwaysOne handling in the caller).
+  // Returns kAdded if the row was stored (or canceled out as redundant),
+  // kFailed if the solution is impossible, or kDeferred if elimination moved
+  // the row to a slot at or beyond `limit`; in that case *row holds the
+  // reduced row for a later retry.
+  BoundedAddResult BandingAddBounded(Index limit, PendingRow* row) {
+    Index i = row->start;
+    CoeffRow cr = row->cr;
+    ResultRow rr = row->rr;
+    for (;;) {
+      if (i >= limit) {
+        row->start = i;
+        row->cr = cr;
+        row->rr = rr;
+        return BoundedAddResult::kDeferred;
+      }
+      assert((cr & 1) == 1);
+      CoeffRow cr_at_i;
+      ResultRow rr_at_i;
+      LoadRow(i, &cr_at_i, &rr_at_i, /* for_back_subst */ false);
+      if (cr_at_i == 0) {
+        StoreRow(i, cr, rr);
+        return BoundedAddResult::kAdded;
+      }
+      assert((cr_at_i & 1) == 1);
+      // Gaussian row reduction
+      cr ^= cr_at_i;
+      rr ^= rr_at_i;
+      if (cr == 0) {
+        // Redundancy if rr == 0, else inconsistency
+        return rr == 0 ? BoundedAddResult::kAdded : BoundedAddResult::kFailed;
+      }
+      // Find relative offset of next non-zero coefficient.
+      int tz = CountTrailingZeroBits(cr);
+      i += static_cast<Index>(tz);
+      cr >>= tz;
+    }
+  }
+
   // TODO: explore combining in a struct
   std::unique_ptr<CoeffRow[]> coeff_rows_;
   std::unique_ptr<ResultRow[]> result_rows_;
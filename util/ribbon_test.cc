@@ -977,6 +977,44 @@ TYPED_TEST(RibbonTypeParamTest, Extremes) {
   ASSERT_EQ(isoln2.ExpectedFpRate(), 1.0);
 }
 
+TYPED_TEST(RibbonTypeParamTest, ParallelBanding) {
+  IMPORT_RIBBON_TYPES_AND_SETTINGS(TypeParam);
+  IMPORT_RIBBON_IMPL_TYPES(TypeParam);
+  using KeyGen = typename TypeParam::KeyGen;
+
+  // Enough slots for several partitions in AddRangeParallel, at an
+  // occupancy where a solving seed is found quickly.
+  const Index num_slots = static_cast<Index>(64 * kCoeffBits);
+  const Index num_to_add = num_slots * 7 / 10;
+
+  KeyGen begin("parallel", 0);
+  KeyGen end("parallel", num_to_add);
+
+  Banding serial;
+  ASSERT_TRUE(serial.ResetAndFindSeedToSolve(num_slots, begin, end));
+
+  // Whether a set of entries can be banded depends only on the equation
+  // system, not on insertion order, so the seed that worked serially must
+  // work for the parallel path too.
+  Banding parallel;
+  parallel.SetOrdinalSeed(serial.GetOrdinalSeed());
+  parallel.Reset(num_slots);
+  ASSERT_TRUE(parallel.AddRangeParallel(begin, end, 4));
+
+  // Same occupied slots as the serial banding.
+  ASSERT_EQ(parallel.GetOccupiedCount(), serial.GetOccupiedCount());
+  for (Index i = 0; i < num_slots; ++i) {
+    ASSERT_EQ(parallel.IsOccupied(i), serial.IsOccupied(i));
+  }
+
+  // And a solution built from it accepts all added keys.
+  SimpleSoln soln;
+  soln.BackSubstFrom(parallel);
+  for (KeyGen cur = begin; cur != end; ++cur) {
+    ASSERT_TRUE(soln.FilterQuery(*cur, parallel));
+  }
+}
+
 TEST(RibbonTest, AllowZeroStarts) {
   IMPORT_RIBBON_TYPES_AND_SETTINGS(TypesAndSettings_AllowZeroStarts);
   IMPORT_RIBBON_IMPL_TYPES(TypesAndSettings_AllowZeroStarts);
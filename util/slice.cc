@@ -31,6 +31,7 @@ class FixedPrefixTransform : public SliceTransform {
  public:
   explicit FixedPrefixTransform(size_t prefix_len) : prefix_len_(prefix_len) {
     id_ = std::string(kClassName()) + "." + std::to_string(prefix_len_);
+    MarkAsBuiltin(Kind::kFixed, prefix_len_);
   }
 
   static const char* kClassName() { return "rocksdb.FixedPrefix"; }
@@ -84,6 +85,7 @@ class CappedPrefixTransform : public SliceTransform {
  public:
   explicit CappedPrefixTransform(size_t cap_len) : cap_len_(cap_len) {
     id_ = std::string(kClassName()) + "." + std::to_string(cap_len_);
+    MarkAsBuiltin(Kind::kCapped, cap_len_);
   }
 
   static const char* kClassName() { return "rocksdb.CappedPrefix"; }
@@ -128,7 +130,7 @@ class CappedPrefixTransform : public SliceTransform {
 
 class NoopTransform : public SliceTransform {
  public:
-  explicit NoopTransform() {}
+  explicit NoopTransform() { MarkAsBuiltin(Kind::kNoop, 0); }
 
   static const char* kClassName() { return "rocksdb.Noop"; }
   const char* Name() const override { return kClassName(); }
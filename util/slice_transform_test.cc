@@ -45,6 +45,51 @@ TEST_F(SliceTransformTest, CapPrefixTransform) {
   ASSERT_EQ(transform->Transform("").ToString(), "");
 }
 
+namespace {
+// A user-defined transform: must keep Kind::kGeneral and go through the
+// virtuals from the *Inline() helpers.
+class FirstTwoBytesTransform : public SliceTransform {
+ public:
+  const char* Name() const override { return "FirstTwoBytesTransform"; }
+  Slice Transform(const Slice& src) const override {
+    return Slice(src.data(), 2);
+  }
+  bool InDomain(const Slice& src) const override { return src.size() >= 2; }
+};
+}  // namespace
+
+TEST_F(SliceTransformTest, InlineDispatch) {
+  std::string s = "abcdefge";
+
+  std::unique_ptr<const SliceTransform> transform;
+
+  transform.reset(NewFixedPrefixTransform(4));
+  ASSERT_EQ(transform->kind(), SliceTransform::Kind::kFixed);
+  ASSERT_EQ(transform->TransformInline(s).ToString(),
+            transform->Transform(s).ToString());
+  ASSERT_EQ(transform->InDomainInline(s), transform->InDomain(s));
+  ASSERT_EQ(transform->InDomainInline("abc"), transform->InDomain("abc"));
+
+  transform.reset(NewCappedPrefixTransform(6));
+  ASSERT_EQ(transform->kind(), SliceTransform::Kind::kCapped);
+  ASSERT_EQ(transform->TransformInline(s).ToString(),
+            transform->Transform(s).ToString());
+  ASSERT_EQ(transform->TransformInline("abc").ToString(),
+            transform->Transform("abc").ToString());
+  ASSERT_TRUE(transform->InDomainInline("a"));
+
+  transform.reset(NewNoopTransform());
+  ASSERT_EQ(transform->kind(), SliceTransform::Kind::kNoop);
+  ASSERT_EQ(transform->TransformInline(s).ToString(), s);
+  ASSERT_TRUE(transform->InDomainInline(s));
+
+  transform.reset(new FirstTwoBytesTransform());
+  ASSERT_EQ(transform->kind(), SliceTransform::Kind::kGeneral);
+  ASSERT_EQ(transform->TransformInline(s).ToString(), "ab");
+  ASSERT_TRUE(transform->InDomainInline(s));
+  ASSERT_TRUE(!transform->InDomainInline("a"));
+}
+
 class SliceTransformDBTest : public testing::Test {
  private:
   std::string dbname_;
@@ -81,10 +81,22 @@ Status::Status(Code _code, SubCode _subcode, const Slice& msg,
       data_loss_(false),
       scope_(0) {
   assert(subcode_ != kMaxSubCode);
+  SetState(msg, msg2);
+}
+
+void Status::SetState(const Slice& msg, const Slice& msg2) {
   const size_t len1 = msg.size();
   const size_t len2 = msg2.size();
   const size_t size = len1 + (len2 ? (2 + len2) : 0);
-  char* const result = new char[size + 1];  // +1 for null terminator
+  char* result;
+  if (size < kInlineStateSize) {
+    // Short messages are kept inline so error paths do not allocate.
+    result = inline_state_;
+    state_is_inline_ = true;
+  } else {
+    result = new char[size + 1];  // +1 for null terminator
+    state_.reset(result);
+  }
   memcpy(result, msg.data(), len1);
   if (len2) {
     result[len1] = ':';
@@ -92,7 +104,6 @@ Status::Status(Code _code, SubCode _subcode, const Slice& msg,
     memcpy(result + len1 + 2, msg2.data(), len2);
   }
   result[size] = '\0';  // null terminator for C style string
-  state_.reset(result);
 }
 
 Status Status::CopyAppendMessage(const Status& s, const Slice& delim,
@@ -175,11 +186,12 @@ std::string Status::ToString() const {
     result.append(msgs[index]);
   }
 
-  if (state_ != nullptr) {
+  const char* state = getState();
+  if (state != nullptr) {
     if (subcode_ != kNone) {
       result.append(": ");
     }
-    result.append(state_.get());
+    result.append(state);
   }
   return result;
 }
@@ -38,6 +38,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -72,9 +73,17 @@ struct ThreadPoolImpl::Impl {
 
   void LowerIOPriority();
 
+  void RaiseIOPriority();
+
   void LowerCPUPriority(CpuPriority pri);
 
-  void WakeUpAllThreads() { bgsignal_.notify_all(); }
+  void WakeUpAllThreads() {
+    // Every worker has its own condition variable, so "broadcast" means
+    // signalling each of them; workers that are not waiting ignore it.
+    for (auto& cv : worker_cvs_) {
+      cv->notify_one();
+    }
+  }
 
   void BGThread(size_t thread_id);
 
@@ -138,7 +147,13 @@ struct ThreadPoolImpl::Impl {
  private:
   static void BGThreadWrapper(void* arg);
 
-  bool low_io_priority_;
+  // Kernel-visible IO priority class applied to worker threads (Linux only)
+  enum class KernelIOPri : char {
+    kDefault,
+    kIdle,            // IOPRIO_CLASS_IDLE
+    kBestEffortHigh,  // IOPRIO_CLASS_BE, highest level
+  };
+  KernelIOPri io_priority_;
   CpuPriority cpu_priority_;
   Env::Priority priority_;
   Env* env_;
@@ -163,18 +178,53 @@ struct ThreadPoolImpl::Impl {
     void* tag = nullptr;
     std::function<void()> function;
     std::function<void()> unschedFunction;
+    // How many times a worker has skipped this item while it was at the
+    // queue head in favor of a job matching the worker's last tag; once it
+    // reaches kMaxHeadBypasses the next worker must take it.
+    uint32_t head_bypass_count = 0;
   };
 
   using BGQueue = std::deque<BGItem>;
   BGQueue queue_;
 
   std::mutex mu_;
-  std::condition_variable bgsignal_;
+  // One condition variable per worker plus a LIFO stack of the ids of idle
+  // workers, all guarded by mu_. Submit() pops the most recently idled
+  // worker — the one whose stack and thread-local state are most likely
+  // still cache-warm — and signals only its condition variable, so a
+  // schedule storm never wakes more threads than it has jobs for.
+  // worker_cvs_ never shrinks; slots of terminated excessive threads are
+  // reused if the thread limit grows again.
+  std::vector<std::unique_ptr<std::condition_variable>> worker_cvs_;
+  std::vector<size_t> idle_workers_;
   std::vector<port::Thread> bgthreads_;
+
+  // The tag of the last job each worker ran, used for sticky assignment:
+  // Submit() prefers waking an idle worker that last ran the same tag, and
+  // a worker prefers a queued job carrying its own last tag, so a worker's
+  // warm per-job state (compression contexts, comparator and properties
+  // collector caches) is reused across jobs from the same scheduler. The
+  // pointers are only ever compared for identity, never dereferenced, so a
+  // stale tag is merely a scheduling hint that stops matching. Jobs sharing
+  // a tag always retain their FIFO order; only the relative order of jobs
+  // with different tags may change, and each queue head is delayed by at
+  // most kMaxHeadBypasses affinity picks before some worker must take it.
+  std::vector<void*> worker_last_tag_;
+
+  // Bounds how far past the queue head a worker may look for a job with its
+  // own tag.
+  static constexpr size_t kAffinityLookahead = 8;
+
+  // A job at the queue head may lose to an affinity match behind it at most
+  // this many times; after that every worker takes the head regardless of
+  // its last tag. Without this bound a sustained stream of same-tag jobs
+  // (e.g. one DB's compaction backlog in a shared Env) could starve a
+  // differently-tagged job sitting at the head indefinitely.
+  static constexpr uint32_t kMaxHeadBypasses = 8;
 };
 
 inline ThreadPoolImpl::Impl::Impl()
-    : low_io_priority_(false),
+    : io_priority_(KernelIOPri::kDefault),
       cpu_priority_(CpuPriority::kNormal),
       priority_(Env::LOW),
       env_(nullptr),
@@ -186,8 +236,10 @@ inline ThreadPoolImpl::Impl::Impl()
       wait_for_jobs_to_complete_(false),
       queue_(),
       mu_(),
-      bgsignal_(),
-      bgthreads_() {}
+      worker_cvs_(),
+      idle_workers_(),
+      bgthreads_(),
+      worker_last_tag_() {}
 
 inline ThreadPoolImpl::Impl::~Impl() { assert(bgthreads_.size() == 0U); }
 
@@ -205,7 +257,9 @@ void ThreadPoolImpl::Impl::JoinThreads(bool wait_for_jobs_to_complete) {
 
   lock.unlock();
 
-  bgsignal_.notify_all();
+  // Safe without the lock: exit_all_threads_ prevents worker_cvs_ from
+  // growing concurrently, and its elements are stable unique_ptrs.
+  WakeUpAllThreads();
 
   for (auto& th : bgthreads_) {
     th.join();
@@ -219,7 +273,12 @@ void ThreadPoolImpl::Impl::JoinThreads(bool wait_for_jobs_to_complete) {
 
 inline void ThreadPoolImpl::Impl::LowerIOPriority() {
   std::lock_guard<std::mutex> lock(mu_);
-  low_io_priority_ = true;
+  io_priority_ = KernelIOPri::kIdle;
+}
+
+inline void ThreadPoolImpl::Impl::RaiseIOPriority() {
+  std::lock_guard<std::mutex> lock(mu_);
+  io_priority_ = KernelIOPri::kBestEffortHigh;
 }
 
 inline void ThreadPoolImpl::Impl::LowerCPUPriority(CpuPriority pri) {
@@ -228,7 +287,7 @@ inline void ThreadPoolImpl::Impl::LowerCPUPriority(CpuPriority pri) {
 }
 
 void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
-  bool low_io_priority = false;
+  KernelIOPri current_io_priority = KernelIOPri::kDefault;
   CpuPriority current_cpu_priority = CpuPriority::kNormal;
 
   while (true) {
@@ -248,7 +307,19 @@ void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
     while (!exit_all_threads_ && !IsLastExcessiveThread(thread_id) &&
            (queue_.empty() || IsExcessiveThread(thread_id) ||
             num_waiting_threads_ <= reserved_threads_)) {
-      bgsignal_.wait(lock);
+      // Park on this worker's own condition variable so that Submit() can
+      // wake exactly one idle thread. The push and the removal below happen
+      // under mu_, so a submitter can only pop this id once the wait has
+      // released the lock and no wakeup can be lost.
+      idle_workers_.push_back(thread_id);
+      worker_cvs_[thread_id]->wait(lock);
+      // A targeted wakeup already removed this id; remove it ourselves after
+      // a broadcast or spurious wakeup so the idle stack only lists waiters.
+      auto it =
+          std::find(idle_workers_.begin(), idle_workers_.end(), thread_id);
+      if (it != idle_workers_.end()) {
+        idle_workers_.erase(it);
+      }
     }
     // Decrease num_waiting_threads_ once the thread is not waiting
     num_waiting_threads_--;
@@ -277,13 +348,35 @@ void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
       break;
     }
 
-    auto func = std::move(queue_.front().function);
-    queue_.pop_front();
+    // Prefer a job with this worker's last tag over the queue head, so that
+    // consecutive jobs from the same scheduler keep running on the same
+    // worker while other workers steal the head.
+    auto picked = queue_.begin();
+    void* const last_tag = worker_last_tag_[thread_id];
+    if (last_tag != nullptr && picked->tag != last_tag &&
+        picked->head_bypass_count < kMaxHeadBypasses) {
+      size_t scanned = 1;
+      for (auto it = std::next(picked);
+           it != queue_.end() && scanned < kAffinityLookahead;
+           ++it, ++scanned) {
+        if (it->tag == last_tag) {
+          picked = it;
+          break;
+        }
+      }
+      if (picked != queue_.begin()) {
+        ++queue_.begin()->head_bypass_count;
+      }
+    }
+
+    auto func = std::move(picked->function);
+    worker_last_tag_[thread_id] = picked->tag;
+    queue_.erase(picked);
 
     queue_len_.store(static_cast<unsigned int>(queue_.size()),
                      std::memory_order_relaxed);
 
-    bool decrease_io_priority = (low_io_priority != low_io_priority_);
+    KernelIOPri io_priority = io_priority_;
     CpuPriority cpu_priority = cpu_priority_;
     lock.unlock();
 
@@ -298,10 +391,12 @@ void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
     }
 
 #ifdef OS_LINUX
-    if (decrease_io_priority) {
+    if (io_priority != current_io_priority) {
 #define IOPRIO_CLASS_SHIFT (13)
 #define IOPRIO_PRIO_VALUE(class, data) (((class) << IOPRIO_CLASS_SHIFT) | data)
-      // Put schedule into IOPRIO_CLASS_IDLE class (lowest)
+      // Put the thread into IOPRIO_CLASS_IDLE (lowest) or the highest level
+      // of IOPRIO_CLASS_BE (best-effort). The real-time class would need
+      // CAP_SYS_ADMIN, so the best-effort top level is used for raising.
       // These system calls only have an effect when used in conjunction
       // with an I/O scheduler that supports I/O priorities. As at
       // kernel 2.6.17 the only such scheduler is the Completely
@@ -311,13 +406,16 @@ void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
       // Tunables to consider:
       //  /sys/block/<device_name>/queue/slice_idle
       //  /sys/block/<device_name>/queue/slice_sync
+      int ioprio = io_priority == KernelIOPri::kIdle
+                       ? IOPRIO_PRIO_VALUE(3, 0)
+                       : IOPRIO_PRIO_VALUE(2, 0);
       syscall(SYS_ioprio_set, 1,  // IOPRIO_WHO_PROCESS
               0,                  // current thread
-              IOPRIO_PRIO_VALUE(3, 0));
-      low_io_priority = true;
+              ioprio);
+      current_io_priority = io_priority;
     }
 #else
-    (void)decrease_io_priority;  // avoid 'unused variable' error
+    (void)io_priority;  // avoid 'unused variable' error
 #endif
 
     TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::Impl::BGThread:BeforeRun",
@@ -393,6 +491,10 @@ int ThreadPoolImpl::Impl::GetBackgroundThreads() {
 void ThreadPoolImpl::Impl::StartBGThreads() {
   // Start background thread if necessary
   while ((int)bgthreads_.size() < total_threads_limit_) {
+    if (worker_cvs_.size() < bgthreads_.size() + 1) {
+      worker_cvs_.push_back(std::make_unique<std::condition_variable>());
+      worker_last_tag_.push_back(nullptr);
+    }
     port::Thread p_t(&BGThreadWrapper,
                      new BGThreadMetadata(this, bgthreads_.size()));
 
@@ -436,8 +538,24 @@ void ThreadPoolImpl::Impl::Submit(std::function<void()>&& schedule,
                    std::memory_order_relaxed);
 
   if (!HasExcessiveThread()) {
-    // Wake up at least one waiting thread.
-    bgsignal_.notify_one();
+    // Wake up the most recently idled thread, if any; with no excessive
+    // threads every idle worker is eligible to run the job. A worker that
+    // last ran a job with the same tag is preferred over plain LIFO, since
+    // its per-job state is the most likely to still be warm.
+    if (!idle_workers_.empty()) {
+      size_t pos = idle_workers_.size() - 1;
+      if (tag != nullptr) {
+        for (size_t i = idle_workers_.size(); i > 0; --i) {
+          if (worker_last_tag_[idle_workers_[i - 1]] == tag) {
+            pos = i - 1;
+            break;
+          }
+        }
+      }
+      size_t id = idle_workers_[pos];
+      idle_workers_.erase(idle_workers_.begin() + pos);
+      worker_cvs_[id]->notify_one();
+    }
   } else {
     // Need to wake up all threads to make sure the one woken
     // up is not the one to terminate.
@@ -501,6 +619,8 @@ void ThreadPoolImpl::WaitForJobsAndJoinAllThreads() {
 
 void ThreadPoolImpl::LowerIOPriority() { impl_->LowerIOPriority(); }
 
+void ThreadPoolImpl::RaiseIOPriority() { impl_->RaiseIOPriority(); }
+
 void ThreadPoolImpl::LowerCPUPriority(CpuPriority pri) {
   impl_->LowerCPUPriority(pri);
 }
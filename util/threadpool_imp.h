@@ -49,6 +49,10 @@ class ThreadPoolImpl : public ThreadPool {
   // Currently only has effect on Linux
   void LowerIOPriority();
 
+  // Make threads to run at the highest best-effort kernel IO priority
+  // Currently only has effect on Linux
+  void RaiseIOPriority();
+
   // Make threads to run at a lower kernel CPU priority
   // Currently only has effect on Linux
   void LowerCPUPriority(CpuPriority pri);
@@ -10,11 +10,24 @@
 
 #include "monitoring/perf_context_imp.h"
 #include "rocksdb/comparator.h"
+#include "util/coding_lean.h"
 
 namespace ROCKSDB_NAMESPACE {
 
 // Wrapper of user comparator, with auto increment to
 // perf_context.user_key_comparison_count.
+//
+// When the wrapped comparator is the built-in forward bytewise comparator
+// (detected by singleton identity), key comparisons short-circuit to an
+// inlined Slice::compare instead of going through virtual dispatch. The
+// virtual call per comparison is measurable on scan-heavy profiles since
+// every memtable, block seek and merging-iterator comparison funnels
+// through here via InternalKeyComparator.
+//
+// The built-in bytewise comparator with a fixed 8-byte integer timestamp
+// suffix (BytewiseComparatorWithU64Ts()) gets the same treatment: the
+// suffix is stripped and decoded inline, so timestamp-aware comparisons
+// avoid both the virtual call and the generic timestamp-size plumbing.
 class UserComparatorWrapper {
  public:
   // `UserComparatorWrapper`s constructed with the default constructor are not
@@ -22,7 +35,9 @@ class UserComparatorWrapper {
   UserComparatorWrapper() : user_comparator_(nullptr) {}
 
   explicit UserComparatorWrapper(const Comparator* const user_cmp)
-      : user_comparator_(user_cmp) {}
+      : user_comparator_(user_cmp),
+        is_forward_bytewise_(user_cmp == BytewiseComparator()),
+        is_bytewise_with_u64_ts_(user_cmp == BytewiseComparatorWithU64Ts()) {}
 
   ~UserComparatorWrapper() = default;
 
@@ -30,35 +45,91 @@ class UserComparatorWrapper {
 
   int Compare(const Slice& a, const Slice& b) const {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_forward_bytewise_) {
+      return a.compare(b);
+    }
+    if (is_bytewise_with_u64_ts_) {
+      const int res = StripU64Ts(a).compare(StripU64Ts(b));
+      if (res != 0) {
+        return res;
+      }
+      // For the same user key, the larger (newer) timestamp comes first.
+      const uint64_t ts_a = DecodeU64Ts(a);
+      const uint64_t ts_b = DecodeU64Ts(b);
+      return (ts_a < ts_b) - (ts_a > ts_b);
+    }
     return user_comparator_->Compare(a, b);
   }
 
   bool Equal(const Slice& a, const Slice& b) const {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_forward_bytewise_ || is_bytewise_with_u64_ts_) {
+      // The fixed-width timestamp encoding is bijective, so byte equality
+      // also covers the timestamp suffix.
+      return a == b;
+    }
     return user_comparator_->Equal(a, b);
   }
 
   int CompareTimestamp(const Slice& ts1, const Slice& ts2) const {
+    if (is_bytewise_with_u64_ts_) {
+      assert(ts1.size() == sizeof(uint64_t));
+      assert(ts2.size() == sizeof(uint64_t));
+      const uint64_t lhs = DecodeFixed64(ts1.data());
+      const uint64_t rhs = DecodeFixed64(ts2.data());
+      return (lhs > rhs) - (lhs < rhs);
+    }
     return user_comparator_->CompareTimestamp(ts1, ts2);
   }
 
   int CompareWithoutTimestamp(const Slice& a, const Slice& b) const {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_forward_bytewise_) {
+      // The builtin bytewise comparator has no timestamp
+      return a.compare(b);
+    }
+    if (is_bytewise_with_u64_ts_) {
+      return StripU64Ts(a).compare(StripU64Ts(b));
+    }
     return user_comparator_->CompareWithoutTimestamp(a, b);
   }
 
   int CompareWithoutTimestamp(const Slice& a, bool a_has_ts, const Slice& b,
                               bool b_has_ts) const {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_forward_bytewise_) {
+      // The builtin bytewise comparator has no timestamp
+      assert(!a_has_ts && !b_has_ts);
+      return a.compare(b);
+    }
+    if (is_bytewise_with_u64_ts_) {
+      return (a_has_ts ? StripU64Ts(a) : a)
+          .compare(b_has_ts ? StripU64Ts(b) : b);
+    }
     return user_comparator_->CompareWithoutTimestamp(a, a_has_ts, b, b_has_ts);
   }
 
   bool EqualWithoutTimestamp(const Slice& a, const Slice& b) const {
+    if (is_bytewise_with_u64_ts_) {
+      return StripU64Ts(a) == StripU64Ts(b);
+    }
     return user_comparator_->EqualWithoutTimestamp(a, b);
   }
 
  private:
+  static Slice StripU64Ts(const Slice& key) {
+    assert(key.size() >= sizeof(uint64_t));
+    return Slice(key.data(), key.size() - sizeof(uint64_t));
+  }
+
+  static uint64_t DecodeU64Ts(const Slice& key) {
+    assert(key.size() >= sizeof(uint64_t));
+    return DecodeFixed64(key.data() + key.size() - sizeof(uint64_t));
+  }
+
   const Comparator* user_comparator_;
+  bool is_forward_bytewise_ = false;
+  bool is_bytewise_with_u64_ts_ = false;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,234 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rocksdb/utilities/async_event_listener.h"
+
+#include <cassert>
+#include <utility>
+
+namespace ROCKSDB_NAMESPACE {
+
+std::shared_ptr<AsyncEventListener> AsyncEventListener::Wrap(
+    std::shared_ptr<EventListener> target, size_t max_queue_depth) {
+  assert(target != nullptr);
+  assert(max_queue_depth > 0);
+  return std::shared_ptr<AsyncEventListener>(
+      new AsyncEventListener(std::move(target), max_queue_depth));
+}
+
+AsyncEventListener::AsyncEventListener(std::shared_ptr<EventListener> target,
+                                       size_t max_queue_depth)
+    : target_(std::move(target)), max_queue_depth_(max_queue_depth) {
+  notifier_ = std::thread(&AsyncEventListener::NotifierThread, this);
+}
+
+AsyncEventListener::~AsyncEventListener() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    shutting_down_ = true;
+  }
+  events_ready_.notify_all();
+  notifier_.join();
+}
+
+uint64_t AsyncEventListener::GetOverflowCount() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return overflow_count_;
+}
+
+void AsyncEventListener::WaitForPendingEvents() {
+  std::unique_lock<std::mutex> lock(mu_);
+  events_drained_.wait(lock,
+                       [this] { return events_.empty() && !delivering_; });
+}
+
+void AsyncEventListener::Enqueue(std::function<void()>&& event) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (events_.size() >= max_queue_depth_) {
+      ++overflow_count_;
+      return;
+    }
+    events_.push_back(std::move(event));
+  }
+  events_ready_.notify_one();
+}
+
+void AsyncEventListener::NotifierThread() {
+  std::unique_lock<std::mutex> lock(mu_);
+  while (true) {
+    events_ready_.wait(
+        lock, [this] { return !events_.empty() || shutting_down_; });
+    if (events_.empty()) {
+      // Shutting down with an empty queue; all events are delivered.
+      return;
+    }
+    std::function<void()> event = std::move(events_.front());
+    events_.pop_front();
+    delivering_ = true;
+    lock.unlock();
+    event();
+    lock.lock();
+    delivering_ = false;
+    if (events_.empty()) {
+      events_drained_.notify_all();
+    }
+  }
+}
+
+void AsyncEventListener::OnFlushBegin(DB* db, const FlushJobInfo& info) {
+  Enqueue([this, db, info] { target_->OnFlushBegin(db, info); });
+}
+
+void AsyncEventListener::OnFlushCompleted(DB* db, const FlushJobInfo& info) {
+  Enqueue([this, db, info] { target_->OnFlushCompleted(db, info); });
+}
+
+void AsyncEventListener::OnCompactionBegin(DB* db,
+                                           const CompactionJobInfo& ci) {
+  Enqueue([this, db, ci] { target_->OnCompactionBegin(db, ci); });
+}
+
+void AsyncEventListener::OnCompactionCompleted(DB* db,
+                                               const CompactionJobInfo& ci) {
+  Enqueue([this, db, ci] { target_->OnCompactionCompleted(db, ci); });
+}
+
+void AsyncEventListener::OnSubcompactionBegin(const SubcompactionJobInfo& si) {
+  Enqueue([this, si] { target_->OnSubcompactionBegin(si); });
+}
+
+void AsyncEventListener::OnSubcompactionCompleted(
+    const SubcompactionJobInfo& si) {
+  Enqueue([this, si] { target_->OnSubcompactionCompleted(si); });
+}
+
+void AsyncEventListener::OnTableFileCreated(const TableFileCreationInfo& info) {
+  // The info structs captured through a shared_ptr below carry Status
+  // members without self-permitting destructors; permit them up front so
+  // that dropping an event on overflow is harmless in
+  // ROCKSDB_ASSERT_STATUS_CHECKED builds.
+  auto copy = std::make_shared<TableFileCreationInfo>(info);
+  copy->status.PermitUncheckedError();
+  Enqueue([this, copy] { target_->OnTableFileCreated(*copy); });
+}
+
+void AsyncEventListener::OnTableFileCreationStarted(
+    const TableFileCreationBriefInfo& info) {
+  Enqueue([this, info] { target_->OnTableFileCreationStarted(info); });
+}
+
+void AsyncEventListener::OnTableFileDeleted(const TableFileDeletionInfo& info) {
+  auto copy = std::make_shared<TableFileDeletionInfo>(info);
+  copy->status.PermitUncheckedError();
+  Enqueue([this, copy] { target_->OnTableFileDeleted(*copy); });
+}
+
+void AsyncEventListener::OnMemTableSealed(const MemTableInfo& info) {
+  Enqueue([this, info] { target_->OnMemTableSealed(info); });
+}
+
+void AsyncEventListener::OnExternalFileIngested(
+    DB* db, const ExternalFileIngestionInfo& info) {
+  Enqueue([this, db, info] { target_->OnExternalFileIngested(db, info); });
+}
+
+void AsyncEventListener::OnStallConditionsChanged(const WriteStallInfo& info) {
+  Enqueue([this, info] { target_->OnStallConditionsChanged(info); });
+}
+
+void AsyncEventListener::OnTuningReport(DB* db, const std::string& report) {
+  Enqueue([this, db, report] { target_->OnTuningReport(db, report); });
+}
+
+void AsyncEventListener::OnErrorRecoveryEnd(
+    const BackgroundErrorRecoveryInfo& info) {
+  auto copy = std::make_shared<BackgroundErrorRecoveryInfo>(info);
+  copy->old_bg_error.PermitUncheckedError();
+  copy->new_bg_error.PermitUncheckedError();
+  Enqueue([this, copy] { target_->OnErrorRecoveryEnd(*copy); });
+}
+
+void AsyncEventListener::OnBlobFileCreationStarted(
+    const BlobFileCreationBriefInfo& info) {
+  Enqueue([this, info] { target_->OnBlobFileCreationStarted(info); });
+}
+
+void AsyncEventListener::OnBlobFileCreated(const BlobFileCreationInfo& info) {
+  auto copy = std::make_shared<BlobFileCreationInfo>(info);
+  copy->status.PermitUncheckedError();
+  Enqueue([this, copy] { target_->OnBlobFileCreated(*copy); });
+}
+
+void AsyncEventListener::OnBlobFileDeleted(const BlobFileDeletionInfo& info) {
+  auto copy = std::make_shared<BlobFileDeletionInfo>(info);
+  copy->status.PermitUncheckedError();
+  Enqueue([this, copy] { target_->OnBlobFileDeleted(*copy); });
+}
+
+void AsyncEventListener::OnIOError(const IOErrorInfo& info) {
+  auto copy = std::make_shared<IOErrorInfo>(info);
+  copy->io_status.PermitUncheckedError();
+  Enqueue([this, copy] { target_->OnIOError(*copy); });
+}
+
+void AsyncEventListener::OnBackgroundError(BackgroundErrorReason reason,
+                                           Status* bg_error) {
+  target_->OnBackgroundError(reason, bg_error);
+}
+
+void AsyncEventListener::OnErrorRecoveryBegin(BackgroundErrorReason reason,
+                                              Status bg_error,
+                                              bool* auto_recovery) {
+  target_->OnErrorRecoveryBegin(reason, std::move(bg_error), auto_recovery);
+}
+
+void AsyncEventListener::OnColumnFamilyHandleDeletionStarted(
+    ColumnFamilyHandle* handle) {
+  target_->OnColumnFamilyHandleDeletionStarted(handle);
+}
+
+void AsyncEventListener::OnFileReadFinish(const FileOperationInfo& info) {
+  target_->OnFileReadFinish(info);
+}
+
+void AsyncEventListener::OnFileWriteFinish(const FileOperationInfo& info) {
+  target_->OnFileWriteFinish(info);
+}
+
+void AsyncEventListener::OnFileFlushFinish(const FileOperationInfo& info) {
+  target_->OnFileFlushFinish(info);
+}
+
+void AsyncEventListener::OnFileSyncFinish(const FileOperationInfo& info) {
+  target_->OnFileSyncFinish(info);
+}
+
+void AsyncEventListener::OnFileRangeSyncFinish(const FileOperationInfo& info) {
+  target_->OnFileRangeSyncFinish(info);
+}
+
+void AsyncEventListener::OnFileTruncateFinish(const FileOperationInfo& info) {
+  target_->OnFileTruncateFinish(info);
+}
+
+void AsyncEventListener::OnFileCloseFinish(const FileOperationInfo& info) {
+  target_->OnFileCloseFinish(info);
+}
+
+bool AsyncEventListener::ShouldBeNotifiedOnFileIO() {
+  return target_->ShouldBeNotifiedOnFileIO();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,147 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rocksdb/utilities/async_event_listener.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "port/stack_trace.h"
+#include "rocksdb/db.h"
+#include "rocksdb/options.h"
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// Records which thread delivered each callback and can be made to block so
+// the queue fills up.
+class RecordingListener : public EventListener {
+ public:
+  const char* Name() const override { return "RecordingListener"; }
+
+  void OnFlushCompleted(DB* /* db */, const FlushJobInfo& /* info */) override {
+    flush_thread_id_ = std::this_thread::get_id();
+    ++flush_completed_count_;
+    while (block_.load()) {
+      std::this_thread::yield();
+    }
+  }
+
+  void OnBackgroundError(BackgroundErrorReason /* reason */,
+                         Status* bg_error) override {
+    bg_error_thread_id_ = std::this_thread::get_id();
+    *bg_error = Status::OK();
+  }
+
+  std::atomic<int> flush_completed_count_{0};
+  std::atomic<bool> block_{false};
+  std::thread::id flush_thread_id_;
+  std::thread::id bg_error_thread_id_;
+};
+
+}  // namespace
+
+class AsyncEventListenerTest : public testing::Test {};
+
+TEST_F(AsyncEventListenerTest, DeliversOffThread) {
+  auto target = std::make_shared<RecordingListener>();
+  auto async = AsyncEventListener::Wrap(target);
+
+  FlushJobInfo info;
+  async->OnFlushCompleted(nullptr, info);
+  async->WaitForPendingEvents();
+
+  ASSERT_EQ(target->flush_completed_count_.load(), 1);
+  ASSERT_NE(target->flush_thread_id_, std::this_thread::get_id());
+  ASSERT_EQ(async->GetOverflowCount(), 0u);
+}
+
+TEST_F(AsyncEventListenerTest, OverflowDropsAndCounts) {
+  auto target = std::make_shared<RecordingListener>();
+  auto async = AsyncEventListener::Wrap(target, /*max_queue_depth=*/1);
+
+  target->block_.store(true);
+  FlushJobInfo info;
+  // First event may start delivery immediately and block inside the target;
+  // keep producing until the queue has overflowed.
+  while (async->GetOverflowCount() == 0) {
+    async->OnFlushCompleted(nullptr, info);
+  }
+  target->block_.store(false);
+  async->WaitForPendingEvents();
+
+  ASSERT_GT(async->GetOverflowCount(), 0u);
+  // Delivered + dropped accounts for every produced event.
+  ASSERT_GE(target->flush_completed_count_.load(), 1);
+}
+
+TEST_F(AsyncEventListenerTest, DestructorDrainsQueue) {
+  auto target = std::make_shared<RecordingListener>();
+  {
+    auto async = AsyncEventListener::Wrap(target);
+    FlushJobInfo info;
+    for (int i = 0; i < 10; ++i) {
+      async->OnFlushCompleted(nullptr, info);
+    }
+  }
+  ASSERT_EQ(target->flush_completed_count_.load(), 10);
+}
+
+TEST_F(AsyncEventListenerTest, MutatingCallbacksStaySynchronous) {
+  auto target = std::make_shared<RecordingListener>();
+  auto async = AsyncEventListener::Wrap(target);
+
+  Status bg_error = Status::IOError("simulated");
+  async->OnBackgroundError(BackgroundErrorReason::kFlush, &bg_error);
+
+  // The target ran on this thread and its out-parameter write is visible
+  // before the callback returns.
+  ASSERT_EQ(target->bg_error_thread_id_, std::this_thread::get_id());
+  ASSERT_OK(bg_error);
+}
+
+TEST_F(AsyncEventListenerTest, WorksAsRegisteredListener) {
+  auto target = std::make_shared<RecordingListener>();
+  auto async = AsyncEventListener::Wrap(target);
+
+  std::string dbname = test::PerThreadDBPath("async_event_listener");
+  ASSERT_OK(DestroyDB(dbname, Options()));
+
+  Options options;
+  options.create_if_missing = true;
+  options.listeners.push_back(async);
+
+  DB* db = nullptr;
+  ASSERT_OK(DB::Open(options, dbname, &db));
+  ASSERT_OK(db->Put(WriteOptions(), "k", "v"));
+  ASSERT_OK(db->Flush(FlushOptions()));
+  async->WaitForPendingEvents();
+
+  ASSERT_EQ(target->flush_completed_count_.load(), 1);
+  ASSERT_NE(target->flush_thread_id_, std::this_thread::get_id());
+
+  delete db;
+  ASSERT_OK(DestroyDB(dbname, Options()));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
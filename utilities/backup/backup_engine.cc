@@ -838,6 +838,13 @@ class BackupEngineImpl {
       corrupt_backups_;
   std::unordered_map<std::string, std::shared_ptr<FileInfo>>
       backuped_file_infos_;
+  // Checksums computed for live source files by earlier CreateNewBackup
+  // calls on this engine, keyed by source path with the file size recorded
+  // at computation time. Table and blob files are immutable once written,
+  // so a (path, size) match lets an incremental backup reuse the checksum
+  // instead of re-reading the whole file.
+  std::unordered_map<std::string, std::pair<uint64_t, std::string>>
+      src_checksum_cache_;
   std::atomic<bool> stop_backup_;
 
   // options data
@@ -2340,11 +2347,18 @@ IOStatus BackupEngineImpl::AddBackupFileWorkItem(
     // since the session id should suffice to avoid file name collision in
     // the shared_checksum directory.
     if (checksum_hex.empty() && db_session_id.empty()) {
-      IOStatus io_s = ReadFileAndComputeChecksum(
-          src_path, db_fs_, src_env_options, size_limit, &checksum_hex,
-          src_temperature);
-      if (!io_s.ok()) {
-        return io_s;
+      auto cached = src_checksum_cache_.find(src_path);
+      if (cached != src_checksum_cache_.end() &&
+          cached->second.first == size_bytes) {
+        checksum_hex = cached->second.second;
+      } else {
+        IOStatus io_s = ReadFileAndComputeChecksum(
+            src_path, db_fs_, src_env_options, size_limit, &checksum_hex,
+            src_temperature);
+        if (!io_s.ok()) {
+          return io_s;
+        }
+        src_checksum_cache_[src_path] = {size_bytes, checksum_hex};
       }
     }
     if (size_bytes == std::numeric_limits<uint64_t>::max()) {
@@ -2460,11 +2474,18 @@ IOStatus BackupEngineImpl::AddBackupFileWorkItem(
           // ID, but even in that case, we double check the file sizes in
           // BackupMeta::AddFile.
         } else {
-          IOStatus io_s = ReadFileAndComputeChecksum(
-              src_path, db_fs_, src_env_options, size_limit, &checksum_hex,
-              src_temperature);
-          if (!io_s.ok()) {
-            return io_s;
+          auto cached = src_checksum_cache_.find(src_path);
+          if (cached != src_checksum_cache_.end() &&
+              cached->second.first == size_bytes) {
+            checksum_hex = cached->second.second;
+          } else {
+            IOStatus io_s = ReadFileAndComputeChecksum(
+                src_path, db_fs_, src_env_options, size_limit, &checksum_hex,
+                src_temperature);
+            if (!io_s.ok()) {
+              return io_s;
+            }
+            src_checksum_cache_[src_path] = {size_bytes, checksum_hex};
           }
         }
       }
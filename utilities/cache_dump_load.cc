@@ -64,4 +64,55 @@ Status NewDefaultCacheDumpedLoader(
   return Status::OK();
 }
 
+IOStatus DumpCacheToFile(SystemClock* clock,
+                         const std::shared_ptr<Cache>& cache,
+                         const std::vector<DB*>& db_list,
+                         const std::shared_ptr<FileSystem>& fs,
+                         const std::string& file_name) {
+  std::unique_ptr<CacheDumpWriter> writer;
+  IOStatus io_s =
+      NewToFileCacheDumpWriter(fs, FileOptions(), file_name, &writer);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  CacheDumpOptions dump_options;
+  dump_options.clock = clock;
+  std::unique_ptr<CacheDumper> dumper;
+  Status s = NewDefaultCacheDumper(dump_options, cache, std::move(writer),
+                                   &dumper);
+  if (!s.ok()) {
+    return status_to_io_status(std::move(s));
+  }
+  if (!db_list.empty()) {
+    s = dumper->SetDumpFilter(db_list);
+    if (!s.ok()) {
+      return status_to_io_status(std::move(s));
+    }
+  }
+  // DumpCacheEntriesToWriter() closes the writer.
+  return dumper->DumpCacheEntriesToWriter();
+}
+
+IOStatus LoadDumpedCacheFromFile(
+    SystemClock* clock, const BlockBasedTableOptions& toptions,
+    const std::shared_ptr<SecondaryCache>& secondary_cache,
+    const std::shared_ptr<FileSystem>& fs, const std::string& file_name) {
+  std::unique_ptr<CacheDumpReader> reader;
+  IOStatus io_s =
+      NewFromFileCacheDumpReader(fs, FileOptions(), file_name, &reader);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  CacheDumpOptions dump_options;
+  dump_options.clock = clock;
+  std::unique_ptr<CacheDumpedLoader> loader;
+  Status s = NewDefaultCacheDumpedLoader(dump_options, toptions,
+                                         secondary_cache, std::move(reader),
+                                         &loader);
+  if (!s.ok()) {
+    return status_to_io_status(std::move(s));
+  }
+  return loader->RestoreCacheEntriesToSecondaryCache();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
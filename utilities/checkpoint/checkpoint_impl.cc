@@ -11,6 +11,7 @@
 #include "utilities/checkpoint/checkpoint_impl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <string>
 #include <tuple>
@@ -144,7 +145,9 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
                               full_private_path + "/" + fname, contents,
                               db_options.use_fsync);
           } /* create_file_cb */,
-          &sequence_number, log_size_for_flush);
+          &sequence_number, log_size_for_flush,
+          false /* get_live_table_checksum */,
+          db_options.max_file_opening_threads /* max_copy_threads */);
 
       // we copied all the files, enable file deletions
       if (disabled_file_deletions) {
@@ -201,7 +204,7 @@ Status CheckpointImpl::CreateCustomCheckpoint(
                          FileType type)>
         create_file_cb,
     uint64_t* sequence_number, uint64_t log_size_for_flush,
-    bool get_live_table_checksum) {
+    bool get_live_table_checksum, int max_copy_threads) {
   *sequence_number = db_->GetLatestSequenceNumber();
 
   LiveFilesStorageInfoOptions opts;
@@ -231,6 +234,11 @@ Status CheckpointImpl::CreateCustomCheckpoint(
 
   bool same_fs = true;
 
+  // First pass: creates and hard links. These are cheap metadata operations,
+  // and the link callback must be probed in order because a NotSupported
+  // result downgrades all subsequent files to copies. Files that need a copy
+  // are collected and handled in a second pass, which can be parallelized.
+  std::vector<const LiveFileStorageInfo*> files_to_copy;
   for (auto& info : infos) {
     Status s;
     if (!info.replacement_contents.empty()) {
@@ -255,19 +263,7 @@ Status CheckpointImpl::CreateCustomCheckpoint(
         s.MustCheck();
       }
       if (!same_fs || info.trim_to_size) {
-        assert(info.file_checksum_func_name.empty() ==
-               !opts.include_checksum_info);
-        // no assertion on file_checksum because empty is used for both "not
-        // set" and "unknown"
-        if (opts.include_checksum_info) {
-          s = copy_file_cb(info.directory, info.relative_filename, info.size,
-                           info.file_type, info.file_checksum_func_name,
-                           info.file_checksum, info.temperature);
-        } else {
-          s = copy_file_cb(info.directory, info.relative_filename, info.size,
-                           info.file_type, kUnknownFileChecksumFuncName,
-                           kUnknownFileChecksum, info.temperature);
-        }
+        files_to_copy.push_back(&info);
       }
     }
     if (!s.ok()) {
@@ -275,6 +271,63 @@ Status CheckpointImpl::CreateCustomCheckpoint(
     }
   }
 
+  auto copy_one_file = [&](const LiveFileStorageInfo& info) {
+    assert(info.file_checksum_func_name.empty() == !opts.include_checksum_info);
+    // no assertion on file_checksum because empty is used for both "not
+    // set" and "unknown"
+    if (opts.include_checksum_info) {
+      return copy_file_cb(info.directory, info.relative_filename, info.size,
+                          info.file_type, info.file_checksum_func_name,
+                          info.file_checksum, info.temperature);
+    } else {
+      return copy_file_cb(info.directory, info.relative_filename, info.size,
+                          info.file_type, kUnknownFileChecksumFuncName,
+                          kUnknownFileChecksum, info.temperature);
+    }
+  };
+
+  // Second pass: copies. On the same file system this is the MANIFEST plus
+  // any WAL files that need trimming; on a different file system it is every
+  // live file. The copies are independent of each other, so spread them over
+  // multiple threads when the caller allows it.
+  const size_t num_copy_threads =
+      std::max<size_t>(1, std::min(static_cast<size_t>(max_copy_threads),
+                                   files_to_copy.size()));
+  if (num_copy_threads <= 1) {
+    for (const auto* info : files_to_copy) {
+      Status s = copy_one_file(*info);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+  } else {
+    std::vector<Status> copy_statuses(files_to_copy.size());
+    std::atomic<size_t> next_file_idx(0);
+    auto copy_files_func = [&]() {
+      while (true) {
+        size_t idx = next_file_idx.fetch_add(1);
+        if (idx >= files_to_copy.size()) {
+          break;
+        }
+        copy_statuses[idx] = copy_one_file(*files_to_copy[idx]);
+      }
+    };
+    std::vector<port::Thread> copy_threads;
+    copy_threads.reserve(num_copy_threads - 1);
+    for (size_t i = 1; i < num_copy_threads; i++) {
+      copy_threads.emplace_back(copy_files_func);
+    }
+    copy_files_func();
+    for (auto& t : copy_threads) {
+      t.join();
+    }
+    for (const Status& s : copy_statuses) {
+      if (!s.ok()) {
+        return s;
+      }
+    }
+  }
+
   return Status::OK();
 }
 
@@ -27,6 +27,10 @@ class CheckpointImpl : public Checkpoint {
 
   // Checkpoint logic can be customized by providing callbacks for link, copy,
   // or create.
+  //
+  // When max_copy_threads > 1, copy_file_cb may be invoked from that many
+  // threads concurrently, so it must be thread-safe. Link and create
+  // callbacks are always invoked serially.
   Status CreateCustomCheckpoint(
       std::function<Status(const std::string& src_dirname,
                            const std::string& fname, FileType type)>
@@ -41,7 +45,7 @@ class CheckpointImpl : public Checkpoint {
                            const std::string& contents, FileType type)>
           create_file_cb,
       uint64_t* sequence_number, uint64_t log_size_for_flush,
-      bool get_live_table_checksum = false);
+      bool get_live_table_checksum = false, int max_copy_threads = 1);
 
  private:
   void CleanStagingDirectory(const std::string& path, Logger* info_log);
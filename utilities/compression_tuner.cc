@@ -0,0 +1,204 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rocksdb/utilities/compression_tuner.h"
+
+#include <cstdlib>
+
+#include "logging/logging.h"
+#include "rocksdb/convenience.h"
+#include "rocksdb/db.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct CompressionTuner::CFState {
+  DB* db = nullptr;
+  ColumnFamilyHandle* cf = nullptr;
+  bool fast = false;
+  int calm_events = 0;
+};
+
+namespace {
+
+Status EncodeCompressionPerLevel(const std::vector<CompressionType>& per_level,
+                                 std::string* encoded) {
+  encoded->clear();
+  for (const CompressionType type : per_level) {
+    std::string name;
+    Status s = GetStringFromCompressionType(&name, type);
+    if (!s.ok()) {
+      return s;
+    }
+    if (!encoded->empty()) {
+      encoded->push_back(':');
+    }
+    encoded->append(name);
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+CompressionTuner::CompressionTuner(const CompressionTunerOptions& options)
+    : options_(options) {}
+
+CompressionTuner::~CompressionTuner() = default;
+
+Status CompressionTuner::ManageColumnFamily(DB* db, ColumnFamilyHandle* cf) {
+  if (db == nullptr || cf == nullptr) {
+    return Status::InvalidArgument("db and cf must be non-null");
+  }
+  if (options_.tight_compression_per_level.empty() ||
+      options_.fast_compression_per_level.empty()) {
+    return Status::InvalidArgument(
+        "both compression profiles must be non-empty");
+  }
+
+  // Apply the tight profile up front so the tuner's notion of the current
+  // profile matches the column family's options.
+  Status s = ApplyProfile(db, cf, false /* fast */);
+  if (!s.ok()) {
+    return s;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& state = cf_states_[cf->GetName()];
+  state.reset(new CFState());
+  state->db = db;
+  state->cf = cf;
+  return Status::OK();
+}
+
+bool CompressionTuner::IsOnFastProfile(const std::string& cf_name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = cf_states_.find(cf_name);
+  return it != cf_states_.end() && it->second->fast;
+}
+
+void CompressionTuner::OnFlushCompleted(DB* db, const FlushJobInfo& info) {
+  Evaluate(db, info.cf_name);
+}
+
+void CompressionTuner::OnCompactionCompleted(DB* db,
+                                             const CompactionJobInfo& info) {
+  Evaluate(db, info.cf_name);
+}
+
+bool CompressionTuner::IsUnderPressure(DB* db, ColumnFamilyHandle* cf) const {
+  const Options opts = db->GetOptions(cf);
+
+  if (opts.soft_pending_compaction_bytes_limit > 0) {
+    uint64_t pending_bytes = 0;
+    if (db->GetIntProperty(cf, DB::Properties::kEstimatePendingCompactionBytes,
+                           &pending_bytes) &&
+        static_cast<double>(pending_bytes) >=
+            options_.pending_compaction_bytes_ratio *
+                static_cast<double>(
+                    opts.soft_pending_compaction_bytes_limit)) {
+      return true;
+    }
+  }
+
+  if (opts.level0_slowdown_writes_trigger > 0) {
+    std::string l0_files_str;
+    if (db->GetProperty(cf, DB::Properties::kNumFilesAtLevelPrefix + "0",
+                        &l0_files_str) &&
+        std::atoi(l0_files_str.c_str()) >=
+            options_.l0_files_ratio * opts.level0_slowdown_writes_trigger) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void CompressionTuner::Evaluate(DB* db, const std::string& cf_name) {
+  ColumnFamilyHandle* cf = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = cf_states_.find(cf_name);
+    if (it == cf_states_.end() || it->second->db != db) {
+      return;
+    }
+    cf = it->second->cf;
+  }
+
+  const bool pressure = IsUnderPressure(db, cf);
+
+  bool switch_to_fast = false;
+  bool switch_to_tight = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = cf_states_.find(cf_name);
+    if (it == cf_states_.end() || it->second->db != db) {
+      return;
+    }
+    CFState* state = it->second.get();
+    if (pressure) {
+      state->calm_events = 0;
+      if (!state->fast) {
+        state->fast = true;
+        switch_to_fast = true;
+      }
+    } else if (state->fast) {
+      ++state->calm_events;
+      if (state->calm_events >= options_.calm_events_before_tightening) {
+        state->fast = false;
+        state->calm_events = 0;
+        switch_to_tight = true;
+      }
+    }
+  }
+
+  if (switch_to_fast || switch_to_tight) {
+    const Status s = ApplyProfile(db, cf, switch_to_fast);
+    if (!s.ok()) {
+      // Roll the state back so the switch is retried on the next event.
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto it = cf_states_.find(cf_name);
+      if (it != cf_states_.end() && it->second->db == db) {
+        it->second->fast = !switch_to_fast;
+        it->second->calm_events = 0;
+      }
+    }
+  }
+}
+
+Status CompressionTuner::ApplyProfile(DB* db, ColumnFamilyHandle* cf,
+                                      bool fast) const {
+  std::string encoded;
+  Status s = EncodeCompressionPerLevel(
+      fast ? options_.fast_compression_per_level
+           : options_.tight_compression_per_level,
+      &encoded);
+  if (s.ok()) {
+    s = db->SetOptions(cf, {{"compression_per_level", encoded}});
+  }
+  const auto info_log = db->GetDBOptions().info_log;
+  if (s.ok()) {
+    ROCKS_LOG_INFO(info_log,
+                   "[%s] CompressionTuner switched to the %s profile (%s)",
+                   cf->GetName().c_str(), fast ? "fast" : "tight",
+                   encoded.c_str());
+  } else {
+    ROCKS_LOG_WARN(info_log,
+                   "[%s] CompressionTuner failed to switch to the %s profile: "
+                   "%s",
+                   cf->GetName().c_str(), fast ? "fast" : "tight",
+                   s.ToString().c_str());
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
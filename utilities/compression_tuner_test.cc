@@ -0,0 +1,142 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rocksdb/utilities/compression_tuner.h"
+
+#include <atomic>
+#include <memory>
+
+#include "port/stack_trace.h"
+#include "rocksdb/db.h"
+#include "rocksdb/options.h"
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// Replaces the pressure signal with a switch so transitions can be driven
+// deterministically.
+class TestCompressionTuner : public CompressionTuner {
+ public:
+  using CompressionTuner::CompressionTuner;
+
+  std::atomic<bool> pressure{false};
+
+ protected:
+  bool IsUnderPressure(DB* /* db */,
+                       ColumnFamilyHandle* /* cf */) const override {
+    return pressure.load();
+  }
+};
+
+}  // namespace
+
+class CompressionTunerTest : public testing::Test {
+ public:
+  CompressionTunerTest() : dbname_(test::PerThreadDBPath("compression_tuner")) {
+    EXPECT_OK(DestroyDB(dbname_, Options()));
+  }
+
+  ~CompressionTunerTest() override {
+    if (db_ != nullptr) {
+      delete db_;
+    }
+    EXPECT_OK(DestroyDB(dbname_, Options()));
+  }
+
+  void OpenDB(const std::shared_ptr<CompressionTuner>& tuner) {
+    Options options;
+    options.create_if_missing = true;
+    options.listeners.push_back(tuner);
+    ASSERT_OK(DB::Open(options, dbname_, &db_));
+  }
+
+  void FlushOne(int key) {
+    ASSERT_OK(db_->Put(WriteOptions(), "key" + std::to_string(key), "value"));
+    ASSERT_OK(db_->Flush(FlushOptions()));
+  }
+
+  std::vector<CompressionType> CurrentPerLevel() {
+    return db_->GetOptions(db_->DefaultColumnFamily()).compression_per_level;
+  }
+
+  std::string dbname_;
+  DB* db_ = nullptr;
+};
+
+TEST_F(CompressionTunerTest, SwitchesProfilesUnderPressure) {
+  // The profiles only use kNoCompression so the test does not depend on
+  // which compression libraries are compiled in; they are distinguished by
+  // their lengths.
+  CompressionTunerOptions tuner_options;
+  tuner_options.tight_compression_per_level = {kNoCompression, kNoCompression,
+                                               kNoCompression};
+  tuner_options.fast_compression_per_level = {kNoCompression};
+  tuner_options.calm_events_before_tightening = 2;
+
+  auto tuner = std::make_shared<TestCompressionTuner>(tuner_options);
+  OpenDB(tuner);
+
+  ASSERT_OK(tuner->ManageColumnFamily(db_, db_->DefaultColumnFamily()));
+  ASSERT_FALSE(tuner->IsOnFastProfile("default"));
+  ASSERT_EQ(3U, CurrentPerLevel().size());
+
+  // A flush under pressure switches to the fast profile.
+  tuner->pressure = true;
+  FlushOne(0);
+  ASSERT_TRUE(tuner->IsOnFastProfile("default"));
+  ASSERT_EQ(1U, CurrentPerLevel().size());
+
+  // One calm flush is not enough to switch back...
+  tuner->pressure = false;
+  FlushOne(1);
+  ASSERT_TRUE(tuner->IsOnFastProfile("default"));
+  ASSERT_EQ(1U, CurrentPerLevel().size());
+
+  // ... but reaching calm_events_before_tightening is.
+  FlushOne(2);
+  ASSERT_FALSE(tuner->IsOnFastProfile("default"));
+  ASSERT_EQ(3U, CurrentPerLevel().size());
+
+  // Renewed pressure interrupts the calm streak immediately.
+  tuner->pressure = true;
+  FlushOne(3);
+  ASSERT_TRUE(tuner->IsOnFastProfile("default"));
+  ASSERT_EQ(1U, CurrentPerLevel().size());
+}
+
+TEST_F(CompressionTunerTest, InvalidConfiguration) {
+  CompressionTunerOptions tuner_options;
+  auto tuner = std::make_shared<TestCompressionTuner>(tuner_options);
+  OpenDB(tuner);
+
+  // Both profiles must be set.
+  ASSERT_TRUE(tuner->ManageColumnFamily(db_, db_->DefaultColumnFamily())
+                  .IsInvalidArgument());
+  ASSERT_TRUE(tuner->ManageColumnFamily(nullptr, nullptr).IsInvalidArgument());
+
+  // Unmanaged column families are left alone.
+  tuner->pressure = true;
+  FlushOne(0);
+  ASSERT_FALSE(tuner->IsOnFastProfile("default"));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
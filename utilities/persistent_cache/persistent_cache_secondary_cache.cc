@@ -0,0 +1,101 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utilities/persistent_cache/persistent_cache_secondary_cache.h"
+
+#include <cassert>
+
+namespace ROCKSDB_NAMESPACE {
+
+PersistentCacheSecondaryCache::PersistentCacheSecondaryCache(
+    const std::shared_ptr<PersistentCache>& cache)
+    : cache_(cache) {
+  assert(cache_);
+  // The tier must store raw uncompressed blocks; the serialized-block format
+  // used by the legacy BlockBasedTableOptions::persistent_cache hook cannot
+  // be reconstructed through the helper's create callback.
+  assert(!cache_->IsCompressed());
+}
+
+Status PersistentCacheSecondaryCache::Insert(
+    const Slice& key, Cache::ObjectPtr value,
+    const Cache::CacheItemHelper* helper) {
+  if (value == nullptr) {
+    return Status::InvalidArgument();
+  }
+  assert(helper != nullptr);
+  assert(helper->size_cb != nullptr && helper->saveto_cb != nullptr);
+
+  size_t size = (*helper->size_cb)(value);
+  std::unique_ptr<char[]> buf(new char[size]);
+  Status s = (*helper->saveto_cb)(value, 0, size, buf.get());
+  if (!s.ok()) {
+    return s;
+  }
+  // The persistent tier copies the bytes (or queues them through its write
+  // pipeline) and applies its own admission control; a drop because the
+  // insert path is saturated is still an OK insert from our point of view.
+  return cache_->Insert(key, buf.get(), size);
+}
+
+std::unique_ptr<SecondaryCacheResultHandle>
+PersistentCacheSecondaryCache::Lookup(const Slice& key,
+                                      const Cache::CacheItemHelper* helper,
+                                      Cache::CreateContext* create_context,
+                                      bool /*wait*/, bool /*advise_erase*/,
+                                      bool& kept_in_sec_cache) {
+  assert(helper != nullptr);
+  kept_in_sec_cache = false;
+
+  std::unique_ptr<char[]> data;
+  size_t size = 0;
+  Status s = cache_->Lookup(key, &data, &size);
+  if (!s.ok()) {
+    return nullptr;
+  }
+
+  Cache::ObjectPtr value{nullptr};
+  size_t charge{0};
+  s = helper->create_cb(Slice(data.get(), size), create_context,
+                        /*allocator=*/nullptr, &value, &charge);
+  if (!s.ok()) {
+    return nullptr;
+  }
+
+  // PersistentCache has no erase, so the entry stays in the tier until its
+  // cache file is evicted; advise_erase cannot be honored.
+  kept_in_sec_cache = true;
+  return std::unique_ptr<SecondaryCacheResultHandle>(
+      new PersistentCacheSecondaryCacheResultHandle(value, charge));
+}
+
+void PersistentCacheSecondaryCache::WaitAll(
+    std::vector<SecondaryCacheResultHandle*> handles) {
+  // Lookups are synchronous, so all handles are already ready.
+  (void)handles;
+}
+
+std::string PersistentCacheSecondaryCache::GetPrintableOptions() const {
+  return cache_->GetPrintableOptions();
+}
+
+std::shared_ptr<SecondaryCache> NewPersistentCacheSecondaryCache(
+    const std::shared_ptr<PersistentCache>& persistent_cache) {
+  if (!persistent_cache || persistent_cache->IsCompressed()) {
+    return nullptr;
+  }
+  return std::make_shared<PersistentCacheSecondaryCache>(persistent_cache);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,95 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "rocksdb/persistent_cache.h"
+#include "rocksdb/secondary_cache.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Lookups against the persistent tier complete synchronously (the tier copies
+// the block into a freshly allocated buffer), so the handle is always ready.
+class PersistentCacheSecondaryCacheResultHandle
+    : public SecondaryCacheResultHandle {
+ public:
+  PersistentCacheSecondaryCacheResultHandle(Cache::ObjectPtr value, size_t size)
+      : value_(value), size_(size) {}
+  ~PersistentCacheSecondaryCacheResultHandle() override = default;
+
+  PersistentCacheSecondaryCacheResultHandle(
+      const PersistentCacheSecondaryCacheResultHandle&) = delete;
+  PersistentCacheSecondaryCacheResultHandle& operator=(
+      const PersistentCacheSecondaryCacheResultHandle&) = delete;
+
+  bool IsReady() override { return true; }
+
+  void Wait() override {}
+
+  Cache::ObjectPtr Value() override { return value_; }
+
+  size_t Size() override { return size_; }
+
+ private:
+  Cache::ObjectPtr value_;
+  size_t size_;
+};
+
+// PersistentCacheSecondaryCache
+//
+// Adapter that plugs a PersistentCache (e.g. the file-backed NVMe tier
+// created by NewPersistentCache()) into the SecondaryCache interface, so it
+// participates in block cache tiering through
+// LRUCacheOptions::secondary_cache instead of the legacy
+// BlockBasedTableOptions::persistent_cache hook. Insert serializes the block
+// with the helper's save callback and hands the bytes to the persistent
+// tier, whose own write pipeline applies buffering and drop-on-full
+// admission; Lookup reads the bytes back and reconstructs the block with the
+// helper's create callback. Lookups complete synchronously, so the returned
+// handles are always ready.
+//
+// The wrapped cache must store uncompressed (parsed-out) data, i.e.
+// PersistentCache::IsCompressed() must be false; the serialized-block format
+// of the legacy hook has no meaning for cache tiering.
+class PersistentCacheSecondaryCache : public SecondaryCache {
+ public:
+  explicit PersistentCacheSecondaryCache(
+      const std::shared_ptr<PersistentCache>& cache);
+
+  const char* Name() const override { return "PersistentCacheSecondaryCache"; }
+
+  Status Insert(const Slice& key, Cache::ObjectPtr value,
+                const Cache::CacheItemHelper* helper) override;
+
+  std::unique_ptr<SecondaryCacheResultHandle> Lookup(
+      const Slice& key, const Cache::CacheItemHelper* helper,
+      Cache::CreateContext* create_context, bool wait, bool advise_erase,
+      bool& kept_in_sec_cache) override;
+
+  bool SupportForceErase() const override { return false; }
+
+  // PersistentCache has no erase; entries age out with their cache files.
+  void Erase(const Slice& /*key*/) override {}
+
+  void WaitAll(std::vector<SecondaryCacheResultHandle*> handles) override;
+
+  std::string GetPrintableOptions() const override;
+
+ private:
+  std::shared_ptr<PersistentCache> cache_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -14,7 +14,9 @@
 #include <thread>
 
 #include "file/file_util.h"
+#include "rocksdb/secondary_cache.h"
 #include "utilities/persistent_cache/block_cache_tier.h"
+#include "utilities/persistent_cache/persistent_cache_secondary_cache.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -281,6 +283,77 @@ TEST_F(PersistentCacheTierTest, FactoryTest) {
   }
 }
 
+namespace {
+void DeleteStringValue(Cache::ObjectPtr obj, MemoryAllocator* /*allocator*/) {
+  delete static_cast<std::string*>(obj);
+}
+
+size_t StringValueSize(Cache::ObjectPtr obj) {
+  return static_cast<std::string*>(obj)->size();
+}
+
+Status StringValueSaveTo(Cache::ObjectPtr from_obj, size_t from_offset,
+                         size_t length, char* out) {
+  const std::string& str = *static_cast<std::string*>(from_obj);
+  memcpy(out, str.data() + from_offset, length);
+  return Status::OK();
+}
+
+Status CreateStringValue(const Slice& data, Cache::CreateContext* /*context*/,
+                         MemoryAllocator* /*allocator*/,
+                         Cache::ObjectPtr* out_obj, size_t* out_charge) {
+  *out_obj = new std::string(data.data(), data.size());
+  *out_charge = data.size();
+  return Status::OK();
+}
+}  // namespace
+
+TEST_F(PersistentCacheTierTest, SecondaryCacheAdapterTest) {
+  static Cache::CacheItemHelper kHelperNoSecondary{CacheEntryRole::kMisc,
+                                                   &DeleteStringValue};
+  static Cache::CacheItemHelper kHelper{
+      CacheEntryRole::kMisc, &DeleteStringValue, &StringValueSize,
+      &StringValueSaveTo,    &CreateStringValue, &kHelperNoSecondary};
+
+  // Compressed tiers and nullptr cannot back the adapter
+  ASSERT_EQ(NewPersistentCacheSecondaryCache(
+                std::make_shared<VolatileCacheTier>(/*is_compressed=*/true)),
+            nullptr);
+  ASSERT_EQ(NewPersistentCacheSecondaryCache(nullptr), nullptr);
+
+  std::shared_ptr<SecondaryCache> sec_cache = NewPersistentCacheSecondaryCache(
+      std::make_shared<VolatileCacheTier>(/*is_compressed=*/false));
+  ASSERT_TRUE(sec_cache);
+
+  std::string v1("v1");
+  ASSERT_OK(sec_cache->Insert("k1", &v1, &kHelper));
+  ASSERT_OK(sec_cache->InsertSaved("k2", "v2"));
+
+  bool kept_in_sec_cache{false};
+  std::unique_ptr<SecondaryCacheResultHandle> handle = sec_cache->Lookup(
+      "k1", &kHelper, /*create_context=*/nullptr, /*wait=*/true,
+      /*advise_erase=*/false, kept_in_sec_cache);
+  ASSERT_TRUE(handle);
+  ASSERT_TRUE(handle->IsReady());
+  ASSERT_TRUE(kept_in_sec_cache);
+  std::unique_ptr<std::string> val1(static_cast<std::string*>(handle->Value()));
+  ASSERT_EQ(*val1, "v1");
+  ASSERT_EQ(handle->Size(), val1->size());
+
+  handle = sec_cache->Lookup("k2", &kHelper, /*create_context=*/nullptr,
+                             /*wait=*/true, /*advise_erase=*/false,
+                             kept_in_sec_cache);
+  ASSERT_TRUE(handle);
+  std::unique_ptr<std::string> val2(static_cast<std::string*>(handle->Value()));
+  ASSERT_EQ(*val2, "v2");
+
+  handle = sec_cache->Lookup("missing", &kHelper, /*create_context=*/nullptr,
+                             /*wait=*/true, /*advise_erase=*/false,
+                             kept_in_sec_cache);
+  ASSERT_EQ(handle, nullptr);
+  ASSERT_FALSE(kept_in_sec_cache);
+}
+
 PersistentCacheDBTest::PersistentCacheDBTest()
     : DBTestBase("cache_test", /*env_do_fsync=*/true) {
 #ifdef OS_LINUX
@@ -0,0 +1,265 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rocksdb/utilities/stats_ring_file.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "rocksdb/env.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// File layout: a kHeaderSize header followed by `capacity` records of
+// RecordSize() bytes each. Everything is little-endian fixed-width, so a
+// record is written with one positioned write and the layout is stable as
+// long as the ticker and histogram enums are.
+//
+// Header:  magic (8) | capacity (4) | num tickers (4) | num histograms (4)
+// Record:  sequence (8) | timestamp micros (8)
+//          | ticker values (8 each)
+//          | histograms (9 fields of 8 bytes each)
+//          | crc32c of all of the above (4)
+
+constexpr char kMagic[8] = {'S', 'P', 'D', 'B', 'S', 'T', 'R', '1'};
+constexpr size_t kHeaderSize = 20;
+constexpr size_t kHistogramFields = 9;
+
+size_t RecordSize() {
+  return 8 + 8 + TICKER_ENUM_MAX * 8 +
+         HISTOGRAM_ENUM_MAX * kHistogramFields * 8 + 4;
+}
+
+uint64_t RecordOffset(uint32_t slot) {
+  return kHeaderSize + static_cast<uint64_t>(slot) * RecordSize();
+}
+
+void PutDouble(std::string* dst, double value) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(value), "unexpected double size");
+  memcpy(&bits, &value, sizeof(bits));
+  PutFixed64(dst, bits);
+}
+
+double DecodeDouble(const char* ptr) {
+  uint64_t bits = DecodeFixed64(ptr);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+Status StatsRingFile::Open(Env* env, const std::string& fname,
+                           uint32_t capacity,
+                           std::unique_ptr<StatsRingFile>* ring) {
+  assert(ring != nullptr);
+  ring->reset();
+  if (capacity == 0) {
+    return Status::InvalidArgument("Ring capacity must be non-zero");
+  }
+
+  Status s = env->FileExists(fname);
+  const bool create = s.IsNotFound();
+  if (!s.ok() && !create) {
+    return s;
+  }
+
+  if (create) {
+    // NewRandomRWFile does not create files, so lay the file out first. The
+    // record area is left sparse; unwritten slots fail their checksum and
+    // are skipped by readers.
+    std::unique_ptr<WritableFile> init_file;
+    s = env->NewWritableFile(fname, &init_file, EnvOptions());
+    if (!s.ok()) {
+      return s;
+    }
+    std::string header(kMagic, sizeof(kMagic));
+    PutFixed32(&header, capacity);
+    PutFixed32(&header, static_cast<uint32_t>(TICKER_ENUM_MAX));
+    PutFixed32(&header, static_cast<uint32_t>(HISTOGRAM_ENUM_MAX));
+    assert(header.size() == kHeaderSize);
+    s = init_file->Append(header);
+    if (s.ok()) {
+      s = init_file->Close();
+    }
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  std::unique_ptr<RandomRWFile> file;
+  s = env->NewRandomRWFile(fname, &file, EnvOptions());
+  if (!s.ok()) {
+    return s;
+  }
+
+  char header_scratch[kHeaderSize];
+  Slice header;
+  s = file->Read(0, kHeaderSize, &header, header_scratch);
+  if (!s.ok()) {
+    return s;
+  }
+  if (header.size() != kHeaderSize ||
+      memcmp(header.data(), kMagic, sizeof(kMagic)) != 0) {
+    return Status::InvalidArgument(fname, "Not a stats ring file");
+  }
+  const uint32_t file_capacity = DecodeFixed32(header.data() + 8);
+  const uint32_t file_tickers = DecodeFixed32(header.data() + 12);
+  const uint32_t file_histograms = DecodeFixed32(header.data() + 16);
+  if (file_capacity != capacity) {
+    return Status::InvalidArgument(fname, "Ring capacity mismatch");
+  }
+  if (file_tickers != static_cast<uint32_t>(TICKER_ENUM_MAX) ||
+      file_histograms != static_cast<uint32_t>(HISTOGRAM_ENUM_MAX)) {
+    return Status::InvalidArgument(fname,
+                                   "Statistics schema mismatch, the file was "
+                                   "written by an incompatible version");
+  }
+
+  std::unique_ptr<StatsRingFile> result(
+      new StatsRingFile(env, std::move(file), capacity, /*next_sequence=*/1));
+  if (!create) {
+    // Resume after the newest snapshot already in the file.
+    StatsSnapshot snapshot;
+    for (uint32_t slot = 0; slot < capacity; slot++) {
+      if (result->ReadRecord(slot, &snapshot).ok() &&
+          snapshot.sequence >= result->next_sequence_) {
+        result->next_sequence_ = snapshot.sequence + 1;
+      }
+    }
+  }
+  *ring = std::move(result);
+  return Status::OK();
+}
+
+StatsRingFile::StatsRingFile(Env* env, std::unique_ptr<RandomRWFile>&& file,
+                             uint32_t capacity, uint64_t next_sequence)
+    : env_(env),
+      file_(std::move(file)),
+      capacity_(capacity),
+      next_sequence_(next_sequence) {}
+
+StatsRingFile::~StatsRingFile() {
+  if (file_) {
+    file_->Close().PermitUncheckedError();
+  }
+}
+
+Status StatsRingFile::Append(Statistics* statistics) {
+  assert(statistics != nullptr);
+
+  std::string record;
+  record.reserve(RecordSize());
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  const uint64_t sequence = next_sequence_;
+
+  PutFixed64(&record, sequence);
+  PutFixed64(&record, env_->NowMicros());
+  for (uint32_t t = 0; t < TICKER_ENUM_MAX; t++) {
+    PutFixed64(&record, statistics->getTickerCount(t));
+  }
+  HistogramData histogram;
+  for (uint32_t h = 0; h < HISTOGRAM_ENUM_MAX; h++) {
+    statistics->histogramData(h, &histogram);
+    PutDouble(&record, histogram.median);
+    PutDouble(&record, histogram.percentile95);
+    PutDouble(&record, histogram.percentile99);
+    PutDouble(&record, histogram.average);
+    PutDouble(&record, histogram.standard_deviation);
+    PutDouble(&record, histogram.max);
+    PutFixed64(&record, histogram.count);
+    PutFixed64(&record, histogram.sum);
+    PutDouble(&record, histogram.min);
+  }
+  PutFixed32(&record, crc32c::Value(record.data(), record.size()));
+  assert(record.size() == RecordSize());
+
+  const uint32_t slot = static_cast<uint32_t>((sequence - 1) % capacity_);
+  Status s = file_->Write(RecordOffset(slot), record);
+  if (s.ok()) {
+    s = file_->Flush();
+  }
+  if (s.ok()) {
+    next_sequence_ = sequence + 1;
+  }
+  return s;
+}
+
+Status StatsRingFile::ReadRecord(uint32_t slot, StatsSnapshot* snapshot) const {
+  const size_t record_size = RecordSize();
+  std::string scratch(record_size, '\0');
+  Slice record;
+  Status s = file_->Read(RecordOffset(slot), record_size, &record, &scratch[0]);
+  if (!s.ok()) {
+    return s;
+  }
+  if (record.size() != record_size) {
+    return Status::Corruption("Short stats ring record");
+  }
+  const char* p = record.data();
+  if (crc32c::Value(p, record_size - 4) !=
+      DecodeFixed32(p + record_size - 4)) {
+    return Status::Corruption("Stats ring record checksum mismatch");
+  }
+
+  snapshot->sequence = DecodeFixed64(p);
+  snapshot->timestamp_micros = DecodeFixed64(p + 8);
+  p += 16;
+  snapshot->tickers.resize(TICKER_ENUM_MAX);
+  for (uint32_t t = 0; t < TICKER_ENUM_MAX; t++) {
+    snapshot->tickers[t] = DecodeFixed64(p);
+    p += 8;
+  }
+  snapshot->histograms.resize(HISTOGRAM_ENUM_MAX);
+  for (uint32_t h = 0; h < HISTOGRAM_ENUM_MAX; h++) {
+    HistogramData& histogram = snapshot->histograms[h];
+    histogram.median = DecodeDouble(p);
+    histogram.percentile95 = DecodeDouble(p + 8);
+    histogram.percentile99 = DecodeDouble(p + 16);
+    histogram.average = DecodeDouble(p + 24);
+    histogram.standard_deviation = DecodeDouble(p + 32);
+    histogram.max = DecodeDouble(p + 40);
+    histogram.count = DecodeFixed64(p + 48);
+    histogram.sum = DecodeFixed64(p + 56);
+    histogram.min = DecodeDouble(p + 64);
+    p += kHistogramFields * 8;
+  }
+  return Status::OK();
+}
+
+Status StatsRingFile::ReadAll(std::vector<StatsSnapshot>* snapshots) const {
+  assert(snapshots != nullptr);
+  snapshots->clear();
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (uint32_t slot = 0; slot < capacity_; slot++) {
+    StatsSnapshot snapshot;
+    if (ReadRecord(slot, &snapshot).ok()) {
+      snapshots->push_back(std::move(snapshot));
+    }
+  }
+  std::sort(snapshots->begin(), snapshots->end(),
+            [](const StatsSnapshot& a, const StatsSnapshot& b) {
+              return a.sequence < b.sequence;
+            });
+  return Status::OK();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,129 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rocksdb/utilities/stats_ring_file.h"
+
+#include <memory>
+
+#include "port/stack_trace.h"
+#include "rocksdb/env.h"
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class StatsRingFileTest : public testing::Test {
+ public:
+  StatsRingFileTest()
+      : env_(Env::Default()),
+        fname_(test::PerThreadDBPath("stats_ring_file_test") + ".ring") {
+    env_->DeleteFile(fname_).PermitUncheckedError();
+  }
+
+  ~StatsRingFileTest() override {
+    env_->DeleteFile(fname_).PermitUncheckedError();
+  }
+
+  Env* env_;
+  std::string fname_;
+};
+
+TEST_F(StatsRingFileTest, RoundTrip) {
+  std::unique_ptr<StatsRingFile> ring;
+  ASSERT_OK(StatsRingFile::Open(env_, fname_, 8, &ring));
+
+  auto stats = CreateDBStatistics();
+  stats->recordTick(BYTES_WRITTEN, 42);
+  ASSERT_OK(ring->Append(stats.get()));
+  stats->recordTick(BYTES_WRITTEN, 100);
+  stats->recordTick(NO_FILE_OPENS, 7);
+  ASSERT_OK(ring->Append(stats.get()));
+
+  std::vector<StatsSnapshot> snapshots;
+  ASSERT_OK(ring->ReadAll(&snapshots));
+  ASSERT_EQ(2u, snapshots.size());
+  ASSERT_EQ(1u, snapshots[0].sequence);
+  ASSERT_EQ(42u, snapshots[0].tickers[BYTES_WRITTEN]);
+  ASSERT_EQ(0u, snapshots[0].tickers[NO_FILE_OPENS]);
+  ASSERT_EQ(2u, snapshots[1].sequence);
+  ASSERT_EQ(142u, snapshots[1].tickers[BYTES_WRITTEN]);
+  ASSERT_EQ(7u, snapshots[1].tickers[NO_FILE_OPENS]);
+  ASSERT_LE(snapshots[0].timestamp_micros, snapshots[1].timestamp_micros);
+  ASSERT_EQ(static_cast<size_t>(HISTOGRAM_ENUM_MAX),
+            snapshots[0].histograms.size());
+}
+
+TEST_F(StatsRingFileTest, WrapAround) {
+  constexpr uint32_t kCapacity = 4;
+  std::unique_ptr<StatsRingFile> ring;
+  ASSERT_OK(StatsRingFile::Open(env_, fname_, kCapacity, &ring));
+
+  auto stats = CreateDBStatistics();
+  for (int i = 0; i < 6; i++) {
+    stats->recordTick(BYTES_WRITTEN, 1);
+    ASSERT_OK(ring->Append(stats.get()));
+  }
+
+  // The two oldest snapshots have been overwritten.
+  std::vector<StatsSnapshot> snapshots;
+  ASSERT_OK(ring->ReadAll(&snapshots));
+  ASSERT_EQ(static_cast<size_t>(kCapacity), snapshots.size());
+  for (uint32_t i = 0; i < kCapacity; i++) {
+    ASSERT_EQ(3u + i, snapshots[i].sequence);
+    ASSERT_EQ(3u + i, snapshots[i].tickers[BYTES_WRITTEN]);
+  }
+}
+
+TEST_F(StatsRingFileTest, ReopenResumesSequence) {
+  auto stats = CreateDBStatistics();
+  {
+    std::unique_ptr<StatsRingFile> ring;
+    ASSERT_OK(StatsRingFile::Open(env_, fname_, 8, &ring));
+    ASSERT_OK(ring->Append(stats.get()));
+    ASSERT_OK(ring->Append(stats.get()));
+  }
+
+  std::unique_ptr<StatsRingFile> ring;
+  ASSERT_OK(StatsRingFile::Open(env_, fname_, 8, &ring));
+  ASSERT_OK(ring->Append(stats.get()));
+
+  std::vector<StatsSnapshot> snapshots;
+  ASSERT_OK(ring->ReadAll(&snapshots));
+  ASSERT_EQ(3u, snapshots.size());
+  ASSERT_EQ(3u, snapshots.back().sequence);
+}
+
+TEST_F(StatsRingFileTest, RejectsMismatchedFile) {
+  {
+    std::unique_ptr<StatsRingFile> ring;
+    ASSERT_OK(StatsRingFile::Open(env_, fname_, 8, &ring));
+  }
+
+  // Same file, different capacity.
+  std::unique_ptr<StatsRingFile> ring;
+  ASSERT_TRUE(StatsRingFile::Open(env_, fname_, 16, &ring).IsInvalidArgument());
+
+  // Not a ring file at all.
+  std::string other = fname_ + ".other";
+  ASSERT_OK(WriteStringToFile(env_, "not a ring file header", other));
+  ASSERT_TRUE(StatsRingFile::Open(env_, other, 8, &ring).IsInvalidArgument());
+  ASSERT_OK(env_->DeleteFile(other));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
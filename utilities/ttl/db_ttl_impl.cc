@@ -184,6 +184,63 @@ void DBWithTTLImpl::SanitizeOptions(int32_t ttl, ColumnFamilyOptions* options,
     options->merge_operator.reset(
         new TtlMergeOperator(options->merge_operator, clock));
   }
+
+  options->table_properties_collector_factories.push_back(
+      std::make_shared<TtlPropertiesCollectorFactory>(ttl, clock));
+}
+
+const std::string TtlPropertiesCollector::kMinTimestampPropertyName =
+    "rocksdb.ttl.min.timestamp";
+const std::string TtlPropertiesCollector::kMaxTimestampPropertyName =
+    "rocksdb.ttl.max.timestamp";
+
+Status TtlPropertiesCollector::AddUserKey(const Slice& /*key*/,
+                                          const Slice& value, EntryType type,
+                                          SequenceNumber /*seq*/,
+                                          uint64_t /*file_size*/) {
+  // Only puts and merge operands carry the trailing write timestamp;
+  // deletions have no value to inspect.
+  if (type != kEntryPut && type != kEntryMerge) {
+    return Status::OK();
+  }
+  if (value.size() < DBWithTTLImpl::kTSLength) {
+    // Tolerate unexpected values the same way IsStale() tolerates them.
+    return Status::OK();
+  }
+  int64_t timestamp_value =
+      DecodeFixed32(value.data() + value.size() - DBWithTTLImpl::kTSLength);
+  min_timestamp_ = std::min(min_timestamp_, timestamp_value);
+  max_timestamp_ = std::max(max_timestamp_, timestamp_value);
+  return Status::OK();
+}
+
+Status TtlPropertiesCollector::Finish(UserCollectedProperties* properties) {
+  if (max_timestamp_ < min_timestamp_) {
+    // No timestamped entries were seen.
+    return Status::OK();
+  }
+  properties->insert(
+      {kMinTimestampPropertyName, std::to_string(min_timestamp_)});
+  properties->insert(
+      {kMaxTimestampPropertyName, std::to_string(max_timestamp_)});
+  int64_t curtime;
+  if (ttl_ > 0 && clock_ != nullptr && clock_->GetCurrentTime(&curtime).ok() &&
+      max_timestamp_ + ttl_ < curtime) {
+    // Every entry in the file is already past its TTL; have the file
+    // compacted promptly so TtlCompactionFilter can drop it wholesale.
+    need_compaction_ = true;
+  }
+  return Status::OK();
+}
+
+UserCollectedProperties TtlPropertiesCollector::GetReadableProperties() const {
+  if (max_timestamp_ < min_timestamp_) {
+    return UserCollectedProperties{};
+  }
+  return UserCollectedProperties{
+      {kMinTimestampPropertyName, std::to_string(min_timestamp_)},
+      {kMaxTimestampPropertyName, std::to_string(max_timestamp_)},
+  };
 }
 
 static std::unordered_map<std::string, OptionTypeInfo> ttl_type_info = {
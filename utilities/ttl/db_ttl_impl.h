@@ -20,6 +20,7 @@
 #pragma once
 
 #include <deque>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include "rocksdb/db.h"
 #include "rocksdb/merge_operator.h"
 #include "rocksdb/system_clock.h"
+#include "rocksdb/table_properties.h"
 #include "rocksdb/utilities/db_ttl.h"
 #include "utilities/compaction_filters/layered_compaction_filter_base.h"
 
@@ -287,6 +289,59 @@ class TtlMergeOperator : public MergeOperator {
   std::shared_ptr<MergeOperator> user_merge_op_;
   SystemClock* clock_;
 };
+
+// Records the minimum and maximum write timestamps embedded in the values of
+// a TTL table, so the expiration state of a whole file can be judged from its
+// properties without decoding any of its entries:
+//   rocksdb.ttl.min.timestamp / rocksdb.ttl.max.timestamp (decimal strings)
+// A file whose max timestamp is already past its TTL when the file is
+// finished consists entirely of dead entries, and is flagged as needing
+// compaction so that TtlCompactionFilter gets to drop it promptly.
+class TtlPropertiesCollector : public TablePropertiesCollector {
+ public:
+  TtlPropertiesCollector(int32_t ttl, SystemClock* clock)
+      : ttl_(ttl), clock_(clock) {}
+
+  static const char* kClassName() { return "TtlPropertiesCollector"; }
+  const char* Name() const override { return kClassName(); }
+
+  static const std::string kMinTimestampPropertyName;
+  static const std::string kMaxTimestampPropertyName;
+
+  Status AddUserKey(const Slice& key, const Slice& value, EntryType type,
+                    SequenceNumber seq, uint64_t file_size) override;
+
+  Status Finish(UserCollectedProperties* properties) override;
+
+  UserCollectedProperties GetReadableProperties() const override;
+
+  bool NeedCompact() const override { return need_compaction_; }
+
+ private:
+  int32_t ttl_;
+  SystemClock* clock_;
+  int64_t min_timestamp_ = std::numeric_limits<int64_t>::max();
+  int64_t max_timestamp_ = std::numeric_limits<int64_t>::min();
+  bool need_compaction_ = false;
+};
+
+class TtlPropertiesCollectorFactory : public TablePropertiesCollectorFactory {
+ public:
+  TtlPropertiesCollectorFactory(int32_t ttl, SystemClock* clock)
+      : ttl_(ttl), clock_(clock) {}
+
+  TablePropertiesCollector* CreateTablePropertiesCollector(
+      TablePropertiesCollectorFactory::Context /*context*/) override {
+    return new TtlPropertiesCollector(ttl_, clock_);
+  }
+
+  static const char* kClassName() { return "TtlPropertiesCollectorFactory"; }
+  const char* Name() const override { return kClassName(); }
+
+ private:
+  int32_t ttl_;
+  SystemClock* clock_;
+};
 extern "C" {
 int RegisterTtlObjects(ObjectLibrary& library, const std::string& /*arg*/);
 }  // extern "C"
@@ -1213,6 +1213,45 @@ TEST_F(TtlTest, SkipExpiredColumnFamiliesTest) {
   }
 }
 
+// Checks that the timestamp properties recorded by TtlPropertiesCollector
+// cover the write timestamps of a file, and that a file which is entirely
+// expired by the time it is finished is flagged as needing compaction.
+TEST_F(TtlTest, TtlPropertiesCollectorTest) {
+  int64_t open_time = 0;
+  ASSERT_OK(env_->GetCurrentTime(&open_time));
+  OpenTtl(ttl_);
+  ASSERT_OK(db_ttl_->Put(WriteOptions(), "a", "val"));  // T=0
+  env_->Sleep(2);
+  ASSERT_OK(db_ttl_->Put(WriteOptions(), "b", "val"));  // T=2
+  ASSERT_OK(db_ttl_->Flush(FlushOptions()));
+
+  TablePropertiesCollection props;
+  ASSERT_OK(db_ttl_->GetBaseDB()->GetPropertiesOfAllTables(&props));
+  ASSERT_EQ(props.size(), 1U);
+  const auto& user_props = props.begin()->second->user_collected_properties;
+  auto min_prop =
+      user_props.find(TtlPropertiesCollector::kMinTimestampPropertyName);
+  auto max_prop =
+      user_props.find(TtlPropertiesCollector::kMaxTimestampPropertyName);
+  ASSERT_NE(min_prop, user_props.end());
+  ASSERT_NE(max_prop, user_props.end());
+  ASSERT_EQ(std::stoll(min_prop->second), open_time);
+  ASSERT_EQ(std::stoll(max_prop->second), open_time + 2);
+  CloseTtl();
+
+  // A collector whose newest entry is already stale when the file is
+  // finished reports NeedCompact().
+  SystemClock* clock = env_->GetSystemClock().get();
+  TtlPropertiesCollector collector(ttl_, clock);
+  std::string val_with_ts;
+  ASSERT_OK(DBWithTTLImpl::AppendTS("val", &val_with_ts, clock));
+  ASSERT_OK(collector.AddUserKey("a", val_with_ts, kEntryPut, 1, 0));
+  env_->Sleep(ttl_ + 1);
+  UserCollectedProperties collected;
+  ASSERT_OK(collector.Finish(&collected));
+  ASSERT_TRUE(collector.NeedCompact());
+}
+
 class DummyFilter : public CompactionFilter {
  public:
   bool Filter(int /*level*/, const Slice& /*key*/, const Slice& /*value*/,
@@ -7,6 +7,7 @@
 #include "rocksdb/utilities/write_batch_with_index.h"
 
 #include <memory>
+#include <unordered_map>
 
 #include "db/column_family.h"
 #include "db/db_impl/db_impl.h"
@@ -25,12 +26,14 @@ namespace ROCKSDB_NAMESPACE {
 struct WriteBatchWithIndex::Rep {
   explicit Rep(const Comparator* index_comparator, size_t reserved_bytes = 0,
                size_t max_bytes = 0, bool _overwrite_key = false,
-               size_t protection_bytes_per_key = 0)
+               size_t protection_bytes_per_key = 0,
+               bool _defer_index_build = false)
       : write_batch(reserved_bytes, max_bytes, protection_bytes_per_key,
                     index_comparator ? index_comparator->timestamp_size() : 0),
         comparator(index_comparator, &write_batch),
         skip_list(comparator, &arena),
         overwrite_key(_overwrite_key),
+        defer_index_build(_defer_index_build),
         last_entry_offset(0),
         last_sub_batch_offset(0),
         sub_batch_cnt(1) {}
@@ -39,6 +42,12 @@ struct WriteBatchWithIndex::Rep {
   Arena arena;
   WriteBatchEntrySkipList skip_list;
   bool overwrite_key;
+  // If true, mutations do not maintain the index; the whole index is built in
+  // one pass on the first read instead. See EnsureIndexBuilt().
+  bool defer_index_build;
+  // True iff the batch holds mutations that are not reflected in the index.
+  // Only set in deferred index mode.
+  bool index_pending = false;
   size_t last_entry_offset;
   // The starting offset of the last sub-batch. A sub-batch starts right before
   // inserting a key that is a duplicate of a key in the last sub-batch. Zero,
@@ -73,9 +82,58 @@ struct WriteBatchWithIndex::Rep {
   void Clear();
   void ClearIndex();
 
+  // In deferred index mode, bring the index up to date with the batch
+  // contents if any mutations are still unindexed. No-op otherwise.
+  Status EnsureIndexBuilt();
+
   // Rebuild index by reading all records from the batch.
   // Returns non-ok status on corruption.
   Status ReBuildIndex();
+
+  // Memoized results of batch-side point lookups so that read-modify-write
+  // loops over the same few keys skip the skip-list search and record decode
+  // on repeated reads. Only results that are independent of the base DB are
+  // cached: a resolved Put (kFound) or a Delete/SingleDelete (kDeleted).
+  // Entries are invalidated per key on writes and wholesale on Clear() and
+  // savepoint rollback. Keys with user-defined timestamps are never cached.
+  struct CachedBatchEntry {
+    WBWIIteratorImpl::Result result;  // kFound or kDeleted
+    std::string value;                // set iff result == kFound
+  };
+  using BatchValueCache = std::unordered_map<std::string, CachedBatchEntry>;
+  std::unordered_map<uint32_t, BatchValueCache> batch_value_cache;
+
+  const CachedBatchEntry* GetCachedBatchEntry(uint32_t cf_id,
+                                              const Slice& key) const {
+    const auto cf_cache = batch_value_cache.find(cf_id);
+    if (cf_cache == batch_value_cache.end()) {
+      return nullptr;
+    }
+    const auto entry = cf_cache->second.find(key.ToString());
+    return entry == cf_cache->second.end() ? nullptr : &entry->second;
+  }
+
+  void CacheBatchEntry(uint32_t cf_id, const Slice& key,
+                       WBWIIteratorImpl::Result result,
+                       const std::string* value) {
+    assert(result == WBWIIteratorImpl::kFound ||
+           result == WBWIIteratorImpl::kDeleted);
+    CachedBatchEntry& entry = batch_value_cache[cf_id][key.ToString()];
+    entry.result = result;
+    if (result == WBWIIteratorImpl::kFound) {
+      assert(value != nullptr);
+      entry.value = *value;
+    } else {
+      entry.value.clear();
+    }
+  }
+
+  void InvalidateCachedBatchEntry(uint32_t cf_id, const Slice& key) {
+    const auto cf_cache = batch_value_cache.find(cf_id);
+    if (cf_cache != batch_value_cache.end()) {
+      cf_cache->second.erase(key.ToString());
+    }
+  }
 };
 
 bool WriteBatchWithIndex::Rep::UpdateExistingEntry(
@@ -122,18 +180,30 @@ bool WriteBatchWithIndex::Rep::UpdateExistingEntryWithCfId(
 
 void WriteBatchWithIndex::Rep::AddOrUpdateIndex(
     ColumnFamilyHandle* column_family, const Slice& key, WriteType type) {
-  if (!UpdateExistingEntry(column_family, key, type)) {
-    uint32_t cf_id = GetColumnFamilyID(column_family);
-    const auto* cf_cmp = GetColumnFamilyUserComparator(column_family);
-    if (cf_cmp != nullptr) {
-      comparator.SetComparatorForCF(cf_id, cf_cmp);
-    }
+  uint32_t cf_id = GetColumnFamilyID(column_family);
+  const auto* cf_cmp = GetColumnFamilyUserComparator(column_family);
+  if (cf_cmp != nullptr) {
+    // Register the comparator even when the index build is deferred, so that
+    // the bulk build can compare keys of this column family correctly.
+    comparator.SetComparatorForCF(cf_id, cf_cmp);
+  }
+  InvalidateCachedBatchEntry(cf_id, key);
+  if (defer_index_build) {
+    index_pending = true;
+    return;
+  }
+  if (!UpdateExistingEntryWithCfId(cf_id, key, type)) {
     AddNewEntry(cf_id);
   }
 }
 
 void WriteBatchWithIndex::Rep::AddOrUpdateIndex(const Slice& key,
                                                 WriteType type) {
+  InvalidateCachedBatchEntry(0, key);
+  if (defer_index_build) {
+    index_pending = true;
+    return;
+  }
   if (!UpdateExistingEntryWithCfId(0, key, type)) {
     AddNewEntry(0);
   }
@@ -169,18 +239,38 @@ void WriteBatchWithIndex::Rep::AddNewEntry(uint32_t column_family_id) {
 void WriteBatchWithIndex::Rep::Clear() {
   write_batch.Clear();
   ClearIndex();
+  index_pending = false;
+  batch_value_cache.clear();
 }
 
 void WriteBatchWithIndex::Rep::ClearIndex() {
+  // Carry the index's observed footprint over to the rebuilt arena so that a
+  // reused batch refills a few right-sized blocks instead of re-growing from
+  // the minimum block size on every Clear().
+  size_t block_size = Arena::kMinBlockSize;
+  if (!arena.IsInInlineBlock()) {
+    block_size = Arena::OptimizeBlockSize(arena.ApproximateMemoryUsage());
+  }
   skip_list.~WriteBatchEntrySkipList();
   arena.~Arena();
-  new (&arena) Arena();
+  new (&arena) Arena(block_size);
   new (&skip_list) WriteBatchEntrySkipList(comparator, &arena);
   last_entry_offset = 0;
   last_sub_batch_offset = 0;
   sub_batch_cnt = 1;
 }
 
+Status WriteBatchWithIndex::Rep::EnsureIndexBuilt() {
+  if (!index_pending) {
+    return Status::OK();
+  }
+  Status s = ReBuildIndex();
+  if (s.ok()) {
+    index_pending = false;
+  }
+  return s;
+}
+
 Status WriteBatchWithIndex::Rep::ReBuildIndex() {
   Status s;
 
@@ -269,9 +359,11 @@ Status WriteBatchWithIndex::Rep::ReBuildIndex() {
 
 WriteBatchWithIndex::WriteBatchWithIndex(
     const Comparator* default_index_comparator, size_t reserved_bytes,
-    bool overwrite_key, size_t max_bytes, size_t protection_bytes_per_key)
+    bool overwrite_key, size_t max_bytes, size_t protection_bytes_per_key,
+    bool defer_index_build)
     : rep(new Rep(default_index_comparator, reserved_bytes, max_bytes,
-                  overwrite_key, protection_bytes_per_key)) {}
+                  overwrite_key, protection_bytes_per_key,
+                  defer_index_build)) {}
 
 WriteBatchWithIndex::~WriteBatchWithIndex() {}
 
@@ -282,15 +374,28 @@ WriteBatchWithIndex& WriteBatchWithIndex::operator=(WriteBatchWithIndex&&) =
 
 WriteBatch* WriteBatchWithIndex::GetWriteBatch() { return &rep->write_batch; }
 
-size_t WriteBatchWithIndex::SubBatchCnt() { return rep->sub_batch_cnt; }
+size_t WriteBatchWithIndex::SubBatchCnt() {
+  // Sub-batches are counted as part of index maintenance, which may be
+  // deferred.
+  rep->EnsureIndexBuilt().PermitUncheckedError();
+  return rep->sub_batch_cnt;
+}
 
 WBWIIterator* WriteBatchWithIndex::NewIterator() {
+  // The deferred index is rebuilt from batch contents this object wrote
+  // itself, so a failure here means the in-memory batch is corrupted.
+  Status s = rep->EnsureIndexBuilt();
+  assert(s.ok());
+  s.PermitUncheckedError();
   return new WBWIIteratorImpl(0, &(rep->skip_list), &rep->write_batch,
                               &(rep->comparator));
 }
 
 WBWIIterator* WriteBatchWithIndex::NewIterator(
     ColumnFamilyHandle* column_family) {
+  Status s = rep->EnsureIndexBuilt();
+  assert(s.ok());
+  s.PermitUncheckedError();
   return new WBWIIteratorImpl(GetColumnFamilyID(column_family),
                               &(rep->skip_list), &rep->write_batch,
                               &(rep->comparator));
@@ -299,6 +404,9 @@ WBWIIterator* WriteBatchWithIndex::NewIterator(
 Iterator* WriteBatchWithIndex::NewIteratorWithBase(
     ColumnFamilyHandle* column_family, Iterator* base_iterator,
     const ReadOptions* read_options) {
+  Status s = rep->EnsureIndexBuilt();
+  assert(s.ok());
+  s.PermitUncheckedError();
   auto wbwiii =
       new WBWIIteratorImpl(GetColumnFamilyID(column_family), &(rep->skip_list),
                            &rep->write_batch, &rep->comparator);
@@ -308,6 +416,9 @@ Iterator* WriteBatchWithIndex::NewIteratorWithBase(
 }
 
 Iterator* WriteBatchWithIndex::NewIteratorWithBase(Iterator* base_iterator) {
+  Status s = rep->EnsureIndexBuilt();
+  assert(s.ok());
+  s.PermitUncheckedError();
   // default column family's comparator
   auto wbwiii = new WBWIIteratorImpl(0, &(rep->skip_list), &rep->write_batch,
                                      &rep->comparator);
@@ -429,10 +540,31 @@ void WriteBatchWithIndex::Clear() { rep->Clear(); }
 Status WriteBatchWithIndex::GetFromBatch(ColumnFamilyHandle* column_family,
                                          const DBOptions& options,
                                          const Slice& key, std::string* value) {
+  const Comparator* const ucmp = rep->comparator.GetComparator(column_family);
+  const size_t ts_sz = ucmp ? ucmp->timestamp_size() : 0;
+  const uint32_t cf_id = GetColumnFamilyID(column_family);
+  if (ts_sz == 0) {
+    const Rep::CachedBatchEntry* cached = rep->GetCachedBatchEntry(cf_id, key);
+    if (cached != nullptr) {
+      if (cached->result == WBWIIteratorImpl::kFound) {
+        *value = cached->value;
+        return Status::OK();
+      }
+      assert(cached->result == WBWIIteratorImpl::kDeleted);
+      return Status::NotFound();
+    }
+  }
+
   Status s;
   WriteBatchWithIndexInternal wbwii(&options, column_family);
   auto result = wbwii.GetFromBatch(this, key, value, &s);
 
+  if (ts_sz == 0 && s.ok() &&
+      (result == WBWIIteratorImpl::kFound ||
+       result == WBWIIteratorImpl::kDeleted)) {
+    rep->CacheBatchEntry(cf_id, key, result, value);
+  }
+
   switch (result) {
     case WBWIIteratorImpl::kFound:
     case WBWIIteratorImpl::kError:
@@ -509,6 +641,20 @@ Status WriteBatchWithIndex::GetFromBatchAndDB(
     return Status::InvalidArgument("Must specify timestamp");
   }
 
+  const uint32_t cf_id = GetColumnFamilyID(column_family);
+  if (ts_sz == 0) {
+    const Rep::CachedBatchEntry* cached = rep->GetCachedBatchEntry(cf_id, key);
+    if (cached != nullptr) {
+      if (cached->result == WBWIIteratorImpl::kFound) {
+        *pinnable_val->GetSelf() = cached->value;
+        pinnable_val->PinSelf();
+        return Status::OK();
+      }
+      assert(cached->result == WBWIIteratorImpl::kDeleted);
+      return Status::NotFound();
+    }
+  }
+
   Status s;
   WriteBatchWithIndexInternal wbwii(db, column_family);
 
@@ -519,11 +665,17 @@ Status WriteBatchWithIndex::GetFromBatchAndDB(
   auto result = wbwii.GetFromBatch(this, key, &batch_value, &s);
 
   if (result == WBWIIteratorImpl::kFound) {
+    if (ts_sz == 0 && s.ok()) {
+      rep->CacheBatchEntry(cf_id, key, result, &batch_value);
+    }
     pinnable_val->PinSelf();
     return s;
   } else if (!s.ok() || result == WBWIIteratorImpl::kError) {
     return s;
   } else if (result == WBWIIteratorImpl::kDeleted) {
+    if (ts_sz == 0) {
+      rep->CacheBatchEntry(cf_id, key, result, nullptr);
+    }
     return Status::NotFound();
   }
   assert(result == WBWIIteratorImpl::kMergeInProgress ||
@@ -667,7 +819,14 @@ Status WriteBatchWithIndex::RollbackToSavePoint() {
   if (s.ok()) {
     rep->sub_batch_cnt = 1;
     rep->last_sub_batch_offset = 0;
-    s = rep->ReBuildIndex();
+    // Rolled-back writes may be reflected in the lookup cache; drop it.
+    rep->batch_value_cache.clear();
+    if (rep->defer_index_build) {
+      // Any index contents are stale now; rebuild lazily on the next read.
+      rep->index_pending = true;
+    } else {
+      s = rep->ReBuildIndex();
+    }
   }
 
   return s;
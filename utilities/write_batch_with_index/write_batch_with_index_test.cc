@@ -1278,6 +1278,56 @@ TEST_P(WriteBatchWithIndexTest, TestGetFromBatchAndDB) {
   ASSERT_TRUE(s.IsNotFound());
 }
 
+TEST_P(WriteBatchWithIndexTest, TestGetFromBatchAndDBRepeatedReads) {
+  // Exercises the memoized batch-side lookup cache: repeated reads of keys
+  // written through the batch must keep returning the current batch state,
+  // and writes in between must invalidate the cached result.
+  ASSERT_OK(OpenDB());
+
+  std::string value;
+
+  ASSERT_OK(db_->Put(write_opts_, "a", "db_a"));
+  ASSERT_OK(batch_->Put("a", "batch_a1"));
+
+  for (int i = 0; i < 3; i++) {
+    ASSERT_OK(batch_->GetFromBatchAndDB(db_, read_opts_, "a", &value));
+    ASSERT_EQ("batch_a1", value);
+  }
+
+  // Overwrite in the batch; the cached result must not be served.
+  ASSERT_OK(batch_->Put("a", "batch_a2"));
+  ASSERT_OK(batch_->GetFromBatchAndDB(db_, read_opts_, "a", &value));
+  ASSERT_EQ("batch_a2", value);
+
+  // Delete in the batch, then read twice (second read hits the cache).
+  ASSERT_OK(batch_->Delete("a"));
+  Status s = batch_->GetFromBatchAndDB(db_, read_opts_, "a", &value);
+  ASSERT_TRUE(s.IsNotFound());
+  s = batch_->GetFromBatchAndDB(db_, read_opts_, "a", &value);
+  ASSERT_TRUE(s.IsNotFound());
+
+  // A merge on top of the deletion must invalidate the cached kDeleted and
+  // go through merge resolution again.
+  ASSERT_OK(batch_->Merge("a", "merge_a"));
+  ASSERT_OK(batch_->GetFromBatchAndDB(db_, read_opts_, "a", &value));
+  ASSERT_EQ("merge_a", value);
+
+  // Rolling back to a savepoint must drop cached results of the rolled-back
+  // writes.
+  batch_->SetSavePoint();
+  ASSERT_OK(batch_->Put("b", "batch_b"));
+  ASSERT_OK(batch_->GetFromBatchAndDB(db_, read_opts_, "b", &value));
+  ASSERT_EQ("batch_b", value);
+  ASSERT_OK(batch_->RollbackToSavePoint());
+  s = batch_->GetFromBatchAndDB(db_, read_opts_, "b", &value);
+  ASSERT_TRUE(s.IsNotFound());
+
+  // Clear() must drop the whole cache.
+  batch_->Clear();
+  ASSERT_OK(batch_->GetFromBatchAndDB(db_, read_opts_, "a", &value));
+  ASSERT_EQ("db_a", value);
+}
+
 TEST_P(WriteBatchWithIndexTest, TestGetFromBatchAndDBMerge) {
   Status s = OpenDB();
   ASSERT_OK(s);
@@ -1750,6 +1800,49 @@ TEST_P(WriteBatchWithIndexTest, SavePointTest) {
   ASSERT_TRUE(s.IsNotFound());
 }
 
+TEST_P(WriteBatchWithIndexTest, DeferredIndexBuild) {
+  batch_.reset(new WriteBatchWithIndex(BytewiseComparator(), 20, GetParam(), 0,
+                                       0, /* defer_index_build */ true));
+  ASSERT_OK(batch_->Put("a", "a1"));
+  ASSERT_OK(batch_->Put("c", "c1"));
+  ASSERT_OK(batch_->Put("b", "b1"));
+  ASSERT_OK(batch_->Put("a", "a2"));
+  ASSERT_OK(batch_->Delete("c"));
+
+  // The index is built on first read and reflects all buffered mutations.
+  std::string value;
+  ASSERT_OK(batch_->GetFromBatch(options_, "a", &value));
+  ASSERT_EQ("a2", value);
+  ASSERT_TRUE(batch_->GetFromBatch(options_, "c", &value).IsNotFound());
+
+  // In overwrite mode duplicates are collapsed during the bulk build, the
+  // same way they are with eager indexing.
+  std::unique_ptr<WBWIIterator> iter(batch_->NewIterator());
+  size_t count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    count++;
+  }
+  ASSERT_EQ(GetParam() ? 3U : 5U, count);
+  iter.reset();
+
+  // Mutations after a read are picked up by the next read.
+  ASSERT_OK(batch_->Put("d", "d1"));
+  ASSERT_OK(batch_->GetFromBatch(options_, "d", &value));
+  ASSERT_EQ("d1", value);
+
+  batch_->SetSavePoint();
+  ASSERT_OK(batch_->Put("e", "e1"));
+  ASSERT_OK(batch_->RollbackToSavePoint());
+  ASSERT_TRUE(batch_->GetFromBatch(options_, "e", &value).IsNotFound());
+  ASSERT_OK(batch_->GetFromBatch(options_, "d", &value));
+  ASSERT_EQ("d1", value);
+
+  batch_->Clear();
+  iter.reset(batch_->NewIterator());
+  iter->SeekToFirst();
+  ASSERT_FALSE(iter->Valid());
+}
+
 TEST_P(WriteBatchWithIndexTest, SingleDeleteTest) {
   Status s;
   std::string value;